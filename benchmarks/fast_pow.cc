@@ -0,0 +1,120 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+/*
+ * A micro-benchmark for the SIMD power functions: pow(), the generic
+ * fast_pow() and FixedExponentPow for the exponent (gamma - 1) / (2 gamma)
+ * that is used in the Riemann solver of the Euler equations. Every
+ * variant is evaluated on an array of VectorizedArray arguments that fits
+ * into the L1 cache. The program reports the time per (scalar) evaluation
+ * and the maximal relative error with respect to pow(). The instruction
+ * set (SSE2, AVX2, AVX512, NEON) is the one selected by the configured
+ * compiler flags and SIMD_WIDTH. Usage:
+ *
+ *   benchmark-fast_pow [gamma] [repetitions]
+ */
+
+#include <compile_time_options.h>
+
+#include <simd.h>
+#include <simd_fixed_exponent_pow.h>
+
+#include <deal.II/base/timer.h>
+#include <deal.II/base/vectorization.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  using namespace ryujin;
+
+  volatile double sink_;
+
+  template <typename Number>
+  void benchmark(const Number gamma, const unsigned int repetitions)
+  {
+    using VA = dealii::VectorizedArray<Number>;
+    constexpr unsigned int n_arguments = 512;
+
+    const Number b = (gamma - Number(1.)) / (Number(2.) * gamma);
+    const FixedExponentPow<Number> fixed_pow(b);
+
+    std::vector<VA> arguments(n_arguments);
+    for (unsigned int i = 0; i < n_arguments; ++i)
+      for (unsigned int l = 0; l < VA::size(); ++l)
+        arguments[i][l] =
+            Number(0.1 + 10. * ((i * VA::size() + l) * 0.618034 -
+                                std::floor((i * VA::size() + l) * 0.618034)));
+
+    std::vector<VA> reference(n_arguments), results(n_arguments);
+    for (unsigned int i = 0; i < n_arguments; ++i)
+      reference[i] = ryujin::pow(arguments[i], b);
+
+    const auto run = [&](const std::string &name, const auto &function) {
+      /* Accumulate a checksum to keep the compiler from hoisting the loop: */
+      VA checksum = Number(0.);
+      dealii::Timer timer;
+      for (unsigned int r = 0; r < repetitions; ++r) {
+        for (unsigned int i = 0; i < n_arguments; ++i) {
+          results[i] = function(arguments[i]);
+          checksum += results[i];
+        }
+      }
+      timer.stop();
+      for (unsigned int l = 0; l < VA::size(); ++l)
+        sink_ = sink_ + checksum[l];
+
+      double error = 0.;
+      for (unsigned int i = 0; i < n_arguments; ++i)
+        for (unsigned int l = 0; l < VA::size(); ++l)
+          error = std::max(error,
+                           std::abs(double(results[i][l] - reference[i][l])) /
+                               double(reference[i][l]));
+
+      const double n_evaluations =
+          double(repetitions) * n_arguments * VA::size();
+      std::cout << "  " << std::left << std::setw(30) << name << std::right
+                << std::setw(10) << std::fixed << std::setprecision(3)
+                << 1.e9 * timer.wall_time() / n_evaluations << " ns   "
+                << std::scientific << std::setprecision(2) << error
+                << std::endl;
+    };
+
+    std::cout << (std::is_same_v<Number, double> ? "double" : "float")
+              << ", SIMD width " << VA::size() << ", b = " << std::defaultfloat
+              << std::setprecision(6) << b << "\n"
+              << "  variant                        time/eval  max rel. error"
+              << std::endl;
+
+    run("pow", [&](const VA x) { return ryujin::pow(x, b); });
+    run("fast_pow, Bias::none",
+        [&](const VA x) { return fast_pow(x, b, Bias::none); });
+    run("fast_pow, Bias::max",
+        [&](const VA x) { return fast_pow(x, b, Bias::max); });
+    run("FixedExponentPow, Bias::none",
+        [&](const VA x) { return fixed_pow(x, Bias::none); });
+    run("FixedExponentPow, Bias::max",
+        [&](const VA x) { return fixed_pow(x, Bias::max); });
+    std::cout << std::endl;
+  }
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+  const double gamma = argc > 1 ? std::stod(argv[1]) : 1.4;
+  const unsigned int repetitions = argc > 2 ? std::stoul(argv[2]) : 20000;
+
+  benchmark<double>(gamma, repetitions);
+  benchmark<float>(float(gamma), repetitions);
+
+  return 0;
+}
@@ -0,0 +1,237 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+/*
+ * A standalone micro-benchmark for the compute kernels of
+ * HyperbolicModule::step(). The program sets up the discretization and
+ * offline data on the (synthetic) mesh described by the usual "C -
+ * Discretization" parameters, interpolates initial values, and then
+ * performs a number of forward Euler steps. For every phase of step()
+ * the wall time, the achieved throughput in (million) degrees of freedom
+ * per second and the memory footprint per degree of freedom are reported.
+ *
+ * The equation is selected at compile time (one executable per equation,
+ * see benchmarks/CMakeLists.txt), the SIMD width is the one configured
+ * with SIMD_WIDTH. The "prefetch distances" parameter runs the benchmark
+ * for a list of software prefetch distances in order to tune the
+ * "prefetch distance" of the HyperbolicModule for an architecture. Usage:
+ *
+ *   benchmark-euler [dimension] [parameter file]
+ */
+
+#include <compile_time_options.h>
+
+#include <description.h>
+#include <discretization.h>
+#include <hyperbolic_module.h>
+#include <initial_values.h>
+#include <mpi_ensemble.h>
+#include <mpi_ensemble_container.h>
+#include <offline_data.h>
+#include <simd.h>
+#include <state_vector.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parameter_acceptor.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+  template <typename Description, int dim, typename Number>
+  class HyperbolicModuleBenchmark final : public dealii::ParameterAcceptor
+  {
+  public:
+    using HyperbolicSystem = typename Description::HyperbolicSystem;
+    using ParabolicSystem = typename Description::ParabolicSystem;
+    using View =
+        typename Description::template HyperbolicSystemView<dim, Number>;
+    using StateVector = typename View::StateVector;
+
+    HyperbolicModuleBenchmark(const MPI_Comm &mpi_comm)
+        : ParameterAcceptor("/A - Benchmark")
+        , mpi_ensemble_(mpi_comm)
+        , hyperbolic_system_(mpi_ensemble_, "/B - Equation")
+        , parabolic_system_(mpi_ensemble_, "/B - Equation")
+        , discretization_(mpi_ensemble_, "/C - Discretization")
+        , offline_data_(mpi_ensemble_, discretization_, "/D - OfflineData")
+        , initial_values_(mpi_ensemble_,
+                          "/E - InitialValues",
+                          mpi_ensemble_,
+                          offline_data_,
+                          hyperbolic_system_,
+                          parabolic_system_)
+        , hyperbolic_module_(mpi_ensemble_,
+                             computing_timer_,
+                             offline_data_,
+                             hyperbolic_system_,
+                             initial_values_,
+                             "/F - HyperbolicModule")
+    {
+      n_warmup_steps_ = 2;
+      add_parameter("warmup steps",
+                    n_warmup_steps_,
+                    "Number of untimed steps performed before measuring");
+
+      n_steps_ = 20;
+      add_parameter("steps", n_steps_, "Number of timed steps");
+
+      add_parameter("prefetch distances",
+                    prefetch_distances_,
+                    "List of software prefetch distances for which the "
+                    "timed steps are repeated. If empty, the prefetch "
+                    "distance of the HyperbolicModule section is used");
+    }
+
+    void run()
+    {
+      const auto memory = [&]() {
+        dealii::Utilities::System::MemoryStats stats;
+        dealii::Utilities::System::get_memory_stats(stats);
+        return dealii::Utilities::MPI::sum(
+            1024. * stats.VmRSS, mpi_ensemble_.world_communicator());
+      };
+
+      const double memory_before = memory();
+
+      const unsigned int n_parabolic_state_vectors =
+          parabolic_system_.get().n_parabolic_state_vectors();
+
+      discretization_.prepare("benchmark");
+      offline_data_.prepare(View::problem_dimension,
+                            View::n_precomputed_values,
+                            n_parabolic_state_vectors);
+      hyperbolic_module_.prepare();
+
+      StateVector old_state_vector;
+      StateVector new_state_vector;
+      Vectors::reinit_state_vector<Description>(old_state_vector,
+                                                offline_data_);
+      Vectors::reinit_state_vector<Description>(new_state_vector,
+                                                offline_data_);
+      std::get<0>(old_state_vector) =
+          initial_values_.get().interpolate_hyperbolic_vector();
+
+      const auto &dof_handler = offline_data_.dof_handler();
+      const double n_dofs = dealii::Utilities::MPI::sum(
+          static_cast<double>(dof_handler.n_locally_owned_dofs()),
+          mpi_ensemble_.world_communicator());
+      const double bytes_per_dof = (memory() - memory_before) / n_dofs;
+
+      const auto step = [&](Number t) {
+        hyperbolic_module_.prepare_state_vector(old_state_vector, t);
+        const Number tau = hyperbolic_module_.template step<0>(
+            old_state_vector, {}, {}, new_state_vector);
+        old_state_vector.swap(new_state_vector);
+        return tau;
+      };
+
+      /* Report: */
+
+      const auto report = [&](const std::string &name, const double time) {
+        const double wall_time = dealii::Utilities::MPI::max(
+            time, mpi_ensemble_.world_communicator());
+        if (mpi_ensemble_.world_rank() != 0)
+          return;
+        std::cout << "  " << std::left << std::setw(56) << name << std::right
+                  << std::setprecision(4) << std::scientific << std::setw(12)
+                  << wall_time / n_steps_ << " s/step  " << std::fixed
+                  << std::setprecision(2) << std::setw(10)
+                  << n_dofs * n_steps_ / wall_time / 1.e6 << " Mdofs/s"
+                  << std::endl;
+      };
+
+      if (mpi_ensemble_.world_rank() == 0) {
+        std::cout << "HyperbolicModule benchmark: dim = " << dim
+                  << ", SIMD width = " << simd_width<Number> << ", "
+                  << n_dofs << " dofs on " << mpi_ensemble_.n_world_ranks()
+                  << " ranks, " << n_steps_ << " steps\n"
+                  << "  memory footprint: " << std::setprecision(1)
+                  << std::fixed << bytes_per_dof << " bytes/dof" << std::endl;
+      }
+
+      auto prefetch_distances = prefetch_distances_;
+      if (prefetch_distances.empty())
+        prefetch_distances.push_back(hyperbolic_module_.prefetch_distance());
+
+      Number t = 0.;
+      for (const auto prefetch_distance : prefetch_distances) {
+        hyperbolic_module_.prefetch_distance(prefetch_distance);
+
+        for (unsigned int i = 0; i < n_warmup_steps_; ++i)
+          t += step(t);
+
+        computing_timer_.clear();
+        dealii::Timer total;
+        for (unsigned int i = 0; i < n_steps_; ++i)
+          t += step(t);
+        total.stop();
+
+        if (mpi_ensemble_.world_rank() == 0)
+          std::cout << "prefetch distance = " << prefetch_distance
+                    << std::endl;
+
+        for (auto &[name, timer] : computing_timer_)
+          report(name, timer.wall_time());
+        report("total", total.wall_time());
+      }
+    }
+
+  private:
+    unsigned int n_warmup_steps_;
+    unsigned int n_steps_;
+    std::vector<unsigned int> prefetch_distances_;
+
+    MPIEnsemble mpi_ensemble_;
+
+    std::map<std::string, dealii::Timer> computing_timer_;
+
+    MPIEnsembleContainer<HyperbolicSystem> hyperbolic_system_;
+    MPIEnsembleContainer<ParabolicSystem> parabolic_system_;
+    Discretization<dim> discretization_;
+    OfflineData<dim, Number> offline_data_;
+    MPIEnsembleContainer<InitialValues<Description, dim, Number>>
+        initial_values_;
+    HyperbolicModule<Description, dim, Number> hyperbolic_module_;
+  };
+
+
+  template <int dim>
+  void run_benchmark(const std::string &parameter_file,
+                     const MPI_Comm &mpi_comm)
+  {
+    using Description = BENCHMARK_DESCRIPTION;
+    HyperbolicModuleBenchmark<Description, dim, NUMBER> benchmark(mpi_comm);
+    dealii::ParameterAcceptor::initialize(parameter_file);
+    benchmark.run();
+  }
+} // namespace ryujin
+
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv);
+  MPI_Comm mpi_communicator(MPI_COMM_WORLD);
+
+  const int dimension = argc > 1 ? std::stoi(argv[1]) : 2;
+  const std::string parameter_file = argc > 2 ? argv[2] : "";
+
+  if (dimension == 1)
+    ryujin::run_benchmark<1>(parameter_file, mpi_communicator);
+  else if (dimension == 2)
+    ryujin::run_benchmark<2>(parameter_file, mpi_communicator);
+  else if (dimension == 3)
+    ryujin::run_benchmark<3>(parameter_file, mpi_communicator);
+  else
+    return 1;
+
+  return 0;
+}
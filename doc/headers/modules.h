@@ -69,6 +69,14 @@
  */
 
 
+/**
+ * @defgroup PassiveScalarsEquations The Passive Scalars Equations
+ *
+ * This module contains classes and functions related to transporting a
+ * number of passive scalars with a common velocity field.
+ */
+
+
 /**
  * @defgroup ScalarConservationEquations The Scalar Conservation Equations
  *
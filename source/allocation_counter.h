@@ -0,0 +1,51 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace ryujin
+{
+  /**
+   * A process-wide counter of heap allocations. If ryujin is configured
+   * with COUNT_ALLOCATIONS the global allocation functions are replaced
+   * in main.cc and every call to operator new increments the counter. On
+   * Linux the aligned allocation functions posix_memalign() and
+   * aligned_alloc() of the C library (used by dealii::AlignedVector and
+   * the MemoryPool) are interposed and counted as well. Plain malloc()
+   * calls are not counted. Without this option the counter stays zero.
+   *
+   * The TimeLoop uses the counter to detect heap allocations that occur
+   * inside a time step after a short warm-up phase.
+   *
+   * @ingroup Miscellaneous
+   */
+  class AllocationCounter
+  {
+  public:
+    /**
+     * Return the number of heap allocations performed so far.
+     */
+    static std::uint64_t value()
+    {
+      return counter_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Increment the counter. Called by the replaced operator new.
+     */
+    static void increment()
+    {
+      counter_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+  private:
+    inline static std::atomic<std::uint64_t> counter_ = 0;
+  };
+} // namespace ryujin
@@ -0,0 +1,344 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A diskless ("buddy") checkpoint of the locally owned part of a
+   * distributed vector. Every rank keeps a copy of its own data and
+   * additionally stores the copy of a partner rank in memory. The partner
+   * of a rank is the rank @p stride positions ahead (modulo the size of
+   * the communicator). Choosing the number of ranks per compute node as
+   * @p stride places the copy on a different node for the usual block
+   * distribution of ranks.
+   *
+   * The data is stored as is, i.e., in the current DoF numbering and
+   * memory layout. A checkpoint thus has to be invalidated with clear()
+   * whenever the partition changes.
+   *
+   * Intended use:
+   * ```
+   * buddy_checkpoint.reinit(communicator, n_ranks_per_node);
+   * // every k cycles:
+   * buddy_checkpoint.store(vector, t, output_cycle);
+   * // after a failure:
+   * if (buddy_checkpoint.agree_on_failure(timeout))
+   *   buddy_checkpoint.recover(vector, t, output_cycle, lost);
+   * ```
+   *
+   * @ingroup TimeLoop
+   */
+  template <typename Number>
+  class BuddyCheckpoint
+  {
+  public:
+    /**
+     * Destructor. Completes all pending transfers.
+     */
+    ~BuddyCheckpoint()
+    {
+      wait();
+      if (failure_communicator_ != MPI_COMM_NULL)
+        MPI_Comm_free(&failure_communicator_);
+    }
+
+    /**
+     * Initialize the checkpoint over the given @p communicator with a
+     * partner rank @p stride positions ahead.
+     */
+    void reinit(const MPI_Comm &communicator, const unsigned int stride)
+    {
+      wait();
+      communicator_ = communicator;
+
+      /* A private communicator for agree_on_failure(): */
+      if (failure_communicator_ != MPI_COMM_NULL)
+        MPI_Comm_free(&failure_communicator_);
+      const int ierr = MPI_Comm_dup(communicator, &failure_communicator_);
+      AssertThrowMPI(ierr);
+
+      const int n_ranks = dealii::Utilities::MPI::n_mpi_processes(communicator);
+      const int rank = dealii::Utilities::MPI::this_mpi_process(communicator);
+      const int offset = std::max(1u, stride) % n_ranks;
+      partner_ = (rank + offset) % n_ranks;
+      source_ = (rank + n_ranks - offset) % n_ranks;
+      local_only_ = (offset == 0);
+
+      clear();
+    }
+
+    /**
+     * Invalidate the stored checkpoint.
+     */
+    void clear()
+    {
+      wait();
+      own_.clear();
+      partner_copy_.clear();
+    }
+
+    /**
+     * Return true if a (local) checkpoint is stored.
+     */
+    bool valid() const
+    {
+      return !own_.empty();
+    }
+
+    /**
+     * Store a copy of the locally owned part of @p vector together with
+     * the time @p t and the @p output_cycle. The copy is sent to the
+     * partner rank asynchronously, the transfer is completed with the
+     * next call to store(), recover(), or wait().
+     *
+     * @note This function is collective over the communicator.
+     */
+    template <typename Vector>
+    void store(const Vector &vector, const Number t, unsigned int output_cycle)
+    {
+      static_assert(std::is_same_v<typename Vector::value_type, Number>);
+
+      /* The send buffer must not be modified while a transfer is pending: */
+      wait();
+
+      const auto size = vector.get_partitioner()->locally_owned_size();
+
+      own_.resize(header_size + size * sizeof(Number));
+      const Header header{double(t), output_cycle, size};
+      std::memcpy(own_.data(), &header, sizeof(Header));
+      std::memcpy(
+          own_.data() + header_size, vector.begin(), size * sizeof(Number));
+
+      if (local_only_)
+        return;
+
+      /* Exchange the message sizes, they change with mesh adaptation: */
+      unsigned long long send_size = own_.size();
+      unsigned long long receive_size = 0;
+      int ierr = MPI_Sendrecv(&send_size,
+                              1,
+                              MPI_UNSIGNED_LONG_LONG,
+                              partner_,
+                              tag_size,
+                              &receive_size,
+                              1,
+                              MPI_UNSIGNED_LONG_LONG,
+                              source_,
+                              tag_size,
+                              communicator_,
+                              MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      partner_copy_.resize(receive_size);
+      ierr = MPI_Irecv(partner_copy_.data(),
+                       receive_size,
+                       MPI_BYTE,
+                       source_,
+                       tag_data,
+                       communicator_,
+                       &requests_[0]);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_Isend(own_.data(),
+                       own_.size(),
+                       MPI_BYTE,
+                       partner_,
+                       tag_data,
+                       communicator_,
+                       &requests_[1]);
+      AssertThrowMPI(ierr);
+
+      pending_ = true;
+    }
+
+    /**
+     * Complete all pending transfers.
+     */
+    void wait()
+    {
+      if (!pending_)
+        return;
+
+      const int ierr =
+          MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+      pending_ = false;
+    }
+
+    /**
+     * Called by a rank whose time step failed. Return true if all ranks
+     * of the communicator call this function within @p timeout seconds,
+     * i.e., if the failure is collective and recover() can be called
+     * safely. Otherwise return false: the remaining ranks are then
+     * possibly blocked in a collective operation and the caller has to
+     * abort.
+     *
+     * The agreement is a nonblocking barrier over a private duplicate of
+     * the communicator, so it cannot be matched with a collective
+     * operation the remaining ranks are waiting in.
+     */
+    bool agree_on_failure(const double timeout) const
+    {
+      MPI_Request request;
+      int ierr = MPI_Ibarrier(failure_communicator_, &request);
+      AssertThrowMPI(ierr);
+
+      const double start = MPI_Wtime();
+      for (;;) {
+        int done = 0;
+        ierr = MPI_Test(&request, &done, MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+        if (done)
+          return true;
+        if (MPI_Wtime() - start > timeout)
+          return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    /**
+     * Restore @p vector, @p t, and @p output_cycle from the checkpoint.
+     * A rank that has @p lost its own copy (for example because it
+     * replaced a failed process) receives the copy held by its partner
+     * rank instead.
+     *
+     * @note This function is collective over the communicator.
+     */
+    template <typename Vector>
+    void recover(Vector &vector,
+                 Number &t,
+                 unsigned int &output_cycle,
+                 const bool lost = false)
+    {
+      wait();
+
+      if (!local_only_) {
+        /*
+         * Tell the partner (holding our copy) whether we need it back,
+         * and learn whether the source rank needs its copy back:
+         */
+        int send_lost = lost;
+        int source_lost = 0;
+        int ierr = MPI_Sendrecv(&send_lost,
+                                1,
+                                MPI_INT,
+                                partner_,
+                                tag_size,
+                                &source_lost,
+                                1,
+                                MPI_INT,
+                                source_,
+                                tag_size,
+                                communicator_,
+                                MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        /* Send without blocking so that chains of lost ranks progress: */
+        unsigned long long return_size = partner_copy_.size();
+        if (source_lost) {
+          ierr = MPI_Isend(&return_size,
+                           1,
+                           MPI_UNSIGNED_LONG_LONG,
+                           source_,
+                           tag_size,
+                           communicator_,
+                           &requests_[0]);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Isend(partner_copy_.data(),
+                           return_size,
+                           MPI_BYTE,
+                           source_,
+                           tag_data,
+                           communicator_,
+                           &requests_[1]);
+          AssertThrowMPI(ierr);
+        }
+
+        if (lost) {
+          unsigned long long size = 0;
+          ierr = MPI_Recv(&size,
+                          1,
+                          MPI_UNSIGNED_LONG_LONG,
+                          partner_,
+                          tag_size,
+                          communicator_,
+                          MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+          own_.resize(size);
+          ierr = MPI_Recv(own_.data(),
+                          size,
+                          MPI_BYTE,
+                          partner_,
+                          tag_data,
+                          communicator_,
+                          MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+        if (source_lost) {
+          ierr = MPI_Waitall(
+              requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+      }
+
+      AssertThrow(own_.size() >= header_size,
+                  dealii::ExcMessage("No buddy checkpoint to recover from"));
+
+      Header header;
+      std::memcpy(&header, own_.data(), sizeof(Header));
+
+      const auto size = vector.get_partitioner()->locally_owned_size();
+      AssertThrow(header.size == size,
+                  dealii::ExcMessage("The buddy checkpoint does not match the "
+                                     "current partition"));
+
+      std::memcpy(
+          vector.begin(), own_.data() + header_size, size * sizeof(Number));
+      t = Number(header.t);
+      output_cycle = header.output_cycle;
+    }
+
+  private:
+    struct Header {
+      double t;
+      unsigned long long output_cycle;
+      unsigned long long size;
+    };
+
+    /* Keep the payload aligned: */
+    static constexpr std::size_t header_size =
+        (sizeof(Header) + 63) / 64 * 64;
+
+    static constexpr int tag_size = 0x7230;
+    static constexpr int tag_data = 0x7231;
+
+    MPI_Comm communicator_ = MPI_COMM_SELF;
+    MPI_Comm failure_communicator_ = MPI_COMM_NULL;
+    int partner_ = 0;
+    int source_ = 0;
+    bool local_only_ = true;
+
+    std::vector<char> own_;
+    std::vector<char> partner_copy_;
+
+    bool pending_ = false;
+    std::array<MPI_Request, 2> requests_;
+  };
+} // namespace ryujin
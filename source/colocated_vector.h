@@ -0,0 +1,155 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "memory_pool.h"
+#include "multicomponent_vector.h"
+#include "openmp.h"
+
+namespace ryujin
+{
+  namespace Vectors
+  {
+    /**
+     * A co-located copy of two MultiComponentVector objects with
+     * @p n_comp_1 and @p n_comp_2 components (typically the hyperbolic
+     * state U and the vector of precomputed values), stored as
+     * \f{align}
+     *  (U_0)_0, \ldots, (U_0)_{n_1-1}, (P_0)_0, \ldots, (P_0)_{n_2-1},
+     *  (U_1)_0, \ldots
+     * \f}
+     * for all locally relevant (owned and ghost) indices.
+     *
+     * The stencil loops of the HyperbolicModule gather the state U_j and
+     * (inside of the RiemannSolver, Indicator, Limiter, or flux
+     * contributions) the precomputed values at the same neighbor indices
+     * js. With separate vectors every such pair of gathers touches two
+     * unrelated cache lines per neighbor. After calling attach() both
+     * vectors redirect their gathers to the co-located copy (see
+     * MultiComponentVector::set_gather_source()), so that the second
+     * gather hits the same (or the adjacent) cache line as the first one.
+     * The interface of the vectors, and thus of all consumers, is left
+     * unchanged.
+     *
+     * Usage:
+     * @code
+     * ColocatedVector<Number, problem_dimension, n_precomputed_values> X;
+     * {
+     *   const auto guard = X.attach(U, precomputed);
+     *   // gathers U.get_tensor(js), precomputed.get_tensor(js) read from X
+     * }
+     * @endcode
+     *
+     * @note The copy is created by attach() and is not kept in sync with
+     * the vectors. Neither vector must be modified while the guard
+     * returned by attach() is alive.
+     *
+     * @ingroup SIMD
+     */
+    template <typename Number,
+              int n_comp_1,
+              int n_comp_2,
+              int simd_length = simd_width<Number>>
+    class ColocatedVector
+    {
+    public:
+      /**
+       * The number of values stored per index.
+       */
+      static constexpr unsigned int stride = n_comp_1 + n_comp_2;
+
+      using FirstVector = MultiComponentVector<Number, n_comp_1, simd_length>;
+      using SecondVector = MultiComponentVector<Number, n_comp_2, simd_length>;
+
+      /**
+       * A (move only) guard object that restores the default gather
+       * behavior of both vectors on destruction.
+       */
+      class Guard
+      {
+      public:
+        Guard(const FirstVector &first, const SecondVector &second)
+            : first_(&first)
+            , second_(&second)
+        {
+        }
+
+        Guard(Guard &&other)
+            : first_(other.first_)
+            , second_(other.second_)
+        {
+          other.first_ = nullptr;
+          other.second_ = nullptr;
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard()
+        {
+          if (first_ == nullptr)
+            return;
+          first_->set_gather_source(nullptr);
+          second_->set_gather_source(nullptr);
+        }
+
+      private:
+        const FirstVector *first_;
+        const SecondVector *second_;
+      };
+
+      /**
+       * Populate the co-located copy from the locally relevant values of
+       * @p first and @p second and redirect the gathers of both vectors
+       * to it. The ghost values of both vectors have to be up to date.
+       * Both vectors have to share the same (scalar) index space.
+       *
+       * The function has to be called outside of a parallel region, it
+       * spawns its own.
+       */
+      [[nodiscard]] Guard attach(const FirstVector &first,
+                                 const SecondVector &second)
+      {
+        const auto &partitioner = *first.get_partitioner();
+        const unsigned int n_relevant =
+            (partitioner.locally_owned_size() + partitioner.n_ghost_indices()) /
+            n_comp_1;
+
+        Assert(n_comp_2 == 0 ||
+                   (second.get_partitioner()->locally_owned_size() +
+                    second.get_partitioner()->n_ghost_indices()) ==
+                       n_relevant * n_comp_2,
+               dealii::ExcMessage("Called with vectors of incompatible local "
+                                  "index ranges."));
+
+        if (data_.size() != std::size_t(n_relevant) * stride)
+          data_.resize_fast(std::size_t(n_relevant) * stride);
+
+        RYUJIN_PARALLEL_REGION_BEGIN
+        RYUJIN_OMP_FOR
+        for (unsigned int i = 0; i < n_relevant; ++i) {
+          Number *destination = data_.data() + std::size_t(i) * stride;
+          for (unsigned int d = 0; d < n_comp_1; ++d)
+            destination[d] = first.local_element(first.element_index(i, d));
+          for (unsigned int d = 0; d < n_comp_2; ++d)
+            destination[n_comp_1 + d] =
+                second.local_element(second.element_index(i, d));
+        }
+        RYUJIN_PARALLEL_REGION_END
+
+        first.set_gather_source(data_.data(), stride);
+        second.set_gather_source(data_.data() + n_comp_1, stride);
+
+        return Guard(first, second);
+      }
+
+    private:
+      PooledVector<Number> data_;
+    };
+  } // namespace Vectors
+} // namespace ryujin
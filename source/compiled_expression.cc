@@ -0,0 +1,516 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#include "compiled_expression.h"
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/numbers.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <utility>
+
+namespace ryujin
+{
+  namespace
+  {
+    using Function1 = double (*)(double);
+    using Function2 = double (*)(double, double);
+
+    /*
+     * The unary and binary functions supported by muparser and the
+     * additional functions registered by dealii::FunctionParser:
+     */
+
+    const std::map<std::string, Function1> &functions1()
+    {
+      static const std::map<std::string, Function1> functions{
+          {"sin", [](double x) { return std::sin(x); }},
+          {"cos", [](double x) { return std::cos(x); }},
+          {"tan", [](double x) { return std::tan(x); }},
+          {"cot", [](double x) { return 1. / std::tan(x); }},
+          {"sec", [](double x) { return 1. / std::cos(x); }},
+          {"csc", [](double x) { return 1. / std::sin(x); }},
+          {"asin", [](double x) { return std::asin(x); }},
+          {"acos", [](double x) { return std::acos(x); }},
+          {"atan", [](double x) { return std::atan(x); }},
+          {"sinh", [](double x) { return std::sinh(x); }},
+          {"cosh", [](double x) { return std::cosh(x); }},
+          {"tanh", [](double x) { return std::tanh(x); }},
+          {"asinh", [](double x) { return std::asinh(x); }},
+          {"acosh", [](double x) { return std::acosh(x); }},
+          {"atanh", [](double x) { return std::atanh(x); }},
+          {"exp", [](double x) { return std::exp(x); }},
+          {"log", [](double x) { return std::log(x); }},
+          {"ln", [](double x) { return std::log(x); }},
+          {"log2", [](double x) { return std::log2(x); }},
+          {"log10", [](double x) { return std::log10(x); }},
+          {"sqrt", [](double x) { return std::sqrt(x); }},
+          {"abs", [](double x) { return std::abs(x); }},
+          {"sign",
+           [](double x) { return x < 0. ? -1. : (x > 0. ? 1. : 0.); }},
+          {"rint", [](double x) { return std::floor(x + 0.5); }},
+          {"int", [](double x) { return double(static_cast<int>(x)); }},
+          {"floor", [](double x) { return std::floor(x); }},
+          {"ceil", [](double x) { return std::ceil(x); }},
+          {"erfc", [](double x) { return std::erfc(x); }},
+      };
+      return functions;
+    }
+
+
+    const std::map<std::string, Function2> &functions2()
+    {
+      static const std::map<std::string, Function2> functions{
+          {"pow", [](double x, double y) { return std::pow(x, y); }},
+          {"atan2", [](double x, double y) { return std::atan2(x, y); }},
+          {"fmod", [](double x, double y) { return std::fmod(x, y); }},
+          {"min", [](double x, double y) { return std::min(x, y); }},
+          {"max", [](double x, double y) { return std::max(x, y); }},
+      };
+      return functions;
+    }
+
+
+    const std::map<std::string, double> &constants()
+    {
+      static const std::map<std::string, double> constants{
+          {"_pi", dealii::numbers::PI},
+          {"pi", dealii::numbers::PI},
+          {"Pi", dealii::numbers::PI},
+          {"_e", dealii::numbers::E},
+      };
+      return constants;
+    }
+  } // namespace
+
+
+  /*
+   * A recursive descent parser emitting instructions in postfix order
+   * with the grammar
+   *
+   *   expression := term { ("+" | "-") term }
+   *   term       := unary { ("*" | "/") unary }
+   *   unary      := ("-" | "+") unary | power
+   *   power      := primary [ "^" unary ]
+   *   primary    := number | constant | variable
+   *                 | function "(" expression { "," expression } ")"
+   *                 | "(" expression ")"
+   *
+   * Constant subexpressions are folded while emitting instructions.
+   */
+  class CompiledExpression::Parser
+  {
+  public:
+    Parser(const std::string &expression,
+           const std::vector<std::string> &variables,
+           std::vector<Instruction> &instructions)
+        : expression_(expression)
+        , variables_(variables)
+        , instructions_(instructions)
+        , position_(0)
+        , depth_(0)
+        , max_depth_(0)
+    {
+    }
+
+    bool parse()
+    {
+      const bool success = parse_expression();
+      skip_whitespace();
+      return success && position_ == expression_.size() &&
+             max_depth_ <= max_stack_depth;
+    }
+
+  private:
+    void skip_whitespace()
+    {
+      while (position_ < expression_.size() &&
+             std::isspace(expression_[position_]))
+        ++position_;
+    }
+
+    bool accept(const char c)
+    {
+      skip_whitespace();
+      if (position_ < expression_.size() && expression_[position_] == c) {
+        ++position_;
+        return true;
+      }
+      return false;
+    }
+
+    bool parse_expression()
+    {
+      if (!parse_term())
+        return false;
+      while (true) {
+        if (accept('+')) {
+          if (!parse_term())
+            return false;
+          emit_binary(Opcode::add);
+        } else if (accept('-')) {
+          if (!parse_term())
+            return false;
+          emit_binary(Opcode::subtract);
+        } else {
+          return true;
+        }
+      }
+    }
+
+    bool parse_term()
+    {
+      if (!parse_unary())
+        return false;
+      while (true) {
+        if (accept('*')) {
+          if (!parse_unary())
+            return false;
+          emit_binary(Opcode::multiply);
+        } else if (accept('/')) {
+          if (!parse_unary())
+            return false;
+          emit_binary(Opcode::divide);
+        } else {
+          return true;
+        }
+      }
+    }
+
+    bool parse_unary()
+    {
+      if (accept('-')) {
+        if (!parse_unary())
+          return false;
+        emit_unary({Opcode::negate});
+        return true;
+      }
+      if (accept('+'))
+        return parse_unary();
+      return parse_power();
+    }
+
+    bool parse_power()
+    {
+      if (!parse_primary())
+        return false;
+      if (accept('^')) {
+        if (!parse_unary())
+          return false;
+        emit_binary(Opcode::power);
+      }
+      return true;
+    }
+
+    bool parse_primary()
+    {
+      skip_whitespace();
+      if (position_ == expression_.size())
+        return false;
+
+      const char c = expression_[position_];
+
+      if (c == '(') {
+        ++position_;
+        return parse_expression() && accept(')');
+      }
+
+      if (std::isdigit(c) || c == '.') {
+        const char *begin = expression_.c_str() + position_;
+        char *end = nullptr;
+        const double value = std::strtod(begin, &end);
+        if (end == begin)
+          return false;
+        position_ += end - begin;
+        emit({Opcode::constant, value});
+        return true;
+      }
+
+      if (!std::isalpha(c) && c != '_')
+        return false;
+
+      const auto begin = position_;
+      while (position_ < expression_.size() &&
+             (std::isalnum(expression_[position_]) ||
+              expression_[position_] == '_'))
+        ++position_;
+      const auto name = expression_.substr(begin, position_ - begin);
+
+      /* Function call: */
+
+      if (accept('(')) {
+        unsigned int n_arguments = 0;
+        do {
+          if (!parse_expression())
+            return false;
+          ++n_arguments;
+        } while (accept(','));
+        if (!accept(')'))
+          return false;
+
+        if (const auto it = functions1().find(name);
+            it != functions1().end() && n_arguments == 1) {
+          Instruction instruction{Opcode::function1};
+          instruction.function1 = it->second;
+          emit_unary(instruction);
+          return true;
+        }
+
+        const bool variadic = (name == "min" || name == "max");
+        if (const auto it = functions2().find(name);
+            it != functions2().end() &&
+            (n_arguments == 2 || (variadic && n_arguments >= 1))) {
+          for (unsigned int i = 1; i < n_arguments; ++i) {
+            Instruction instruction{Opcode::function2};
+            instruction.function2 = it->second;
+            emit_binary(instruction);
+          }
+          return true;
+        }
+
+        return false;
+      }
+
+      /* Variable or constant: */
+
+      if (const auto it = std::find(variables_.begin(), variables_.end(), name);
+          it != variables_.end()) {
+        Instruction instruction{Opcode::variable};
+        instruction.index = it - variables_.begin();
+        emit(instruction);
+        return true;
+      }
+
+      if (const auto it = constants().find(name); it != constants().end()) {
+        emit({Opcode::constant, it->second});
+        return true;
+      }
+
+      return false;
+    }
+
+    void emit(const Instruction &instruction)
+    {
+      instructions_.push_back(instruction);
+      max_depth_ = std::max(max_depth_, ++depth_);
+    }
+
+    void emit_unary(const Instruction &instruction)
+    {
+      auto &last = instructions_.back();
+      if (last.opcode == Opcode::constant) {
+        last.value = apply(instruction, last.value, 0.);
+        return;
+      }
+      instructions_.push_back(instruction);
+    }
+
+    void emit_binary(const Instruction &instruction)
+    {
+      --depth_;
+
+      const auto n = instructions_.size();
+      auto &left = instructions_[n - 2];
+      auto &right = instructions_[n - 1];
+
+      if (left.opcode == Opcode::constant &&
+          right.opcode == Opcode::constant) {
+        left.value = apply(instruction, left.value, right.value);
+        instructions_.pop_back();
+        return;
+      }
+
+      if (instruction.opcode == Opcode::power &&
+          right.opcode == Opcode::constant && right.value == 2.) {
+        right = Instruction{Opcode::square};
+        return;
+      }
+
+      instructions_.push_back(instruction);
+    }
+
+    void emit_binary(const Opcode opcode)
+    {
+      emit_binary(Instruction{opcode});
+    }
+
+    static double apply(const Instruction &instruction, double a, double b)
+    {
+      switch (instruction.opcode) {
+      case Opcode::add:
+        return a + b;
+      case Opcode::subtract:
+        return a - b;
+      case Opcode::multiply:
+        return a * b;
+      case Opcode::divide:
+        return a / b;
+      case Opcode::power:
+        return std::pow(a, b);
+      case Opcode::negate:
+        return -a;
+      case Opcode::square:
+        return a * a;
+      case Opcode::function1:
+        return instruction.function1(a);
+      case Opcode::function2:
+        return instruction.function2(a, b);
+      default:
+        Assert(false, dealii::ExcInternalError());
+        return 0.;
+      }
+    }
+
+    const std::string &expression_;
+    const std::vector<std::string> &variables_;
+    std::vector<Instruction> &instructions_;
+    std::string::size_type position_;
+    unsigned int depth_;
+    unsigned int max_depth_;
+  };
+
+
+  bool CompiledExpression::initialize(const std::string &expression,
+                                      const std::vector<std::string> &variables)
+  {
+    instructions_.clear();
+    n_variables_ = variables.size();
+
+    if (n_variables_ > max_variables)
+      return false;
+
+    Parser parser(expression, variables, instructions_);
+    if (!parser.parse()) {
+      instructions_.clear();
+      return false;
+    }
+
+    return true;
+  }
+
+
+  void CompiledExpression::evaluate(double *result,
+                                    const double *const *variables,
+                                    unsigned int n) const
+  {
+    Assert(initialized(), dealii::ExcInternalError());
+
+    for (unsigned int offset = 0; offset < n; offset += batch_size)
+      evaluate_batch(
+          result, variables, offset, std::min(batch_size, n - offset));
+  }
+
+
+  double
+  CompiledExpression::value(const std::initializer_list<double> &values) const
+  {
+    Assert(values.size() == n_variables_, dealii::ExcInternalError());
+
+    std::array<const double *, max_variables> variables;
+    std::transform(std::begin(values),
+                   std::end(values),
+                   std::begin(variables),
+                   [](const double &value) { return &value; });
+
+    double result;
+    evaluate_batch(&result, variables.data(), 0, 1);
+    return result;
+  }
+
+
+  void CompiledExpression::evaluate_batch(double *result,
+                                          const double *const *variables,
+                                          unsigned int offset,
+                                          unsigned int n) const
+  {
+    std::array<std::array<double, batch_size>, max_stack_depth> stack;
+    unsigned int top = 0;
+
+    for (const auto &instruction : instructions_) {
+      switch (instruction.opcode) {
+      case Opcode::constant: {
+        auto &a = stack[top++];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] = instruction.value;
+      } break;
+
+      case Opcode::variable: {
+        auto &a = stack[top++];
+        const double *values = variables[instruction.index] + offset;
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] = values[i];
+      } break;
+
+      case Opcode::add: {
+        const auto &b = stack[--top];
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] += b[i];
+      } break;
+
+      case Opcode::subtract: {
+        const auto &b = stack[--top];
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] -= b[i];
+      } break;
+
+      case Opcode::multiply: {
+        const auto &b = stack[--top];
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] *= b[i];
+      } break;
+
+      case Opcode::divide: {
+        const auto &b = stack[--top];
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] /= b[i];
+      } break;
+
+      case Opcode::power: {
+        const auto &b = stack[--top];
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] = std::pow(a[i], b[i]);
+      } break;
+
+      case Opcode::negate: {
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] = -a[i];
+      } break;
+
+      case Opcode::square: {
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] *= a[i];
+      } break;
+
+      case Opcode::function1: {
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] = instruction.function1(a[i]);
+      } break;
+
+      case Opcode::function2: {
+        const auto &b = stack[--top];
+        auto &a = stack[top - 1];
+        for (unsigned int i = 0; i < n; ++i)
+          a[i] = instruction.function2(a[i], b[i]);
+      } break;
+      }
+    }
+
+    Assert(top == 1, dealii::ExcInternalError());
+    std::copy(stack[0].begin(), stack[0].begin() + n, result + offset);
+  }
+} // namespace ryujin
@@ -0,0 +1,231 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A small compiler for user-supplied function expressions that
+   * translates an expression into a sequence of instructions for a stack
+   * machine. Compared to evaluating a dealii::FunctionParser (muparser)
+   * object point by point the instructions are applied to a whole batch
+   * of up to @ref batch_size points at once. This makes most of the
+   * evaluation amenable to auto-vectorization and avoids the overhead of
+   * the muparser and deal.II wrapper (thread-local parser lookup, copying
+   * of arguments) for every point.
+   *
+   * The supported syntax is the arithmetic subset of muparser:
+   *  - number literals, variables, and the constants _pi, pi, Pi and _e,
+   *  - the binary operators +, -, *, /, ^ (right associative) and unary
+   *    minus and plus, with the same precedence as in muparser,
+   *  - the functions sin, cos, tan, cot, sec, csc, asin, acos, atan,
+   *    sinh, cosh, tanh, asinh, acosh, atanh, exp, log, ln, log2, log10,
+   *    sqrt, abs, sign, rint, int, floor, ceil, erfc, and the binary
+   *    functions pow, atan2, fmod, as well as min and max with an
+   *    arbitrary number of arguments.
+   *
+   * Expressions with unsupported syntax (most notably comparisons and the
+   * ternary operator) are rejected by initialize(). Callers are expected
+   * to fall back to a dealii::FunctionParser object in this case.
+   *
+   * Usage:
+   * @code
+   * CompiledExpression expression;
+   * if (expression.initialize("0.5 * u^2", {"u"})) {
+   *   std::array<double, 8> u{...}, f;
+   *   const double *variables[] = {u.data()};
+   *   expression.evaluate(f.data(), variables, u.size());
+   * }
+   * @endcode
+   *
+   * @ingroup Miscellaneous
+   */
+  class CompiledExpression
+  {
+  public:
+    /**
+     * The maximal number of points evaluated in one sweep over the
+     * instructions. Larger batches are processed in chunks.
+     */
+    static constexpr unsigned int batch_size = 16;
+
+    /**
+     * The maximal depth of the evaluation stack. Expressions requiring a
+     * deeper stack are rejected.
+     */
+    static constexpr unsigned int max_stack_depth = 16;
+
+    /**
+     * The maximal number of variables.
+     */
+    static constexpr unsigned int max_variables = 8;
+
+    /**
+     * Compile the @p expression with variables @p variables. Returns
+     * true if the expression could be compiled and false if it contains
+     * unsupported syntax.
+     */
+    bool initialize(const std::string &expression,
+                    const std::vector<std::string> &variables);
+
+    /**
+     * Return true if the object holds a successfully compiled
+     * expression.
+     */
+    bool initialized() const
+    {
+      return !instructions_.empty();
+    }
+
+    /**
+     * Evaluate the expression for @p n points. The argument
+     * @p variables contains one pointer per variable (in the order given
+     * to initialize()) to an array of @p n values. The results are
+     * stored in @p result.
+     */
+    void evaluate(double *result,
+                  const double *const *variables,
+                  unsigned int n) const;
+
+    /**
+     * Evaluate the expression for a single point.
+     */
+    double value(const std::initializer_list<double> &variables) const;
+
+    /**
+     * Evaluate an expression that was compiled with the variables
+     * returned by coordinate_variables() for a single @p point and time
+     * @p t.
+     */
+    template <int dim>
+    double value(const dealii::Point<dim> &point, double t) const;
+
+    /**
+     * Evaluate an expression that was compiled with the variables
+     * returned by coordinate_variables() for all @p points and time
+     * @p t. The results are stored in @p result.
+     */
+    template <int dim>
+    void evaluate(double *result,
+                  const dealii::ArrayView<const dealii::Point<dim>> &points,
+                  double t) const;
+
+    /**
+     * Return the variable names "x", "y", "z" (depending on @p dim) and
+     * "t" that dealii::FunctionParser uses for time-dependent functions.
+     */
+    template <int dim>
+    static std::vector<std::string> coordinate_variables();
+
+  private:
+    /**
+     * The instruction set of the stack machine.
+     */
+    enum class Opcode {
+      constant,
+      variable,
+      add,
+      subtract,
+      multiply,
+      divide,
+      power,
+      negate,
+      square,
+      function1,
+      function2,
+    };
+
+    struct Instruction {
+      Opcode opcode;
+      double value = 0.;
+      unsigned int index = 0;
+      double (*function1)(double) = nullptr;
+      double (*function2)(double, double) = nullptr;
+    };
+
+    class Parser;
+
+    /**
+     * Evaluate the expression for n <= batch_size points starting at
+     * @p offset.
+     */
+    void evaluate_batch(double *result,
+                        const double *const *variables,
+                        unsigned int offset,
+                        unsigned int n) const;
+
+    unsigned int n_variables_ = 0;
+    std::vector<Instruction> instructions_;
+  };
+
+
+  template <int dim>
+  inline double CompiledExpression::value(const dealii::Point<dim> &point,
+                                          double t) const
+  {
+    Assert(n_variables_ == dim + 1, dealii::ExcInternalError());
+
+    std::array<const double *, dim + 1> variables;
+    for (unsigned int d = 0; d < dim; ++d)
+      variables[d] = &point[d];
+    variables[dim] = &t;
+
+    double result;
+    evaluate_batch(&result, variables.data(), 0, 1);
+    return result;
+  }
+
+
+  template <int dim>
+  inline void CompiledExpression::evaluate(
+      double *result,
+      const dealii::ArrayView<const dealii::Point<dim>> &points,
+      double t) const
+  {
+    Assert(n_variables_ == dim + 1, dealii::ExcInternalError());
+
+    std::array<std::array<double, batch_size>, dim + 1> coordinates;
+    std::array<const double *, dim + 1> variables;
+    for (unsigned int d = 0; d <= dim; ++d)
+      variables[d] = coordinates[d].data();
+    coordinates[dim].fill(t);
+
+    for (unsigned int offset = 0; offset < points.size();
+         offset += batch_size) {
+      const unsigned int n = std::min<unsigned int>(batch_size,
+                                                    points.size() - offset);
+      for (unsigned int k = 0; k < n; ++k)
+        for (unsigned int d = 0; d < dim; ++d)
+          coordinates[d][k] = points[offset + k][d];
+
+      evaluate_batch(result + offset, variables.data(), 0, n);
+    }
+  }
+
+
+  template <int dim>
+  inline std::vector<std::string> CompiledExpression::coordinate_variables()
+  {
+    static_assert(dim >= 1 && dim <= 3, "unsupported dimension");
+    const std::vector<std::string> coordinates{"x", "y", "z"};
+    std::vector<std::string> variables(coordinates.begin(),
+                                       coordinates.begin() + dim);
+    variables.push_back("t");
+    return variables;
+  }
+} // namespace ryujin
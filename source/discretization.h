@@ -9,6 +9,7 @@
 
 #include "convenience_macros.h"
 #include "geometry.h"
+#include "geotiff_reader.h"
 #include "mpi_ensemble.h"
 #include "patterns_conversion.h"
 
@@ -331,6 +332,14 @@ namespace ryujin
     std::unique_ptr<const dealii::Quadrature<dim - 1>> face_nodal_quadrature_;
 
   private:
+    /**
+     * Locally refine the mesh where the terrain (bathymetry) given by a
+     * GeoTIFF raster is steep or strongly curved. The slope and curvature
+     * on a cell are estimated from the heights at the vertices and the
+     * cell center.
+     */
+    void refine_terrain();
+
     //@}
     /**
      * @name Run time options
@@ -343,6 +352,10 @@ namespace ryujin
 
     unsigned int refinement_;
 
+    unsigned int terrain_refinement_;
+    double terrain_slope_threshold_;
+    double terrain_curvature_threshold_;
+
     bool mesh_writeout_;
     double mesh_distortion_;
 
@@ -354,6 +367,8 @@ namespace ryujin
 
     std::set<std::unique_ptr<Geometry<dim>>> geometry_list_;
 
+    GeoTIFFReader<dim> terrain_reader_;
+
     //@}
   };
 
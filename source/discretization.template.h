@@ -27,6 +27,7 @@ namespace ryujin
                                       const std::string &subsection)
       : ParameterAcceptor(subsection)
       , mpi_ensemble_(mpi_ensemble)
+      , terrain_reader_(subsection + "/terrain refinement")
   {
     /* Options: */
 
@@ -47,6 +48,27 @@ namespace ryujin
                   refinement_,
                   "number of refinement of global refinement steps");
 
+    terrain_refinement_ = 0;
+    add_parameter("terrain refinement",
+                  terrain_refinement_,
+                  "number of additional local refinement steps driven by "
+                  "the slope and curvature of a GeoTIFF terrain (see "
+                  "subsection \"terrain refinement\")");
+
+    terrain_slope_threshold_ = 0.1;
+    add_parameter("terrain slope threshold",
+                  terrain_slope_threshold_,
+                  "terrain refinement: refine all cells with an estimated "
+                  "terrain slope larger than this threshold. A value of "
+                  "zero disables the criterion");
+
+    terrain_curvature_threshold_ = 0.;
+    add_parameter("terrain curvature threshold",
+                  terrain_curvature_threshold_,
+                  "terrain refinement: refine all cells with an estimated "
+                  "terrain curvature (times cell diameter) larger than this "
+                  "threshold. A value of zero disables the criterion");
+
     mesh_writeout_ = true;
     add_parameter("mesh writeout",
                   mesh_writeout_,
@@ -60,6 +82,66 @@ namespace ryujin
   }
 
 
+  template <int dim>
+  void Discretization<dim>::refine_terrain()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "Discretization<dim>::refine_terrain()" << std::endl;
+#endif
+
+    auto &triangulation = *triangulation_;
+
+    /* The GeoTIFFReader only queries the first two coordinates: */
+    constexpr unsigned int n_horizontal = std::min(dim, 2);
+    const auto horizontal_distance = [](const auto &p, const auto &q) {
+      double result = 0.;
+      for (unsigned int d = 0; d < n_horizontal; ++d)
+        result += (p[d] - q[d]) * (p[d] - q[d]);
+      return std::sqrt(result);
+    };
+
+    for (unsigned int cycle = 0; cycle < terrain_refinement_; ++cycle) {
+      for (const auto &cell : triangulation.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+
+        const auto center = cell->center();
+        const auto z_center = terrain_reader_.compute_height(center);
+
+        /*
+         * Estimate the slope by the largest difference quotient between
+         * the center and a vertex, and the curvature from the deviation
+         * of the vertex average from the center value (which is
+         * kappa / 2 * r^2 for a quadratic profile):
+         */
+        double slope = 0.;
+        double z_mean = 0.;
+        double r2_mean = 0.;
+        for (const auto v : cell->vertex_indices()) {
+          const auto vertex = cell->vertex(v);
+          const auto z_vertex = terrain_reader_.compute_height(vertex);
+          const auto r = horizontal_distance(vertex, center);
+          slope = std::max(slope, std::abs(z_vertex - z_center) / r);
+          z_mean += z_vertex;
+          r2_mean += r * r;
+        }
+        z_mean /= cell->n_vertices();
+        r2_mean /= cell->n_vertices();
+
+        const auto curvature = 2. * std::abs(z_mean - z_center) / r2_mean;
+
+        if ((terrain_slope_threshold_ > 0. &&
+             slope > terrain_slope_threshold_) ||
+            (terrain_curvature_threshold_ > 0. &&
+             curvature * cell->diameter() > terrain_curvature_threshold_))
+          cell->set_refine_flag();
+      }
+
+      triangulation.execute_coarsening_and_refinement();
+    }
+  }
+
+
   template <int dim>
   void Discretization<dim>::prepare(const std::string &base_name)
   {
@@ -121,6 +203,9 @@ namespace ryujin
 
     triangulation.refine_global(refinement_);
 
+    if (terrain_refinement_ > 0)
+      refine_terrain();
+
     if (std::abs(mesh_distortion_) > 1.0e-10)
       GridTools::distort_random(
           mesh_distortion_, triangulation, false, std::random_device()());
@@ -0,0 +1,106 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#include "ensemble_progress.h"
+
+#include <algorithm>
+
+namespace ryujin
+{
+  EnsembleProgress::EnsembleProgress(const MPIEnsemble &mpi_ensemble)
+      : mpi_ensemble_(mpi_ensemble)
+      , window_(MPI_WIN_NULL)
+      , progress_(nullptr)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "EnsembleProgress::EnsembleProgress()" << std::endl;
+#endif
+
+    if (mpi_ensemble_.global_synchronization() ||
+        mpi_ensemble_.n_ensembles() == 1 || mpi_ensemble_.ensemble_rank() != 0)
+      return;
+
+    /*
+     * The first ensemble leader holds one progress slot per ensemble. All
+     * other ensemble leaders expose an empty window:
+     */
+
+    const auto &communicator = mpi_ensemble_.ensemble_leader_communicator();
+    const bool owner = mpi_ensemble_.world_rank() == 0;
+    const auto size = std::tuple_size_v<Progress> * mpi_ensemble_.n_ensembles();
+
+    int ierr = MPI_Win_allocate(owner ? size * sizeof(double) : 0,
+                                sizeof(double),
+                                MPI_INFO_NULL,
+                                communicator,
+                                &progress_,
+                                &window_);
+    AssertThrowMPI(ierr);
+
+    if (owner) {
+      ierr = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, window_);
+      AssertThrowMPI(ierr);
+      std::fill(progress_, progress_ + size, 0.);
+      ierr = MPI_Win_unlock(0, window_);
+      AssertThrowMPI(ierr);
+    }
+
+    /* Make sure that the slots are initialized before they are accessed: */
+    ierr = MPI_Barrier(communicator);
+    AssertThrowMPI(ierr);
+  }
+
+
+  EnsembleProgress::~EnsembleProgress()
+  {
+    if (window_ != MPI_WIN_NULL)
+      MPI_Win_free(&window_);
+  }
+
+
+  void EnsembleProgress::post(const Progress &progress)
+  {
+    if (window_ == MPI_WIN_NULL)
+      return;
+
+    constexpr int size = std::tuple_size_v<Progress>;
+    const MPI_Aint displacement = size * mpi_ensemble_.ensemble();
+
+    /* Every ensemble writes to its own slot, a shared lock suffices: */
+    int ierr = MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, window_);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Put(progress.data(),
+                   size,
+                   MPI_DOUBLE,
+                   0,
+                   displacement,
+                   size,
+                   MPI_DOUBLE,
+                   window_);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Win_unlock(0, window_);
+    AssertThrowMPI(ierr);
+  }
+
+
+  auto EnsembleProgress::gather() const -> std::vector<Progress>
+  {
+    if (window_ == MPI_WIN_NULL || mpi_ensemble_.world_rank() != 0)
+      return {};
+
+    std::vector<Progress> result(mpi_ensemble_.n_ensembles());
+
+    int ierr = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, window_);
+    AssertThrowMPI(ierr);
+    for (unsigned int i = 0; i < result.size(); ++i)
+      std::copy(progress_ + i * result[i].size(),
+                progress_ + (i + 1) * result[i].size(),
+                result[i].begin());
+    ierr = MPI_Win_unlock(0, window_);
+    AssertThrowMPI(ierr);
+
+    return result;
+  }
+} /* namespace ryujin */
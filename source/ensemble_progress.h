@@ -0,0 +1,81 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "mpi_ensemble.h"
+
+#include <deal.II/base/mpi.h>
+
+#include <array>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * Asynchronous aggregation of the progress of decoupled ensembles,
+   * i.e., ensembles of an MPIEnsemble without global synchronization.
+   *
+   * Every ensemble leader posts the progress of its ensemble (the
+   * current cycle, time, and wall time) with a one-sided MPI_Put into a
+   * window held by the first ensemble leader, which can then report the
+   * progress of all ensembles at any time by calling gather(). Neither
+   * function synchronizes the ensembles, a slow ensemble thus never
+   * stalls the others.
+   *
+   * For an MPIEnsemble with global synchronization, or with a single
+   * ensemble, the class does nothing.
+   *
+   * @ingroup TimeLoop
+   */
+  class EnsembleProgress final
+  {
+  public:
+    /**
+     * The progress of an ensemble: cycle, time, and wall time.
+     */
+    using Progress = std::array<double, 3>;
+
+    /**
+     * Constructor. The constructor is collective over the world
+     * communicator of @p mpi_ensemble.
+     */
+    EnsembleProgress(const MPIEnsemble &mpi_ensemble);
+
+    ~EnsembleProgress();
+
+    EnsembleProgress(const EnsembleProgress &) = delete;
+    EnsembleProgress &operator=(const EnsembleProgress &) = delete;
+
+    /**
+     * Return true if the ensembles are decoupled and progress is
+     * aggregated.
+     */
+    bool enabled() const
+    {
+      return window_ != MPI_WIN_NULL;
+    }
+
+    /**
+     * Post the progress of the ensemble. Only the ensemble leader
+     * communicates; the function returns immediately on all other ranks.
+     */
+    void post(const Progress &progress);
+
+    /**
+     * Return the last posted progress of all ensembles. Only valid on
+     * world rank 0, an empty vector is returned on all other ranks.
+     */
+    std::vector<Progress> gather() const;
+
+  private:
+    const MPIEnsemble &mpi_ensemble_;
+
+    MPI_Win window_;
+    double *progress_;
+  };
+} /* namespace ryujin */
@@ -0,0 +1,89 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#include "ensemble_scheduler.h"
+
+#include <algorithm>
+
+namespace ryujin
+{
+  EnsembleScheduler::EnsembleScheduler(const MPIEnsemble &mpi_ensemble,
+                                       const unsigned int n_samples)
+      : mpi_ensemble_(mpi_ensemble)
+      , n_samples_(n_samples)
+      , window_(MPI_WIN_NULL)
+      , counter_(nullptr)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "EnsembleScheduler::EnsembleScheduler()" << std::endl;
+#endif
+
+    AssertThrow(!mpi_ensemble_.global_synchronization(),
+                dealii::ExcMessage(
+                    "The EnsembleScheduler requires an MPIEnsemble without "
+                    "global synchronization."));
+
+    if (mpi_ensemble_.ensemble_rank() != 0)
+      return;
+
+    /*
+     * The first ensemble leader holds the counter of handed out samples.
+     * All other ensemble leaders expose an empty window:
+     */
+
+    const auto &communicator = mpi_ensemble_.ensemble_leader_communicator();
+    const bool owner =
+        dealii::Utilities::MPI::this_mpi_process(communicator) == 0;
+
+    int ierr = MPI_Win_allocate(owner ? sizeof(unsigned int) : 0,
+                                sizeof(unsigned int),
+                                MPI_INFO_NULL,
+                                communicator,
+                                &counter_,
+                                &window_);
+    AssertThrowMPI(ierr);
+
+    if (owner) {
+      ierr = MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, window_);
+      AssertThrowMPI(ierr);
+      *counter_ = 0;
+      ierr = MPI_Win_unlock(0, window_);
+      AssertThrowMPI(ierr);
+    }
+
+    /* Make sure that the counter is initialized before it is accessed: */
+    ierr = MPI_Barrier(communicator);
+    AssertThrowMPI(ierr);
+  }
+
+
+  EnsembleScheduler::~EnsembleScheduler()
+  {
+    if (window_ != MPI_WIN_NULL)
+      MPI_Win_free(&window_);
+  }
+
+
+  unsigned int EnsembleScheduler::next_sample()
+  {
+    unsigned int sample = n_samples_;
+
+    if (mpi_ensemble_.ensemble_rank() == 0) {
+      const unsigned int increment = 1;
+      int ierr = MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, window_);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Fetch_and_op(
+          &increment, &sample, MPI_UNSIGNED, 0, 0, MPI_SUM, window_);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Win_unlock(0, window_);
+      AssertThrowMPI(ierr);
+    }
+
+    sample = dealii::Utilities::MPI::broadcast(
+        mpi_ensemble_.ensemble_communicator(), sample);
+
+    return std::min(sample, n_samples_);
+  }
+} /* namespace ryujin */
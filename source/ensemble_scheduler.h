@@ -0,0 +1,79 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "convenience_macros.h"
+#include "mpi_ensemble.h"
+
+#include <deal.II/base/mpi.h>
+
+namespace ryujin
+{
+  /**
+   * A dynamic work queue distributing @p n_samples samples (for example,
+   * the parameter samples of an uncertainty quantification campaign) over
+   * the ensembles of an MPIEnsemble.
+   *
+   * Instead of statically assigning one configuration per ensemble, every
+   * ensemble pulls the next sample from the queue as soon as it has
+   * finished its current one by calling next_sample(). The queue is a
+   * single counter held by the first ensemble leader and accessed with
+   * an atomic MPI-3 fetch-and-op over the ensemble leader communicator.
+   * No MPI rank is thus dedicated to managing the queue.
+   *
+   * Usage:
+   * @code
+   * MPIEnsemble mpi_ensemble(mpi_comm, n_ensembles, false);
+   * EnsembleScheduler scheduler(mpi_ensemble, n_samples);
+   * for (unsigned int sample = scheduler.next_sample(); sample < n_samples;
+   *      sample = scheduler.next_sample()) {
+   *   // process sample on mpi_ensemble.ensemble_communicator()
+   * }
+   * @endcode
+   *
+   * @ingroup Miscellaneous
+   */
+  class EnsembleScheduler final
+  {
+  public:
+    /**
+     * Constructor. The constructor is collective over the world
+     * communicator of @p mpi_ensemble.
+     *
+     * @pre The MPIEnsemble must not use global synchronization, i.e.,
+     * ensembles have to be able to advance independently.
+     */
+    EnsembleScheduler(const MPIEnsemble &mpi_ensemble,
+                      const unsigned int n_samples);
+
+    ~EnsembleScheduler();
+
+    EnsembleScheduler(const EnsembleScheduler &) = delete;
+    EnsembleScheduler &operator=(const EnsembleScheduler &) = delete;
+
+    /**
+     * Return the index of the next sample that the ensemble of the
+     * current MPI process should process, or n_samples() if the queue is
+     * exhausted. The function is collective over the ensemble
+     * communicator; every sample is handed out to exactly one ensemble.
+     */
+    unsigned int next_sample();
+
+    /**
+     * Return the total number of samples.
+     */
+    ACCESSOR_READ_ONLY(n_samples);
+
+  private:
+    const MPIEnsemble &mpi_ensemble_;
+    unsigned int n_samples_;
+
+    MPI_Win window_;
+    unsigned int *counter_;
+  };
+} /* namespace ryujin */
@@ -7,15 +7,24 @@
 
 #include <compile_time_options.h>
 
+#include "ensemble_scheduler.h"
 #include "time_loop.h"
 
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/parameter_acceptor.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <boost/signals2.hpp>
 
+#include <iomanip>
+#include <iostream>
 #include <string>
+#include <vector>
 
 namespace ryujin
 {
@@ -48,6 +57,15 @@ namespace ryujin
    * and then create an instance of the correct TimeLoop class, that takes
    * the dimension and equation as template parameters.
    *
+   * The optional parameters "ensembles" and "samples" of the same
+   * subsection configure an MPIEnsemble. If a list of samples (parameter
+   * files) is given, the ensembles pull these samples dynamically from a
+   * work queue, see run_time_loop().
+   *
+   * If dispatch() is called with @p tune set to true, a number of short
+   * runs with different runtime configurations is performed instead
+   * and the fastest configuration is reported, see tune_time_loop().
+   *
    * @ingroup TimeLoop
    */
   class EquationDispatch : dealii::ParameterAcceptor
@@ -60,6 +78,47 @@ namespace ryujin
       add_parameter("dimension", dimension_, "The spatial dimension");
       add_parameter("equation", equation_, "The PDE system");
 
+      n_ensembles_ = 1;
+      add_parameter("ensembles",
+                    n_ensembles_,
+                    "The number of ensembles, i.e., groups of MPI ranks, "
+                    "that the MPI ranks are subdivided into");
+
+      ensemble_synchronization_ = true;
+      add_parameter("ensemble synchronization",
+                    ensemble_synchronization_,
+                    "If set to true, all ensembles advance in lockstep with a "
+                    "common time step size. Otherwise, the ensembles are "
+                    "fully decoupled: every ensemble chooses its own time "
+                    "step size and reports its own statistics, so that a "
+                    "slow ensemble never stalls the others");
+
+      add_parameter(
+          "samples",
+          samples_,
+          "A list of parameter files. If nonempty, then every ensemble "
+          "repeatedly pulls the next sample from a (global) work queue and "
+          "runs the time loop with the parameters read from the main "
+          "parameter file overridden by the parameters of the sample. "
+          "Entries set in a sample file should also be set in the main "
+          "parameter file, so that they are reset before the next sample "
+          "is read");
+
+      precision_switch_time_ = 0.;
+      add_parameter(
+          "precision switch time",
+          precision_switch_time_,
+          "If set to a positive value, the computation is carried out in "
+          "single precision up to this time and then continued in double "
+          "precision on the same mesh. This requires ryujin to be "
+          "configured with the PRECISION_SWITCH compile-time option");
+
+      tuning_final_time_ = 0.;
+      add_parameter("tuning final time",
+                    tuning_final_time_,
+                    "Final time of every run performed in tuning mode "
+                    "(--tune). A value of 0 selects 1% of the final time");
+
       time_loop_executed_ = false;
     }
 
@@ -93,9 +152,13 @@ namespace ryujin
 
 
     /**
-     * Call dispatch() for all registered equations.
+     * Call dispatch() for all registered equations. If @p tune is set to
+     * true a set of runtime configurations is benchmarked instead of
+     * running the computation.
      */
-    void dispatch(const std::string &parameter_file, const MPI_Comm &mpi_comm)
+    void dispatch(const std::string &parameter_file,
+                  const MPI_Comm &mpi_comm,
+                  const bool tune = false)
     {
       ParameterAcceptor::prm.parse_input(parameter_file,
                                          "",
@@ -118,6 +181,11 @@ namespace ryujin
                           equation_,
                           parameter_file,
                           mpi_comm,
+                          n_ensembles_,
+                          ensemble_synchronization_,
+                          samples_,
+                          precision_switch_time_,
+                          tune,
                           time_loop_executed_);
 
       AssertThrow(time_loop_executed_ == true,
@@ -158,6 +226,11 @@ namespace ryujin
                                    const std::string & /*equation*/,
                                    const std::string & /*parameter file*/,
                                    const MPI_Comm & /*MPI communicator*/,
+                                   int /*number of ensembles*/,
+                                   bool /*ensemble synchronization*/,
+                                   const std::vector<std::string> & /*samples*/,
+                                   double /*precision switch time*/,
+                                   bool /*tune*/,
                                    bool & /*time loop executed*/)>
           dispatch;
     };
@@ -177,6 +250,11 @@ namespace ryujin
 
     int dimension_;
     std::string equation_;
+    int n_ensembles_;
+    bool ensemble_synchronization_;
+    std::vector<std::string> samples_;
+    double precision_switch_time_;
+    double tuning_final_time_;
 
     //@}
 
@@ -253,6 +331,311 @@ namespace ryujin
   }
 
 
+#ifdef PRECISION_SWITCH
+  /**
+   * Run the initial transient up to @p precision_switch_time with a
+   * TimeLoop in single precision (with the base name suffixed by
+   * "-warm_up") and continue the computation up to the final time with a
+   * TimeLoop in precision @p Number. The second TimeLoop copies the mesh
+   * and converts the final state of the first one, see
+   * TimeLoop::run(warm_up). A resumed computation skips the warm-up
+   * phase.
+   */
+  template <typename Description, int dim, typename Number>
+  void run_time_loop_with_precision_switch(const std::string &parameter_file,
+                                           const MPI_Comm &mpi_comm,
+                                           const int n_ensembles,
+                                           const bool ensemble_synchronization,
+                                           const double precision_switch_time)
+  {
+    auto &prm = dealii::ParameterAcceptor::prm;
+
+    TimeLoop<Description, dim, float> warm_up(
+        mpi_comm, n_ensembles, ensemble_synchronization);
+    TimeLoop<Description, dim, Number> time_loop(
+        mpi_comm, n_ensembles, ensemble_synchronization);
+    dealii::ParameterAcceptor::initialize(parameter_file);
+
+    prm.enter_subsection("A - TimeLoop");
+    const auto base_name = prm.get("basename");
+    const bool resume = prm.get_bool("resume");
+    prm.leave_subsection();
+
+    if (resume) {
+      time_loop.run();
+      return;
+    }
+
+    prm.enter_subsection("A - TimeLoop");
+    prm.set("basename", base_name + "-warm_up");
+    prm.set("final time", precision_switch_time);
+    prm.leave_subsection();
+    dealii::ParameterAcceptor::parse_all_parameters();
+
+    warm_up.keep_final_state() = true;
+    warm_up.run();
+
+    prm.parse_input(parameter_file);
+    dealii::ParameterAcceptor::parse_all_parameters();
+
+    time_loop.run(warm_up);
+  }
+#endif
+
+
+  /**
+   * Benchmark a set of runtime configurations for the given
+   * @p parameter_file: Every combination of the number of OpenMP threads
+   * per rank (powers of two up to the maximal number), the "loop
+   * schedule" (static or dynamic), and the "overlap limiter exchange"
+   * option runs the time loop up to the "tuning final time" with all
+   * output, checkpointing and mesh adaptation disabled. The mesh and
+   * offline data are set up once in an initial (untimed) run and reused
+   * afterwards. The wall time of every configuration and the fastest
+   * configuration are reported on rank 0.
+   */
+  template <typename Description, int dim, typename Number>
+  void tune_time_loop(const std::string &parameter_file,
+                      const MPI_Comm &mpi_comm)
+  {
+    auto &prm = dealii::ParameterAcceptor::prm;
+
+    TimeLoop<Description, dim, Number> time_loop(mpi_comm);
+    dealii::ParameterAcceptor::initialize(parameter_file);
+
+    prm.enter_subsection("B - Equation");
+    double final_time = prm.get_double("tuning final time");
+    prm.leave_subsection();
+
+    prm.enter_subsection("A - TimeLoop");
+    if (final_time <= 0.)
+      final_time = 0.01 * prm.get_double("final time");
+    const auto base_name = prm.get("basename");
+    prm.leave_subsection();
+
+    const auto set_parameters = [&](const std::string &schedule,
+                                    const bool overlap) {
+      prm.parse_input(parameter_file);
+
+      prm.enter_subsection("A - TimeLoop");
+      prm.set("basename", base_name + "-tune");
+      prm.set("final time", final_time);
+      prm.set("resume", false);
+      for (const std::string flag : {"enable checkpointing",
+                                     "enable output full",
+                                     "enable output levelsets",
+                                     "enable compute error",
+                                     "enable compute quantities",
+                                     "enable mesh adaptivity"})
+        prm.set(flag, false);
+      prm.set("terminal update interval", 0.);
+      prm.leave_subsection();
+
+      prm.enter_subsection("F - HyperbolicModule");
+      prm.set("loop schedule", schedule);
+      prm.set("overlap limiter exchange", overlap);
+      prm.leave_subsection();
+
+      dealii::ParameterAcceptor::parse_all_parameters();
+    };
+
+    const auto set_threads = [](const unsigned int n_threads) {
+#ifdef WITH_OPENMP
+      omp_set_num_threads(n_threads);
+#endif
+      dealii::MultithreadInfo::set_thread_limit(n_threads);
+    };
+
+#ifdef WITH_OPENMP
+    const unsigned int n_threads_max = omp_get_max_threads();
+#else
+    const unsigned int n_threads_max = 1;
+#endif
+
+    /* Set up mesh and offline data: */
+    set_parameters("static", false);
+    time_loop.run();
+
+    std::vector<std::tuple<unsigned int, std::string, bool, double>> results;
+
+    for (unsigned int n_threads = n_threads_max; n_threads > 0;
+         n_threads /= 2) {
+      for (const std::string schedule : {"static", "dynamic"}) {
+        for (const bool overlap : {false, true}) {
+          set_threads(n_threads);
+          set_parameters(schedule, overlap);
+
+          MPI_Barrier(mpi_comm);
+          const double start = MPI_Wtime();
+          time_loop.run();
+          const double wall_time =
+              dealii::Utilities::MPI::max(MPI_Wtime() - start, mpi_comm);
+
+          results.emplace_back(n_threads, schedule, overlap, wall_time);
+        }
+      }
+    }
+
+    set_threads(n_threads_max);
+
+    /* Report results: */
+
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(
+        mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    const auto ranks_per_node =
+        dealii::Utilities::MPI::n_mpi_processes(node_comm);
+    MPI_Comm_free(&node_comm);
+
+    if (dealii::Utilities::MPI::this_mpi_process(mpi_comm) != 0)
+      return;
+
+    char node_name[MPI_MAX_PROCESSOR_NAME];
+    int length;
+    MPI_Get_processor_name(node_name, &length);
+
+    std::cout << "[INFO] tuning results for node »" << node_name << "« with "
+              << dealii::Utilities::MPI::n_mpi_processes(mpi_comm)
+              << " MPI ranks (" << ranks_per_node << " per node):\n";
+
+    const auto print = [](const auto &result) {
+      const auto &[n_threads, schedule, overlap, wall_time] = result;
+      std::cout << "threads " << std::setw(4) << n_threads
+                << ", loop schedule " << std::setw(7) << schedule
+                << ", overlap limiter exchange " << std::setw(5)
+                << std::boolalpha << overlap << ": " << std::fixed
+                << std::setprecision(3) << wall_time << " s\n";
+    };
+
+    for (const auto &result : results) {
+      std::cout << "[INFO]     ";
+      print(result);
+    }
+
+    const auto best = std::min_element(
+        results.begin(),
+        results.end(),
+        [](const auto &left, const auto &right) {
+          return std::get<3>(left) < std::get<3>(right);
+        });
+    std::cout << "[INFO] fastest configuration: ";
+    print(*best);
+    std::cout << std::flush;
+  }
+
+
+  /**
+   * Create a TimeLoop for the specified equation Description, dimension
+   * and number type, read in the parameter file and run it. The
+   * @p n_ensembles ensembles advance in lockstep if
+   * @p ensemble_synchronization is set, and fully decoupled otherwise.
+   *
+   * If a nonempty list of @p samples is given, the MPI ranks are
+   * subdivided into @p n_ensembles independent ensembles. Every ensemble
+   * runs its own TimeLoop (over the ensemble communicator) and pulls
+   * samples from an EnsembleScheduler until all samples are processed.
+   * For every sample the parameters of the main @p parameter_file are
+   * read first and then overridden by the parameters of the sample. If
+   * the sample does not set a base name, the base name is suffixed by
+   * "-sample_n". The TimeLoop reuses the mesh and the offline data of the
+   * previous sample if possible, see TimeLoop::run().
+   *
+   * A positive @p precision_switch_time computes the initial transient in
+   * single precision, see run_time_loop_with_precision_switch(). If
+   * @p tune is set, tune_time_loop() is called instead.
+   */
+  template <typename Description, int dim, typename Number>
+  void run_time_loop(const std::string &parameter_file,
+                     const MPI_Comm &mpi_comm,
+                     const int n_ensembles,
+                     const bool ensemble_synchronization,
+                     const std::vector<std::string> &samples,
+                     const double precision_switch_time,
+                     const bool tune)
+  {
+    auto &prm = dealii::ParameterAcceptor::prm;
+
+    if (tune) {
+      tune_time_loop<Description, dim, Number>(parameter_file, mpi_comm);
+      return;
+    }
+
+    if (precision_switch_time > 0.) {
+#ifdef PRECISION_SWITCH
+      AssertThrow(samples.empty(),
+                  dealii::ExcMessage(
+                      dave + "A precision switch is not supported for a list "
+                             "of samples.\n"));
+      run_time_loop_with_precision_switch<Description, dim, Number>(
+          parameter_file,
+          mpi_comm,
+          n_ensembles,
+          ensemble_synchronization,
+          precision_switch_time);
+      return;
+#else
+      AssertThrow(false,
+                  dealii::ExcMessage(
+                      dave + "A precision switch requires ryujin to be "
+                             "configured with PRECISION_SWITCH.\n"));
+#endif
+    }
+
+    if (samples.empty()) {
+      TimeLoop<Description, dim, Number> time_loop(
+          mpi_comm, n_ensembles, ensemble_synchronization);
+      dealii::ParameterAcceptor::initialize(parameter_file);
+      time_loop.run();
+      return;
+    }
+
+    MPIEnsemble mpi_ensemble(mpi_comm,
+                             n_ensembles,
+                             /* global synchronization */ false);
+    EnsembleScheduler scheduler(mpi_ensemble, samples.size());
+
+    TimeLoop<Description, dim, Number> time_loop(
+        mpi_ensemble.ensemble_communicator());
+    dealii::ParameterAcceptor::initialize(parameter_file);
+
+    prm.enter_subsection("A - TimeLoop");
+    const auto base_name = prm.get("basename");
+    prm.leave_subsection();
+
+    const unsigned int digits =
+        dealii::Utilities::needed_digits(samples.size());
+
+    for (auto sample = scheduler.next_sample(); sample < samples.size();
+         sample = scheduler.next_sample()) {
+
+      if (mpi_ensemble.ensemble_rank() == 0) {
+        std::cout << "[INFO] ensemble " << mpi_ensemble.ensemble()
+                  << ": running sample " << sample << " »" << samples[sample]
+                  << "«" << std::endl;
+      }
+
+      prm.parse_input(parameter_file);
+
+      prm.enter_subsection("A - TimeLoop");
+      prm.set("basename", base_name);
+      prm.leave_subsection();
+
+      prm.parse_input(samples[sample]);
+
+      prm.enter_subsection("A - TimeLoop");
+      if (prm.get("basename") == base_name)
+        prm.set("basename",
+                base_name + "-sample_" +
+                    dealii::Utilities::int_to_string(sample, digits));
+      prm.leave_subsection();
+
+      dealii::ParameterAcceptor::parse_all_parameters();
+
+      time_loop.run();
+    }
+  }
+
+
   /**
    * A small Dispatch struct templated in Description that registers the
    * call backs.
@@ -277,6 +660,11 @@ namespace ryujin
                  const std::string &equation,
                  const std::string &parameter_file,
                  const MPI_Comm &mpi_comm,
+                 const int n_ensembles,
+                 const bool ensemble_synchronization,
+                 const std::vector<std::string> &samples,
+                 const double precision_switch_time,
+                 const bool tune,
                  bool &time_loop_executed) {
             if (equation != name)
               return;
@@ -294,19 +682,34 @@ namespace ryujin
                             equation + "«"));
 
             if (dimension == 1) {
-              TimeLoop<Description, 1, Number> time_loop(mpi_comm);
-              dealii::ParameterAcceptor::initialize(parameter_file);
-              time_loop.run();
+              run_time_loop<Description, 1, Number>(
+                  parameter_file,
+                  mpi_comm,
+                  n_ensembles,
+                  ensemble_synchronization,
+                  samples,
+                  precision_switch_time,
+                  tune);
               time_loop_executed = true;
             } else if (dimension == 2) {
-              TimeLoop<Description, 2, Number> time_loop(mpi_comm);
-              dealii::ParameterAcceptor::initialize(parameter_file);
-              time_loop.run();
+              run_time_loop<Description, 2, Number>(
+                  parameter_file,
+                  mpi_comm,
+                  n_ensembles,
+                  ensemble_synchronization,
+                  samples,
+                  precision_switch_time,
+                  tune);
               time_loop_executed = true;
             } else if (dimension == 3) {
-              TimeLoop<Description, 3, Number> time_loop(mpi_comm);
-              dealii::ParameterAcceptor::initialize(parameter_file);
-              time_loop.run();
+              run_time_loop<Description, 3, Number>(
+                  parameter_file,
+                  mpi_comm,
+                  n_ensembles,
+                  ensemble_synchronization,
+                  samples,
+                  precision_switch_time,
+                  tune);
               time_loop_executed = true;
             }
           });
@@ -14,6 +14,7 @@
 #include <simd.h>
 #include <state_vector.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/tensor.h>
 
@@ -134,7 +135,11 @@ namespace ryujin
 
       DEAL_II_ALWAYS_INLINE inline ScalarNumber gamma() const
       {
+#ifdef EULER_FIXED_GAMMA
+        return ScalarNumber(fixed_gamma);
+#else
         return hyperbolic_system_.gamma_;
+#endif
       }
 
       DEAL_II_ALWAYS_INLINE inline ScalarNumber reference_density() const
@@ -166,26 +171,51 @@ namespace ryujin
 
       DEAL_II_ALWAYS_INLINE inline ScalarNumber gamma_inverse() const
       {
+#ifdef EULER_FIXED_GAMMA
+        return ScalarNumber(1. / fixed_gamma);
+#else
         return ScalarNumber(hyperbolic_system_.gamma_inverse_);
+#endif
       }
 
       DEAL_II_ALWAYS_INLINE inline ScalarNumber gamma_plus_one_inverse() const
       {
+#ifdef EULER_FIXED_GAMMA
+        return ScalarNumber(1. / (fixed_gamma + 1.));
+#else
         return ScalarNumber(hyperbolic_system_.gamma_plus_one_inverse_);
+#endif
       }
 
       DEAL_II_ALWAYS_INLINE inline ScalarNumber gamma_minus_one_inverse() const
       {
+#ifdef EULER_FIXED_GAMMA
+        return ScalarNumber(1. / (fixed_gamma - 1.));
+#else
         return ScalarNumber(hyperbolic_system_.gamma_minus_one_inverse_);
+#endif
       }
 
       DEAL_II_ALWAYS_INLINE inline ScalarNumber
       gamma_minus_one_over_gamma_plus_one() const
       {
+#ifdef EULER_FIXED_GAMMA
+        return ScalarNumber((fixed_gamma - 1.) / (fixed_gamma + 1.));
+#else
         return ScalarNumber(
             hyperbolic_system_.gamma_minus_one_over_gamma_plus_one_);
+#endif
       }
 
+#ifdef EULER_FIXED_GAMMA
+      /**
+       * The ratio of specific heats fixed at compile time with the
+       * EULER_FIXED_GAMMA option. All gamma expressions above reduce to
+       * compile-time constants in this case.
+       */
+      static constexpr double fixed_gamma = EULER_FIXED_GAMMA;
+#endif
+
       /**
        * constexpr boolean used in the EulerInitialStates namespace
        */
@@ -266,7 +296,7 @@ namespace ryujin
       /**
        * The number of precomputed values.
        */
-      static constexpr unsigned int n_precomputed_values = 2;
+      static constexpr unsigned int n_precomputed_values = 5;
 
       /**
        * Array type used for precomputed values.
@@ -277,7 +307,18 @@ namespace ryujin
        * An array holding all component names of the precomputed values.
        */
       static inline const auto precomputed_names =
-          std::array<std::string, n_precomputed_values>{"s", "eta_h"};
+          std::array<std::string, n_precomputed_values>{
+              "s", "eta_h", "p", "rho_inverse", "a"};
+
+      /**
+       * The components of the precomputed values that are read at
+       * neighboring degrees of freedom: s (in the Limiter), eta_h, p and
+       * rho_inverse (in the Indicator), and p, rho_inverse and a (in the
+       * RiemannSolver). Only these components are exchanged over MPI
+       * ranks.
+       */
+      static constexpr std::array<unsigned int, 5>
+          precomputed_ghost_components{{0, 1, 2, 3, 4}};
 
       /**
        * The number of precomputed initial values.
@@ -529,6 +570,15 @@ namespace ryujin
        */
       flux_type f(const state_type &U) const;
 
+      /**
+       * Variant of f() for a state @p U with given inverse density
+       * @p rho_inverse and pressure @p p, for example taken from the
+       * precomputed values.
+       */
+      flux_type f(const state_type &U,
+                  const Number &rho_inverse,
+                  const Number &p) const;
+
       /**
        * Given a state @p U_i and an index @p i compute flux contributions.
        *
@@ -596,6 +646,9 @@ namespace ryujin
                               const state_type &U_j,
                               const ScalarNumber tau) const = delete;
 
+      /** We do not have implicit source terms */
+      static constexpr bool have_implicit_source_terms = false;
+
       //@}
       /**
        * @name State transformations
@@ -631,6 +684,14 @@ namespace ryujin
       template <typename ST>
       state_type from_initial_state(const ST &initial_state) const;
 
+      /**
+       * Variant of above function converting a batch of (full) primitive
+       * initial states [rho, u_1, ..., u_d, p] into conserved states in
+       * place.
+       */
+      void
+      from_initial_states(const dealii::ArrayView<state_type> &states) const;
+
       /**
        * Given a primitive state [rho, u_1, ..., u_d, p] return a conserved
        * state
@@ -665,7 +726,11 @@ namespace ryujin
     inline HyperbolicSystem::HyperbolicSystem(const std::string &subsection)
         : ParameterAcceptor(subsection)
     {
+#ifdef EULER_FIXED_GAMMA
+      gamma_ = EULER_FIXED_GAMMA;
+#else
       gamma_ = 7. / 5.;
+#endif
       add_parameter("gamma", gamma_, "The ratio of specific heats");
 
       reference_density_ = 1.;
@@ -688,6 +753,13 @@ namespace ryujin
        * divisions:
        */
       const auto compute_inverses = [this] {
+#ifdef EULER_FIXED_GAMMA
+        AssertThrow(
+            std::abs(gamma_ - double(EULER_FIXED_GAMMA)) < 1.e-12,
+            dealii::ExcMessage("ryujin was configured with EULER_FIXED_GAMMA "
+                               "and the parameter \"gamma\" must match the "
+                               "compile-time value."));
+#endif
         gamma_inverse_ = 1. / gamma_;
         gamma_plus_one_inverse_ = 1. / (gamma_ + 1.);
         gamma_minus_one_inverse_ = 1. / (gamma_ - 1.);
@@ -730,8 +802,14 @@ namespace ryujin
         dispatch_check(i);
 
         const auto U_i = U.template get_tensor<Number>(i);
+        const auto p_i = pressure(U_i);
+        const auto rho_i_inverse = ScalarNumber(1.) / density(U_i);
+        const auto a_i = std::sqrt(gamma() * p_i * rho_i_inverse);
         const precomputed_type prec_i{specific_entropy(U_i),
-                                      harten_entropy(U_i)};
+                                      harten_entropy(U_i),
+                                      p_i,
+                                      rho_i_inverse,
+                                      a_i};
         precomputed.template write_tensor<Number>(prec_i, i);
       }
     }
@@ -1172,9 +1250,17 @@ namespace ryujin
     DEAL_II_ALWAYS_INLINE inline auto
     HyperbolicSystemView<dim, Number>::f(const state_type &U) const -> flux_type
     {
-      const auto rho_inverse = ScalarNumber(1.) / density(U);
+      return f(U, ScalarNumber(1.) / density(U), pressure(U));
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline auto
+    HyperbolicSystemView<dim, Number>::f(const state_type &U,
+                                         const Number &rho_inverse,
+                                         const Number &p) const -> flux_type
+    {
       const auto m = momentum(U);
-      const auto p = pressure(U);
       const auto E = total_energy(U);
 
       flux_type result;
@@ -1259,6 +1345,15 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    inline void HyperbolicSystemView<dim, Number>::from_initial_states(
+        const dealii::ArrayView<state_type> &states) const
+    {
+      for (auto &state : states)
+        state = from_primitive_state(state);
+    }
+
+
     template <int dim, typename Number>
     DEAL_II_ALWAYS_INLINE inline auto
     HyperbolicSystemView<dim, Number>::from_primitive_state(
@@ -136,9 +136,12 @@ namespace ryujin
 
       /**
        * Reset temporary storage and initialize for a new row corresponding
-       * to state vector U_i.
+       * to state vector U_i. The index @p i is either the first index of a
+       * contiguous range, or (for a SIMD vectorized state) an array of
+       * individual indices, see HyperbolicModule::step().
        */
-      void reset(const unsigned int i, const state_type &U_i);
+      template <typename Index>
+      void reset(const Index i, const state_type &U_i);
 
       /**
        * When looping over the sparsity row, add the contribution associated
@@ -185,23 +188,23 @@ namespace ryujin
 
 
     template <int dim, typename Number>
+    template <typename Index>
     DEAL_II_ALWAYS_INLINE inline void
-    Indicator<dim, Number>::reset(const unsigned int i, const state_type &U_i)
+    Indicator<dim, Number>::reset(const Index i, const state_type &U_i)
     {
       /* Entropy viscosity commutator: */
 
       const auto view = hyperbolic_system.view<dim, Number>();
 
-      const auto &[new_s_i, new_eta_i] =
+      const auto &[new_s_i, new_eta_i, p_i, new_rho_i_inverse, a_i] =
           precomputed_values.template get_tensor<Number, precomputed_type>(i);
 
-      const auto rho_i = view.density(U_i);
-      rho_i_inverse = Number(1.) / rho_i;
+      rho_i_inverse = new_rho_i_inverse;
       eta_i = new_eta_i;
 
       d_eta_i = view.harten_entropy_derivative(U_i);
       d_eta_i[0] -= eta_i * rho_i_inverse;
-      f_i = view.f(U_i);
+      f_i = view.f(U_i, rho_i_inverse, p_i);
 
       left = 0.;
       right = 0.;
@@ -218,14 +221,16 @@ namespace ryujin
 
       const auto view = hyperbolic_system.view<dim, Number>();
 
-      const auto &[s_j, eta_j] =
+      /*
+       * The pressure and the inverse density of the neighbor are
+       * precomputed once per degree of freedom, see
+       * HyperbolicSystemView::precomputation_loop():
+       */
+      const auto &[s_j, eta_j, p_j, rho_j_inverse, a_j] =
           precomputed_values.template get_tensor<Number, precomputed_type>(js);
 
-      const auto rho_j = view.density(U_j);
-      const auto rho_j_inverse = Number(1.) / rho_j;
-
       const auto m_j = view.momentum(U_j);
-      const auto f_j = view.f(U_j);
+      const auto f_j = view.f(U_j, rho_j_inverse, p_j);
 
       const auto entropy_flux =
           (eta_j * rho_j_inverse - eta_i * rho_i_inverse) * (m_j * c_ij);
@@ -37,6 +37,8 @@ namespace ryujin
           : InitialState<Description, dim, Number>("astro jet", subsection)
           , hyperbolic_system_(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         gamma_ = 5. / 3.;
         if constexpr (!View::have_gamma) {
           this->add_parameter("gamma", gamma_, "The ratio of specific heats");
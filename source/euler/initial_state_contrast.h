@@ -35,6 +35,8 @@ namespace ryujin
           : InitialState<Description, dim, Number>("contrast", subsection)
           , hyperbolic_system_(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         primitive_left_[0] = 1.4;
         primitive_left_[1] = 0.;
         primitive_left_[2] = 1.;
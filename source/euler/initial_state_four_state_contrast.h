@@ -39,6 +39,8 @@ namespace ryujin
                                                    subsection)
           , hyperbolic_system_(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         primitive_bottom_left_[0] = 1.4;
         primitive_bottom_left_[1] = 0.;
         primitive_bottom_left_[2] = 0.;
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <compiled_expression.h>
 #include <initial_state_library.h>
 
 #include <deal.II/base/function_parser.h>
@@ -22,6 +23,8 @@ namespace ryujin
     class Function : public InitialState<Description, dim, Number>
     {
     public:
+      using InitialState<Description, dim, Number>::compute;
+
       using HyperbolicSystem = typename Description::HyperbolicSystem;
       using View =
           typename Description::template HyperbolicSystemView<dim, Number>;
@@ -67,7 +70,8 @@ namespace ryujin
 
         /*
          * Set up the muparser object with the final flux description from
-         * the parameter file:
+         * the parameter file. If possible, we also compile the expressions
+         * into CompiledExpression objects that are used instead:
          */
         const auto set_up_muparser = [this] {
           using FP = dealii::FunctionParser<dim>;
@@ -83,6 +87,23 @@ namespace ryujin
           if constexpr (dim > 2)
             velocity_z_function_ = std::make_unique<FP>(velocity_z_expression_);
           pressure_function_ = std::make_unique<FP>(pressure_expression_);
+
+          const auto variables =
+              CompiledExpression::coordinate_variables<dim>();
+          compiled_ =
+              density_compiled_.initialize(density_expression_, variables) &&
+              velocity_x_compiled_.initialize(velocity_x_expression_,
+                                              variables) &&
+              pressure_compiled_.initialize(pressure_expression_, variables);
+          if constexpr (dim > 1)
+            compiled_ = compiled_ && velocity_y_compiled_.initialize(
+                                         velocity_y_expression_, variables);
+          if constexpr (dim > 2)
+            compiled_ = compiled_ && velocity_z_compiled_.initialize(
+                                         velocity_z_expression_, variables);
+
+          /* Only the compiled expressions can be evaluated concurrently: */
+          this->thread_safe_ = compiled_;
         };
 
         set_up_muparser();
@@ -94,27 +115,75 @@ namespace ryujin
         const auto view = hyperbolic_system_.template view<dim, Number>();
         state_type full_primitive_state;
 
-        density_function_->set_time(t);
-        full_primitive_state[0] = density_function_->value(point);
+        const auto evaluate = [&](const auto &compiled, auto &function) {
+          if (compiled_)
+            return compiled.value(point, t);
+          function->set_time(t);
+          return function->value(point);
+        };
 
-        velocity_x_function_->set_time(t);
-        full_primitive_state[1] = velocity_x_function_->value(point);
+        full_primitive_state[0] =
+            evaluate(density_compiled_, density_function_);
+        full_primitive_state[1] =
+            evaluate(velocity_x_compiled_, velocity_x_function_);
 
         if constexpr (dim > 1) {
-          velocity_y_function_->set_time(t);
-          full_primitive_state[2] = velocity_y_function_->value(point);
+          full_primitive_state[2] =
+              evaluate(velocity_y_compiled_, velocity_y_function_);
         }
         if constexpr (dim > 2) {
-          velocity_z_function_->set_time(t);
-          full_primitive_state[3] = velocity_z_function_->value(point);
+          full_primitive_state[3] =
+              evaluate(velocity_z_compiled_, velocity_z_function_);
         }
 
-        pressure_function_->set_time(t);
-        full_primitive_state[1 + dim] = pressure_function_->value(point);
+        full_primitive_state[1 + dim] =
+            evaluate(pressure_compiled_, pressure_function_);
 
         return view.from_initial_state(full_primitive_state);
       }
 
+      void compute(const dealii::ArrayView<state_type> &states,
+                   const dealii::ArrayView<const dealii::Point<dim>> &points,
+                   Number t) final
+      {
+        if (!compiled_) {
+          InitialState<Description, dim, Number>::compute(states, points, t);
+          return;
+        }
+
+        const auto view = hyperbolic_system_.template view<dim, Number>();
+
+        std::array<const CompiledExpression *, 2 + dim> expressions;
+        expressions[0] = &density_compiled_;
+        expressions[1] = &velocity_x_compiled_;
+        if constexpr (dim > 1)
+          expressions[2] = &velocity_y_compiled_;
+        if constexpr (dim > 2)
+          expressions[3] = &velocity_z_compiled_;
+        expressions[1 + dim] = &pressure_compiled_;
+
+        constexpr auto batch_size = CompiledExpression::batch_size;
+        std::array<std::array<double, batch_size>, 2 + dim> values;
+
+        for (unsigned int offset = 0; offset < points.size();
+             offset += batch_size) {
+          const unsigned int n = std::min<unsigned int>(
+              batch_size, points.size() - offset);
+          const dealii::ArrayView<const dealii::Point<dim>> batch(
+              points.data() + offset, n);
+
+          for (unsigned int c = 0; c < 2 + dim; ++c)
+            expressions[c]->evaluate(values[c].data(), batch, t);
+
+          for (unsigned int k = 0; k < n; ++k)
+            for (unsigned int c = 0; c < 2 + dim; ++c)
+              states[offset + k][c] = values[c][k];
+        }
+
+        /* Convert all states at once to batch equation of state calls: */
+        view.from_initial_states(states);
+      }
+
     private:
       const HyperbolicSystem &hyperbolic_system_;
 
@@ -129,6 +198,13 @@ namespace ryujin
       std::unique_ptr<dealii::FunctionParser<dim>> velocity_y_function_;
       std::unique_ptr<dealii::FunctionParser<dim>> velocity_z_function_;
       std::unique_ptr<dealii::FunctionParser<dim>> pressure_function_;
+
+      bool compiled_;
+      CompiledExpression density_compiled_;
+      CompiledExpression velocity_x_compiled_;
+      CompiledExpression velocity_y_compiled_;
+      CompiledExpression velocity_z_compiled_;
+      CompiledExpression pressure_compiled_;
     };
   } // namespace EulerInitialStates
 } // namespace ryujin
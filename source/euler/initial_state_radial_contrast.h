@@ -40,6 +40,8 @@ namespace ryujin
                                                    subsection)
           , hyperbolic_system_(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         primitive_inner_[0] = 1.4;
         primitive_inner_[1] = 0.0;
         primitive_inner_[2] = 1.;
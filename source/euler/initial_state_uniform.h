@@ -34,6 +34,8 @@ namespace ryujin
           : InitialState<Description, dim, Number>("uniform", subsection)
           , hyperbolic_system_(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         primitive_[0] = 1.4;
         primitive_[1] = 3.;
         primitive_[2] = 1.;
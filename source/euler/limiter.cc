@@ -17,8 +17,18 @@ namespace ryujin
     template class Limiter<2, NUMBER>;
     template class Limiter<3, NUMBER>;
 
-    template class Limiter<1, dealii::VectorizedArray<NUMBER>>;
-    template class Limiter<2, dealii::VectorizedArray<NUMBER>>;
-    template class Limiter<3, dealii::VectorizedArray<NUMBER>>;
+    template class Limiter<1, VectorizedArrayType<NUMBER>>;
+    template class Limiter<2, VectorizedArrayType<NUMBER>>;
+    template class Limiter<3, VectorizedArrayType<NUMBER>>;
+
+#ifdef PRECISION_SWITCH
+    template class Limiter<1, float>;
+    template class Limiter<2, float>;
+    template class Limiter<3, float>;
+
+    template class Limiter<1, VectorizedArrayType<float>>;
+    template class Limiter<2, VectorizedArrayType<float>>;
+    template class Limiter<3, VectorizedArrayType<float>>;
+#endif
   } // namespace Euler
 } // namespace ryujin
@@ -261,7 +261,7 @@ namespace ryujin
     {
       const auto view = hyperbolic_system.view<dim, Number>();
       const auto rho_i = view.density(U_i);
-      const auto &[s_i, eta_i] =
+      const auto &[s_i, eta_i, p_i, rho_i_inverse, a_i] =
           precomputed_values.template get_tensor<Number, precomputed_type>(i);
 
       return {/*rho_min*/ rho_i, /*rho_max*/ rho_i, /*s_min*/ s_i};
@@ -339,7 +339,7 @@ namespace ryujin
       rho_min = std::min(rho_min, rho_ij_bar);
       rho_max = std::max(rho_max, rho_ij_bar);
 
-      const auto &[s_j, eta_j] =
+      const auto &[s_j, eta_j, p_j, rho_j_inverse, a_j] =
           precomputed_values.template get_tensor<Number, precomputed_type>(js);
       s_min = std::min(s_min, s_j);
 
@@ -130,6 +130,17 @@ namespace ryujin
                      const unsigned int *js,
                      const dealii::Tensor<1, dim, Number> &n_ij) const;
 
+      /**
+       * Variant of above function for a (SIMD vectorized) state U_i that
+       * is associated with individual indices @p is instead of a
+       * contiguous range of indices starting at i.
+       */
+      Number compute(const state_type &U_i,
+                     const state_type &U_j,
+                     const unsigned int *is,
+                     const unsigned int *js,
+                     const dealii::Tensor<1, dim, Number> &n_ij) const;
+
       //@}
 
     protected:
@@ -272,6 +283,18 @@ namespace ryujin
       riemann_data_from_state(const state_type &U,
                               const dealii::Tensor<1, dim, Number> &n_ij) const;
 
+      /**
+       * Variant of above function that takes the pressure, the inverse
+       * density and the speed of sound from the precomputed values @p
+       * prec (see HyperbolicSystemView::precomputation_loop()). All three
+       * quantities are invariant under the projection onto the 1D Riemann
+       * problem, so that only the momentum has to be projected onto n_ij.
+       */
+      primitive_type
+      riemann_data_from_state(const state_type &U,
+                              const precomputed_type &prec,
+                              const dealii::Tensor<1, dim, Number> &n_ij) const;
+
     private:
       const HyperbolicSystem &hyperbolic_system;
       const Parameters &parameters;
@@ -403,6 +403,24 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline auto
+    RiemannSolver<dim, Number>::riemann_data_from_state(
+        const state_type &U,
+        const precomputed_type &prec,
+        const dealii::Tensor<1, dim, Number> &n_ij) const -> primitive_type
+    {
+      const auto view = hyperbolic_system.view<dim, Number>();
+
+      const auto &[s, eta, p, rho_inverse, a] = prec;
+
+      const auto rho = view.density(U);
+      const auto proj_m = n_ij * view.momentum(U);
+
+      return {{rho, proj_m * rho_inverse, p, a}};
+    }
+
+
     template <int dim, typename Number>
     Number RiemannSolver<dim, Number>::compute(
         const primitive_type &riemann_data_i,
@@ -537,10 +555,11 @@ namespace ryujin
       std::cout << "l_m: (start) " << lambda_max << std::endl;
 #endif
 
+      const Number tolerance(parameters.newton_tolerance());
+
       for (unsigned int i = 0; i < parameters.newton_max_iterations(); ++i) {
 
         /* We accept our current guess if we reach the tolerance... */
-        const Number tolerance(parameters.newton_tolerance());
         if (std::max(Number(0.), gap - tolerance) == Number(0.)) {
 #ifdef DEBUG_RIEMANN_SOLVER
           std::cout << "converged after " << i << " iterations." << std::endl;
@@ -554,13 +573,41 @@ namespace ryujin
         const Number dphi_p_1 = dphi(riemann_data_i, riemann_data_j, p_1);
         const Number dphi_p_2 = dphi(riemann_data_i, riemann_data_j, p_2);
 
-        quadratic_newton_step(p_1, p_2, phi_p_1, phi_p_2, dphi_p_1, dphi_p_2);
+        auto p_1_new = p_1;
+        auto p_2_new = p_2;
+        quadratic_newton_step(
+            p_1_new, p_2_new, phi_p_1, phi_p_2, dphi_p_1, dphi_p_2);
 
         /* Update  lambda_max and gap: */
         auto [gap_new, lambda_max_new] =
-            compute_gap(riemann_data_i, riemann_data_j, p_1, p_2);
-        gap = gap_new;
-        lambda_max = lambda_max_new;
+            compute_gap(riemann_data_i, riemann_data_j, p_1_new, p_2_new);
+
+        if constexpr (std::is_same_v<ScalarNumber, Number>) {
+          p_1 = p_1_new;
+          p_2 = p_2_new;
+          gap = gap_new;
+          lambda_max = lambda_max_new;
+
+        } else {
+          /*
+           * Retire all lanes that have already converged: Their bracket
+           * [p_1, p_2], gap and lambda_max are left untouched so that
+           * every lane returns exactly the result of the scalar
+           * iteration, independently of the convergence of the other
+           * lanes.
+           */
+          using dealii::SIMDComparison;
+          const auto retire = [&](const Number &old_value,
+                                  const Number &new_value) {
+            return dealii::compare_and_apply_mask<
+                SIMDComparison::less_than_or_equal>(
+                gap, tolerance, old_value, new_value);
+          };
+          p_1 = retire(p_1, p_1_new);
+          p_2 = retire(p_2, p_2_new);
+          lambda_max = retire(lambda_max, lambda_max_new);
+          gap = retire(gap, gap_new);
+        }
 
 #ifdef DEBUG_RIEMANN_SOLVER
         std::cout << "phi_p_1:     " << phi_p_1 << std::endl;
@@ -586,12 +633,37 @@ namespace ryujin
     DEAL_II_ALWAYS_INLINE inline Number RiemannSolver<dim, Number>::compute(
         const state_type &U_i,
         const state_type &U_j,
-        const unsigned int /*i*/,
-        const unsigned int * /*js*/,
+        const unsigned int i,
+        const unsigned int *js,
+        const dealii::Tensor<1, dim, Number> &n_ij) const
+    {
+      const auto prec_i =
+          precomputed_values.template get_tensor<Number, precomputed_type>(i);
+      const auto prec_j =
+          precomputed_values.template get_tensor<Number, precomputed_type>(js);
+
+      const auto riemann_data_i = riemann_data_from_state(U_i, prec_i, n_ij);
+      const auto riemann_data_j = riemann_data_from_state(U_j, prec_j, n_ij);
+
+      return compute(riemann_data_i, riemann_data_j);
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline Number RiemannSolver<dim, Number>::compute(
+        const state_type &U_i,
+        const state_type &U_j,
+        const unsigned int *is,
+        const unsigned int *js,
         const dealii::Tensor<1, dim, Number> &n_ij) const
     {
-      const auto riemann_data_i = riemann_data_from_state(U_i, n_ij);
-      const auto riemann_data_j = riemann_data_from_state(U_j, n_ij);
+      const auto prec_i =
+          precomputed_values.template get_tensor<Number, precomputed_type>(is);
+      const auto prec_j =
+          precomputed_values.template get_tensor<Number, precomputed_type>(js);
+
+      const auto riemann_data_i = riemann_data_from_state(U_i, prec_i, n_ij);
+      const auto riemann_data_j = riemann_data_from_state(U_j, prec_j, n_ij);
 
       return compute(riemann_data_i, riemann_data_j);
     }
@@ -13,7 +13,9 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
+#include <cmath>
 #include <string>
 
 namespace ryujin
@@ -24,6 +26,12 @@ namespace ryujin
      * A small abstract base class to group configuration options for an
      * equation of state.
      *
+     * Derived classes implement their formulas as function templates that
+     * can be called with double, float, and VectorizedArray arguments. The
+     * (final) overrides of the EquationOfState interface forward to them.
+     * HyperbolicSystemView calls the templates directly, which avoids the
+     * virtual call and the lane by lane evaluation.
+     *
      * @ingroup EulerEquations
      */
     class EquationOfState : public dealii::ParameterAcceptor
@@ -7,6 +7,8 @@
 
 #include "equation_of_state.h"
 
+#include <compiled_expression.h>
+
 #include <deal.II/base/function_parser.h>
 
 namespace ryujin
@@ -76,7 +78,11 @@ namespace ryujin
 
         /*
          * Set up the muparser object with the final equation of state
-         * description from the parameter file:
+         * description from the parameter file. In addition, we try to
+         * compile all expressions into CompiledExpression objects for
+         * faster (batched) evaluation. If any of the expressions uses
+         * syntax not supported by CompiledExpression we fall back to
+         * muparser:
          */
         const auto set_up_muparser = [this] {
           p_function_ = std::make_unique<dealii::FunctionParser<2>>();
@@ -91,6 +97,12 @@ namespace ryujin
 
           sos_function_ = std::make_unique<dealii::FunctionParser<2>>();
           sos_function_->initialize("rho,e", sos_expression_, {});
+
+          compiled_ = p_compiled_.initialize(p_expression_, {"rho", "e"}) &&
+                      sie_compiled_.initialize(sie_expression_, {"rho", "p"}) &&
+                      temperature_compiled_.initialize(temperature_expression_,
+                                                       {"rho", "e"}) &&
+                      sos_compiled_.initialize(sos_expression_, {"rho", "e"});
         };
 
         set_up_muparser();
@@ -99,25 +111,90 @@ namespace ryujin
 
       double pressure(double rho, double e) const final
       {
+        if (compiled_)
+          return p_compiled_.value({rho, e});
         return p_function_->value(dealii::Point<2>(rho, e));
       }
 
+      void pressure(const dealii::ArrayView<double> &p,
+                    const dealii::ArrayView<double> &rho,
+                    const dealii::ArrayView<double> &e) const final
+      {
+        if (!compiled_) {
+          EquationOfState::pressure(p, rho, e);
+          return;
+        }
+        evaluate(p_compiled_, p, rho, e);
+      }
+
       double specific_internal_energy(double rho, double p) const final
       {
+        if (compiled_)
+          return sie_compiled_.value({rho, p});
         return sie_function_->value(dealii::Point<2>(rho, p));
       }
 
+      void
+      specific_internal_energy(const dealii::ArrayView<double> &e,
+                               const dealii::ArrayView<double> &rho,
+                               const dealii::ArrayView<double> &p) const final
+      {
+        if (!compiled_) {
+          EquationOfState::specific_internal_energy(e, rho, p);
+          return;
+        }
+        evaluate(sie_compiled_, e, rho, p);
+      }
+
       double temperature(double rho, double e) const final
       {
+        if (compiled_)
+          return temperature_compiled_.value({rho, e});
         return temperature_function_->value(dealii::Point<2>(rho, e));
       }
 
+      void temperature(const dealii::ArrayView<double> &T,
+                       const dealii::ArrayView<double> &rho,
+                       const dealii::ArrayView<double> &e) const final
+      {
+        if (!compiled_) {
+          EquationOfState::temperature(T, rho, e);
+          return;
+        }
+        evaluate(temperature_compiled_, T, rho, e);
+      }
+
       double speed_of_sound(double rho, double e) const final
       {
+        if (compiled_)
+          return sos_compiled_.value({rho, e});
         return sos_function_->value(dealii::Point<2>(rho, e));
       }
 
+      void speed_of_sound(const dealii::ArrayView<double> &c,
+                          const dealii::ArrayView<double> &rho,
+                          const dealii::ArrayView<double> &e) const final
+      {
+        if (!compiled_) {
+          EquationOfState::speed_of_sound(c, rho, e);
+          return;
+        }
+        evaluate(sos_compiled_, c, rho, e);
+      }
+
     private:
+      static void evaluate(const CompiledExpression &expression,
+                           const dealii::ArrayView<double> &result,
+                           const dealii::ArrayView<double> &first,
+                           const dealii::ArrayView<double> &second)
+      {
+        Assert(result.size() == first.size() && first.size() == second.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        const double *variables[] = {first.data(), second.data()};
+        expression.evaluate(result.data(), variables, result.size());
+      }
+
       std::string p_expression_;
       std::string sie_expression_;
       std::string sos_expression_;
@@ -127,6 +204,12 @@ namespace ryujin
       std::unique_ptr<dealii::FunctionParser<2>> sie_function_;
       std::unique_ptr<dealii::FunctionParser<2>> sos_function_;
       std::unique_ptr<dealii::FunctionParser<2>> temperature_function_;
+
+      bool compiled_;
+      CompiledExpression p_compiled_;
+      CompiledExpression sie_compiled_;
+      CompiledExpression sos_compiled_;
+      CompiledExpression temperature_compiled_;
     };
   } // namespace EquationOfStateLibrary
 } // namespace ryujin
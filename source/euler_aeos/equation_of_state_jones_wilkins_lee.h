@@ -56,6 +56,8 @@ namespace ryujin
             "c_v", cv_, "The specific heat capacity at constant volume");
       }
 
+      /* Function templates and final overrides, see EquationOfState: */
+
       /**
        * The pressure is given by
        * \f{align}
@@ -64,17 +66,25 @@ namespace ryujin
        *     + \omega \rho (e + q_0)
        * \f}
        */
-      double pressure(double rho, double e) const final
+      template <typename Number>
+      Number pressure(const Number &rho, const Number &e) const
       {
+        const auto ratio = rho / Number(rho_0);
 
-        const auto ratio = rho / rho_0;
+        const auto first_term = Number(capA) *
+                                (Number(1.) - Number(omega / R1) * ratio) *
+                                std::exp(Number(-R1) / ratio);
+        const auto second_term = Number(capB) *
+                                 (Number(1.) - Number(omega / R2) * ratio) *
+                                 std::exp(Number(-R2) / ratio);
 
-        const auto first_term =
-            capA * (1. - omega / R1 * ratio) * std::exp(-R1 * 1. / ratio);
-        const auto second_term =
-            capB * (1. - omega / R2 * ratio) * std::exp(-R2 * 1. / ratio);
+        return first_term + second_term +
+               Number(omega) * rho * (e + Number(q_0));
+      }
 
-        return first_term + second_term + omega * rho * (e + q_0);
+      double pressure(double rho, double e) const final
+      {
+        return pressure<double>(rho, e);
       }
 
       /**
@@ -85,16 +95,24 @@ namespace ryujin
        *   - B(1 - \omega / R_2 \rho/ \rho_0) e^{(-R_2 \rho_0 / \rho)}
        * \f}
        */
-      double specific_internal_energy(double rho, double p) const final
+      template <typename Number>
+      Number specific_internal_energy(const Number &rho, const Number &p) const
       {
-        const auto ratio = rho / rho_0;
+        const auto ratio = rho / Number(rho_0);
 
-        const auto first_term =
-            capA * (1. - omega / R1 * ratio) * std::exp(-R1 * 1. / ratio);
-        const auto second_term =
-            capB * (1. - omega / R2 * ratio) * std::exp(-R2 * 1. / ratio);
+        const auto first_term = Number(capA) *
+                                (Number(1.) - Number(omega / R1) * ratio) *
+                                std::exp(Number(-R1) / ratio);
+        const auto second_term = Number(capB) *
+                                 (Number(1.) - Number(omega / R2) * ratio) *
+                                 std::exp(Number(-R2) / ratio);
 
-        return (p - first_term - second_term) / (rho * omega);
+        return (p - first_term - second_term) / (rho * Number(omega));
+      }
+
+      double specific_internal_energy(double rho, double p) const final
+      {
+        return specific_internal_energy<double>(rho, p);
       }
 
       /**
@@ -104,39 +122,57 @@ namespace ryujin
        *         + B / R_2 * e^{(-R_2 \rho_0 / \rho)})
        * \f}
        */
-      double temperature(double rho, double e) const final
+      template <typename Number>
+      Number temperature(const Number &rho, const Number &e) const
       {
         /* Using (16a) of LA-UR-15-29536 */
-        const auto ratio = rho / rho_0;
+        const auto ratio = rho / Number(rho_0);
 
-        const auto first_term = capA / R1 * std::exp(-R1 * 1. / ratio);
-        const auto second_term = capB / R2 * std::exp(-R2 * 1. / ratio);
+        const auto first_term =
+            Number(capA / R1) * std::exp(Number(-R1) / ratio);
+        const auto second_term =
+            Number(capB / R2) * std::exp(Number(-R2) / ratio);
 
-        return (e + q_0 - 1. / rho_0 * (first_term + second_term)) / cv_;
+        return (e + Number(q_0) -
+                Number(1. / rho_0) * (first_term + second_term)) /
+               Number(cv_);
+      }
+
+      double temperature(double rho, double e) const final
+      {
+        return temperature<double>(rho, e);
       }
 
       /**
        * The speed of sound is given by
        */
-      double speed_of_sound(double rho, double e) const final
+      template <typename Number>
+      Number speed_of_sound(const Number &rho, const Number &e) const
       {
         /* FIXME: Need to cross reference with literature */
 
-        const auto t1 = omega * rho / (R1 * rho_0);
-        const auto factor1 = omega * (1. - t1) * (1. + 1. / t1) - t1;
-        const auto first_term =
-            capA / rho * factor1 * std::exp(-1. / t1 / omega);
+        const Number one(1.);
 
-        const auto t2 = omega * rho / (R2 * rho_0);
-        const auto factor2 = omega * (1. - t2) * (1. + 1. / t2) - t2;
-        const auto second_term =
-            capB / rho * factor2 * std::exp(-1. / t2 / omega);
+        const auto t1 = Number(omega) * rho / Number(R1 * rho_0);
+        const auto factor1 = Number(omega) * (one - t1) * (one + one / t1) - t1;
+        const auto first_term = Number(capA) / rho * factor1 *
+                                std::exp(Number(-1.) / t1 / Number(omega));
 
-        const auto third_term = omega * (omega + 1.) * e;
+        const auto t2 = Number(omega) * rho / Number(R2 * rho_0);
+        const auto factor2 = Number(omega) * (one - t2) * (one + one / t2) - t2;
+        const auto second_term = Number(capB) / rho * factor2 *
+                                 std::exp(Number(-1.) / t2 / Number(omega));
+
+        const auto third_term = Number(omega * (omega + 1.)) * e;
 
         return std::sqrt(first_term + second_term + third_term);
       }
 
+      double speed_of_sound(double rho, double e) const final
+      {
+        return speed_of_sound<double>(rho, e);
+      }
+
     private:
       double capA;
       double capB;
@@ -11,6 +11,7 @@
 #include "equation_of_state_polytropic_gas.h"
 #include "equation_of_state_pressureless.h"
 #include "equation_of_state_sesame.h"
+#include "equation_of_state_tabulated.h"
 #include "equation_of_state_van_der_waals.h"
 
 namespace ryujin
@@ -39,6 +40,7 @@ namespace ryujin
       add(std::make_shared<Sesame>(subsection));
       add(std::make_shared<VanDerWaals>(subsection));
       add(std::make_shared<Pressureless>(subsection));
+      add(std::make_shared<Tabulated>(subsection, equation_of_state_list));
     }
   } // namespace EquationOfStateLibrary
 } // namespace ryujin
@@ -62,16 +62,25 @@ namespace ryujin
         });
       }
 
+      /* Function templates and final overrides, see EquationOfState: */
+
       /**
        * The pressure is given by
        * \f{align}
        *   p = (\gamma - 1) \rho (e - q) / (1 - b \rho) - \gamma p_\infty
        * \f}
        */
+      template <typename Number>
+      Number pressure(const Number &rho, const Number &e) const
+      {
+        return Number(gamma_ - 1.) * rho * (e - Number(q_)) /
+                   (Number(1.) - Number(b_) * rho) -
+               Number(gamma_ * pinf_);
+      }
+
       double pressure(double rho, double e) const final
       {
-        return (gamma_ - 1.) * rho * (e - q_) / (1. - b_ * rho) -
-               gamma_ * pinf_;
+        return pressure<double>(rho, e);
       }
 
 
@@ -81,11 +90,18 @@ namespace ryujin
        *   e - q = (p + \gamma p_\infty) * (1 - b \rho) / (\rho (\gamma - 1))
        * \f}
        */
+      template <typename Number>
+      Number specific_internal_energy(const Number &rho, const Number &p) const
+      {
+        const auto numerator =
+            (p + Number(gamma_ * pinf_)) * (Number(1.) - Number(b_) * rho);
+        const auto denominator = rho * Number(gamma_ - 1.);
+        return Number(q_) + numerator / denominator;
+      }
+
       double specific_internal_energy(double rho, double p) const final
       {
-        const auto numerator = (p + gamma_ * pinf_) * (1. - b_ * rho);
-        const auto denominator = rho * (gamma_ - 1.);
-        return q_ + numerator / denominator;
+        return specific_internal_energy<double>(rho, p);
       }
 
       /**
@@ -94,9 +110,17 @@ namespace ryujin
        *   T = (e - q - p_\infty (1 / rho - b)) / c_v
        * \f}
        */
+      template <typename Number>
+      Number temperature(const Number &rho, const Number &e) const
+      {
+        return (e - Number(q_) -
+                Number(pinf_) * (Number(1.) / rho - Number(b_))) /
+               Number(cv_);
+      }
+
       double temperature(double rho, double e) const final
       {
-        return (e - q_ - pinf_ * (1. / rho - b_)) / cv_;
+        return temperature<double>(rho, e);
       }
 
       /**
@@ -106,15 +130,21 @@ namespace ryujin
        *       = \frac{\gamma (\gamma -1)[\rho (e - q) - p_\infty X]}{\rho X^2}
        * \f}
        */
-      double speed_of_sound(double rho, double e) const final
+      template <typename Number>
+      Number speed_of_sound(const Number &rho, const Number &e) const
       {
-        const auto covolume = 1. - b_ * rho;
-        auto radicand =
-            (rho * (e - q_) - pinf_ * covolume) / (covolume * covolume * rho);
-        radicand *= gamma_ * (gamma_ - 1.);
+        const auto covolume = Number(1.) - Number(b_) * rho;
+        auto radicand = (rho * (e - Number(q_)) - Number(pinf_) * covolume) /
+                        (covolume * covolume * rho);
+        radicand *= Number(gamma_ * (gamma_ - 1.));
         return std::sqrt(radicand);
       }
 
+      double speed_of_sound(double rho, double e) const final
+      {
+        return speed_of_sound<double>(rho, e);
+      }
+
     private:
       double gamma_;
       double R_;
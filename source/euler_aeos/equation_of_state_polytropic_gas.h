@@ -42,15 +42,23 @@ namespace ryujin
         cv_ = R_ / (gamma_ - 1.);
       }
 
+      /* Function templates and final overrides, see EquationOfState: */
+
       /**
        * The pressure is given by
        * \f{align}
        *   p = (\gamma - 1) \rho e
        * \f}
        */
+      template <typename Number>
+      Number pressure(const Number &rho, const Number &e) const
+      {
+        return Number(gamma_ - 1.) * rho * e;
+      }
+
       double pressure(double rho, double e) const final
       {
-        return (gamma_ - 1.) * rho * e;
+        return pressure<double>(rho, e);
       }
 
       /**
@@ -59,9 +67,15 @@ namespace ryujin
        *   e = p / (\rho (\gamma - 1))
        * \f}
        */
+      template <typename Number>
+      Number specific_internal_energy(const Number &rho, const Number &p) const
+      {
+        return p / (rho * Number(gamma_ - 1.));
+      }
+
       double specific_internal_energy(double rho, double p) const final
       {
-        return p / (rho * (gamma_ - 1.));
+        return specific_internal_energy<double>(rho, p);
       }
 
       /**
@@ -70,9 +84,15 @@ namespace ryujin
        *   T = e / c_v
        * \f}
        */
-      double temperature(double /*rho*/, double e) const final
+      template <typename Number>
+      Number temperature(const Number & /*rho*/, const Number &e) const
       {
-        return e / cv_;
+        return e / Number(cv_);
+      }
+
+      double temperature(double rho, double e) const final
+      {
+        return temperature<double>(rho, e);
       }
 
       /**
@@ -81,9 +101,15 @@ namespace ryujin
        *   c^2 = \gamma * (\gamma - 1) e
        * \f}
        */
-      double speed_of_sound(double /*rho*/, double e) const final
+      template <typename Number>
+      Number speed_of_sound(const Number & /*rho*/, const Number &e) const
+      {
+        return std::sqrt(Number(gamma_ * (gamma_ - 1.)) * e);
+      }
+
+      double speed_of_sound(double rho, double e) const final
       {
-        return std::sqrt(gamma_ * (gamma_ - 1.) * e);
+        return speed_of_sound<double>(rho, e);
       }
 
     private:
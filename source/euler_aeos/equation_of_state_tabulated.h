@@ -0,0 +1,556 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include "equation_of_state.h"
+#include "equation_of_state_library.h"
+#include "lazy.h"
+
+#include <simd.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace ryujin
+{
+  namespace EquationOfStateLibrary
+  {
+    /**
+     * A native tabulated equation of state. On first use the pressure of
+     * a "source equation of state" (any other equation of state of the
+     * library, for example the EOSPAC backed "sesame" equation of state)
+     * is sampled once on a regular grid in density and specific internal
+     * energy. Each axis can be spaced logarithmically. The speed of sound
+     * is computed on the same grid from finite differences of the
+     * pressure,
+     * \f{align}
+     *   c^2 = \partial_\rho p + \frac{p}{\rho^2} \partial_e p.
+     * \f}
+     * The temperature is tabulated as well. All tables are stored
+     * contiguously and shared by all threads. After that, pressure(),
+     * speed_of_sound() and temperature() are evaluated with bilinear
+     * interpolation, for VectorizedArray arguments with SIMD gathers.
+     * Queries outside of the tabulated range are extrapolated linearly.
+     * specific_internal_energy() inverts the interpolated pressure with a
+     * binary search along the energy axis.
+     *
+     * If the equation of state is selected and "share tables" is set,
+     * the tables are built right after parameter parsing on the first
+     * MPI rank only and then replicated into node-local shared memory
+     * (MPI-3 shared memory windows, see
+     * dealii::AlignedVector::replicate_across_communicator()). The
+     * source equation of state (and for the "sesame" equation of state
+     * the EOSPAC database) is thus only queried on a single rank, and
+     * the tables are stored only once per compute node.
+     *
+     * @ingroup EulerEquations
+     */
+    class Tabulated : public EquationOfState
+    {
+    public:
+      using EquationOfState::pressure;
+      using EquationOfState::specific_internal_energy;
+      using EquationOfState::speed_of_sound;
+      using EquationOfState::temperature;
+
+      Tabulated(const std::string &subsection,
+                const equation_of_state_list_type &equation_of_state_list)
+          : EquationOfState("tabulated", subsection)
+          , equation_of_state_list_(equation_of_state_list)
+      {
+        source_ = "polytropic gas";
+        this->add_parameter("source equation of state",
+                            source_,
+                            "The equation of state that is tabulated");
+
+        density_range_ = {1.e-4, 1.e4};
+        this->add_parameter("density range",
+                            density_range_,
+                            "Minimal and maximal density of the table");
+
+        energy_range_ = {1.e-4, 1.e4};
+        this->add_parameter(
+            "specific internal energy range",
+            energy_range_,
+            "Minimal and maximal specific internal energy of the table");
+
+        n_points_ = {256, 256};
+        this->add_parameter("number of points",
+                            n_points_,
+                            "Number of grid points in density and specific "
+                            "internal energy");
+
+        logarithmic_ = {true, true};
+        this->add_parameter("logarithmic spacing",
+                            logarithmic_,
+                            "Use a logarithmic spacing (in density and "
+                            "specific internal energy) for the grid points");
+
+        share_tables_ = true;
+        this->add_parameter(
+            "share tables",
+            share_tables_,
+            "Build the tables on the first MPI rank only and store them in "
+            "node-local shared memory");
+
+        selected_ = false;
+
+        /* Copy the EOS interpolation parameters of the source: */
+        ParameterAcceptor::parse_parameters_call_back.connect([this] {
+          tables_guard_.reset();
+          if (const auto eos = find_source(); eos != nullptr) {
+            this->interpolation_b_ = eos->interpolation_b();
+            this->interpolation_pinfty_ = eos->interpolation_pinfty();
+            this->interpolation_q_ = eos->interpolation_q();
+          }
+
+          /*
+           * ParameterAcceptor::initialize() parses the parameters of all
+           * instances (and all ensembles) on all MPI ranks, the setup is
+           * thus collective over MPI_COMM_WORLD:
+           */
+          if (selected_ && share_tables_)
+            tables_guard_.ensure_initialized([&]() {
+              set_up_tables(MPI_COMM_WORLD);
+              return true;
+            });
+        });
+      }
+
+      /**
+       * Mark the equation of state as selected (or deselected). This
+       * function is called by the HyperbolicSystem whenever its
+       * parameters are parsed, i.e., prior to the parameter callback of
+       * the equation of state.
+       */
+      void set_selected(const bool selected)
+      {
+        selected_ = selected;
+      }
+
+      /* Function templates and final overrides, see EquationOfState: */
+
+      /**
+       * Bilinear interpolation of the tabulated pressure.
+       */
+      template <typename Number>
+      Number pressure(const Number &rho, const Number &e) const
+      {
+        return interpolate(pressure_index, rho, e);
+      }
+
+      double pressure(double rho, double e) const final
+      {
+        return pressure<double>(rho, e);
+      }
+
+      /**
+       * Invert the interpolated pressure for the specific internal
+       * energy.
+       */
+      template <typename Number>
+      Number specific_internal_energy(const Number &rho, const Number &p) const
+      {
+        return for_each_lane(rho, p, [&](double rho_k, double p_k) {
+          return invert_pressure(rho_k, p_k);
+        });
+      }
+
+      double specific_internal_energy(double rho, double p) const final
+      {
+        return specific_internal_energy<double>(rho, p);
+      }
+
+      /**
+       * Bilinear interpolation of the tabulated temperature.
+       */
+      template <typename Number>
+      Number temperature(const Number &rho, const Number &e) const
+      {
+        return interpolate(temperature_index, rho, e);
+      }
+
+      double temperature(double rho, double e) const final
+      {
+        return temperature<double>(rho, e);
+      }
+
+      /**
+       * Bilinear interpolation of the tabulated speed of sound.
+       */
+      template <typename Number>
+      Number speed_of_sound(const Number &rho, const Number &e) const
+      {
+        return interpolate(speed_of_sound_index, rho, e);
+      }
+
+      double speed_of_sound(double rho, double e) const final
+      {
+        return speed_of_sound<double>(rho, e);
+      }
+
+    private:
+      /**
+       * @name Table setup and interpolation
+       */
+      //@{
+
+      static constexpr unsigned int pressure_index = 0;
+      static constexpr unsigned int speed_of_sound_index = 1;
+      static constexpr unsigned int temperature_index = 2;
+      static constexpr unsigned int n_tables = 3;
+
+      /**
+       * Return a pointer to the source equation of state, or a nullptr if
+       * no equation of state with the given name exists.
+       */
+      const EquationOfState *find_source() const
+      {
+        for (const auto &it : equation_of_state_list_)
+          if (it->name() == source_ && it.get() != this)
+            return it.get();
+        return nullptr;
+      }
+
+      const EquationOfState &source_eos() const
+      {
+        const auto eos = find_source();
+        AssertThrow(eos != nullptr,
+                    dealii::ExcMessage("Could not find the source equation of "
+                                       "state \"" +
+                                       source_ + "\" of the tabulated EOS"));
+        return *eos;
+      }
+
+      /**
+       * Evaluate @p callable(rho, value) lane by lane.
+       */
+      template <typename Number, typename Callable>
+      static Number for_each_lane(const Number &rho,
+                                  const Number &value,
+                                  const Callable &callable)
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+
+        if constexpr (std::is_same_v<ScalarNumber, Number>) {
+          return ScalarNumber(callable(rho, value));
+        } else {
+          Number result;
+          for (unsigned int k = 0; k < Number::size(); ++k)
+            result[k] = ScalarNumber(callable(rho[k], value[k]));
+          return result;
+        }
+      }
+
+      /**
+       * Build the tables (on the current MPI rank) if necessary.
+       */
+      void ensure_tables() const
+      {
+        tables_guard_.ensure_initialized([&]() {
+          set_up_tables(MPI_COMM_SELF);
+          return true;
+        });
+      }
+
+      /**
+       * Return the index of the grid cell along an axis with @p n points
+       * that contains the (fractional) grid coordinate @p z. Coordinates
+       * outside of the table (and NaNs) are mapped to the boundary cells.
+       */
+      template <typename ScalarNumber>
+      static unsigned int cell_index(const ScalarNumber z, const unsigned int n)
+      {
+        if (z >= ScalarNumber(n - 2))
+          return n - 2;
+        return z > ScalarNumber(0.) ? static_cast<unsigned int>(z) : 0u;
+      }
+
+      /**
+       * Translate a physical coordinate @p value into a (fractional) grid
+       * coordinate along axis @p axis.
+       */
+      template <typename Number>
+      Number grid_coordinate(const Number &value, const unsigned int axis) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+
+        if (logarithmic_[axis]) {
+          constexpr auto min = std::numeric_limits<ScalarNumber>::min();
+          const Number log_value = std::log(std::max(value, Number(min)));
+          return (log_value - Number(origin_[axis])) *
+                 Number(inverse_spacing_[axis]);
+        }
+
+        return (value - Number(origin_[axis])) * Number(inverse_spacing_[axis]);
+      }
+
+      /**
+       * Bilinear interpolation of table @p index at (@p rho, @p e).
+       */
+      template <typename Number>
+      Number interpolate(const unsigned int index,
+                         const Number &rho,
+                         const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+
+        ensure_tables();
+
+        const std::size_t size = std::size_t(n_points_[0]) * n_points_[1];
+        const ScalarNumber *table;
+        if constexpr (std::is_same_v<ScalarNumber, float>)
+          table = tables_float_.data() + index * size;
+        else
+          table = tables_.data() + index * size;
+
+        const Number x = grid_coordinate(rho, 0);
+        const Number y = grid_coordinate(e, 1);
+
+        const unsigned int n_e = n_points_[1];
+
+        /*
+         * Return the offset of the lower left corner of the grid cell
+         * containing (x, y) and the local coordinates within the cell:
+         */
+        const auto locate = [&](const ScalarNumber x_k,
+                                const ScalarNumber y_k) {
+          const unsigned int i = cell_index(x_k, n_points_[0]);
+          const unsigned int j = cell_index(y_k, n_e);
+          return std::make_tuple(
+              i * n_e + j, x_k - ScalarNumber(i), y_k - ScalarNumber(j));
+        };
+
+        if constexpr (std::is_same_v<ScalarNumber, Number>) {
+          const auto [offset, t, s] = locate(x, y);
+          const auto f = table + offset;
+          return (Number(1.) - t) * ((Number(1.) - s) * f[0] + s * f[1]) +
+                 t * ((Number(1.) - s) * f[n_e] + s * f[n_e + 1]);
+
+        } else {
+          std::array<unsigned int, Number::size()> offsets;
+          Number t, s;
+          for (unsigned int k = 0; k < Number::size(); ++k) {
+            const auto [offset, t_k, s_k] = locate(x[k], y[k]);
+            offsets[k] = offset;
+            t[k] = t_k;
+            s[k] = s_k;
+          }
+
+          Number f_00, f_01, f_10, f_11;
+          f_00.gather(table, offsets.data());
+          f_01.gather(table + 1, offsets.data());
+          f_10.gather(table + n_e, offsets.data());
+          f_11.gather(table + n_e + 1, offsets.data());
+
+          return (Number(1.) - t) * ((Number(1.) - s) * f_00 + s * f_01) +
+                 t * ((Number(1.) - s) * f_10 + s * f_11);
+        }
+      }
+
+      /**
+       * Return the specific internal energy for which the interpolated
+       * pressure at density @p rho equals @p p. The pressure is assumed
+       * to be monotonically increasing in the specific internal energy.
+       */
+      double invert_pressure(const double rho, const double p) const
+      {
+        ensure_tables();
+
+        const unsigned int n_e = n_points_[1];
+        const std::size_t size = std::size_t(n_points_[0]) * n_e;
+        const double *table = tables_.data() + pressure_index * size;
+
+        const double x = grid_coordinate(rho, 0);
+        const unsigned int i = cell_index(x, n_points_[0]);
+        const double t = x - double(i);
+
+        const auto row = [&](const unsigned int j) {
+          const auto f = table + i * n_e + j;
+          return (1. - t) * f[0] + t * f[n_e];
+        };
+
+        /* Find the last segment [j, j + 1] with row(j) <= p: */
+        unsigned int j = 0;
+        unsigned int j_end = n_e - 1;
+        while (j_end - j > 1) {
+          const unsigned int mid = (j + j_end) / 2;
+          if (row(mid) <= p)
+            j = mid;
+          else
+            j_end = mid;
+        }
+
+        const double p_l = row(j);
+        const double p_r = row(j + 1);
+        const double s = p_r != p_l ? (p - p_l) / (p_r - p_l) : 0.;
+
+        const double y = origin_[1] + (double(j) + s) / inverse_spacing_[1];
+        return logarithmic_[1] ? std::exp(y) : y;
+      }
+
+      /**
+       * Sample the source equation of state and populate the tables. The
+       * function is collective over @p communicator: The tables are
+       * computed on the first rank and replicated into shared memory on
+       * all other ranks.
+       */
+      void set_up_tables(const MPI_Comm &communicator) const
+      {
+        for (unsigned int axis = 0; axis < 2; ++axis)
+          AssertThrow(n_points_[axis] >= 2,
+                      dealii::ExcMessage("The tabulated EOS needs at least "
+                                         "two points per axis"));
+
+        const std::array<std::array<double, 2>, 2> ranges{density_range_,
+                                                          energy_range_};
+
+        std::array<std::vector<double>, 2> coordinates;
+        for (unsigned int axis = 0; axis < 2; ++axis) {
+          auto [min, max] = ranges[axis];
+          AssertThrow(
+              max > min && (!logarithmic_[axis] || min > 0.),
+              dealii::ExcMessage("Invalid range for the tabulated EOS"));
+
+          if (logarithmic_[axis]) {
+            min = std::log(min);
+            max = std::log(max);
+          }
+
+          const unsigned int n = n_points_[axis];
+          origin_[axis] = min;
+          inverse_spacing_[axis] = double(n - 1) / (max - min);
+
+          coordinates[axis].resize(n);
+          for (unsigned int i = 0; i < n; ++i) {
+            const double x = min + (max - min) * i / double(n - 1);
+            coordinates[axis][i] = logarithmic_[axis] ? std::exp(x) : x;
+          }
+        }
+
+        const unsigned int n_rho = n_points_[0];
+        const unsigned int n_e = n_points_[1];
+        const std::size_t size = std::size_t(n_rho) * n_e;
+
+        if (dealii::Utilities::MPI::this_mpi_process(communicator) == 0) {
+          tables_.resize_fast(n_tables * size);
+          compute_tables(coordinates[0], coordinates[1]);
+
+          tables_float_.resize_fast(n_tables * size);
+          std::copy(tables_.begin(), tables_.end(), tables_float_.begin());
+        }
+
+        if (dealii::Utilities::MPI::n_mpi_processes(communicator) > 1) {
+          tables_.replicate_across_communicator(communicator, 0);
+          tables_float_.replicate_across_communicator(communicator, 0);
+        }
+      }
+
+      /**
+       * Evaluate the source equation of state on the grid given by the
+       * coordinates @p rho_i and @p e_j and populate the tables.
+       */
+      void compute_tables(const std::vector<double> &rho_i,
+                          const std::vector<double> &e_j) const
+      {
+        const auto &source = source_eos();
+
+        const unsigned int n_rho = rho_i.size();
+        const unsigned int n_e = e_j.size();
+        const std::size_t size = std::size_t(n_rho) * n_e;
+
+        /*
+         * Query the pressure and temperature on all grid points with a
+         * single call into the vector interface of the source equation of
+         * state each (which might modify its arguments in place):
+         */
+
+        std::vector<double> rho(size);
+        std::vector<double> e(size);
+        const auto reset_arguments = [&]() {
+          for (unsigned int i = 0; i < n_rho; ++i)
+            for (unsigned int j = 0; j < n_e; ++j) {
+              rho[i * n_e + j] = rho_i[i];
+              e[i * n_e + j] = e_j[j];
+            }
+        };
+
+        const auto p = tables_.data() + pressure_index * size;
+        const auto c = tables_.data() + speed_of_sound_index * size;
+        const auto T = tables_.data() + temperature_index * size;
+
+        reset_arguments();
+        source.pressure(dealii::ArrayView<double>(p, size),
+                        dealii::ArrayView<double>(rho),
+                        dealii::ArrayView<double>(e));
+
+        reset_arguments();
+        source.temperature(dealii::ArrayView<double>(T, size),
+                           dealii::ArrayView<double>(rho),
+                           dealii::ArrayView<double>(e));
+
+        /*
+         * Compute the speed of sound with (one-sided at the boundary)
+         * finite differences:
+         */
+
+        for (unsigned int i = 0; i < n_rho; ++i) {
+          const unsigned int i_l = i == 0 ? 0 : i - 1;
+          const unsigned int i_r = i == n_rho - 1 ? i : i + 1;
+          for (unsigned int j = 0; j < n_e; ++j) {
+            const unsigned int j_l = j == 0 ? 0 : j - 1;
+            const unsigned int j_r = j == n_e - 1 ? j : j + 1;
+
+            const double p_rho = (p[i_r * n_e + j] - p[i_l * n_e + j]) /
+                                 (rho_i[i_r] - rho_i[i_l]);
+            const double p_e = (p[i * n_e + j_r] - p[i * n_e + j_l]) /
+                               (e_j[j_r] - e_j[j_l]);
+            const double p_ij = p[i * n_e + j];
+
+            const double c_square =
+                p_rho + p_ij / (rho_i[i] * rho_i[i]) * p_e;
+            c[i * n_e + j] = std::sqrt(std::max(c_square, 0.));
+          }
+        }
+      }
+
+      Lazy<bool> tables_guard_;
+      mutable dealii::AlignedVector<double> tables_;
+      mutable dealii::AlignedVector<float> tables_float_;
+      mutable std::array<double, 2> origin_;
+      mutable std::array<double, 2> inverse_spacing_;
+
+      const equation_of_state_list_type &equation_of_state_list_;
+
+      //@}
+      /**
+       * @name Run time options
+       */
+      //@{
+
+      std::string source_;
+      std::array<double, 2> density_range_;
+      std::array<double, 2> energy_range_;
+      std::array<unsigned int, 2> n_points_;
+      std::array<bool, 2> logarithmic_;
+      bool share_tables_;
+      bool selected_;
+
+      //@}
+    };
+  } // namespace EquationOfStateLibrary
+} // namespace ryujin
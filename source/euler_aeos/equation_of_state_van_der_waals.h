@@ -59,18 +59,26 @@ namespace ryujin
         });
       }
 
+      /* Function templates and final overrides, see EquationOfState: */
+
       /**
        * The pressure is given by
        * \f{align}
        *   p = (\gamma - 1) * (\rho * e + a \rho^2)/(1 - b \rho) - a \rho^2
        * \f}
        */
-      double pressure(double rho, double e) const final
+      template <typename Number>
+      Number pressure(const Number &rho, const Number &e) const
       {
-        const auto intermolecular = a_ * rho * rho;
+        const auto intermolecular = Number(a_) * rho * rho;
         const auto numerator = rho * e + intermolecular;
-        const auto covolume = 1. - b_ * rho;
-        return (gamma_ - 1.) * numerator / covolume - intermolecular;
+        const auto covolume = Number(1.) - Number(b_) * rho;
+        return Number(gamma_ - 1.) * numerator / covolume - intermolecular;
+      }
+
+      double pressure(double rho, double e) const final
+      {
+        return pressure<double>(rho, e);
       }
 
       /**
@@ -80,13 +88,19 @@ namespace ryujin
        *   - a \rho^2
        * \f}
        */
-      double specific_internal_energy(double rho, double p) const final
+      template <typename Number>
+      Number specific_internal_energy(const Number &rho, const Number &p) const
       {
-        const auto intermolecular = a_ * rho * rho;
-        const auto covolume = 1. - b_ * rho;
+        const auto intermolecular = Number(a_) * rho * rho;
+        const auto covolume = Number(1.) - Number(b_) * rho;
         const auto numerator = (p + intermolecular) * covolume;
-        const auto denominator = rho * (gamma_ - 1.);
-        return numerator / denominator - a_ * rho;
+        const auto denominator = rho * Number(gamma_ - 1.);
+        return numerator / denominator - Number(a_) * rho;
+      }
+
+      double specific_internal_energy(double rho, double p) const final
+      {
+        return specific_internal_energy<double>(rho, p);
       }
 
       /**
@@ -95,9 +109,15 @@ namespace ryujin
        *   T = (\gamma - 1) / R (e + a \rho)
        * \f}
        */
+      template <typename Number>
+      Number temperature(const Number &rho, const Number &e) const
+      {
+        return (e + Number(a_) * rho) / Number(cv_);
+      }
+
       double temperature(double rho, double e) const final
       {
-        return (e + a_ * rho) / cv_;
+        return temperature<double>(rho, e);
       }
 
       /**
@@ -107,11 +127,19 @@ namespace ryujin
        *   - 2a\rho.
        * \f}
        */
+      template <typename Number>
+      Number speed_of_sound(const Number &rho, const Number &e) const
+      {
+        const auto covolume = Number(1.) - Number(b_) * rho;
+        const auto numerator =
+            Number(gamma_ * (gamma_ - 1.)) * (e + Number(a_) * rho);
+        return std::sqrt(numerator / (covolume * covolume) -
+                         Number(2. * a_) * rho);
+      }
+
       double speed_of_sound(double rho, double e) const final
       {
-        const auto covolume = 1. - b_ * rho;
-        const auto numerator = gamma_ * (gamma_ - 1.) * (e + a_ * rho);
-        return std::sqrt(numerator / (covolume * covolume) - 2. * a_ * rho);
+        return speed_of_sound<double>(rho, e);
       }
 
     private:
@@ -5,7 +5,12 @@
 
 #pragma once
 
+#include "equation_of_state_jones_wilkins_lee.h"
 #include "equation_of_state_library.h"
+#include "equation_of_state_noble_abel_stiffened_gas.h"
+#include "equation_of_state_polytropic_gas.h"
+#include "equation_of_state_tabulated.h"
+#include "equation_of_state_van_der_waals.h"
 
 #include <compile_time_options.h>
 #include <convenience_macros.h>
@@ -16,6 +21,7 @@
 #include <simd.h>
 #include <state_vector.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/tensor.h>
 
@@ -104,6 +110,20 @@ namespace ryujin
       using EquationOfState = EquationOfStateLibrary::EquationOfState;
       std::shared_ptr<EquationOfState> selected_equation_of_state_;
 
+      /**
+       * The concrete type of the selected equation of state for all
+       * analytic equations of state that provide templated kernels, see
+       * HyperbolicSystemView::eos_dispatch().
+       */
+      enum class EquationOfStateType {
+        generic,
+        jones_wilkins_lee,
+        noble_abel_stiffened_gas,
+        polytropic_gas,
+        tabulated,
+        van_der_waals,
+      } selected_equation_of_state_type_;
+
       template <int dim, typename Number>
       friend class HyperbolicSystemView;
       //@}
@@ -191,6 +211,39 @@ namespace ryujin
        */
       //@{
 
+      /**
+       * Call @p kernel(eos) with the selected equation of state cast to
+       * its concrete type if it is one of the analytic equations of state
+       * that implement their formulas as function templates. This
+       * evaluates the equation of state without virtual function calls
+       * and fully vectorized. For all other equations of state
+       * @p fallback() is called.
+       */
+      template <typename Kernel, typename Fallback>
+      DEAL_II_ALWAYS_INLINE inline Number
+      eos_dispatch(const Kernel &kernel, const Fallback &fallback) const
+      {
+        using namespace EquationOfStateLibrary;
+        using EOST = HyperbolicSystem::EquationOfStateType;
+
+        const auto &eos = *hyperbolic_system_.selected_equation_of_state_;
+
+        switch (hyperbolic_system_.selected_equation_of_state_type_) {
+        case EOST::jones_wilkins_lee:
+          return kernel(static_cast<const JonesWilkinsLee &>(eos));
+        case EOST::noble_abel_stiffened_gas:
+          return kernel(static_cast<const NobleAbelStiffenedGas &>(eos));
+        case EOST::polytropic_gas:
+          return kernel(static_cast<const PolytropicGas &>(eos));
+        case EOST::tabulated:
+          return kernel(static_cast<const Tabulated &>(eos));
+        case EOST::van_der_waals:
+          return kernel(static_cast<const VanDerWaals &>(eos));
+        default:
+          return fallback();
+        }
+      }
+
       /**
        * For a given density \f$\rho\f$ and <i>specific</i> internal
        * energy \f$e\f$ return the pressure \f$p\f$.
@@ -200,15 +253,21 @@ namespace ryujin
       {
         const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
-          return ScalarNumber(eos->pressure(rho, e));
-        } else {
-          Number p;
-          for (unsigned int k = 0; k < Number::size(); ++k) {
-            p[k] = ScalarNumber(eos->pressure(rho[k], e[k]));
-          }
-          return p;
-        }
+        return eos_dispatch(
+            [&](const auto &model) {
+              return model.template pressure<Number>(rho, e);
+            },
+            [&]() {
+              if constexpr (std::is_same_v<ScalarNumber, Number>) {
+                return ScalarNumber(eos->pressure(rho, e));
+              } else {
+                Number p;
+                for (unsigned int k = 0; k < Number::size(); ++k) {
+                  p[k] = ScalarNumber(eos->pressure(rho[k], e[k]));
+                }
+                return p;
+              }
+            });
       }
 
       /**
@@ -220,15 +279,22 @@ namespace ryujin
       {
         const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
-          return ScalarNumber(eos->specific_internal_energy(rho, p));
-        } else {
-          Number e;
-          for (unsigned int k = 0; k < Number::size(); ++k) {
-            e[k] = ScalarNumber(eos->specific_internal_energy(rho[k], p[k]));
-          }
-          return e;
-        }
+        return eos_dispatch(
+            [&](const auto &model) {
+              return model.template specific_internal_energy<Number>(rho, p);
+            },
+            [&]() {
+              if constexpr (std::is_same_v<ScalarNumber, Number>) {
+                return ScalarNumber(eos->specific_internal_energy(rho, p));
+              } else {
+                Number e;
+                for (unsigned int k = 0; k < Number::size(); ++k) {
+                  e[k] = ScalarNumber(
+                      eos->specific_internal_energy(rho[k], p[k]));
+                }
+                return e;
+              }
+            });
       }
 
       /**
@@ -240,15 +306,21 @@ namespace ryujin
       {
         const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
-          return ScalarNumber(eos->temperature(rho, e));
-        } else {
-          Number temp;
-          for (unsigned int k = 0; k < Number::size(); ++k) {
-            temp[k] = ScalarNumber(eos->temperature(rho[k], e[k]));
-          }
-          return temp;
-        }
+        return eos_dispatch(
+            [&](const auto &model) {
+              return model.template temperature<Number>(rho, e);
+            },
+            [&]() {
+              if constexpr (std::is_same_v<ScalarNumber, Number>) {
+                return ScalarNumber(eos->temperature(rho, e));
+              } else {
+                Number temp;
+                for (unsigned int k = 0; k < Number::size(); ++k) {
+                  temp[k] = ScalarNumber(eos->temperature(rho[k], e[k]));
+                }
+                return temp;
+              }
+            });
       }
 
       /**
@@ -260,15 +332,21 @@ namespace ryujin
       {
         const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
-          return ScalarNumber(eos->speed_of_sound(rho, e));
-        } else {
-          Number c;
-          for (unsigned int k = 0; k < Number::size(); ++k) {
-            c[k] = ScalarNumber(eos->speed_of_sound(rho[k], e[k]));
-          }
-          return c;
-        }
+        return eos_dispatch(
+            [&](const auto &model) {
+              return model.template speed_of_sound<Number>(rho, e);
+            },
+            [&]() {
+              if constexpr (std::is_same_v<ScalarNumber, Number>) {
+                return ScalarNumber(eos->speed_of_sound(rho, e));
+              } else {
+                Number c;
+                for (unsigned int k = 0; k < Number::size(); ++k) {
+                  c[k] = ScalarNumber(eos->speed_of_sound(rho[k], e[k]));
+                }
+                return c;
+              }
+            });
       }
 
       /**
@@ -379,9 +457,20 @@ namespace ryujin
       }();
 
       /**
-       * The number of precomputed values.
+       * The number of precomputed values: the pressure, the surrogate
+       * gamma minimum over the stencil, and the surrogate entropies. If
+       * the compile-time option EULER_AEOS_CACHE_SURROGATES is set we
+       * also store the surrogate gamma and the surrogate speed of sound of
+       * every degree of freedom. This way the RiemannSolver and the
+       * second precomputation cycle read the EOS-derived state instead of
+       * recomputing it for every edge, at the cost of two more values per
+       * degree of freedom to store and exchange.
        */
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      static constexpr unsigned int n_precomputed_values = 6;
+#else
       static constexpr unsigned int n_precomputed_values = 4;
+#endif
 
       /**
        * Array type used for precomputed values.
@@ -396,7 +485,27 @@ namespace ryujin
               {"p",
                "surrogate_gamma_min",
                "surrogate_specific_entropy",
-               "surrogate_harten_entropy"}};
+               "surrogate_harten_entropy",
+#ifdef EULER_AEOS_CACHE_SURROGATES
+               "surrogate_gamma",
+               "surrogate_speed_of_sound"
+#endif
+              }};
+
+      /**
+       * The components of the precomputed values that are read at
+       * neighboring degrees of freedom: the RiemannSolver, the flux and
+       * the Limiter read the pressure, the surrogate specific entropy,
+       * and (if cached) the surrogate gamma and the surrogate speed of
+       * sound. Only these components are exchanged over MPI ranks.
+       */
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      static constexpr std::array<unsigned int, 4>
+          precomputed_ghost_components{{0, 2, 4, 5}};
+#else
+      static constexpr std::array<unsigned int, 2>
+          precomputed_ghost_components{{0, 2}};
+#endif
 
       /**
        * The number of precomputed initial values.
@@ -598,6 +707,15 @@ namespace ryujin
       Number surrogate_speed_of_sound(const state_type &U,
                                       const Number &gamma) const;
 
+      /**
+       * Variant of above function that computes the surrogate speed of
+       * sound from a given pressure <code>p</code> with the first
+       * formula.
+       */
+      Number surrogate_speed_of_sound(const state_type &U,
+                                      const Number &p,
+                                      const Number &gamma) const;
+
       /**
        * Returns whether the state @p U is admissible. If @p U is a
        * vectorized state then @p U is admissible if all vectorized values
@@ -736,6 +854,9 @@ namespace ryujin
                               const state_type &U_j,
                               const ScalarNumber tau) const = delete;
 
+      /** We do not have implicit source terms */
+      static constexpr bool have_implicit_source_terms = false;
+
       //@}
       /**
        * @name State transformations
@@ -770,6 +891,14 @@ namespace ryujin
       template <typename ST>
       state_type from_initial_state(const ST &initial_state) const;
 
+      /**
+       * Variant of above function converting a batch of (full) primitive
+       * initial states [rho, u_1, ..., u_d, p] into conserved states in
+       * place.
+       */
+      void
+      from_initial_states(const dealii::ArrayView<state_type> &states) const;
+
       /**
        * Given a primitive state [rho, u_1, ..., u_d, e] return a conserved
        * state.
@@ -846,12 +975,41 @@ namespace ryujin
           equation_of_state_list_, subsection);
 
       const auto populate_functions = [this]() {
+        /*
+         * Notify the tabulated equation of state whether it is selected.
+         * A selected tabulated equation of state builds its (shared)
+         * tables in its own parameter callback:
+         */
+        for (auto &it : equation_of_state_list_)
+          if (auto tabulated =
+                  dynamic_cast<EquationOfStateLibrary::Tabulated *>(it.get()))
+            tabulated->set_selected(it->name() == equation_of_state_);
+
         bool initialized = false;
         for (auto &it : equation_of_state_list_)
 
           /* Populate EOS-specific quantities and functions */
           if (it->name() == equation_of_state_) {
             selected_equation_of_state_ = it;
+
+            using namespace EquationOfStateLibrary;
+            using EOST = EquationOfStateType;
+            const auto eos = it.get();
+            if (dynamic_cast<const JonesWilkinsLee *>(eos) != nullptr)
+              selected_equation_of_state_type_ = EOST::jones_wilkins_lee;
+            else if (dynamic_cast<const NobleAbelStiffenedGas *>(eos) !=
+                     nullptr)
+              selected_equation_of_state_type_ =
+                  EOST::noble_abel_stiffened_gas;
+            else if (dynamic_cast<const PolytropicGas *>(eos) != nullptr)
+              selected_equation_of_state_type_ = EOST::polytropic_gas;
+            else if (dynamic_cast<const Tabulated *>(eos) != nullptr)
+              selected_equation_of_state_type_ = EOST::tabulated;
+            else if (dynamic_cast<const VanDerWaals *>(eos) != nullptr)
+              selected_equation_of_state_type_ = EOST::van_der_waals;
+            else
+              selected_equation_of_state_type_ = EOST::generic;
+
             problem_name =
                 "Compressible Euler equations (" + it->name() + " EOS)";
             initialized = true;
@@ -943,7 +1101,13 @@ namespace ryujin
             const auto U_i = U.template get_tensor<Number>(offset + i);
             const auto p_i = get_entry<Number>(p, i);
             const auto gamma_i = surrogate_gamma(U_i, p_i);
+#ifdef EULER_AEOS_CACHE_SURROGATES
+            const auto a_i = surrogate_speed_of_sound(U_i, p_i, gamma_i);
+            const PT prec_i{
+                p_i, gamma_i, Number(0.), Number(0.), gamma_i, a_i};
+#else
             const PT prec_i{p_i, gamma_i, Number(0.), Number(0.)};
+#endif
             precomputed.template write_tensor<Number>(prec_i, offset + i);
           }
         } else {
@@ -968,7 +1132,13 @@ namespace ryujin
 
             const auto gamma_i = surrogate_gamma(U_i, p_i);
             using PT = precomputed_type;
+#ifdef EULER_AEOS_CACHE_SURROGATES
+            const auto a_i = surrogate_speed_of_sound(U_i, p_i, gamma_i);
+            const PT prec_i{
+                p_i, gamma_i, Number(0.), Number(0.), gamma_i, a_i};
+#else
             const PT prec_i{p_i, gamma_i, Number(0.), Number(0.)};
+#endif
             precomputed.template write_tensor<Number>(prec_i, i);
           }
         } /* prefer_vector_interface */
@@ -988,16 +1158,29 @@ namespace ryujin
 
           const auto U_i = U.template get_tensor<Number>(i);
           auto prec_i = precomputed.template get_tensor<Number, PT>(i);
+#ifdef EULER_AEOS_CACHE_SURROGATES
+          auto &[p_i, gamma_min_i, s_i, eta_i, gamma_i, a_i] = prec_i;
+#else
           auto &[p_i, gamma_min_i, s_i, eta_i] = prec_i;
+#endif
 
           const unsigned int *js = sparsity_simd.columns(i) + stride_size;
           for (unsigned int col_idx = 1; col_idx < row_length;
                ++col_idx, js += stride_size) {
 
+#ifdef EULER_AEOS_CACHE_SURROGATES
+            /*
+             * Only read the surrogate gamma of the neighbor, which (in
+             * contrast to gamma_min_j) is not modified in this cycle:
+             */
+            const auto prec_j = precomputed.template get_tensor<Number, PT>(js);
+            const auto &[p_j, gamma_min_j, s_j, eta_j, gamma_j, a_j] = prec_j;
+#else
             const auto U_j = U.template get_tensor<Number>(js);
             const auto prec_j = precomputed.template get_tensor<Number, PT>(js);
             auto &[p_j, gamma_min_j, s_j, eta_j] = prec_j;
             const auto gamma_j = surrogate_gamma(U_j, p_j);
+#endif
             gamma_min_i = std::min(gamma_min_i, gamma_j);
           }
 
@@ -1252,6 +1435,21 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline Number
+    HyperbolicSystemView<dim, Number>::surrogate_speed_of_sound(
+        const state_type &U, const Number &p, const Number &gamma) const
+    {
+      const auto b = Number(eos_interpolation_b());
+      const auto pinf = Number(eos_interpolation_pinfty());
+
+      const auto rho = density(U);
+      const auto covolume = Number(1.) - b * rho;
+
+      return std::sqrt(gamma * (p + pinf) / (rho * covolume));
+    }
+
+
     template <int dim, typename Number>
     DEAL_II_ALWAYS_INLINE inline bool
     HyperbolicSystemView<dim, Number>::is_admissible(const state_type &U) const
@@ -1563,8 +1761,13 @@ namespace ryujin
         const unsigned int i,
         const state_type &U_i) const -> flux_contribution_type
     {
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      const auto &[p_i, gamma_min_i, s_i, eta_i, gamma_i, a_i] =
+          pv.template get_tensor<Number, precomputed_type>(i);
+#else
       const auto &[p_i, gamma_min_i, s_i, eta_i] =
           pv.template get_tensor<Number, precomputed_type>(i);
+#endif
       return f(U_i, p_i);
     }
 
@@ -1577,8 +1780,13 @@ namespace ryujin
         const unsigned int *js,
         const state_type &U_j) const -> flux_contribution_type
     {
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      const auto &[p_j, gamma_min_j, s_j, eta_j, gamma_j, a_j] =
+          pv.template get_tensor<Number, precomputed_type>(js);
+#else
       const auto &[p_j, gamma_min_j, s_j, eta_j] =
           pv.template get_tensor<Number, precomputed_type>(js);
+#endif
       return f(U_j, p_j);
     }
 
@@ -1635,6 +1843,58 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    inline void HyperbolicSystemView<dim, Number>::from_initial_states(
+        const dealii::ArrayView<state_type> &states) const
+    {
+      using EOST = HyperbolicSystem::EquationOfStateType;
+
+      /*
+       * Analytic equations of state are inverted with their templated
+       * kernels. Only the generic (for example, tabulated or user
+       * supplied) equations of state benefit from the batched interface:
+       */
+      if constexpr (std::is_same_v<ScalarNumber, Number>) {
+        if (hyperbolic_system_.selected_equation_of_state_type_ ==
+            EOST::generic) {
+          const auto &eos = hyperbolic_system_.selected_equation_of_state_;
+
+          constexpr unsigned int batch_size = 64;
+          std::array<double, batch_size> rho;
+          std::array<double, batch_size> p;
+          std::array<double, batch_size> e;
+
+          for (std::size_t offset = 0; offset < states.size();
+               offset += batch_size) {
+            const auto n =
+                std::min<std::size_t>(batch_size, states.size() - offset);
+
+            for (std::size_t k = 0; k < n; ++k) {
+              const auto &state = states[offset + k];
+              rho[k] = density(state);
+              p[k] = /*SIC!*/ total_energy(state);
+            }
+
+            eos->specific_internal_energy(
+                dealii::ArrayView<double>(e.data(), n),
+                dealii::ArrayView<double>(rho.data(), n),
+                dealii::ArrayView<double>(p.data(), n));
+
+            for (std::size_t k = 0; k < n; ++k) {
+              auto &state = states[offset + k];
+              state[dim + 1] = ScalarNumber(e[k]);
+              state = from_primitive_state(state);
+            }
+          }
+          return;
+        }
+      }
+
+      for (auto &state : states)
+        state = from_initial_state(state);
+    }
+
+
     template <int dim, typename Number>
     DEAL_II_ALWAYS_INLINE inline auto
     HyperbolicSystemView<dim, Number>::from_primitive_state(
@@ -263,8 +263,13 @@ namespace ryujin
     {
       const auto view = hyperbolic_system.view<dim, Number>();
       const auto rho_i = view.density(U_i);
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      const auto &[p_i, gamma_min_i, s_i, eta_i, gamma_i, a_i] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(i);
+#else
       const auto &[p_i, gamma_min_i, s_i, eta_i] =
           precomputed_values.template get_tensor<Number, precomputed_type>(i);
+#endif
 
       return {/*rho_min*/ rho_i,
               /*rho_max*/ rho_i,
@@ -304,8 +309,13 @@ namespace ryujin
       rho_max = Number(0.);
       s_min = Number(std::numeric_limits<ScalarNumber>::max());
 
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      const auto &[p_i, gamma_min_i, s_i, eta_i, gamma_i, a_i] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(i);
+#else
       const auto &[p_i, gamma_min_i, s_i, eta_i] =
           precomputed_values.template get_tensor<Number, precomputed_type>(i);
+#endif
 
       gamma_min = gamma_min_i;
 
@@ -392,9 +402,15 @@ namespace ryujin
          * of the bar state. We use the s_ij_bar for computing the bounds
          * relaxation as well.
          */
+#ifdef EULER_AEOS_CACHE_SURROGATES
+        const auto [p_j, gamma_min_j, s_j, eta_j, gamma_j, a_j] =
+            precomputed_values.template get_tensor<Number, precomputed_type>(
+                js);
+#else
         const auto [p_j, gamma_min_j, s_j, eta_j] =
             precomputed_values.template get_tensor<Number, precomputed_type>(
                 js);
+#endif
 
         const auto s_ij_bar =
             view.surrogate_specific_entropy(U_ij_bar, gamma_min);
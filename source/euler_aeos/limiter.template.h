@@ -143,7 +143,6 @@ namespace ryujin
       Number t_l = t_min; // good state
 
       const auto &gamma = std::get<3>(bounds) /* = gamma_min*/;
-      const Number gm1 = gamma - Number(1.);
 
       const auto b = Number(view.eos_interpolation_b());
       const auto pinf = Number(view.eos_interpolation_pinfty());
@@ -164,6 +163,10 @@ namespace ryujin
          * (s in turn was defined as s =\varepsilon \rho ^{-\gamma}, where
          * \varepsilon = (\rho e - pinf * (1 - b rho)) is the shifted
          * internal energy.)
+         *
+         * We use rho^gamma (1 - b rho)^(1 - gamma) = (rho / (1 - b
+         * rho))^gamma (1 - b rho) so that psi and its derivative only
+         * need a single power per state and Newton iteration.
          */
 
         const auto &s_min = std::get<2>(bounds);
@@ -179,15 +182,14 @@ namespace ryujin
 
           const auto U_r = U + t_r * P;
           const auto rho_r = view.density(U_r);
-          const auto rho_r_gamma = ryujin::pow(rho_r, gamma);
           const auto covolume_r = Number(1.) - b * rho_r;
+          const auto rho_cov_gamma_r = ryujin::pow(rho_r / covolume_r, gamma);
 
           const auto rho_e_r = view.internal_energy(U_r);
           const auto shift_r = rho_e_r - rho_r * q - pinf * covolume_r;
 
-          auto psi_r =
-              relax_small * rho_r * shift_r -
-              s_min * rho_r * rho_r_gamma * ryujin::pow(covolume_r, -gm1);
+          auto psi_r = relax_small * rho_r * shift_r -
+                       s_min * rho_r * rho_cov_gamma_r * covolume_r;
 
 #ifndef EXPENSIVE_BOUNDS_CHECK
           /*
@@ -227,21 +229,20 @@ namespace ryujin
 
           const auto U_l = U + t_l * P;
           const auto rho_l = view.density(U_l);
-          const auto rho_l_gamma = ryujin::pow(rho_l, gamma);
           const auto covolume_l = Number(1.) - b * rho_l;
+          const auto rho_cov_gamma_l = ryujin::pow(rho_l / covolume_l, gamma);
           const auto rho_e_l = view.internal_energy(U_l);
           const auto shift_l = rho_e_l - rho_l * q - pinf * covolume_l;
 
-          auto psi_l =
-              relax_small * rho_l * shift_l -
-              s_min * rho_l * rho_l_gamma * ryujin::pow(covolume_l, -gm1);
+          auto psi_l = relax_small * rho_l * shift_l -
+                       s_min * rho_l * rho_cov_gamma_l * covolume_l;
 
           /*
            * Verify that the left state is within bounds. This property might
            * be violated for relative CFL numbers larger than 1.
            */
           const auto lower_bound = (ScalarNumber(1.) - relax) * s_min * rho_l *
-                                   rho_l_gamma * ryujin::pow(covolume_l, -gm1);
+                                   rho_cov_gamma_l * covolume_l;
           if (n == 0 &&
               !(std::min(Number(0.), psi_l - lower_bound) == Number(0.))) {
 #ifdef DEBUG_OUTPUT
@@ -292,12 +293,10 @@ namespace ryujin
               ScalarNumber(2.) * rho_r * q +
               pinf * (Number(1.) - ScalarNumber(2.) * b * rho_r);
 
-          const auto extra_term_l = s_min *
-                                    ryujin::pow(rho_l / covolume_l, gamma) *
-                                    (covolume_l + gamma - b * rho_l);
-          const auto extra_term_r = s_min *
-                                    ryujin::pow(rho_r / covolume_r, gamma) *
-                                    (covolume_r + gamma - b * rho_r);
+          const auto extra_term_l =
+              s_min * rho_cov_gamma_l * (covolume_l + gamma - b * rho_l);
+          const auto extra_term_r =
+              s_min * rho_cov_gamma_r * (covolume_r + gamma - b * rho_r);
 
           const auto dpsi_l = rho_l * drho_e_l +
                               (rho_e_l - q_pinf_term_l - extra_term_l) * drho;
@@ -327,18 +326,18 @@ namespace ryujin
           const auto rho_new = view.density(U_new);
           const auto covolume_new = Number(1.) - b * rho_new;
 
-          const auto rho_new_gamma = ryujin::pow(rho_new, gamma);
+          const auto rho_cov_gamma_new =
+              ryujin::pow(rho_new / covolume_new, gamma);
           const auto rho_e_new = view.internal_energy(U_new);
 
           const auto shift_new = rho_e_new - rho_new * q - pinf * covolume_new;
 
           const auto psi_new =
               relax_small * rho_new * shift_new -
-              s_min * rho_new * rho_new_gamma * ryujin::pow(covolume_new, -gm1);
+              s_min * rho_new * rho_cov_gamma_new * covolume_new;
 
           const auto lower_bound = (ScalarNumber(1.) - relax) * s_min *
-                                   rho_new * rho_new_gamma *
-                                   ryujin::pow(covolume_new, -gm1);
+                                   rho_new * rho_cov_gamma_new * covolume_new;
 
           const bool e_valid = std::min(Number(0.), shift_new) == Number(0.);
           const bool psi_valid =
@@ -108,6 +108,17 @@ namespace ryujin
                      const unsigned int *js,
                      const dealii::Tensor<1, dim, Number> &n_ij) const;
 
+      /**
+       * Variant of above function for a (SIMD vectorized) state U_i that
+       * is associated with individual indices @p is instead of a
+       * contiguous range of indices starting at i.
+       */
+      Number compute(const state_type &U_i,
+                     const state_type &U_j,
+                     const unsigned int *is,
+                     const unsigned int *js,
+                     const dealii::Tensor<1, dim, Number> &n_ij) const;
+
       //@}
 
     protected:
@@ -249,6 +260,17 @@ namespace ryujin
                               const Number &p,
                               const dealii::Tensor<1, dim, Number> &n_ij) const;
 
+      /**
+       * Variant of above function that takes a precomputed surrogate
+       * gamma @p gamma and surrogate speed of sound @p a.
+       */
+      primitive_type
+      riemann_data_from_state(const state_type &U,
+                              const Number &p,
+                              const Number &gamma,
+                              const Number &a,
+                              const dealii::Tensor<1, dim, Number> &n_ij) const;
+
     private:
       const HyperbolicSystem &hyperbolic_system;
       const Parameters &parameters;
@@ -564,20 +564,35 @@ namespace ryujin
     {
       const auto view = hyperbolic_system.view<dim, Number>();
 
+      const auto gamma = view.surrogate_gamma(U, p);
+      const auto a = view.surrogate_speed_of_sound(U, p, gamma);
+
+      return riemann_data_from_state(U, p, gamma, a, n_ij);
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline auto
+    RiemannSolver<dim, Number>::riemann_data_from_state(
+        const state_type &U,
+        const Number &p,
+        const Number &gamma,
+        const Number &a,
+        const dealii::Tensor<1, dim, Number> &n_ij) const -> primitive_type
+    {
+      const auto view = hyperbolic_system.view<dim, Number>();
+
       const auto rho = view.density(U);
       const auto rho_inverse = ScalarNumber(1.0) / rho;
 
       const auto m = view.momentum(U);
       const auto proj_m = n_ij * m;
 
-      const auto gamma = view.surrogate_gamma(U, p);
-
+#ifdef EXPENSIVE_BOUNDS_CHECK
       const auto interpolation_b = view.eos_interpolation_b();
       const auto pinf = view.eos_interpolation_pinfty();
       const auto x = Number(1.) - interpolation_b * rho;
-      const auto a = std::sqrt(gamma * (p + pinf) / (rho * x));
 
-#ifdef EXPENSIVE_BOUNDS_CHECK
       AssertThrowSIMD(
           Number(p + pinf),
           [](auto val) { return val >= ScalarNumber(0.); },
@@ -692,6 +707,18 @@ namespace ryujin
         const unsigned int *js,
         const dealii::Tensor<1, dim, Number> &n_ij) const
     {
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      const auto &[p_i, unused_i, s_i, eta_i, gamma_i, a_i] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(i);
+
+      const auto &[p_j, unused_j, s_j, eta_j, gamma_j, a_j] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(js);
+
+      const auto riemann_data_i =
+          riemann_data_from_state(U_i, p_i, gamma_i, a_i, n_ij);
+      const auto riemann_data_j =
+          riemann_data_from_state(U_j, p_j, gamma_j, a_j, n_ij);
+#else
       const auto &[p_i, unused_i, s_i, eta_i] =
           precomputed_values.template get_tensor<Number, precomputed_type>(i);
 
@@ -700,6 +727,41 @@ namespace ryujin
 
       const auto riemann_data_i = riemann_data_from_state(U_i, p_i, n_ij);
       const auto riemann_data_j = riemann_data_from_state(U_j, p_j, n_ij);
+#endif
+
+      return compute(riemann_data_i, riemann_data_j);
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline Number RiemannSolver<dim, Number>::compute(
+        const state_type &U_i,
+        const state_type &U_j,
+        const unsigned int *is,
+        const unsigned int *js,
+        const dealii::Tensor<1, dim, Number> &n_ij) const
+    {
+#ifdef EULER_AEOS_CACHE_SURROGATES
+      const auto &[p_i, unused_i, s_i, eta_i, gamma_i, a_i] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(is);
+
+      const auto &[p_j, unused_j, s_j, eta_j, gamma_j, a_j] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(js);
+
+      const auto riemann_data_i =
+          riemann_data_from_state(U_i, p_i, gamma_i, a_i, n_ij);
+      const auto riemann_data_j =
+          riemann_data_from_state(U_j, p_j, gamma_j, a_j, n_ij);
+#else
+      const auto &[p_i, unused_i, s_i, eta_i] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(is);
+
+      const auto &[p_j, unused_j, s_j, eta_j] =
+          precomputed_values.template get_tensor<Number, precomputed_type>(js);
+
+      const auto riemann_data_i = riemann_data_from_state(U_i, p_i, n_ij);
+      const auto riemann_data_j = riemann_data_from_state(U_j, p_j, n_ij);
+#endif
 
       return compute(riemann_data_i, riemann_data_j);
     }
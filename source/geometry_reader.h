@@ -2,9 +2,15 @@
 
 #include "geometry_common_includes.h"
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/grid/grid_in.h>
 
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
 #include <fstream>
+#include <type_traits>
 
 namespace ryujin
 {
@@ -20,6 +26,13 @@ namespace ryujin
      * file. Supported boundary IDs and their meaning are collected in the
      * Boundary enum.
      *
+     * The mesh file is only parsed on rank 0. The resulting coarse mesh
+     * description (vertices, cells, and boundary information) is sent to
+     * all other ranks in a compact binary format. Optionally, this
+     * binary description is also stored in a cache file next to the mesh
+     * file. Subsequent runs then load the cache instead of parsing the
+     * text again, unless the mesh file has been modified in between.
+     *
      * @ingroup Mesh
      */
     template <int dim>
@@ -35,18 +48,233 @@ namespace ryujin
                             "The mesh file to read in via dealii::GridIn. This "
                             "class supports, among others, reading in Gmsh "
                             "*.msh files, and the *.ucd file format.");
+
+        cache_ = false;
+        this->add_parameter(
+            "binary cache",
+            cache_,
+            "Store the parsed coarse mesh in a binary cache file "
+            "(\"<filename>.cache\") that is used instead of the mesh file in "
+            "subsequent runs as long as the mesh file is not modified.");
       }
 
       void create_triangulation(
           typename Geometry<dim>::Triangulation &triangulation) final
       {
-        dealii::GridIn<dim> gridin;
-        gridin.attach_triangulation(triangulation);
-        gridin.read(filename_);
+        if constexpr (dim == 1) {
+          /* Boundary ids are attached to vertices in 1D, read in directly: */
+          dealii::GridIn<dim> gridin;
+          gridin.attach_triangulation(triangulation);
+          gridin.read(filename_);
+
+        } else {
+          const auto &mpi_communicator = triangulation.get_communicator();
+          const auto rank =
+              dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+
+          /*
+           * Read in the coarse mesh description on rank 0 and broadcast
+           * it. An empty buffer signals an error on rank 0, in which case
+           * rank 0 rethrows the original exception and all other ranks
+           * throw a generic one.
+           */
+
+          std::vector<char> buffer;
+          std::exception_ptr exception;
+          if (rank == 0) {
+            try {
+              buffer = read_coarse_mesh_description();
+            } catch (...) {
+              buffer.clear();
+              exception = std::current_exception();
+            }
+          }
+
+          broadcast(buffer, mpi_communicator);
+
+          if (exception)
+            std::rethrow_exception(exception);
+          AssertThrow(!buffer.empty(),
+                      dealii::ExcMessage("Could not read in mesh file \"" +
+                                         filename_ + "\""));
+
+          std::vector<dealii::Point<dim>> vertices;
+          std::vector<dealii::CellData<dim>> cells;
+          dealii::SubCellData subcell_data;
+          unpack(buffer, vertices, cells, subcell_data);
+          buffer = std::vector<char>();
+
+          triangulation.create_triangulation(vertices, cells, subcell_data);
+        }
       }
 
     private:
       std::string filename_;
+      bool cache_;
+
+      static constexpr std::uint64_t magic_ = 0x72796a75696e0001 + dim;
+
+      /*
+       * Parse the mesh file (or load the binary cache) and return the
+       * packed coarse mesh description.
+       */
+      std::vector<char> read_coarse_mesh_description() const
+      {
+        const std::string cache_filename = filename_ + ".cache";
+
+        namespace fs = std::filesystem;
+        if (cache_ && fs::exists(cache_filename) &&
+            fs::last_write_time(cache_filename) >=
+                fs::last_write_time(filename_)) {
+          std::ifstream file(cache_filename, std::ios::binary);
+          std::vector<char> buffer((std::istreambuf_iterator<char>(file)),
+                                   std::istreambuf_iterator<char>());
+
+          std::uint64_t magic = 0;
+          if (buffer.size() >= sizeof(magic))
+            std::memcpy(&magic, buffer.data(), sizeof(magic));
+          if (magic == magic_)
+            return buffer;
+        }
+
+        dealii::Triangulation<dim> serial_triangulation;
+        dealii::GridIn<dim> gridin;
+        gridin.attach_triangulation(serial_triangulation);
+        gridin.read(filename_);
+
+        const auto [vertices, cells, subcell_data] =
+            dealii::GridTools::get_coarse_mesh_description(
+                serial_triangulation);
+        serial_triangulation.clear();
+
+        std::vector<char> buffer;
+        pack(buffer, vertices, cells, subcell_data);
+
+        if (cache_) {
+          std::ofstream file(cache_filename, std::ios::binary);
+          file.write(buffer.data(), buffer.size());
+        }
+
+        return buffer;
+      }
+
+
+      /*
+       * Broadcast the buffer from rank 0 in chunks so that the total size
+       * can exceed the range of an int.
+       */
+      static void broadcast(std::vector<char> &buffer,
+                            const MPI_Comm &mpi_communicator)
+      {
+        std::uint64_t size = buffer.size();
+        int ierr = MPI_Bcast(&size, 1, MPI_UINT64_T, 0, mpi_communicator);
+        AssertThrowMPI(ierr);
+        buffer.resize(size);
+
+        constexpr std::uint64_t chunk_size = 1 << 30;
+        for (std::uint64_t offset = 0; offset < size; offset += chunk_size) {
+          const int count = std::min(chunk_size, size - offset);
+          ierr = MPI_Bcast(
+              buffer.data() + offset, count, MPI_CHAR, 0, mpi_communicator);
+          AssertThrowMPI(ierr);
+        }
+      }
+
+
+      template <typename T>
+      static void append(std::vector<char> &buffer, const T &value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto data = reinterpret_cast<const char *>(&value);
+        buffer.insert(buffer.end(), data, data + sizeof(T));
+      }
+
+
+      template <typename T>
+      static void extract(const char *&position, T &value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+      }
+
+
+      template <int celldim>
+      static void
+      append_cells(std::vector<char> &buffer,
+                   const std::vector<dealii::CellData<celldim>> &cells)
+      {
+        append(buffer, static_cast<std::uint64_t>(cells.size()));
+        for (const auto &cell : cells) {
+          append(buffer, static_cast<std::uint32_t>(cell.vertices.size()));
+          for (const auto &vertex : cell.vertices)
+            append(buffer, vertex);
+          append(buffer, cell.material_id);
+          append(buffer, cell.manifold_id);
+        }
+      }
+
+
+      template <int celldim>
+      static void extract_cells(const char *&position,
+                                std::vector<dealii::CellData<celldim>> &cells)
+      {
+        std::uint64_t n_cells;
+        extract(position, n_cells);
+        cells.resize(n_cells);
+        for (auto &cell : cells) {
+          std::uint32_t n_vertices;
+          extract(position, n_vertices);
+          cell.vertices.resize(n_vertices);
+          for (auto &vertex : cell.vertices)
+            extract(position, vertex);
+          extract(position, cell.material_id);
+          extract(position, cell.manifold_id);
+        }
+      }
+
+
+      static void pack(std::vector<char> &buffer,
+                       const std::vector<dealii::Point<dim>> &vertices,
+                       const std::vector<dealii::CellData<dim>> &cells,
+                       const dealii::SubCellData &subcell_data)
+      {
+        append(buffer, magic_);
+        append(buffer, static_cast<std::uint64_t>(vertices.size()));
+        for (const auto &vertex : vertices)
+          for (unsigned int d = 0; d < dim; ++d)
+            append(buffer, vertex[d]);
+        append_cells(buffer, cells);
+        append_cells(buffer, subcell_data.boundary_lines);
+        append_cells(buffer, subcell_data.boundary_quads);
+      }
+
+
+      static void unpack(const std::vector<char> &buffer,
+                         std::vector<dealii::Point<dim>> &vertices,
+                         std::vector<dealii::CellData<dim>> &cells,
+                         dealii::SubCellData &subcell_data)
+      {
+        const char *position = buffer.data();
+
+        std::uint64_t magic;
+        extract(position, magic);
+        AssertThrow(magic == magic_,
+                    dealii::ExcMessage("Invalid binary mesh description"));
+
+        std::uint64_t n_vertices;
+        extract(position, n_vertices);
+        vertices.resize(n_vertices);
+        for (auto &vertex : vertices)
+          for (unsigned int d = 0; d < dim; ++d)
+            extract(position, vertex[d]);
+        extract_cells(position, cells);
+        extract_cells(position, subcell_data.boundary_lines);
+        extract_cells(position, subcell_data.boundary_quads);
+
+        Assert(position == buffer.data() + buffer.size(),
+               dealii::ExcInternalError());
+      }
     };
   } // namespace Geometries
 } // namespace ryujin
@@ -9,8 +9,16 @@
 #include "lazy.h"
 #include "patterns_conversion.h"
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/parameter_acceptor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iomanip>
+#include <limits>
+#include <mutex>
+#include <vector>
 
 #ifdef WITH_GDAL
 #include <cpl_conv.h>
@@ -47,6 +55,17 @@ namespace ryujin
    * https://gdal.org/index.html for details on GDAL and what image
    * formats it supports.
    *
+   * The raster is not read in as a whole. Instead, it is split into
+   * square tiles that are read in (with a windowed GDAL read) on first
+   * access from compute_height(). This way every rank only holds the
+   * part of the raster that covers its share of the mesh. Optionally, a
+   * coarser overview (pyramid) level stored in the image can be used
+   * instead of the full resolution raster.
+   *
+   * Alternatively, the raster can be read in once per compute node into
+   * an MPI shared memory window that all ranks of the node access
+   * directly (see the "shared memory" parameter).
+   *
    * @ingroup ShallowWaterEquations
    */
   template <int dim>
@@ -107,22 +126,74 @@ namespace ryujin
                           "GeoTIFF: choose base point for height normalization "
                           "that is set to 0.: none, minimum, average, maximum");
 
+      tile_size_ = 512;
+      this->add_parameter("tile size",
+                          tile_size_,
+                          "GeoTIFF: edge length (in pixels) of the square "
+                          "tiles the raster is read in with on first access");
+
+      overview_resolution_ = 0.;
+      this->add_parameter(
+          "overview resolution",
+          overview_resolution_,
+          "GeoTIFF: if set to a value larger than zero, use the coarsest "
+          "overview (pyramid) level stored in the image whose pixel size "
+          "does not exceed the given value. A good choice is the smallest "
+          "mesh size in the region covered by the raster. If set to zero, "
+          "the full resolution raster is used.");
+
+      shared_memory_ = false;
+      this->add_parameter(
+          "shared memory",
+          shared_memory_,
+          "GeoTIFF: read in the (full) raster once per compute node into an "
+          "MPI shared memory window instead of reading individual tiles on "
+          "every rank. The raster is read in collectively right after "
+          "parameter parsing; the option must thus be set identically on "
+          "all ranks.");
+
       const auto set_up = [&] {
 #ifdef WITH_GDAL
         /* Initial GDAL and reset all data: */
         GDALAllRegister();
+        close_dataset();
+        free_shared_raster();
+        geotiff_guard_.reset();
         driver_name_ = "";
         driver_projection_ = "";
         affine_transformation_ = {0, 0, 0, 0, 0, 0};
         inverse_affine_transformation_ = {0, 0, 0, 0, 0, 0};
         raster_offset_ = {0, 0};
         raster_size_ = {0, 0};
-        raster_.clear();
+        height_shift_ = 0.;
+        tiles_.clear();
 #endif
       };
 
       set_up();
       this->parse_parameters_call_back.connect(set_up);
+
+      /*
+       * The shared memory window has to be set up collectively on all
+       * ranks of a node, so we cannot defer it to the first call of
+       * compute_height():
+       */
+      this->parse_parameters_call_back.connect([&] {
+        if (shared_memory_)
+          geotiff_guard_.ensure_initialized([&]() {
+            read_in_raster();
+            return true;
+          });
+      });
+    }
+
+
+    ~GeoTIFFReader()
+    {
+#ifdef WITH_GDAL
+      close_dataset();
+      free_shared_raster();
+#endif
     }
 
 
@@ -167,13 +238,13 @@ namespace ryujin
        */
 
       const auto i_left = std::min(
-          std::max(static_cast<int>(std::floor(di)), 0), raster_size_[0]);
+          std::max(static_cast<int>(std::floor(di)), 0), raster_size_[0] - 1);
       const auto i_right = std::min(
-          std::max(static_cast<int>(std::ceil(di)), 0), raster_size_[0]);
+          std::max(static_cast<int>(std::ceil(di)), 0), raster_size_[0] - 1);
       const auto j_left = std::min(
-          std::max(static_cast<int>(std::floor(dj)), 0), raster_size_[1]);
+          std::max(static_cast<int>(std::floor(dj)), 0), raster_size_[1] - 1);
       const auto j_right = std::min(
-          std::max(static_cast<int>(std::ceil(dj)), 0), raster_size_[1]);
+          std::max(static_cast<int>(std::ceil(dj)), 0), raster_size_[1] - 1);
 
 #ifdef DEBUG_OUTPUT
       if (!in_bounds) {
@@ -185,11 +256,11 @@ namespace ryujin
       const double i_ratio = std::fmod(di, 1.);
       const double j_ratio = std::fmod(dj, 1.);
 
-      const auto v_iljl = raster_[i_left + j_left * raster_size_[0]];
-      const auto v_irjl = raster_[i_right + j_left * raster_size_[0]];
+      const auto v_iljl = raster_value(i_left, j_left);
+      const auto v_irjl = raster_value(i_right, j_left);
 
-      const auto v_iljr = raster_[i_left + j_right * raster_size_[0]];
-      const auto v_irjr = raster_[i_right + j_right * raster_size_[0]];
+      const auto v_iljr = raster_value(i_left, j_right);
+      const auto v_irjr = raster_value(i_right, j_right);
 
       const auto v_jl = v_iljl * (1. - i_ratio) + v_irjl * i_ratio;
       const auto v_jr = v_iljr * (1. - i_ratio) + v_irjr * i_ratio;
@@ -211,11 +282,11 @@ namespace ryujin
     void read_in_raster() const
     {
 #ifdef WITH_GDAL
-      auto dataset_handle = GDALOpen(filename_.c_str(), GA_ReadOnly);
-      AssertThrow(dataset_handle,
+      dataset_handle_ = GDALOpen(filename_.c_str(), GA_ReadOnly);
+      AssertThrow(dataset_handle_,
                   dealii::ExcMessage("GDAL error: file not found"));
 
-      auto dataset = GDALDataset::FromHandle(dataset_handle);
+      auto dataset = GDALDataset::FromHandle(dataset_handle_);
       Assert(dataset, dealii::ExcInternalError());
 
       const auto driver = dataset->GetDriver();
@@ -231,43 +302,20 @@ namespace ryujin
           dealii::ExcMessage(
               "GDAL driver error: currently we only support one raster"));
 
-      const auto raster_band = dataset->GetRasterBand(1);
+      raster_band_ = dataset->GetRasterBand(1);
 
-      AssertThrow(dataset->GetRasterXSize() == raster_band->GetXSize() &&
-                      dataset->GetRasterYSize() == raster_band->GetYSize(),
+      AssertThrow(dataset->GetRasterXSize() == raster_band_->GetXSize() &&
+                      dataset->GetRasterYSize() == raster_band_->GetYSize(),
                   dealii::ExcMessage(
                       "GDAL driver error: the raster band has a different "
                       "dimension than the (global) raster dimension of the "
                       "geotiff image. This is not supported."));
 
-      /*
-       * FIXME: For now, we simply read in the entire geotiff file on
-       * each rank. In order to save memory for very large files it would
-       * be possible to create a bounding box for the all active cells of
-       * the triangulation and then only read in a small region for which
-       * we actually need data.
-       */
+      const std::array<int, 2> full_size{dataset->GetRasterXSize(),
+                                         dataset->GetRasterYSize()};
 
       raster_offset_ = {0, 0};
-      raster_size_ = {dataset->GetRasterXSize(), dataset->GetRasterYSize()};
-
-      raster_.resize(raster_size_[0] * raster_size_[1]);
-      const auto error_code = raster_band->RasterIO(
-          GF_Read,
-          raster_offset_[0], /* x-offset of image region */
-          raster_offset_[1], /* y-offset of image region */
-          raster_size_[0],   /* x-size of image region */
-          raster_size_[1],   /* y-size of image region */
-          raster_.data(),
-          raster_size_[0], /* x-size of target buffer */
-          raster_size_[1], /* y-size of target buffer */
-          GDT_Float32,
-          0,
-          0);
-
-      AssertThrow(error_code == 0,
-                  dealii::ExcMessage(
-                      "GDAL driver error: error reading in geotiff file"));
+      raster_size_ = full_size;
 
       /*
        * Read in the affine transformation from the geotiff image.
@@ -292,6 +340,39 @@ namespace ryujin
         affine_transformation_[5] *= -1.;
       }
 
+      /*
+       * Select the coarsest overview level whose pixel size does not
+       * exceed the requested resolution and rescale the affine
+       * transformation to the index space of the overview:
+       */
+      if (overview_resolution_ > 0.) {
+        const auto &at = affine_transformation_;
+        const double pixel_size = std::max(std::hypot(at[1], at[4]),
+                                           std::hypot(at[2], at[5]));
+
+        const auto full_band = raster_band_;
+        for (int k = 0; k < full_band->GetOverviewCount(); ++k) {
+          const auto overview = full_band->GetOverview(k);
+          const double ratio = std::max(
+              static_cast<double>(full_size[0]) / overview->GetXSize(),
+              static_cast<double>(full_size[1]) / overview->GetYSize());
+          if (ratio * pixel_size <= overview_resolution_ &&
+              overview->GetXSize() < raster_band_->GetXSize())
+            raster_band_ = overview;
+        }
+
+        raster_size_ = {raster_band_->GetXSize(), raster_band_->GetYSize()};
+
+        const double ratio_i =
+            static_cast<double>(full_size[0]) / raster_size_[0];
+        const double ratio_j =
+            static_cast<double>(full_size[1]) / raster_size_[1];
+        affine_transformation_[1] *= ratio_i;
+        affine_transformation_[4] *= ratio_i;
+        affine_transformation_[2] *= ratio_j;
+        affine_transformation_[5] *= ratio_j;
+      }
+
       /*
        * Ensure that (i=0, j=raster_size[1]-1) corresponds to the user
        * supplied (transformation_[0], transformation_[3]).
@@ -327,8 +408,6 @@ namespace ryujin
       inverse_affine_transformation_[4] = inv * (-affine_transformation_[4]);
       inverse_affine_transformation_[5] = inv * affine_transformation_[1];
 
-      GDALClose(dataset_handle);
-
 #ifdef DEBUG_OUTPUT
       std::cout << std::setprecision(16);
       std::cout << "GDAL: driver name    = " << driver_name_;
@@ -348,25 +427,46 @@ namespace ryujin
       std::cout << std::endl;
 #endif
 
+      /*
+       * Compute the height normalization from the band statistics. This
+       * streams through the raster (or uses statistics stored in the
+       * image) without holding it in memory:
+       */
+
+      height_shift_ = 0.;
       if (height_normalization_ != HeightNormalization::none) {
-        float shift = 0.;
+        double minimum, maximum, mean, standard_deviation;
+        const auto error_code = raster_band_->GetStatistics(
+            FALSE, TRUE, &minimum, &maximum, &mean, &standard_deviation);
+        AssertThrow(error_code == CE_None,
+                    dealii::ExcMessage("GDAL driver error: could not compute "
+                                       "raster statistics"));
 
         if (height_normalization_ == HeightNormalization::minimum)
-          shift = *std::min_element(std::begin(raster_), std::end(raster_));
+          height_shift_ = minimum;
         else if (height_normalization_ == HeightNormalization::maximum)
-          shift = *std::max_element(std::begin(raster_), std::end(raster_));
+          height_shift_ = maximum;
         else {
           Assert(height_normalization_ == HeightNormalization::average,
                  dealii::ExcInternalError());
-          const auto sum = std::reduce(std::begin(raster_), std::end(raster_));
-          shift = sum / raster_.size();
+          height_shift_ = mean;
         }
+      }
 
-        std::for_each(std::begin(raster_),
-                      std::end(raster_),
-                      [&](auto &element) { element -= shift; });
+      if (shared_memory_) {
+        read_in_shared_raster();
+        return;
       }
 
+      /* Set up (empty) tiles: */
+
+      AssertThrow(tile_size_ > 0,
+                  dealii::ExcMessage("The tile size must be positive"));
+      n_tiles_ = {(raster_size_[0] + tile_size_ - 1) / tile_size_,
+                  (raster_size_[1] + tile_size_ - 1) / tile_size_};
+      tiles_.clear();
+      tiles_.resize(n_tiles_[0] * n_tiles_[1]);
+
 #else
       static constexpr auto message =
           "ryujin has to be configured with GDAL support in order to read in "
@@ -377,6 +477,183 @@ namespace ryujin
     }
 
 
+#ifdef WITH_GDAL
+    void close_dataset() const
+    {
+      if (dataset_handle_ != nullptr)
+        GDALClose(dataset_handle_);
+      dataset_handle_ = nullptr;
+      raster_band_ = nullptr;
+    }
+
+
+    /*
+     * Read in the whole raster into a shared memory window on the first
+     * rank of every node and let all other ranks of the node query the
+     * base address of the window.
+     */
+    void read_in_shared_raster() const
+    {
+      /* Group all ranks on the same node that read in the same image: */
+
+      MPI_Comm node_communicator;
+      int ierr = MPI_Comm_split_type(MPI_COMM_WORLD,
+                                     MPI_COMM_TYPE_SHARED,
+                                     0,
+                                     MPI_INFO_NULL,
+                                     &node_communicator);
+      AssertThrowMPI(ierr);
+
+      const auto color = static_cast<int>(std::hash<std::string>{}(filename_) %
+                                          std::numeric_limits<int>::max());
+      ierr = MPI_Comm_split(node_communicator, color, 0, &shared_communicator_);
+      AssertThrowMPI(ierr);
+      MPI_Comm_free(&node_communicator);
+
+      const auto rank =
+          dealii::Utilities::MPI::this_mpi_process(shared_communicator_);
+
+      const std::size_t n_pixels =
+          static_cast<std::size_t>(raster_size_[0]) * raster_size_[1];
+      const MPI_Aint size = (rank == 0) ? n_pixels * sizeof(float) : 0;
+
+      float *base = nullptr;
+      ierr = MPI_Win_allocate_shared(size,
+                                     sizeof(float),
+                                     MPI_INFO_NULL,
+                                     shared_communicator_,
+                                     &base,
+                                     &shared_window_);
+      AssertThrowMPI(ierr);
+
+      if (rank != 0) {
+        MPI_Aint query_size;
+        int displacement_unit;
+        ierr = MPI_Win_shared_query(
+            shared_window_, 0, &query_size, &displacement_unit, &base);
+        AssertThrowMPI(ierr);
+      }
+
+      int error_code = 0;
+      if (rank == 0) {
+        error_code = raster_band_->RasterIO(GF_Read,
+                                            0,
+                                            0,
+                                            raster_size_[0],
+                                            raster_size_[1],
+                                            base,
+                                            raster_size_[0],
+                                            raster_size_[1],
+                                            GDT_Float32,
+                                            0,
+                                            0);
+
+        if (height_shift_ != 0.)
+          std::for_each(base, base + n_pixels, [&](auto &element) {
+            element -= height_shift_;
+          });
+      }
+
+      /* Make the raster visible to all ranks and propagate errors: */
+
+      ierr = MPI_Win_fence(0, shared_window_);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Bcast(&error_code, 1, MPI_INT, 0, shared_communicator_);
+      AssertThrowMPI(ierr);
+      AssertThrow(error_code == 0,
+                  dealii::ExcMessage(
+                      "GDAL driver error: error reading in geotiff file"));
+
+      shared_raster_ = base;
+    }
+
+
+    void free_shared_raster() const
+    {
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if (finalized)
+        return;
+
+      if (shared_window_ != MPI_WIN_NULL)
+        MPI_Win_free(&shared_window_);
+      if (shared_communicator_ != MPI_COMM_NULL)
+        MPI_Comm_free(&shared_communicator_);
+      shared_raster_ = nullptr;
+    }
+
+
+    /*
+     * Read in tile (a, b) with a windowed read and apply the height
+     * normalization.
+     */
+    std::vector<float> read_tile(const int a, const int b) const
+    {
+      const int offset_i = a * tile_size_;
+      const int offset_j = b * tile_size_;
+      const int size_i = std::min<int>(tile_size_, raster_size_[0] - offset_i);
+      const int size_j = std::min<int>(tile_size_, raster_size_[1] - offset_j);
+
+      std::vector<float> tile(size_i * size_j);
+
+      {
+        /* GDAL datasets must not be accessed concurrently: */
+        std::lock_guard<std::mutex> lock(gdal_mutex_);
+        const auto error_code = raster_band_->RasterIO(GF_Read,
+                                                       offset_i,
+                                                       offset_j,
+                                                       size_i,
+                                                       size_j,
+                                                       tile.data(),
+                                                       size_i,
+                                                       size_j,
+                                                       GDT_Float32,
+                                                       0,
+                                                       0);
+        AssertThrow(error_code == 0,
+                    dealii::ExcMessage(
+                        "GDAL driver error: error reading in geotiff file"));
+      }
+
+      if (height_shift_ != 0.)
+        std::for_each(std::begin(tile), std::end(tile), [&](auto &element) {
+          element -= height_shift_;
+        });
+
+      return tile;
+    }
+#endif
+
+
+    /*
+     * Return the raster value at index (i, j) and read in the
+     * corresponding tile if necessary.
+     */
+    DEAL_II_ALWAYS_INLINE inline float raster_value(const int i,
+                                                    const int j) const
+    {
+#ifdef WITH_GDAL
+      if (shared_raster_ != nullptr)
+        return shared_raster_[i + static_cast<std::size_t>(j) *
+                                      raster_size_[0]];
+
+      const int a = i / tile_size_;
+      const int b = j / tile_size_;
+
+      const auto &tile = tiles_[a + b * n_tiles_[0]];
+      tile.ensure_initialized([&]() { return read_tile(a, b); });
+
+      const int size_i =
+          std::min<int>(tile_size_, raster_size_[0] - a * tile_size_);
+      return tile.value()[(i - a * tile_size_) + (j - b * tile_size_) * size_i];
+#else
+      (void)i;
+      (void)j;
+      return 0.;
+#endif
+    }
+
+
     DEAL_II_ALWAYS_INLINE inline std::array<double, 2>
     apply_transformation(const double i, const double j) const
     {
@@ -406,6 +683,9 @@ namespace ryujin
     bool transformation_use_geotiff_origin_;
     HeightNormalization height_normalization_;
     double height_scaling_;
+    int tile_size_;
+    double overview_resolution_;
+    bool shared_memory_;
 
     /* GDAL data structures: */
 
@@ -420,6 +700,19 @@ namespace ryujin
     mutable std::array<double, 6> inverse_affine_transformation_;
     mutable std::array<int, 2> raster_offset_;
     mutable std::array<int, 2> raster_size_;
-    mutable std::vector<float> raster_;
+    mutable float height_shift_;
+
+#ifdef WITH_GDAL
+    mutable GDALDatasetH dataset_handle_ = nullptr;
+    mutable GDALRasterBand *raster_band_ = nullptr;
+    mutable std::mutex gdal_mutex_;
+
+    mutable MPI_Comm shared_communicator_ = MPI_COMM_NULL;
+    mutable MPI_Win shared_window_ = MPI_WIN_NULL;
+    mutable float *shared_raster_ = nullptr;
+#endif
+
+    mutable std::array<int, 2> n_tiles_;
+    mutable std::vector<Lazy<std::vector<float>>> tiles_;
   };
 } // namespace ryujin
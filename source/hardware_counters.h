@@ -0,0 +1,246 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "openmp.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef WITH_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ryujin
+{
+  /**
+   * A minimal hardware performance counter collection based on the Linux
+   * perf_event interface. The class is a process-wide singleton that is
+   * initialized once in main() and that accumulates counter values for
+   * every timer section managed by a Scope object if ryujin is configured
+   * with WITH_PERF_EVENT. Without this option all functions are no-ops.
+   *
+   * Every (OpenMP) thread opens its own group of counters, which can
+   * then be read from any thread. This way a Scope on the main thread
+   * accumulates the counters of all worker threads executing the
+   * compute kernels of the section.
+   *
+   * The following events are collected:
+   *  - cycles and instructions (PERF_COUNT_HW_CPU_CYCLES and
+   *    PERF_COUNT_HW_INSTRUCTIONS),
+   *  - last level cache misses (PERF_COUNT_HW_CACHE_MISSES) that serve
+   *    as an estimate for the memory traffic of a section (assuming 64
+   *    bytes per cache line and neglecting write backs),
+   *  - an optional raw, architecture specific event counting floating
+   *    point operations that is selected by setting the environment
+   *    variable RYUJIN_PERF_FLOP_EVENT to the raw event code (for
+   *    example, 0x0f03 for "retired SSE/AVX flops" on AMD Zen).
+   *
+   * @ingroup Miscellaneous
+   */
+  class HardwareCounters
+  {
+  public:
+    /**
+     * The collected events.
+     */
+    enum Event : unsigned int {
+      cycles,
+      instructions,
+      cache_misses,
+      flops,
+      n_events,
+    };
+
+    /**
+     * An array holding one value per event.
+     */
+    using Values = std::array<std::uint64_t, n_events>;
+
+    /**
+     * The size of a cache line used for converting cache misses into
+     * transferred bytes.
+     */
+    static constexpr unsigned int cache_line_size = 64;
+
+    /**
+     * Return a reference to the singleton.
+     */
+    static HardwareCounters &instance()
+    {
+      static HardwareCounters hardware_counters;
+      return hardware_counters;
+    }
+
+    /**
+     * Open a group of counters on every thread of the OpenMP thread
+     * pool. Has to be called after the thread pool has been set up.
+     */
+    void initialize()
+    {
+#ifdef WITH_PERF_EVENT
+      std::uint64_t flop_event = 0;
+      if (const char *value = std::getenv("RYUJIN_PERF_FLOP_EVENT"))
+        flop_event = std::strtoull(value, nullptr, 0);
+
+      std::mutex mutex;
+      RYUJIN_PARALLEL_REGION_BEGIN
+      const auto group = open_group(flop_event);
+      std::lock_guard<std::mutex> lock(mutex);
+      file_descriptors_.push_back(group);
+      RYUJIN_PARALLEL_REGION_END
+
+      active_ = file_descriptors_.front()[cycles] >= 0;
+#endif
+    }
+
+    /**
+     * Return true if counters have been successfully opened.
+     */
+    bool active() const
+    {
+      return active_;
+    }
+
+    /**
+     * Start accumulating counter values for a @p section.
+     */
+    void start(const std::string &section)
+    {
+      if (!active_)
+        return;
+      const auto values = read();
+      std::lock_guard<std::mutex> lock(mutex_);
+      started_[section] = values;
+    }
+
+    /**
+     * Stop accumulating counter values for a @p section.
+     */
+    void stop(const std::string &section)
+    {
+      if (!active_)
+        return;
+      const auto values = read();
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto &started = started_[section];
+      auto &accumulated = accumulated_[section];
+      for (unsigned int e = 0; e < n_events; ++e)
+        accumulated[e] += values[e] - started[e];
+    }
+
+    /**
+     * Return the accumulated counter values of a @p section (summed over
+     * all threads).
+     */
+    Values values(const std::string &section) const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto it = accumulated_.find(section);
+      return it != accumulated_.end() ? it->second : Values{};
+    }
+
+  private:
+    HardwareCounters() = default;
+
+    ~HardwareCounters()
+    {
+#ifdef WITH_PERF_EVENT
+      for (const auto &group : file_descriptors_)
+        for (const auto fd : group)
+          if (fd >= 0)
+            close(fd);
+#endif
+    }
+
+#ifdef WITH_PERF_EVENT
+    /**
+     * Open a group of counters for the calling thread. The cycle counter
+     * is the group leader.
+     */
+    static std::array<int, n_events> open_group(std::uint64_t flop_event)
+    {
+      std::array<int, n_events> group;
+      group.fill(-1);
+
+      const auto open = [&](std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr{};
+        attr.size = sizeof(perf_event_attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(__NR_perf_event_open,
+                                        &attr,
+                                        0 /* calling thread */,
+                                        -1 /* any cpu */,
+                                        group[cycles],
+                                        0));
+      };
+
+      group[cycles] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+      if (group[cycles] < 0)
+        return group;
+
+      group[instructions] =
+          open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+      group[cache_misses] =
+          open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+      if (flop_event != 0)
+        group[flops] = open(PERF_TYPE_RAW, flop_event);
+
+      ioctl(group[cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(group[cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      return group;
+    }
+#endif
+
+    /**
+     * Read and sum up the current counter values of all threads.
+     */
+    Values read() const
+    {
+      Values result{};
+#ifdef WITH_PERF_EVENT
+      for (const auto &group : file_descriptors_) {
+        if (group[cycles] < 0)
+          continue;
+
+        /* Layout for PERF_FORMAT_GROUP: number of events, values: */
+        std::array<std::uint64_t, 1 + n_events> buffer{};
+        if (::read(group[cycles], buffer.data(), sizeof(buffer)) <= 0)
+          continue;
+
+        /* Values are stored in the order the events were opened: */
+        unsigned int n = 0;
+        for (unsigned int e = 0; e < n_events && n < buffer[0]; ++e)
+          if (group[e] >= 0)
+            result[e] += buffer[1 + n++];
+      }
+#endif
+      return result;
+    }
+
+    bool active_ = false;
+
+    std::vector<std::array<int, n_events>> file_descriptors_;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Values> started_;
+    std::map<std::string, Values> accumulated_;
+  };
+} // namespace ryujin
@@ -7,10 +7,15 @@
 
 #include <compile_time_options.h>
 
+#include "colocated_vector.h"
 #include "convenience_macros.h"
 #include "initial_values.h"
+#include "kernel_variants.h"
 #include "mpi_ensemble.h"
 #include "offline_data.h"
+#include "openmp.h"
+#include "patterns_conversion.h"
+#include "reduced_precision_exchange.h"
 #include "sparse_matrix_simd.h"
 #include "state_vector.h"
 
@@ -20,7 +25,11 @@
 #include <deal.II/lac/sparse_matrix.templates.h>
 #include <deal.II/lac/vector.h>
 
+#include <atomic>
 #include <functional>
+#include <map>
+#include <string>
+#include <string_view>
 
 namespace ryujin
 {
@@ -56,6 +65,36 @@ namespace ryujin
   };
 
 
+  /**
+   * An enum controlling whether the HyperbolicModule stores or reuses the
+   * data of the "first stage", i.e., a step() call without stage vectors
+   * that computes the time step size. The graph viscosity d_ij, the
+   * indicator alpha_i and the CFL bound of such a step only depend on the
+   * old state and can be reused when the step is repeated with a
+   * different CFL number after a restart.
+   *
+   * @ingroup HyperbolicModule
+   */
+  enum class FirstStageCache : std::uint8_t {
+    /**
+     * Do not store or reuse any data.
+     */
+    none,
+
+    /**
+     * Store d_ij, alpha_i and the CFL bound of the next first stage.
+     */
+    store,
+
+    /**
+     * Reuse the data stored in the previous first stage instead of
+     * recomputing d_ij, alpha_i and the CFL bound. The old state vector
+     * passed to step() must be identical to the one of the stored stage.
+     */
+    reuse,
+  };
+
+
   /**
    * A class signalling a restart, thrown in HyperbolicModule::single_step and
    * caught at various places.
@@ -128,6 +167,15 @@ namespace ryujin
      */
     void prepare();
 
+    /**
+     * Return an estimate (in bytes) of the temporary storage allocated
+     * by prepare() for the current partition of the OfflineData object.
+     * The function only requires the partition and the sparsity pattern
+     * of the OfflineData object to be set up, see
+     * OfflineData::prepare_partition().
+     */
+    std::size_t memory_estimate() const;
+
     //@}
     /**
      * @name Functons for performing explicit time steps
@@ -156,6 +204,17 @@ namespace ryujin
      */
     void prepare_state_vector(StateVector &state_vector, Number t) const;
 
+    /**
+     * Apply the pointwise implicit source update of the hyperbolic
+     * system (if the system has one and it is enabled) to all locally
+     * owned states of @p state_vector for a time step of size @p tau.
+     * The TimeIntegrator calls this function after every successful
+     * time step, which amounts to a first-order (Lie) splitting between
+     * the explicit hyperbolic update and the stiff source. The function
+     * does not update ghost ranges.
+     */
+    void apply_implicit_source(StateVector &state_vector, Number tau) const;
+
     /**
      * Given a reference to a previous state vector @p old_U perform an
      * explicit euler step (and store the result in @p new_U). The
@@ -228,6 +287,94 @@ namespace ryujin
         Number tau = Number(0.),
         std::atomic<Number> tau_max = std::numeric_limits<Number>::max()) const;
 
+    /**
+     * Classify all locally owned degrees of freedom into @p n_levels
+     * local time stepping levels. A degree of freedom is assigned to level
+     * l if its local CFL bound \f$\tau_i = \text{cfl}\,m_i/(2|d_{ii}|)\f$
+     * satisfies \f$2^l\tau_{\text{min}}\le\tau_i<2^{l+1}\tau_{\text{min}}\f$,
+     * where the last level collects all remaining degrees of freedom. The
+     * function uses the d_ij matrix computed in the last call to step()
+     * and returns the fraction of (global) degrees of freedom per level.
+     *
+     * @note This function is collective over the ensemble communicator.
+     */
+    std::vector<double> local_time_step_levels(unsigned int n_levels) const;
+
+    /**
+     * Print the busy time of all threads in the row loops of step() and
+     * the resulting load imbalance (the busy time of the slowest thread
+     * relative to the average) accumulated since the last call to @p
+     * output, and reset the statistics. The function does nothing unless
+     * the run time option "report thread load" is set.
+     *
+     * @note This function is collective over the ensemble communicator
+     * (or the world communicator if global synchronization is enabled).
+     */
+    void print_thread_load_statistics(std::ostream &output) const;
+
+    /**
+     * Print the percentage of rows that skipped the limiter because they
+     * were flagged as smooth (see the run time option "smooth row
+     * threshold") accumulated since the last call to @p output, and
+     * reset the statistics. The function does nothing if the option is
+     * disabled.
+     *
+     * @note This function is collective over the ensemble communicator
+     * (or the world communicator if global synchronization is enabled).
+     */
+    void print_smooth_row_statistics(std::ostream &output) const;
+
+    /**
+     * Return a reference to the registry of kernel variants that are
+     * autotuned during the first calls to step() if the run time option
+     * "autotune kernel variants" is set, see KernelVariantRegistry. The
+     * registry is empty otherwise.
+     */
+    ACCESSOR_READ_ONLY(kernel_variants)
+
+    /**
+     * Record the wall time spent on every locally owned row in the row
+     * loops of step(), see RowWorkStatistics. The recorded work is used
+     * for a cost-weighted repartitioning of the mesh, see
+     * MeshAdaptor::attach_cell_weights(). The setting takes effect with
+     * the next call to prepare().
+     */
+    void record_row_work(const bool enabled) const
+    {
+      record_row_work_ = enabled;
+    }
+
+    /**
+     * Return a reference to the per-row work statistics recorded since
+     * the last call to prepare().
+     */
+    ACCESSOR_READ_ONLY_NO_DEREFERENCE(row_work_statistics)
+
+    /**
+     * Return a reference to the per-row work counters accumulated since
+     * the last call to prepare(), see RowWorkCounters. The counters are
+     * only recorded if ryujin is configured with WORK_COUNTERS.
+     */
+    ACCESSOR_READ_ONLY_NO_DEREFERENCE(row_work_counters)
+
+    /**
+     * Return a reference to the analytic memory traffic (in bytes) and
+     * the number of invocations accumulated for every timed stage of
+     * step(), keyed by the name of the corresponding computing timer.
+     * The estimate streams every vector and stencil entry a stage
+     * touches exactly once and neglects cache reuse, see
+     * TimeLoop::print_timers().
+     */
+    ACCESSOR_READ_ONLY_NO_DEREFERENCE(stage_traffic)
+
+    /**
+     * Reset the accumulated analytic memory traffic.
+     */
+    void clear_stage_traffic() const
+    {
+      stage_traffic_.clear();
+    }
+
     /**
      * Sets the relative CFL number used for computing an appropriate
      * time-step size to the given value. The CFL number must be a positive
@@ -247,6 +394,41 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(cfl)
 
+    /**
+     * Enable or disable local pseudo time stepping for steady state
+     * computations. If enabled, every row i is advanced with its own
+     * maximal time step size \f$\tau_i = \text{cfl}\,m_i/(2|d_{ii}|)\f$
+     * instead of the (global) time step size tau, which step() still
+     * returns. The low-order update and the limiter remain invariant
+     * domain preserving row by row, but the update is no longer
+     * time-accurate (nor conservative). Only meaningful for single stage
+     * (forward Euler) steps.
+     */
+    void local_time_stepping(const bool enabled) const
+    {
+      local_time_stepping_ = enabled;
+    }
+
+    /**
+     * Returns whether local pseudo time stepping is enabled.
+     */
+    ACCESSOR_READ_ONLY(local_time_stepping)
+
+    /**
+     * Sets the prefetch distance (in stencil entries) used in the stencil
+     * loops of step(), see the "prefetch distance" parameter. A value of
+     * 0 disables software prefetching.
+     */
+    void prefetch_distance(unsigned int new_prefetch_distance) const
+    {
+      prefetch_distance_ = new_prefetch_distance;
+    }
+
+    /**
+     * Returns the prefetch distance used in the stencil loops of step().
+     */
+    ACCESSOR_READ_ONLY(prefetch_distance)
+
     /**
      * Return a reference to the OfflineData object
      */
@@ -265,7 +447,8 @@ namespace ryujin
     /**
      * Return a reference to alpha vector storing indicator values. Note
      * that the values stored in alpha correspond to the last step executed
-     * by this class.
+     * by this class. The values are stored with the (potentially reduced)
+     * precision defined by Vectors::indicator_number_type.
      */
     ACCESSOR_READ_ONLY(alpha)
 
@@ -283,12 +466,51 @@ namespace ryujin
     // FIXME: refactor to function
     mutable IDViolationStrategy id_violation_strategy_;
 
+    /**
+     * Controls whether the next first stage stores, or reuses, the
+     * graph viscosity, the indicator and the CFL bound. Set by the
+     * TimeIntegrator around restarts, see FirstStageCache.
+     */
+    mutable FirstStageCache first_stage_cache_;
+
   private:
     //@}
     /**
      * @name Run time options
      */
     //@{
+
+    bool fused_stencil_;
+
+    bool nonblocking_reductions_;
+
+    bool cache_dirichlet_data_;
+
+    mutable LoopSchedule loop_schedule_;
+
+    unsigned int loop_schedule_chunk_size_;
+
+    bool report_thread_load_;
+
+    mutable bool overlap_limiter_exchange_;
+    mutable bool export_range_first_;
+
+    Number smooth_row_threshold_;
+
+    unsigned int active_set_interval_;
+    Number quiescent_tolerance_;
+
+    mutable bool colocate_neighbor_data_;
+
+    mutable unsigned int prefetch_distance_;
+
+    unsigned int temporal_block_size_;
+
+    bool reduced_precision_ghost_exchange_;
+
+    bool autotune_kernel_variants_;
+    unsigned int autotune_samples_;
+
     typename Description::template Indicator<dim, Number>::Parameters
         indicator_parameters_;
 
@@ -316,29 +538,177 @@ namespace ryujin
 
     mutable Number cfl_;
 
+    mutable bool local_time_stepping_;
+
     mutable unsigned int n_restarts_;
 
     mutable unsigned int n_warnings_;
 
     InitialPrecomputedVector initial_precomputed_;
 
+    std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+        precomputed_ghost_partitioner_;
+
+    /* Compact boundary map (without do_nothing entries), see prepare(): */
+    std::vector<std::size_t> boundary_groups_;
+    std::vector<unsigned int> boundary_group_rows_;
+    std::vector<unsigned int> boundary_entries_;
+    std::vector<dealii::types::boundary_id> boundary_ids_;
+    std::vector<dealii::Tensor<1, dim, Number>> boundary_normals_;
+
+    /* Boundary map entries that need Dirichlet data, see prepare(): */
+    std::vector<std::size_t> dirichlet_entries_;
+    std::vector<dealii::Point<dim>> dirichlet_points_;
+
+    /* Coupling boundary pairs packed into SIMD groups, see prepare(): */
+    using CouplingPairsSIMD =
+        std::array<std::array<unsigned int, simd_width<Number>>, 3>;
+    std::vector<CouplingPairsSIMD> coupling_pairs_simd_;
+    mutable std::vector<state_type> dirichlet_data_;
+    mutable bool dirichlet_data_cached_;
+
     using ScalarVector = typename Vectors::ScalarVector<Number>;
-    mutable ScalarVector alpha_;
+    using IndicatorVector = typename Vectors::IndicatorVector<Number>;
+    mutable IndicatorVector alpha_;
 
     static constexpr auto n_bounds =
         Description::template Limiter<dim, Number>::n_bounds;
-    mutable Vectors::MultiComponentVector<Number, n_bounds> bounds_;
+    mutable Vectors::MultiComponentVector<
+        Vectors::indicator_number_type<Number>,
+        n_bounds,
+        simd_width<Number>>
+        bounds_;
+
+    using IndicatorExchange = Vectors::ReducedPrecisionExchange<
+        Vectors::indicator_number_type<Number>>;
+    mutable IndicatorExchange alpha_exchange_;
+    mutable IndicatorExchange bounds_exchange_;
 
     using HyperbolicVector =
         Vectors::MultiComponentVector<Number, problem_dimension>;
     mutable HyperbolicVector r_;
 
-    mutable SparseMatrixSIMD<Number> dij_matrix_;
-    mutable SparseMatrixSIMD<Number> lij_matrix_;
-    mutable SparseMatrixSIMD<Number> lij_matrix_next_;
+    mutable Vectors::ColocatedVector<Number,
+                                     problem_dimension,
+                                     View::n_precomputed_values>
+        colocated_state_;
+
+#ifdef SYMMETRIC_MATRIX_STORAGE
+    using DijMatrix =
+        SymmetricSparseMatrixSIMD<Number,
+                                  simd_width<Number>,
+                                  storage_number_type<Number>>;
+#else
+    using DijMatrix = StorageSparseMatrixSIMD<Number>;
+#endif
+    mutable DijMatrix dij_matrix_;
+    mutable StorageSparseMatrixSIMD<Number> lij_matrix_;
+    mutable StorageSparseMatrixSIMD<Number> lij_matrix_next_;
     mutable SparseMatrixSIMD<Number, problem_dimension> pij_matrix_;
 
+    mutable DijMatrix dij_matrix_first_stage_;
+    mutable IndicatorVector alpha_first_stage_;
+    mutable Number tau_max_first_stage_;
+    mutable bool first_stage_stored_;
+
+    mutable ThreadLoadStatistics thread_load_statistics_;
+
+    mutable bool record_row_work_;
+    mutable RowWorkStatistics row_work_statistics_;
+    mutable RowWorkCounters row_work_counters_;
+
+    mutable KernelVariantRegistry kernel_variants_;
+
+    mutable std::map<std::string, std::pair<double, unsigned int>>
+        stage_traffic_;
+
+    /**
+     * Return the computing timer name "time step [H] step_no - name" of a
+     * stage of step(), or @p name itself if @p step_no is zero. All names
+     * are cached so that step() does not allocate strings after its
+     * first invocation. @p name has to be a string literal.
+     */
+    const std::string &timer_name(const std::string_view name,
+                                  const int step_no = 0) const;
+
+    mutable std::map<std::pair<int, std::string_view>, std::string>
+        timer_names_;
+    double n_stencil_entries_;
+
+    mutable std::atomic<std::size_t> n_smooth_rows_;
+    mutable std::atomic<std::size_t> n_limited_rows_;
+
+    mutable ScalarVector active_;
+    mutable ScalarVector active_scratch_;
+    mutable unsigned int active_set_age_;
+
+    /**
+     * The actions of the temporally blocked execution of Steps 4, 5, and
+     * the first pass of Step 6, see prepare_temporal_blocking().
+     */
+    enum class TemporalBlockAction : std::uint8_t {
+      step_4,
+      start_exchange_4,
+      finish_exchange_4,
+      step_5,
+      start_exchange_5,
+      finish_exchange_5,
+      step_6,
+    };
+
+    std::vector<std::pair<unsigned int, unsigned int>> temporal_blocks_;
+    std::vector<std::pair<TemporalBlockAction, unsigned int>>
+        temporal_schedule_;
+
+    //@}
+    /**
+     * @name Internal functions
+     */
+    //@{
+
+    /**
+     * Rebuild the active set of rows stored in @p active_ from the state
+     * vector @p state_vector: A row is active if it lies within
+     * active_set_interval_ layers of the stencil of a seed row. For the
+     * shallow water equations seed rows are all wet degrees of freedom,
+     * for all other equations seed rows are boundary degrees of freedom
+     * and rows whose stencil is not quiescent, i.e., contains a state
+     * that differs from U_i by more than "quiescent tolerance".
+     * Auxiliary data (d_ij, alpha_i, r_i, l_ij) of all inactive rows is
+     * reset to zero so that it can be read from neighboring active rows
+     * without ever being recomputed.
+     *
+     * The function does nothing unless the run time option "active set
+     * update interval" is set.
+     */
+    void update_active_set(const StateVector &state_vector) const;
+
+    /**
+     * Split the locally owned rows into blocks of (at most) "temporal
+     * block size" rows and precompute the schedule in which step()
+     * executes Steps 4, 5, and the first pass of Step 6 block by block,
+     * and in which the ghost exchanges of r_i (and the bounds) and l_ij
+     * are issued. A block is scheduled for Step 5 (or 6) as soon as all
+     * blocks containing rows of its stencil have completed Step 4 (or 5)
+     * and, if the block couples to ghost rows, the corresponding ghost
+     * exchange has been completed. The exchanges are started as soon as
+     * all blocks of the export range have completed the step, and are
+     * completed only once no other block is ready.
+     *
+     * The schedule is left empty (and temporal blocking is disabled) if
+     * the "temporal block size" parameter is zero, or if no limiter
+     * iterations are performed.
+     */
+    void prepare_temporal_blocking();
+
     //@}
   };
 
 } /* namespace ryujin */
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::LoopSchedule,
+             LIST({ryujin::LoopSchedule::static_schedule, "static"},
+                  {ryujin::LoopSchedule::dynamic_schedule, "dynamic"},
+                  {ryujin::LoopSchedule::guided_schedule, "guided"}));
+#endif
@@ -8,13 +8,19 @@
 #include "hyperbolic_module.h"
 #include "introspection.h"
 #include "mpi_ensemble.h"
+#include "numa.h"
 #include "openmp.h"
 #include "scope.h"
 #include "simd.h"
 
 #include "sparse_matrix_simd.template.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <optional>
 
 namespace ryujin
 {
@@ -35,6 +41,7 @@ namespace ryujin
       const std::string &subsection /*= "HyperbolicModule"*/)
       : ParameterAcceptor(subsection)
       , id_violation_strategy_(IDViolationStrategy::warn)
+      , first_stage_cache_(FirstStageCache::none)
       , indicator_parameters_(subsection + "/indicator")
       , limiter_parameters_(subsection + "/limiter")
       , riemann_solver_parameters_(subsection + "/riemann solver")
@@ -44,9 +51,185 @@ namespace ryujin
       , hyperbolic_system_(&hyperbolic_system)
       , initial_values_(&initial_values)
       , cfl_(0.2)
+      , local_time_stepping_(false)
       , n_restarts_(0)
       , n_warnings_(0)
+      , record_row_work_(false)
+      , n_stencil_entries_(0.)
   {
+    fused_stencil_ = false;
+    add_parameter(
+        "fused stencil",
+        fused_stencil_,
+        "Compute the full row of d_ij together with the diagonal d_ii and "
+        "the maximal time-step size in a single sweep over the stencil "
+        "instead of computing the upper triangular part and symmetrizing "
+        "in a second sweep. This trades additional Riemann solver "
+        "evaluations for reduced memory traffic");
+
+    nonblocking_reductions_ = false;
+    add_parameter(
+        "nonblocking reductions",
+        nonblocking_reductions_,
+        "Combine the MPI reductions of the maximal time step size and the "
+        "restart condition into a single nonblocking reduction at the end "
+        "of a step for all stages with a prescribed time step size, i.e., "
+        "all but the first stage of a Runge-Kutta scheme");
+
+    cache_dirichlet_data_ = false;
+    add_parameter("cache dirichlet data",
+                  cache_dirichlet_data_,
+                  "Evaluate Dirichlet boundary data only once (for the first "
+                  "time point) and reuse the values for all subsequent time "
+                  "steps and stages. Only use this option for time "
+                  "independent boundary data. Boundary data of initial "
+                  "states that are known to be time independent is always "
+                  "cached");
+
+    loop_schedule_ = LoopSchedule::static_schedule;
+    add_parameter("loop schedule",
+                  loop_schedule_,
+                  "OpenMP schedule of the row loops of all steps: static, "
+                  "dynamic, or guided. Dynamic and guided schedules balance "
+                  "rows of different cost, for example constrained degrees "
+                  "of freedom on adaptively refined meshes");
+
+    loop_schedule_chunk_size_ = 0;
+    add_parameter("loop schedule chunk size",
+                  loop_schedule_chunk_size_,
+                  "Chunk size (in loop iterations, i.e., SIMD row chunks for "
+                  "vectorized loops) of the loop schedule. A value of 0 "
+                  "selects the default of the OpenMP implementation");
+
+    overlap_limiter_exchange_ = false;
+    add_parameter("overlap limiter exchange",
+                  overlap_limiter_exchange_,
+                  "Complete the ghost exchange of the limiter coefficients "
+                  "l_ij only after the interior rows of the subsequent "
+                  "limiter pass have been processed, instead of waiting for "
+                  "the exchange at the end of every limiter step");
+
+    export_range_first_ = false;
+    add_parameter("export range first",
+                  export_range_first_,
+                  "Split the vectorized row loops that feed a ghost exchange "
+                  "at the end of the export index range: all threads first "
+                  "cooperatively finish the export rows and proceed to the "
+                  "interior rows without an intermediate barrier. The ghost "
+                  "exchange is thus dispatched as soon as the last export "
+                  "row has been computed");
+
+    report_thread_load_ = false;
+    add_parameter("report thread load",
+                  report_thread_load_,
+                  "Record the busy time of every thread in the row loops of "
+                  "all steps and report the load imbalance between threads");
+
+    smooth_row_threshold_ = Number(0.);
+    add_parameter(
+        "smooth row threshold",
+        smooth_row_threshold_,
+        "Rows (and SIMD row chunks) whose indicator values alpha_i are all "
+        "less than or equal to this threshold are considered smooth. Smooth "
+        "rows skip the computation of limiter bounds (for a continuous "
+        "ansatz) and the limiter line search, i.e., they set l_ij = 1. The "
+        "limited update l_ij = min(l_ij, l_ji) of a pair is then only "
+        "determined by the neighboring row. Warning: This gives up the "
+        "invariant domain guarantee in smooth rows. A value of 0 disables "
+        "the shortcut");
+
+    active_set_interval_ = 0;
+    add_parameter(
+        "active set update interval",
+        active_set_interval_,
+        "Restrict all row loops to an active set consisting of all seed "
+        "rows extended by this number of stencil layers, and rebuild the "
+        "active set every that many calls to step(). Seed rows are all wet "
+        "degrees of freedom for the shallow water equations, and boundary "
+        "degrees of freedom as well as all rows with a non-quiescent "
+        "stencil for all other equations. Rows outside of the active set "
+        "(that can only couple to dry or identical states) keep their "
+        "state. Information travels at most one stencil layer per step, "
+        "thus the active set remains valid in between updates. A value of "
+        "0 disables the active set");
+
+    quiescent_tolerance_ = Number(0.);
+    add_parameter(
+        "quiescent tolerance",
+        quiescent_tolerance_,
+        "Active set (all equations except shallow water): A stencil is "
+        "quiescent if all states U_j differ from U_i at most by this "
+        "relative tolerance in every component. The default of 0 requires "
+        "identical states, for which the update of the row vanishes "
+        "exactly");
+
+    colocate_neighbor_data_ = false;
+    add_parameter(
+        "colocate neighbor data",
+        colocate_neighbor_data_,
+        "Copy the old state and the precomputed values into a single "
+        "co-located vector at the beginning of every step and gather all "
+        "neighbor values from this copy. This reduces the number of cache "
+        "lines touched per stencil entry in Steps 2, 4, and 5 at the cost "
+        "of an additional sweep over the state. Only has an effect for "
+        "hyperbolic systems with precomputed values");
+
+    prefetch_distance_ = 0;
+    add_parameter(
+        "prefetch distance",
+        prefetch_distance_,
+        "Issue software prefetches for the neighboring states and "
+        "precomputed values (Steps 2 and 4), and the high-order fluxes "
+        "(Step 5) of the stencil entry that many columns ahead in the "
+        "stencil loops. The optimal value depends on the architecture, it "
+        "can be tuned with the kernel benchmark. A value of 0 disables "
+        "software prefetching");
+
+    temporal_block_size_ = 0;
+    add_parameter(
+        "temporal block size",
+        temporal_block_size_,
+        "Execute Steps 4, 5, and the first pass of Step 6 interleaved for "
+        "blocks of (at most) that many rows instead of step by step over "
+        "all rows, so that p_ij, l_ij, and the limiter bounds of a block "
+        "are consumed while still cache resident. The block size should be "
+        "chosen such that the matrix rows of a block (times the number of "
+        "threads) fit into the L2 cache. Only has an effect if at least "
+        "one limiter iteration is performed. A value of 0 disables "
+        "temporal blocking");
+
+    reduced_precision_ghost_exchange_ = false;
+    add_parameter(
+        "reduced precision ghost exchange",
+        reduced_precision_ghost_exchange_,
+        "If set to true the ghost values of the indicator alpha_i and of "
+        "the limiter bounds are sent in single precision over MPI, which "
+        "halves the message size of these exchanges in a double precision "
+        "computation. The exported values are rounded on the owning rank "
+        "as well, and bounds are widened prior to rounding, so that "
+        "conservation and the invariant domain property are retained");
+
+    autotune_kernel_variants_ = false;
+    add_parameter(
+        "autotune kernel variants",
+        autotune_kernel_variants_,
+        "Select the loop schedule, the prefetch distance, and the "
+        "\"export range first\", \"overlap limiter exchange\", and "
+        "\"colocate neighbor data\" options automatically. During the first "
+        "cycles of a run every variant is timed (one knob after another) "
+        "for the first stage of a time step and the fastest variant is "
+        "locked in on every MPI rank independently. The configured values "
+        "of these options are only used as initial values");
+
+    autotune_samples_ = 2;
+    add_parameter("autotune samples",
+                  autotune_samples_,
+                  "Number of timed samples (in addition to one warm-up "
+                  "sample) per kernel variant");
+
+    n_smooth_rows_ = 0;
+    n_limited_rows_ = 0;
+    active_set_age_ = 0;
   }
 
 
@@ -62,28 +245,405 @@ namespace ryujin
                 dealii::ExcMessage(
                     "The number of limiter iterations must be between [0,2]"));
 
+#ifdef SYMMETRIC_MATRIX_STORAGE
+    AssertThrow(!fused_stencil_,
+                dealii::ExcMessage("The fused stencil mode is not supported "
+                                   "with symmetric d_ij matrix storage"));
+#endif
+
+    if (active_set_interval_ != 0) {
+      AssertThrow(
+          !offline_data_->discretization().have_discontinuous_ansatz(),
+          dealii::ExcMessage("The active set is not supported for a "
+                             "discontinuous finite element ansatz"));
+    }
+
+    /*
+     * Register all kernel variants that can be switched in between two
+     * calls to step(). The selection is kept over subsequent calls to
+     * prepare(), i.e., after mesh adaptation:
+     */
+    if (autotune_kernel_variants_ && kernel_variants_.empty()) {
+      using Setting = KernelVariantRegistry::Setting;
+      const auto on_off = [](bool &option) {
+        return std::vector<Setting>{
+            {"off", [&option]() { option = false; }},
+            {"on", [&option]() { option = true; }}};
+      };
+
+      kernel_variants_.reinit(autotune_samples_);
+
+      std::vector<Setting> schedules;
+      for (const auto schedule : {LoopSchedule::static_schedule,
+                                  LoopSchedule::dynamic_schedule,
+                                  LoopSchedule::guided_schedule})
+        schedules.push_back(
+            {Patterns::Tools::Convert<LoopSchedule>::to_string(schedule),
+             [this, schedule]() { loop_schedule_ = schedule; }});
+      kernel_variants_.add("loop schedule", std::move(schedules));
+
+      std::vector<Setting> prefetch_distances;
+      for (const unsigned int distance : {0u, 2u, 4u, 8u})
+        prefetch_distances.push_back(
+            {std::to_string(distance),
+             [this, distance]() { prefetch_distance_ = distance; }});
+      kernel_variants_.add("prefetch distance", std::move(prefetch_distances));
+
+      kernel_variants_.add("export range first", on_off(export_range_first_));
+
+      if (limiter_parameters_.iterations() != 0)
+        kernel_variants_.add("overlap limiter exchange",
+                             on_off(overlap_limiter_exchange_));
+
+      if constexpr (View::n_precomputed_values > 0)
+        kernel_variants_.add("colocate neighbor data",
+                             on_off(colocate_neighbor_data_));
+    }
+
     /* Initialize vectors: */
 
     const auto &scalar_partitioner = offline_data_->scalar_partitioner();
-    alpha_.reinit(scalar_partitioner);
+    const auto comm_sm = offline_data_->shared_memory_communicator();
+    alpha_.reinit(scalar_partitioner, comm_sm);
     bounds_.reinit_with_scalar_partitioner(scalar_partitioner);
 
-    r_.reinit(offline_data_->hyperbolic_vector_partitioner());
+    r_.reinit(offline_data_->hyperbolic_vector_partitioner(), comm_sm);
+    Vectors::set_blocked_range(r_, *offline_data_);
+
+    constexpr auto simd_length = simd_width<Number>;
+    NUMA::first_touch_vector(alpha_, 1, simd_length);
+    NUMA::first_touch_vector(r_, problem_dimension, simd_length);
+
+    if (active_set_interval_ != 0) {
+      active_.reinit(scalar_partitioner);
+      active_scratch_.reinit(scalar_partitioner);
+    }
+    /* Rebuild the active set in the next call to step(): */
+    active_set_age_ = 0;
+
     using View =
         typename Description::template HyperbolicSystemView<dim, Number>;
 
+    /*
+     * Only exchange the precomputed values that are read at neighboring
+     * degrees of freedom, see prepare_state_vector(). With an extended
+     * ghost halo the indicator is evaluated on ghost rows as well (see
+     * Step 2 in step()), which reads all precomputed values of the row:
+     */
+    constexpr auto &ghost_components = View::precomputed_ghost_components;
+    if (ghost_components.size() < View::n_precomputed_values &&
+        !offline_data_->extended_ghost_halo())
+      precomputed_ghost_partitioner_ = Vectors::create_vector_partitioner(
+          scalar_partitioner,
+          View::n_precomputed_values,
+          {ghost_components.begin(), ghost_components.end()});
+    else
+      precomputed_ghost_partitioner_.reset();
+
     /* Initialize matrices: */
 
     const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
     dij_matrix_.reinit(sparsity_simd);
-    lij_matrix_.reinit(sparsity_simd);
-    lij_matrix_next_.reinit(sparsity_simd);
-    pij_matrix_.reinit(sparsity_simd);
+
+    /*
+     * The p_ij and l_ij matrices are only needed for at least one limiter
+     * iteration, and the l_ij of the next pass only for two:
+     */
+    const auto n_iterations = limiter_parameters_.iterations();
+    if (n_iterations > 0) {
+      lij_matrix_.reinit(sparsity_simd);
+      pij_matrix_.reinit(sparsity_simd);
+    }
+    if (n_iterations > 1)
+      lij_matrix_next_.reinit(sparsity_simd);
+
+    thread_load_statistics_.reinit(report_thread_load_);
+    row_work_statistics_.reinit(record_row_work_,
+                                offline_data_->n_locally_owned());
+    row_work_counters_.reinit(offline_data_->n_locally_owned());
+
+    /*
+     * Create a compact copy of the boundary map for
+     * prepare_state_vector(): We drop all entries with the do_nothing
+     * boundary id and store the remaining entries as a struct of arrays
+     * of boundary ids, normals and indices into the boundary map. The
+     * boundary map is sorted by index and might contain multiple entries
+     * for a single degree of freedom. These have to be applied in order
+     * and are thus grouped and processed by the same thread.
+     */
+
+    const auto &boundary_map = offline_data_->boundary_map();
+    boundary_groups_.clear();
+    boundary_group_rows_.clear();
+    boundary_entries_.clear();
+    boundary_ids_.clear();
+    boundary_normals_.clear();
+    dirichlet_entries_.clear();
+    dirichlet_points_.clear();
+    for (std::size_t k = 0; k < boundary_map.size(); ++k) {
+      const auto &[i, normal, normal_mass, boundary_mass, id, position] =
+          boundary_map[k];
+      if (id == Boundary::do_nothing)
+        continue;
+
+      if (id == Boundary::dirichlet || id == Boundary::dynamic ||
+          id == Boundary::dirichlet_momentum) {
+        dirichlet_entries_.push_back(k);
+        dirichlet_points_.push_back(position);
+      }
+
+      if (boundary_group_rows_.empty() || boundary_group_rows_.back() != i) {
+        boundary_groups_.push_back(boundary_entries_.size());
+        boundary_group_rows_.push_back(i);
+      }
+      boundary_entries_.push_back(k);
+      boundary_ids_.push_back(id);
+      boundary_normals_.push_back(normal);
+    }
+    boundary_groups_.push_back(boundary_entries_.size());
+
+    /*
+     * Pack the coupling boundary pairs into groups of simd_length pairs
+     * stored as a struct of arrays of row indices i, column positions
+     * col_idx, and column indices j. Without the fused stencil only pairs
+     * pointing to the upper triangular part of the d_ij matrix are needed
+     * in step(). The last group is padded by repeating its last pair:
+     */
+
+    const auto &coupling_boundary_pairs =
+        offline_data_->coupling_boundary_pairs();
+
+    coupling_pairs_simd_.clear();
+    unsigned int n_lanes = 0;
+    for (const auto &[i, col_idx, j] : coupling_boundary_pairs) {
+      if (!fused_stencil_ && j < i)
+        continue;
+      if (n_lanes == 0)
+        coupling_pairs_simd_.emplace_back();
+      auto &[is, col_idxs, js] = coupling_pairs_simd_.back();
+      is[n_lanes] = i;
+      col_idxs[n_lanes] = col_idx;
+      js[n_lanes] = j;
+      n_lanes = (n_lanes + 1) % simd_length;
+    }
+    if (n_lanes != 0) {
+      for (auto &indices : coupling_pairs_simd_.back())
+        for (unsigned int k = n_lanes; k < simd_length; ++k)
+          indices[k] = indices[n_lanes - 1];
+    }
+
+    dirichlet_data_.resize(boundary_map.size());
+    dirichlet_data_cached_ = false;
+
+    /* Number of stencil entries for the analytic traffic estimate: */
+    const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
+    n_stencil_entries_ = 0.;
+    for (unsigned int i = 0; i < offline_data_->n_locally_owned(); ++i)
+      n_stencil_entries_ += sparsity_simd.row_length(i);
+
+    /* Invalidate a possibly stored first stage: */
+    first_stage_stored_ = false;
 
     /* Set up initial precomputed vector: */
 
     initial_precomputed_ =
         initial_values_->interpolate_initial_precomputed_vector();
+
+    prepare_temporal_blocking();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  std::size_t
+  HyperbolicModule<Description, dim, Number>::memory_estimate() const
+  {
+    using IndicatorNumber = Vectors::indicator_number_type<Number>;
+    using StorageNumber = storage_number_type<Number>;
+
+    const std::size_t n_relevant = offline_data_->n_locally_relevant();
+    const std::size_t n_entries =
+        offline_data_->sparsity_pattern_simd().n_nonzero_elements();
+
+    /* Vectors alpha_, bounds_, r_ and the active set: */
+
+    std::size_t bytes = n_relevant * (1 + n_bounds) * sizeof(IndicatorNumber);
+    bytes += n_relevant * problem_dimension * sizeof(Number);
+    if (active_set_interval_ != 0)
+      bytes += 2 * n_relevant * sizeof(Number);
+
+    /* Matrices d_ij, l_ij, p_ij and l_ij of the next limiter pass: */
+
+#ifdef SYMMETRIC_MATRIX_STORAGE
+    /* The compressed symmetric storage holds about half of all entries: */
+    bytes += (n_entries / 2 + n_relevant) * sizeof(StorageNumber);
+#else
+    bytes += n_entries * sizeof(StorageNumber);
+#endif
+
+    const auto n_iterations = limiter_parameters_.iterations();
+    if (n_iterations > 0)
+      bytes += n_entries *
+               (sizeof(StorageNumber) + problem_dimension * sizeof(Number));
+    if (n_iterations > 1)
+      bytes += n_entries * sizeof(StorageNumber);
+
+    return bytes;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::prepare_temporal_blocking()
+  {
+    temporal_blocks_.clear();
+    temporal_schedule_.clear();
+
+    if (temporal_block_size_ == 0 || limiter_parameters_.iterations() == 0)
+      return;
+
+    constexpr auto simd_length = simd_width<Number>;
+    const unsigned int n_export_indices = offline_data_->n_export_indices();
+    const unsigned int n_internal = offline_data_->n_locally_internal();
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+    const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
+
+    /*
+     * Split the vectorized export range, the non-vectorized range (that
+     * might contain exported indices as well), and the remaining
+     * vectorized range into blocks, in this order. Block boundaries are
+     * aligned to the SIMD width:
+     */
+
+    const unsigned int block_size =
+        (temporal_block_size_ + simd_length - 1) / simd_length * simd_length;
+
+    unsigned int n_export_blocks = 0;
+    for (const auto &[left, right] : {std::make_pair(0u, n_export_indices),
+                                      std::make_pair(n_internal, n_owned),
+                                      std::make_pair(n_export_indices,
+                                                     n_internal)}) {
+      /* All but the last range contain exported indices: */
+      n_export_blocks = temporal_blocks_.size();
+      for (unsigned int i = left; i < right; i += block_size)
+        temporal_blocks_.emplace_back(i, std::min(i + block_size, right));
+    }
+
+    const unsigned int n_blocks = temporal_blocks_.size();
+
+    std::vector<unsigned int> block_of_row(n_owned);
+    for (unsigned int b = 0; b < n_blocks; ++b)
+      std::fill(block_of_row.begin() + temporal_blocks_[b].first,
+                block_of_row.begin() + temporal_blocks_[b].second,
+                b);
+
+    /*
+     * Record all blocks containing rows of the stencil of a block, and
+     * whether a block couples to ghost rows:
+     */
+
+    std::vector<std::vector<unsigned int>> neighbors(n_blocks);
+    std::vector<bool> couples_to_ghosts(n_blocks, false);
+    unsigned int js_buffer[simd_length];
+
+    for (unsigned int b = 0; b < n_blocks; ++b) {
+      const auto [left, right] = temporal_blocks_[b];
+      const unsigned int stride_size = left < n_internal ? simd_length : 1;
+
+      for (unsigned int i = left; i < right; i += stride_size) {
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+          const unsigned int *js =
+              sparsity_simd.columns(i, col_idx, js_buffer);
+          for (unsigned int k = 0; k < stride_size; ++k) {
+            if (js[k] >= n_owned)
+              couples_to_ghosts[b] = true;
+            else if (block_of_row[js[k]] != b)
+              neighbors[b].push_back(block_of_row[js[k]]);
+          }
+        }
+      }
+
+      std::sort(neighbors[b].begin(), neighbors[b].end());
+      neighbors[b].erase(std::unique(neighbors[b].begin(), neighbors[b].end()),
+                         neighbors[b].end());
+    }
+
+    /*
+     * Simulate the execution: Step 4 is executed block by block in
+     * order. After every block we greedily schedule all blocks that are
+     * ready for Step 5 or 6, and start ghost exchanges as soon as the
+     * export range is complete. Pending exchanges are only completed if
+     * no other progress is possible.
+     */
+
+    using Action = TemporalBlockAction;
+
+    /* done[b][s] is true if block b has completed Step 4 + s: */
+    std::vector<std::array<bool, 3>> done(n_blocks, {false, false, false});
+    std::array<bool, 2> started{{false, false}};
+    std::array<bool, 2> finished{{false, false}};
+
+    const auto ready = [&](unsigned int b, unsigned int s) {
+      if (done[b][s] || !done[b][s - 1])
+        return false;
+      if (couples_to_ghosts[b] && !finished[s - 1])
+        return false;
+      return std::all_of(neighbors[b].begin(),
+                         neighbors[b].end(),
+                         [&](unsigned int c) { return done[c][s - 1]; });
+    };
+
+    const auto start_exchanges = [&]() {
+      for (unsigned int s = 0; s < 2; ++s) {
+        if (started[s])
+          continue;
+        bool exports_done = true;
+        for (unsigned int b = 0; b < n_export_blocks; ++b)
+          exports_done = exports_done && done[b][s];
+        if (!exports_done)
+          break;
+        temporal_schedule_.emplace_back(
+            s == 0 ? Action::start_exchange_4 : Action::start_exchange_5, 0);
+        started[s] = true;
+      }
+    };
+
+    unsigned int next_block = 0;
+    unsigned int n_completed = 0;
+    while (n_completed < n_blocks) {
+      if (next_block < n_blocks) {
+        temporal_schedule_.emplace_back(Action::step_4, next_block);
+        done[next_block++][0] = true;
+      } else if (started[0] && !finished[0]) {
+        temporal_schedule_.emplace_back(Action::finish_exchange_4, 0);
+        finished[0] = true;
+      } else if (started[1] && !finished[1]) {
+        temporal_schedule_.emplace_back(Action::finish_exchange_5, 0);
+        finished[1] = true;
+      } else {
+        AssertThrow(false, dealii::ExcInternalError());
+      }
+
+      for (bool progress = true; progress;) {
+        start_exchanges();
+        progress = false;
+        for (unsigned int s = 1; s < 3; ++s)
+          for (unsigned int b = 0; b < n_blocks; ++b) {
+            if (!ready(b, s))
+              continue;
+            temporal_schedule_.emplace_back(
+                s == 1 ? Action::step_5 : Action::step_6, b);
+            done[b][s] = true;
+            n_completed += (s == 2);
+            progress = true;
+          }
+      }
+    }
+
+    /* Complete all pending exchanges: */
+    if (!finished[0])
+      temporal_schedule_.emplace_back(Action::finish_exchange_4, 0);
+    if (!finished[1])
+      temporal_schedule_.emplace_back(Action::finish_exchange_5, 0);
   }
 
 
@@ -113,40 +673,147 @@ namespace ryujin
     const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
     const auto &boundary_map = offline_data_->boundary_map();
     unsigned int channel = 10;
-    using VA = VectorizedArray<Number>;
+    using VA = VectorizedArrayType<Number>;
 
     Scope scope(computing_timer_,
-                "time step [H] 1 - update boundary values, precompute values");
+                timer_name("time step [H] 1 - update boundary values, "
+                           "precompute values"));
 
-    LIKWID_MARKER_START("time_step_1a");
+    /*
+     * Evaluate Dirichlet data. Unless the initial state is thread safe we
+     * do this serially because the initial states are in general not
+     * thread safe (they might, for example, set the time of an
+     * underlying function parser). The values are evaluated only once if
+     * the initial state is time independent (or if caching was requested
+     * explicitly).
+     */
 
-    /* FIXME: not thread parallel... */
-    for (const auto &entry : boundary_map) {
-      const auto &[i, normal, normal_mass, boundary_mass, id, position] = entry;
+    Assert(dirichlet_data_.size() == boundary_map.size(),
+           dealii::ExcInternalError());
 
+    const auto needs_dirichlet_data = [](const auto id) {
+      return id == Boundary::dirichlet || id == Boundary::dynamic ||
+             id == Boundary::dirichlet_momentum;
+    };
+
+    const bool cache_dirichlet_data =
+        cache_dirichlet_data_ || initial_values_->time_independent();
+
+    if (!cache_dirichlet_data || !dirichlet_data_cached_) {
       /*
-       * Relay the task of applying appropriate boundary conditions to the
-       * Problem Description.
+       * Evaluate the initial state in batches. This way initial states
+       * with an expensive conversion to conserved states (for example,
+       * the inversion of a tabulated equation of state) can use their
+       * batched code path.
        */
+      constexpr auto batch_size =
+          InitialValues<Description, dim, Number>::batch_size;
+
+      const auto n_entries = dirichlet_entries_.size();
+      const auto evaluate_batch = [&](const std::size_t l) {
+        std::array<state_type, batch_size> states;
+        const auto n = std::min<std::size_t>(batch_size, n_entries - l);
+        initial_values_->initial_states(
+            dealii::ArrayView<state_type>(states.data(), n),
+            dealii::ArrayView<const dealii::Point<dim>>(
+                dirichlet_points_.data() + l, n),
+            t);
+        for (std::size_t k = 0; k < n; ++k)
+          dirichlet_data_[dirichlet_entries_[l + k]] = states[k];
+      };
 
-      if (id == Boundary::do_nothing)
-        continue;
+      if (initial_values_->thread_safe()) {
+        RYUJIN_PARALLEL_REGION_BEGIN
+        RYUJIN_OMP_FOR
+        for (std::size_t l = 0; l < n_entries; l += batch_size)
+          evaluate_batch(l);
+        RYUJIN_PARALLEL_REGION_END
+      } else {
+        for (std::size_t l = 0; l < n_entries; l += batch_size)
+          evaluate_batch(l);
+      }
+
+      dirichlet_data_cached_ = true;
+    }
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+    LIKWID_MARKER_START("time_step_1a");
+
+    const auto view = hyperbolic_system_->template view<dim, Number>();
 
+    RYUJIN_OMP_FOR
+    for (std::size_t g = 0; g + 1 < boundary_groups_.size(); ++g) {
+      const auto i = boundary_group_rows_[g];
       auto U_i = U.get_tensor(i);
 
-      /* Use a lambda to avoid computing unnecessary state values */
-      auto get_dirichlet_data = [position = position, t = t, this]() {
-        return initial_values_->initial_state(position, t);
-      };
+      /* Apply all entries for a given degree of freedom in order: */
+      for (std::size_t l = boundary_groups_[g]; l < boundary_groups_[g + 1];
+           ++l) {
+        const auto k = boundary_entries_[l];
+        const auto id = boundary_ids_[l];
+
+        /*
+         * Relay the task of applying appropriate boundary conditions to
+         * the Problem Description.
+         */
+
+        auto get_dirichlet_data = [&]() {
+          if (RYUJIN_LIKELY(needs_dirichlet_data(id)))
+            return dirichlet_data_[k];
+
+          /* Fall back to a (serialized) evaluation of the initial state: */
+          const auto &position = std::get<5>(boundary_map[k]);
+          state_type result;
+          RYUJIN_OMP_CRITICAL
+          result = initial_values_->initial_state(position, t);
+          return result;
+        };
+
+        U_i = view.apply_boundary_conditions(
+            id, U_i, boundary_normals_[l], get_dirichlet_data);
+      }
 
-      const auto view = hyperbolic_system_->template view<dim, Number>();
-      U_i = view.apply_boundary_conditions(id, U_i, normal, get_dirichlet_data);
       U.write_tensor(U_i, i);
     }
 
     LIKWID_MARKER_STOP("time_step_1a");
+    RYUJIN_PARALLEL_REGION_END
+
+#ifdef DEBUG
+    /*
+     * Poison all ghost entries of U so that a precomputation cycle 0 that
+     * violates the contract stated below is detected:
+     */
+    {
+      const auto &partitioner = U.get_partitioner();
+      const unsigned int n_relevant =
+          partitioner->locally_owned_size() + partitioner->n_ghost_indices();
+      state_type nan_state;
+      for (unsigned int c = 0; c < problem_dimension; ++c)
+        nan_state[c] = std::numeric_limits<Number>::quiet_NaN();
+      for (unsigned int i = n_owned; i < n_relevant; ++i)
+        U.write_tensor(nan_state, i);
+    }
+#endif
+
+    /*
+     * Start the ghost exchange of U. By contract, precomputation cycle 0
+     * is a pointwise operation that only accesses the states U_i of the
+     * locally owned index range. We can thus hide the exchange behind
+     * cycle 0. All later cycles may access the stencil, i.e., ghost
+     * states U_j, so we have to finish the exchange before cycle 1.
+     */
+    U.update_ghost_values_start(channel++);
+    bool ghost_exchange_finished = false;
 
-    U.update_ghost_values();
+    const auto finish_ghost_exchange = [&]() {
+      if (ghost_exchange_finished)
+        return;
+      Scope scope(computing_timer_,
+                  timer_name("time step [H] 1 - ghost exchange, exposed"));
+      U.update_ghost_values_finish();
+      ghost_exchange_finished = true;
+    };
 
     /*
      * Precompute values
@@ -155,10 +822,25 @@ namespace ryujin
     if constexpr (n_precomputation_cycles != 0) {
       for (unsigned int cycle = 0; cycle < n_precomputation_cycles; ++cycle) {
 
-        SynchronizationDispatch synchronization_dispatch([&]() {
-          precomputed.update_ghost_values_start(channel++);
-          precomputed.update_ghost_values_finish();
-        });
+        if (cycle > 0)
+          finish_ghost_exchange();
+
+        SynchronizationDispatch synchronization_dispatch(
+            [&]() {
+              if (precomputed_ghost_partitioner_) {
+                precomputed.update_selected_ghost_values_start(
+                    channel++, *precomputed_ghost_partitioner_);
+                precomputed.update_selected_ghost_values_finish(
+                    *precomputed_ghost_partitioner_);
+              } else {
+                precomputed.update_ghost_values_start(channel++);
+                precomputed.update_ghost_values_finish();
+              }
+            },
+            computing_timer_[timer_name(
+                "time step [H] 1 - ghost exchange, total")],
+            computing_timer_[timer_name(
+                "time step [H] 1 - ghost exchange, exposed")]);
 
         RYUJIN_PARALLEL_REGION_BEGIN
         LIKWID_MARKER_START(("time_step_1b"));
@@ -189,7 +871,75 @@ namespace ryujin
 
         LIKWID_MARKER_STOP("time_step_1b");
         RYUJIN_PARALLEL_REGION_END
+
+#ifdef DEBUG
+        if (cycle == 0) {
+          for (unsigned int i = 0; i < n_owned; ++i) {
+            if (sparsity_simd.row_length(i) == 1)
+              continue;
+            const auto prec_i = precomputed.get_tensor(i);
+            for (unsigned int c = 0; c < View::n_precomputed_values; ++c)
+              Assert(std::isfinite(prec_i[c]),
+                     dealii::ExcMessage(
+                         "Precomputation cycle 0 accessed a ghost state U_j. "
+                         "Cycle 0 must be a pointwise operation on the "
+                         "locally owned index range."));
+          }
+        }
+#endif
+      }
+    }
+
+    finish_ghost_exchange();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::apply_implicit_source(
+      [[maybe_unused]] StateVector &state_vector,
+      [[maybe_unused]] Number tau) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "HyperbolicModule<Description, dim, Number>::"
+                 "apply_implicit_source()"
+              << std::endl;
+#endif
+
+    using View =
+        typename Description::template HyperbolicSystemView<dim, Number>;
+
+    if constexpr (View::have_implicit_source_terms) {
+      const auto view = hyperbolic_system_->template view<dim, Number>();
+      if (!view.implicit_source_terms())
+        return;
+
+      Scope scope(computing_timer_,
+                  timer_name("time step [H] _ - implicit source"));
+
+      auto &U = std::get<0>(state_vector);
+
+      const unsigned int n_owned = offline_data_->n_locally_owned();
+      const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
+
+      /*
+       * The update is pointwise, we thus only touch locally owned
+       * states. Ghost ranges are updated by the next call to
+       * prepare_state_vector():
+       */
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
+
+        /* Skip constrained degrees of freedom: */
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        if (row_length == 1)
+          continue;
+
+        const auto U_i = U.get_tensor(i);
+        U.write_tensor(view.implicit_source(U_i, tau), i);
       }
+      RYUJIN_PARALLEL_REGION_END
     }
   }
 
@@ -229,9 +979,65 @@ namespace ryujin
         return all_below_diagonal;
       }
     }
+
+
+    /**
+     * Internally used: returns true if any index is on the lower
+     * triangular part of the matrix.
+     */
+    template <typename T>
+    bool any_below_diagonal(unsigned int i, const unsigned int *js)
+    {
+      if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
+        /* Non-vectorized sequential access. */
+        const auto j = *js;
+        return j < i;
+
+      } else {
+        /* Vectorized fast access. index must be divisible by simd_length */
+
+        constexpr auto simd_length = T::size();
+
+        for (unsigned int k = 0; k < simd_length; ++k)
+          if (js[k] < i + k)
+            return true;
+        return false;
+      }
+    }
+
+
+    /**
+     * Internally used: access lane @p k of a (possibly vectorized) value.
+     */
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline auto &lane(T &value, const unsigned int k)
+    {
+      if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
+        (void)k;
+        return value;
+      } else {
+        return value[k];
+      }
+    }
   } // namespace
 
 
+  template <typename Description, int dim, typename Number>
+  const std::string &HyperbolicModule<Description, dim, Number>::timer_name(
+      const std::string_view name, const int step_no /*= 0*/) const
+  {
+    auto &result = timer_names_[{step_no, name}];
+    if (result.empty()) {
+      if (step_no == 0)
+        result = name;
+      else
+        result = "time step [H] " + std::to_string(step_no) + " - " +
+                 std::string(name);
+    }
+    return result;
+  }
+
+
   template <typename Description, int dim, typename Number>
   template <int stages>
   Number HyperbolicModule<Description, dim, Number>::step(
@@ -254,6 +1060,18 @@ namespace ryujin
 
     CALLGRIND_START_INSTRUMENTATION;
 
+    /*
+     * Time the first stage of every time step (with a time step size
+     * that has yet to be computed) for autotuning the kernel variants.
+     * The work of these calls is comparable over all time stepping
+     * schemes:
+     */
+    const bool kernel_variant_sample = stages == 0 && tau == Number(0.);
+    if (kernel_variant_sample)
+      kernel_variants_.start();
+
+    set_loop_schedule(loop_schedule_, loop_schedule_chunk_size_);
+
     /*
      * Workaround: A constexpr boolean storing the fact whether we
      * instantiate the HyperbolicModule for the shallow water equations.
@@ -271,15 +1089,39 @@ namespace ryujin
     constexpr bool shallow_water =
         std::is_same_v<Description, ShallowWater::Description>;
 
-    using VA = VectorizedArray<Number>;
+    using VA = VectorizedArrayType<Number>;
 
     /* Index ranges for the iteration over the sparsity pattern : */
 
-    constexpr auto simd_length = VA::size();
+    constexpr auto simd_length = simd_width<Number>;
     const unsigned int n_export_indices = offline_data_->n_export_indices();
     const unsigned int n_internal = offline_data_->n_locally_internal();
     const unsigned int n_owned = offline_data_->n_locally_owned();
 
+    /*
+     * Run a vectorized row loop over [0, n_internal). With "export range
+     * first" the loop is split at n_export_indices and the first part
+     * ends without a barrier (see skip_barrier()), so that every thread
+     * signals the SynchronizationDispatch as soon as it has finished its
+     * share of the export range:
+     */
+    const auto simd_range = [&](const auto &loop) {
+      if (export_range_first_) {
+        loop(0u, n_export_indices);
+        loop(n_export_indices, n_internal);
+      } else {
+        loop(0u, n_internal);
+      }
+    };
+
+    const auto skip_barrier = [&](auto sentinel,
+                                  const unsigned int left,
+                                  const unsigned int right) {
+      using T = decltype(sentinel);
+      return export_range_first_ && !std::is_same_v<T, Number> && left == 0 &&
+             right == n_export_indices && right != n_internal;
+    };
+
     /* References to precomputed matrices and the stencil: */
 
     const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
@@ -293,6 +1135,11 @@ namespace ryujin
     const auto &cij_matrix = offline_data_->cij_matrix();
     const auto &incidence_matrix = offline_data_->incidence_matrix();
 
+    const bool precompute_normalized_cij =
+        offline_data_->precompute_normalized_cij();
+    const auto &cij_norm_matrix = offline_data_->cij_norm_matrix();
+    const auto &nij_matrix = offline_data_->nij_matrix();
+
     const auto &coupling_boundary_pairs =
         offline_data_->coupling_boundary_pairs();
 
@@ -302,24 +1149,199 @@ namespace ryujin
     /* A monotonically increasing "channel" variable for mpi_tags: */
     unsigned int channel = 10;
 
-    /* Lambda for creating the computing timer string: */
+    /* Lambdas for looking up the computing timer strings and timers: */
     int step_no = 1;
-    const auto scoped_name = [&step_no](const auto &name,
-                                        const bool advance = true) {
+    const auto scoped_name = [&](const std::string_view name,
+                                 const bool advance = true)
+        -> const std::string & {
       advance || step_no--;
-      return "time step [H] " + std::to_string(++step_no) + " - " + name;
+      return timer_name(name, ++step_no);
     };
 
-    /* A boolean signalling that a restart is necessary: */
-    std::atomic<bool> restart_needed = false;
+    const auto exchange_timer =
+        [&](const std::string_view name) -> dealii::Timer & {
+      return computing_timer_[scoped_name(name, false)];
+    };
 
     /*
-     * -------------------------------------------------------------------------
-     * Step 2: Compute off-diagonal d_ij, and alpha_i
-     *
-     * The computation of the d_ij is quite costly. So we do a trick to
-     * save a bit of computational resources. Instead of computing all d_ij
-     * entries for a row of a given local index i, we only compute d_ij for
+     * Analytic estimate of the memory traffic of the stages of a step,
+     * see stage_traffic(). A stencil sweep streams the column indices
+     * and gathers U_j, the precomputed values of j, c_ij and d_ij for
+     * every entry. Row data is streamed once. Cache reuse of gathered
+     * data and the boundary stages are neglected.
+     */
+
+    const double n_rows = n_owned;
+    const double n_entries = n_stencil_entries_;
+    constexpr double s = sizeof(Number);
+    constexpr double s_index = sizeof(unsigned int);
+    constexpr double n_gathered =
+        problem_dimension + View::n_precomputed_values + dim + 1;
+
+    const double state = n_rows * problem_dimension * s;
+    const double bounds = n_rows * n_bounds * s;
+    const double p_ij = n_entries * problem_dimension * s;
+    const double l_ij = n_entries * s;
+
+    const double traffic_dij =
+        n_entries * (s_index + n_gathered * s) + state + n_rows * s;
+    const double traffic_restore = 2. * n_entries * s + 2. * n_rows * s;
+    const double traffic_low_order = n_entries * (s_index + n_gathered * s) +
+                                     l_ij + p_ij + 3. * state + bounds +
+                                     n_rows * s;
+    const double traffic_lij =
+        n_entries * s_index + p_ij + l_ij + state + bounds;
+    const double traffic_high_order =
+        n_entries * s_index + p_ij + 2. * l_ij + 2. * state;
+
+    const auto record_traffic = [&](const std::string &name,
+                                    const double bytes) {
+      auto &[total, n_invocations] = stage_traffic_[name];
+      total += bytes;
+      ++n_invocations;
+    };
+
+    /*
+     * Exchange alpha_i and the limiter bounds in single precision, see
+     * the "reduced precision ghost exchange" option. If the indicators are
+     * already stored in single precision this is the default:
+     */
+    const bool reduced_exchange =
+        reduced_precision_ghost_exchange_ &&
+        !std::is_same_v<Vectors::indicator_number_type<Number>, float>;
+
+    const auto update_alpha_ghost_values_start = [&]() {
+      if (reduced_exchange)
+        alpha_exchange_.update_ghost_values_start(alpha_, channel++);
+      else
+        alpha_.update_ghost_values_start(channel++);
+    };
+
+    const auto update_alpha_ghost_values_finish = [&]() {
+      if (reduced_exchange)
+        alpha_exchange_.update_ghost_values_finish(alpha_);
+      else
+        alpha_.update_ghost_values_finish();
+    };
+
+    const auto update_bounds_ghost_values_start = [&]() {
+      if (reduced_exchange)
+        bounds_exchange_.update_ghost_values_start(bounds_, channel++);
+      else
+        bounds_.update_ghost_values_start(channel++);
+    };
+
+    const auto update_bounds_ghost_values_finish = [&]() {
+      if (reduced_exchange)
+        bounds_exchange_.update_ghost_values_finish(bounds_);
+      else
+        bounds_.update_ghost_values_finish();
+    };
+
+    /* A boolean signalling that a restart is necessary: */
+    std::atomic<bool> restart_needed = false;
+
+    /*
+     * Return whether a row (or all rows of a SIMD row chunk) with
+     * indicator value alpha_i is smooth, see the "smooth row threshold"
+     * option:
+     */
+    const auto is_smooth_row = [&](const auto &alpha_i) {
+      using T = std::decay_t<decltype(alpha_i)>;
+      if (smooth_row_threshold_ <= Number(0.))
+        return false;
+      const T threshold(smooth_row_threshold_);
+      return std::max(alpha_i, threshold) == threshold;
+    };
+
+    /*
+     * Rebuild the active set every active_set_interval_ calls, see the
+     * "active set update interval" option. Return whether a row (or all
+     * rows of a SIMD row chunk) starting at index i is inactive:
+     */
+    const bool use_active_set = active_set_interval_ != 0;
+    if (use_active_set && active_set_age_++ % active_set_interval_ == 0) {
+      Scope scope(computing_timer_,
+                  timer_name("time step [H] _ - update active set"));
+      update_active_set(old_state_vector);
+    }
+
+    const auto is_inactive_row = [&](auto sentinel, const unsigned int i) {
+      using T = decltype(sentinel);
+      return use_active_set && get_entry<T>(active_, i) == T(0.);
+    };
+
+    const bool defer_tau_max_reduction =
+        nonblocking_reductions_ && tau != Number(0.);
+
+    const auto check_tau_max = [](const Number value) {
+      AssertThrow(
+          !std::isnan(value) && !std::isinf(value) && value > 0.,
+          ExcMessage(
+              "I'm sorry, Dave. I'm afraid I can't do that.\nWe crashed."));
+    };
+
+    Assert(!local_time_stepping_ || stages == 0,
+           dealii::ExcMessage("Local time stepping is only supported for "
+                              "single stage (forward Euler) steps."));
+
+    /*
+     * A first stage (no stage vectors, and the time step size tau is
+     * computed) only depends on the old state. Depending on
+     * first_stage_cache_ we either store d_ij, alpha_i and the CFL bound,
+     * or reuse the data stored previously and skip Steps 2 and 3:
+     */
+    const bool first_stage = (stages == 0 && tau == Number(0.));
+    const bool store_first_stage =
+        first_stage && first_stage_cache_ == FirstStageCache::store;
+    const bool reuse_first_stage = first_stage && first_stage_stored_ &&
+                                   first_stage_cache_ == FirstStageCache::reuse;
+
+    /*
+     * We apply the supplied upper bound on tau_max after computing the
+     * CFL bound so that the CFL bound can be stored separately:
+     */
+    const Number tau_max_bound = tau_max.load();
+    tau_max.store(std::numeric_limits<Number>::max());
+
+    /*
+     * Gather neighboring states and precomputed values from a single
+     * co-located copy, see the "colocate neighbor data" option. The
+     * guard restores the default behavior when leaving this function:
+     */
+    std::optional<typename decltype(colocated_state_)::Guard> colocation;
+    if (colocate_neighbor_data_ && View::n_precomputed_values > 0) {
+      Scope scope(computing_timer_,
+                  timer_name("time step [H] _ - colocate neighbor data"));
+      colocation.emplace(colocated_state_.attach(old_U, old_precomputed));
+    }
+
+    /*
+     * Issue software prefetches for the neighboring state and precomputed
+     * values of the stencil entry prefetch_distance_ columns ahead of
+     * col_idx in row i, see the "prefetch distance" option:
+     */
+    const auto prefetch_neighbors = [&](auto sentinel,
+                                        const unsigned int i,
+                                        const unsigned int col_idx,
+                                        const unsigned int row_length,
+                                        unsigned int *buffer) {
+      using T = decltype(sentinel);
+      const unsigned int col_ahead = col_idx + prefetch_distance_;
+      if (prefetch_distance_ == 0 || col_ahead >= row_length)
+        return;
+      const unsigned int *js = sparsity_simd.columns(i, col_ahead, buffer);
+      old_U.template prefetch<T>(js);
+      old_precomputed.template prefetch<T>(js);
+    };
+
+    /*
+     * -------------------------------------------------------------------------
+     * Step 2: Compute off-diagonal d_ij, and alpha_i
+     *
+     * The computation of the d_ij is quite costly. So we do a trick to
+     * save a bit of computational resources. Instead of computing all d_ij
+     * entries for a row of a given local index i, we only compute d_ij for
      * which j > i,
      *
      *        llllrr
@@ -330,26 +1352,83 @@ namespace ryujin
      *      r ......
      *      r ......
      *
-     *  and symmetrize in Step 2.
+     *  and symmetrize in Step 3.
      *
      *  MM: We could save a bit more computational resources by only
      *  computing entries for which *IN A GLOBAL* enumeration j > i. But
      *  the index translation, subsequent symmetrization, and exchange
      *  sounds a bit too expensive...
+     *
+     *  If the "fused stencil" run time option is set we instead compute
+     *  the full row of d_ij (upper and lower triangular part) and
+     *  directly accumulate the diagonal entry d_ii and the local time
+     *  step constraint tau_max. This doubles the number of Riemann solver
+     *  invocations but eliminates the symmetrization sweep in Step 3
+     *  which has to stream the d_ij matrix (and its transpose) a second
+     *  time. For memory-bandwidth bound configurations this is typically
+     *  the faster variant. Step 3 then only fixes up d_ij for coupling
+     *  boundary pairs.
+     *
+     *  With an extended ghost halo (see OfflineData::extended_ghost_halo())
+     *  alpha_i is computed redundantly on all ghost rows coupled to a
+     *  locally owned row instead of being exchanged. The values have to
+     *  be bitwise identical to the ones of the owning rank, otherwise the
+     *  graph viscosity is not symmetric across ranks. We thus accumulate
+     *  the stencil in the order of the owning rank and evaluate rows that
+     *  are vectorized on the owning rank with the SIMD kernel (with the
+     *  row broadcast to all lanes). The active set (see
+     *  update_active_set()) skips entire SIMD strides on the owning rank,
+     *  which cannot be reproduced on a single ghost row; we exchange
+     *  alpha_i in this case.
      * -------------------------------------------------------------------------
      */
 
-    {
-      Scope scope(computing_timer_, scoped_name("compute d_ij, and alpha_i"));
+    /* Thread-local time step constraints, used by Steps 2 and 3: */
+    const auto reduce_tau_max = [&tau_max](const Number local_tau_max) {
+      Number current_tau_max = tau_max.load();
+      while (current_tau_max > local_tau_max &&
+             !tau_max.compare_exchange_weak(current_tau_max, local_tau_max))
+        ;
+    };
 
-      SynchronizationDispatch synchronization_dispatch([&]() {
-        alpha_.update_ghost_values_start(channel++);
-        alpha_.update_ghost_values_finish();
-      });
+    if (reuse_first_stage) {
+      const auto &name = scoped_name("restore d_ij, alpha_i, and tau_max");
+      Scope scope(computing_timer_, name);
+      record_traffic(name, traffic_restore);
+
+      dij_matrix_ = dij_matrix_first_stage_;
+      alpha_ = alpha_first_stage_;
+      tau_max.store(tau_max_first_stage_ * cfl_);
+
+      /* Skip Step 3 as well: */
+      ++step_no;
+
+    } else {
+      const auto &name = scoped_name(
+          fused_stencil_ ? "compute d_ij, d_ii, tau_max, and alpha_i"
+                         : "compute d_ij, and alpha_i");
+      Scope scope(computing_timer_, name);
+      record_traffic(name, traffic_dij);
+
+      const bool redundant_halo =
+          offline_data_->extended_ghost_halo() && !use_active_set;
+
+      SynchronizationDispatch synchronization_dispatch(
+          [&]() {
+            if (redundant_halo)
+              return;
+            update_alpha_ghost_values_start();
+            update_alpha_ghost_values_finish();
+          },
+          exchange_timer("ghost exchange, total"),
+          exchange_timer("ghost exchange, exposed"));
 
       RYUJIN_PARALLEL_REGION_BEGIN
       LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
 
+      /* Only used for the fused stencil: */
+      Number local_tau_max = std::numeric_limits<Number>::max();
+
       auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
         using T = decltype(sentinel);
         unsigned int stride_size = get_stride_size<T>;
@@ -366,8 +1445,11 @@ namespace ryujin
             *hyperbolic_system_, indicator_parameters_, old_precomputed);
 
         bool thread_ready = false;
+        unsigned int js_buffer[simd_length];
+        unsigned int js_prefetch_buffer[simd_length];
 
-        RYUJIN_OMP_FOR
+        const auto busy_start = thread_load_statistics_.start();
+        RYUJIN_OMP_FOR_RUNTIME_NOWAIT
         for (unsigned int i = left; i < right; i += stride_size) {
 
           /* Skip constrained degrees of freedom: */
@@ -375,16 +1457,27 @@ namespace ryujin
           if (row_length == 1)
             continue;
 
+          /* Record the wall time spent on this row (chunk), if enabled: */
+          const auto work_guard = row_work_statistics_.guard(i, stride_size);
+
           synchronization_dispatch.check(
               thread_ready, i >= n_export_indices && i < n_internal);
 
+          /* Skip inactive rows, see update_active_set(): */
+          if (is_inactive_row(T(), i))
+            continue;
+
           const auto U_i = old_U.template get_tensor<T>(i);
 
           indicator.reset(i, U_i);
 
-          const unsigned int *js = sparsity_simd.columns(i);
-          for (unsigned int col_idx = 0; col_idx < row_length;
-               ++col_idx, js += stride_size) {
+          T d_sum = T(0.);
+
+          for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+            const unsigned int *js =
+                sparsity_simd.columns(i, col_idx, js_buffer);
+
+            prefetch_neighbors(T(), i, col_idx, row_length, js_prefetch_buffer);
 
             const auto U_j = old_U.template get_tensor<T>(js);
 
@@ -397,31 +1490,193 @@ namespace ryujin
               continue;
 
             /* Only iterate over the upper triangular portion of d_ij */
-            if (all_below_diagonal<T>(i, js))
+            if (!fused_stencil_ && all_below_diagonal<T>(i, js))
               continue;
 
-            const auto norm = c_ij.norm();
-            const auto n_ij = c_ij / norm;
-            const auto lambda_max =
-                riemann_solver.compute(U_i, U_j, i, js, n_ij);
-            const auto d_ij = norm * lambda_max;
+            T norm;
+            dealii::Tensor<1, dim, T> n_ij;
+            if (precompute_normalized_cij) {
+              norm = cij_norm_matrix.template get_entry<T>(i, col_idx);
+              n_ij = nij_matrix.template get_tensor<T>(i, col_idx);
+            } else {
+              norm = c_ij.norm();
+              n_ij = c_ij / norm;
+            }
+
+            T d_ij;
+            if (!fused_stencil_ || !any_below_diagonal<T>(i, js)) {
+              const auto lambda_max =
+                  riemann_solver.compute(U_i, U_j, i, js, n_ij);
+              d_ij = norm * lambda_max;
+
+            } else {
+              /*
+               * The fused stencil also computes the lower triangular
+               * portion of d_ij. In order to guarantee that d_ij and d_ji
+               * are bitwise identical we evaluate every lane with j < i
+               * in its canonical orientation: with exactly the states,
+               * indices and (transposed) c_ji that row j uses when
+               * computing its upper triangular entry d_ji.
+               */
+              constexpr unsigned int n_lanes = get_stride_size<T>;
+              unsigned int is_a[simd_length];
+              unsigned int is_b[simd_length];
+
+              T norm_ji;
+              dealii::Tensor<1, dim, T> n_ji;
+              if (precompute_normalized_cij) {
+                norm_ji =
+                    cij_norm_matrix.template get_transposed_entry<T>(
+                        i, col_idx);
+                n_ji =
+                    nij_matrix.template get_transposed_tensor<T>(i, col_idx);
+              } else {
+                const auto c_ji =
+                    cij_matrix.template get_transposed_tensor<T>(i, col_idx);
+                norm_ji = c_ji.norm();
+                n_ji = c_ji / norm_ji;
+              }
+
+              for (unsigned int k = 0; k < n_lanes; ++k) {
+                const bool below = js[k] < i + k;
+                is_a[k] = below ? js[k] : i + k;
+                is_b[k] = below ? i + k : js[k];
+                if (below) {
+                  lane(norm, k) = lane(norm_ji, k);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    lane(n_ij[d], k) = lane(n_ji[d], k);
+                }
+              }
+
+              const auto U_a = old_U.template get_tensor<T>(is_a);
+              const auto U_b = old_U.template get_tensor<T>(is_b);
+
+              const auto lambda_max =
+                  riemann_solver.compute(U_a, U_b, is_a, is_b, n_ij);
+              d_ij = norm * lambda_max;
+            }
 
             dij_matrix_.write_entry(d_ij, i, col_idx, true);
+            d_sum -= d_ij;
           }
 
           const auto mass = get_entry<T>(lumped_mass_matrix, i);
           const auto hd_i = mass * measure_of_omega_inverse;
           write_entry<T>(alpha_, indicator.alpha(hd_i), i);
+
+          if (fused_stencil_) {
+            /* See the comment in Step 3 for the lower bound on d_sum: */
+            constexpr auto d_min =
+                Number(-1.e6) * std::numeric_limits<Number>::min();
+            d_sum = std::min(d_sum, T(d_min));
+            dij_matrix_.write_entry(d_sum, i, 0, true);
+
+            const auto tau = cfl_ * mass / (Number(-2.) * d_sum);
+            if constexpr (std::is_same_v<T, Number>) {
+              local_tau_max = std::min(local_tau_max, tau);
+            } else {
+              for (unsigned int k = 0; k < simd_length; ++k)
+                local_tau_max = std::min(local_tau_max, tau[k]);
+            }
+          }
+        }
+        thread_load_statistics_.stop(busy_start);
+        if (!skip_barrier(T(), left, right)) {
+          RYUJIN_OMP_BARRIER
         }
       };
 
       /* Parallel non-vectorized loop: */
       loop(Number(), n_internal, n_owned);
       /* Parallel vectorized SIMD loop: */
-      loop(VA(), 0, n_internal);
+      simd_range([&](auto left, auto right) { loop(VA(), left, right); });
+
+      /* Redundantly compute alpha_i on ghost rows: */
+      if (redundant_halo) {
+        const auto &[rows, row_starts, columns, cij, vectorized] =
+            offline_data_->ghost_halo();
+
+        using Indicator = typename Description::template Indicator<dim, Number>;
+        Indicator indicator(
+            *hyperbolic_system_, indicator_parameters_, old_precomputed);
+
+        using IndicatorSIMD = typename Description::template Indicator<dim, VA>;
+        IndicatorSIMD indicator_simd(
+            *hyperbolic_system_, indicator_parameters_, old_precomputed);
+
+        unsigned int is_simd[simd_length];
+        unsigned int js_simd[simd_length];
+
+        RYUJIN_OMP_FOR
+        for (std::size_t k = 0; k < rows.size(); ++k) {
+          const unsigned int i = rows[k];
+
+          /* Skip constrained degrees of freedom: */
+          if (row_starts[k + 1] - row_starts[k] == 1)
+            continue;
+
+          const Number mass = lumped_mass_matrix.local_element(i);
+
+          if (!vectorized[k]) {
+            const auto U_i = old_U.get_tensor(i);
+            indicator.reset(i, U_i);
+
+            for (auto p = row_starts[k]; p < row_starts[k + 1]; ++p) {
+              const unsigned int *js = &columns[p];
+              const auto U_j = old_U.template get_tensor<Number>(js);
+              indicator.accumulate(js, U_j, cij[p]);
+            }
+
+            const Number hd_i = mass * measure_of_omega_inverse;
+            alpha_.local_element(i) = indicator.alpha(hd_i);
+            continue;
+          }
+
+          /* Same SIMD operations as on the owning rank, in every lane: */
+          std::fill(std::begin(is_simd), std::end(is_simd), i);
+          const auto U_i = old_U.template get_tensor<VA>(is_simd);
+          indicator_simd.reset(is_simd, U_i);
+
+          for (auto p = row_starts[k]; p < row_starts[k + 1]; ++p) {
+            std::fill(std::begin(js_simd), std::end(js_simd), columns[p]);
+            const auto U_j = old_U.template get_tensor<VA>(js_simd);
+            dealii::Tensor<1, dim, VA> c_ij;
+            for (unsigned int d = 0; d < dim; ++d)
+              c_ij[d] = cij[p][d];
+            indicator_simd.accumulate(js_simd, U_j, c_ij);
+          }
+
+          const VA hd_i = VA(mass) * measure_of_omega_inverse;
+          alpha_.local_element(i) = indicator_simd.alpha(hd_i)[0];
+        }
+      }
+
+      if (fused_stencil_)
+        reduce_tau_max(local_tau_max);
 
       LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
       RYUJIN_PARALLEL_REGION_END
+
+#ifdef DEBUG
+      /* The redundant alpha_i has to be bitwise identical to the owner's: */
+      if (redundant_halo) {
+        const auto redundant_alpha = alpha_;
+        alpha_.update_ghost_values();
+
+        const auto &halo = offline_data_->ghost_halo();
+        for (std::size_t k = 0; k < halo.rows.size(); ++k) {
+          if (halo.row_starts[k + 1] - halo.row_starts[k] == 1)
+            continue;
+          const auto i = halo.rows[k];
+          const auto redundant = redundant_alpha.local_element(i);
+          const auto exchanged = alpha_.local_element(i);
+          Assert(std::memcmp(&redundant, &exchanged, sizeof(redundant)) == 0,
+                 dealii::ExcMessage("The redundantly computed alpha_i on a "
+                                    "ghost row differs from the value of "
+                                    "the owning rank."));
+        }
+      }
+#endif
     }
 
     /*
@@ -430,7 +1685,130 @@ namespace ryujin
      * -------------------------------------------------------------------------
      */
 
-    {
+    /*
+     * Load c_ij and c_ji for a SIMD group of coupling boundary pairs
+     * (lane by lane):
+     */
+    const auto gather_coupling_cij = [&](const auto &is,
+                                         const auto &col_idxs) {
+      std::array<dealii::Tensor<1, dim, VA>, 2> result;
+      for (unsigned int l = 0; l < simd_length; ++l) {
+        const auto c_ij = cij_matrix.get_tensor(is[l], col_idxs[l]);
+        const auto c_ji = cij_matrix.get_transposed_tensor(is[l], col_idxs[l]);
+        Assert(c_ji.norm() > 1.e-12, ExcInternalError());
+        for (unsigned int d = 0; d < dim; ++d) {
+          result[0][d][l] = c_ij[d];
+          result[1][d][l] = c_ji[d];
+        }
+      }
+      return result;
+    };
+
+    if (reuse_first_stage) {
+      /* Nothing to do, we have restored all data in Step 2. */
+
+    } else if (fused_stencil_) {
+      Scope scope(computing_timer_,
+                  scoped_name("compute bdry d_ij, bdry d_ii, and tau_max"));
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+
+      using RiemannSolver =
+          typename Description::template RiemannSolver<dim, VA>;
+      RiemannSolver riemann_solver(
+          *hyperbolic_system_, riemann_solver_parameters_, old_precomputed);
+
+      Number local_tau_max = std::numeric_limits<Number>::max();
+
+      /*
+       * Complete d_ij at boundary: The full row of d_ij has already been
+       * computed in Step 2. For coupling boundary pairs we recompute both
+       * d_ij and d_ji and take the maximum. The pairs are processed in
+       * SIMD groups, see prepare(). Every lane of the vectorized Riemann
+       * solver returns the result of the scalar computation, this ensures
+       * that d_ij and d_ji are bitwise identical.
+       */
+      RYUJIN_OMP_FOR
+      for (std::size_t k = 0; k < coupling_pairs_simd_.size(); ++k) {
+        const auto &[is, col_idxs, js] = coupling_pairs_simd_[k];
+
+        const auto U_i = old_U.template get_tensor<VA>(is.data());
+        const auto U_j = old_U.template get_tensor<VA>(js.data());
+
+        const auto [c_ij, c_ji] = gather_coupling_cij(is, col_idxs);
+
+        const auto norm_ij = c_ij.norm();
+        const auto n_ij = c_ij / norm_ij;
+
+        const auto norm_ji = c_ji.norm();
+        const auto n_ji = c_ji / norm_ji;
+
+        const auto d_ij = norm_ij * riemann_solver.compute(
+                                        U_i, U_j, is.data(), js.data(), n_ij);
+        const auto d_ji = norm_ji * riemann_solver.compute(
+                                        U_j, U_i, js.data(), is.data(), n_ji);
+
+        const auto d_max = std::max(d_ij, d_ji);
+        for (unsigned int l = 0; l < simd_length; ++l)
+          dij_matrix_.write_entry(d_max[l], is[l], col_idxs[l]);
+      }
+
+#ifdef DEBUG
+      /* Verify that d_ij and d_ji are bitwise identical: */
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        if (row_length == 1 || is_inactive_row(Number(), i))
+          continue;
+
+        const unsigned int *js = sparsity_simd.columns(i);
+        for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+          const auto j =
+              *(i < n_internal ? js + col_idx * simd_length : js + col_idx);
+          if (j >= n_owned || is_inactive_row(Number(), j))
+            continue;
+
+          Assert(dij_matrix_.get_entry(i, col_idx) ==
+                     dij_matrix_.get_transposed_entry(i, col_idx),
+                 dealii::ExcMessage("d_ij not symmetrized correctly by the "
+                                    "fused stencil."));
+        }
+      }
+#endif
+
+      /*
+       * Recompute the diagonal d_ii for all rows that were modified
+       * above. Coupling boundary pairs are sorted by row index, thus we
+       * only act on the first pair of every row:
+       */
+      RYUJIN_OMP_FOR
+      for (std::size_t k = 0; k < coupling_boundary_pairs.size(); ++k) {
+        const auto i = std::get<0>(coupling_boundary_pairs[k]);
+        if (k > 0 && std::get<0>(coupling_boundary_pairs[k - 1]) == i)
+          continue;
+
+        const unsigned int row_length = sparsity_simd.row_length(i);
+
+        Number d_sum = Number(0.);
+        for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx)
+          d_sum -= dij_matrix_.get_entry(i, col_idx);
+
+        d_sum =
+            std::min(d_sum, Number(-1.e6) * std::numeric_limits<Number>::min());
+        dij_matrix_.write_entry(d_sum, i, 0);
+
+        const Number mass = lumped_mass_matrix.local_element(i);
+        const Number tau = cfl_ * mass / (Number(-2.) * d_sum);
+        local_tau_max = std::min(local_tau_max, tau);
+      }
+
+      reduce_tau_max(local_tau_max);
+
+      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      RYUJIN_PARALLEL_REGION_END
+
+    } else {
       Scope scope(computing_timer_,
                   scoped_name("compute bdry d_ij, diag d_ii, and tau_max"));
 
@@ -447,57 +1825,61 @@ namespace ryujin
        * boundary degrees of freedom as well.
        */
 
+      /* Only used for verification in debug mode: */
       using RiemannSolver =
           typename Description::template RiemannSolver<dim, Number>;
-      RiemannSolver riemann_solver(
+      [[maybe_unused]] RiemannSolver riemann_solver(
+          *hyperbolic_system_, riemann_solver_parameters_, old_precomputed);
+
+      using RiemannSolverSIMD =
+          typename Description::template RiemannSolver<dim, VA>;
+      RiemannSolverSIMD riemann_solver_simd(
           *hyperbolic_system_, riemann_solver_parameters_, old_precomputed);
 
       Number local_tau_max = std::numeric_limits<Number>::max();
 
       /*
-       * Note: we need this dance of iterating over an integer and then
-       * accessing the element to make Apple's OpenMP implementation
-       * happy.
+       * Only work on index pairs "i < j" that point to the upper
+       * triangular portion of the d_ij matrix, see prepare(). For all of
+       * these index pairs we compute the corresponding d_ji entry and fix
+       * up the d_ij entry (from step 2) by taking the maximum. Note that
+       * we actually do not store anything in the d_ji entry itself
+       * because we symmetrize the matrix later on anyway. The pairs are
+       * processed in SIMD groups.
        */
       RYUJIN_OMP_FOR
-      for (std::size_t k = 0; k < coupling_boundary_pairs.size(); ++k) {
-        const auto &[i, col_idx, j] = coupling_boundary_pairs[k];
+      for (std::size_t k = 0; k < coupling_pairs_simd_.size(); ++k) {
+        const auto &[is, col_idxs, js] = coupling_pairs_simd_[k];
 
-        /*
-         * Only work on index pairs "i < j" that point to the upper
-         * triangular portion of the d_ij matrix. For all of these index
-         * pairs we compute the corresponding d_ji entry and fix up the
-         * d_ij entry (from step 2) by taking the maximum. Note that we
-         * actually do not store anything in the d_ji entry itself because
-         * we symmetrize the matrix later on anyway.
-         */
-        if (j < i)
-          continue;
+        const auto U_i = old_U.template get_tensor<VA>(is.data());
+        const auto U_j = old_U.template get_tensor<VA>(js.data());
 
-        const auto U_i = old_U.get_tensor(i);
-        const auto U_j = old_U.get_tensor(j);
+        VA d_ij;
+        for (unsigned int l = 0; l < simd_length; ++l)
+          d_ij[l] = dij_matrix_.get_entry(is[l], col_idxs[l]);
 
-        const auto c_ji = cij_matrix.get_transposed_tensor(i, col_idx);
-        Assert(c_ji.norm() > 1.e-12, ExcInternalError());
+        const auto c_ji = gather_coupling_cij(is, col_idxs)[1];
         const auto norm_ji = c_ji.norm();
         const auto n_ji = c_ji / norm_ji;
 
-        const auto d_ij = dij_matrix_.get_entry(i, col_idx);
-
-        const auto lambda_max = riemann_solver.compute(U_j, U_i, j, &i, n_ji);
+        const auto lambda_max = riemann_solver_simd.compute(
+            U_j, U_i, js.data(), is.data(), n_ji);
         const auto d_ji = norm_ji * lambda_max;
 
-        dij_matrix_.write_entry(std::max(d_ij, d_ji), i, col_idx);
+        const auto d_max = std::max(d_ij, d_ji);
+        for (unsigned int l = 0; l < simd_length; ++l)
+          dij_matrix_.write_entry(d_max[l], is[l], col_idxs[l]);
       }
 
       /* Symmetrize d_ij: */
 
-      RYUJIN_OMP_FOR
+      const auto busy_start = thread_load_statistics_.start();
+      RYUJIN_OMP_FOR_RUNTIME_NOWAIT
       for (unsigned int i = 0; i < n_owned; ++i) {
 
-        /* Skip constrained degrees of freedom: */
+        /* Skip constrained degrees of freedom and inactive rows: */
         const unsigned int row_length = sparsity_simd.row_length(i);
-        if (row_length == 1)
+        if (row_length == 1 || is_inactive_row(Number(), i))
           continue;
 
         Number d_sum = Number(0.);
@@ -532,7 +1914,9 @@ namespace ryujin
                                       "boundary degrees of freedom."));
 #endif
 
+#ifndef SYMMETRIC_MATRIX_STORAGE
             dij_matrix_.write_entry(d_ji, i, col_idx);
+#endif
           }
 
           d_sum -= dij_matrix_.get_entry(i, col_idx);
@@ -553,12 +1937,11 @@ namespace ryujin
         const Number tau = cfl_ * mass / (Number(-2.) * d_sum);
         local_tau_max = std::min(local_tau_max, tau);
       }
+      thread_load_statistics_.stop(busy_start);
+      RYUJIN_OMP_BARRIER
 
       /* Synchronize tau max over all threads: */
-      Number current_tau_max = tau_max.load();
-      while (current_tau_max > local_tau_max &&
-             !tau_max.compare_exchange_weak(current_tau_max, local_tau_max))
-        ;
+      reduce_tau_max(local_tau_max);
 
       LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
       RYUJIN_PARALLEL_REGION_END
@@ -566,19 +1949,32 @@ namespace ryujin
 
     {
       Scope scope(computing_timer_,
-                  "time step [H] _ - synchronization barriers");
+                  timer_name("time step [H] _ - synchronization barriers"));
 
       /*
        * MPI Barrier: Synchronize the maximal time-step size. This has to
-       * happen either over the global, or the local subrange communicator:
+       * happen either over the global, or the local subrange communicator.
+       *
+       * If the time step size tau is prescribed then tau_max is only used
+       * for detecting a crash. In this case we can defer the reduction
+       * and combine it with the reduction of the restart condition at the
+       * end of the step:
        */
-      tau_max.store(Utilities::MPI::min(
-          tau_max.load(), mpi_ensemble_.synchronization_communicator()));
+      if (!reuse_first_stage && !defer_tau_max_reduction)
+        tau_max.store(Utilities::MPI::min(
+            tau_max.load(), mpi_ensemble_.synchronization_communicator()));
+
+      if (store_first_stage) {
+        dij_matrix_first_stage_ = dij_matrix_;
+        alpha_first_stage_ = alpha_;
+        tau_max_first_stage_ = tau_max.load() / cfl_;
+        first_stage_stored_ = true;
+      }
 
-      AssertThrow(
-          !std::isnan(tau_max) && !std::isinf(tau_max) && tau_max > 0.,
-          ExcMessage(
-              "I'm sorry, Dave. I'm afraid I can't do that.\nWe crashed."));
+      tau_max.store(std::min(tau_max.load(), tau_max_bound));
+
+      if (!defer_tau_max_reduction)
+        check_tau_max(tau_max.load());
 
       tau = (tau == Number(0.) ? tau_max.load() : tau);
 
@@ -594,616 +1990,1137 @@ namespace ryujin
 #endif
 
     /*
-     * -------------------------------------------------------------------------
-     * Step 4: Low-order update, also compute limiter bounds, R_i
-     * -------------------------------------------------------------------------
+     * The row loops of Steps 4, 5, and 6 (see below). They are defined
+     * upfront so that they can be executed either step by step over all
+     * locally owned rows, or interleaved block by block if temporal
+     * blocking is enabled, see prepare_temporal_blocking().
      */
 
-    {
-      Scope scope(computing_timer_,
-                  scoped_name("l.-o. update, compute bounds, r_i, and p_ij"));
+    const Number weight =
+        -std::accumulate(stage_weights.begin(), stage_weights.end(), -1.);
 
-      SynchronizationDispatch synchronization_dispatch([&]() {
-        r_.update_ghost_values_start(channel++);
-        r_.update_ghost_values_finish();
-        if (offline_data_->discretization().have_discontinuous_ansatz()) {
-          /*
-           * In case we extend bounds over the stencil, we have to ensure
-           * that ghost ranges are properly communicated over all MPI
-           * ranks.
-           */
-          bounds_.update_ghost_values_start(channel++);
-          bounds_.update_ghost_values_finish();
-        }
-      });
+    /*
+     * The integral constant @p low_order_only is std::true_type if no
+     * limiter iterations are performed. In this case the high-order
+     * update, the limiter bounds, and the p_ij are dead work and are
+     * skipped at compile time.
+     */
+    const auto step_4_loop_impl = [&](SynchronizationDispatch &dispatch,
+                                      auto sentinel,
+                                      auto have_discontinuous_ansatz,
+                                      auto low_order_only,
+                                      unsigned int left,
+                                      unsigned int right) {
+      using T = decltype(sentinel);
+      using View = typename Description::template HyperbolicSystemView<dim, T>;
+      using Limiter = typename Description::template Limiter<dim, T>;
+      using flux_contribution_type = typename View::flux_contribution_type;
+      using state_type = typename View::state_type;
+
+      unsigned int stride_size = get_stride_size<T>;
+
+      const auto view = hyperbolic_system_->template view<dim, T>();
+
+      /* Stored thread locally: */
+      Limiter limiter(
+          *hyperbolic_system_, limiter_parameters_, old_precomputed);
+      bool thread_ready = false;
+      unsigned int js_buffer[simd_length];
+      unsigned int js_prefetch_buffer[simd_length];
+
+      const auto busy_start = thread_load_statistics_.start();
+      RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+      for (unsigned int i = left; i < right; i += stride_size) {
 
-      const Number weight =
-          -std::accumulate(stage_weights.begin(), stage_weights.end(), -1.);
+        /* Skip constrained degrees of freedom: */
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        if (row_length == 1)
+          continue;
 
-      /* Parallel region */
-      RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+        const auto work_guard = row_work_statistics_.guard(i, stride_size);
 
-      auto loop = [&](auto sentinel,
-                      auto have_discontinuous_ansatz,
-                      unsigned int left,
-                      unsigned int right) {
-        using T = decltype(sentinel);
-        using View =
-            typename Description::template HyperbolicSystemView<dim, T>;
-        using Limiter = typename Description::template Limiter<dim, T>;
-        using flux_contribution_type = typename View::flux_contribution_type;
-        using state_type = typename View::state_type;
+        dispatch.check(thread_ready, i >= n_export_indices && i < n_internal);
 
-        unsigned int stride_size = get_stride_size<T>;
+        const auto U_i = old_U.template get_tensor<T>(i);
 
-        const auto view = hyperbolic_system_->template view<dim, T>();
+        /* Inactive rows keep their state, see update_active_set(): */
+        if (is_inactive_row(T(), i)) {
+          new_U.template write_tensor<T>(U_i, i);
+          continue;
+        }
 
-        /* Stored thread locally: */
-        Limiter limiter(
-            *hyperbolic_system_, limiter_parameters_, old_precomputed);
-        bool thread_ready = false;
+        auto U_i_new = U_i;
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+        const auto alpha_i = get_entry<T>(alpha_, i);
+        const auto m_i = get_entry<T>(lumped_mass_matrix, i);
+        const auto m_i_inv = get_entry<T>(lumped_mass_matrix_inverse, i);
 
-          /* Skip constrained degrees of freedom: */
-          const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
-
-          synchronization_dispatch.check(
-              thread_ready, i >= n_export_indices && i < n_internal);
-
-          const auto U_i = old_U.template get_tensor<T>(i);
-          auto U_i_new = U_i;
-
-          const auto alpha_i = get_entry<T>(alpha_, i);
-          const auto m_i = get_entry<T>(lumped_mass_matrix, i);
-          const auto m_i_inv = get_entry<T>(lumped_mass_matrix_inverse, i);
-
-          const auto flux_i = view.flux_contribution(
-              old_precomputed, initial_precomputed_, i, U_i);
+        /* The time step size of the row, see local_time_stepping(): */
+        auto tau_i = T(tau);
+        if (local_time_stepping_)
+          tau_i = cfl_ * m_i /
+                  (Number(-2.) * dij_matrix_.template get_entry<T>(i, 0));
 
-          std::array<flux_contribution_type, stages> flux_iHs;
-          [[maybe_unused]] state_type S_iH;
+        /*
+         * Smooth rows are not limited, so we can skip computing limiter
+         * bounds. With a discontinuous ansatz bounds are extended over
+         * the stencil, though, and still have to be computed.
+         */
+        const bool skip_bounds =
+            low_order_only ||
+            (!have_discontinuous_ansatz && is_smooth_row(alpha_i));
 
-          for (int s = 0; s < stages; ++s) {
-            const auto &[U_s, prec_s, V_s] = stage_state_vectors[s].get();
+        const auto flux_i = view.flux_contribution(
+            old_precomputed, initial_precomputed_, i, U_i);
 
-            const auto U_iHs = U_s.template get_tensor<T>(i);
-            flux_iHs[s] =
-                view.flux_contribution(prec_s, initial_precomputed_, i, U_iHs);
+        std::array<flux_contribution_type, stages> flux_iHs;
+        [[maybe_unused]] state_type S_iH;
 
-            if constexpr (View::have_source_terms) {
-              S_iH +=
-                  stage_weights[s] * view.nodal_source(prec_s, i, U_iHs, tau);
-            }
-          }
+        for (int s = 0; !low_order_only && s < stages; ++s) {
+          const auto &[U_s, prec_s, V_s] = stage_state_vectors[s].get();
 
-          [[maybe_unused]] state_type S_i;
-          state_type F_iH;
+          const auto U_iHs = U_s.template get_tensor<T>(i);
+          flux_iHs[s] =
+              view.flux_contribution(prec_s, initial_precomputed_, i, U_iHs);
 
           if constexpr (View::have_source_terms) {
-            S_i = view.nodal_source(old_precomputed, i, U_i, tau);
-            S_iH += weight * S_i;
-            U_i_new += tau * /* m_i_inv * m_i */ S_i;
-            F_iH += m_i * S_iH;
+            S_iH += stage_weights[s] * view.nodal_source(prec_s, i, U_iHs, tau);
           }
+        }
 
-          limiter.reset(i, U_i, flux_i);
+        [[maybe_unused]] state_type S_i;
+        state_type F_iH;
 
-          [[maybe_unused]] state_type affine_shift;
+        if constexpr (View::have_source_terms) {
+          S_i = view.nodal_source(old_precomputed, i, U_i, tau);
+          S_iH += weight * S_i;
+          U_i_new += tau_i * /* m_i_inv * m_i */ S_i;
+          F_iH += m_i * S_iH;
+        }
 
-          /*
-           * Workaround: For shallow water we need to accumulate an
-           * additional contribution to the affine shift over the stencil
-           * before we can compute limiter bounds.
-           */
+        limiter.reset(i, U_i, flux_i);
 
-          const unsigned int *js = sparsity_simd.columns(i);
-          if constexpr (shallow_water) {
-            for (unsigned int col_idx = 0; col_idx < row_length;
-                 ++col_idx, js += stride_size) {
+        [[maybe_unused]] state_type affine_shift;
 
-              const auto U_j = old_U.template get_tensor<T>(js);
-              const auto flux_j = view.flux_contribution(
-                  old_precomputed, initial_precomputed_, js, U_j);
+        /*
+         * Workaround: For shallow water we need to accumulate an
+         * additional contribution to the affine shift over the stencil
+         * before we can compute limiter bounds.
+         */
 
-              const auto d_ij = dij_matrix_.template get_entry<T>(i, col_idx);
-              const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
+        const unsigned int *js = sparsity_simd.columns(i);
+        if constexpr (shallow_water) {
+          for (unsigned int col_idx = 0; !skip_bounds && col_idx < row_length;
+               ++col_idx, js += stride_size) {
 
-              const auto B_ij = view.affine_shift(flux_i, flux_j, c_ij, d_ij);
-              affine_shift += B_ij;
-            }
+            const auto U_j = old_U.template get_tensor<T>(js);
+            const auto flux_j = view.flux_contribution(
+                old_precomputed, initial_precomputed_, js, U_j);
 
-            affine_shift *= tau * m_i_inv;
-          }
+            const auto d_ij = dij_matrix_.template get_entry<T>(i, col_idx);
+            const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
 
-          if constexpr (View::have_source_terms) {
-            affine_shift += tau * /* m_i_inv * m_i */ S_i;
+            const auto B_ij = view.affine_shift(flux_i, flux_j, c_ij, d_ij);
+            affine_shift += B_ij;
           }
 
-          js = sparsity_simd.columns(i);
-          for (unsigned int col_idx = 0; col_idx < row_length;
-               ++col_idx, js += stride_size) {
+          affine_shift *= tau_i * m_i_inv;
+        }
 
-            const auto U_j = old_U.template get_tensor<T>(js);
+        if constexpr (View::have_source_terms) {
+          affine_shift += tau_i * /* m_i_inv * m_i */ S_i;
+        }
 
-            const auto alpha_j = get_entry<T>(alpha_, js);
+        for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+          js = sparsity_simd.columns(i, col_idx, js_buffer);
 
-            const auto d_ij = dij_matrix_.template get_entry<T>(i, col_idx);
-            auto factor = (alpha_i + alpha_j) * Number(.5);
+          prefetch_neighbors(T(), i, col_idx, row_length, js_prefetch_buffer);
 
-            if constexpr (have_discontinuous_ansatz) {
-              const auto incidence_ij =
-                  incidence_matrix.template get_entry<T>(i, col_idx);
-              factor = std::max(factor, incidence_ij);
-            }
+          const auto U_j = old_U.template get_tensor<T>(js);
+
+          const auto alpha_j = get_entry<T>(alpha_, js);
+
+          const auto d_ij = dij_matrix_.template get_entry<T>(i, col_idx);
+          auto factor = (alpha_i + alpha_j) * Number(.5);
 
-            const auto d_ijH = d_ij * factor;
+          if constexpr (have_discontinuous_ansatz) {
+            const auto incidence_ij =
+                incidence_matrix.template get_entry<T>(i, col_idx);
+            factor = std::max(factor, incidence_ij);
+          }
+
+          const auto d_ijH = d_ij * factor;
 
 #ifdef DEBUG
-            /*
-             * Verify that all local chunks of the d_ij matrix have been
-             * computed consistently over all MPI ranks. For that we import
-             * all ghost rows from neighboring MPI ranks and simply check
-             * that the (local) values of d_ij and d_ji match.
-             */
-            const auto d_ji =
-                dij_matrix_.template get_transposed_entry<T>(i, col_idx);
-            Assert(std::max(std::abs(d_ij - d_ji), T(1.0e-12)) == T(1.0e-12),
-                   dealii::ExcMessage(
-                       "d_ij not symmetrized correctly over MPI ranks"));
+          /*
+           * Verify that all local chunks of the d_ij matrix have been
+           * computed consistently over all MPI ranks. For that we import
+           * all ghost rows from neighboring MPI ranks and simply check
+           * that the (local) values of d_ij and d_ji match.
+           */
+          const auto d_ji =
+              dij_matrix_.template get_transposed_entry<T>(i, col_idx);
+          Assert(std::max(std::abs(d_ij - d_ji), T(1.0e-12)) == T(1.0e-12),
+                 dealii::ExcMessage(
+                     "d_ij not symmetrized correctly over MPI ranks"));
 #endif
 
-            const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
-            constexpr auto eps = std::numeric_limits<Number>::epsilon();
-            const auto scale = dealii::compare_and_apply_mask<
-                dealii::SIMDComparison::less_than>(
-                std::abs(d_ij), T(eps * eps), T(0.), T(1.) / d_ij);
-            const auto scaled_c_ij = c_ij * scale;
+          const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
+          constexpr auto eps = std::numeric_limits<Number>::epsilon();
+          const auto scale = dealii::compare_and_apply_mask<
+              dealii::SIMDComparison::less_than>(
+              std::abs(d_ij), T(eps * eps), T(0.), T(1.) / d_ij);
+          const auto scaled_c_ij = c_ij * scale;
 
-            const auto flux_j = view.flux_contribution(
-                old_precomputed, initial_precomputed_, js, U_j);
+          const auto flux_j = view.flux_contribution(
+              old_precomputed, initial_precomputed_, js, U_j);
 
-            const auto m_ij = mass_matrix.template get_entry<T>(i, col_idx);
+          const auto m_ij = mass_matrix.template get_entry<T>(i, col_idx);
 
-            /*
-             * Compute low-order flux and limiter bounds:
-             */
+          /*
+           * Compute low-order flux and limiter bounds:
+           */
 
-            const auto flux_ij = view.flux_divergence(flux_i, flux_j, c_ij);
-            U_i_new += tau * m_i_inv * flux_ij;
-            auto P_ij = -flux_ij;
+          /*
+           * Shallow water (and related) need the equilibrated states for
+           * the low-order flux, the update and the limiter bounds. We
+           * compute them only once:
+           */
+          [[maybe_unused]] std::array<state_type, 2> star_states;
+          if constexpr (shallow_water)
+            star_states = view.equilibrated_states(flux_i, flux_j);
+
+          const auto flux_ij = [&]() {
+            if constexpr (shallow_water)
+              return view.flux_divergence(flux_i, star_states, c_ij);
+            else
+              return view.flux_divergence(flux_i, flux_j, c_ij);
+          }();
+          U_i_new += tau_i * m_i_inv * flux_ij;
+          auto P_ij = -flux_ij;
 
-            if constexpr (shallow_water) {
-              /*
-               * Workaround: Shallow water (and related) are special:
-               */
+          if constexpr (shallow_water) {
+            /*
+             * Workaround: Shallow water (and related) are special:
+             */
 
-              const auto &[U_star_ij, U_star_ji] =
-                  view.equilibrated_states(flux_i, flux_j);
+            const auto &[U_star_ij, U_star_ji] = star_states;
 
-              U_i_new += tau * m_i_inv * d_ij * (U_star_ji - U_star_ij);
-              F_iH += d_ijH * (U_star_ji - U_star_ij);
-              P_ij += (d_ijH - d_ij) * (U_star_ji - U_star_ij);
+            U_i_new += tau_i * m_i_inv * d_ij * (U_star_ji - U_star_ij);
+            F_iH += d_ijH * (U_star_ji - U_star_ij);
+            P_ij += (d_ijH - d_ij) * (U_star_ji - U_star_ij);
 
+            if (!skip_bounds)
               limiter.accumulate(
                   U_j, U_star_ij, U_star_ji, scaled_c_ij, affine_shift);
 
-            } else {
+          } else {
 
-              U_i_new += tau * m_i_inv * d_ij * (U_j - U_i);
-              F_iH += d_ijH * (U_j - U_i);
-              P_ij += (d_ijH - d_ij) * (U_j - U_i);
+            U_i_new += tau_i * m_i_inv * d_ij * (U_j - U_i);
+            F_iH += d_ijH * (U_j - U_i);
+            P_ij += (d_ijH - d_ij) * (U_j - U_i);
 
+            if (!skip_bounds)
               limiter.accumulate(js, U_j, flux_j, scaled_c_ij, affine_shift);
-            }
+          }
 
-            if constexpr (View::have_source_terms) {
-              F_iH -= m_ij * S_iH;
-              P_ij -= m_ij * /*sic!*/ S_i;
-            }
+          /* Without limiter iterations this is all we need: */
+          if constexpr (low_order_only)
+            continue;
 
-            /*
-             * Compute high-order fluxes and source terms:
-             */
+          if constexpr (View::have_source_terms) {
+            F_iH -= m_ij * S_iH;
+            P_ij -= m_ij * /*sic!*/ S_i;
+          }
 
-            if constexpr (View::have_high_order_flux) {
-              const auto high_order_flux_ij =
-                  view.high_order_flux_divergence(flux_i, flux_j, c_ij);
-              F_iH += weight * high_order_flux_ij;
-              P_ij += weight * high_order_flux_ij;
-            } else {
-              F_iH += weight * flux_ij;
-              P_ij += weight * flux_ij;
-            }
+          /*
+           * Compute high-order fluxes and source terms:
+           */
 
-            if constexpr (View::have_source_terms) {
-              const auto S_j = view.nodal_source(old_precomputed, js, U_j, tau);
-              F_iH += weight * m_ij * S_j;
-              P_ij += weight * m_ij * S_j;
-            }
+          if constexpr (View::have_high_order_flux) {
+            const auto high_order_flux_ij =
+                view.high_order_flux_divergence(flux_i, flux_j, c_ij);
+            F_iH += weight * high_order_flux_ij;
+            P_ij += weight * high_order_flux_ij;
+          } else {
+            F_iH += weight * flux_ij;
+            P_ij += weight * flux_ij;
+          }
 
-            for (int s = 0; s < stages; ++s) {
-              const auto &[U_s, prec_s, V_s] = stage_state_vectors[s].get();
+          if constexpr (View::have_source_terms) {
+            const auto S_j = view.nodal_source(old_precomputed, js, U_j, tau);
+            F_iH += weight * m_ij * S_j;
+            P_ij += weight * m_ij * S_j;
+          }
 
-              const auto U_jHs = U_s.template get_tensor<T>(js);
-              const auto flux_jHs = view.flux_contribution(
-                  prec_s, initial_precomputed_, js, U_jHs);
+          for (int s = 0; s < stages; ++s) {
+            const auto &[U_s, prec_s, V_s] = stage_state_vectors[s].get();
 
-              if constexpr (View::have_high_order_flux) {
-                const auto high_order_flux_ij = view.high_order_flux_divergence(
-                    flux_iHs[s], flux_jHs, c_ij);
-                F_iH += stage_weights[s] * high_order_flux_ij;
-                P_ij += stage_weights[s] * high_order_flux_ij;
-              } else {
-                const auto flux_ij =
-                    view.flux_divergence(flux_iHs[s], flux_jHs, c_ij);
-                F_iH += stage_weights[s] * flux_ij;
-                P_ij += stage_weights[s] * flux_ij;
-              }
+            const auto U_jHs = U_s.template get_tensor<T>(js);
+            const auto flux_jHs = view.flux_contribution(
+                prec_s, initial_precomputed_, js, U_jHs);
 
-              if constexpr (View::have_source_terms) {
-                const auto S_js = view.nodal_source(prec_s, js, U_jHs, tau);
-                F_iH += stage_weights[s] * m_ij * S_js;
-                P_ij += stage_weights[s] * m_ij * S_js;
-              }
+            if constexpr (View::have_high_order_flux) {
+              const auto high_order_flux_ij = view.high_order_flux_divergence(
+                  flux_iHs[s], flux_jHs, c_ij);
+              F_iH += stage_weights[s] * high_order_flux_ij;
+              P_ij += stage_weights[s] * high_order_flux_ij;
+            } else {
+              const auto flux_ij =
+                  view.flux_divergence(flux_iHs[s], flux_jHs, c_ij);
+              F_iH += stage_weights[s] * flux_ij;
+              P_ij += stage_weights[s] * flux_ij;
             }
 
-            pij_matrix_.write_entry(P_ij, i, col_idx, true);
+            if constexpr (View::have_source_terms) {
+              const auto S_js = view.nodal_source(prec_s, js, U_jHs, tau);
+              F_iH += stage_weights[s] * m_ij * S_js;
+              P_ij += stage_weights[s] * m_ij * S_js;
+            }
           }
 
+          pij_matrix_.write_entry(P_ij, i, col_idx, true);
+        }
+
 #ifdef EXPENSIVE_BOUNDS_CHECK
-          if (!view.is_admissible(U_i_new)) {
-            restart_needed = true;
-          }
+        if (!view.is_admissible(U_i_new)) {
+          restart_needed = true;
+        }
 #endif
 
-          new_U.template write_tensor<T>(U_i_new, i);
-          r_.template write_tensor<T>(F_iH, i);
+        new_U.template write_tensor<T>(U_i_new, i);
 
-          const auto hd_i = m_i * measure_of_omega_inverse;
-          const auto relaxed_bounds = limiter.bounds(hd_i);
-          bounds_.template write_tensor<T>(relaxed_bounds, i);
-        }
-      };
-
-      /*
-       * Chain through a compile time integral constant std::true_type for
-       * a discontinuous ansatz and std::false_type otherwise. We use the
-       * (constexpr) integral constant later on to avoid branching when
-       * computing d_ijH.
-       */
-      if (offline_data_->discretization().have_discontinuous_ansatz()) {
-        /* Parallel non-vectorized loop and vectorized SIMD loop: */
-        loop(Number(), std::true_type{}, n_internal, n_owned);
-        loop(VA(), std::true_type{}, 0, n_internal);
-      } else {
-        /* Parallel non-vectorized loop and vectorized SIMD loop: */
-        loop(Number(), std::false_type{}, n_internal, n_owned);
-        loop(VA(), std::false_type{}, 0, n_internal);
-      }
+        if constexpr (low_order_only)
+          continue;
 
-      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
-      RYUJIN_PARALLEL_REGION_END
-    }
+        r_.template write_tensor<T>(F_iH, i);
 
-    /*
-     * -------------------------------------------------------------------------
-     * Step 5: Compute second part of P_ij, and l_ij (first round):
-     * -------------------------------------------------------------------------
-     */
+        if (skip_bounds)
+          continue;
 
-    if (limiter_parameters_.iterations() != 0) {
-      Scope scope(computing_timer_, scoped_name("compute p_ij, and l_ij"));
+        const auto hd_i = m_i * measure_of_omega_inverse;
+        auto relaxed_bounds = limiter.bounds(hd_i);
 
-      SynchronizationDispatch synchronization_dispatch([&]() {
-        lij_matrix_.update_ghost_rows_start(channel++);
-        lij_matrix_.update_ghost_rows_finish();
-      });
+        using IndicatorNumber = Vectors::indicator_number_type<Number>;
+        constexpr bool reduced_storage =
+            !std::is_same_v<IndicatorNumber, Number>;
+        if (reduced_storage ||
+            (have_discontinuous_ansatz && reduced_exchange)) {
+          /*
+           * Storing (or exchanging) the bounds in single precision must
+           * not tighten them. We thus widen the bounds by a few ulp of
+           * float: combine_bounds() picks the smaller of the two scaled
+           * lower bounds and the larger of the two upper bounds,
+           * independently of the sign.
+           */
+          constexpr auto eps =
+              Number(4. * std::numeric_limits<float>::epsilon());
+          auto bounds_down = relaxed_bounds;
+          auto bounds_up = relaxed_bounds;
+          for (unsigned int k = 0; k < n_bounds; ++k) {
+            bounds_down[k] *= Number(1.) - eps;
+            bounds_up[k] *= Number(1.) + eps;
+          }
+          relaxed_bounds = limiter.combine_bounds(bounds_down, bounds_up);
+        }
 
-      RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+        bounds_.template write_tensor<T>(relaxed_bounds, i);
+      }
+      thread_load_statistics_.stop(busy_start);
+      if (!skip_barrier(T(), left, right)) {
+        RYUJIN_OMP_BARRIER
+      }
+    };
 
-      auto loop = [&](auto sentinel,
-                      auto have_discontinuous_ansatz,
-                      unsigned int left,
-                      unsigned int right) {
-        using T = decltype(sentinel);
-        using View =
-            typename Description::template HyperbolicSystemView<dim, T>;
-        using Limiter = typename Description::template Limiter<dim, T>;
+    const auto step_4_loop = [&](SynchronizationDispatch &dispatch,
+                                 auto sentinel,
+                                 auto have_discontinuous_ansatz,
+                                 unsigned int left,
+                                 unsigned int right) {
+      if (limiter_parameters_.iterations() == 0)
+        step_4_loop_impl(dispatch,
+                         sentinel,
+                         have_discontinuous_ansatz,
+                         std::true_type{},
+                         left,
+                         right);
+      else
+        step_4_loop_impl(dispatch,
+                         sentinel,
+                         have_discontinuous_ansatz,
+                         std::false_type{},
+                         left,
+                         right);
+    };
 
-        unsigned int stride_size = get_stride_size<T>;
+    const auto step_5_loop = [&](SynchronizationDispatch &dispatch,
+                                 auto sentinel,
+                                 auto have_discontinuous_ansatz,
+                                 unsigned int left,
+                                 unsigned int right) {
+      using T = decltype(sentinel);
+      using View = typename Description::template HyperbolicSystemView<dim, T>;
+      using Limiter = typename Description::template Limiter<dim, T>;
 
-        /* Stored thread locally: */
-        Limiter limiter(
-            *hyperbolic_system_, limiter_parameters_, old_precomputed);
-        bool thread_ready = false;
+      unsigned int stride_size = get_stride_size<T>;
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+      /* Stored thread locally: */
+      Limiter limiter(
+          *hyperbolic_system_, limiter_parameters_, old_precomputed);
+      bool thread_ready = false;
+      std::size_t local_n_smooth_rows = 0;
+      std::size_t local_n_limited_rows = 0;
 
-          /* Skip constrained degrees of freedom: */
-          const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
+      const auto busy_start = thread_load_statistics_.start();
+      RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+      for (unsigned int i = left; i < right; i += stride_size) {
 
-          synchronization_dispatch.check(
-              thread_ready, i >= n_export_indices && i < n_internal);
+        /* Skip constrained degrees of freedom: */
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        if (row_length == 1)
+          continue;
 
-          auto bounds =
-              bounds_.template get_tensor<T, std::array<T, n_bounds>>(i);
+        const auto work_guard = row_work_statistics_.guard(i, stride_size);
 
-          /*
-           * In case of a discontinuous finite element ansatz we need to
-           * extend bounds over the stencil. We do this by looping over the
-           * stencil once and taking the minimum/maximum:
-           */
-          if constexpr (have_discontinuous_ansatz) {
-            /* Skip diagonal. */
-            const unsigned int *js = sparsity_simd.columns(i) + stride_size;
-            for (unsigned int col_idx = 1; col_idx < row_length;
-                 ++col_idx, js += stride_size) {
-              bounds = limiter.combine_bounds(
-                  bounds,
-                  bounds_.template get_tensor<T, std::array<T, n_bounds>>(js));
-            }
-            bounds_.template write_tensor<T>(bounds, i);
-          }
+        dispatch.check(thread_ready, i >= n_export_indices && i < n_internal);
 
-          [[maybe_unused]] T m_i;
-          if constexpr (have_discontinuous_ansatz)
-            m_i = get_entry<T>(lumped_mass_matrix, i);
-          const auto m_i_inv = get_entry<T>(lumped_mass_matrix_inverse, i);
+        /* Skip inactive rows, see update_active_set(): */
+        if (is_inactive_row(T(), i))
+          continue;
 
-          const auto U_i_new = new_U.template get_tensor<T>(i);
+        const bool smooth_row = is_smooth_row(get_entry<T>(alpha_, i));
+        local_n_limited_rows += stride_size;
+        if (smooth_row)
+          local_n_smooth_rows += stride_size;
 
-          const auto F_iH = r_.template get_tensor<T>(i);
+        row_work_counters_.count(
+            RowWorkCounters::stencil_entries, i, stride_size, row_length - 1);
+        if (smooth_row)
+          row_work_counters_.count(
+              RowWorkCounters::smooth_rows, i, stride_size);
 
-          const auto lambda_inv = Number(row_length - 1);
-          const auto factor = tau * m_i_inv * lambda_inv;
+        auto bounds =
+            bounds_.template get_tensor<T, std::array<T, n_bounds>>(i);
 
+        /*
+         * In case of a discontinuous finite element ansatz we need to
+         * extend bounds over the stencil. We do this by looping over the
+         * stencil once and taking the minimum/maximum:
+         */
+        if constexpr (have_discontinuous_ansatz) {
           /* Skip diagonal. */
           const unsigned int *js = sparsity_simd.columns(i) + stride_size;
           for (unsigned int col_idx = 1; col_idx < row_length;
                ++col_idx, js += stride_size) {
+            bounds = limiter.combine_bounds(
+                bounds,
+                bounds_.template get_tensor<T, std::array<T, n_bounds>>(js));
+          }
+          bounds_.template write_tensor<T>(bounds, i);
+        }
 
-            auto P_ij = pij_matrix_.template get_tensor<T>(i, col_idx);
-            const auto F_jH = r_.template get_tensor<T>(js);
+        [[maybe_unused]] T m_i;
+        if constexpr (have_discontinuous_ansatz)
+          m_i = get_entry<T>(lumped_mass_matrix, i);
+        const auto m_i_inv = get_entry<T>(lumped_mass_matrix_inverse, i);
 
-            /*
-             * Mass matrix correction:
-             */
+        const auto U_i_new = new_U.template get_tensor<T>(i);
 
-            const auto kronecker_ij = col_idx == 0 ? T(1.) : T(0.);
+        const auto F_iH = r_.template get_tensor<T>(i);
 
-            if constexpr (have_discontinuous_ansatz) {
-              /* Use full consistent mass matrix inverse: */
+        const auto lambda_inv = Number(row_length - 1);
+        auto factor = tau * m_i_inv * lambda_inv;
+        /* See local_time_stepping(): tau_i m_i_inv = cfl / (2 |d_ii|) */
+        if (local_time_stepping_)
+          factor = cfl_ * lambda_inv /
+                   (Number(-2.) * dij_matrix_.template get_entry<T>(i, 0));
 
-              const auto m_j = get_entry<T>(lumped_mass_matrix, js);
-              const auto m_ij_inv =
-                  mass_matrix_inverse.template get_entry<T>(i, col_idx);
-              const auto b_ij = m_i * m_ij_inv - kronecker_ij;
-              const auto b_ji = m_j * m_ij_inv - kronecker_ij;
+        /* Skip diagonal. */
+        const unsigned int *js = sparsity_simd.columns(i) + stride_size;
+        for (unsigned int col_idx = 1; col_idx < row_length;
+             ++col_idx, js += stride_size) {
 
-              P_ij += b_ij * F_jH - b_ji * F_iH;
+          if (prefetch_distance_ != 0 &&
+              col_idx + prefetch_distance_ < row_length)
+            r_.template prefetch<T>(js + prefetch_distance_ * stride_size);
 
-            } else {
-              /* Use Neumann series expansion: */
+          auto P_ij = pij_matrix_.template get_tensor<T>(i, col_idx);
+          const auto F_jH = r_.template get_tensor<T>(js);
 
-              const auto m_j_inv = get_entry<T>(lumped_mass_matrix_inverse, js);
-              const auto m_ij = mass_matrix.template get_entry<T>(i, col_idx);
-              const auto b_ij = kronecker_ij - m_ij * m_j_inv;
-              const auto b_ji = kronecker_ij - m_ij * m_i_inv;
+          /*
+           * Mass matrix correction:
+           */
 
-              P_ij += b_ij * F_jH - b_ji * F_iH;
-            }
+          const auto kronecker_ij = col_idx == 0 ? T(1.) : T(0.);
 
-            P_ij *= factor;
-            pij_matrix_.write_entry(P_ij, i, col_idx);
+          if constexpr (have_discontinuous_ansatz) {
+            /* Use full consistent mass matrix inverse: */
 
-            /*
-             * Compute limiter coefficients:
-             */
+            const auto m_j = get_entry<T>(lumped_mass_matrix, js);
+            const auto m_ij_inv =
+                mass_matrix_inverse.template get_entry<T>(i, col_idx);
+            const auto b_ij = m_i * m_ij_inv - kronecker_ij;
+            const auto b_ji = m_j * m_ij_inv - kronecker_ij;
 
-            const auto &[l_ij, success] = limiter.limit(bounds, U_i_new, P_ij);
-            lij_matrix_.template write_entry<T>(l_ij, i, col_idx, true);
+            P_ij += b_ij * F_jH - b_ji * F_iH;
 
-            /*
-             * If the success is set to false then the low-order update
-             * resulted in a state outside of the limiter bounds. This can
-             * happen if we compute with an aggressive CFL number. We
-             * signal this condition by setting the restart_needed boolean
-             * to true and defer further action to the chosen
-             * IDViolationStrategy and the policy set in the
-             * TimeIntegrator.
-             */
-            if (!success)
-              restart_needed = true;
+          } else {
+            /* Use Neumann series expansion: */
+
+            const auto m_j_inv = get_entry<T>(lumped_mass_matrix_inverse, js);
+            const auto m_ij = mass_matrix.template get_entry<T>(i, col_idx);
+            const auto b_ij = kronecker_ij - m_ij * m_j_inv;
+            const auto b_ji = kronecker_ij - m_ij * m_i_inv;
+
+            P_ij += b_ij * F_jH - b_ji * F_iH;
           }
-        }
-      };
 
-      /*
-       * Chain through a compile time integral constant std::true_type for
-       * a discontinuous ansatz and std::false_type otherwise. We use the
-       * (constexpr) integral constant later on to avoid branching when
-       * computing d_ijH.
-       */
-      if (offline_data_->discretization().have_discontinuous_ansatz()) {
-        /* Parallel non-vectorized loop and vectorized SIMD loop: */
-        loop(Number(), std::true_type{}, n_internal, n_owned);
-        loop(VA(), std::true_type{}, 0, n_internal);
-      } else {
-        /* Parallel non-vectorized loop and vectorized SIMD loop: */
-        loop(Number(), std::false_type{}, n_internal, n_owned);
-        loop(VA(), std::false_type{}, 0, n_internal);
-      }
+          P_ij *= factor;
+          pij_matrix_.write_entry(P_ij, i, col_idx);
 
-      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
-      RYUJIN_PARALLEL_REGION_END
-    }
+          /*
+           * Compute limiter coefficients:
+           */
 
-    /*
-     * -------------------------------------------------------------------------
-     * Step 6, 7: Perform high-order update:
-     *
-     *   Symmetrize l_ij
-     *   High-order update: += l_ij * lambda * P_ij
-     *   Compute next l_ij
-     * -------------------------------------------------------------------------
-     */
+          if (smooth_row) {
+            lij_matrix_.template write_entry<T>(T(1.), i, col_idx, true);
+            continue;
+          }
 
-    const auto n_iterations = limiter_parameters_.iterations();
-    for (unsigned int pass = 0; pass < n_iterations; ++pass) {
-      bool last_round = (pass + 1 == n_iterations);
+          const auto &[l_ij, success] = limiter.limit(bounds, U_i_new, P_ij);
+          lij_matrix_.template write_entry<T>(l_ij, i, col_idx, true);
 
-      std::string additional_step = (last_round ? "" : ", next l_ij");
-      Scope scope(
-          computing_timer_,
-          scoped_name("symmetrize l_ij, h.-o. update" + additional_step));
+          row_work_counters_.count(
+              RowWorkCounters::limiter_calls, i, stride_size);
+          if (!success)
+            row_work_counters_.count(
+                RowWorkCounters::limiter_failures, i, stride_size);
 
-      if ((n_iterations == 2) && last_round) {
-        std::swap(lij_matrix_, lij_matrix_next_);
+          /*
+           * If the success is set to false then the low-order update
+           * resulted in a state outside of the limiter bounds. This can
+           * happen if we compute with an aggressive CFL number. We
+           * signal this condition by setting the restart_needed boolean
+           * to true and defer further action to the chosen
+           * IDViolationStrategy and the policy set in the
+           * TimeIntegrator.
+           */
+          if (!success)
+            restart_needed = true;
+        }
       }
+      thread_load_statistics_.stop(busy_start);
+      n_smooth_rows_ += local_n_smooth_rows;
+      n_limited_rows_ += local_n_limited_rows;
+      if (!skip_barrier(T(), left, right)) {
+        RYUJIN_OMP_BARRIER
+      }
+    };
 
-      SynchronizationDispatch synchronization_dispatch([&]() {
-        if (!last_round) {
-          lij_matrix_next_.update_ghost_rows_start(channel++);
-          lij_matrix_next_.update_ghost_rows_finish();
-        }
-      });
+    /*
+     * The integral constant @p last_round is std::true_type for the last
+     * limiter pass, in which case we skip computing the next l_ij at
+     * compile time.
+     */
+    const auto step_6_loop_impl = [&](SynchronizationDispatch &dispatch,
+                                      auto &lij_matrix,
+                                      auto last_round,
+                                      auto sentinel,
+                                      unsigned int left,
+                                      unsigned int right) {
+      using T = decltype(sentinel);
+      using View = typename Description::template HyperbolicSystemView<dim, T>;
+      using Limiter = typename Description::template Limiter<dim, T>;
+
+      unsigned int stride_size = get_stride_size<T>;
+
+      /* Stored thread locally: */
+      AlignedVector<T> lij_row;
+      Limiter limiter(
+          *hyperbolic_system_, limiter_parameters_, old_precomputed);
+      bool thread_ready = false;
+
+      const auto busy_start = thread_load_statistics_.start();
+      RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+      for (unsigned int i = left; i < right; i += stride_size) {
 
-      RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+        /* Skip constrained degrees of freedom: */
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        if (row_length == 1)
+          continue;
 
-      auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
-        using T = decltype(sentinel);
-        using View =
-            typename Description::template HyperbolicSystemView<dim, T>;
-        using Limiter = typename Description::template Limiter<dim, T>;
+        const auto work_guard = row_work_statistics_.guard(i, stride_size);
 
-        unsigned int stride_size = get_stride_size<T>;
+        /* Never dispatch early when overlapping, see above: */
+        dispatch.check(thread_ready,
+                       !overlap_limiter_exchange_ && i >= n_export_indices &&
+                           i < n_internal);
 
-        /* Stored thread locally: */
-        AlignedVector<T> lij_row;
-        Limiter limiter(
-            *hyperbolic_system_, limiter_parameters_, old_precomputed);
-        bool thread_ready = false;
+        /* Skip inactive rows, see update_active_set(): */
+        if (is_inactive_row(T(), i))
+          continue;
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+        auto U_i_new = new_U.template get_tensor<T>(i);
 
-          /* Skip constrained degrees of freedom: */
-          const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
+        const Number lambda = Number(1.) / Number(row_length - 1);
+        lij_row.resize_fast(row_length);
 
-          synchronization_dispatch.check(
-              thread_ready, i >= n_export_indices && i < n_internal);
+        /* Skip diagonal. */
+        for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
 
-          auto U_i_new = new_U.template get_tensor<T>(i);
+          const auto l_ij = std::min(
+              lij_matrix.template get_entry<T>(i, col_idx),
+              lij_matrix.template get_transposed_entry<T>(i, col_idx));
 
-          const Number lambda = Number(1.) / Number(row_length - 1);
-          lij_row.resize_fast(row_length);
+          const auto p_ij = pij_matrix_.template get_tensor<T>(i, col_idx);
 
-          /* Skip diagonal. */
-          for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+          U_i_new += l_ij * lambda * p_ij;
 
-            const auto l_ij = std::min(
-                lij_matrix_.template get_entry<T>(i, col_idx),
-                lij_matrix_.template get_transposed_entry<T>(i, col_idx));
+          if constexpr (!last_round)
+            lij_row[col_idx] = l_ij;
+        }
 
-            const auto p_ij = pij_matrix_.template get_tensor<T>(i, col_idx);
+#ifdef EXPENSIVE_BOUNDS_CHECK
+        const auto view = hyperbolic_system_->template view<dim, T>();
+        if (!view.is_admissible(U_i_new)) {
+          restart_needed = true;
+        }
+#endif
 
-            U_i_new += l_ij * lambda * p_ij;
+        new_U.template write_tensor<T>(U_i_new, i);
 
-            if (!last_round)
-              lij_row[col_idx] = l_ij;
-          }
+        /* Skip computating l_ij and updating p_ij in the last round */
+        if constexpr (last_round)
+          continue;
 
-#ifdef EXPENSIVE_BOUNDS_CHECK
-          const auto view = hyperbolic_system_->template view<dim, T>();
-          if (!view.is_admissible(U_i_new)) {
-            restart_needed = true;
-          }
-#endif
+        /*
+         * Smooth rows accept the full remaining update, i.e., l_ij^(2)
+         * = 1, see Step 5:
+         */
+        if (is_smooth_row(get_entry<T>(alpha_, i))) {
+          for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx)
+            lij_matrix_next_.write_entry(
+                T(1.) - lij_row[col_idx], i, col_idx, true);
+          continue;
+        }
+
+        const auto bounds =
+            bounds_.template get_tensor<T, std::array<T, n_bounds>>(i);
+        /* Skip diagonal. */
+        for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
 
-          new_U.template write_tensor<T>(U_i_new, i);
+          const auto old_l_ij = lij_row[col_idx];
 
-          /* Skip computating l_ij and updating p_ij in the last round */
-          if (last_round)
+#ifndef EXPENSIVE_BOUNDS_CHECK
+          /*
+           * Shortcut: If the first pass accepted the full update p_ij
+           * (for all lanes) there is nothing left to limit and the
+           * entry (1 - l_ij^(1)) * l_ij^(2) below is zero. This is the
+           * case for the majority of pairs in smooth regions.
+           */
+          if (old_l_ij == T(1.)) {
+            lij_matrix_next_.write_entry(T(0.), i, col_idx, true);
             continue;
+          }
+#endif
 
-          const auto bounds =
-              bounds_.template get_tensor<T, std::array<T, n_bounds>>(i);
-          /* Skip diagonal. */
-          for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+          const auto new_p_ij = (T(1.) - old_l_ij) *
+                                pij_matrix_.template get_tensor<T>(i, col_idx);
 
-            const auto old_l_ij = lij_row[col_idx];
+          const auto &[new_l_ij, success] =
+              limiter.limit(bounds, U_i_new, new_p_ij);
 
-            const auto new_p_ij =
-                (T(1.) - old_l_ij) *
-                pij_matrix_.template get_tensor<T>(i, col_idx);
+          row_work_counters_.count(
+              RowWorkCounters::limiter_calls, i, stride_size);
+          if (!success)
+            row_work_counters_.count(
+                RowWorkCounters::limiter_failures, i, stride_size);
 
-            const auto &[new_l_ij, success] =
-                limiter.limit(bounds, U_i_new, new_p_ij);
-
-            /*
-             * This is the second pass of the limiter. Under rare
-             * circumstances the previous high-order update might be
-             * slightly out of bounds due to roundoff errors. This happens
-             * for example in flat regions or in stagnation points at a
-             * (slip boundary) point. The limiter should ensure that we do
-             * not further manipulate the state in this case. We thus only
-             * signal a restart condition if the `EXPENSIVE_BOUNDS_CHECK` debug
-             * macro is defined.
-             */
+          /*
+           * This is the second pass of the limiter. Under rare
+           * circumstances the previous high-order update might be
+           * slightly out of bounds due to roundoff errors. This happens
+           * for example in flat regions or in stagnation points at a
+           * (slip boundary) point. The limiter should ensure that we do
+           * not further manipulate the state in this case. We thus only
+           * signal a restart condition if the `EXPENSIVE_BOUNDS_CHECK` debug
+           * macro is defined.
+           */
 #ifdef EXPENSIVE_BOUNDS_CHECK
-            if (!success)
-              restart_needed = true;
+          if (!success)
+            restart_needed = true;
 #endif
 
-            /*
-             * Shortcut: We omit updating the p_ij and q_ij matrices and
-             * simply write (1 - l_ij^(1)) * l_ij^(2) into the l_ij matrix.
-             *
-             * This approach only works for at most two limiting steps.
-             */
-            const auto entry = (T(1.) - old_l_ij) * new_l_ij;
-            lij_matrix_next_.write_entry(entry, i, col_idx, true);
+          /*
+           * Shortcut: We omit updating the p_ij and q_ij matrices and
+           * simply write (1 - l_ij^(1)) * l_ij^(2) into the l_ij matrix.
+           *
+           * This approach only works for at most two limiting steps.
+           */
+          const auto entry = (T(1.) - old_l_ij) * new_l_ij;
+          lij_matrix_next_.write_entry(entry, i, col_idx, true);
+        }
+      }
+      thread_load_statistics_.stop(busy_start);
+      if (!skip_barrier(T(), left, right)) {
+        RYUJIN_OMP_BARRIER
+      }
+    };
+
+    const auto step_6_loop = [&](SynchronizationDispatch &dispatch,
+                                 auto &lij_matrix,
+                                 bool last_round,
+                                 auto sentinel,
+                                 unsigned int left,
+                                 unsigned int right) {
+      if (last_round)
+        step_6_loop_impl(
+            dispatch, lij_matrix, std::true_type{}, sentinel, left, right);
+      else
+        step_6_loop_impl(
+            dispatch, lij_matrix, std::false_type{}, sentinel, left, right);
+    };
+
+    const bool temporal_blocking = !temporal_schedule_.empty();
+
+    /*
+     * -------------------------------------------------------------------------
+     * Step 4: Low-order update, also compute limiter bounds, R_i
+     * -------------------------------------------------------------------------
+     */
+
+    if (!temporal_blocking) {
+      const auto &name =
+          scoped_name("l.-o. update, compute bounds, r_i, and p_ij");
+      Scope scope(computing_timer_, name);
+      record_traffic(name, traffic_low_order);
+
+      SynchronizationDispatch synchronization_dispatch(
+          [&]() {
+            /* Without limiter iterations neither r_i nor bounds are read: */
+            if (limiter_parameters_.iterations() == 0)
+              return;
+            r_.update_ghost_values_start(channel++);
+            r_.update_ghost_values_finish();
+            if (offline_data_->discretization().have_discontinuous_ansatz()) {
+              /*
+               * In case we extend bounds over the stencil, we have to ensure
+               * that ghost ranges are properly communicated over all MPI
+               * ranks.
+               */
+              update_bounds_ghost_values_start();
+              update_bounds_ghost_values_finish();
+            }
+          },
+          exchange_timer("ghost exchange, total"),
+          exchange_timer("ghost exchange, exposed"));
+
+      /* Parallel region */
+      RYUJIN_PARALLEL_REGION_BEGIN
+      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+
+      /*
+       * Chain through a compile time integral constant std::true_type for
+       * a discontinuous ansatz and std::false_type otherwise. We use the
+       * (constexpr) integral constant later on to avoid branching when
+       * computing d_ijH.
+       */
+      if (offline_data_->discretization().have_discontinuous_ansatz()) {
+        /* Parallel non-vectorized loop and vectorized SIMD loop: */
+        step_4_loop(synchronization_dispatch,
+                    Number(),
+                    std::true_type{},
+                    n_internal,
+                    n_owned);
+        simd_range([&](auto left, auto right) {
+          step_4_loop(
+              synchronization_dispatch, VA(), std::true_type{}, left, right);
+        });
+      } else {
+        /* Parallel non-vectorized loop and vectorized SIMD loop: */
+        step_4_loop(synchronization_dispatch,
+                    Number(),
+                    std::false_type{},
+                    n_internal,
+                    n_owned);
+        simd_range([&](auto left, auto right) {
+          step_4_loop(
+              synchronization_dispatch, VA(), std::false_type{}, left, right);
+        });
+      }
+
+      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    /*
+     * -------------------------------------------------------------------------
+     * Step 5: Compute second part of P_ij, and l_ij (first round):
+     * -------------------------------------------------------------------------
+     */
+
+    if (!temporal_blocking && limiter_parameters_.iterations() != 0) {
+      const auto &name = scoped_name("compute p_ij, and l_ij");
+      Scope scope(computing_timer_, name);
+      record_traffic(name, traffic_lij);
+
+      SynchronizationDispatch synchronization_dispatch(
+          [&]() {
+            lij_matrix_.update_transposed_entries_start(channel++);
+            /* The exchange is completed in Step 6 when overlapping: */
+            if (!overlap_limiter_exchange_)
+              lij_matrix_.update_transposed_entries_finish();
+          },
+          exchange_timer("ghost exchange, total"),
+          exchange_timer("ghost exchange, exposed"));
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+
+      /*
+       * Chain through a compile time integral constant std::true_type for
+       * a discontinuous ansatz and std::false_type otherwise. We use the
+       * (constexpr) integral constant later on to avoid branching when
+       * computing d_ijH.
+       */
+      if (offline_data_->discretization().have_discontinuous_ansatz()) {
+        /* Parallel non-vectorized loop and vectorized SIMD loop: */
+        step_5_loop(synchronization_dispatch,
+                    Number(),
+                    std::true_type{},
+                    n_internal,
+                    n_owned);
+        simd_range([&](auto left, auto right) {
+          step_5_loop(
+              synchronization_dispatch, VA(), std::true_type{}, left, right);
+        });
+      } else {
+        /* Parallel non-vectorized loop and vectorized SIMD loop: */
+        step_5_loop(synchronization_dispatch,
+                    Number(),
+                    std::false_type{},
+                    n_internal,
+                    n_owned);
+        simd_range([&](auto left, auto right) {
+          step_5_loop(
+              synchronization_dispatch, VA(), std::false_type{}, left, right);
+        });
+      }
+
+      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    /*
+     * -------------------------------------------------------------------------
+     * Steps 4, 5, 6 (first pass) with temporal blocking:
+     *
+     *   Execute the row loops of Steps 4, 5, and the first pass of Step 6
+     *   block by block in the order precomputed by
+     *   prepare_temporal_blocking(). A block is scheduled for Step 5 (or
+     *   6) as soon as all blocks it couples to have completed Step 4 (or
+     *   5), thus P_ij, l_ij, and the bounds of a block are consumed while
+     *   still cache resident. Subsequent limiter passes are not blocked.
+     * -------------------------------------------------------------------------
+     */
+
+    if (temporal_blocking) {
+      const auto &name = scoped_name("l.-o. update, bounds, r_i, p_ij, l_ij, "
+                                     "h.-o. update (blocked)");
+      Scope scope(computing_timer_, name);
+      /* p_ij and l_ij are consumed while still cache resident: */
+      record_traffic(name,
+                     traffic_low_order + traffic_lij + traffic_high_order -
+                         2. * (p_ij + l_ij));
+
+      dealii::Timer &exposed_timer = exchange_timer("ghost exchange, exposed");
+
+      const bool have_discontinuous_ansatz =
+          offline_data_->discretization().have_discontinuous_ansatz();
+      const bool last_round = (limiter_parameters_.iterations() == 1);
+
+      /* Ghost exchanges are issued explicitly from the schedule: */
+      SynchronizationDispatch no_dispatch([]() {});
+
+      /*
+       * Run a row loop over a block with the sentinel (and the integral
+       * constant for the ansatz) matching the index range of the block.
+       *
+       * A block coinciding with the export range [0, n_export_indices)
+       * ends without a barrier in the row loop (see skip_barrier()). The
+       * schedule relies on every block being complete before the next
+       * action starts, so we issue the barrier here:
+       */
+      const auto run = [&](const auto &loop, const auto &block) {
+        const auto [left, right] = block;
+        if (left < n_internal) {
+          if (have_discontinuous_ansatz)
+            loop(VA(), std::true_type{}, left, right);
+          else
+            loop(VA(), std::false_type{}, left, right);
+          if (skip_barrier(VA(), left, right)) {
+            RYUJIN_OMP_BARRIER
           }
+        } else {
+          if (have_discontinuous_ansatz)
+            loop(Number(), std::true_type{}, left, right);
+          else
+            loop(Number(), std::false_type{}, left, right);
         }
       };
 
-      /* Parallel non-vectorized loop: */
-      loop(Number(), n_internal, n_owned);
-      /* Parallel vectorized SIMD loop: */
-      loop(VA(), 0, n_internal);
+      RYUJIN_PARALLEL_REGION_BEGIN
+      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+
+      for (const auto &[action, index] : temporal_schedule_) {
+        const auto &block = temporal_blocks_[index];
+
+        switch (action) {
+        case TemporalBlockAction::step_4:
+          run([&](auto... args) { step_4_loop(no_dispatch, args...); }, block);
+          break;
+
+        case TemporalBlockAction::step_5:
+          run([&](auto... args) { step_5_loop(no_dispatch, args...); }, block);
+          break;
+
+        case TemporalBlockAction::step_6:
+          run(
+              [&](auto sentinel, auto, auto left, auto right) {
+                step_6_loop(no_dispatch,
+                            lij_matrix_,
+                            last_round,
+                            sentinel,
+                            left,
+                            right);
+              },
+              block);
+          break;
+
+        case TemporalBlockAction::start_exchange_4:
+          RYUJIN_OMP_SINGLE
+          {
+            exposed_timer.start();
+            r_.update_ghost_values_start(channel++);
+            if (have_discontinuous_ansatz)
+              update_bounds_ghost_values_start();
+            exposed_timer.stop();
+          }
+          break;
+
+        case TemporalBlockAction::finish_exchange_4:
+          RYUJIN_OMP_SINGLE
+          {
+            exposed_timer.start();
+            r_.update_ghost_values_finish();
+            if (have_discontinuous_ansatz)
+              update_bounds_ghost_values_finish();
+            exposed_timer.stop();
+          }
+          break;
+
+        case TemporalBlockAction::start_exchange_5:
+          RYUJIN_OMP_SINGLE
+          {
+            exposed_timer.start();
+            lij_matrix_.update_transposed_entries_start(channel++);
+            exposed_timer.stop();
+          }
+          break;
+
+        case TemporalBlockAction::finish_exchange_5:
+          RYUJIN_OMP_SINGLE
+          {
+            exposed_timer.start();
+            lij_matrix_.update_transposed_entries_finish();
+            exposed_timer.stop();
+          }
+          break;
+        }
+      }
 
       LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
       RYUJIN_PARALLEL_REGION_END
-    } /* limiter_iter_ */
 
-    CALLGRIND_STOP_INSTRUMENTATION;
+      /* Start the exchange of the l_ij for the next pass, see Step 6: */
+      if (!last_round) {
+        exposed_timer.start();
+        lij_matrix_next_.update_transposed_entries_start(channel++);
+        if (!overlap_limiter_exchange_)
+          lij_matrix_next_.update_transposed_entries_finish();
+        exposed_timer.stop();
+      }
+
+      /* Keep the numbering of the timer sections of subsequent passes: */
+      step_no += 2;
+    }
 
     /*
-     * Pass through the parabolic state vector
+     * -------------------------------------------------------------------------
+     * Step 6, 7: Perform high-order update:
+     *
+     *   Symmetrize l_ij
+     *   High-order update: += l_ij * lambda * P_ij
+     *   Compute next l_ij
+     * -------------------------------------------------------------------------
      */
+
+    const auto n_iterations = limiter_parameters_.iterations();
+    for (unsigned int pass = temporal_blocking ? 1 : 0; pass < n_iterations;
+         ++pass) {
+      bool last_round = (pass + 1 == n_iterations);
+
+      const auto &name =
+          scoped_name(last_round ? "symmetrize l_ij, h.-o. update"
+                                 : "symmetrize l_ij, h.-o. update, next l_ij");
+      Scope scope(computing_timer_, name);
+      record_traffic(name,
+                     traffic_high_order + (last_round ? 0. : traffic_lij));
+
+      /*
+       * The second pass reads the l_ij computed in the first pass. We
+       * select the matrix by reference instead of swapping the two
+       * matrices so that their (pending) ghost exchanges stay attached to
+       * the same object:
+       */
+      auto &lij_matrix = (pass == 0) ? lij_matrix_ : lij_matrix_next_;
+
+      SynchronizationDispatch synchronization_dispatch(
+          [&]() {
+            if (!last_round) {
+              lij_matrix_next_.update_transposed_entries_start(channel++);
+              /* The exchange is completed in the next pass: */
+              if (!overlap_limiter_exchange_)
+                lij_matrix_next_.update_transposed_entries_finish();
+            }
+          },
+          exchange_timer("ghost exchange, total"),
+          exchange_timer("ghost exchange, exposed"));
+
+      /*
+       * When overlapping we complete the ghost exchange of the l_ij
+       * matrix (started at the end of the previous step, or pass) after
+       * the interior rows have been processed:
+       */
+      dealii::Timer &exposed_timer = exchange_timer("ghost exchange, exposed");
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+
+      if (overlap_limiter_exchange_) {
+        /*
+         * Rows in the interior range [n_export_indices, n_internal) do not
+         * couple to ghost rows and can be processed before the ghost
+         * exchange has completed:
+         */
+        step_6_loop(synchronization_dispatch,
+                    lij_matrix,
+                    last_round,
+                    VA(),
+                    n_export_indices,
+                    n_internal);
+
+        RYUJIN_OMP_SINGLE
+        {
+          exposed_timer.start();
+          lij_matrix.update_transposed_entries_finish();
+          exposed_timer.stop();
+        }
+
+        /* Parallel non-vectorized loop: */
+        step_6_loop(synchronization_dispatch,
+                    lij_matrix,
+                    last_round,
+                    Number(),
+                    n_internal,
+                    n_owned);
+        /* Parallel vectorized SIMD loop over the export range: */
+        step_6_loop(synchronization_dispatch,
+                    lij_matrix,
+                    last_round,
+                    VA(),
+                    0,
+                    n_export_indices);
+
+      } else {
+        /* Parallel non-vectorized loop: */
+        step_6_loop(synchronization_dispatch,
+                    lij_matrix,
+                    last_round,
+                    Number(),
+                    n_internal,
+                    n_owned);
+        /* Parallel vectorized SIMD loop: */
+        simd_range([&](auto left, auto right) {
+          step_6_loop(synchronization_dispatch,
+                      lij_matrix,
+                      last_round,
+                      VA(),
+                      left,
+                      right);
+        });
+      }
+
+      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      RYUJIN_PARALLEL_REGION_END
+    } /* limiter_iter_ */
+
+    CALLGRIND_STOP_INSTRUMENTATION;
+
     const auto &old_V = std::get<2>(old_state_vector);
     auto &new_V = std::get<2>(new_state_vector);
-    new_V = old_V;
 
-    /*
-     * Do we have to restart?
-     */
+    if (nonblocking_reductions_) {
+      /*
+       * Post a single nonblocking reduction for tau_max and the restart
+       * condition (encoded as 0 for "restart needed" and 1 otherwise) and
+       * pass through the parabolic state vector while the reduction is in
+       * flight. A (local) crash is mapped to a zero tau_max so that all
+       * ranks detect it consistently.
+       */
+
+      const Number local_tau_max = tau_max.load();
+      std::array<Number, 2> local_values{
+          {(std::isnan(local_tau_max) || std::isinf(local_tau_max))
+               ? Number(0.)
+               : local_tau_max,
+           restart_needed ? Number(0.) : Number(1.)}};
+      std::array<Number, 2> global_values;
+
+      MPI_Request request;
+      const int ierr = MPI_Iallreduce(
+          local_values.data(),
+          global_values.data(),
+          2,
+          std::is_same_v<Number, double> ? MPI_DOUBLE : MPI_FLOAT,
+          MPI_MIN,
+          mpi_ensemble_.synchronization_communicator(),
+          &request);
+      AssertThrowMPI(ierr);
+
+      new_V = old_V;
+
+      Scope scope(computing_timer_,
+                  timer_name("time step [H] _ - synchronization barriers"));
+
+      MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+      if (defer_tau_max_reduction)
+        check_tau_max(global_values[0]);
+      restart_needed.store(global_values[1] == Number(0.));
+
+    } else {
+      /*
+       * Pass through the parabolic state vector
+       */
+      new_V = old_V;
+
+      /*
+       * Do we have to restart?
+       */
 
-    {
       Scope scope(computing_timer_,
-                  "time step [H] _ - synchronization barriers");
+                  timer_name("time step [H] _ - synchronization barriers"));
 
       /*
        * Synchronize whether we have to restart the time step. Even though
@@ -1231,8 +3148,268 @@ namespace ryujin
     Vectors::debug_poison_precomputed_values<Description>(new_state_vector,
                                                           *offline_data_);
 
+    if (kernel_variant_sample)
+      kernel_variants_.stop();
+
     /* Return the time step size tau: */
     return tau;
   }
 
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::update_active_set(
+      const StateVector &state_vector) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "HyperbolicModule<Description, dim, Number>::"
+                 "update_active_set()"
+              << std::endl;
+#endif
+
+    const auto &U = std::get<0>(state_vector);
+
+    constexpr auto simd_length = simd_width<Number>;
+    const unsigned int n_internal = offline_data_->n_locally_internal();
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+    const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
+
+    if constexpr (std::is_same_v<Description, ShallowWater::Description>) {
+      using View =
+          typename Description::template HyperbolicSystemView<dim, Number>;
+      const auto view = hyperbolic_system_->template view<dim, Number>();
+
+      /* Use the same cutoff as for filtering dry states: */
+      constexpr auto eps = std::numeric_limits<Number>::epsilon();
+      const Number h_dry = view.reference_water_depth() *
+                           view.dry_state_relaxation_large() * Number(eps);
+
+      /* Flag all wet degrees of freedom: */
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
+        const auto h_i = View::water_depth(U.get_tensor(i));
+        active_.local_element(i) = h_i > h_dry ? Number(1.) : Number(0.);
+      }
+      RYUJIN_PARALLEL_REGION_END
+
+    } else {
+
+      /*
+       * Flag all rows with a non-quiescent stencil. If all states U_j of
+       * the stencil coincide with U_i the fluxes and the graph viscosity
+       * of the row cancel and the update vanishes:
+       */
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        const unsigned int *js = sparsity_simd.columns(i);
+        const auto U_i = U.get_tensor(i);
+
+        bool quiescent = true;
+        for (unsigned int col_idx = 1; quiescent && col_idx < row_length;
+             ++col_idx) {
+          const auto j =
+              *(i < n_internal ? js + col_idx * simd_length : js + col_idx);
+          const auto U_j = U.get_tensor(j);
+          for (unsigned int k = 0; k < problem_dimension; ++k) {
+            const auto scale = std::max(std::abs(U_i[k]), std::abs(U_j[k]));
+            if (std::abs(U_j[k] - U_i[k]) > quiescent_tolerance_ * scale) {
+              quiescent = false;
+              break;
+            }
+          }
+        }
+
+        active_.local_element(i) = quiescent ? Number(0.) : Number(1.);
+      }
+      RYUJIN_PARALLEL_REGION_END
+
+      /*
+       * Boundary conditions (for example time-dependent Dirichlet data)
+       * might change a quiescent state, always flag boundary rows:
+       */
+      for (const auto &entry : offline_data_->boundary_map()) {
+        const auto i = std::get<0>(entry);
+        if (i < n_owned)
+          active_.local_element(i) = Number(1.);
+      }
+    }
+
+    active_.update_ghost_values();
+
+    /*
+     * Extend the flagged region by active_set_interval_ layers of the
+     * stencil. Every layer requires a ghost exchange:
+     */
+
+    for (unsigned int layer = 0; layer < active_set_interval_; ++layer) {
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
+        const unsigned int row_length = sparsity_simd.row_length(i);
+        const unsigned int *js = sparsity_simd.columns(i);
+
+        Number value = Number(0.);
+        for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+          const auto j =
+              *(i < n_internal ? js + col_idx * simd_length : js + col_idx);
+          value = std::max(value, active_.local_element(j));
+        }
+        active_scratch_.local_element(i) = value;
+      }
+      RYUJIN_PARALLEL_REGION_END
+
+      active_.swap(active_scratch_);
+      active_.update_ghost_values();
+    }
+
+    /*
+     * Reset auxiliary data of all inactive rows. The entries are read
+     * (as transposed entries, or via the stencil) by neighboring active
+     * rows and are never recomputed while the row stays inactive:
+     */
+
+    constexpr auto d_min = Number(-1.e6) * std::numeric_limits<Number>::min();
+
+    const auto n_iterations = limiter_parameters_.iterations();
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      if (active_.local_element(i) != Number(0.))
+        continue;
+
+      const unsigned int row_length = sparsity_simd.row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+        const Number d_ij = (col_idx == 0) ? d_min : Number(0.);
+        dij_matrix_.write_entry(d_ij, i, col_idx);
+        if (n_iterations > 0)
+          lij_matrix_.write_entry(Number(0.), i, col_idx);
+        if (n_iterations > 1)
+          lij_matrix_next_.write_entry(Number(0.), i, col_idx);
+      }
+
+      alpha_.local_element(i) = Number(0.);
+      r_.write_tensor(state_type(), i);
+    }
+    RYUJIN_PARALLEL_REGION_END
+
+    /* A stored first stage does not know about the new active set: */
+    first_stage_stored_ = false;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  std::vector<double>
+  HyperbolicModule<Description, dim, Number>::local_time_step_levels(
+      unsigned int n_levels) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "HyperbolicModule<Description, dim, "
+                 "Number>::local_time_step_levels()"
+              << std::endl;
+#endif
+
+    Assert(n_levels > 0, dealii::ExcInternalError());
+
+    const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
+    const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+    const auto &communicator = mpi_ensemble_.ensemble_communicator();
+
+    const auto local_tau = [&](const unsigned int i) {
+      const Number mass = lumped_mass_matrix.local_element(i);
+      const Number d_ii = dij_matrix_.get_entry(i, 0);
+      return cfl_ * mass / (Number(-2.) * d_ii);
+    };
+
+    Number tau_min = std::numeric_limits<Number>::max();
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      /* Skip constrained degrees of freedom: */
+      if (sparsity_simd.row_length(i) == 1)
+        continue;
+      tau_min = std::min(tau_min, local_tau(i));
+    }
+    tau_min = Utilities::MPI::min(tau_min, communicator);
+
+    std::vector<double> levels(n_levels, 0.);
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      /* Skip constrained degrees of freedom: */
+      if (sparsity_simd.row_length(i) == 1)
+        continue;
+      const auto ratio = static_cast<double>(local_tau(i) / tau_min);
+      const auto level =
+          static_cast<unsigned int>(std::log2(std::max(ratio, 1.)));
+      levels[std::min(level, n_levels - 1)] += 1.;
+    }
+
+    levels = Utilities::MPI::sum(levels, communicator);
+    const auto n_dofs = std::accumulate(levels.begin(), levels.end(), 0.);
+    if (n_dofs > 0.)
+      for (auto &it : levels)
+        it /= n_dofs;
+
+    return levels;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::print_thread_load_statistics(
+      std::ostream &output) const
+  {
+    if (!report_thread_load_)
+      return;
+
+    const auto busy_time = thread_load_statistics_.busy_time();
+    thread_load_statistics_.reset();
+
+    double max = 0.;
+    double sum = 0.;
+    for (const auto &it : busy_time) {
+      max = std::max(max, it);
+      sum += it;
+    }
+    const double avg = busy_time.empty() ? 0. : sum / busy_time.size();
+
+    /* Relative load imbalance: slowest thread compared to the average: */
+    const double imbalance = avg > 0. ? max / avg - 1. : 0.;
+
+    const auto &communicator = mpi_ensemble_.synchronization_communicator();
+    const auto busy_data = Utilities::MPI::min_max_avg(avg, communicator);
+    const auto imbalance_data =
+        Utilities::MPI::min_max_avg(imbalance, communicator);
+
+    output << "        [ thread busy time: " << std::setprecision(2)
+           << std::scientific << busy_data.avg << " s, load imbalance: avg "
+           << std::setprecision(1) << std::fixed << 100. * imbalance_data.avg
+           << "%, max " << 100. * imbalance_data.max << "% [p"
+           << imbalance_data.max_index << "] ]" << std::endl;
+  }
+
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::print_smooth_row_statistics(
+      std::ostream &output) const
+  {
+    if (smooth_row_threshold_ <= Number(0.))
+      return;
+
+    const auto &communicator = mpi_ensemble_.synchronization_communicator();
+    const double n_smooth_rows =
+        Utilities::MPI::sum(double(n_smooth_rows_.exchange(0)), communicator);
+    const double n_limited_rows =
+        Utilities::MPI::sum(double(n_limited_rows_.exchange(0)), communicator);
+
+    const double ratio =
+        n_limited_rows > 0. ? n_smooth_rows / n_limited_rows : 0.;
+
+    output << "        [ smooth rows skipping the limiter: "
+           << std::setprecision(1) << std::fixed << 100. * ratio << "% ]"
+           << std::endl;
+  }
+
 } /* namespace ryujin */
@@ -9,7 +9,9 @@
 
 #include "convenience_macros.h"
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/parameter_acceptor.h>
+#include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
 
 #include <set>
@@ -49,6 +51,17 @@ namespace ryujin
         : ParameterAcceptor(subsection + "/" + name)
         , name_(name)
     {
+      /*
+       * Derived classes that modify internal state in compute() (or
+       * initial_precomputations()) have to set this boolean to false.
+       */
+      thread_safe_ = true;
+
+      /*
+       * Derived classes whose compute() ignores the time argument t can
+       * set this boolean to true.
+       */
+      time_independent_ = false;
     }
 
     /**
@@ -60,6 +73,24 @@ namespace ryujin
      */
     virtual state_type compute(const dealii::Point<dim> &point, Number t) = 0;
 
+    /**
+     * Variant of above function operating on a batch of points @p
+     * points. The result is stored in the first argument @p states,
+     * overriding previous contents. The default implementation simply
+     * calls compute() for every point.
+     */
+    virtual void
+    compute(const dealii::ArrayView<state_type> &states,
+            const dealii::ArrayView<const dealii::Point<dim>> &points,
+            Number t)
+    {
+      Assert(states.size() == points.size(),
+             dealii::ExcMessage("vectors have different size"));
+
+      for (unsigned int i = 0; i < points.size(); ++i)
+        states[i] = compute(points[i], t);
+    }
+
     /**
      * Given a position @p point returns a precomputed value used for the
      * flux computation via HyperbolicSystem::flux_contribution().
@@ -80,6 +111,24 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(name)
 
+    /**
+     * Return true if compute() and initial_precomputations() can be
+     * called concurrently from multiple threads. In this case
+     * InitialValues interpolates initial values thread-parallel.
+     */
+    ACCESSOR_READ_ONLY(thread_safe)
+
+    /**
+     * Return true if compute() returns the same state for all times t. In
+     * this case Dirichlet boundary data is evaluated only once, see
+     * HyperbolicModule::prepare_state_vector().
+     */
+    ACCESSOR_READ_ONLY(time_independent)
+
+  protected:
+    bool thread_safe_;
+    bool time_independent_;
+
   private:
     const std::string name_;
   };
@@ -13,4 +13,10 @@ namespace ryujin
   template class InitialValues<Description, 2, NUMBER>;
   template class InitialValues<Description, 3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class InitialValues<Description, 1, float>;
+  template class InitialValues<Description, 2, float>;
+  template class InitialValues<Description, 3, float>;
+#endif
+
 } /* namespace ryujin */
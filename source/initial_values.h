@@ -10,12 +10,14 @@
 #include "initial_state_library.h"
 #include "mpi_ensemble.h"
 #include "offline_data.h"
+#include "simd.h"
 
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/tensor.h>
 
 #include <functional>
+#include <vector>
 
 namespace ryujin
 {
@@ -116,9 +118,47 @@ namespace ryujin
     }
 
 
+    /**
+     * Evaluate the initial state for time @p t at a batch of positions
+     * @p points and store the result in @p states. The function may only
+     * be called concurrently if thread_safe() returns true.
+     */
+    void
+    initial_states(const dealii::ArrayView<state_type> &states,
+                   const dealii::ArrayView<const dealii::Point<dim>> &points,
+                   Number t) const
+    {
+      initial_states_(states, points, t);
+    }
+
+
+    /**
+     * Return whether the selected initial state can be evaluated
+     * concurrently from several threads.
+     */
+    ACCESSOR_READ_ONLY(thread_safe)
+
+
+    /**
+     * Return whether the selected initial state (including a possible
+     * perturbation) is independent of the time t.
+     */
+    ACCESSOR_READ_ONLY(time_independent)
+
+
+    /**
+     * Return the positions of all locally owned degrees of freedom
+     * indexed by their local index.
+     */
+    std::vector<dealii::Point<dim>> locally_owned_support_points() const;
+
+
     /**
      * This routine computes and returns a state vector populated with
      * initial values for a specified time @p t.
+     *
+     * The initial state is evaluated in batches of @ref batch_size points
+     * and, if the selected initial state is thread safe, in parallel.
      */
     HyperbolicVector interpolate_hyperbolic_vector(Number t = 0) const;
 
@@ -129,6 +169,12 @@ namespace ryujin
      */
     InitialPrecomputedVector interpolate_initial_precomputed_vector() const;
 
+    /**
+     * The number of points evaluated at once by
+     * interpolate_hyperbolic_vector().
+     */
+    static constexpr unsigned int batch_size = simd_width<Number>;
+
   private:
     //@}
     /**
@@ -162,9 +208,17 @@ namespace ryujin
     std::function<state_type(const dealii::Point<dim> &, Number)>
         initial_state_;
 
+    std::function<void(const dealii::ArrayView<state_type> &,
+                       const dealii::ArrayView<const dealii::Point<dim>> &,
+                       Number)>
+        initial_states_;
+
     std::function<initial_precomputed_type(const dealii::Point<dim> &)>
         initial_precomputed_;
 
+    bool thread_safe_;
+    bool time_independent_;
+
     //@}
   };
 
@@ -6,7 +6,9 @@
 #pragma once
 
 #include "initial_values.h"
+#include "openmp.h"
 
+#include <deal.II/fe/fe_values.h>
 #include <deal.II/numerics/vector_tools.h>
 #include <deal.II/numerics/vector_tools.templates.h>
 
@@ -184,12 +186,41 @@ namespace ryujin
             return state;
           };
 
+          initial_states_ =
+              [this, &it](const dealii::ArrayView<state_type> &states,
+                          const dealii::ArrayView<const dealii::Point<dim>>
+                              &points,
+                          Number t) {
+                Assert(points.size() <= batch_size, ExcInternalError());
+
+                std::array<dealii::Point<dim>, batch_size> transformed_points;
+                for (unsigned int k = 0; k < points.size(); ++k)
+                  transformed_points[k] = affine_transform(
+                      initial_direction_, initial_position_, points[k]);
+
+                it->compute(states,
+                            ArrayView<const dealii::Point<dim>>(
+                                transformed_points.data(), points.size()),
+                            t);
+
+                const auto view =
+                    hyperbolic_system_->template view<dim, Number>();
+                for (auto &state : states)
+                  state = view.apply_galilei_transform(
+                      state, [&](const auto &momentum) {
+                        return affine_transform_vector(initial_direction_,
+                                                       momentum);
+                      });
+              };
+
           initial_precomputed_ = [this, &it](const dealii::Point<dim> &point) {
             const auto transformed_point =
                 affine_transform(initial_direction_, initial_position_, point);
             return it->initial_precomputations(transformed_point);
           };
 
+          thread_safe_ = it->thread_safe();
+          time_independent_ = it->time_independent();
           initialized = true;
           break;
         }
@@ -221,10 +252,65 @@ namespace ryujin
 
         return state;
       };
+
+      /* Drawing random numbers is not thread safe: */
+      thread_safe_ = false;
+
+      /* The perturbation is only applied for t = 0: */
+      time_independent_ = false;
+
+      initial_states_ = [this](const dealii::ArrayView<state_type> &states,
+                               const dealii::ArrayView<const dealii::Point<dim>>
+                                   &points,
+                               Number t) {
+        for (unsigned int k = 0; k < points.size(); ++k)
+          states[k] = initial_state_(points[k], t);
+      };
     }
   }
 
 
+  template <typename Description, int dim, typename Number>
+  std::vector<dealii::Point<dim>>
+  InitialValues<Description, dim, Number>::locally_owned_support_points() const
+  {
+    const auto &discretization = offline_data_->discretization();
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &partitioner = *offline_data_->scalar_partitioner();
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+
+    const Quadrature<dim> quadrature(
+        discretization.finite_element().get_unit_support_points());
+    FEValues<dim> fe_values(discretization.mapping(),
+                            discretization.finite_element(),
+                            quadrature,
+                            update_quadrature_points);
+
+    const unsigned int dofs_per_cell =
+        discretization.finite_element().dofs_per_cell;
+    std::vector<dealii::types::global_dof_index> local_dof_indices(
+        dofs_per_cell);
+
+    std::vector<dealii::Point<dim>> points(n_owned);
+
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
+
+      fe_values.reinit(cell);
+      cell->get_dof_indices(local_dof_indices);
+
+      for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+        const auto index = partitioner.global_to_local(local_dof_indices[j]);
+        if (index < n_owned)
+          points[index] = fe_values.quadrature_point(j);
+      }
+    }
+
+    return points;
+  }
+
+
   template <typename Description, int dim, typename Number>
   auto InitialValues<Description, dim, Number>::interpolate_hyperbolic_vector(
       Number t) const -> HyperbolicVector
@@ -236,20 +322,35 @@ namespace ryujin
 
     HyperbolicVector U;
     U.reinit(offline_data_->hyperbolic_vector_partitioner());
+    Vectors::set_blocked_range(U, *offline_data_);
 
-    using ScalarVector = typename OfflineData<dim, Number>::ScalarVector;
-
-    const auto callable = [&](const auto &p) { return initial_state(p, t); };
-
-    ScalarVector temp;
-    const auto scalar_partitioner = offline_data_->scalar_partitioner();
-    temp.reinit(scalar_partitioner);
+    const auto points = locally_owned_support_points();
+    const unsigned int n_owned = points.size();
 
-    for (unsigned int d = 0; d < problem_dimension; ++d) {
-      VectorTools::interpolate(offline_data_->dof_handler(),
-                               to_function<dim, Number>(callable, d),
-                               temp);
-      U.insert_component(temp, d);
+    /*
+     * Evaluate the initial state in batches of batch_size points. We
+     * only do so thread-parallel if the selected initial state is thread
+     * safe:
+     */
+    const auto interpolate = [&](const unsigned int i) {
+      const unsigned int n = std::min(batch_size, n_owned - i);
+      std::array<state_type, batch_size> states;
+      initial_states_(ArrayView<state_type>(states.data(), n),
+                      ArrayView<const dealii::Point<dim>>(points.data() + i, n),
+                      t);
+      for (unsigned int k = 0; k < n; ++k)
+        U.write_tensor(states[k], i + k);
+    };
+
+    if (thread_safe_) {
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; i += batch_size)
+        interpolate(i);
+      RYUJIN_PARALLEL_REGION_END
+    } else {
+      for (unsigned int i = 0; i < n_owned; i += batch_size)
+        interpolate(i);
     }
 
     U.update_ghost_values();
@@ -275,18 +376,22 @@ namespace ryujin
     if constexpr (n_initial_precomputed_values == 0)
       return precomputed;
 
-    using ScalarVector = typename OfflineData<dim, Number>::ScalarVector;
-
-    const auto callable = [&](const auto &p) { return initial_precomputed(p); };
-
-    ScalarVector temp;
-    temp.reinit(scalar_partitioner);
-
-    for (unsigned int d = 0; d < n_initial_precomputed_values; ++d) {
-      VectorTools::interpolate(offline_data_->dof_handler(),
-                               to_function<dim, Number>(callable, d),
-                               temp);
-      precomputed.insert_component(temp, d);
+    const auto points = locally_owned_support_points();
+    const unsigned int n_owned = points.size();
+
+    const auto interpolate = [&](const unsigned int i) {
+      precomputed.write_tensor(initial_precomputed(points[i]), i);
+    };
+
+    if (thread_safe_) {
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i)
+        interpolate(i);
+      RYUJIN_PARALLEL_REGION_END
+    } else {
+      for (unsigned int i = 0; i < n_owned; ++i)
+        interpolate(i);
     }
 
     precomputed.update_ghost_values();
@@ -0,0 +1,203 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A registry of execution variants ("knobs") of a compute kernel that
+   * can be switched at run time, together with a simple online
+   * autotuner. Every knob holds a list of named settings and a callback
+   * applying a setting. The knobs are tuned one after another (in the
+   * order of registration) with all other knobs kept at their currently
+   * selected setting: every setting is applied for one warm-up sample
+   * and @p n_samples timed samples, and the setting with the smallest
+   * timed sample is locked in. Intended use:
+   * ```
+   * kernel_variants.reinit(n_samples);
+   * kernel_variants.add("prefetch distance", {{"0", [&]() { ... }}, ...});
+   * // ...
+   * kernel_variants.start();
+   * // timed work
+   * kernel_variants.stop();
+   * ```
+   *
+   * The registry only measures wall time on the calling MPI rank, i.e.,
+   * the selection is made independently on every rank.
+   *
+   * @ingroup Miscellaneous
+   */
+  class KernelVariantRegistry
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * A named setting of a knob.
+     */
+    struct Setting {
+      std::string name;
+      std::function<void()> apply;
+    };
+
+    /**
+     * Remove all knobs and reset the autotuner. Every setting is timed
+     * for @p n_samples samples (after one warm-up sample).
+     */
+    void reinit(const unsigned int n_samples)
+    {
+      n_samples_ = std::max(1u, n_samples);
+      knobs_.clear();
+      knob_ = 0;
+      setting_ = 0;
+      sample_ = 0;
+      running_ = false;
+    }
+
+    /**
+     * Register a knob with name @p name and the given list of
+     * @p settings. Knobs with less than two settings are ignored.
+     */
+    void add(const std::string &name, std::vector<Setting> settings)
+    {
+      if (settings.size() < 2)
+        return;
+
+      Knob knob{name,
+                std::move(settings),
+                {},
+                std::numeric_limits<unsigned int>::max()};
+      knob.times.assign(knob.settings.size(),
+                        std::numeric_limits<double>::max());
+      knobs_.push_back(std::move(knob));
+    }
+
+    /**
+     * Return true if knobs have been registered.
+     */
+    bool empty() const
+    {
+      return knobs_.empty();
+    }
+
+    /**
+     * Return true once all knobs have been tuned and the fastest
+     * settings are locked in.
+     */
+    bool selected() const
+    {
+      return !knobs_.empty() && knob_ == knobs_.size();
+    }
+
+    /**
+     * Start a sample and apply the setting under consideration. A sample
+     * that was started but never stopped (for example because the timed
+     * work threw an exception) is discarded.
+     */
+    void start()
+    {
+      if (knob_ >= knobs_.size())
+        return;
+
+      if (sample_ == 0)
+        knobs_[knob_].settings[setting_].apply();
+
+      running_ = true;
+      start_ = clock::now();
+    }
+
+    /**
+     * Stop a sample, record the elapsed time and advance the autotuner.
+     */
+    void stop()
+    {
+      if (knob_ >= knobs_.size() || !running_)
+        return;
+
+      running_ = false;
+      const double time =
+          std::chrono::duration<double>(clock::now() - start_).count();
+
+      auto &knob = knobs_[knob_];
+
+      /* The first sample of every setting is a warm-up sample: */
+      if (sample_ > 0)
+        knob.times[setting_] = std::min(knob.times[setting_], time);
+
+      if (++sample_ <= n_samples_)
+        return;
+
+      sample_ = 0;
+      if (++setting_ < knob.settings.size())
+        return;
+
+      /* All settings timed, lock in the fastest one: */
+      const auto fastest = std::min_element(knob.times.begin(), //
+                                            knob.times.end());
+      knob.selected = std::distance(knob.times.begin(), fastest);
+      knob.settings[knob.selected].apply();
+
+      setting_ = 0;
+      ++knob_;
+    }
+
+    /**
+     * Print the selected setting (and the measured time relative to the
+     * slowest setting) of every knob, or the progress of the autotuner.
+     */
+    void print(std::ostream &output) const
+    {
+      if (knobs_.empty())
+        return;
+
+      output << "        [ kernel variants";
+      if (!selected()) {
+        output << ": autotuning (" << knob_ << "/" << knobs_.size()
+               << " knobs tuned) ]" << std::endl;
+        return;
+      }
+
+      for (const auto &knob : knobs_) {
+        const double slowest =
+            *std::max_element(knob.times.begin(), knob.times.end());
+        const double speedup = slowest / knob.times[knob.selected];
+        output << "\n          " << knob.name << ": "
+               << knob.settings[knob.selected].name << " ("
+               << std::setprecision(2) << std::fixed << speedup << "x)";
+      }
+      output << " ]" << std::endl;
+    }
+
+  private:
+    struct Knob {
+      std::string name;
+      std::vector<Setting> settings;
+      std::vector<double> times;
+      unsigned int selected;
+    };
+
+    std::vector<Knob> knobs_;
+
+    unsigned int n_samples_ = 1;
+    unsigned int knob_ = 0;
+    unsigned int setting_ = 0;
+    unsigned int sample_ = 0;
+
+    bool running_ = false;
+    clock::time_point start_;
+  };
+} // namespace ryujin
@@ -5,14 +5,28 @@
 
 #pragma once
 
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/partitioner.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/mapping.h>
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_tools.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
 namespace ryujin
 {
   /**
@@ -88,6 +102,164 @@ namespace ryujin
      */
     using dealii::DoFRenumbering::Cuthill_McKee;
 
+    /**
+     * Reorder all locally owned degrees of freedom along a Hilbert space
+     * filling curve through their support points. Compared to
+     * Cuthill_McKee() this improves the spatial locality of the
+     * (indirect) column accesses of a stencil on unstructured meshes and
+     * thus the cache reuse of gather operations.
+     *
+     * The renumbering only acts within the (contiguous) locally owned
+     * index range and thus can be followed by export_indices_first() and
+     * internal_range().
+     *
+     * @ingroup FiniteElement
+     */
+    template <int dim>
+    void hilbert_curve(dealii::DoFHandler<dim> &dof_handler,
+                       const dealii::Mapping<dim> &mapping)
+    {
+      using namespace dealii;
+
+      const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+      const auto n_locally_owned = locally_owned.n_elements();
+
+      /* The locally owned index range has to be contiguous */
+      Assert(locally_owned.is_contiguous() == true,
+             dealii::ExcMessage(
+                 "Need a contiguous set of locally owned indices."));
+
+      /* Offset to translate from global to local index range */
+      const auto offset = n_locally_owned != 0 ? *locally_owned.begin() : 0;
+
+#if DEAL_II_VERSION_GTE(9, 5, 0)
+      const auto support_points =
+          dealii::DoFTools::map_dofs_to_support_points(mapping, dof_handler);
+#else
+      std::map<types::global_dof_index, Point<dim>> support_points;
+      dealii::DoFTools::map_dofs_to_support_points(
+          mapping, dof_handler, support_points);
+#endif
+
+      std::vector<Point<dim>> points(n_locally_owned);
+      for (const auto &[index, point] : support_points)
+        if (locally_owned.is_element(index))
+          points[index - offset] = point;
+
+      /*
+       * Compute the position of every support point along the Hilbert
+       * curve (within the bounding box of all locally owned support
+       * points) and sort accordingly:
+       */
+
+      std::vector<std::pair<std::uint64_t, unsigned int>> keys;
+      keys.reserve(n_locally_owned);
+
+      if (n_locally_owned != 0) {
+        constexpr int bits_per_dim = 64 / dim;
+        const auto indices = Utilities::inverse_Hilbert_space_filling_curve(
+            points, bits_per_dim);
+        for (unsigned int i = 0; i < n_locally_owned; ++i)
+          keys.emplace_back(
+              Utilities::pack_integers<dim>(indices[i], bits_per_dim), i);
+      }
+
+      std::stable_sort(keys.begin(), keys.end());
+
+      std::vector<dealii::types::global_dof_index> new_order(n_locally_owned);
+      for (unsigned int k = 0; k < n_locally_owned; ++k)
+        new_order[keys[k].second] = offset + k;
+
+      dof_handler.renumber_dofs(new_order);
+    }
+
+    /**
+     * Reorder all locally owned degrees of freedom cell by cell: The
+     * locally owned cells are sorted along a Hilbert space filling curve
+     * through their centers and the degrees of freedom of every cell are
+     * numbered consecutively (in the order they are visited first). For a
+     * discontinuous ansatz this keeps the stencil of every row, which
+     * consists of the dense cell block and the face neighbors, in a small
+     * number of contiguous index ranges. (hilbert_curve() in contrast
+     * interleaves the degrees of freedom of neighboring cells that share
+     * a support point.)
+     *
+     * The renumbering only acts within the (contiguous) locally owned
+     * index range and thus can be followed by export_indices_first() and
+     * internal_range().
+     *
+     * @ingroup FiniteElement
+     */
+    template <int dim>
+    void cell_wise_hilbert_curve(dealii::DoFHandler<dim> &dof_handler)
+    {
+      using namespace dealii;
+
+      const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+      const auto n_locally_owned = locally_owned.n_elements();
+
+      /* The locally owned index range has to be contiguous */
+      Assert(locally_owned.is_contiguous() == true,
+             dealii::ExcMessage(
+                 "Need a contiguous set of locally owned indices."));
+
+      /* Offset to translate from global to local index range */
+      const auto offset = n_locally_owned != 0 ? *locally_owned.begin() : 0;
+
+      std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+      std::vector<Point<dim>> centers;
+      for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+        cells.push_back(cell);
+        centers.push_back(cell->center());
+      }
+
+      /*
+       * Compute the position of every cell center along the Hilbert curve
+       * and sort accordingly:
+       */
+
+      std::vector<std::pair<std::uint64_t, unsigned int>> keys;
+      keys.reserve(cells.size());
+
+      if (!cells.empty()) {
+        constexpr int bits_per_dim = 64 / dim;
+        const auto indices = Utilities::inverse_Hilbert_space_filling_curve(
+            centers, bits_per_dim);
+        for (unsigned int k = 0; k < cells.size(); ++k)
+          keys.emplace_back(
+              Utilities::pack_integers<dim>(indices[k], bits_per_dim), k);
+      }
+
+      std::stable_sort(keys.begin(), keys.end());
+
+      /* Number degrees of freedom in the order of first visit: */
+
+      std::vector<dealii::types::global_dof_index> new_order(
+          n_locally_owned, numbers::invalid_dof_index);
+      types::global_dof_index next = offset;
+
+      std::vector<types::global_dof_index> dof_indices;
+      for (const auto &[key, k] : keys) {
+        const auto &cell = cells[k];
+        dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(dof_indices);
+        for (const auto index : dof_indices) {
+          if (!locally_owned.is_element(index))
+            continue;
+          auto &new_index = new_order[index - offset];
+          if (new_index == numbers::invalid_dof_index)
+            new_index = next++;
+        }
+      }
+
+      /* Every locally owned degree of freedom lies on a locally owned cell: */
+      Assert(next == offset + n_locally_owned, dealii::ExcInternalError());
+
+      dof_handler.renumber_dofs(new_order);
+    }
+
     /**
      * Reorder all (strides of) locally internal indices that contain
      * export indices to the start of the index range.
@@ -369,6 +541,257 @@ namespace ryujin
       Assert(n_locally_internal % group_size == 0, ExcInternalError());
       return n_locally_internal;
     }
+
+    namespace internal
+    {
+      /**
+       * Call worker(chunk) for all chunks in [0, n_chunks) concurrently.
+       *
+       * @ingroup FiniteElement
+       */
+      template <typename Callable>
+      void chunk_loop(const unsigned int n_chunks, const Callable &worker)
+      {
+        if (n_chunks == 1) {
+          worker(0u);
+          return;
+        }
+
+        dealii::Threads::TaskGroup<void> tasks;
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+          tasks += dealii::Threads::new_task(
+              [&worker, chunk]() { worker(chunk); });
+        tasks.join_all();
+      }
+    } // namespace internal
+
+
+    /**
+     * Reorder indices in a single pass: This function combines
+     * export_indices_first() (with a group size of one), internal_range()
+     * and export_indices_first() (with a group size of @p group_size).
+     * The set of export indices is determined with a single exchange, and
+     * the final permutation is computed in a number of thread-parallel
+     * sweeps and applied with a single call to renumber_dofs(). For
+     * unconstrained problems the resulting numbering is the one of the
+     * three individual renumberings. With hanging node or periodicity
+     * constraints the row lengths seen by internal_range() depend on the
+     * preceding renumbering, and the numbering may differ.
+     *
+     * The row lengths are taken from the (temporary) sparsity pattern
+     * @p sparsity. Row lengths do not depend on the numbering of locally
+     * owned indices, except for the (numbering dependent) elimination of
+     * periodicity constraints, which is taken care of by
+     * inconsistent_strides_last().
+     *
+     * Returns the pair (n_locally_internal, n_export_indices).
+     *
+     * @ingroup FiniteElement
+     */
+    template <int dim>
+    std::pair<unsigned int, unsigned int>
+    internal_range_export_indices_first(
+        dealii::DoFHandler<dim> &dof_handler,
+        const dealii::DynamicSparsityPattern &sparsity,
+        const MPI_Comm &mpi_communicator,
+        const unsigned int group_size)
+    {
+      using namespace dealii;
+
+      const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+      const unsigned int n_locally_owned = locally_owned.n_elements();
+
+      /* The locally owned index range has to be contiguous */
+      Assert(locally_owned.is_contiguous() == true,
+             dealii::ExcMessage(
+                 "Need a contiguous set of locally owned indices."));
+
+      /* Offset to translate from global to local index range */
+      const auto offset = n_locally_owned != 0 ? *locally_owned.begin() : 0;
+
+      /*
+       * Determine all export indices. This is the only communication
+       * (performed by the constructor of the temporary partitioner):
+       */
+
+      IndexSet locally_relevant;
+      DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant);
+
+      Utilities::MPI::Partitioner partitioner(
+          locally_owned, locally_relevant, mpi_communicator);
+
+      std::vector<char> is_export(n_locally_owned, 0);
+      for (const auto &[first, last] : partitioner.import_indices())
+        std::fill(is_export.begin() + first, is_export.begin() + last, 1);
+
+      /* Visit all export indices first: */
+
+      std::vector<unsigned int> order(n_locally_owned);
+      std::iota(order.begin(), order.end(), 0u);
+      std::stable_partition(order.begin(), order.end(), [&](const auto i) {
+        return is_export[i] != 0;
+      });
+
+      const unsigned int n_chunks = std::max<std::size_t>(
+          1,
+          std::min<std::size_t>(MultithreadInfo::n_threads(),
+                                (n_locally_owned + 4095) / 4096));
+      const auto chunk_begin = [&](const unsigned int chunk) {
+        return static_cast<unsigned int>(std::size_t(n_locally_owned) *
+                                         chunk / n_chunks);
+      };
+
+      /*
+       * First sweep: Record the row length of every index in visiting
+       * order and count the number of indices per row length (the "bin")
+       * for every chunk:
+       */
+
+      const unsigned int n_bins = sparsity.max_entries_per_row() + 1;
+
+      std::vector<unsigned int> row_length(n_locally_owned);
+      std::vector<std::vector<unsigned int>> bin_offsets(
+          n_chunks, std::vector<unsigned int>(n_bins, 0));
+
+      internal::chunk_loop(n_chunks, [&](const unsigned int chunk) {
+        auto &counts = bin_offsets[chunk];
+        for (auto k = chunk_begin(chunk); k < chunk_begin(chunk + 1); ++k) {
+          row_length[k] = sparsity.row_length(offset + order[k]);
+          counts[row_length[k]]++;
+        }
+      });
+
+      /*
+       * Translate counts into offsets: Every bin is split into strides of
+       * group_size indices in visiting order. Full strides are enumerated
+       * consecutively over all bins, the remainder of all bins is written
+       * out after the internal range in the order of increasing row
+       * length.
+       */
+
+      std::vector<unsigned int> n_full(n_bins, 0);
+      std::vector<unsigned int> stride_offsets(n_bins, 0);
+      std::vector<unsigned int> remainder_offsets(n_bins, 0);
+
+      unsigned int n_strides = 0;
+      unsigned int n_remainder = 0;
+      for (unsigned int b = 0; b < n_bins; ++b) {
+        unsigned int n_bin = 0;
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk) {
+          const auto count = bin_offsets[chunk][b];
+          bin_offsets[chunk][b] = n_bin;
+          n_bin += count;
+        }
+
+        n_full[b] = n_bin / group_size * group_size;
+        stride_offsets[b] = n_strides;
+        remainder_offsets[b] = n_remainder;
+        n_strides += n_bin / group_size;
+        n_remainder += n_bin - n_full[b];
+      }
+
+      const unsigned int n_locally_internal = n_strides * group_size;
+      Assert(n_locally_internal + n_remainder == n_locally_owned,
+             ExcInternalError());
+
+      /*
+       * Second sweep: Compute the position of every index within its bin
+       * and record for every full stride whether it contains an export
+       * index. Export indices are visited first, a stride thus contains
+       * an export index if and only if its first index is one.
+       */
+
+      std::vector<unsigned int> position(n_locally_owned);
+      std::vector<char> stride_is_export(n_strides, 0);
+
+      internal::chunk_loop(n_chunks, [&](const unsigned int chunk) {
+        auto positions = bin_offsets[chunk];
+        for (auto k = chunk_begin(chunk); k < chunk_begin(chunk + 1); ++k) {
+          const auto b = row_length[k];
+          const auto p = positions[b]++;
+          position[k] = p;
+          if (p < n_full[b] && p % group_size == 0)
+            stride_is_export[stride_offsets[b] + p / group_size] =
+                is_export[order[k]];
+        }
+      });
+
+      /*
+       * Third sweep: A stride is complete when its last index is visited.
+       * Strides are written out in the order of completion, all strides
+       * containing an export index first. Count completed strides per
+       * chunk:
+       */
+
+      std::vector<std::array<unsigned int, 2>> completed(n_chunks);
+
+      const auto stride_of = [&](const unsigned int k) {
+        const auto b = row_length[k];
+        return stride_offsets[b] + position[k] / group_size;
+      };
+
+      const auto completes_stride = [&](const unsigned int k) {
+        const auto b = row_length[k];
+        return position[k] < n_full[b] &&
+               position[k] % group_size == group_size - 1;
+      };
+
+      internal::chunk_loop(n_chunks, [&](const unsigned int chunk) {
+        completed[chunk] = {0, 0};
+        for (auto k = chunk_begin(chunk); k < chunk_begin(chunk + 1); ++k)
+          if (completes_stride(k))
+            completed[chunk][stride_is_export[stride_of(k)] ? 0 : 1]++;
+      });
+
+      unsigned int n_export_strides = 0;
+      for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+        n_export_strides += completed[chunk][0];
+
+      std::array<unsigned int, 2> running_slot = {0, n_export_strides};
+      for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+        for (unsigned int e = 0; e < 2; ++e) {
+          const auto count = completed[chunk][e];
+          completed[chunk][e] = running_slot[e];
+          running_slot[e] += count;
+        }
+
+      Assert(running_slot[1] == n_strides, ExcInternalError());
+
+      /* Fourth sweep: assign the final slot of every stride: */
+
+      std::vector<unsigned int> stride_slot(n_strides);
+
+      internal::chunk_loop(n_chunks, [&](const unsigned int chunk) {
+        auto slots = completed[chunk];
+        for (auto k = chunk_begin(chunk); k < chunk_begin(chunk + 1); ++k)
+          if (completes_stride(k)) {
+            const auto stride = stride_of(k);
+            stride_slot[stride] = slots[stride_is_export[stride] ? 0 : 1]++;
+          }
+      });
+
+      /* Fifth sweep: assemble the permutation: */
+
+      std::vector<dealii::types::global_dof_index> new_order(n_locally_owned);
+
+      internal::chunk_loop(n_chunks, [&](const unsigned int chunk) {
+        for (auto k = chunk_begin(chunk); k < chunk_begin(chunk + 1); ++k) {
+          const auto b = row_length[k];
+          const auto p = position[k];
+          const auto index =
+              p < n_full[b]
+                  ? stride_slot[stride_of(k)] * group_size + p % group_size
+                  : n_locally_internal + remainder_offsets[b] + p - n_full[b];
+          new_order[order[k]] = offset + index;
+        }
+      });
+
+      dof_handler.renumber_dofs(new_order);
+
+      const unsigned int n_export_indices = n_export_strides * group_size;
+      Assert(n_export_indices <= n_locally_internal, ExcInternalError());
+      return {n_locally_internal, n_export_indices};
+    }
   } // namespace DoFRenumbering
 
 
@@ -393,10 +816,121 @@ namespace ryujin
     using dealii::DoFTools::make_sparsity_pattern;
 
 
+    namespace internal
+    {
+      /**
+       * Call worker(cell, dof_indices, sparsity) for all non-artificial
+       * (i.e., locally owned and ghost layer) cells of @p dof_handler,
+       * where dof_indices holds the degrees of freedom of the cell. The
+       * cells are split into contiguous chunks that are processed
+       * concurrently. Each chunk populates its own DynamicSparsityPattern
+       * that is restricted to the rows the chunk touches (the degrees of
+       * freedom of its cells and the entries they are constrained to).
+       * All patterns are merged into @p dsp at the end.
+       *
+       * @ingroup FiniteElement
+       */
+      template <int dim, typename Number, typename SPARSITY, typename Callable>
+      void parallel_cell_loop(
+          const dealii::DoFHandler<dim> &dof_handler,
+          SPARSITY &dsp,
+          const dealii::AffineConstraints<Number> &affine_constraints,
+          const Callable &worker)
+      {
+        using dof_type = dealii::types::global_dof_index;
+        using Iterator = typename dealii::DoFHandler<dim>::active_cell_iterator;
+
+        const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+
+        std::vector<Iterator> cells;
+        for (auto cell : dof_handler.active_cell_iterators())
+          if (!cell->is_artificial())
+            cells.push_back(cell);
+
+        const unsigned int n_chunks = std::max<std::size_t>(
+            1, std::min<std::size_t>(dealii::MultithreadInfo::n_threads(),
+                                     cells.size()));
+
+        if (n_chunks == 1) {
+          std::vector<dof_type> dof_indices(dofs_per_cell);
+          for (const auto &cell : cells) {
+            cell->get_dof_indices(dof_indices);
+            worker(cell, dof_indices, dsp);
+          }
+          return;
+        }
+
+        std::vector<dealii::DynamicSparsityPattern> local_dsp(n_chunks);
+
+        const auto process_chunk = [&](const unsigned int chunk) {
+          const auto first = cells.begin() + cells.size() * chunk / n_chunks;
+          const auto last =
+              cells.begin() + cells.size() * (chunk + 1) / n_chunks;
+
+          std::vector<dof_type> dof_indices(dofs_per_cell);
+
+          std::vector<dof_type> rows;
+          for (auto it = first; it != last; ++it) {
+            (*it)->get_dof_indices(dof_indices);
+            for (const auto i : dof_indices) {
+              rows.push_back(i);
+              if (affine_constraints.is_constrained(i))
+                for (const auto &entry :
+                     *affine_constraints.get_constraint_entries(i))
+                  rows.push_back(entry.first);
+            }
+          }
+          std::sort(rows.begin(), rows.end());
+          rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+          dealii::IndexSet row_set(dsp.n_rows());
+          row_set.add_indices(rows.begin(), rows.end());
+          row_set.compress();
+
+          auto &sparsity = local_dsp[chunk];
+          sparsity.reinit(dsp.n_rows(), dsp.n_cols(), row_set);
+
+          for (auto it = first; it != last; ++it) {
+            (*it)->get_dof_indices(dof_indices);
+            worker(*it, dof_indices, sparsity);
+          }
+        };
+
+        dealii::Threads::TaskGroup<void> tasks;
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+          tasks += dealii::Threads::new_task(
+              [&process_chunk, chunk]() { process_chunk(chunk); });
+        tasks.join_all();
+
+        /*
+         * Merge: All thread-local rows are sorted and free of duplicates,
+         * and chunks of contiguous cells only overlap in a thin layer of
+         * rows. Release every local pattern as soon as it is merged to
+         * keep the memory footprint low.
+         */
+
+        std::vector<dof_type> columns;
+        for (auto &sparsity : local_dsp) {
+          for (const auto row : sparsity.row_index_set()) {
+            const auto row_length = sparsity.row_length(row);
+            if (row_length == 0)
+              continue;
+            columns.resize(row_length);
+            for (unsigned int k = 0; k < row_length; ++k)
+              columns[k] = sparsity.column_number(row, k);
+            dsp.add_entries(row, columns.begin(), columns.end(), true);
+          }
+          sparsity.reinit(0, 0);
+        }
+      }
+    } // namespace internal
+
+
     /**
      * Given a @p dof_handler, and constraints @p affine_constraints this
      * function creates an extended sparsity pattern that also includes
-     * locally relevant to locally relevant couplings.
+     * locally relevant to locally relevant couplings. The cell loop is
+     * executed in parallel, see internal::parallel_cell_loop().
      *
      * @ingroup FiniteElement
      */
@@ -407,18 +941,15 @@ namespace ryujin
         const dealii::AffineConstraints<Number> &affine_constraints,
         bool keep_constrained)
     {
-      const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
-      std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
-
-      for (auto cell : dof_handler.active_cell_iterators()) {
-        /* iterate over locally owned cells and the ghost layer */
-        if (cell->is_artificial())
-          continue;
-
-        cell->get_dof_indices(dof_indices);
-        affine_constraints.add_entries_local_to_global(
-            dof_indices, dsp, keep_constrained);
-      }
+      /* iterate over locally owned cells and the ghost layer */
+      internal::parallel_cell_loop(
+          dof_handler,
+          dsp,
+          affine_constraints,
+          [&](const auto & /*cell*/, const auto &dof_indices, auto &sparsity) {
+            affine_constraints.add_entries_local_to_global(
+                dof_indices, sparsity, keep_constrained);
+          });
     }
 
 
@@ -426,7 +957,8 @@ namespace ryujin
      * Given a @p dof_handler, and constraints @p affine_constraints this
      * function creates an extended sparsity pattern for the discontinuous
      * Galerkin formulation that also includes locally relevant to locally
-     * relevant couplings.
+     * relevant couplings. The cell loop is executed in parallel, see
+     * internal::parallel_cell_loop().
      *
      * @ingroup FiniteElement
      */
@@ -442,71 +974,71 @@ namespace ryujin
 
       const auto &fe = dof_handler.get_fe();
       const unsigned int dofs_per_cell = fe.dofs_per_cell;
-      std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
-      std::vector<dealii::types::global_dof_index> neighbor_dof_indices(
-          dofs_per_cell);
-
-      /*
-       * We collect all coupling dof indices on a face and store the result
-       * in a vector.
-       */
-      std::vector<dealii::types::global_dof_index> coupling_indices;
-      std::vector<dealii::types::global_dof_index> neighbor_coupling_indices;
 
       /* we iterate over locally owned cells and the ghost layer */
-      for (auto cell : dof_handler.active_cell_iterators()) {
-        if (cell->is_artificial())
-          continue;
-
-        cell->get_dof_indices(dof_indices);
-
-        affine_constraints.add_entries_local_to_global(
-            dof_indices, dsp, keep_constrained);
-
-        for (const auto f_index : cell->face_indices()) {
-          const auto &face = cell->face(f_index);
-
-          /* Skip faces without neighbors... */
-          const bool has_neighbor =
-              !face->at_boundary() || cell->has_periodic_neighbor(f_index);
-          if (!has_neighbor)
-            continue;
-
-          /* Avoid artificial cells: */
-          const auto neighbor_cell =
-              cell->neighbor_or_periodic_neighbor(f_index);
-          if (neighbor_cell->is_artificial())
-            continue;
-
-          const unsigned int f_index_neighbor =
-              cell->has_periodic_neighbor(f_index)
-                  ? cell->periodic_neighbor_of_periodic_neighbor(f_index)
-                  : cell->neighbor_of_neighbor(f_index);
-
-          neighbor_cell->get_dof_indices(neighbor_dof_indices);
-
-          /*
-           * Construct all couplings between current and neighbor cell with
-           * DoFs located at the boundary:
-           */
-
-          coupling_indices.resize(0);
-          for (unsigned int i = 0; i < dofs_per_cell; ++i)
-            if (fe.has_support_on_face(i, f_index))
-              coupling_indices.push_back(dof_indices[i]);
-
-          neighbor_coupling_indices.resize(0);
-          for (unsigned int j = 0; j < dofs_per_cell; ++j)
-            if (fe.has_support_on_face(j, f_index_neighbor))
-              neighbor_coupling_indices.push_back(neighbor_dof_indices[j]);
-
-          affine_constraints.add_entries_local_to_global(
-              coupling_indices,
-              neighbor_coupling_indices,
-              dsp,
-              keep_constrained);
-        }
-      }
+      internal::parallel_cell_loop(
+          dof_handler,
+          dsp,
+          affine_constraints,
+          [&](const auto &cell, const auto &dof_indices, auto &sparsity) {
+            affine_constraints.add_entries_local_to_global(
+                dof_indices, sparsity, keep_constrained);
+
+            std::vector<dealii::types::global_dof_index> neighbor_dof_indices(
+                dofs_per_cell);
+
+            /*
+             * We collect all coupling dof indices on a face and store the
+             * result in a vector.
+             */
+            std::vector<dealii::types::global_dof_index> coupling_indices;
+            std::vector<dealii::types::global_dof_index>
+                neighbor_coupling_indices;
+
+            for (const auto f_index : cell->face_indices()) {
+              const auto &face = cell->face(f_index);
+
+              /* Skip faces without neighbors... */
+              const bool has_neighbor =
+                  !face->at_boundary() || cell->has_periodic_neighbor(f_index);
+              if (!has_neighbor)
+                continue;
+
+              /* Avoid artificial cells: */
+              const auto neighbor_cell =
+                  cell->neighbor_or_periodic_neighbor(f_index);
+              if (neighbor_cell->is_artificial())
+                continue;
+
+              const unsigned int f_index_neighbor =
+                  cell->has_periodic_neighbor(f_index)
+                      ? cell->periodic_neighbor_of_periodic_neighbor(f_index)
+                      : cell->neighbor_of_neighbor(f_index);
+
+              neighbor_cell->get_dof_indices(neighbor_dof_indices);
+
+              /*
+               * Construct all couplings between current and neighbor cell
+               * with DoFs located at the boundary:
+               */
+
+              coupling_indices.resize(0);
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                if (fe.has_support_on_face(i, f_index))
+                  coupling_indices.push_back(dof_indices[i]);
+
+              neighbor_coupling_indices.resize(0);
+              for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                if (fe.has_support_on_face(j, f_index_neighbor))
+                  neighbor_coupling_indices.push_back(neighbor_dof_indices[j]);
+
+              affine_constraints.add_entries_local_to_global(
+                  coupling_indices,
+                  neighbor_coupling_indices,
+                  sparsity,
+                  keep_constrained);
+            }
+          });
     }
 
 
@@ -5,8 +5,11 @@
 
 #include <compile_time_options.h>
 
+#include "allocation_counter.h"
 #include "equation_dispatch.h"
+#include "hardware_counters.h"
 #include "introspection.h"
+#include "timeline_tracer.h"
 
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/multithread_info.h>
@@ -16,7 +19,14 @@
 #include <omp.h>
 #endif
 
+#if defined(COUNT_ALLOCATIONS) && defined(__linux__)
+#include <dlfcn.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
+#include <new>
 
 /**
  * Change rounding mode on X86-64 architecture: Denormals are flushed to
@@ -36,6 +46,99 @@ void flush_denormals_to_zero()
 }
 
 
+#ifdef COUNT_ALLOCATIONS
+/*
+ * Return aligned storage without counting it, i.e., by calling the
+ * aligned_alloc() of the C library (on Linux we interpose aligned_alloc()
+ * below).
+ */
+static void *uncounted_aligned_alloc(std::size_t alignment, std::size_t size)
+{
+#ifdef __linux__
+  using function_type = void *(std::size_t, std::size_t);
+  static const auto next =
+      reinterpret_cast<function_type *>(dlsym(RTLD_NEXT, "aligned_alloc"));
+  return next(alignment, size);
+#else
+  return std::aligned_alloc(alignment, size);
+#endif
+}
+
+
+/*
+ * Replace the global allocation functions in order to count all heap
+ * allocations, see AllocationCounter. The array and nothrow variants
+ * forward to these functions.
+ */
+
+void *operator new(std::size_t size)
+{
+  ryujin::AllocationCounter::increment();
+  if (void *pointer = std::malloc(size == 0 ? 1 : size))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+  ryujin::AllocationCounter::increment();
+  const auto align = static_cast<std::size_t>(alignment);
+  /* std::aligned_alloc requires a multiple of the alignment: */
+  const auto padded_size = std::max(align, (size + align - 1) / align * align);
+  if (void *pointer = uncounted_aligned_alloc(align, padded_size))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+#ifdef __linux__
+/*
+ * Also count the aligned allocations of the C library that bypass
+ * operator new, i.e., the storage of dealii::AlignedVector (allocated
+ * with posix_memalign()) and of the MemoryPool (allocated with
+ * aligned_alloc()). We forward to the next definition in the symbol
+ * lookup order, i.e., the one of the C library. Plain malloc() calls are
+ * not counted.
+ */
+
+extern "C" int
+posix_memalign(void **pointer, std::size_t alignment, std::size_t size) noexcept
+{
+  using function_type = int(void **, std::size_t, std::size_t);
+  static const auto next =
+      reinterpret_cast<function_type *>(dlsym(RTLD_NEXT, "posix_memalign"));
+  ryujin::AllocationCounter::increment();
+  return next(pointer, alignment, size);
+}
+
+extern "C" void *aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+{
+  ryujin::AllocationCounter::increment();
+  return uncounted_aligned_alloc(alignment, size);
+}
+#endif
+#endif
+
+
 /**
  * Set up thread pools and obey thread limits:
  */
@@ -73,15 +176,31 @@ int main(int argc, char *argv[])
   LSAN_ENABLE
 
   LIKWID_INIT;
+  ryujin::HardwareCounters::instance().initialize();
+  ryujin::TimelineTracer::instance().initialize();
 
   if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
     std::cout << "[INFO] initiating flux capacitor" << std::endl;
   }
 
+  /*
+   * An optional leading "--tune" argument benchmarks runtime
+   * configurations instead of running the computation, see
+   * EquationDispatch::dispatch().
+   */
+  const bool tune = argc > 1 && std::string(argv[1]) == "--tune";
+  if (tune) {
+    /* Drop the argument but keep the executable name in argv[0]: */
+    argv[1] = argv[0];
+    --argc;
+    ++argv;
+  }
+
   if (argc > 2) {
     if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
       std::cout << "[ERROR] Invalid number of parameters. At most one argument "
-                << "supported which has to be a parameter file." << std::endl;
+                << "supported which has to be a parameter file (optionally "
+                << "preceded by \"--tune\")." << std::endl;
     }
 
     LIKWID_CLOSE;
@@ -125,7 +244,7 @@ int main(int argc, char *argv[])
 
   {
     ryujin::EquationDispatch equation_dispatch;
-    equation_dispatch.dispatch(parameter_file, mpi_communicator);
+    equation_dispatch.dispatch(parameter_file, mpi_communicator, tune);
   }
 
   LIKWID_CLOSE;
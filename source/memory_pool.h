@@ -0,0 +1,410 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ryujin
+{
+  /**
+   * A process wide pool of large memory blocks. Requests are rounded up
+   * to size classes (with a spacing of a quarter power of two) and
+   * released blocks are cached instead of being returned to the system.
+   * A subsequent request of the same size class, for example after a
+   * mesh adaptation cycle with a slightly different number of degrees
+   * of freedom, is served from the cache. The cached blocks are not
+   * returned to the system, which avoids repeated mmap/munmap calls. The
+   * NUMA placement of their pages is that of the previous owner; users
+   * of the pool still have to first touch a recycled block for their own
+   * thread partition.
+   *
+   * The pool is disabled by default and enabled with the "memory pool
+   * cache size" parameter of the TimeLoop. If disabled, all requests are
+   * forwarded to the system allocator.
+   *
+   * @ingroup Miscellaneous
+   */
+  class MemoryPool
+  {
+  public:
+    /**
+     * Requests smaller than this size (in bytes) are not pooled.
+     */
+    static constexpr std::size_t min_pooled_size = 1 << 20;
+
+    /**
+     * Return a reference to the pool. The pool is intentionally never
+     * destroyed so that it outlives all static objects holding pooled
+     * memory.
+     */
+    static MemoryPool &instance()
+    {
+      static MemoryPool *pool = new MemoryPool;
+      return *pool;
+    }
+
+    /**
+     * Enable the pool and limit the total size of cached (unused) blocks
+     * to @p cache_size bytes. A size of zero disables the pool and
+     * releases all cached blocks.
+     */
+    void set_cache_size(const std::size_t cache_size)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache_size_ = cache_size;
+      trim();
+    }
+
+    /**
+     * Return true if the pool is enabled.
+     */
+    bool enabled() const
+    {
+      return cache_size_.load(std::memory_order_relaxed) != 0;
+    }
+
+    /**
+     * Return the size class (in bytes) for a request of @p size bytes.
+     */
+    static std::size_t size_class(const std::size_t size)
+    {
+      if (size < min_pooled_size)
+        return (size + alignment - 1) / alignment * alignment;
+
+      std::size_t power = min_pooled_size;
+      while (2 * power <= size)
+        power *= 2;
+
+      for (unsigned int k = 4; k < 8; ++k)
+        if (power / 4 * k >= size)
+          return power / 4 * k;
+
+      return 2 * power;
+    }
+
+    /**
+     * Return a block of at least @p size bytes together with its
+     * capacity. The flag @p recycled is set to true if the block was
+     * served from the cache.
+     */
+    std::pair<void *, std::size_t> allocate(const std::size_t size,
+                                            bool &recycled)
+    {
+      recycled = false;
+      if (size == 0)
+        return {nullptr, 0};
+
+      const std::size_t capacity =
+          enabled() ? size_class(size)
+                    : (size + alignment - 1) / alignment * alignment;
+
+      if (enabled() && capacity >= min_pooled_size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        /* Accept a cached block with at most one size class of slack: */
+        const auto it = std::find_if(
+            cache_.begin(), cache_.end(), [&](const auto &block) {
+              return block.second >= capacity &&
+                     block.second <= size_class(capacity + 1);
+            });
+        if (it != cache_.end()) {
+          const auto block = *it;
+          cache_.erase(it);
+          n_cached_bytes_ -= block.second;
+          recycled = true;
+          return block;
+        }
+      }
+
+      void *pointer = std::aligned_alloc(alignment, capacity);
+      if (pointer == nullptr)
+        throw std::bad_alloc();
+      return {pointer, capacity};
+    }
+
+    /**
+     * Return a block obtained by allocate() with capacity @p capacity to
+     * the pool.
+     */
+    void deallocate(void *pointer, const std::size_t capacity)
+    {
+      if (pointer == nullptr)
+        return;
+
+      if (!enabled() || capacity < min_pooled_size) {
+        std::free(pointer);
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache_.emplace_back(pointer, capacity);
+      n_cached_bytes_ += capacity;
+      trim();
+    }
+
+    /**
+     * Return the total size (in bytes) of all cached blocks.
+     */
+    std::size_t n_cached_bytes() const
+    {
+      return n_cached_bytes_;
+    }
+
+  private:
+    static constexpr std::size_t alignment = 64;
+
+    MemoryPool() = default;
+
+    /**
+     * Release the oldest cached blocks until the cache size limit is
+     * met. Has to be called with the mutex locked.
+     */
+    void trim()
+    {
+      while (!cache_.empty() && n_cached_bytes_ > cache_size_) {
+        std::free(cache_.front().first);
+        n_cached_bytes_ -= cache_.front().second;
+        cache_.pop_front();
+      }
+    }
+
+    std::mutex mutex_;
+
+    /*
+     * Both sizes are only modified with the mutex locked but read
+     * without it by enabled() and n_cached_bytes():
+     */
+    std::atomic<std::size_t> cache_size_ = 0;
+    std::atomic<std::size_t> n_cached_bytes_ = 0;
+    std::deque<std::pair<void *, std::size_t>> cache_;
+  };
+
+
+  /**
+   * A minimal replacement of dealii::AlignedVector for trivially
+   * copyable types whose storage is obtained from the MemoryPool. Only
+   * the subset of the interface used for the large data arrays of
+   * SparseMatrixSIMD and ColocatedVector is provided.
+   *
+   * In contrast to dealii::AlignedVector a resize() that fits into the
+   * capacity of the current block (which is rounded up to a size class
+   * if the pool is enabled) never reallocates.
+   *
+   * The storage can also be replaced by an external memory block that is
+   * not owned by the vector, see set_external_storage().
+   *
+   * @ingroup Miscellaneous
+   */
+  template <typename T>
+  class PooledVector
+  {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "PooledVector only supports trivially copyable types");
+
+  public:
+    PooledVector() = default;
+
+    PooledVector(const PooledVector &other)
+    {
+      *this = other;
+    }
+
+    PooledVector(PooledVector &&other) noexcept
+    {
+      swap(other);
+    }
+
+    PooledVector &operator=(const PooledVector &other)
+    {
+      if (this != &other) {
+        resize_fast(other.size_);
+        if (size_ != 0)
+          std::memcpy(data_, other.data_, size_ * sizeof(T));
+      }
+      return *this;
+    }
+
+    PooledVector &operator=(PooledVector &&other) noexcept
+    {
+      swap(other);
+      return *this;
+    }
+
+    ~PooledVector()
+    {
+      if (!external_)
+        MemoryPool::instance().deallocate(data_, capacity_ * sizeof(T));
+    }
+
+    /**
+     * Change the size of the vector to @p new_size elements without
+     * initializing new elements. Existing elements are preserved.
+     */
+    void resize_fast(const std::size_t new_size)
+    {
+      if (new_size <= capacity_ && !external_) {
+        /* Keep the block unless it is more than a size class too large: */
+        const auto bytes = new_size * sizeof(T);
+        if (!MemoryPool::instance().enabled() ||
+            capacity_ * sizeof(T) <=
+                MemoryPool::size_class(MemoryPool::size_class(bytes) + 1)) {
+          size_ = new_size;
+          recycled_ = MemoryPool::instance().enabled();
+          return;
+        }
+      }
+
+      auto &pool = MemoryPool::instance();
+      bool recycled;
+      const auto [pointer, bytes] =
+          pool.allocate(new_size * sizeof(T), recycled);
+
+      T *new_data = static_cast<T *>(pointer);
+      const auto n_preserved = std::min(size_, new_size);
+      if (n_preserved != 0)
+        std::memcpy(new_data, data_, n_preserved * sizeof(T));
+
+      if (!external_)
+        pool.deallocate(data_, capacity_ * sizeof(T));
+      data_ = new_data;
+      size_ = new_size;
+      capacity_ = bytes / sizeof(T);
+      recycled_ = recycled;
+      external_ = false;
+    }
+
+    /**
+     * Change the size of the vector to @p new_size elements. Existing
+     * elements are preserved, new elements are set to T().
+     */
+    void resize(const std::size_t new_size)
+    {
+      const auto old_size = std::min(size_, new_size);
+      resize_fast(new_size);
+      std::fill(data_ + old_size, data_ + size_, T());
+    }
+
+    /**
+     * Return true if the current block was reused (either in place, or
+     * from the cache of the MemoryPool) instead of freshly allocated
+     * from the system.
+     *
+     * @note A reused block has already been touched, but there is no
+     * guarantee that the NUMA placement of its pages matches the thread
+     * partition of the new data structure. Callers that rely on a
+     * specific placement still have to perform a first touch.
+     */
+    bool recycled() const
+    {
+      return recycled_;
+    }
+
+    /**
+     * Release the current block and refer to the external memory block
+     * @p pointer holding size() elements instead. The external block is
+     * not owned by the vector and has to outlive it (or the next
+     * reallocation). Resizing the vector, or assigning to it, always
+     * moves the vector back to a block of its own.
+     */
+    void set_external_storage(T *pointer)
+    {
+      if (!external_)
+        MemoryPool::instance().deallocate(data_, capacity_ * sizeof(T));
+      data_ = pointer;
+      capacity_ = size_;
+      recycled_ = false;
+      external_ = true;
+    }
+
+    /**
+     * Return true if the vector refers to an external memory block.
+     */
+    bool external() const
+    {
+      return external_;
+    }
+
+    void swap(PooledVector &other) noexcept
+    {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(recycled_, other.recycled_);
+      std::swap(external_, other.external_);
+    }
+
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    T *data()
+    {
+      return data_;
+    }
+
+    const T *data() const
+    {
+      return data_;
+    }
+
+    T *begin()
+    {
+      return data_;
+    }
+
+    const T *begin() const
+    {
+      return data_;
+    }
+
+    T *end()
+    {
+      return data_ + size_;
+    }
+
+    const T *end() const
+    {
+      return data_ + size_;
+    }
+
+    T &operator[](const std::size_t index)
+    {
+      AssertIndexRange(index, size_);
+      return data_[index];
+    }
+
+    const T &operator[](const std::size_t index) const
+    {
+      AssertIndexRange(index, size_);
+      return data_[index];
+    }
+
+    std::size_t memory_consumption() const
+    {
+      return sizeof(*this) + (external_ ? 0 : capacity_ * sizeof(T));
+    }
+
+  private:
+    T *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+    bool recycled_ = false;
+    bool external_ = false;
+  };
+} // namespace ryujin
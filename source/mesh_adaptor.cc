@@ -13,4 +13,10 @@ namespace ryujin
   template class MeshAdaptor<Description, 2, NUMBER>;
   template class MeshAdaptor<Description, 3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class MeshAdaptor<Description, 1, float>;
+  template class MeshAdaptor<Description, 2, float>;
+  template class MeshAdaptor<Description, 3, float>;
+#endif
+
 } /* namespace ryujin */
@@ -10,7 +10,12 @@
 
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/grid/cell_id.h>
 
+#include <boost/signals2.hpp>
+
+#include <future>
+#include <map>
 #include <random>
 
 namespace ryujin
@@ -37,6 +42,30 @@ namespace ryujin
      * Perform local refinement and coarsening based on Kelly error estimator.
      */
     kelly_estimator,
+
+    /**
+     * Perform local refinement and coarsening based on the smoothness
+     * indicator alpha_i computed by the HyperbolicModule in the last
+     * time step. The indicator of a cell is the maximum of alpha_i over
+     * all degrees of freedom of the cell. This strategy requires no
+     * additional evaluation of the state.
+     */
+    smoothness_indicator,
+
+    /**
+     * Perform local refinement and coarsening based on a stencil-based
+     * gradient jump indicator. For every quantity selected with the
+     * "kelly estimator: quantities" option a lumped gradient
+     * g_i = m_i^{-1} sum_j c_ij q_j is reconstructed at every degree of
+     * freedom. The indicator eta_i = sum_j |c_ij| |g_j - g_i| then
+     * measures the jump of the reconstructed gradient over the stencil,
+     * similarly to the face jumps of the Kelly error estimator. The
+     * indicator of a cell is the maximum of eta_i over all degrees of
+     * freedom of the cell. The indicator is computed with the vectorized
+     * and thread parallel stencil loops of the HyperbolicModule and does
+     * not require any quadrature.
+     */
+    gradient_indicator,
   };
 
   /**
@@ -56,6 +85,15 @@ namespace ryujin
      * refinement make up for a certain fraction of the total "error".
      */
     fixed_fraction,
+    /**
+     * Refine and coarsen a number of cells such that the global number of
+     * degrees of freedom after mesh adaptation approximately matches a
+     * prescribed target. The coarsening fraction is kept fixed and the
+     * refinement fraction is chosen accordingly. If the target lies below
+     * the current number of degrees of freedom, no cells are refined and
+     * the coarsening fraction is increased instead.
+     */
+    fixed_dof_count,
   };
 
   /**
@@ -73,6 +111,17 @@ namespace ryujin
      * Perform a mesh adaptation cycle at every nth simulation cycle.
      */
     simulation_cycle,
+
+    /**
+     * Perform a mesh adaptation cycle once the smoothness indicator
+     * alpha_i has drifted away from its state at the last mesh
+     * adaptation, i.e., once the relative l1 difference of the
+     * indicators of all locally owned degrees of freedom exceeds a
+     * threshold. Features that move out of the refined region cause
+     * such a drift, whereas the mesh is left untouched as long as they
+     * stay within it. The drift is measured every nth simulation cycle.
+     */
+    indicator_drift,
   };
 } // namespace ryujin
 
@@ -81,18 +130,25 @@ DECLARE_ENUM(
     ryujin::AdaptationStrategy,
     LIST({ryujin::AdaptationStrategy::global_refinement, "global refinement"},
          {ryujin::AdaptationStrategy::random_adaptation, "random adaptation"},
-         {ryujin::AdaptationStrategy::kelly_estimator, "kelly estimator"}, ));
+         {ryujin::AdaptationStrategy::kelly_estimator, "kelly estimator"},
+         {ryujin::AdaptationStrategy::smoothness_indicator,
+          "smoothness indicator"},
+         {ryujin::AdaptationStrategy::gradient_indicator,
+          "gradient indicator"}, ));
 
 DECLARE_ENUM(ryujin::MarkingStrategy,
              LIST({ryujin::MarkingStrategy::fixed_number, "fixed number"},
-                  {ryujin::MarkingStrategy::fixed_fraction,
-                   "fixed fraction"}, ));
+                  {ryujin::MarkingStrategy::fixed_fraction, "fixed fraction"},
+                  {ryujin::MarkingStrategy::fixed_dof_count,
+                   "fixed dof count"}, ));
 
 DECLARE_ENUM(ryujin::TimePointSelectionStrategy,
              LIST({ryujin::TimePointSelectionStrategy::fixed_time_points,
                    "fixed time points"},
                   {ryujin::TimePointSelectionStrategy::simulation_cycle,
-                   "simulation cycle"}, ));
+                   "simulation cycle"},
+                  {ryujin::TimePointSelectionStrategy::indicator_drift,
+                   "indicator drift"}, ));
 #endif
 
 namespace ryujin
@@ -140,7 +196,7 @@ namespace ryujin
                 const HyperbolicSystem &hyperbolic_system,
                 const ParabolicSystem &parabolic_system,
                 const InitialPrecomputedVector &initial_precomputed,
-                const ScalarVector &alpha,
+                const Vectors::IndicatorVector<Number> &alpha,
                 const std::string &subsection = "/MeshAdaptor");
 
     /**
@@ -152,7 +208,10 @@ namespace ryujin
     /**
      * Analyze the given StateVector with the configured adaptation
      * strategy and time point selection strategy and decide whether a mesh
-     * adaptation cycle should be performed.
+     * adaptation cycle should be performed. For a nonzero "adaptation
+     * lag" the refinement indicators are computed when an adaptation
+     * cycle is selected and the mesh adaptation is only requested the
+     * configured number of cycles later.
      */
     void analyze(const StateVector &state_vector,
                  const Number t,
@@ -168,10 +227,46 @@ namespace ryujin
 
     /**
      * Mark cells for coarsening and refinement with the configured mesh
-     * adaptation and marking strategies.
+     * adaptation and marking strategies. The refinement flags are then
+     * extended by a buffer zone of cells, see the "refinement buffer"
+     * options. The @p courant_number (the relative CFL number used by
+     * the time stepping) is used for predicting the width of the buffer
+     * zone.
      */
     void mark_cells_for_coarsening_and_refinement(
-        Triangulation &triangulation) const;
+        Triangulation &triangulation,
+        const Number courant_number = Number(0.)) const;
+
+    /**
+     * A boolean indicating whether the run time option "weighted
+     * repartitioning" is set. In this case the HyperbolicModule has to
+     * record the work per row, see HyperbolicModule::record_row_work().
+     */
+    ACCESSOR_READ_ONLY(weighted_repartitioning)
+
+    /**
+     * If the run time option "weighted repartitioning" is set, estimate
+     * the cost of every locally owned cell from the wall time @p row_work
+     * spent on its (locally owned) degrees of freedom in the row loops of
+     * HyperbolicModule::step() and connect a weight callback to the
+     * triangulation. The weights are used for repartitioning the mesh in
+     * the subsequent call to execute_coarsening_and_refinement(). Cells
+     * that are refined inherit the cost of the parent cell, coarsened
+     * cells receive the average cost of their children.
+     *
+     * The callback has to be disconnected again with
+     * detach_cell_weights() after the mesh has been adapted.
+     *
+     * @note This function is collective over the ensemble communicator.
+     */
+    void attach_cell_weights(Triangulation &triangulation,
+                             const std::vector<double> &row_work) const;
+
+    /**
+     * Disconnect the weight callback installed by attach_cell_weights()
+     * and release the cost estimate.
+     */
+    void detach_cell_weights() const;
 
   private:
     /**
@@ -188,13 +283,23 @@ namespace ryujin
     unsigned int min_refinement_level_;
     unsigned int max_refinement_level_;
     unsigned int max_num_cells_;
+    std::uint_fast64_t target_n_dofs_;
+    unsigned int refinement_buffer_layers_;
+    bool refinement_buffer_predictor_;
 
     TimePointSelectionStrategy time_point_selection_strategy_;
     std::vector<Number> adaptation_time_points_;
     unsigned int adaptation_cycle_interval_;
+    double drift_threshold_;
+    unsigned int drift_cycle_interval_;
+    unsigned int adaptation_lag_;
 
     std::vector<std::string> kelly_quantities_;
 
+    bool weighted_repartitioning_;
+    unsigned int cell_weight_base_;
+    double cell_weight_max_ratio_;
+
     //@}
     /**
      * @name Internal fields and methods
@@ -211,6 +316,15 @@ namespace ryujin
 
     mutable dealii::Vector<float> indicators_;
 
+    /* Compute indicators_ with the chosen adaptation strategy: */
+
+    void compute_indicators() const;
+
+    /* Adaptation lag: */
+
+    mutable std::future<void> pending_indicators_;
+    mutable unsigned int n_lag_cycles_remaining_;
+
     /* random adaptation: */
 
     void compute_random_indicators() const;
@@ -222,10 +336,37 @@ namespace ryujin
     void populate_kelly_quantities(const StateVector &state_vector) const;
     void compute_kelly_indicators() const;
 
+    /* Smoothness indicator: */
+
+    void compute_smoothness_indicators() const;
+
+    /* Gradient indicator: */
+
+    void compute_gradient_indicators() const;
+
+    mutable std::vector<Vectors::MultiComponentVector<Number, dim>> gradients_;
+    mutable ScalarVector gradient_jumps_;
+
+    /* Indicator drift: */
+
+    bool indicator_drifted();
+
+    std::vector<float> alpha_reference_;
+
+    /* Refinement buffer: */
+
+    void extend_refinement_flags(Triangulation &triangulation,
+                                 const unsigned int n_layers) const;
+
     const InitialPrecomputedVector &initial_precomputed_;
-    const ScalarVector &alpha_;
+    const Vectors::IndicatorVector<Number> &alpha_;
 
     mutable std::vector<ScalarVector> kelly_components_;
+
+    /* Weighted repartitioning: */
+
+    mutable std::map<dealii::CellId, double> cell_cost_;
+    mutable boost::signals2::connection cell_weight_connection_;
     //@}
   };
 
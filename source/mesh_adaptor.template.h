@@ -6,12 +6,19 @@
 #pragma once
 
 #include "mesh_adaptor.h"
+#include "openmp.h"
 #include "selected_components_extractor.h"
+#include "simd.h"
 
 #include <deal.II/base/array_view.h>
 #include <deal.II/grid/grid_refinement.h>
+#include <deal.II/grid/grid_tools.h>
 #include <deal.II/numerics/error_estimator.h>
 
+#include <algorithm>
+#include <future>
+#include <optional>
+
 namespace ryujin
 {
   template <typename Description, int dim, typename Number>
@@ -21,7 +28,7 @@ namespace ryujin
       const HyperbolicSystem &hyperbolic_system,
       const ParabolicSystem &parabolic_system,
       const InitialPrecomputedVector &initial_precomputed,
-      const ScalarVector &alpha,
+      const Vectors::IndicatorVector<Number> &alpha,
       const std::string &subsection /*= "MeshAdaptor"*/)
       : ParameterAcceptor(subsection)
       , mpi_ensemble_(mpi_ensemble)
@@ -29,6 +36,7 @@ namespace ryujin
       , hyperbolic_system_(&hyperbolic_system)
       , parabolic_system_(&parabolic_system)
       , need_mesh_adaptation_(false)
+      , n_lag_cycles_remaining_(0)
       , initial_precomputed_(initial_precomputed)
       , alpha_(alpha)
   {
@@ -36,20 +44,21 @@ namespace ryujin
     add_parameter("adaptation strategy",
                   adaptation_strategy_,
                   "The chosen adaptation strategy. Possible values are: global "
-                  "refinement, random adaptation, kelly estimator");
+                  "refinement, random adaptation, kelly estimator, smoothness "
+                  "indicator, gradient indicator");
 
     marking_strategy_ = MarkingStrategy::fixed_number;
     add_parameter("marking strategy",
                   marking_strategy_,
                   "The chosen marking strategy. Possible values are: fixed "
-                  "number, fixed fraction");
+                  "number, fixed fraction, fixed dof count");
 
     time_point_selection_strategy_ =
         TimePointSelectionStrategy::fixed_time_points;
     add_parameter("time point selection strategy",
                   time_point_selection_strategy_,
                   "The chosen time point selection strategy. Possible values "
-                  "are: fixed time points, simulation cycle");
+                  "are: fixed time points, simulation cycle, indicator drift");
 
     /* Options for various adaptation strategies: */
     enter_subsection("adaptation strategies");
@@ -62,7 +71,8 @@ namespace ryujin
         "kelly estimator: quantities",
         kelly_quantities_,
         "List of conserved, primitive or precomputed quantities that will be "
-        "used for the Kelly error estimator for refinement and coarsening.");
+        "used for the Kelly error estimator and the gradient indicator for "
+        "refinement and coarsening.");
     leave_subsection();
 
     /* Options for various marking strategies: */
@@ -97,6 +107,34 @@ namespace ryujin
         "Marking: maximal number of cells used for the fixed fraction "
         "strategy. Note this is only an indicator and not strictly enforced.");
 
+    target_n_dofs_ = 1000000;
+    add_parameter("target number of dofs",
+                  target_n_dofs_,
+                  "Marking: global number of degrees of freedom targeted by "
+                  "the fixed dof count strategy. The refinement fraction is "
+                  "chosen such that the number of degrees of freedom after "
+                  "mesh adaptation approximately matches this target. Note "
+                  "this is only an indicator and not strictly enforced.");
+
+    refinement_buffer_layers_ = 0;
+    add_parameter("refinement buffer layers",
+                  refinement_buffer_layers_,
+                  "Marking: number of layers of neighboring cells that are "
+                  "additionally flagged for refinement (and not coarsened) "
+                  "around every cell flagged for refinement. A buffer zone "
+                  "keeps moving features within the refined region and allows "
+                  "for less frequent mesh adaptation.");
+
+    refinement_buffer_predictor_ = false;
+    add_parameter(
+        "refinement buffer predictor",
+        refinement_buffer_predictor_,
+        "Marking: for the \"simulation cycle\" time point selection "
+        "strategy, predict the number of buffer layers from the maximal "
+        "distance (in cells) the fastest wave travels until the next "
+        "adaptation cycle. The larger of the predicted and the configured "
+        "number of buffer layers is used.");
+
     leave_subsection();
 
     /* Options for various time point selection strategies: */
@@ -113,6 +151,52 @@ namespace ryujin
                   adaptation_cycle_interval_,
                   "The nth simulation cycle at which we will "
                   "perform mesh adapation.");
+
+    drift_threshold_ = 0.1;
+    add_parameter("indicator drift: threshold",
+                  drift_threshold_,
+                  "Relative l1 difference between the current smoothness "
+                  "indicator and the indicator at the last mesh adaptation "
+                  "above which we perform a mesh adaptation cycle.");
+
+    drift_cycle_interval_ = 5;
+    add_parameter("indicator drift: interval",
+                  drift_cycle_interval_,
+                  "The nth simulation cycle at which we measure the drift "
+                  "of the smoothness indicator.");
+
+    adaptation_lag_ = 0;
+    add_parameter(
+        "adaptation lag",
+        adaptation_lag_,
+        "Number of cycles between computing the refinement indicators and "
+        "adapting the mesh. For a nonzero lag the indicators are computed "
+        "when an adaptation cycle is selected (for the Kelly estimator "
+        "asynchronously on a helper thread), time stepping continues on "
+        "the current mesh, and the mesh is adapted with these indicators "
+        "the given number of cycles later.");
+    leave_subsection();
+
+    /* Options for repartitioning: */
+
+    enter_subsection("repartitioning");
+    weighted_repartitioning_ = false;
+    add_parameter("weighted repartitioning",
+                  weighted_repartitioning_,
+                  "Repartition the mesh after adaptation with cell weights "
+                  "derived from the wall time measured for every cell in the "
+                  "hyperbolic update instead of uniform cell weights.");
+
+    cell_weight_base_ = 1000;
+    add_parameter("cell weight base",
+                  cell_weight_base_,
+                  "Repartitioning: weight assigned to a cell of average cost.");
+
+    cell_weight_max_ratio_ = 10.;
+    add_parameter("cell weight max ratio",
+                  cell_weight_max_ratio_,
+                  "Repartitioning: maximal ratio between the cost of a cell "
+                  "and the average cost (and its inverse as lower bound).");
     leave_subsection();
 
     const auto call_back = [this] {
@@ -142,11 +226,21 @@ namespace ryujin
       adaptation_time_points_.erase(new_end, adaptation_time_points_.end());
     }
 
-    if (adaptation_strategy_ == AdaptationStrategy::kelly_estimator) {
+    if (adaptation_strategy_ == AdaptationStrategy::kelly_estimator ||
+        adaptation_strategy_ == AdaptationStrategy::gradient_indicator) {
       SelectedComponentsExtractor<Description, dim, Number>::check(
           kelly_quantities_);
     }
 
+    /* Discard indicators that were computed on an outdated mesh: */
+    if (pending_indicators_.valid())
+      pending_indicators_.wait();
+    pending_indicators_ = {};
+    n_lag_cycles_remaining_ = 0;
+
+    /* The indicator reference is recorded anew on the new mesh: */
+    alpha_reference_.clear();
+
     /* toggle mesh adaptation flag to off. */
     need_mesh_adaptation_ = false;
   }
@@ -232,6 +326,229 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void
+  MeshAdaptor<Description, dim, Number>::compute_smoothness_indicators() const
+  {
+    /*
+     * The alpha_i vector has been computed (and its ghost range
+     * exchanged) in Step 2 of the last HyperbolicModule::step() call. We
+     * simply take the maximum over all degrees of freedom of a cell:
+     */
+
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &partitioner = *offline_data_->scalar_partitioner();
+
+    std::vector<dealii::types::global_dof_index> dof_indices(
+        dof_handler.get_fe().n_dofs_per_cell());
+
+    indicators_ = 0.;
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
+
+      cell->get_dof_indices(dof_indices);
+
+      Number indicator = Number(0.);
+      for (const auto global_index : dof_indices) {
+        const auto index = partitioner.global_to_local(global_index);
+        indicator = std::max(indicator, Number(alpha_.local_element(index)));
+      }
+
+      indicators_[cell->active_cell_index()] = indicator;
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void
+  MeshAdaptor<Description, dim, Number>::compute_gradient_indicators() const
+  {
+    using VA = VectorizedArrayType<Number>;
+
+    const auto &affine_constraints = offline_data_->affine_constraints();
+    const auto &scalar_partitioner = offline_data_->scalar_partitioner();
+
+    const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
+    const auto &lumped_mass_matrix_inverse =
+        offline_data_->lumped_mass_matrix_inverse();
+    const auto &cij_matrix = offline_data_->cij_matrix();
+
+    const unsigned int n_internal = offline_data_->n_locally_internal();
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+
+    const unsigned int n_quantities = kelly_components_.size();
+
+    gradients_.resize(n_quantities);
+    for (auto &it : gradients_)
+      it.reinit_with_scalar_partitioner(scalar_partitioner);
+    gradient_jumps_.reinit(scalar_partitioner);
+
+    /*
+     * Step 1: Reconstruct the lumped gradient
+     *   g_i = m_i^{-1} sum_j c_ij q_j
+     * of every selected quantity. (The kelly_components_ vectors have
+     * been populated and their ghost range exchanged in analyze().)
+     */
+
+    {
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+        using T = decltype(sentinel);
+        unsigned int stride_size = get_stride_size<T>;
+
+        RYUJIN_OMP_FOR
+        for (unsigned int i = left; i < right; i += stride_size) {
+
+          /* Skip constrained degrees of freedom: */
+          const unsigned int row_length = sparsity_simd.row_length(i);
+          if (row_length == 1)
+            continue;
+
+          const auto m_i_inv = get_entry<T>(lumped_mass_matrix_inverse, i);
+
+          for (unsigned int k = 0; k < n_quantities; ++k) {
+            dealii::Tensor<1, dim, T> g_i;
+
+            const unsigned int *js = sparsity_simd.columns(i);
+            for (unsigned int col_idx = 0; col_idx < row_length;
+                 ++col_idx, js += stride_size) {
+              const auto q_j = get_entry<T>(kelly_components_[k], js);
+              const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
+              g_i += c_ij * q_j;
+            }
+
+            gradients_[k].template write_tensor<T>(m_i_inv * g_i, i);
+          }
+        }
+      };
+
+      /* Parallel non-vectorized loop: */
+      loop(Number(), n_internal, n_owned);
+      /* Parallel vectorized SIMD loop: */
+      loop(VA(), 0, n_internal);
+
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    for (auto &it : gradients_)
+      it.update_ghost_values();
+
+    /*
+     * Step 2: Compute the jump of the reconstructed gradients over the
+     * stencil
+     *   eta_i = sum_k sum_j |c_ij| |g_j - g_i|,
+     * summed over all selected quantities:
+     */
+
+    {
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+        using T = decltype(sentinel);
+        unsigned int stride_size = get_stride_size<T>;
+
+        RYUJIN_OMP_FOR
+        for (unsigned int i = left; i < right; i += stride_size) {
+
+          /* Skip constrained degrees of freedom: */
+          const unsigned int row_length = sparsity_simd.row_length(i);
+          if (row_length == 1)
+            continue;
+
+          T eta_i = T(0.);
+
+          for (unsigned int k = 0; k < n_quantities; ++k) {
+            const auto g_i = gradients_[k].template get_tensor<T>(i);
+
+            /* Skip diagonal: */
+            const unsigned int *js = sparsity_simd.columns(i) + stride_size;
+            for (unsigned int col_idx = 1; col_idx < row_length;
+                 ++col_idx, js += stride_size) {
+              const auto g_j = gradients_[k].template get_tensor<T>(js);
+              const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
+              eta_i += c_ij.norm() * (g_j - g_i).norm();
+            }
+          }
+
+          write_entry<T>(gradient_jumps_, eta_i, i);
+        }
+      };
+
+      /* Parallel non-vectorized loop: */
+      loop(Number(), n_internal, n_owned);
+      /* Parallel vectorized SIMD loop: */
+      loop(VA(), 0, n_internal);
+
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    affine_constraints.distribute(gradient_jumps_);
+    gradient_jumps_.update_ghost_values();
+
+    /*
+     * Step 3: Take the maximum over all degrees of freedom of a cell:
+     */
+
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &partitioner = *scalar_partitioner;
+
+    std::vector<dealii::types::global_dof_index> dof_indices(
+        dof_handler.get_fe().n_dofs_per_cell());
+
+    indicators_ = 0.;
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
+
+      cell->get_dof_indices(dof_indices);
+
+      Number indicator = Number(0.);
+      for (const auto global_index : dof_indices) {
+        const auto index = partitioner.global_to_local(global_index);
+        indicator = std::max(indicator, gradient_jumps_.local_element(index));
+      }
+
+      indicators_[cell->active_cell_index()] = indicator;
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  bool MeshAdaptor<Description, dim, Number>::indicator_drifted()
+  {
+    /*
+     * The alpha_i vector has been computed in the last
+     * HyperbolicModule::step() call. The first call after prepare() only
+     * records the reference:
+     */
+
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+
+    if (alpha_reference_.size() != n_owned) {
+      alpha_reference_.resize(n_owned);
+      for (unsigned int i = 0; i < n_owned; ++i)
+        alpha_reference_[i] = alpha_.local_element(i);
+      return false;
+    }
+
+    double difference = 0.;
+    double norm = 0.;
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      const double alpha_i = alpha_.local_element(i);
+      difference += std::abs(alpha_i - alpha_reference_[i]);
+      norm += alpha_reference_[i];
+    }
+
+    const auto &ensemble_communicator = mpi_ensemble_.ensemble_communicator();
+    difference = dealii::Utilities::MPI::sum(difference, ensemble_communicator);
+    norm = dealii::Utilities::MPI::sum(norm, ensemble_communicator);
+
+    return difference > drift_threshold_ * norm;
+  }
+
+
   template <typename Description, int dim, typename Number>
   void MeshAdaptor<Description, dim, Number>::analyze(
       const StateVector &state_vector, const Number t, unsigned int cycle)
@@ -240,6 +557,19 @@ namespace ryujin
     std::cout << "MeshAdaptor<dim, Number>::analyze()" << std::endl;
 #endif
 
+    /*
+     * If indicators have been computed in an earlier cycle we simply
+     * count down the adaptation lag:
+     */
+
+    if (pending_indicators_.valid()) {
+      if (n_lag_cycles_remaining_ > 0)
+        --n_lag_cycles_remaining_;
+      if (n_lag_cycles_remaining_ == 0)
+        need_mesh_adaptation_ = true;
+      return;
+    }
+
     /*
      * Decide whether we perform an adaptation cycle with the chosen time
      * point selection strategy:
@@ -266,6 +596,12 @@ namespace ryujin
         need_mesh_adaptation_ = true;
     } break;
 
+    case TimePointSelectionStrategy::indicator_drift: {
+      /* check whether the indicator drifted away from the reference: */
+      if (cycle % drift_cycle_interval_ == 0 && indicator_drifted())
+        need_mesh_adaptation_ = true;
+    } break;
+
     default:
       AssertThrow(false, dealii::ExcInternalError());
       __builtin_trap();
@@ -289,50 +625,176 @@ namespace ryujin
       break;
 
     case AdaptationStrategy::kelly_estimator:
+      [[fallthrough]];
+    case AdaptationStrategy::gradient_indicator:
       populate_kelly_quantities(state_vector);
       break;
 
+    case AdaptationStrategy::smoothness_indicator:
+      /* do nothing, we reuse the alpha_i vector */
+      break;
+
     default:
       AssertThrow(false, dealii::ExcInternalError());
       __builtin_trap();
     }
+
+    /*
+     * With a nonzero adaptation lag we compute the indicators right away
+     * and postpone the mesh adaptation. The Kelly estimator only reads
+     * the (ghosted) copies of the selected quantities, the DoFHandler and
+     * the mapping, none of which change until the mesh is adapted. It
+     * thus runs asynchronously while time stepping continues:
+     */
+
+    if (adaptation_lag_ == 0 ||
+        adaptation_strategy_ == AdaptationStrategy::global_refinement)
+      return;
+
+    const auto policy =
+        adaptation_strategy_ == AdaptationStrategy::kelly_estimator
+            ? std::launch::async
+            : std::launch::deferred;
+
+    /*
+     * Random, smoothness and gradient indicators are cheap, compute them
+     * now. (The gradient indicator uses the OpenMP thread pool and must
+     * not run concurrently to the time stepping.)
+     */
+    pending_indicators_ =
+        std::async(policy, [this]() { compute_indicators(); });
+    if (policy == std::launch::deferred)
+      pending_indicators_.wait();
+
+    n_lag_cycles_remaining_ = adaptation_lag_;
+    need_mesh_adaptation_ = false;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void MeshAdaptor<Description, dim, Number>::compute_indicators() const
+  {
+    const auto &triangulation = offline_data_->discretization().triangulation();
+    indicators_.reinit(triangulation.n_active_cells());
+
+    switch (adaptation_strategy_) {
+    case AdaptationStrategy::random_adaptation:
+      compute_random_indicators();
+      break;
+
+    case AdaptationStrategy::kelly_estimator:
+      compute_kelly_indicators();
+      break;
+
+    case AdaptationStrategy::smoothness_indicator:
+      compute_smoothness_indicators();
+      break;
+
+    case AdaptationStrategy::gradient_indicator:
+      compute_gradient_indicators();
+      break;
+
+    default:
+      AssertThrow(false, dealii::ExcInternalError());
+      __builtin_trap();
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void MeshAdaptor<Description, dim, Number>::extend_refinement_flags(
+      Triangulation &triangulation, const unsigned int n_layers) const
+  {
+    using cell_iterator = typename Triangulation::active_cell_iterator;
+
+    /*
+     * Update the refinement flags of all ghost cells with the flags set
+     * by their owners, so that a layer can grow across the boundary of
+     * the locally owned subdomain:
+     */
+    const auto exchange_refinement_flags = [&]() {
+      dealii::GridTools::exchange_cell_data_to_ghosts<bool, Triangulation>(
+          triangulation,
+          [](const cell_iterator &cell) {
+            return std::optional<bool>(cell->refine_flag_set());
+          },
+          [](const cell_iterator &cell, const bool &refine) {
+            if (refine)
+              cell->set_refine_flag();
+            else
+              cell->clear_refine_flag();
+          });
+    };
+
+    std::vector<cell_iterator> neighbors;
+    std::vector<cell_iterator> front;
+
+    for (unsigned int layer = 0; layer < n_layers; ++layer) {
+      exchange_refinement_flags();
+
+      /*
+       * Collect all locally owned neighbors of (locally owned or ghost)
+       * cells flagged for refinement first, so that every sweep adds
+       * exactly one layer:
+       */
+      front.clear();
+      for (const auto &cell : triangulation.active_cell_iterators()) {
+        if (cell->is_artificial() || !cell->refine_flag_set())
+          continue;
+
+        dealii::GridTools::get_active_neighbors<Triangulation>(cell,
+                                                                neighbors);
+        for (const auto &neighbor : neighbors)
+          if (neighbor->is_locally_owned() && !neighbor->refine_flag_set())
+            front.push_back(neighbor);
+      }
+
+      /* All ranks have to take part in the exchange of the next layer: */
+      if (!dealii::Utilities::MPI::logical_or(
+              !front.empty(), mpi_ensemble_.ensemble_communicator()))
+        break;
+
+      for (const auto &cell : front) {
+        cell->clear_coarsen_flag();
+        if (static_cast<unsigned int>(cell->level()) < max_refinement_level_)
+          cell->set_refine_flag();
+      }
+    }
+
+    /* Only the owners decide about refinement: */
+    for (const auto &cell : triangulation.active_cell_iterators())
+      if (cell->is_ghost())
+        cell->clear_refine_flag();
   }
 
 
   template <typename Description, int dim, typename Number>
   void MeshAdaptor<Description, dim, Number>::
       mark_cells_for_coarsening_and_refinement(
-          Triangulation &triangulation) const
+          Triangulation &triangulation, const Number courant_number) const
   {
     auto &discretization [[maybe_unused]] = offline_data_->discretization();
     Assert(&triangulation == &discretization.triangulation(),
            dealii::ExcInternalError());
 
     /*
-     * Compute an indicator with the chosen adaptation strategy:
+     * Compute an indicator with the chosen adaptation strategy, or pick
+     * up the indicators computed in analyze() for a nonzero adaptation
+     * lag:
      */
 
-    switch (adaptation_strategy_) {
-    case AdaptationStrategy::global_refinement: {
+    if (adaptation_strategy_ == AdaptationStrategy::global_refinement) {
       /* Simply mark all cells for refinement and return: */
       for (auto &cell : triangulation.active_cell_iterators())
         cell->set_refine_flag();
       return;
-    } break;
-
-    case AdaptationStrategy::random_adaptation: {
-      indicators_.reinit(triangulation.n_active_cells());
-      compute_random_indicators();
-    } break;
-
-    case AdaptationStrategy::kelly_estimator: {
-      indicators_.reinit(triangulation.n_active_cells());
-      compute_kelly_indicators();
-    } break;
+    }
 
-    default:
-      AssertThrow(false, dealii::ExcInternalError());
-      __builtin_trap();
+    if (pending_indicators_.valid()) {
+      pending_indicators_.get();
+      n_lag_cycles_remaining_ = 0;
+    } else {
+      compute_indicators();
     }
 
     /*
@@ -358,6 +820,37 @@ namespace ryujin
           coarsening_fraction_,
           max_num_cells_);
     } break;
+    case MarkingStrategy::fixed_dof_count: {
+      /*
+       * Assume that the number of degrees of freedom scales with the
+       * number of cells. Every refined cell adds 2^dim - 1 cells, and
+       * every cell flagged for coarsening removes about (2^dim - 1) /
+       * 2^dim cells. We thus choose refinement and coarsening fractions
+       * r, c such that
+       *   1 + (2^dim - 1) * (r - c / 2^dim) = n_target_dofs / n_dofs.
+       */
+      const double n_dofs = offline_data_->dof_handler().n_dofs();
+      const double ratio = double(target_n_dofs_) / n_dofs;
+
+      constexpr double n_children = 1 << dim;
+      double coarsening_fraction = coarsening_fraction_;
+      double refinement_fraction =
+          (ratio - 1.) / (n_children - 1.) + coarsening_fraction / n_children;
+
+      if (refinement_fraction < 0.) {
+        refinement_fraction = 0.;
+        coarsening_fraction =
+            std::min(1., (1. - ratio) * n_children / (n_children - 1.));
+      }
+      refinement_fraction =
+          std::min(refinement_fraction, 1. - coarsening_fraction);
+
+      dealii::GridRefinement::refine_and_coarsen_fixed_number(
+          triangulation,
+          indicators_,
+          refinement_fraction,
+          coarsening_fraction);
+    } break;
 
     default:
       AssertThrow(false, dealii::ExcInternalError());
@@ -377,5 +870,151 @@ namespace ryujin
     for (const auto &cell :
          triangulation.active_cell_iterators_on_level(min_refinement_level_))
       cell->clear_coarsen_flag();
+
+    /*
+     * Extend the refinement flags by a buffer zone. With the CFL condition
+     * used by the HyperbolicModule the fastest wave travels at most about
+     * courant_number cells per cycle, i.e., about (interval + lag) *
+     * courant_number cells from the cycle the indicators were computed
+     * until the next adaptation cycle:
+     */
+
+    unsigned int n_layers = refinement_buffer_layers_;
+
+    if (refinement_buffer_predictor_ &&
+        time_point_selection_strategy_ ==
+            TimePointSelectionStrategy::simulation_cycle) {
+      const auto n_cycles = adaptation_cycle_interval_ + adaptation_lag_;
+      const auto predicted = static_cast<unsigned int>(
+          std::ceil(n_cycles * double(courant_number)));
+      n_layers = std::max(n_layers, predicted);
+    }
+
+    if (n_layers > 0)
+      extend_refinement_flags(triangulation, n_layers);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void MeshAdaptor<Description, dim, Number>::attach_cell_weights(
+      Triangulation &triangulation [[maybe_unused]],
+      const std::vector<double> &row_work [[maybe_unused]]) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "MeshAdaptor<dim, Number>::attach_cell_weights()"
+              << std::endl;
+#endif
+
+    if (!weighted_repartitioning_)
+      return;
+
+    /* Cell weights are only used for repartitioning a p4est forest: */
+    if constexpr (have_distributed_triangulation<dim>) {
+      const auto &dof_handler = offline_data_->dof_handler();
+      const auto &partitioner = *offline_data_->scalar_partitioner();
+      const unsigned int n_owned = offline_data_->n_locally_owned();
+
+      AssertThrow(row_work.size() == n_owned,
+                  dealii::ExcMessage("Weighted repartitioning requires the "
+                                     "HyperbolicModule to record the work "
+                                     "per row"));
+
+      /*
+       * Estimate the cost of every locally owned cell by the average work
+       * recorded for its locally owned degrees of freedom:
+       */
+
+      cell_cost_.clear();
+      double local_sum = 0.;
+      double local_n_cells = 0.;
+
+      std::vector<dealii::types::global_dof_index> dof_indices(
+          dof_handler.get_fe().n_dofs_per_cell());
+
+      for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+
+        cell->get_dof_indices(dof_indices);
+
+        double cost = 0.;
+        unsigned int n_dofs = 0;
+        for (const auto global_index : dof_indices) {
+          const auto index = partitioner.global_to_local(global_index);
+          if (index >= n_owned)
+            continue;
+          cost += row_work[index];
+          ++n_dofs;
+        }
+
+        if (n_dofs == 0)
+          continue;
+
+        cost /= n_dofs;
+        cell_cost_[cell->id()] = cost;
+        local_sum += cost;
+        local_n_cells += 1.;
+      }
+
+      const auto &communicator = mpi_ensemble_.ensemble_communicator();
+      const double sum = dealii::Utilities::MPI::sum(local_sum, communicator);
+      const double n_cells =
+          dealii::Utilities::MPI::sum(local_n_cells, communicator);
+
+      /* Nothing recorded so far, keep uniform weights: */
+      if (!(sum > 0.) || !(n_cells > 0.)) {
+        cell_cost_.clear();
+        return;
+      }
+
+      const double average = sum / n_cells;
+      const double max_ratio = std::max(cell_weight_max_ratio_, 1.);
+      for (auto &[id, cost] : cell_cost_)
+        cost = std::clamp(cost / average, 1. / max_ratio, max_ratio);
+
+      /*
+       * Cells without an estimate (all degrees of freedom owned by a
+       * different rank) receive the average cost:
+       */
+      const auto cost_of = [this](const dealii::CellId &id) {
+        const auto it = cell_cost_.find(id);
+        return it == cell_cost_.end() ? 1. : it->second;
+      };
+
+      cell_weight_connection_.disconnect();
+      cell_weight_connection_ = triangulation.signals.weight.connect(
+          [this, cost_of](const auto &cell,
+                          const auto status) -> unsigned int {
+#if DEAL_II_VERSION_GTE(9, 6, 0)
+            const bool coarsen =
+                (status == dealii::CellStatus::children_will_be_coarsened);
+#else
+            const bool coarsen = (status == Triangulation::CELL_COARSEN);
+#endif
+            double cost = 0.;
+            if (coarsen) {
+              /* The cell is the parent of the children to be coarsened: */
+              constexpr auto n_children =
+                  dealii::GeometryInfo<dim>::max_children_per_cell;
+              for (unsigned int c = 0; c < n_children; ++c)
+                cost += cost_of(cell->id().child_cell_id(c));
+              cost /= n_children;
+            } else {
+              /* Persisting cells, and parents of refined cells: */
+              cost = cost_of(cell->id());
+            }
+
+            return static_cast<unsigned int>(
+                std::max(std::round(cell_weight_base_ * cost), 1.));
+          });
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void MeshAdaptor<Description, dim, Number>::detach_cell_weights() const
+  {
+    cell_weight_connection_.disconnect();
+    cell_cost_.clear();
   }
 } // namespace ryujin
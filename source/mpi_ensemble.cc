@@ -18,6 +18,9 @@ namespace ryujin
       , n_ensembles_(1)
       , ensemble_rank_(0)
       , n_ensemble_ranks_(1)
+      , node_rank_(0)
+      , n_node_ranks_(1)
+      , n_nodes_(1)
   {
 #ifdef DEBUG_OUTPUT
     std::cout << "MPIEnsemble::prepare()" << std::endl;
@@ -92,6 +95,39 @@ namespace ryujin
         world_communicator_, ensemble_rank_, ensemble_, &peer_communicator_);
     AssertThrowMPI(ierr);
 
+    /* node communicator: */
+
+    ierr = MPI_Comm_split_type(world_communicator_,
+                               MPI_COMM_TYPE_SHARED,
+                               world_rank_,
+                               MPI_INFO_NULL,
+                               &node_communicator_);
+    AssertThrowMPI(ierr);
+
+    node_rank_ = dealii::Utilities::MPI::this_mpi_process(node_communicator_);
+    n_node_ranks_ =
+        dealii::Utilities::MPI::n_mpi_processes(node_communicator_);
+    n_nodes_ = dealii::Utilities::MPI::sum(node_rank_ == 0 ? 1 : 0,
+                                           world_communicator_);
+
+    /* node peer communicator: */
+
+    ierr = MPI_Comm_split_type(peer_communicator_,
+                               MPI_COMM_TYPE_SHARED,
+                               ensemble_,
+                               MPI_INFO_NULL,
+                               &node_peer_communicator_);
+    AssertThrowMPI(ierr);
+
+    /* ensemble node communicator: */
+
+    ierr = MPI_Comm_split_type(ensemble_communicator_,
+                               MPI_COMM_TYPE_SHARED,
+                               ensemble_rank_,
+                               MPI_INFO_NULL,
+                               &ensemble_node_communicator_);
+    AssertThrowMPI(ierr);
+
 #ifdef DEBUG_OUTPUT
     const auto peer_rank =
         dealii::Utilities::MPI::this_mpi_process(peer_communicator_);
@@ -114,6 +150,9 @@ namespace ryujin
     MPI_Comm_free(&ensemble_communicator_);
     MPI_Comm_free(&ensemble_leader_communicator_);
     MPI_Comm_free(&peer_communicator_);
+    MPI_Comm_free(&node_communicator_);
+    MPI_Comm_free(&node_peer_communicator_);
+    MPI_Comm_free(&ensemble_node_communicator_);
   }
 
 } /* namespace ryujin */
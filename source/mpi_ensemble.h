@@ -122,6 +122,47 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY_NO_DEREFERENCE(peer_communicator);
 
+    /**
+     * A "node communicator" that groups all (world) ranks sharing the
+     * same compute node (i.e., the same shared memory domain). The node
+     * communicator is collective over all world ranks.
+     */
+    ACCESSOR_READ_ONLY_NO_DEREFERENCE(node_communicator);
+
+    /**
+     * A "node peer communicator" that groups all kth ranks of each
+     * ensemble that share the same compute node, i.e., the intersection
+     * of the peer_communicator() and the node_communicator(). Rank 0 of
+     * the node peer communicator belongs to the lowest ensemble. The node
+     * peer communicator is collective over all world ranks.
+     */
+    ACCESSOR_READ_ONLY_NO_DEREFERENCE(node_peer_communicator);
+
+    /**
+     * An "ensemble node communicator" that groups all ranks of the
+     * ensemble that share the same compute node, i.e., the intersection
+     * of the ensemble_communicator() and the node_communicator(). This
+     * communicator is suitable for allocating vectors in MPI-3 shared
+     * memory windows. The ensemble node communicator is collective over
+     * all ranks participating in the ensemble.
+     */
+    ACCESSOR_READ_ONLY_NO_DEREFERENCE(ensemble_node_communicator);
+
+    /**
+     * The rank of the current MPI process within the node communicator.
+     */
+    ACCESSOR_READ_ONLY(node_rank);
+
+    /**
+     * The total number of MPI processes running on the current node.
+     */
+    ACCESSOR_READ_ONLY(n_node_ranks);
+
+    /**
+     * The total number of compute nodes (shared memory domains).
+     */
+    ACCESSOR_READ_ONLY(n_nodes);
+
   private:
     const MPI_Comm &world_communicator_;
 
@@ -133,6 +174,9 @@ namespace ryujin
     int n_ensembles_;
     int ensemble_rank_;
     int n_ensemble_ranks_;
+    int node_rank_;
+    int n_node_ranks_;
+    int n_nodes_;
 
     MPI_Group world_group_;
     std::vector<MPI_Group> ensemble_groups_;
@@ -141,5 +185,8 @@ namespace ryujin
     MPI_Comm ensemble_communicator_;
     MPI_Comm ensemble_leader_communicator_;
     MPI_Comm peer_communicator_;
+    MPI_Comm node_communicator_;
+    MPI_Comm node_peer_communicator_;
+    MPI_Comm ensemble_node_communicator_;
   };
 } /* namespace ryujin */
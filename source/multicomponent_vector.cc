@@ -5,6 +5,8 @@
 
 #include "multicomponent_vector.h"
 
+#include <algorithm>
+
 namespace ryujin
 {
   namespace Vectors
@@ -40,5 +42,43 @@ namespace ryujin
 
       return vector_partitioner;
     }
+
+
+    std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+    create_vector_partitioner(
+        const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+            &scalar_partitioner,
+        const unsigned int n_components,
+        const std::vector<unsigned int> &ghost_components)
+    {
+      Assert(std::is_sorted(ghost_components.begin(), ghost_components.end()),
+             dealii::ExcMessage("The ghost components must be sorted."));
+
+      const auto full_partitioner =
+          create_vector_partitioner(scalar_partitioner, n_components);
+
+      std::vector<dealii::types::global_dof_index> ghost_indices;
+      ghost_indices.reserve(scalar_partitioner->n_ghost_indices() *
+                            ghost_components.size());
+      for (const auto i : scalar_partitioner->ghost_indices())
+        for (const auto c : ghost_components) {
+          AssertIndexRange(c, n_components);
+          ghost_indices.push_back(i * n_components + c);
+        }
+
+      dealii::IndexSet vector_ghost_set(n_components *
+                                        scalar_partitioner->size());
+      vector_ghost_set.add_indices(ghost_indices.begin(), ghost_indices.end());
+      vector_ghost_set.compress();
+
+      const auto vector_partitioner =
+          std::make_shared<dealii::Utilities::MPI::Partitioner>(
+              full_partitioner->locally_owned_range(),
+              scalar_partitioner->get_mpi_communicator());
+      vector_partitioner->set_ghost_indices(vector_ghost_set,
+                                            full_partitioner->ghost_indices());
+
+      return vector_partitioner;
+    }
   } // namespace Vectors
 } // namespace ryujin
@@ -5,8 +5,13 @@
 
 #pragma once
 
+#include <compile_time_options.h>
+
+#include "numa.h"
 #include "simd.h"
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/vectorization.h>
@@ -42,11 +47,88 @@ namespace ryujin
         const unsigned int n_components);
 
 
+    /**
+     * Variant of the above function creating a "vector" MPI partitioner
+     * that only holds the (ghost) components @p ghost_components (in
+     * strictly ascending order) of every ghost index. The ghost index set
+     * of the full vector partitioner is set as "larger ghost index set",
+     * i.e., the partitioner can be used to exchange a subset of the ghost
+     * values of a MultiComponentVector with the (full) layout described
+     * above, see MultiComponentVector::update_selected_ghost_values_start().
+     *
+     * @ingroup SIMD
+     */
+    std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+    create_vector_partitioner(
+        const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+            &scalar_partitioner,
+        const unsigned int n_components,
+        const std::vector<unsigned int> &ghost_components);
+
+
+    /**
+     * Layout policy for MultiComponentVector: all @p n_comp components of
+     * an entry are stored contiguously ("array of structures"), see
+     * create_vector_partitioner().
+     *
+     * @ingroup SIMD
+     */
+    struct InterleavedLayout {
+    };
+
+
+    /**
+     * Layout policy for MultiComponentVector: within a configurable range
+     * of (locally owned, SIMD-vectorized) indices, see
+     * MultiComponentVector::set_blocked_range(), entries are grouped into
+     * blocks of @p simd_length consecutive indices, and within every block
+     * all values of the same component are stored contiguously ("array of
+     * structures of arrays"):
+     * \f{align}
+     *  (U_0)_0, (U_1)_0, \ldots, (U_{s-1})_0, (U_0)_1, (U_1)_1, \ldots
+     * \f}
+     * A SIMD vectorized get_tensor() or write_tensor() for an index in
+     * this range thus reduces to @p n_comp aligned vector loads or stores.
+     * Outside of the range (in particular for all indices that are
+     * exported to or imported from other MPI ranks) the interleaved
+     * layout is used. As a price, gathering values at arbitrary indices
+     * (get_tensor(const unsigned int *)) touches up to @p n_comp cache
+     * lines per index instead of one.
+     *
+     * Every block occupies the same memory region as in the interleaved
+     * layout, so the MPI partitioner and all vector space operations are
+     * unaffected, provided all vectors that are combined use the same
+     * range.
+     *
+     * @ingroup SIMD
+     */
+    struct BlockedLayout {
+    };
+
+
+    /**
+     * The default layout policy of MultiComponentVector, BlockedLayout if
+     * the compile-time option BLOCKED_VECTOR_LAYOUT is set, and
+     * InterleavedLayout otherwise.
+     *
+     * @ingroup SIMD
+     */
+#ifdef BLOCKED_VECTOR_LAYOUT
+    using DefaultLayout = BlockedLayout;
+#else
+    using DefaultLayout = InterleavedLayout;
+#endif
+
+
     /**
      * A wrapper around dealii::LinearAlgebra::distributed::Vector<Number>
      * that stores a vector element of @p n_comp components per entry
      * (instead of a scalar value).
      *
+     * The template parameter @p Layout selects the storage layout of the
+     * vector elements, either InterleavedLayout, or BlockedLayout (see
+     * DefaultLayout).
+     *
      * @note reinit() has to be called with an appropriate "vector" MPI
      * partitioner created by create_vector_partitioner().
      *
@@ -54,7 +136,8 @@ namespace ryujin
      */
     template <typename Number,
               int n_comp,
-              int simd_length = dealii::VectorizedArray<Number>::size()>
+              int simd_length = simd_width<Number>,
+              typename Layout = DefaultLayout>
     class MultiComponentVector
         : public dealii::LinearAlgebra::distributed::Vector<Number>
     {
@@ -84,6 +167,10 @@ namespace ryujin
        * partitioner. The function calls create_vector_partitioner()
        * internally to create and store a corresponding "vector" MPI
        * partitioner.
+       *
+       * If the compile-time option NUMA_FIRST_TOUCH is set, the vector is
+       * first touched with the static OpenMP schedule of the compute
+       * kernels, see NUMA::first_touch_vector().
        */
       void reinit_with_scalar_partitioner(
           const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
@@ -122,6 +209,83 @@ namespace ryujin
       void insert_component(const ScalarVector &scalar_vector,
                             unsigned int component);
 
+      /**
+       * Variant of update_ghost_values_start() that only exchanges the
+       * ghost values described by @p ghost_partitioner. The partitioner
+       * must have been created with the variant of
+       * create_vector_partitioner() taking a list of ghost components.
+       * All other ghost values are set to zero by
+       * update_selected_ghost_values_finish().
+       *
+       * @note This function is used to reduce the message size of the
+       * ghost exchange of precomputed values to the components that are
+       * actually read at neighboring indices.
+       */
+      void update_selected_ghost_values_start(
+          const unsigned int communication_channel,
+          const dealii::Utilities::MPI::Partitioner &ghost_partitioner);
+
+      /**
+       * Complete a ghost exchange started with
+       * update_selected_ghost_values_start().
+       */
+      void update_selected_ghost_values_finish(
+          const dealii::Utilities::MPI::Partitioner &ghost_partitioner);
+
+      /**
+       * Set the half open interval [@p begin, @p end) of locally owned
+       * indices that are stored in the blocked layout. Both numbers must
+       * be divisible by @p simd_length. The function has no effect for
+       * the InterleavedLayout.
+       *
+       * @note The function only changes the interpretation of the stored
+       * values, it has to be called before the vector is populated.
+       */
+      void set_blocked_range(const unsigned int begin, const unsigned int end)
+      {
+        Assert(begin % simd_length == 0 && end % simd_length == 0,
+               dealii::ExcMessage("Blocked range is not SIMD aligned"));
+        if constexpr (std::is_same_v<Layout, BlockedLayout>) {
+          blocked_begin_ = begin;
+          blocked_end_ = std::max(begin, end);
+        }
+      }
+
+      /**
+       * Return the position of component @p d of the vector element with
+       * index @p i in the local storage.
+       */
+      DEAL_II_ALWAYS_INLINE inline unsigned int
+      element_index(const unsigned int i, const unsigned int d) const
+      {
+        if constexpr (std::is_same_v<Layout, BlockedLayout>) {
+          if (is_blocked(i)) {
+            const unsigned int lane = i % simd_length;
+            return (i - lane) * n_comp + d * simd_length + lane;
+          }
+        }
+        return i * n_comp + d;
+      }
+
+      /**
+       * Redirect all gathers at arbitrary indices, i.e.,
+       * get_tensor(const unsigned int *), to the external array @p data
+       * that stores component @p d of the vector element with (local)
+       * index @p j at position `data[j * stride + d]`. This allows
+       * multiple vectors to share a single co-located (interleaved) copy
+       * of their values for neighbor access, see ColocatedVector. Calling
+       * the function with a nullptr restores the default behavior.
+       *
+       * @note The caller is responsible that the external array is kept
+       * in sync with the vector while the redirection is active.
+       */
+      void set_gather_source(const Number *data,
+                             const unsigned int stride = n_comp) const
+      {
+        gather_data_ = data;
+        gather_stride_ = stride;
+      }
+
       /**
        * Return a dealii::Tensor populated with the @p n_comp component
        * vector stored at index @p i.
@@ -147,6 +311,16 @@ namespace ryujin
                 typename Tensor = dealii::Tensor<1, n_comp, Number2>>
       Tensor get_tensor(const unsigned int *js) const;
 
+      /**
+       * Issue software prefetches for the @p n_comp component vectors
+       * stored at indices *(js), ..., *(js+simd_length-1) (if the template
+       * parameter @a Number2 is a VectorizedArray), or at index *(js).
+       * The function is intended to be called a few stencil entries
+       * ahead of a corresponding call to get_tensor(const unsigned int *).
+       */
+      template <typename Number2 = Number>
+      void prefetch(const unsigned int *js) const;
+
       /**
        * Update the values of the @p n_comp component vector at index @p i
        * with the values supplied by @p tensor.
@@ -180,14 +354,48 @@ namespace ryujin
       template <typename Number2 = Number,
                 typename Tensor = dealii::Tensor<1, n_comp, Number2>>
       void add_tensor(const Tensor &tensor, const unsigned int i);
+
+    private:
+      /*
+       * Helpers for accessing a @a Number2 with a value type different
+       * from @p Number (e.g. double vs. float storage, see
+       * Vectors::indicator_number_type) lane by lane:
+       */
+      template <typename Number2>
+      static constexpr unsigned int n_lanes =
+          std::is_arithmetic_v<Number2> ? 1 : simd_length;
+
+      template <typename Number2>
+      DEAL_II_ALWAYS_INLINE static inline auto &lane(Number2 &value,
+                                                     const unsigned int k)
+      {
+        if constexpr (std::is_arithmetic_v<std::remove_const_t<Number2>>)
+          return value;
+        else
+          return value[k];
+      }
+
+      DEAL_II_ALWAYS_INLINE inline bool is_blocked(const unsigned int i) const
+      {
+        return i >= blocked_begin_ && i < blocked_end_;
+      }
+
+      unsigned int blocked_begin_ = 0;
+      unsigned int blocked_end_ = 0;
+
+      mutable const Number *gather_data_ = nullptr;
+      mutable unsigned int gather_stride_ = n_comp;
+
+      dealii::AlignedVector<Number> selected_import_data_;
+      std::vector<MPI_Request> selected_requests_;
     };
 
 
 #ifndef DOXYGEN
     /* Template definitions: */
 
-    template <typename Number, int n_comp, int simd_length>
-    void MultiComponentVector<Number, n_comp, simd_length>::
+    template <typename Number, int n_comp, int simd_length, typename Layout>
+    void MultiComponentVector<Number, n_comp, simd_length, Layout>::
         reinit_with_scalar_partitioner(
             const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
                 &scalar_partitioner)
@@ -201,12 +409,15 @@ namespace ryujin
 
       dealii::LinearAlgebra::distributed::Vector<Number>::reinit(
           vector_partitioner);
+
+      NUMA::first_touch_vector(*this, n_comp, simd_length);
     }
 
 
-    template <typename Number, int n_comp, int simd_length>
-    void MultiComponentVector<Number, n_comp, simd_length>::extract_component(
-        ScalarVector &scalar_vector, unsigned int component) const
+    template <typename Number, int n_comp, int simd_length, typename Layout>
+    void MultiComponentVector<Number, n_comp, simd_length, Layout>::
+        extract_component(ScalarVector &scalar_vector,
+                          unsigned int component) const
     {
       Assert(n_comp > 0,
              dealii::ExcMessage(
@@ -220,14 +431,15 @@ namespace ryujin
           scalar_vector.get_partitioner()->locally_owned_size();
       for (unsigned int i = 0; i < local_size; ++i)
         scalar_vector.local_element(i) =
-            this->local_element(i * n_comp + component);
+            this->local_element(element_index(i, component));
       scalar_vector.update_ghost_values();
     }
 
 
-    template <typename Number, int n_comp, int simd_length>
-    void MultiComponentVector<Number, n_comp, simd_length>::insert_component(
-        const ScalarVector &scalar_vector, unsigned int component)
+    template <typename Number, int n_comp, int simd_length, typename Layout>
+    void MultiComponentVector<Number, n_comp, simd_length, Layout>::
+        insert_component(const ScalarVector &scalar_vector,
+                         unsigned int component)
     {
       Assert(n_comp > 0,
              dealii::ExcMessage(
@@ -240,16 +452,60 @@ namespace ryujin
       const auto local_size =
           scalar_vector.get_partitioner()->locally_owned_size();
       for (unsigned int i = 0; i < local_size; ++i)
-        this->local_element(i * n_comp + component) =
+        this->local_element(element_index(i, component)) =
             scalar_vector.local_element(i);
     }
 
+
+    template <typename Number, int n_comp, int simd_length, typename Layout>
+    void MultiComponentVector<Number, n_comp, simd_length, Layout>::
+        update_selected_ghost_values_start(
+            const unsigned int communication_channel,
+            const dealii::Utilities::MPI::Partitioner &ghost_partitioner)
+    {
+      const auto &partitioner = *this->get_partitioner();
+      Assert(ghost_partitioner.locally_owned_size() ==
+                     partitioner.locally_owned_size() &&
+                 ghost_partitioner.n_ghost_indices() <=
+                     partitioner.n_ghost_indices(),
+             dealii::ExcMessage("Called with a ghost_partitioner argument "
+                                "that has an incompatible index range."));
+
+      selected_import_data_.resize_fast(ghost_partitioner.n_import_indices());
+
+      Number *values = this->begin();
+      const unsigned int n_owned = partitioner.locally_owned_size();
+      ghost_partitioner.export_to_ghosted_array_start<Number>(
+          communication_channel,
+          dealii::ArrayView<const Number>(values, n_owned),
+          dealii::make_array_view(selected_import_data_),
+          dealii::ArrayView<Number>(values + n_owned,
+                                    partitioner.n_ghost_indices()),
+          selected_requests_);
+    }
+
+
+    template <typename Number, int n_comp, int simd_length, typename Layout>
+    void MultiComponentVector<Number, n_comp, simd_length, Layout>::
+        update_selected_ghost_values_finish(
+            const dealii::Utilities::MPI::Partitioner &ghost_partitioner)
+    {
+      const auto &partitioner = *this->get_partitioner();
+
+      Number *values = this->begin();
+      const unsigned int n_owned = partitioner.locally_owned_size();
+      ghost_partitioner.export_to_ghosted_array_finish(
+          dealii::ArrayView<Number>(values + n_owned,
+                                    partitioner.n_ghost_indices()),
+          selected_requests_);
+    }
+
     /* Inline function  definitions: */
 
-    template <typename Number, int n_comp, int simd_length>
+    template <typename Number, int n_comp, int simd_length, typename Layout>
     template <typename Number2, typename Tensor>
     DEAL_II_ALWAYS_INLINE inline Tensor
-    MultiComponentVector<Number, n_comp, simd_length>::get_tensor(
+    MultiComponentVector<Number, n_comp, simd_length, Layout>::get_tensor(
         const unsigned int i) const
     {
       static_assert(std::is_same<Number2, typename Tensor::value_type>::value,
@@ -260,14 +516,32 @@ namespace ryujin
       if constexpr (n_comp == 0)
         return tensor;
 
+      if constexpr (!std::is_same_v<typename get_value_type<Number2>::type,
+                                    Number>) {
+        /* Mixed precision access, convert lane by lane: */
+        for (unsigned int d = 0; d < n_comp; ++d)
+          for (unsigned int k = 0; k < n_lanes<Number2>; ++k)
+            lane(tensor[d], k) = this->local_element(element_index(i + k, d));
+        return tensor;
+      }
+
       if constexpr (std::is_same<Number, Number2>::value) {
         /* Non-vectorized sequential access. */
 
         for (unsigned int d = 0; d < n_comp; ++d)
-          tensor[d] = this->local_element(i * n_comp + d);
+          tensor[d] = this->local_element(element_index(i, d));
 
       } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
 
+        if constexpr (std::is_same_v<Layout, BlockedLayout>) {
+          if (is_blocked(i)) {
+            /* Blocked layout: one aligned vector load per component */
+            for (unsigned int d = 0; d < n_comp; ++d)
+              tensor[d].load(this->begin() + i * n_comp + d * simd_length);
+            return tensor;
+          }
+        }
+
         /* Vectorized fast access. index must be divisible by simd_length */
         std::array<unsigned int, VectorizedArray::size()> indices;
         for (unsigned int k = 0; k < VectorizedArray::size(); ++k)
@@ -285,10 +559,10 @@ namespace ryujin
     }
 
 
-    template <typename Number, int n_comp, int simd_length>
+    template <typename Number, int n_comp, int simd_length, typename Layout>
     template <typename Number2, typename Tensor>
     DEAL_II_ALWAYS_INLINE inline Tensor
-    MultiComponentVector<Number, n_comp, simd_length>::get_tensor(
+    MultiComponentVector<Number, n_comp, simd_length, Layout>::get_tensor(
         const unsigned int *js) const
     {
       static_assert(std::is_same<Number2, typename Tensor::value_type>::value,
@@ -299,13 +573,48 @@ namespace ryujin
       if constexpr (n_comp == 0)
         return tensor;
 
+      if constexpr (!std::is_same_v<typename get_value_type<Number2>::type,
+                                    Number>) {
+        /* Mixed precision access, convert lane by lane: */
+        for (unsigned int d = 0; d < n_comp; ++d)
+          for (unsigned int k = 0; k < n_lanes<Number2>; ++k)
+            lane(tensor[d], k) = this->local_element(element_index(js[k], d));
+        return tensor;
+      }
+
       if constexpr (std::is_same<Number, Number2>::value) {
         /* Non-vectorized sequential access. */
 
+        if (gather_data_ != nullptr) {
+          for (unsigned int d = 0; d < n_comp; ++d)
+            tensor[d] = gather_data_[js[0] * gather_stride_ + d];
+          return tensor;
+        }
+
         for (unsigned int d = 0; d < n_comp; ++d)
-          tensor[d] = this->local_element(js[0] * n_comp + d);
+          tensor[d] = this->local_element(element_index(js[0], d));
 
       } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+
+        if (gather_data_ != nullptr) {
+          /* Co-located copy, see set_gather_source() */
+          std::array<unsigned int, VectorizedArray::size()> indices;
+          for (unsigned int k = 0; k < VectorizedArray::size(); ++k)
+            indices[k] = js[k] * gather_stride_;
+
+          dealii::vectorized_load_and_transpose(
+              n_comp, gather_data_, indices.data(), &tensor[0]);
+          return tensor;
+        }
+
+        if constexpr (std::is_same_v<Layout, BlockedLayout>) {
+          /* Blocked layout: gather every lane individually */
+          for (unsigned int k = 0; k < VectorizedArray::size(); ++k)
+            for (unsigned int d = 0; d < n_comp; ++d)
+              tensor[d][k] = this->local_element(element_index(js[k], d));
+          return tensor;
+        }
+
         /* Vectorized fast access. index must be divisible by simd_length */
 
         std::array<unsigned int, VectorizedArray::size()> indices;
@@ -324,10 +633,37 @@ namespace ryujin
     }
 
 
-    template <typename Number, int n_comp, int simd_length>
+    template <typename Number, int n_comp, int simd_length, typename Layout>
+    template <typename Number2>
+    DEAL_II_ALWAYS_INLINE inline void
+    MultiComponentVector<Number, n_comp, simd_length, Layout>::prefetch(
+        const unsigned int *js) const
+    {
+      /* Special case of a zero component vector */
+      if constexpr (n_comp == 0)
+        return;
+
+      for (unsigned int k = 0; k < n_lanes<Number2>; ++k) {
+        /* First and last component might lie on different cache lines: */
+        const Number *first;
+        const Number *last;
+        if (gather_data_ != nullptr) {
+          first = gather_data_ + js[k] * gather_stride_;
+          last = first + (n_comp - 1);
+        } else {
+          first = this->begin() + element_index(js[k], 0);
+          last = this->begin() + element_index(js[k], n_comp - 1);
+        }
+        __builtin_prefetch(first, 0 /* read */, 3 /* high locality */);
+        __builtin_prefetch(last, 0 /* read */, 3 /* high locality */);
+      }
+    }
+
+
+    template <typename Number, int n_comp, int simd_length, typename Layout>
     template <typename Number2, typename Tensor>
     DEAL_II_ALWAYS_INLINE inline void
-    MultiComponentVector<Number, n_comp, simd_length>::write_tensor(
+    MultiComponentVector<Number, n_comp, simd_length, Layout>::write_tensor(
         const Tensor &tensor, const unsigned int i)
     {
       static_assert(std::is_same<Number2, typename Tensor::value_type>::value,
@@ -337,13 +673,33 @@ namespace ryujin
       if constexpr (n_comp == 0)
         return;
 
+      if constexpr (!std::is_same_v<typename get_value_type<Number2>::type,
+                                    Number>) {
+        /* Mixed precision access, convert lane by lane: */
+        for (unsigned int d = 0; d < n_comp; ++d)
+          for (unsigned int k = 0; k < n_lanes<Number2>; ++k)
+            this->local_element(element_index(i + k, d)) =
+                Number(lane(tensor[d], k));
+        return;
+      }
+
       if constexpr (std::is_same<Number, Number2>::value) {
         /* Non-vectorized sequential access. */
 
         for (unsigned int d = 0; d < n_comp; ++d)
-          this->local_element(i * n_comp + d) = tensor[d];
+          this->local_element(element_index(i, d)) = tensor[d];
 
       } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+
+        if constexpr (std::is_same_v<Layout, BlockedLayout>) {
+          if (is_blocked(i)) {
+            /* Blocked layout: one aligned vector store per component */
+            for (unsigned int d = 0; d < n_comp; ++d)
+              tensor[d].store(this->begin() + i * n_comp + d * simd_length);
+            return;
+          }
+        }
+
         /* Vectorized fast access. index must be divisible by simd_length */
 
         std::array<unsigned int, VectorizedArray::size()> indices;
@@ -363,10 +719,10 @@ namespace ryujin
     }
 
 
-    template <typename Number, int n_comp, int simd_length>
+    template <typename Number, int n_comp, int simd_length, typename Layout>
     template <typename Number2, typename Tensor>
     DEAL_II_ALWAYS_INLINE inline void
-    MultiComponentVector<Number, n_comp, simd_length>::add_tensor(
+    MultiComponentVector<Number, n_comp, simd_length, Layout>::add_tensor(
         const Tensor &tensor, const unsigned int i)
     {
       static_assert(std::is_same<Number2, typename Tensor::value_type>::value,
@@ -380,9 +736,25 @@ namespace ryujin
         /* Non-vectorized sequential access. */
 
         for (unsigned int d = 0; d < n_comp; ++d)
-          this->local_element(i * n_comp + d) += tensor[d];
+          this->local_element(element_index(i, d)) += tensor[d];
 
       } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+
+        if constexpr (std::is_same_v<Layout, BlockedLayout>) {
+          if (is_blocked(i)) {
+            /* Blocked layout: one vector load and store per component */
+            for (unsigned int d = 0; d < n_comp; ++d) {
+              const auto position =
+                  this->begin() + i * n_comp + d * simd_length;
+              VectorizedArray value;
+              value.load(position);
+              value += tensor[d];
+              value.store(position);
+            }
+            return;
+          }
+        }
+
         /* Vectorized fast access. index must be divisible by simd_length */
 
         std::array<unsigned int, VectorizedArray::size()> indices;
@@ -13,5 +13,11 @@ namespace ryujin
     template class ParabolicSolver<Description, 1, NUMBER>;
     template class ParabolicSolver<Description, 2, NUMBER>;
     template class ParabolicSolver<Description, 3, NUMBER>;
+
+#ifdef PRECISION_SWITCH
+    template class ParabolicSolver<Description, 1, float>;
+    template class ParabolicSolver<Description, 2, float>;
+    template class ParabolicSolver<Description, 3, float>;
+#endif
   } // namespace NavierStokes
 } // namespace ryujin
@@ -31,6 +31,9 @@
 #include <deal.II/multigrid/mg_smoother.h>
 #include <deal.II/multigrid/mg_transfer_matrix_free.h>
 
+#include <type_traits>
+#include <vector>
+
 namespace ryujin
 {
   namespace NavierStokes
@@ -213,6 +216,9 @@ namespace ryujin
 
       Number tolerance_;
       bool tolerance_linfty_norm_;
+      bool pipelined_cg_;
+      bool mixed_precision_;
+      double mixed_precision_reduction_;
 
       unsigned int gmg_max_iter_vel_;
       unsigned int gmg_max_iter_en_;
@@ -222,7 +228,17 @@ namespace ryujin
       double gmg_smoother_max_eig_en_;
       unsigned int gmg_smoother_degree_;
       unsigned int gmg_smoother_n_cg_iter_;
+      double gmg_eigenvalue_tolerance_;
+      unsigned int chebyshev_degree_;
+      double chebyshev_range_;
       unsigned int gmg_min_level_;
+      unsigned int gmg_coarse_cg_iter_;
+      double gmg_coarse_cg_reduction_;
+      bool gmg_smoother_auto_tuning_;
+      std::vector<unsigned int> gmg_smoother_tuning_degrees_;
+      std::vector<double> gmg_smoother_tuning_ranges_;
+      bool super_time_stepping_;
+      unsigned int super_time_stepping_max_stages_;
 
       //@}
       /**
@@ -249,6 +265,7 @@ namespace ryujin
       mutable unsigned int n_warnings_;
       mutable double n_iterations_velocity_;
       mutable double n_iterations_internal_energy_;
+      mutable double n_reductions_;
 
       mutable dealii::MatrixFree<dim, Number> matrix_free_;
 
@@ -258,6 +275,13 @@ namespace ryujin
       mutable ScalarVector internal_energy_rhs_;
       mutable ScalarVector density_;
 
+      /* Mixed precision: */
+      mutable dealii::MatrixFree<dim, float> matrix_free_float_;
+      mutable dealii::LinearAlgebra::distributed::Vector<float>
+          lumped_mass_matrix_float_;
+      mutable dealii::LinearAlgebra::distributed::Vector<float>
+          density_float_;
+
       mutable dealii::MGLevelObject<dealii::MatrixFree<dim, float>>
           level_matrix_free_;
       mutable dealii::MGConstrainedDoFs mg_constrained_dofs_;
@@ -286,6 +310,95 @@ namespace ryujin
           dealii::LinearAlgebra::distributed::Vector<float>>
           mg_smoother_energy_;
 
+      /*
+       * Eigenvalue estimates of the Chebyshev smoothers and the time-step
+       * size they have been computed for:
+       */
+      mutable Number gmg_eigenvalue_tau_velocity_;
+      mutable dealii::MGLevelObject<double> gmg_max_eigenvalues_velocity_;
+      mutable Number gmg_eigenvalue_tau_energy_;
+      mutable dealii::MGLevelObject<double> gmg_max_eigenvalues_energy_;
+
+      /*
+       * Auto tuning of the Chebyshev smoother: Every candidate, i.e.,
+       * every combination of a degree and a range, is used for one
+       * implicit solve and its wall time is recorded. Afterwards, the
+       * cheapest candidate is locked in.
+       */
+      struct SmootherTuning {
+        unsigned int candidate;   /* currently tried candidate */
+        std::vector<double> cost; /* measured wall time per candidate */
+        unsigned int degree;      /* degree currently in use */
+        double range;             /* range currently in use */
+        bool update;              /* smoother needs to be set up again */
+      };
+
+      void initialize_smoother_tuning(SmootherTuning &tuning,
+                                      const double range) const;
+      void record_smoother_tuning(SmootherTuning &tuning,
+                                  const double wall_time) const;
+
+      mutable SmootherTuning smoother_tuning_velocity_;
+      mutable SmootherTuning smoother_tuning_energy_;
+
+      /*
+       * Explicit super time stepping: Advance the parabolic subproblem
+       * with a second order Runge-Kutta-Legendre (RKL2) scheme instead of
+       * an implicit solve. The function returns false (and leaves
+       * @p new_state_vector untouched) if the number of necessary stages
+       * exceeds the configured maximum.
+       */
+      bool super_time_step(const StateVector &old_state_vector,
+                           const Number old_t,
+                           StateVector &new_state_vector,
+                           Number tau,
+                           const IDViolationStrategy id_violation_strategy,
+                           const bool reestimate_eigenvalues) const;
+
+      /*
+       * Compute the viscous heating m_i K_i for a given @p velocity field.
+       */
+      void compute_viscous_heating(ScalarVector &heating,
+                                   const BlockVector &velocity) const;
+
+      /*
+       * All locally owned degrees of freedom (in local numbering) that are
+       * constrained by the AffineConstraints object of the OfflineData
+       * class, i.e., by periodicity or hanging node constraints:
+       */
+      std::vector<unsigned int> constrained_dofs_;
+
+      /*
+       * Zero out all constrained degrees of freedom of all given scalar
+       * and block vectors in a single sweep. This is equivalent to calling
+       * AffineConstraints::set_zero() on every block of every vector.
+       */
+      template <typename... Vectors>
+      void set_zero_constrained(Vectors &...vectors) const
+      {
+        const auto set_zero = [](auto &vector, const unsigned int i) {
+          using VectorType = std::decay_t<decltype(vector)>;
+          if constexpr (std::is_same_v<VectorType, BlockVector>) {
+            for (unsigned int d = 0; d < vector.n_blocks(); ++d)
+              vector.block(d).local_element(i) = Number(0.);
+          } else {
+            vector.local_element(i) = Number(0.);
+          }
+        };
+
+        for (const auto i : constrained_dofs_)
+          (set_zero(vectors, i), ...);
+      }
+
+      /*
+       * Estimates of the largest eigenvalues of the (mass scaled) velocity
+       * and energy operators used for selecting the number of stages:
+       */
+      mutable double sts_max_eigenvalue_velocity_;
+      mutable double sts_max_eigenvalue_energy_;
+      mutable double n_stages_velocity_;
+      mutable double n_stages_internal_energy_;
+
       //@}
     };
 
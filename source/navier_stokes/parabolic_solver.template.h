@@ -6,6 +6,7 @@
 #pragma once
 
 #include "parabolic_solver.h"
+#include "parabolic_solver_pipelined_cg.h"
 
 #include <introspection.h>
 #include <openmp.h>
@@ -30,6 +31,148 @@ namespace ryujin
   {
     using namespace dealii;
 
+    namespace
+    {
+      /**
+       * Solve the linear system @p op x = @p rhs with a mixed-precision
+       * defect correction: The residual and the update of @p x are
+       * computed with @p op in the precision of VectorType, the
+       * correction is computed with an inner (preconditioned) CG iteration
+       * with @p op_float and @p preconditioner entirely in the precision
+       * of FloatVectorType. The inner iteration reduces the defect by a
+       * factor @p reduction. The outer iteration stops as soon as the l2
+       * (or linfty) norm of the residual is below @p tolerance.
+       *
+       * The function returns the total number of inner CG iterations and
+       * throws SolverControl::NoConvergence if the tolerance was not
+       * reached with at most @p max_iterations inner iterations.
+       */
+      template <typename FloatVectorType,
+                typename VectorType,
+                typename Operator,
+                typename FloatOperator,
+                typename Preconditioner>
+      unsigned int defect_correction(const Operator &op,
+                                     const FloatOperator &op_float,
+                                     const Preconditioner &preconditioner,
+                                     VectorType &x,
+                                     const VectorType &rhs,
+                                     const double tolerance,
+                                     const bool linfty_norm,
+                                     const unsigned int max_iterations,
+                                     const double reduction)
+      {
+        VectorType residual;
+        residual.reinit(rhs, /*omit_zeroing_entries*/ true);
+        FloatVectorType residual_float;
+        residual_float.reinit(rhs, /*omit_zeroing_entries*/ true);
+        FloatVectorType correction_float;
+        correction_float.reinit(rhs, /*omit_zeroing_entries*/ true);
+
+        unsigned int n_iterations = 0;
+        for (;;) {
+          /* r = rhs - op x in full precision: */
+          op.vmult(residual, x);
+          residual.sadd(-1., 1., rhs);
+
+          const double norm =
+              linfty_norm ? residual.linfty_norm() : residual.l2_norm();
+          if (norm <= tolerance)
+            return n_iterations;
+
+          if (n_iterations >= max_iterations)
+            throw SolverControl::NoConvergence(n_iterations, norm);
+
+          /* Solve for the correction in reduced precision: */
+          residual_float = residual;
+          correction_float = 0.;
+
+          ReductionControl solver_control(max_iterations - n_iterations,
+                                          0.,
+                                          reduction,
+                                          /*log_history*/ false,
+                                          /*log_result*/ false);
+          SolverCG<FloatVectorType> solver(solver_control);
+          solver.solve(
+              op_float, correction_float, residual_float, preconditioner);
+          n_iterations += std::max(solver_control.last_step(), 1u);
+
+          /* And update the solution in full precision: */
+          residual = correction_float;
+          x += residual;
+        }
+      }
+
+
+      /**
+       * A coarse grid solver for the geometric multigrid that runs a CG
+       * iteration on the coarse level with the coarse level smoother as
+       * preconditioner. The iteration stops after the residual has been
+       * reduced by a factor @p reduction, or after @p max_iterations
+       * steps. In contrast to SolverControl the latter is not considered
+       * a failure.
+       */
+      template <typename VectorType,
+                typename MatrixType,
+                typename PreconditionerType>
+      class MGCoarseGridCG : public MGCoarseGridBase<VectorType>
+      {
+      public:
+        MGCoarseGridCG(const MatrixType &matrix,
+                       const PreconditionerType &preconditioner,
+                       const unsigned int max_iterations,
+                       const double reduction)
+            : matrix_(matrix)
+            , preconditioner_(preconditioner)
+            , max_iterations_(max_iterations)
+            , reduction_(reduction)
+        {
+        }
+
+        void operator()(const unsigned int /*level*/,
+                        VectorType &dst,
+                        const VectorType &src) const override
+        {
+          ReductionControl solver_control(max_iterations_,
+                                          0.,
+                                          reduction_,
+                                          /*log_history*/ false,
+                                          /*log_result*/ false);
+          SolverCG<VectorType> solver(solver_control);
+          dst = 0.;
+          try {
+            solver.solve(matrix_, dst, src, preconditioner_);
+          } catch (const SolverControl::NoConvergence &) {
+            /* Keep the last iterate. */
+          }
+        }
+
+      private:
+        const MatrixType &matrix_;
+        const PreconditionerType &preconditioner_;
+        const unsigned int max_iterations_;
+        const double reduction_;
+      };
+
+
+      /**
+       * Helper function creating an MGCoarseGridCG object for a given
+       * VectorType.
+       */
+      template <typename VectorType,
+                typename MatrixType,
+                typename PreconditionerType>
+      MGCoarseGridCG<VectorType, MatrixType, PreconditionerType>
+      make_coarse_grid_cg(const MatrixType &matrix,
+                          const PreconditionerType &preconditioner,
+                          const unsigned int max_iterations,
+                          const double reduction)
+      {
+        return {matrix, preconditioner, max_iterations, reduction};
+      }
+    } // namespace
+
+
     template <typename Description, int dim, typename Number>
     ParabolicSolver<Description, dim, Number>::ParabolicSolver(
         const MPIEnsemble &mpi_ensemble,
@@ -50,6 +193,13 @@ namespace ryujin
         , n_warnings_(0)
         , n_iterations_velocity_(0.)
         , n_iterations_internal_energy_(0.)
+        , n_reductions_(0.)
+        , gmg_eigenvalue_tau_velocity_(0.)
+        , gmg_eigenvalue_tau_energy_(0.)
+        , sts_max_eigenvalue_velocity_(0.)
+        , sts_max_eigenvalue_energy_(0.)
+        , n_stages_velocity_(0.)
+        , n_stages_internal_energy_(0.)
     {
       use_gmg_velocity_ = false;
       add_parameter("multigrid velocity",
@@ -103,6 +253,31 @@ namespace ryujin
           "Chebyshev smoother: number of CG iterations to approximate "
           "eigenvalue");
 
+      gmg_eigenvalue_tolerance_ = 0.;
+      add_parameter(
+          "multigrid - chebyshev eigenvalue reuse tolerance",
+          gmg_eigenvalue_tolerance_,
+          "Chebyshev smoother: reuse the eigenvalue estimates of the last "
+          "full multigrid setup when updating the level matrices, unless "
+          "the time-step size changed by more than the given relative "
+          "tolerance. A value of 0 re-estimates eigenvalues on every "
+          "update");
+
+      chebyshev_degree_ = 0;
+      add_parameter(
+          "chebyshev preconditioner - degree",
+          chebyshev_degree_,
+          "Degree of a Chebyshev-over-Jacobi preconditioner on the finest "
+          "level that is used instead of the plain diagonal preconditioner "
+          "if multigrid is disabled (or did not converge). It needs no "
+          "multigrid level data. A value of 0 selects the plain diagonal "
+          "preconditioner");
+
+      chebyshev_range_ = 15.;
+      add_parameter("chebyshev preconditioner - range",
+                    chebyshev_range_,
+                    "Chebyshev preconditioner: eigenvalue range parameter");
+
       gmg_min_level_ = 0;
       add_parameter(
           "multigrid - min level",
@@ -110,6 +285,60 @@ namespace ryujin
           "Minimal mesh level to be visited in the geometric multigrid "
           "cycle where the coarse grid solver (Chebyshev) is called");
 
+      gmg_coarse_cg_iter_ = 0;
+      add_parameter(
+          "multigrid - coarse grid cg iter",
+          gmg_coarse_cg_iter_,
+          "Maximal number of iterations of a CG coarse grid solver that is "
+          "preconditioned with the Chebyshev smoother of the coarse level. "
+          "This keeps the number of multigrid iterations independent of "
+          "the size of large coarse meshes. A value of 0 applies the "
+          "Chebyshev smoother once instead");
+
+      gmg_coarse_cg_reduction_ = 1.e-2;
+      add_parameter("multigrid - coarse grid cg reduction",
+                    gmg_coarse_cg_reduction_,
+                    "CG coarse grid solver: relative residual reduction");
+
+      gmg_smoother_auto_tuning_ = false;
+      add_parameter(
+          "multigrid - chebyshev auto tuning",
+          gmg_smoother_auto_tuning_,
+          "Chebyshev smoother: auto tune the degree and the range of the "
+          "smoother. During the first implicit steps every combination of "
+          "the candidate degrees and ranges is used for one solve, "
+          "afterwards the combination with the smallest wall time "
+          "(iterations times cost per iteration) is locked in. The "
+          "configured degree and ranges are ignored in this case");
+
+      gmg_smoother_tuning_degrees_ = {2, 3, 4, 5};
+      add_parameter("multigrid - chebyshev auto tuning degrees",
+                    gmg_smoother_tuning_degrees_,
+                    "Chebyshev smoother auto tuning: candidate degrees");
+
+      gmg_smoother_tuning_ranges_ = {5., 8., 15., 20.};
+      add_parameter("multigrid - chebyshev auto tuning ranges",
+                    gmg_smoother_tuning_ranges_,
+                    "Chebyshev smoother auto tuning: candidate ranges");
+
+      super_time_stepping_ = false;
+      add_parameter(
+          "super time stepping",
+          super_time_stepping_,
+          "Advance the parabolic subproblem explicitly with a second order "
+          "Runge-Kutta-Legendre (RKL2) super time stepping scheme instead of "
+          "solving the implicit linear systems. The number of stages is "
+          "chosen from an estimate of the largest eigenvalue of the "
+          "operators. This is intended for weakly viscous flows and the "
+          "\"strang ... cn\" time stepping schemes");
+
+      super_time_stepping_max_stages_ = 50;
+      add_parameter(
+          "super time stepping - max stages",
+          super_time_stepping_max_stages_,
+          "Super time stepping: maximal number of RKL2 stages. If more "
+          "stages would be necessary the implicit solver is used instead");
+
       tolerance_ = Number(1.0e-12);
       add_parameter("tolerance", tolerance_, "Tolerance for linear solvers");
 
@@ -118,6 +347,31 @@ namespace ryujin
                     tolerance_linfty_norm_,
                     "Use the l_infty norm instead of the l_2 norm for the "
                     "stopping criterion");
+
+      pipelined_cg_ = false;
+      add_parameter("pipelined cg",
+                    pipelined_cg_,
+                    "Use a pipelined conjugate gradient method that performs "
+                    "a single (non-blocking) global reduction per iteration "
+                    "instead of the classical variant with two reductions "
+                    "per iteration");
+
+      mixed_precision_ = false;
+      add_parameter(
+          "mixed precision",
+          mixed_precision_,
+          "Solve the velocity and internal energy updates with multigrid in "
+          "a mixed-precision defect correction: the inner CG iteration and "
+          "the multigrid preconditioner run entirely in single precision, "
+          "residuals and solution updates are computed in full precision. "
+          "The outer iteration uses the stopping criterion configured by "
+          "\"tolerance\" and \"tolerance linfty norm\"");
+
+      mixed_precision_reduction_ = 1.0e-3;
+      add_parameter("mixed precision - inner reduction",
+                    mixed_precision_reduction_,
+                    "Mixed precision: reduction of the defect by the inner "
+                    "single precision CG iteration in every outer step");
     }
 
 
@@ -148,6 +402,22 @@ namespace ryujin
       const auto &scalar_partitioner =
           matrix_free_.get_dof_info(0).vector_partitioner;
 
+      if (mixed_precision_) {
+        typename MatrixFree<dim, float>::AdditionalData additional_data_float;
+        additional_data_float.tasks_parallel_scheme =
+            MatrixFree<dim, float>::AdditionalData::none;
+
+        matrix_free_float_.reinit(discretization.mapping(),
+                                  offline_data_->dof_handler(),
+                                  offline_data_->affine_constraints(),
+                                  discretization.quadrature_1d(),
+                                  additional_data_float);
+
+        lumped_mass_matrix_float_.reinit(scalar_partitioner);
+        lumped_mass_matrix_float_ = offline_data_->lumped_mass_matrix();
+        density_float_.reinit(scalar_partitioner);
+      }
+
       velocity_.reinit(dim);
       velocity_rhs_.reinit(dim);
       for (unsigned int i = 0; i < dim; ++i) {
@@ -160,11 +430,35 @@ namespace ryujin
 
       density_.reinit(scalar_partitioner);
 
+      /* Record all locally owned, constrained degrees of freedom: */
+
+      constrained_dofs_.clear();
+      const auto &locally_owned =
+          offline_data_->dof_handler().locally_owned_dofs();
+      for (const auto &line : offline_data_->affine_constraints().get_lines())
+        if (locally_owned.is_element(line.index))
+          constrained_dofs_.push_back(
+              locally_owned.index_within_set(line.index));
+
+      /* Initialize (and restart) auto tuning of the Chebyshev smoother: */
+
+      initialize_smoother_tuning(smoother_tuning_velocity_,
+                                 gmg_smoother_range_vel_);
+      initialize_smoother_tuning(smoother_tuning_energy_,
+                                 gmg_smoother_range_en_);
+
+      /* Invalidate eigenvalue estimates for super time stepping: */
+      sts_max_eigenvalue_velocity_ = 0.;
+      sts_max_eigenvalue_energy_ = 0.;
+
       /* Initialize multigrid: */
 
       if (!use_gmg_velocity_ && !use_gmg_internal_energy_)
         return;
 
+      /* Distributes level dofs and creates the level data on first call: */
+      offline_data_->level_boundary_map();
+
       const unsigned int n_levels =
           offline_data_->dof_handler().get_triangulation().n_global_levels();
       const unsigned int min_level = std::min(gmg_min_level_, n_levels - 1);
@@ -205,6 +499,548 @@ namespace ryujin
                                   level_matrix_free_);
       mg_transfer_energy_.build(offline_data_->dof_handler(),
                                 level_matrix_free_);
+
+      /* Invalidate eigenvalue estimates: */
+      gmg_eigenvalue_tau_velocity_ = Number(0.);
+      gmg_eigenvalue_tau_energy_ = Number(0.);
+      gmg_max_eigenvalues_velocity_.resize(min_level, n_levels - 1);
+      gmg_max_eigenvalues_energy_.resize(min_level, n_levels - 1);
+    }
+
+
+    template <typename Description, int dim, typename Number>
+    void ParabolicSolver<Description, dim, Number>::initialize_smoother_tuning(
+        SmootherTuning &tuning, const double range) const
+    {
+      tuning.candidate = 0;
+      tuning.degree = gmg_smoother_degree_;
+      tuning.range = range;
+      tuning.update = false;
+      tuning.cost.clear();
+
+      if (!gmg_smoother_auto_tuning_)
+        return;
+
+      AssertThrow(!gmg_smoother_tuning_degrees_.empty() &&
+                      !gmg_smoother_tuning_ranges_.empty(),
+                  dealii::ExcMessage("Chebyshev smoother auto tuning "
+                                     "requires at least one candidate "
+                                     "degree and range."));
+
+      tuning.cost.resize(gmg_smoother_tuning_degrees_.size() *
+                             gmg_smoother_tuning_ranges_.size(),
+                         std::numeric_limits<double>::max());
+      tuning.degree = gmg_smoother_tuning_degrees_[0];
+      tuning.range = gmg_smoother_tuning_ranges_[0];
+      tuning.update = true;
+    }
+
+
+    template <typename Description, int dim, typename Number>
+    void ParabolicSolver<Description, dim, Number>::record_smoother_tuning(
+        SmootherTuning &tuning, const double wall_time) const
+    {
+      if (tuning.candidate >= tuning.cost.size())
+        return;
+
+      /* Use the maximal wall time so that all ranks agree on the choice: */
+      tuning.cost[tuning.candidate++] =
+          Utilities::MPI::max(wall_time, mpi_ensemble_.ensemble_communicator());
+
+      unsigned int next = tuning.candidate;
+      if (next == tuning.cost.size()) {
+        /* All candidates have been tried, lock in the cheapest one: */
+        next = std::distance(
+            tuning.cost.begin(),
+            std::min_element(tuning.cost.begin(), tuning.cost.end()));
+      }
+
+      const auto n_ranges = gmg_smoother_tuning_ranges_.size();
+      tuning.degree = gmg_smoother_tuning_degrees_[next / n_ranges];
+      tuning.range = gmg_smoother_tuning_ranges_[next % n_ranges];
+      tuning.update = true;
+    }
+
+
+    template <typename Description, int dim, typename Number>
+    void ParabolicSolver<Description, dim, Number>::compute_viscous_heating(
+        ScalarVector &heating, const BlockVector &velocity) const
+    {
+      matrix_free_.template cell_loop<ScalarVector, BlockVector>(
+          [this](const auto &data,
+                 auto &dst,
+                 const auto &src,
+                 const auto cell_range) {
+            FEEvaluation<dim, order_fe, order_quad, dim, Number> velocity(
+                data);
+            FEEvaluation<dim, order_fe, order_quad, 1, Number> energy(data);
+
+            const auto mu = parabolic_system_->mu();
+            const auto lambda = parabolic_system_->lambda();
+
+            for (unsigned int cell = cell_range.first;
+                 cell < cell_range.second;
+                 ++cell) {
+              velocity.reinit(cell);
+              energy.reinit(cell);
+              velocity.gather_evaluate(src, EvaluationFlags::gradients);
+
+              for (unsigned int q = 0; q < velocity.n_q_points; ++q) {
+                if constexpr (dim == 1) {
+                  /* Workaround: no symmetric gradient for dim == 1: */
+                  const auto gradient = velocity.get_gradient(q);
+                  auto S = (4. / 3. * mu + lambda) * gradient;
+                  energy.submit_value(gradient * S, q);
+
+                } else {
+
+                  const auto symmetric_gradient =
+                      velocity.get_symmetric_gradient(q);
+                  const auto divergence = trace(symmetric_gradient);
+                  auto S = 2. * mu * symmetric_gradient;
+                  for (unsigned int d = 0; d < dim; ++d)
+                    S[d][d] += (lambda - 2. / 3. * mu) * divergence;
+                  energy.submit_value(symmetric_gradient * S, q);
+                }
+              }
+              energy.integrate_scatter(EvaluationFlags::values, dst);
+            }
+          },
+          heating,
+          velocity,
+          /* zero destination */ true);
+    }
+
+
+    template <typename Description, int dim, typename Number>
+    bool ParabolicSolver<Description, dim, Number>::super_time_step(
+        const StateVector &old_state_vector,
+        const Number t,
+        StateVector &new_state_vector,
+        Number tau,
+        const IDViolationStrategy id_violation_strategy,
+        const bool reestimate_eigenvalues) const
+    {
+#ifdef DEBUG_OUTPUT
+      std::cout << "ParabolicSolver<dim, Number>::super_time_step()"
+                << std::endl;
+#endif
+
+      const auto &old_U = std::get<0>(old_state_vector);
+      auto &new_U = std::get<0>(new_state_vector);
+
+      using VA = VectorizedArrayType<Number>;
+
+      const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
+      const auto &affine_constraints = offline_data_->affine_constraints();
+      const auto &boundary_map = offline_data_->boundary_map();
+
+      constexpr auto simd_length = VA::size();
+      const unsigned int n_owned = offline_data_->n_locally_owned();
+      const unsigned int n_regular = n_owned / simd_length * simd_length;
+
+      /*
+       * The Strang splitting extrapolates the result W of this function
+       * to the Crank-Nicolson update 2 W - U^n over 2 tau. We thus
+       * advance the parabolic subproblem explicitly over 2 tau and return
+       * the average of U^n and the new state:
+       */
+      const Number tau_total = Number(2.) * tau;
+
+      /*
+       * Step 0: Set up density, velocity and internal energy and enforce
+       * boundary conditions exactly as for the implicit solve:
+       */
+      {
+        Scope scope(computing_timer_, "time step [P] 1 - update velocities");
+
+        RYUJIN_PARALLEL_REGION_BEGIN
+
+        auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+          using T = decltype(sentinel);
+          unsigned int stride_size = get_stride_size<T>;
+
+          const auto view = hyperbolic_system_->template view<dim, T>();
+
+          RYUJIN_OMP_FOR
+          for (unsigned int i = left; i < right; i += stride_size) {
+            const auto U_i = old_U.template get_tensor<T>(i);
+            const auto rho_i = view.density(U_i);
+            const auto M_i = view.momentum(U_i);
+            const auto rho_e_i = view.internal_energy(U_i);
+
+            write_entry<T>(density_, rho_i, i);
+            for (unsigned int d = 0; d < dim; ++d)
+              write_entry<T>(velocity_.block(d), M_i[d] / rho_i, i);
+            write_entry<T>(internal_energy_, rho_e_i / rho_i, i);
+          }
+        };
+
+        /* Parallel non-vectorized loop: */
+        loop(Number(), n_regular, n_owned);
+        /* Parallel vectorized SIMD loop: */
+        loop(VA(), 0, n_regular);
+
+        RYUJIN_PARALLEL_REGION_END
+
+        for (auto entry : boundary_map) {
+          // [i, normal, normal_mass, boundary_mass, id, position] = entry
+          const auto i = std::get<0>(entry);
+          if (i >= n_owned)
+            continue;
+
+          const auto normal = std::get<1>(entry);
+          const auto id = std::get<4>(entry);
+          const auto position = std::get<5>(entry);
+
+          if (id == Boundary::slip) {
+            /* Remove normal component of velocity: */
+            Tensor<1, dim, Number> V_i;
+            for (unsigned int d = 0; d < dim; ++d)
+              V_i[d] = velocity_.block(d).local_element(i);
+            V_i -= 1. * (V_i * normal) * normal;
+            for (unsigned int d = 0; d < dim; ++d)
+              velocity_.block(d).local_element(i) = V_i[d];
+
+          } else if (id == Boundary::no_slip) {
+
+            /* Set velocity to zero: */
+            for (unsigned int d = 0; d < dim; ++d)
+              velocity_.block(d).local_element(i) = Number(0.);
+
+          } else if (id == Boundary::dirichlet) {
+
+            /* Prescribe velocity and internal energy: */
+            const auto U_i =
+                initial_values_->initial_state(position, t + tau_total);
+            const auto view = hyperbolic_system_->template view<dim, Number>();
+            const auto rho_i = view.density(U_i);
+            const auto V_i = view.momentum(U_i) / rho_i;
+            const auto e_i = view.internal_energy(U_i) / rho_i;
+
+            for (unsigned int d = 0; d < dim; ++d)
+              velocity_.block(d).local_element(i) = V_i[d];
+            internal_energy_.local_element(i) = e_i;
+          }
+        }
+
+        set_zero_constrained(density_, internal_energy_, velocity_);
+      }
+
+      Number e_min_old;
+
+      {
+        Scope scope(computing_timer_,
+                    "time step [P] _ - synchronization barriers");
+
+        // .begin() and .end() denote the locally owned index range:
+        e_min_old =
+            *std::min_element(internal_energy_.begin(), internal_energy_.end());
+        e_min_old = Utilities::MPI::min(e_min_old,
+                                        mpi_ensemble_.ensemble_communicator());
+
+        constexpr Number eps = std::numeric_limits<Number>::epsilon();
+        e_min_old *= (1. - 1000. * eps);
+      }
+
+      /*
+       * The (mass scaled) operators -(m_i rho_i)^{-1} B: We apply the
+       * matrix-free operators with a unit time-step size and remove the
+       * mass contribution again. The update vanishes on degrees of
+       * freedom with strongly enforced boundary conditions:
+       */
+
+      DiagonalMatrix<dim, Number> inverse_mass;
+      inverse_mass.reinit(lumped_mass_matrix, density_, affine_constraints);
+
+      VelocityMatrix<dim, Number, Number> velocity_operator;
+      velocity_operator.initialize(*parabolic_system_,
+                                   *offline_data_,
+                                   matrix_free_,
+                                   density_,
+                                   Number(1.));
+
+      const auto apply_velocity = [&](BlockVector &dst,
+                                      const BlockVector &src) {
+        velocity_operator.vmult(dst, src);
+        inverse_mass.vmult(dst, dst);
+        dst.sadd(Number(-1.), Number(1.), src);
+
+        for (auto entry : boundary_map) {
+          const auto i = std::get<0>(entry);
+          if (i >= n_owned)
+            continue;
+
+          const auto normal = std::get<1>(entry);
+          const auto id = std::get<4>(entry);
+
+          if (id == Boundary::slip) {
+            Tensor<1, dim, Number> V_i;
+            for (unsigned int d = 0; d < dim; ++d)
+              V_i[d] = dst.block(d).local_element(i);
+            V_i -= 1. * (V_i * normal) * normal;
+            for (unsigned int d = 0; d < dim; ++d)
+              dst.block(d).local_element(i) = V_i[d];
+          } else if (id == Boundary::no_slip || id == Boundary::dirichlet) {
+            for (unsigned int d = 0; d < dim; ++d)
+              dst.block(d).local_element(i) = Number(0.);
+          }
+        }
+
+        set_zero_constrained(dst);
+      };
+
+      EnergyMatrix<dim, Number, Number> energy_operator;
+      energy_operator.initialize(*offline_data_,
+                                 matrix_free_,
+                                 density_,
+                                 parabolic_system_->cv_inverse_kappa());
+
+      const auto apply_energy = [&](ScalarVector &dst,
+                                    const ScalarVector &src) {
+        energy_operator.vmult(dst, src);
+        inverse_mass.vmult(dst, dst);
+        dst.sadd(Number(-1.), Number(1.), src);
+
+        for (auto entry : boundary_map) {
+          const auto i = std::get<0>(entry);
+          if (i >= n_owned)
+            continue;
+
+          const auto id = std::get<4>(entry);
+          if (id == Boundary::dirichlet)
+            dst.local_element(i) = Number(0.);
+        }
+
+        set_zero_constrained(dst);
+      };
+
+      /*
+       * Estimate the largest eigenvalue of the operators with a few steps
+       * of a power iteration. The estimates are only updated when the
+       * multigrid data would have been set up again:
+       */
+
+      const auto estimate_max_eigenvalue = [&](auto x, const auto &apply) {
+        using VectorType = decltype(x);
+
+        /* Start with an oscillatory vector: */
+        if constexpr (std::is_same_v<VectorType, BlockVector>) {
+          for (unsigned int d = 0; d < dim; ++d)
+            for (unsigned int i = 0; i < n_owned; ++i)
+              x.block(d).local_element(i) = (i + d) % 2 ? 1. : -1.;
+        } else {
+          for (unsigned int i = 0; i < n_owned; ++i)
+            x.local_element(i) = i % 2 ? 1. : -1.;
+        }
+
+        VectorType y;
+        y.reinit(x, /*omit_zeroing_entries*/ true);
+
+        double lambda = 0.;
+        for (unsigned int k = 0; k < 20; ++k) {
+          const auto norm = x.l2_norm();
+          if (norm == Number(0.))
+            break;
+          x /= norm;
+          apply(y, x);
+          lambda = y.l2_norm();
+          x.swap(y);
+        }
+
+        /* Safety factor for the underestimated eigenvalue: */
+        return 1.2 * lambda;
+      };
+
+      if (reestimate_eigenvalues || sts_max_eigenvalue_velocity_ == 0.) {
+        Scope scope(computing_timer_, "time step [P] 1 - update velocities");
+        sts_max_eigenvalue_velocity_ =
+            estimate_max_eigenvalue(velocity_, apply_velocity);
+        sts_max_eigenvalue_energy_ =
+            estimate_max_eigenvalue(internal_energy_, apply_energy);
+      }
+
+      /*
+       * The RKL2 scheme with s stages is stable for time-step sizes with
+       * lambda_max * tau <= (s^2 + s - 2) / 2:
+       */
+      const auto n_stages = [&](const double max_eigenvalue) {
+        const double z = max_eigenvalue * tau_total;
+        const double s = 0.5 * (std::sqrt(9. + 8. * z) - 1.);
+        return std::max(2u, static_cast<unsigned int>(std::ceil(s)));
+      };
+
+      const unsigned int s_velocity = n_stages(sts_max_eigenvalue_velocity_);
+      const unsigned int s_energy = n_stages(sts_max_eigenvalue_energy_);
+      if (std::max(s_velocity, s_energy) > super_time_stepping_max_stages_)
+        return false;
+
+      /*
+       * Advance du/dt = F(u) over tau_total with s stages of the second
+       * order Runge-Kutta-Legendre scheme [Meyer, Balsara, Aslam, 2014]:
+       */
+
+      const auto rkl2 = [&](auto &y, const auto &apply, const unsigned int s) {
+        using VectorType = std::decay_t<decltype(y)>;
+
+        VectorType y_0, y_1, f_0, f_1;
+        y_0.reinit(y, /*omit_zeroing_entries*/ true);
+        y_1.reinit(y, /*omit_zeroing_entries*/ true);
+        f_0.reinit(y, /*omit_zeroing_entries*/ true);
+        f_1.reinit(y, /*omit_zeroing_entries*/ true);
+
+        y_0 = y;
+        y_1 = y;
+        apply(f_0, y_0);
+
+        const auto b = [](const unsigned int j) {
+          return j < 2 ? Number(1. / 3.)
+                       : Number(j * j + j - 2) / Number(2 * j * (j + 1));
+        };
+        const Number w_1 = Number(4.) / Number(s * s + s - 2);
+
+        /* First stage: */
+        y.add(b(1) * w_1 * tau_total, f_0);
+
+        for (unsigned int j = 2; j <= s; ++j) {
+          const Number mu = Number(2 * j - 1) / Number(j) * b(j) / b(j - 1);
+          const Number nu = -Number(j - 1) / Number(j) * b(j) / b(j - 2);
+          const Number mu_tilde = mu * w_1;
+          const Number gamma_tilde = -(Number(1.) - b(j - 1)) * mu_tilde;
+
+          /* y holds Y_{j-1}, y_1 holds Y_{j-2}: */
+          apply(f_1, y);
+          y_1.sadd(nu, mu, y);
+          y_1.add(Number(1.) - mu - nu, y_0, mu_tilde * tau_total, f_1);
+          y_1.add(gamma_tilde * tau_total, f_0);
+          y.swap(y_1);
+        }
+      };
+
+      /*
+       * Step 1: Advance velocity. We record the viscous heating of the
+       * old velocity field for a trapezoidal rule in step 2:
+       */
+      {
+        Scope scope(computing_timer_, "time step [P] 1 - update velocities");
+
+        compute_viscous_heating(internal_energy_rhs_, velocity_);
+        rkl2(velocity_, apply_velocity, s_velocity);
+
+        n_stages_velocity_ = 0.9 * n_stages_velocity_ + 0.1 * s_velocity;
+      }
+
+      /*
+       * Step 2: Advance internal energy with the averaged viscous heating
+       * as source term:
+       */
+      {
+        Scope scope(computing_timer_,
+                    "time step [P] 2 - update internal energy");
+
+        ScalarVector heating;
+        heating.reinit(internal_energy_rhs_, /*omit_zeroing_entries*/ true);
+        compute_viscous_heating(heating, velocity_);
+        internal_energy_rhs_.add(Number(1.), heating);
+
+        /* Source term 1/2 (m_i K_i^n + m_i K_i^{n+1}) / (m_i rho_i): */
+        inverse_mass.vmult(internal_energy_rhs_, internal_energy_rhs_);
+        internal_energy_rhs_ *= Number(0.5);
+        for (auto entry : boundary_map) {
+          const auto i = std::get<0>(entry);
+          if (i < n_owned && std::get<4>(entry) == Boundary::dirichlet)
+            internal_energy_rhs_.local_element(i) = Number(0.);
+        }
+
+        rkl2(
+            internal_energy_,
+            [&](ScalarVector &dst, const ScalarVector &src) {
+              apply_energy(dst, src);
+              dst.add(Number(1.), internal_energy_rhs_);
+            },
+            s_energy);
+
+        n_stages_internal_energy_ =
+            0.9 * n_stages_internal_energy_ + 0.1 * s_energy;
+      }
+
+      /* A boolean signalling that a restart is necessary: */
+      bool restart_needed = false;
+
+      {
+        Scope scope(computing_timer_,
+                    "time step [P] _ - synchronization barriers");
+
+        // .begin() and .end() denote the locally owned index range:
+        auto e_min_new = *std::min_element(internal_energy_.begin(),
+                                           internal_energy_.end());
+        e_min_new = Utilities::MPI::min(e_min_new,
+                                        mpi_ensemble_.ensemble_communicator());
+
+        restart_needed = e_min_new < e_min_old;
+
+        restart_needed = Utilities::MPI::logical_or(
+            restart_needed, mpi_ensemble_.synchronization_communicator());
+      }
+
+      /*
+       * Step 3: Write back the average of the old and the new state:
+       */
+      {
+        Scope scope(computing_timer_, "time step [P] 3 - write back vectors");
+
+        RYUJIN_PARALLEL_REGION_BEGIN
+
+        auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+          using T = decltype(sentinel);
+          unsigned int stride_size = get_stride_size<T>;
+
+          const auto view = hyperbolic_system_->template view<dim, T>();
+
+          RYUJIN_OMP_FOR
+          for (unsigned int i = left; i < right; i += stride_size) {
+            auto U_i = old_U.template get_tensor<T>(i);
+            const auto rho_i = view.density(U_i);
+
+            Tensor<1, dim, T> m_i_new;
+            for (unsigned int d = 0; d < dim; ++d) {
+              m_i_new[d] = rho_i * get_entry<T>(velocity_.block(d), i);
+            }
+
+            const auto rho_e_i_new = rho_i * get_entry<T>(internal_energy_, i);
+
+            const auto E_i_new = rho_e_i_new + 0.5 * m_i_new * m_i_new / rho_i;
+
+            for (unsigned int d = 0; d < dim; ++d)
+              U_i[1 + d] = 0.5 * (U_i[1 + d] + m_i_new[d]);
+            U_i[1 + dim] = 0.5 * (U_i[1 + dim] + E_i_new);
+
+            new_U.template write_tensor<T>(U_i, i);
+          }
+        };
+
+        /* Parallel non-vectorized loop: */
+        loop(Number(), n_regular, n_owned);
+        /* Parallel vectorized SIMD loop: */
+        loop(VA(), 0, n_regular);
+
+        RYUJIN_PARALLEL_REGION_END
+
+        new_U.update_ghost_values();
+      }
+
+      if (restart_needed) {
+        switch (id_violation_strategy) {
+        case IDViolationStrategy::warn:
+          n_warnings_++;
+          break;
+        case IDViolationStrategy::raise_exception:
+          n_restarts_++;
+          throw Restart();
+        }
+      }
+
+      return true;
     }
 
 
@@ -221,12 +1057,27 @@ namespace ryujin
       std::cout << "ParabolicSolver<dim, Number>::step()" << std::endl;
 #endif
 
+      if (super_time_stepping_ && super_time_step(old_state_vector,
+                                                  t,
+                                                  new_state_vector,
+                                                  tau,
+                                                  id_violation_strategy,
+                                                  reinitialize_gmg))
+        return;
+
+      /*
+       * With super time stepping enabled we only end up here if too many
+       * stages would have been necessary. The multigrid data is then
+       * likely outdated and has to be set up again:
+       */
+      const bool setup_gmg = reinitialize_gmg || super_time_stepping_;
+
       const auto &old_U = std::get<0>(old_state_vector);
       auto &new_U = std::get<0>(new_state_vector);
 
       CALLGRIND_START_INSTRUMENTATION;
 
-      using VA = VectorizedArray<Number>;
+      using VA = VectorizedArrayType<Number>;
 
       const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
       const auto &affine_constraints = offline_data_->affine_constraints();
@@ -239,6 +1090,43 @@ namespace ryujin
 
       DiagonalMatrix<dim, Number> diagonal_matrix;
 
+      /*
+       * Returns true if the eigenvalue estimates computed for the
+       * time-step size @p tau_estimate can be reused for the current
+       * time-step size:
+       */
+      const auto can_reuse_eigenvalues = [&](const Number tau_estimate) {
+        return gmg_smoother_n_cg_iter_ != 0 &&
+               gmg_eigenvalue_tolerance_ > 0. && tau_estimate > Number(0.) &&
+               std::abs(tau - tau_estimate) <=
+                   gmg_eigenvalue_tolerance_ * tau_estimate;
+      };
+
+      /*
+       * Solve with the configured CG variant and return the number of
+       * global reductions. The classical variant needs the reductions
+       * (p, A p) and the fused (r, z), |r| per iteration:
+       */
+      const auto solve_cg = [&](const auto &A,
+                                auto &x,
+                                const auto &b,
+                                const auto &preconditioner,
+                                SolverControl &solver_control) {
+        using VectorType = std::decay_t<decltype(x)>;
+        if (pipelined_cg_) {
+          SolverPipelinedCG<VectorType> solver(
+              solver_control, mpi_ensemble_.ensemble_communicator());
+          solver.solve(A, x, b, preconditioner);
+          return solver.n_reductions();
+        }
+        SolverCG<VectorType> solver(solver_control);
+        solver.solve(A, x, b, preconditioner);
+        return 2 * solver_control.last_step() + 1;
+      };
+
+      /* The number of global reductions of all linear solves: */
+      unsigned int n_reductions = 0;
+
 #ifdef DEBUG_OUTPUT
       std::cout << "        perform time-step with tau = " << tau << std::endl;
 #endif
@@ -356,12 +1244,8 @@ namespace ryujin
          * the linear system.
          */
 
-        affine_constraints.set_zero(density_);
-        affine_constraints.set_zero(internal_energy_);
-        for (unsigned int d = 0; d < dim; ++d) {
-          affine_constraints.set_zero(velocity_.block(d));
-          affine_constraints.set_zero(velocity_rhs_.block(d));
-        }
+        set_zero_constrained(
+            density_, internal_energy_, velocity_, velocity_rhs_);
 
         /* Prepare preconditioner: */
 
@@ -373,7 +1257,12 @@ namespace ryujin
          * refreshes will render the approximation better, at some additional
          * cost.
          */
-        if (use_gmg_velocity_ && reinitialize_gmg) {
+        if (use_gmg_velocity_ &&
+            (setup_gmg || smoother_tuning_velocity_.update)) {
+          smoother_tuning_velocity_.update = false;
+          const bool reuse_eigenvalues =
+              can_reuse_eigenvalues(gmg_eigenvalue_tau_velocity_);
+
           MGLevelObject<typename PreconditionChebyshev<
               VelocityMatrix<dim, float, Number>,
               LinearAlgebra::distributed::BlockVector<float>,
@@ -403,16 +1292,41 @@ namespace ryujin
               smoother_data[level].eig_cg_n_iterations = 500;
               smoother_data[level].smoothing_range = 1e-3;
             } else {
-              smoother_data[level].degree = gmg_smoother_degree_;
+              smoother_data[level].degree = smoother_tuning_velocity_.degree;
               smoother_data[level].eig_cg_n_iterations =
                   gmg_smoother_n_cg_iter_;
-              smoother_data[level].smoothing_range = gmg_smoother_range_vel_;
+              smoother_data[level].smoothing_range =
+                  smoother_tuning_velocity_.range;
               if (gmg_smoother_n_cg_iter_ == 0)
                 smoother_data[level].max_eigenvalue = gmg_smoother_max_eig_vel_;
+              if (reuse_eigenvalues) {
+                smoother_data[level].eig_cg_n_iterations = 0;
+                smoother_data[level].max_eigenvalue =
+                    gmg_max_eigenvalues_velocity_[level];
+              }
             }
           }
           mg_smoother_velocity_.initialize(level_velocity_matrices_,
                                            smoother_data);
+
+          /*
+           * Estimate eigenvalues right away and store them for subsequent
+           * updates. The Lanczos estimate approaches the largest
+           * eigenvalue from below, we thus pad it by a safety factor:
+           */
+          if (!reuse_eigenvalues && gmg_smoother_n_cg_iter_ != 0 &&
+              gmg_eigenvalue_tolerance_ > 0.) {
+            for (unsigned int level = level_matrix_free_.min_level() + 1;
+                 level <= level_matrix_free_.max_level();
+                 ++level) {
+              const auto info =
+                  mg_smoother_velocity_[level].estimate_eigenvalues(
+                      smoother_data[level].preconditioner->get_block_vector());
+              gmg_max_eigenvalues_velocity_[level] =
+                  1.2 * info.max_eigenvalue_estimate;
+            }
+            gmg_eigenvalue_tau_velocity_ = tau;
+          }
         }
 
         LIKWID_MARKER_STOP("time_step_parabolic_1");
@@ -450,6 +1364,9 @@ namespace ryujin
         velocity_operator.initialize(
             *parabolic_system_, *offline_data_, matrix_free_, density_, tau);
 
+        if (mixed_precision_)
+          density_float_ = density_;
+
         const auto tolerance_velocity =
             (tolerance_linfty_norm_ ? velocity_rhs_.linfty_norm()
                                     : velocity_rhs_.l2_norm()) *
@@ -460,14 +1377,28 @@ namespace ryujin
          * too many iterations we better switch to the more robust plain
          * conjugate gradient method.
          */
+        Timer tuning_timer;
         try {
           if (!use_gmg_velocity_)
             throw SolverControl::NoConvergence(0, 0.);
 
           using bvt_float = LinearAlgebra::distributed::BlockVector<float>;
 
-          MGCoarseGridApplySmoother<bvt_float> mg_coarse;
-          mg_coarse.initialize(mg_smoother_velocity_);
+          MGCoarseGridApplySmoother<bvt_float> mg_coarse_smoother;
+          mg_coarse_smoother.initialize(mg_smoother_velocity_);
+
+          const auto coarse_level = level_velocity_matrices_.min_level();
+          const auto mg_coarse_cg = make_coarse_grid_cg<bvt_float>(
+              level_velocity_matrices_[coarse_level],
+              mg_smoother_velocity_[coarse_level],
+              gmg_coarse_cg_iter_,
+              gmg_coarse_cg_reduction_);
+
+          const MGCoarseGridBase<bvt_float> &mg_coarse =
+              gmg_coarse_cg_iter_ > 0
+                  ? static_cast<const MGCoarseGridBase<bvt_float> &>(
+                        mg_coarse_cg)
+                  : mg_coarse_smoother;
 
           mg::Matrix<bvt_float> mg_matrix(level_velocity_matrices_);
 
@@ -483,21 +1414,79 @@ namespace ryujin
           PreconditionMG<dim, bvt_float, MGTransferVelocity<dim, float>>
               preconditioner(dof_handler, mg, mg_transfer_velocity_);
 
-          SolverControl solver_control(gmg_max_iter_vel_, tolerance_velocity);
-          SolverCG<BlockVector> solver(solver_control);
-          solver.solve(
-              velocity_operator, velocity_, velocity_rhs_, preconditioner);
-
-          /* update exponential moving average */
-          n_iterations_velocity_ =
-              0.9 * n_iterations_velocity_ + 0.1 * solver_control.last_step();
+          if (mixed_precision_) {
+            VelocityMatrix<dim, float, Number> velocity_operator_float;
+            velocity_operator_float.initialize(*parabolic_system_,
+                                               *offline_data_,
+                                               matrix_free_float_,
+                                               density_float_,
+                                               float(tau));
+            velocity_operator_float.set_lumped_mass_matrix(
+                lumped_mass_matrix_float_);
+
+            const auto n_iterations =
+                defect_correction<bvt_float>(velocity_operator,
+                                             velocity_operator_float,
+                                             preconditioner,
+                                             velocity_,
+                                             velocity_rhs_,
+                                             tolerance_velocity,
+                                             tolerance_linfty_norm_,
+                                             gmg_max_iter_vel_,
+                                             mixed_precision_reduction_);
+
+            /* update exponential moving average */
+            n_iterations_velocity_ =
+                0.9 * n_iterations_velocity_ + 0.1 * n_iterations;
+            n_reductions += 2 * n_iterations;
+
+          } else {
+            SolverControl solver_control(gmg_max_iter_vel_,
+                                         tolerance_velocity);
+            n_reductions += solve_cg(velocity_operator,
+                                     velocity_,
+                                     velocity_rhs_,
+                                     preconditioner,
+                                     solver_control);
+
+            /* update exponential moving average */
+            n_iterations_velocity_ =
+                0.9 * n_iterations_velocity_ + 0.1 * solver_control.last_step();
+          }
 
         } catch (SolverControl::NoConvergence &) {
 
           SolverControl solver_control(1000, tolerance_velocity);
-          SolverCG<BlockVector> solver(solver_control);
-          solver.solve(
-              velocity_operator, velocity_, velocity_rhs_, diagonal_matrix);
+
+          if (chebyshev_degree_ > 0) {
+            using Chebyshev =
+                PreconditionChebyshev<VelocityMatrix<dim, Number, Number>,
+                                      BlockVector,
+                                      DiagonalMatrix<dim, Number>>;
+            typename Chebyshev::AdditionalData data;
+            velocity_operator.compute_diagonal(data.preconditioner);
+            set_zero_constrained(data.preconditioner->get_block_vector());
+            data.degree = chebyshev_degree_;
+            data.smoothing_range = chebyshev_range_;
+            data.eig_cg_n_iterations = gmg_smoother_n_cg_iter_;
+            if (gmg_smoother_n_cg_iter_ == 0)
+              data.max_eigenvalue = gmg_smoother_max_eig_vel_;
+
+            Chebyshev preconditioner;
+            preconditioner.initialize(velocity_operator, data);
+            n_reductions += solve_cg(velocity_operator,
+                                     velocity_,
+                                     velocity_rhs_,
+                                     preconditioner,
+                                     solver_control);
+
+          } else {
+            n_reductions += solve_cg(velocity_operator,
+                                     velocity_,
+                                     velocity_rhs_,
+                                     diagonal_matrix,
+                                     solver_control);
+          }
 
           /* update exponential moving average, counting also GMG iterations */
           n_iterations_velocity_ *= 0.9;
@@ -506,6 +1495,10 @@ namespace ryujin
               0.1 * solver_control.last_step();
         }
 
+        if (use_gmg_velocity_)
+          record_smoother_tuning(smoother_tuning_velocity_,
+                                 tuning_timer.wall_time());
+
         LIKWID_MARKER_STOP("time_step_parabolic_1");
       }
 
@@ -519,49 +1512,7 @@ namespace ryujin
         LIKWID_MARKER_START("time_step_parabolic_2");
 
         /* Compute m_i K_i^{n+1/2}:  (5.5) */
-        matrix_free_.template cell_loop<ScalarVector, BlockVector>(
-            [this](const auto &data,
-                   auto &dst,
-                   const auto &src,
-                   const auto cell_range) {
-              FEEvaluation<dim, order_fe, order_quad, dim, Number> velocity(
-                  data);
-              FEEvaluation<dim, order_fe, order_quad, 1, Number> energy(data);
-
-              const auto mu = parabolic_system_->mu();
-              const auto lambda = parabolic_system_->lambda();
-
-              for (unsigned int cell = cell_range.first;
-                   cell < cell_range.second;
-                   ++cell) {
-                velocity.reinit(cell);
-                energy.reinit(cell);
-                velocity.gather_evaluate(src, EvaluationFlags::gradients);
-
-                for (unsigned int q = 0; q < velocity.n_q_points; ++q) {
-                  if constexpr (dim == 1) {
-                    /* Workaround: no symmetric gradient for dim == 1: */
-                    const auto gradient = velocity.get_gradient(q);
-                    auto S = (4. / 3. * mu + lambda) * gradient;
-                    energy.submit_value(gradient * S, q);
-
-                  } else {
-
-                    const auto symmetric_gradient =
-                        velocity.get_symmetric_gradient(q);
-                    const auto divergence = trace(symmetric_gradient);
-                    auto S = 2. * mu * symmetric_gradient;
-                    for (unsigned int d = 0; d < dim; ++d)
-                      S[d][d] += (lambda - 2. / 3. * mu) * divergence;
-                    energy.submit_value(symmetric_gradient * S, q);
-                  }
-                }
-                energy.integrate_scatter(EvaluationFlags::values, dst);
-              }
-            },
-            internal_energy_rhs_,
-            velocity_,
-            /* zero destination */ true);
+        compute_viscous_heating(internal_energy_rhs_, velocity_);
 
         const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
 
@@ -611,7 +1562,10 @@ namespace ryujin
          * Set up "strongly enforced" boundary conditions that are not stored
          * in the AffineConstraints map: We enforce Neumann conditions (i.e.,
          * insulating boundary conditions) everywhere except for Dirichlet
-         * boundaries where we have to enforce prescribed conditions:
+         * boundaries where we have to enforce prescribed conditions. The
+         * prescribed internal energy has already been written into
+         * internal_energy_ in Step 1, where the Dirichlet data at t + tau
+         * has been evaluated for the velocity, and is simply copied:
          */
 
         const auto &boundary_map = offline_data_->boundary_map();
@@ -623,15 +1577,11 @@ namespace ryujin
             continue;
 
           const auto id = std::get<4>(entry);
-          const auto position = std::get<5>(entry);
 
           if (id == Boundary::dirichlet) {
             /* Prescribe internal energy: */
-            const auto U_i = initial_values_->initial_state(position, t + tau);
-            const auto view = hyperbolic_system_->template view<dim, Number>();
-            const auto rho_i = view.density(U_i);
-            const auto e_i = view.internal_energy(U_i) / rho_i;
-            internal_energy_rhs_.local_element(i) = e_i;
+            internal_energy_rhs_.local_element(i) =
+                internal_energy_.local_element(i);
           }
         }
 
@@ -641,14 +1591,19 @@ namespace ryujin
          * the stencil - consequently we have to remove constrained dofs from
          * the linear system.
          */
-        affine_constraints.set_zero(internal_energy_rhs_);
+        set_zero_constrained(internal_energy_rhs_);
 
         /*
          * Update MG matrices all 4 time steps; this is a balance because more
          * refreshes will render the approximation better, at some additional
          * cost.
          */
-        if (use_gmg_internal_energy_ && reinitialize_gmg) {
+        if (use_gmg_internal_energy_ &&
+            (setup_gmg || smoother_tuning_energy_.update)) {
+          smoother_tuning_energy_.update = false;
+          const bool reuse_eigenvalues =
+              can_reuse_eigenvalues(gmg_eigenvalue_tau_energy_);
+
           MGLevelObject<typename PreconditionChebyshev<
               EnergyMatrix<dim, float, Number>,
               LinearAlgebra::distributed::Vector<float>>::AdditionalData>
@@ -674,15 +1629,35 @@ namespace ryujin
               smoother_data[level].eig_cg_n_iterations = 500;
               smoother_data[level].smoothing_range = 1e-3;
             } else {
-              smoother_data[level].degree = gmg_smoother_degree_;
+              smoother_data[level].degree = smoother_tuning_energy_.degree;
               smoother_data[level].eig_cg_n_iterations =
                   gmg_smoother_n_cg_iter_;
-              smoother_data[level].smoothing_range = gmg_smoother_range_en_;
+              smoother_data[level].smoothing_range =
+                  smoother_tuning_energy_.range;
               if (gmg_smoother_n_cg_iter_ == 0)
                 smoother_data[level].max_eigenvalue = gmg_smoother_max_eig_en_;
+              if (reuse_eigenvalues) {
+                smoother_data[level].eig_cg_n_iterations = 0;
+                smoother_data[level].max_eigenvalue =
+                    gmg_max_eigenvalues_energy_[level];
+              }
             }
           }
           mg_smoother_energy_.initialize(level_energy_matrices_, smoother_data);
+
+          /* Estimate and store eigenvalues for subsequent updates: */
+          if (!reuse_eigenvalues && gmg_smoother_n_cg_iter_ != 0 &&
+              gmg_eigenvalue_tolerance_ > 0.) {
+            for (unsigned int level = level_matrix_free_.min_level() + 1;
+                 level <= level_matrix_free_.max_level();
+                 ++level) {
+              const auto info = mg_smoother_energy_[level].estimate_eigenvalues(
+                  smoother_data[level].preconditioner->get_vector());
+              gmg_max_eigenvalues_energy_[level] =
+                  1.2 * info.max_eigenvalue_estimate;
+            }
+            gmg_eigenvalue_tau_energy_ = tau;
+          }
         }
 
         LIKWID_MARKER_STOP("time_step_parabolic_2");
@@ -707,13 +1682,28 @@ namespace ryujin
                                     : internal_energy_rhs_.l2_norm()) *
             tolerance_;
 
+        Timer tuning_timer;
         try {
           if (!use_gmg_internal_energy_)
             throw SolverControl::NoConvergence(0, 0.);
 
           using vt_float = LinearAlgebra::distributed::Vector<float>;
-          MGCoarseGridApplySmoother<vt_float> mg_coarse;
-          mg_coarse.initialize(mg_smoother_energy_);
+          MGCoarseGridApplySmoother<vt_float> mg_coarse_smoother;
+          mg_coarse_smoother.initialize(mg_smoother_energy_);
+
+          const auto coarse_level = level_energy_matrices_.min_level();
+          const auto mg_coarse_cg = make_coarse_grid_cg<vt_float>(
+              level_energy_matrices_[coarse_level],
+              mg_smoother_energy_[coarse_level],
+              gmg_coarse_cg_iter_,
+              gmg_coarse_cg_reduction_);
+
+          const MGCoarseGridBase<vt_float> &mg_coarse =
+              gmg_coarse_cg_iter_ > 0
+                  ? static_cast<const MGCoarseGridBase<vt_float> &>(
+                        mg_coarse_cg)
+                  : mg_coarse_smoother;
+
           mg::Matrix<vt_float> mg_matrix(level_energy_matrices_);
 
           Multigrid<vt_float> mg(mg_matrix,
@@ -728,26 +1718,79 @@ namespace ryujin
           PreconditionMG<dim, vt_float, MGTransferEnergy<dim, float>>
               preconditioner(dof_handler, mg, mg_transfer_energy_);
 
-          SolverControl solver_control(gmg_max_iter_en_,
-                                       tolerance_internal_energy);
-          SolverCG<ScalarVector> solver(solver_control);
-          solver.solve(energy_operator,
-                       internal_energy_,
-                       internal_energy_rhs_,
-                       preconditioner);
-
-          /* update exponential moving average */
-          n_iterations_internal_energy_ = 0.9 * n_iterations_internal_energy_ +
-                                          0.1 * solver_control.last_step();
+          if (mixed_precision_) {
+            EnergyMatrix<dim, float, Number> energy_operator_float;
+            energy_operator_float.initialize(*offline_data_,
+                                             matrix_free_float_,
+                                             density_float_,
+                                             float(tau * kappa));
+            energy_operator_float.set_lumped_mass_matrix(
+                lumped_mass_matrix_float_);
+
+            const auto n_iterations =
+                defect_correction<vt_float>(energy_operator,
+                                            energy_operator_float,
+                                            preconditioner,
+                                            internal_energy_,
+                                            internal_energy_rhs_,
+                                            tolerance_internal_energy,
+                                            tolerance_linfty_norm_,
+                                            gmg_max_iter_en_,
+                                            mixed_precision_reduction_);
+
+            /* update exponential moving average */
+            n_iterations_internal_energy_ =
+                0.9 * n_iterations_internal_energy_ + 0.1 * n_iterations;
+            n_reductions += 2 * n_iterations;
+
+          } else {
+            SolverControl solver_control(gmg_max_iter_en_,
+                                         tolerance_internal_energy);
+            n_reductions += solve_cg(energy_operator,
+                                     internal_energy_,
+                                     internal_energy_rhs_,
+                                     preconditioner,
+                                     solver_control);
+
+            /* update exponential moving average */
+            n_iterations_internal_energy_ =
+                0.9 * n_iterations_internal_energy_ +
+                0.1 * solver_control.last_step();
+          }
 
         } catch (SolverControl::NoConvergence &) {
 
           SolverControl solver_control(1000, tolerance_internal_energy);
-          SolverCG<ScalarVector> solver(solver_control);
-          solver.solve(energy_operator,
-                       internal_energy_,
-                       internal_energy_rhs_,
-                       diagonal_matrix);
+
+          if (chebyshev_degree_ > 0) {
+            using Chebyshev =
+                PreconditionChebyshev<EnergyMatrix<dim, Number, Number>,
+                                      ScalarVector,
+                                      dealii::DiagonalMatrix<ScalarVector>>;
+            typename Chebyshev::AdditionalData data;
+            energy_operator.compute_diagonal(data.preconditioner);
+            set_zero_constrained(data.preconditioner->get_vector());
+            data.degree = chebyshev_degree_;
+            data.smoothing_range = chebyshev_range_;
+            data.eig_cg_n_iterations = gmg_smoother_n_cg_iter_;
+            if (gmg_smoother_n_cg_iter_ == 0)
+              data.max_eigenvalue = gmg_smoother_max_eig_en_;
+
+            Chebyshev preconditioner;
+            preconditioner.initialize(energy_operator, data);
+            n_reductions += solve_cg(energy_operator,
+                                     internal_energy_,
+                                     internal_energy_rhs_,
+                                     preconditioner,
+                                     solver_control);
+
+          } else {
+            n_reductions += solve_cg(energy_operator,
+                                     internal_energy_,
+                                     internal_energy_rhs_,
+                                     diagonal_matrix,
+                                     solver_control);
+          }
 
           /* update exponential moving average, counting also GMG iterations */
           n_iterations_internal_energy_ *= 0.9;
@@ -756,6 +1799,13 @@ namespace ryujin
               0.1 * solver_control.last_step();
         }
 
+        if (use_gmg_internal_energy_)
+          record_smoother_tuning(smoother_tuning_energy_,
+                                 tuning_timer.wall_time());
+
+        /* update exponential moving average */
+        n_reductions_ = 0.9 * n_reductions_ + 0.1 * n_reductions;
+
         /*
          * Check for local minimum principle on internal energy:
          */
@@ -875,8 +1925,37 @@ namespace ryujin
              << n_iterations_velocity_
              << (use_gmg_velocity_ ? " GMG vel -- " : " CG vel -- ")
              << n_iterations_internal_energy_
-             << (use_gmg_internal_energy_ ? " GMG int ]" : " CG int ]")
-             << std::endl;
+             << (use_gmg_internal_energy_ ? " GMG int -- " : " CG int -- ")
+             << n_reductions_ << (pipelined_cg_ ? " pipelined" : "")
+             << " reductions ]" << std::endl;
+
+      if (super_time_stepping_)
+        output << "        [ " << std::setprecision(2) << std::fixed
+               << n_stages_velocity_ << " RKL2 vel -- "
+               << n_stages_internal_energy_ << " RKL2 int stages ]"
+               << std::endl;
+
+      if (!gmg_smoother_auto_tuning_ ||
+          !(use_gmg_velocity_ || use_gmg_internal_energy_))
+        return;
+
+      const auto print_tuning = [&](const SmootherTuning &tuning) {
+        output << "degree " << tuning.degree << " range "
+               << std::setprecision(1) << tuning.range
+               << (tuning.candidate < tuning.cost.size() ? " (tuning)" : "");
+      };
+
+      output << "        [ Chebyshev smoother: ";
+      if (use_gmg_velocity_) {
+        output << "vel ";
+        print_tuning(smoother_tuning_velocity_);
+        output << (use_gmg_internal_energy_ ? " -- " : "");
+      }
+      if (use_gmg_internal_energy_) {
+        output << "int ";
+        print_tuning(smoother_tuning_energy_);
+      }
+      output << " ]" << std::endl;
     }
 
   } // namespace NavierStokes
@@ -128,16 +128,17 @@ namespace ryujin
             for (unsigned int d = 0; d < dim; ++d)
               dst.block(d).local_element(i) =
                   diagonal.local_element(i) * src.block(d).local_element(i);
-        } else
-          for (unsigned int d = 0; d < dim; ++d) {
-            DEAL_II_OPENMP_SIMD_PRAGMA
-            for (unsigned int i = 0;
-                 i < src.block(d).get_partitioner()->locally_owned_size();
-                 ++i)
+        } else {
+          /* Interleave all blocks in a single sweep: */
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = 0;
+               i < src.block(0).get_partitioner()->locally_owned_size();
+               ++i)
+            for (unsigned int d = 0; d < dim; ++d)
               dst.block(d).local_element(i) =
                   diagonal_block.block(d).local_element(i) *
                   src.block(d).local_element(i);
-          }
+        }
       }
 
     private:
@@ -180,6 +181,17 @@ namespace ryujin
         density_ = &density;
         theta_x_tau_ = theta_x_tau;
         level_ = level;
+        lumped_mass_matrix_ = nullptr;
+      }
+
+      /**
+       * Use the given lumped mass matrix on the active level instead of
+       * the one stored in the OfflineData object. This is necessary for
+       * applying the operator in a lower precision than Number2.
+       */
+      void set_lumped_mass_matrix(const vector_type &lumped_mass_matrix)
+      {
+        lumped_mass_matrix_ = &lumped_mass_matrix;
       }
 
       void Tvmult(block_vector_type &dst, const block_vector_type &src) const
@@ -189,57 +201,50 @@ namespace ryujin
 
       void vmult(block_vector_type &dst, const block_vector_type &src) const
       {
-        /* Apply action of m_i rho_i V_i: */
-
         using VA = dealii::VectorizedArray<Number>;
         constexpr auto simd_length = VA::size();
 
-        const vector_type *lumped_mass_matrix = nullptr;
-        if constexpr (std::is_same<Number, Number2>::value) {
-          if constexpr (std::is_same<Number, float>::value) {
-            if (level_ == dealii::numbers::invalid_unsigned_int)
-              lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-            else
-              lumped_mass_matrix =
-                  &offline_data_->level_lumped_mass_matrix()[level_];
-          } else {
-            Assert(level_ == dealii::numbers::invalid_unsigned_int,
-                   dealii::ExcInternalError());
-            lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-          }
-        } else
-          lumped_mass_matrix =
-              &offline_data_->level_lumped_mass_matrix()[level_];
+        const vector_type *lumped_mass_matrix = &get_lumped_mass_matrix();
 
         const unsigned int n_owned =
             lumped_mass_matrix->get_partitioner()->locally_owned_size();
-        const unsigned int size_regular = n_owned / simd_length * simd_length;
 
-        RYUJIN_PARALLEL_REGION_BEGIN
-
-        RYUJIN_OMP_FOR
-        for (unsigned int i = 0; i < size_regular; i += simd_length) {
-          const auto m_i = get_entry<VA>(*lumped_mass_matrix, i);
-          const auto rho_i = get_entry<VA>(*density_, i);
-          for (unsigned int d = 0; d < dim; ++d) {
-            const auto temp = get_entry<VA>(src.block(d), i);
-            write_entry<VA>(dst.block(d), m_i * rho_i * temp, i);
+        /*
+         * Apply action of m_i rho_i V_i on the index range [begin, end):
+         * This is called by the cell loop for every range of locally owned
+         * degrees of freedom before the first cell contributing to it is
+         * processed. This way the stress tensor is applied in the same
+         * sweep over the vectors while the entries are still in cache.
+         */
+        const auto mass_operation = [&](const unsigned int begin,
+                                        const unsigned int end) {
+          const unsigned int end_regular =
+              begin + (end - begin) / simd_length * simd_length;
+
+          for (unsigned int i = begin; i < end_regular; i += simd_length) {
+            const auto m_i = get_entry<VA>(*lumped_mass_matrix, i);
+            const auto rho_i = get_entry<VA>(*density_, i);
+            for (unsigned int d = 0; d < dim; ++d) {
+              const auto temp = get_entry<VA>(src.block(d), i);
+              write_entry<VA>(dst.block(d), m_i * rho_i * temp, i);
+            }
           }
-        }
-
-        RYUJIN_PARALLEL_REGION_END
 
-        for (unsigned int i = size_regular; i < n_owned; ++i) {
-          const auto m_i = lumped_mass_matrix->local_element(i);
-          const auto rho_i = density_->local_element(i);
-
-          for (unsigned int d = 0; d < dim; ++d) {
-            const auto temp = src.block(d).local_element(i);
-            dst.block(d).local_element(i) = m_i * rho_i * temp;
+          for (unsigned int i = end_regular; i < end; ++i) {
+            const auto m_i = lumped_mass_matrix->local_element(i);
+            const auto rho_i = density_->local_element(i);
+            for (unsigned int d = 0; d < dim; ++d) {
+              const auto temp = src.block(d).local_element(i);
+              dst.block(d).local_element(i) = m_i * rho_i * temp;
+            }
           }
-        }
+        };
 
-        /* Apply action of stress tensor: + theta * \sum_j B_ij V_j: */
+        /*
+         * Apply action of stress tensor: + theta * \sum_j B_ij V_j: The
+         * dim-component FEEvaluation object evaluates all velocity
+         * components in one sum-factorization sweep per cell batch.
+         */
 
         const auto integrator = [this](const auto &data,
                                        auto &dst,
@@ -257,7 +262,11 @@ namespace ryujin
         };
 
         matrix_free_->template cell_loop<block_vector_type, block_vector_type>(
-            integrator, dst, src, /* zero destination */ false);
+            integrator,
+            dst,
+            src,
+            mass_operation,
+            [](const unsigned int, const unsigned int) {});
 
         /* (5.4a) Fix up constrained degrees of freedom: */
 
@@ -302,8 +311,6 @@ namespace ryujin
       void compute_diagonal(
           std::shared_ptr<DiagonalMatrix<dim, Number>> &matrix) const
       {
-        Assert(level_ != dealii::numbers::invalid_unsigned_int,
-               dealii::ExcNotImplemented());
         matrix = std::make_shared<DiagonalMatrix<dim, Number>>();
         block_vector_type &vector = matrix->get_block_vector();
         vector.reinit(dim);
@@ -311,8 +318,7 @@ namespace ryujin
           matrix_free_->initialize_dof_vector(vector.block(d));
         vector.collect_sizes();
 
-        const auto &lumped_mass_matrix =
-            offline_data_->level_lumped_mass_matrix()[level_];
+        const auto &lumped_mass_matrix = get_lumped_mass_matrix();
 
         unsigned int dummy = 0;
         matrix_free_->template cell_loop<block_vector_type, unsigned int>(
@@ -359,7 +365,10 @@ namespace ryujin
 
         RYUJIN_PARALLEL_REGION_END
 
-        const auto &boundary_map = offline_data_->level_boundary_map()[level_];
+        const auto &boundary_map =
+            level_ == dealii::numbers::invalid_unsigned_int
+                ? offline_data_->boundary_map()
+                : offline_data_->level_boundary_map()[level_];
 
         for (auto entry : boundary_map) {
           // [i, normal, normal_mass, boundary_mass, id, position] = entry
@@ -400,6 +409,31 @@ namespace ryujin
       const vector_type *density_;
       Number theta_x_tau_;
       unsigned int level_;
+      const vector_type *lumped_mass_matrix_ = nullptr;
+
+      /* Select the lumped mass matrix of the current level: */
+      const vector_type &get_lumped_mass_matrix() const
+      {
+        if (lumped_mass_matrix_ != nullptr) {
+          Assert(level_ == dealii::numbers::invalid_unsigned_int,
+                 dealii::ExcInternalError());
+          return *lumped_mass_matrix_;
+        }
+
+        if constexpr (std::is_same<Number, Number2>::value) {
+          if constexpr (std::is_same<Number, float>::value) {
+            if (level_ == dealii::numbers::invalid_unsigned_int)
+              return offline_data_->lumped_mass_matrix();
+            else
+              return offline_data_->level_lumped_mass_matrix()[level_];
+          } else {
+            Assert(level_ == dealii::numbers::invalid_unsigned_int,
+                   dealii::ExcInternalError());
+            return offline_data_->lumped_mass_matrix();
+          }
+        } else
+          return offline_data_->level_lumped_mass_matrix()[level_];
+      }
 
       template <typename Evaluator>
       void apply_local_operator(Evaluator &velocity) const
@@ -567,6 +601,17 @@ namespace ryujin
         density_ = &density;
         factor_ = time_factor;
         level_ = level;
+        lumped_mass_matrix_ = nullptr;
+      }
+
+      /**
+       * Use the given lumped mass matrix on the active level instead of
+       * the one stored in the OfflineData object. This is necessary for
+       * applying the operator in a lower precision than Number2.
+       */
+      void set_lumped_mass_matrix(const vector_type &lumped_mass_matrix)
+      {
+        lumped_mass_matrix_ = &lumped_mass_matrix;
       }
 
       void Tvmult(vector_type &dst, const vector_type &src) const
@@ -592,22 +637,7 @@ namespace ryujin
         using VA = dealii::VectorizedArray<Number>;
         constexpr auto simd_length = VA::size();
 
-        const vector_type *lumped_mass_matrix = nullptr;
-        if constexpr (std::is_same<Number, Number2>::value) {
-          if constexpr (std::is_same<Number, float>::value) {
-            if (level_ == dealii::numbers::invalid_unsigned_int)
-              lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-            else
-              lumped_mass_matrix =
-                  &offline_data_->level_lumped_mass_matrix()[level_];
-          } else {
-            Assert(level_ == dealii::numbers::invalid_unsigned_int,
-                   dealii::ExcInternalError());
-            lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-          }
-        } else
-          lumped_mass_matrix =
-              &offline_data_->level_lumped_mass_matrix()[level_];
+        const vector_type *lumped_mass_matrix = &get_lumped_mass_matrix();
 
         const unsigned int n_owned =
             lumped_mass_matrix->get_partitioner()->locally_owned_size();
@@ -673,14 +703,11 @@ namespace ryujin
       void compute_diagonal(
           std::shared_ptr<dealii::DiagonalMatrix<vector_type>> &matrix) const
       {
-        Assert(level_ != dealii::numbers::invalid_unsigned_int,
-               dealii::ExcNotImplemented());
         matrix = std::make_shared<dealii::DiagonalMatrix<vector_type>>();
         vector_type &vector = matrix->get_vector();
         matrix_free_->initialize_dof_vector(vector);
 
-        const vector_type &lumped_mass_matrix =
-            offline_data_->level_lumped_mass_matrix()[level_];
+        const vector_type &lumped_mass_matrix = get_lumped_mass_matrix();
 
         unsigned int dummy = 0;
         matrix_free_->template cell_loop<vector_type, unsigned int>(
@@ -726,7 +753,10 @@ namespace ryujin
 
         RYUJIN_PARALLEL_REGION_END
 
-        const auto &boundary_map = offline_data_->level_boundary_map()[level_];
+        const auto &boundary_map =
+            level_ == dealii::numbers::invalid_unsigned_int
+                ? offline_data_->boundary_map()
+                : offline_data_->level_boundary_map()[level_];
 
         for (auto entry : boundary_map) {
           const auto i = std::get<0>(entry);
@@ -745,6 +775,31 @@ namespace ryujin
       const dealii::LinearAlgebra::distributed::Vector<Number> *density_;
       Number factor_;
       unsigned int level_;
+      const vector_type *lumped_mass_matrix_ = nullptr;
+
+      /* Select the lumped mass matrix of the current level: */
+      const vector_type &get_lumped_mass_matrix() const
+      {
+        if (lumped_mass_matrix_ != nullptr) {
+          Assert(level_ == dealii::numbers::invalid_unsigned_int,
+                 dealii::ExcInternalError());
+          return *lumped_mass_matrix_;
+        }
+
+        if constexpr (std::is_same<Number, Number2>::value) {
+          if constexpr (std::is_same<Number, float>::value) {
+            if (level_ == dealii::numbers::invalid_unsigned_int)
+              return offline_data_->lumped_mass_matrix();
+            else
+              return offline_data_->level_lumped_mass_matrix()[level_];
+          } else {
+            Assert(level_ == dealii::numbers::invalid_unsigned_int,
+                   dealii::ExcInternalError());
+            return offline_data_->lumped_mass_matrix();
+          }
+        } else
+          return offline_data_->level_lumped_mass_matrix()[level_];
+      }
 
       template <typename Evaluator>
       void apply_local_operator(Evaluator &energy) const
@@ -0,0 +1,208 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <array>
+#include <cmath>
+
+namespace ryujin
+{
+  namespace NavierStokes
+  {
+    namespace internal
+    {
+      /*
+       * Accumulate the local contributions of the dot products (r, u),
+       * (w, u) and (r, r) in a single pass:
+       */
+      template <typename Number>
+      void accumulate_local_dots(
+          const dealii::LinearAlgebra::distributed::Vector<Number> &r,
+          const dealii::LinearAlgebra::distributed::Vector<Number> &u,
+          const dealii::LinearAlgebra::distributed::Vector<Number> &w,
+          std::array<double, 3> &dots)
+      {
+        double r_u = 0.;
+        double w_u = 0.;
+        double r_r = 0.;
+
+        const unsigned int n_owned = r.locally_owned_size();
+        DEAL_II_OPENMP_SIMD_PRAGMA
+        for (unsigned int i = 0; i < n_owned; ++i) {
+          const double r_i = r.local_element(i);
+          const double u_i = u.local_element(i);
+          const double w_i = w.local_element(i);
+          r_u += r_i * u_i;
+          w_u += w_i * u_i;
+          r_r += r_i * r_i;
+        }
+
+        dots[0] += r_u;
+        dots[1] += w_u;
+        dots[2] += r_r;
+      }
+
+
+      template <typename Number>
+      void accumulate_local_dots(
+          const dealii::LinearAlgebra::distributed::BlockVector<Number> &r,
+          const dealii::LinearAlgebra::distributed::BlockVector<Number> &u,
+          const dealii::LinearAlgebra::distributed::BlockVector<Number> &w,
+          std::array<double, 3> &dots)
+      {
+        for (unsigned int b = 0; b < r.n_blocks(); ++b)
+          accumulate_local_dots(r.block(b), u.block(b), w.block(b), dots);
+      }
+    } // namespace internal
+
+
+    /**
+     * A pipelined preconditioned conjugate gradient method following
+     * Ghysels and Vanroose, "Hiding global synchronization latency in the
+     * preconditioned Conjugate Gradient algorithm", Parallel Computing
+     * 40 (2014).
+     *
+     * Compared to the classical formulation (as implemented by
+     * dealii::SolverCG) the algorithm needs only a single global
+     * reduction per iteration. This reduction combines the three dot
+     * products \f$(r,u)\f$, \f$(w,u)\f$ and \f$(r,r)\f$. It is issued
+     * non-blocking and overlapped with the application of the
+     * preconditioner and the operator. The price is four additional
+     * vectors and four more vector updates per iteration, and slightly
+     * reduced numerical stability.
+     *
+     * The stopping criterion is the same as the one of dealii::SolverCG:
+     * the l2 norm of the (unpreconditioned) residual is checked against
+     * the given SolverControl object. An exception of type
+     * dealii::SolverControl::NoConvergence is thrown if the iteration
+     * fails to converge.
+     *
+     * @ingroup NavierStokesEquations
+     */
+    template <typename VectorType>
+    class SolverPipelinedCG
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      SolverPipelinedCG(dealii::SolverControl &solver_control,
+                        const MPI_Comm &mpi_communicator)
+          : solver_control_(solver_control)
+          , mpi_communicator_(mpi_communicator)
+          , n_reductions_(0)
+      {
+      }
+
+      /**
+       * Solve the linear system @p A @p x = @p b with preconditioner
+       * @p preconditioner. The vector @p x is used as initial guess.
+       */
+      template <typename MatrixType, typename PreconditionerType>
+      void solve(const MatrixType &A,
+                 VectorType &x,
+                 const VectorType &b,
+                 const PreconditionerType &preconditioner)
+      {
+        VectorType r, u, w, m, n, z, q, s, p;
+        r.reinit(b, true);
+        u.reinit(b, true);
+        w.reinit(b, true);
+        m.reinit(b, true);
+        n.reinit(b, true);
+        z.reinit(b);
+        q.reinit(b);
+        s.reinit(b);
+        p.reinit(b);
+
+        /* r = b - A x, u = P r, w = A u: */
+        A.vmult(r, x);
+        r.sadd(-1., 1., b);
+        preconditioner.vmult(u, r);
+        A.vmult(w, u);
+
+        n_reductions_ = 0;
+        double gamma_old = 0.;
+        double alpha_old = 0.;
+
+        for (unsigned int step = 0;; ++step) {
+          std::array<double, 3> local_dots{{0., 0., 0.}};
+          internal::accumulate_local_dots(r, u, w, local_dots);
+
+          std::array<double, 3> dots;
+          MPI_Request request;
+          const int ierr = MPI_Iallreduce(local_dots.data(),
+                                          dots.data(),
+                                          3,
+                                          MPI_DOUBLE,
+                                          MPI_SUM,
+                                          mpi_communicator_,
+                                          &request);
+          AssertThrowMPI(ierr);
+          ++n_reductions_;
+
+          /* m = P w, n = A m, while the reduction is in flight: */
+          preconditioner.vmult(m, w);
+          A.vmult(n, m);
+
+          MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+          const double gamma = dots[0];
+          const double delta = dots[1];
+          const double residual_norm = std::sqrt(dots[2]);
+
+          const auto state = solver_control_.check(step, residual_norm);
+          if (state == dealii::SolverControl::success)
+            return;
+
+          AssertThrow(state == dealii::SolverControl::iterate,
+                      dealii::SolverControl::NoConvergence(step,
+                                                           residual_norm));
+
+          double alpha = gamma / delta;
+          double beta = 0.;
+          if (step > 0) {
+            beta = gamma / gamma_old;
+            alpha = gamma / (delta - beta * gamma / alpha_old);
+          }
+
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+
+          x.add(alpha, p);
+          r.add(-alpha, s);
+          u.add(-alpha, q);
+          w.add(-alpha, z);
+
+          gamma_old = gamma;
+          alpha_old = alpha;
+        }
+      }
+
+      /**
+       * The number of global reductions performed in the last call to
+       * solve().
+       */
+      unsigned int n_reductions() const
+      {
+        return n_reductions_;
+      }
+
+    private:
+      dealii::SolverControl &solver_control_;
+      const MPI_Comm mpi_communicator_;
+      unsigned int n_reductions_;
+    };
+
+  } // namespace NavierStokes
+} // namespace ryujin
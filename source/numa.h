@@ -0,0 +1,316 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2020 - 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "openmp.h"
+
+#include <deal.II/base/config.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ryujin
+{
+  namespace NUMA
+  {
+    /**
+     * Release all memory pages that lie entirely within the range
+     * [@p data, @p data + @p size) back to the operating system. For
+     * private anonymous memory (which is what the system allocator hands
+     * out for large allocations) the next write access to such a page
+     * allocates a fresh, zero-initialized page on the NUMA domain of the
+     * writing thread ("first touch" policy).
+     *
+     * @note The content of the released pages is lost, the function must
+     * thus only be called on zero-initialized memory. Partially covered
+     * pages at the beginning and end of the range are left untouched.
+     *
+     * The function is a no-op unless the compile-time option
+     * NUMA_FIRST_TOUCH is set.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <typename T>
+    void release_pages([[maybe_unused]] T *data,
+                       [[maybe_unused]] const std::size_t size)
+    {
+#if defined(NUMA_FIRST_TOUCH) && defined(__linux__)
+      if (data == nullptr || size == 0)
+        return;
+
+      const auto page_size =
+          static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+      const auto begin = reinterpret_cast<std::uintptr_t>(data);
+      const auto end = reinterpret_cast<std::uintptr_t>(data + size);
+
+      const auto first_page = (begin + page_size - 1) / page_size * page_size;
+      const auto last_page = end / page_size * page_size;
+
+      if (first_page < last_page)
+        madvise(reinterpret_cast<void *>(first_page),
+                last_page - first_page,
+                MADV_DONTNEED);
+#endif
+    }
+
+
+    /**
+     * Runtime switch for backing large arrays by transparent huge pages,
+     * see advise_huge_pages(). The switch is set by the "use huge pages"
+     * parameter of the TimeLoop and has to be set before the arrays are
+     * allocated.
+     *
+     * @ingroup Miscellaneous
+     */
+    inline bool &huge_pages_enabled()
+    {
+      static bool enabled = false;
+      return enabled;
+    }
+
+
+    /**
+     * If huge_pages_enabled() is set, mark all 2 MiB huge pages that lie
+     * entirely within the range [@p data, @p data + @p size) as eligible
+     * for transparent huge pages (madvise(MADV_HUGEPAGE)). The range is
+     * subsequently released with MADV_DONTNEED so that the next (first)
+     * write access allocates a huge page instead of 512 small pages.
+     *
+     * @note The content of the released pages is lost, the function must
+     * thus only be called on zero-initialized memory. Explicit (1 GiB)
+     * huge pages from a hugetlbfs pool are not supported because the
+     * storage of deal.II vectors cannot be allocated with a custom
+     * allocator.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <typename T>
+    void advise_huge_pages([[maybe_unused]] T *data,
+                           [[maybe_unused]] const std::size_t size)
+    {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      if (!huge_pages_enabled() || data == nullptr || size == 0)
+        return;
+
+      constexpr std::uintptr_t huge_page_size = 2 * 1024 * 1024;
+      const auto begin = reinterpret_cast<std::uintptr_t>(data);
+      const auto end = reinterpret_cast<std::uintptr_t>(data + size);
+
+      const auto first_page =
+          (begin + huge_page_size - 1) / huge_page_size * huge_page_size;
+      const auto last_page = end / huge_page_size * huge_page_size;
+
+      if (first_page < last_page) {
+        madvise(reinterpret_cast<void *>(first_page),
+                last_page - first_page,
+                MADV_HUGEPAGE);
+        madvise(reinterpret_cast<void *>(first_page),
+                last_page - first_page,
+                MADV_DONTNEED);
+      }
+#endif
+    }
+
+
+    /**
+     * Reset the (zero-initialized) array [@p data, @p data + @p size) to
+     * zero with the same static OpenMP schedule that is used by the
+     * compute kernels, i.e., by slicing the SIMD row range [0, @p
+     * n_internal) in chunks of @p simd_length rows and the remaining
+     * locally owned rows [@p n_internal, @p n_owned) individually. The
+     * callable @p row_range(i) has to return the (half-open) range of
+     * array offsets [first, last) corresponding to the row chunk starting
+     * at row i. All entries beyond the locally owned range (ghost rows)
+     * are zeroed by the calling thread.
+     *
+     * Together with release_pages() this ensures that the memory pages
+     * of the array reside on the NUMA domain of the thread that later
+     * processes the corresponding rows.
+     *
+     * The function first calls advise_huge_pages() and is otherwise a
+     * no-op unless the compile-time option NUMA_FIRST_TOUCH is set.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <typename T, typename Callable>
+    void first_touch([[maybe_unused]] T *data,
+                     [[maybe_unused]] const std::size_t size,
+                     [[maybe_unused]] const unsigned int n_internal,
+                     [[maybe_unused]] const unsigned int n_owned,
+                     [[maybe_unused]] const unsigned int simd_length,
+                     [[maybe_unused]] const Callable &row_range)
+    {
+      if (data == nullptr || size == 0)
+        return;
+
+      advise_huge_pages(data, size);
+
+#ifdef NUMA_FIRST_TOUCH
+      release_pages(data, size);
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_internal; i += simd_length) {
+        const auto [first, last] = row_range(i);
+        std::fill(data + first, data + last, T());
+      }
+
+      RYUJIN_OMP_FOR
+      for (unsigned int i = n_internal; i < n_owned; ++i) {
+        const auto [first, last] = row_range(i);
+        std::fill(data + first, data + last, T());
+      }
+
+      RYUJIN_PARALLEL_REGION_END
+
+      const std::size_t owned_end =
+          n_owned == 0 ? 0 : row_range(n_owned - 1).second;
+      std::fill(data + owned_end, data + size, T());
+#endif
+    }
+
+
+    /**
+     * Variant of first_touch() for (distributed) vectors storing
+     * @p n_components consecutive entries per degree of freedom. The
+     * locally owned range is sliced in chunks of @p simd_length rows
+     * (with a remainder of less than simd_length rows processed
+     * individually), approximating the schedule of the compute kernels.
+     *
+     * The function first calls advise_huge_pages() and is otherwise a
+     * no-op unless the compile-time option NUMA_FIRST_TOUCH is set.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <typename VectorType>
+    void first_touch_vector(VectorType &vector,
+                            const unsigned int n_components,
+                            const unsigned int simd_length)
+    {
+      if (n_components == 0)
+        return;
+
+      const auto &partitioner = vector.get_partitioner();
+      const std::size_t size =
+          partitioner->locally_owned_size() + partitioner->n_ghost_indices();
+      const unsigned int n_owned =
+          partitioner->locally_owned_size() / n_components;
+      const unsigned int n_internal = n_owned - n_owned % simd_length;
+
+      first_touch(vector.begin(),
+                  size,
+                  n_internal,
+                  n_owned,
+                  simd_length,
+                  [&](const unsigned int i) {
+                    const unsigned int stride =
+                        i < n_internal ? simd_length : 1;
+                    return std::make_pair(std::size_t(i) * n_components,
+                                          std::size_t(i + stride) *
+                                              n_components);
+                  });
+    }
+
+
+    /**
+     * Return the amount of memory (in MiB) of the current process that
+     * resides on each NUMA domain. The information is parsed from
+     * /proc/self/numa_maps; the function returns an empty vector if the
+     * file is not available.
+     *
+     * @ingroup Miscellaneous
+     */
+    inline std::vector<double> memory_per_domain()
+    {
+      std::vector<double> result;
+
+      std::ifstream numa_maps("/proc/self/numa_maps");
+      if (!numa_maps)
+        return result;
+
+      std::string line;
+      while (std::getline(numa_maps, line)) {
+        std::istringstream tokens(line);
+
+        double page_size_kb = 4.;
+        std::vector<std::pair<unsigned int, double>> pages;
+
+        std::string token;
+        while (tokens >> token) {
+          const auto position = token.find('=');
+          if (position == std::string::npos)
+            continue;
+
+          const auto key = token.substr(0, position);
+          const auto value = token.substr(position + 1);
+
+          if (key == "kernelpagesize_kB") {
+            page_size_kb = std::stod(value);
+
+          } else if (key.size() > 1 && key[0] == 'N' &&
+                     std::all_of(key.begin() + 1, key.end(), [](char c) {
+                       return std::isdigit(static_cast<unsigned char>(c));
+                     })) {
+            pages.emplace_back(std::stoul(key.substr(1)), std::stod(value));
+          }
+        }
+
+        for (const auto &[node, n_pages] : pages) {
+          if (node >= result.size())
+            result.resize(node + 1, 0.);
+          result[node] += n_pages * page_size_kb / 1024.;
+        }
+      }
+
+      return result;
+    }
+
+
+    /**
+     * Return the fraction of anonymous memory of the current process
+     * that is backed by transparent huge pages. The information is
+     * parsed from /proc/self/smaps_rollup; the function returns 0 if the
+     * file is not available.
+     *
+     * @ingroup Miscellaneous
+     */
+    inline double huge_page_coverage()
+    {
+      std::ifstream smaps("/proc/self/smaps_rollup");
+      if (!smaps)
+        return 0.;
+
+      double anonymous = 0.;
+      double anonymous_huge_pages = 0.;
+
+      std::string key;
+      double value;
+      while (smaps >> key) {
+        if (key == "Anonymous:" && smaps >> value)
+          anonymous = value;
+        else if (key == "AnonHugePages:" && smaps >> value)
+          anonymous_huge_pages = value;
+      }
+
+      return anonymous > 0. ? anonymous_huge_pages / anonymous : 0.;
+    }
+  } // namespace NUMA
+} // namespace ryujin
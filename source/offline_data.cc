@@ -12,4 +12,10 @@ namespace ryujin
   template class OfflineData<2, NUMBER>;
   template class OfflineData<3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class OfflineData<1, float>;
+  template class OfflineData<2, float>;
+  template class OfflineData<3, float>;
+#endif
+
 } /* namespace ryujin */
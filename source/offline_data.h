@@ -9,7 +9,9 @@
 
 #include "convenience_macros.h"
 #include "discretization.h"
+#include "lazy.h"
 #include "mpi_ensemble.h"
+#include "patterns_conversion.h"
 #include "sparse_matrix_simd.h"
 #include "state_vector.h"
 
@@ -23,6 +25,49 @@
 
 #include <deal.II/numerics/data_out.h>
 
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * An enum class for choosing the degree of freedom renumbering that is
+   * applied to the locally owned index range before the degrees of
+   * freedom are grouped into SIMD strides.
+   *
+   * @ingroup Mesh
+   */
+  enum class Renumbering {
+    /** Cuthill McKee renumbering: */
+    cuthill_mckee,
+
+    /**
+     * Order the degrees of freedom along a Hilbert space filling curve
+     * through their support points:
+     */
+    hilbert_curve,
+
+    /**
+     * Order the locally owned cells along a Hilbert space filling curve
+     * through their centers and number the degrees of freedom of every
+     * cell consecutively. This is the preferred choice for a
+     * discontinuous ansatz:
+     */
+    cell_wise_hilbert_curve,
+  };
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::Renumbering,
+             LIST({ryujin::Renumbering::cuthill_mckee, "Cuthill McKee"},
+                  {ryujin::Renumbering::hilbert_curve, "Hilbert curve"},
+                  {ryujin::Renumbering::cell_wise_hilbert_curve,
+                   "cell-wise Hilbert curve"}));
+#endif
+
 namespace ryujin
 {
   /**
@@ -83,6 +128,24 @@ namespace ryujin
                                            unsigned int /*col_idx*/,
                                            unsigned int /*j*/>;
 
+    /**
+     * The full rows of all ghost degrees of freedom that are coupled to a
+     * locally owned degree of freedom, see the "extended ghost halo" run
+     * time parameter. Row k belongs to the (local) ghost index rows[k] and
+     * consists of the local column indices and c_ij tensors in the half
+     * open range [row_starts[k], row_starts[k+1]). The entries are stored
+     * in the order of the owning rank, the diagonal comes first.
+     * vectorized[k] is set if the owning rank processes the row with the
+     * SIMD vectorized kernels, i.e., if it is locally internal there.
+     */
+    struct GhostHalo {
+      std::vector<unsigned int> rows;
+      std::vector<unsigned int> row_starts;
+      std::vector<unsigned int> columns;
+      std::vector<dealii::Tensor<1, dim, Number>> cij;
+      std::vector<char> vectorized;
+    };
+
     /**
      * Constructor
      */
@@ -90,24 +153,51 @@ namespace ryujin
                 const Discretization<dim> &discretization,
                 const std::string &subsection = "/OfflineData");
 
+    /**
+     * Destructor. Frees all shared memory windows, see prepare().
+     */
+    ~OfflineData();
+
     /**
      * Prepare offline data. A call to prepare() internally calls setup()
      * and assemble().
      *
+     * If the "cache directory" run time parameter is set, the degree of
+     * freedom renumbering and all assembled matrices are read from (or
+     * written to) a binary cache file per MPI rank. The cache is keyed on
+     * a format version, the mesh (including the mapped geometry), the
+     * finite element ansatz, and the number of MPI ranks.
+     * On a valid cache entry the expensive renumbering and the matrix
+     * assembly are skipped entirely.
+     *
+     * If the "share between ensembles" run time parameter is set, the
+     * kth ranks of all ensembles that run on the same compute node (see
+     * MPIEnsemble::node_peer_communicator()) hold a single copy of all
+     * assembled matrices in an MPI-3 shared memory window. The matrices
+     * are assembled (or read from the cache) only by ensembles that
+     * contain a rank providing the shared copy. This requires that all
+     * ensembles use the same mesh and that prepare() is called by all
+     * ensembles collectively.
+     *
+     * The memory high-water mark of every phase of prepare() is recorded
+     * and can be queried with memory_high_water_marks().
+     *
      * The problem_dimension and n_precomputed_values parameters is used to
      * set up appropriately sized vector partitioners for the state and
      * precomputed MultiComponentVector.
      */
     void prepare(const unsigned int problem_dimension,
                  const unsigned int n_precomputed_values,
-                 const unsigned int n_parabolic_state_vectors)
-    {
-      setup(problem_dimension, n_precomputed_values);
-      assemble();
-      create_multigrid_data();
+                 const unsigned int n_parabolic_state_vectors);
 
-      n_parabolic_state_vectors_ = n_parabolic_state_vectors;
-    }
+    /**
+     * Only set up the DoFHandler, the partition and the (SIMD) sparsity
+     * pattern without allocating or assembling any matrix. This is used
+     * by the "dry run" mode of the TimeLoop to estimate the memory
+     * footprint of a run from the row lengths of the sparsity pattern.
+     */
+    void prepare_partition(const unsigned int problem_dimension,
+                           const unsigned int n_precomputed_values);
 
     /**
      * The DofHandler for our (scalar) CG ansatz space in (deal.II typical)
@@ -139,6 +229,21 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY_NO_DEREFERENCE(precomputed_vector_partitioner)
 
+    /**
+     * The communicator passed to the reinit() function of all ghosted
+     * state vectors: If the "shared memory ghost exchange" option is set
+     * this is the MPIEnsemble::ensemble_node_communicator(); the vectors
+     * are then allocated in MPI-3 shared memory windows and ghost values
+     * owned by ranks on the same node are read directly instead of being
+     * sent via MPI messages. Otherwise MPI_COMM_SELF is returned.
+     */
+    MPI_Comm shared_memory_communicator() const
+    {
+      return shared_memory_ghost_exchange_
+                 ? mpi_ensemble_.ensemble_node_communicator()
+                 : MPI_COMM_SELF;
+    }
+
     /**
      * The block size of the parabolic state vector.
      */
@@ -201,15 +306,40 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(coupling_boundary_pairs)
 
+    /**
+     * Return true if the ghost range of all partitioners has been
+     * extended by a second layer of degrees of freedom, see the "extended
+     * ghost halo" run time parameter.
+     */
+    ACCESSOR_READ_ONLY(extended_ghost_halo)
+
+    /**
+     * The full rows of all ghost degrees of freedom coupled to a locally
+     * owned degree of freedom, see GhostHalo. Empty unless the ghost
+     * range has been extended, see extended_ghost_halo().
+     */
+    ACCESSOR_READ_ONLY(ghost_halo)
+
     /**
      * The boundary map on all levels of the grid in case multilevel
      * support was enabled.
+     *
+     * @note All multigrid data (including the level degrees of freedom of
+     * the DoFHandler) is created on first access to level_boundary_map()
+     * or level_lumped_mass_matrix(). The first call is thus collective
+     * and has to happen on all MPI ranks of the ensemble.
      */
-    ACCESSOR_READ_ONLY(level_boundary_map)
+    const auto &level_boundary_map() const
+    {
+      return multigrid_data().level_boundary_map;
+    }
 
     /**
      * A sparsity pattern for (standard deal.II) matrices storing indices
      * in (Deal.II typical) global numbering.
+     *
+     * @note The sparsity pattern is empty after prepare() if the "memory
+     * lean setup" run time parameter is set.
      */
     ACCESSOR_READ_ONLY(sparsity_pattern)
 
@@ -245,9 +375,12 @@ namespace ryujin
 
     /**
      * The lumped mass matrix on all levels of the grid in case multilevel
-     * support was enabled.
+     * support was enabled. See the note of level_boundary_map().
      */
-    ACCESSOR_READ_ONLY(level_lumped_mass_matrix)
+    const auto &level_lumped_mass_matrix() const
+    {
+      return multigrid_data().level_lumped_mass_matrix;
+    }
 
     /**
      * The \f$(c_{ij})\f$ matrix. (SIMD storage, local numbering)
@@ -265,6 +398,31 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(incidence_matrix)
 
+    /**
+     * Returns true if the norms \f$|c_{ij}|\f$ and the normalized
+     * directions \f$n_{ij} = c_{ij}/|c_{ij}|\f$ have been precomputed
+     * and can be queried with cij_norm_matrix() and nij_matrix().
+     */
+    ACCESSOR_READ_ONLY(precompute_normalized_cij)
+
+    /**
+     * The matrix of norms \f$(|c_{ij}|)\f$. (SIMD storage, local
+     * numbering)
+     *
+     * This matrix is only available if the "precompute normalized cij"
+     * run time parameter is set.
+     */
+    ACCESSOR_READ_ONLY(cij_norm_matrix)
+
+    /**
+     * The matrix of normalized directions \f$(n_{ij})\f$. (SIMD storage,
+     * local numbering)
+     *
+     * This matrix is only available if the "precompute normalized cij"
+     * run time parameter is set.
+     */
+    ACCESSOR_READ_ONLY(nij_matrix)
+
     /**
      * Size of computational domain.
      */
@@ -275,6 +433,13 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(discretization)
 
+    /**
+     * A vector of pairs consisting of the name of a phase of prepare()
+     * ("setup", and "assemble" or "read cache") and the memory
+     * high-water mark (in MiB) of the process during that phase.
+     */
+    ACCESSOR_READ_ONLY(memory_high_water_marks)
+
   private:
     /**
      * Private methods used in prepare()
@@ -289,13 +454,14 @@ namespace ryujin
 
     /**
      * Set up DoFHandler, all IndexSet objects and the SparsityPattern.
-     * Initialize matrix storage.
+     * Initialize matrix storage if @p allocate_matrices is set to true.
      *
      * The problem_dimension parameter is used to setup up an appropriately
      * sized vector partitioner for the MultiComponentVector.
      */
     void setup(const unsigned int problem_dimension,
-               const unsigned int n_precomputed_values);
+               const unsigned int n_precomputed_values,
+               const bool allocate_matrices = true);
 
     /**
      * Assemble all matrices.
@@ -303,9 +469,128 @@ namespace ryujin
     void assemble();
 
     /**
-     * Create multigrid data.
+     * Receive the full rows of all ghost degrees of freedom from their
+     * owners and store them in ghost_halo_. Does nothing unless the ghost
+     * range is extended.
+     */
+    void setup_ghost_halo();
+
+    /**
+     * Boundary maps and lumped mass matrices on all levels of the grid.
      */
-    void create_multigrid_data();
+    struct MultigridData {
+      std::vector<std::vector<BoundaryDescription>> level_boundary_map;
+      std::vector<ScalarVectorFloat> level_lumped_mass_matrix;
+    };
+
+    /**
+     * Distribute level degrees of freedom and create multigrid data.
+     * Internally used by multigrid_data().
+     */
+    MultigridData create_multigrid_data() const;
+
+    /**
+     * Return the multigrid data, creating it on first access.
+     */
+    const MultigridData &multigrid_data() const
+    {
+      multigrid_data_.ensure_initialized(
+          [&]() { return create_multigrid_data(); });
+      return multigrid_data_.value();
+    }
+
+    //@}
+    /**
+     * @name Offline data cache
+     */
+    //@{
+
+    /**
+     * Compute the cache key and the name of the cache files for the
+     * current mesh and DoFHandler. Internally used in setup().
+     */
+    void prepare_cache();
+
+    /**
+     * Read the degree of freedom renumbering from the cache and apply it
+     * to the DoFHandler. Returns false (on all ranks) if no valid cache
+     * entry exists on any rank.
+     */
+    bool read_cached_renumbering();
+
+    /**
+     * Write the degree of freedom renumbering @p new_order (indexed by
+     * the initial locally owned index range) to the cache.
+     */
+    void write_cached_renumbering(
+        const std::vector<dealii::types::global_dof_index> &new_order) const;
+
+    /**
+     * Read all assembled matrices, the lumped mass matrix, the boundary
+     * map and the coupling boundary pairs from the cache. Returns false
+     * (on all ranks) if no valid cache entry exists on any rank.
+     */
+    bool read_cached_matrices();
+
+    /**
+     * Write all assembled data to the cache.
+     */
+    void write_cached_matrices() const;
+
+    /**
+     * Write the cache key to @p out and read and verify it from @p in,
+     * respectively.
+     */
+    void write_cache_header(std::ostream &out) const;
+    bool read_cache_header(std::istream &in) const;
+
+    /**
+     * Write the locally owned part of the lumped mass matrix, the
+     * boundary map and the coupling boundary pairs to @p out and read
+     * them from @p in, respectively.
+     */
+    void write_auxiliary_data(std::ostream &out) const;
+    void read_auxiliary_data(std::istream &in);
+
+    /**
+     * Create the cache file with given @p suffix by invoking
+     * @p writer(std::ostream &). The file is written to a temporary
+     * file first and then moved into place.
+     */
+    template <typename Callable>
+    void write_cache_file(const std::string &suffix,
+                          const Callable &writer) const;
+
+    /**
+     * The version of the binary cache format. Increment whenever the
+     * layout of the cache files or the content of the cached data
+     * changes.
+     */
+    static constexpr std::uint64_t cache_format_version = 1;
+
+    std::string cache_name_;
+    std::vector<std::uint64_t> cache_key_;
+
+    //@}
+    /**
+     * @name Sharing offline data between ensembles
+     */
+    //@{
+
+    /**
+     * Move all assembled matrices into shared memory windows over the
+     * node peer communicator and distribute the auxiliary data of the
+     * providing rank to all ranks that have not assembled. Internally
+     * used in prepare().
+     */
+    void share_assembled_data(const bool assembled);
+
+    /**
+     * Collectively free all shared memory windows.
+     */
+    void free_shared_windows();
+
+    std::vector<MPI_Win> shared_windows_;
 
     //@}
     /**
@@ -337,29 +622,34 @@ namespace ryujin
 
     using BoundaryMap = std::vector<BoundaryDescription>;
     BoundaryMap boundary_map_;
-    std::vector<BoundaryMap> level_boundary_map_;
 
     using CouplingBoundaryPairs = std::vector<CouplingDescription>;
     CouplingBoundaryPairs coupling_boundary_pairs_;
 
+    GhostHalo ghost_halo_;
+
     dealii::DynamicSparsityPattern sparsity_pattern_;
 
-    SparsityPatternSIMD<dealii::VectorizedArray<Number>::size()>
-        sparsity_pattern_simd_;
+    SparsityPatternSIMD<simd_width<Number>> sparsity_pattern_simd_;
 
-    SparseMatrixSIMD<Number> mass_matrix_;
-    SparseMatrixSIMD<Number> mass_matrix_inverse_;
+    StorageSparseMatrixSIMD<Number> mass_matrix_;
+    StorageSparseMatrixSIMD<Number> mass_matrix_inverse_;
 
     ScalarVector lumped_mass_matrix_;
     ScalarVector lumped_mass_matrix_inverse_;
 
-    std::vector<ScalarVectorFloat> level_lumped_mass_matrix_;
+    Lazy<MultigridData> multigrid_data_;
 
-    SparseMatrixSIMD<Number, dim> cij_matrix_;
-    SparseMatrixSIMD<Number> incidence_matrix_;
+    StorageSparseMatrixSIMD<Number, dim> cij_matrix_;
+    StorageSparseMatrixSIMD<Number> incidence_matrix_;
+
+    StorageSparseMatrixSIMD<Number> cij_norm_matrix_;
+    StorageSparseMatrixSIMD<Number, dim> nij_matrix_;
 
     Number measure_of_omega_;
 
+    std::vector<std::pair<std::string, double>> memory_high_water_marks_;
+
     dealii::SmartPointer<const Discretization<dim>> discretization_;
 
     /**
@@ -390,6 +680,22 @@ namespace ryujin
     double incidence_relaxation_even_;
     double incidence_relaxation_odd_;
 
+    bool precompute_normalized_cij_;
+
+    Renumbering renumbering_;
+
+    bool direct_assembly_;
+
+    bool memory_lean_setup_;
+
+    std::string cache_directory_;
+
+    bool share_between_ensembles_;
+
+    bool shared_memory_ghost_exchange_;
+
+    bool extended_ghost_halo_;
+
     //@}
   };
 
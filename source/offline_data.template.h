@@ -14,6 +14,7 @@
 
 #include <deal.II/base/graph_coloring.h>
 #include <deal.II/base/parallel.h>
+#include <deal.II/base/utilities.h>
 #include <deal.II/base/work_stream.h>
 #include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_tools.h>
@@ -25,6 +26,15 @@
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 #endif
 
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+
 #ifdef FORCE_DEAL_II_SPARSE_MATRIX
 #undef DEAL_II_WITH_TRILINOS
 #endif
@@ -56,6 +66,284 @@ namespace ryujin
                   "Scaling exponent for incidence matrix used for "
                   "discontinuous finite elements with even degree. The default "
                   "value of 0.0 sets the jump penalization to a constant 1.");
+
+    precompute_normalized_cij_ = false;
+    add_parameter("precompute normalized cij",
+                  precompute_normalized_cij_,
+                  "Precompute and store the norms |c_ij| and normalized "
+                  "directions n_ij = c_ij / |c_ij|. This trades additional "
+                  "memory (and memory bandwidth) for avoiding a square root "
+                  "and dim divisions per stencil entry and stage when "
+                  "computing the graph viscosity d_ij.");
+
+    renumbering_ = Renumbering::cuthill_mckee;
+    add_parameter("dof renumbering",
+                  renumbering_,
+                  "Renumbering of the locally owned degrees of freedom that is "
+                  "applied prior to grouping them into SIMD strides. Possible "
+                  "values: Cuthill McKee, Hilbert curve, cell-wise Hilbert "
+                  "curve. The Hilbert curve ordering improves cache reuse of "
+                  "stencil gathers on unstructured meshes. The cell-wise "
+                  "variant numbers the degrees of freedom of every cell "
+                  "consecutively and is best suited for a discontinuous "
+                  "ansatz.");
+
+    direct_assembly_ = false;
+    add_parameter("direct assembly",
+                  direct_assembly_,
+                  "Assemble all matrices directly into the SIMD matrix storage "
+                  "(thread parallel via graph coloring) instead of going "
+                  "through global sparse matrix temporaries. This reduces "
+                  "the peak memory consumption during setup substantially. "
+                  "Only used for meshes without hanging node or periodicity "
+                  "constraints and full precision matrix storage.");
+
+    memory_lean_setup_ = false;
+    add_parameter("memory lean setup",
+                  memory_lean_setup_,
+                  "Release all intermediate sparsity patterns and assembly "
+                  "temporaries as soon as they are no longer needed. This "
+                  "reduces the peak memory consumption of prepare() at the "
+                  "expense of no longer providing sparsity_pattern().");
+
+    cache_directory_ = "";
+    add_parameter("cache directory",
+                  cache_directory_,
+                  "If set to a nonempty string, the degree of freedom "
+                  "renumbering and all assembled matrices are stored in (and "
+                  "reloaded from) binary cache files in this directory. "
+                  "Cache entries are keyed on the mesh, the finite element "
+                  "ansatz and the number of MPI ranks.");
+
+    share_between_ensembles_ = false;
+    add_parameter("share between ensembles",
+                  share_between_ensembles_,
+                  "Hold a single copy of all assembled matrices per compute "
+                  "node that is shared (via MPI-3 shared memory) by all "
+                  "ensembles running on the node. The matrices are then "
+                  "only assembled once per node. Requires that all ensembles "
+                  "use an identical mesh and refine it in lockstep.");
+
+    shared_memory_ghost_exchange_ = false;
+    add_parameter("shared memory ghost exchange",
+                  shared_memory_ghost_exchange_,
+                  "Allocate the state vectors of all ranks of an ensemble "
+                  "running on the same compute node in MPI-3 shared memory "
+                  "windows. Ghost values owned by a rank on the same node "
+                  "are then copied directly from its memory. Only ghost "
+                  "values owned by ranks on other nodes are exchanged via "
+                  "MPI messages.");
+
+    extended_ghost_halo_ = false;
+    add_parameter("extended ghost halo",
+                  extended_ghost_halo_,
+                  "Extend the ghost range of all vectors by a second layer of "
+                  "degrees of freedom and store the full stencil of every "
+                  "ghost row. The indicator alpha_i is then computed "
+                  "redundantly (and bitwise identical to the owning rank) on "
+                  "ghost rows instead of being exchanged, unless an active "
+                  "set is used. This saves one (latency bound) ghost "
+                  "exchange per stage at the cost of larger messages (all "
+                  "precomputed values are exchanged), duplicate work at "
+                  "partition boundaries, and a larger export index range.");
+  }
+
+
+  template <int dim, typename Number>
+  OfflineData<dim, Number>::~OfflineData()
+  {
+    free_shared_windows();
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::prepare(
+      const unsigned int problem_dimension,
+      const unsigned int n_precomputed_values,
+      const unsigned int n_parabolic_state_vectors)
+  {
+    /*
+     * We record the memory high-water mark of every phase. On Linux the
+     * high-water mark can be reset by writing "5" to clear_refs; on other
+     * platforms the recorded values are cumulative.
+     */
+
+    memory_high_water_marks_.clear();
+
+    const auto reset_high_water_mark = []() {
+      std::ofstream file("/proc/self/clear_refs");
+      file << "5";
+    };
+
+    const auto record_high_water_mark = [&](const std::string &phase) {
+      Utilities::System::MemoryStats stats;
+      Utilities::System::get_memory_stats(stats);
+      memory_high_water_marks_.emplace_back(phase, stats.VmHWM / 1024.);
+      reset_high_water_mark();
+    };
+
+    reset_high_water_mark();
+
+    setup(problem_dimension, n_precomputed_values);
+    record_high_water_mark("setup");
+
+    /*
+     * setup() has moved all matrices back to storage of their own, we
+     * can thus release the shared memory windows of a previous call:
+     */
+    free_shared_windows();
+
+    const bool share =
+        share_between_ensembles_ && mpi_ensemble_.n_ensembles() > 1;
+
+    /*
+     * If we share offline data, only rank 0 of every node peer group
+     * provides the data. Assembly is collective over the ensemble, the
+     * whole ensemble thus assembles if any of its ranks is a provider:
+     */
+    const bool provider =
+        !share || Utilities::MPI::this_mpi_process(
+                      mpi_ensemble_.node_peer_communicator()) == 0;
+    const bool assembled =
+        Utilities::MPI::max(static_cast<unsigned int>(provider),
+                            mpi_ensemble_.ensemble_communicator()) == 1;
+
+    if (assembled) {
+      if (read_cached_matrices()) {
+        record_high_water_mark("read cache");
+      } else {
+        assemble();
+        write_cached_matrices();
+        record_high_water_mark("assemble");
+      }
+    }
+
+    if (share) {
+      share_assembled_data(assembled);
+      record_high_water_mark("share");
+    }
+
+    setup_ghost_halo();
+
+    /*
+     * The DynamicSparsityPattern is not needed after assembly:
+     */
+    if (memory_lean_setup_)
+      sparsity_pattern_.reinit(0, 0);
+
+    /*
+     * Multigrid data is only created on demand, see multigrid_data():
+     */
+    multigrid_data_.reset();
+
+    n_parabolic_state_vectors_ = n_parabolic_state_vectors;
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::setup_ghost_halo()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::setup_ghost_halo()" << std::endl;
+#endif
+
+    ghost_halo_ = GhostHalo();
+
+    if (!extended_ghost_halo_)
+      return;
+
+    constexpr auto simd_length = simd_width<Number>;
+    const auto &sparsity = sparsity_pattern_simd_;
+
+    const auto column = [&](const unsigned int i, const unsigned int col_idx) {
+      const unsigned int *js = sparsity.columns(i);
+      return *(i < n_locally_internal_ ? js + col_idx * simd_length
+                                       : js + col_idx);
+    };
+
+    /*
+     * Send every locally owned row with a ghost exchange as a block of
+     * max_row_length entries, each consisting of the global column index
+     * (stored as double, set to -1 for unused entries) and the dim
+     * components of c_ij. The entries are stored in the local order of
+     * the row so that the receiving rank accumulates the stencil in
+     * exactly the same order. The last entry of the block records whether
+     * the row is locally internal on the owning rank:
+     */
+
+    unsigned int max_row_length = 0;
+    for (unsigned int i = 0; i < n_locally_owned_; ++i)
+      max_row_length = std::max(max_row_length, sparsity.row_length(i));
+    max_row_length = Utilities::MPI::max(max_row_length,
+                                         mpi_ensemble_.ensemble_communicator());
+
+    constexpr unsigned int entry_size = dim + 1;
+    const unsigned int block_size = max_row_length * entry_size + 1;
+
+    LinearAlgebra::distributed::Vector<double> rows(
+        Vectors::create_vector_partitioner(scalar_partitioner_, block_size));
+    rows = -1.;
+
+    for (unsigned int i = 0; i < n_locally_owned_; ++i) {
+      const unsigned int row_length = sparsity.row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+        const auto position =
+            std::size_t(i) * block_size + col_idx * entry_size;
+        rows.local_element(position) =
+            scalar_partitioner_->local_to_global(column(i, col_idx));
+        const auto c_ij = cij_matrix_.get_tensor(i, col_idx);
+        for (unsigned int d = 0; d < dim; ++d)
+          rows.local_element(position + 1 + d) = c_ij[d];
+      }
+      rows.local_element(std::size_t(i + 1) * block_size - 1) =
+          i < n_locally_internal_ ? 1. : 0.;
+    }
+
+    rows.update_ghost_values();
+
+    /* We only store ghost rows that are coupled to a locally owned row: */
+
+    std::vector<bool> coupled(n_locally_relevant_ - n_locally_owned_, false);
+    for (unsigned int i = 0; i < n_locally_owned_; ++i) {
+      const unsigned int row_length = sparsity.row_length(i);
+      for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+        const auto j = column(i, col_idx);
+        if (j >= n_locally_owned_)
+          coupled[j - n_locally_owned_] = true;
+      }
+    }
+
+    auto &[halo_rows, row_starts, columns, cij, vectorized] = ghost_halo_;
+    row_starts.push_back(0);
+
+    for (unsigned int j = n_locally_owned_; j < n_locally_relevant_; ++j) {
+      if (!coupled[j - n_locally_owned_])
+        continue;
+
+      halo_rows.push_back(j);
+      vectorized.push_back(
+          rows.local_element(std::size_t(j + 1) * block_size - 1) != 0.);
+      for (unsigned int col_idx = 0; col_idx < max_row_length; ++col_idx) {
+        const auto position =
+            std::size_t(j) * block_size + col_idx * entry_size;
+        const double global_column = rows.local_element(position);
+        if (global_column < 0.)
+          break;
+
+        /* All columns are part of the second layer, see setup(): */
+        const auto index = static_cast<types::global_dof_index>(global_column);
+        Assert(scalar_partitioner_->in_local_range(index) ||
+                   scalar_partitioner_->is_ghost_entry(index),
+               ExcInternalError());
+        columns.push_back(scalar_partitioner_->global_to_local(index));
+
+        Tensor<1, dim, Number> c_ij;
+        for (unsigned int d = 0; d < dim; ++d)
+          c_ij[d] = rows.local_element(position + 1 + d);
+        cij.push_back(c_ij);
+      }
+      row_starts.push_back(columns.size());
+    }
   }
 
 
@@ -186,9 +474,23 @@ namespace ryujin
   }
 
 
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::prepare_partition(
+      const unsigned int problem_dimension,
+      const unsigned int n_precomputed_values)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::prepare_partition()" << std::endl;
+#endif
+
+    setup(problem_dimension, n_precomputed_values, false);
+  }
+
+
   template <int dim, typename Number>
   void OfflineData<dim, Number>::setup(const unsigned int problem_dimension,
-                                       const unsigned int n_precomputed_values)
+                                       const unsigned int n_precomputed_values,
+                                       const bool allocate_matrices)
   {
 #ifdef DEBUG_OUTPUT
     std::cout << "OfflineData<dim, Number>::setup()" << std::endl;
@@ -207,59 +509,12 @@ namespace ryujin
 
     n_locally_owned_ = dof_handler.locally_owned_dofs().n_elements();
 
-    /*
-     * Renumbering:
-     */
-
-    DoFRenumbering::Cuthill_McKee(dof_handler);
-
-    /*
-     * Reorder all (individual) export indices at the beginning of the
-     * locally_internal index range to achieve a better packing:
-     *
-     * Note: This function might miss export indices that come from
-     * eliminating hanging node and periodicity constraints (which we do
-     * not know at this point because they depend on the renumbering...).
-     */
-    DoFRenumbering::export_indices_first(dof_handler,
-                                         mpi_ensemble_.ensemble_communicator(),
-                                         n_locally_owned_,
-                                         1);
-
-    /*
-     * Group degrees of freedom that have the same stencil size in groups
-     * of multiples of the VectorizedArray<Number>::size().
-     *
-     * In order to determine the stencil size we have to create a first,
-     * temporary sparsity pattern:
-     */
-    create_constraints_and_sparsity_pattern();
-    n_locally_internal_ = DoFRenumbering::internal_range(
-        dof_handler, sparsity_pattern_, VectorizedArray<Number>::size());
-
-    /*
-     * Reorder all (strides of) locally internal indices that contain
-     * export indices to the start of the index range. This reordering
-     * preserves the binning introduced by
-     * DoFRenumbering::internal_range().
-     *
-     * Note: This function might miss export indices that come from
-     * eliminating hanging node and periodicity constraints (which we do
-     * not know at this point because they depend on the renumbering...).
-     * We therefore have to update n_export_indices_ later again.
-     */
-    n_export_indices_ = DoFRenumbering::export_indices_first(
-        dof_handler,
-        mpi_ensemble_.ensemble_communicator(),
-        n_locally_internal_,
-        VectorizedArray<Number>::size());
-
     /*
      * A small lambda to check for stride-level consistency of the internal
      * index range:
      */
     const auto consistent_stride_range [[maybe_unused]] = [&]() {
-      constexpr auto group_size = VectorizedArray<Number>::size();
+      constexpr auto group_size = simd_width<Number>;
       const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
       const auto offset = n_locally_owned_ != 0 ? *locally_owned.begin() : 0;
 
@@ -290,39 +545,185 @@ namespace ryujin
     };
 
     /*
-     * Create final sparsity pattern:
+     * Renumbering: If the offline data cache holds a valid entry we
+     * simply apply the stored permutation. Otherwise, we renumber and
+     * record the final permutation by comparing the degrees of freedom of
+     * all locally owned cells before and after renumbering.
      */
 
-    create_constraints_and_sparsity_pattern();
+    const auto locally_owned_cell_dofs = [&]() {
+      std::vector<types::global_dof_index> result;
+      std::vector<types::global_dof_index> indices;
+      for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+        indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(indices);
+        result.insert(result.end(), indices.begin(), indices.end());
+      }
+      return result;
+    };
 
-    /*
-     * We have to ensure that the locally internal numbering range is still
-     * consistent, meaning that all strides have the same stencil size.
-     * This property might not hold any more after the elimination
-     * procedure of constrained degrees of freedom (periodicity, or hanging
-     * node constraints). Therefore, the following little dance:
-     */
+    prepare_cache();
 
-#if DEAL_II_VERSION_GTE(9, 5, 0)
-    if (mpi_allreduce_logical_or(affine_constraints_.n_constraints() > 0)) {
-      if (mpi_allreduce_logical_or( //
-              consistent_stride_range() != n_locally_internal_)) {
-        /*
-         * In this case we try to fix up the numbering by pushing affected
-         * strides to the end and slightly lowering the n_locally_internal_
-         * marker.
-         */
-        n_locally_internal_ = DoFRenumbering::inconsistent_strides_last(
+    if (read_cached_renumbering()) {
+      create_constraints_and_sparsity_pattern();
+
+    } else {
+      std::vector<types::global_dof_index> initial_cell_dofs;
+      if (!cache_name_.empty())
+        initial_cell_dofs = locally_owned_cell_dofs();
+
+      switch (renumbering_) {
+      case Renumbering::cuthill_mckee:
+        DoFRenumbering::Cuthill_McKee(dof_handler);
+        break;
+      case Renumbering::hilbert_curve:
+        DoFRenumbering::hilbert_curve(dof_handler, discretization_->mapping());
+        break;
+      case Renumbering::cell_wise_hilbert_curve:
+        DoFRenumbering::cell_wise_hilbert_curve(dof_handler);
+        break;
+      }
+
+      /*
+       * Group degrees of freedom that have the same stencil size in groups
+       * of multiples of the simd_width<Number> and reorder all (strides
+       * of) locally internal indices that contain export indices to the
+       * start of the index range. Export indices are grouped first to
+       * achieve a better packing. All of this happens in a single,
+       * thread-parallel pass that needs a single exchange to determine
+       * the export indices. For unconstrained problems the result is
+       * identical to the individual renumberings (checked in debug mode).
+       *
+       * In order to determine the stencil size we have to create a first,
+       * temporary sparsity pattern.
+       *
+       * Note: The renumbering might miss export indices that come from
+       * eliminating hanging node and periodicity constraints (which we do
+       * not know at this point because they depend on the renumbering...).
+       * We therefore have to update n_export_indices_ later again.
+       */
+      create_constraints_and_sparsity_pattern();
+
+#ifdef DEBUG
+      /*
+       * Without constraints the row lengths do not depend on the
+       * numbering and the fused renumbering has to reproduce the
+       * individual renumberings export_indices_first(), internal_range()
+       * and export_indices_first() exactly. With constraints the row
+       * lengths seen by internal_range() depend on the preceding
+       * renumbering and the results may differ. We compute the
+       * reference numbering first and renumber back afterwards:
+       */
+      const bool check_renumbering =
+          !mpi_allreduce_logical_or(affine_constraints_.n_constraints() > 0);
+
+      std::vector<types::global_dof_index> reference_cell_dofs;
+      unsigned int reference_n_locally_internal = 0;
+      unsigned int reference_n_export_indices = 0;
+
+      if (check_renumbering) {
+        const auto cell_dofs = locally_owned_cell_dofs();
+
+        DoFRenumbering::export_indices_first(
             dof_handler,
-            sparsity_pattern_,
-            n_locally_internal_,
-            VectorizedArray<Number>::size());
+            mpi_ensemble_.ensemble_communicator(),
+            n_locally_owned_,
+            1);
         create_constraints_and_sparsity_pattern();
-        n_locally_internal_ = consistent_stride_range();
+        reference_n_locally_internal = DoFRenumbering::internal_range(
+            dof_handler, sparsity_pattern_, simd_width<Number>);
+        reference_n_export_indices = DoFRenumbering::export_indices_first(
+            dof_handler,
+            mpi_ensemble_.ensemble_communicator(),
+            reference_n_locally_internal,
+            simd_width<Number>);
+        reference_cell_dofs = locally_owned_cell_dofs();
+
+        const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+        const auto offset = n_locally_owned_ != 0 ? *locally_owned.begin() : 0;
+
+        std::vector<types::global_dof_index> new_order(n_locally_owned_);
+        for (std::size_t k = 0; k < reference_cell_dofs.size(); ++k) {
+          const auto index = reference_cell_dofs[k];
+          if (index >= offset && index - offset < n_locally_owned_)
+            new_order[index - offset] = cell_dofs[k];
+        }
+        dof_handler.renumber_dofs(new_order);
+        create_constraints_and_sparsity_pattern();
+        Assert(locally_owned_cell_dofs() == cell_dofs, ExcInternalError());
+      }
+#endif
+
+      std::tie(n_locally_internal_, n_export_indices_) =
+          DoFRenumbering::internal_range_export_indices_first(
+              dof_handler,
+              sparsity_pattern_,
+              mpi_ensemble_.ensemble_communicator(),
+              simd_width<Number>);
+
+#ifdef DEBUG
+      if (check_renumbering) {
+        Assert(n_locally_internal_ == reference_n_locally_internal &&
+                   n_export_indices_ == reference_n_export_indices &&
+                   locally_owned_cell_dofs() == reference_cell_dofs,
+               ExcMessage("The fused renumbering differs from the result of "
+                          "export_indices_first(), internal_range() and "
+                          "export_indices_first()"));
+      }
+#endif
+
+      /*
+       * Create final sparsity pattern:
+       */
+
+      create_constraints_and_sparsity_pattern();
+
+      /*
+       * We have to ensure that the locally internal numbering range is still
+       * consistent, meaning that all strides have the same stencil size.
+       * This property might not hold any more after the elimination
+       * procedure of constrained degrees of freedom (periodicity, or hanging
+       * node constraints). Therefore, the following little dance:
+       */
+
+#if DEAL_II_VERSION_GTE(9, 5, 0)
+      if (mpi_allreduce_logical_or(affine_constraints_.n_constraints() > 0)) {
+        if (mpi_allreduce_logical_or( //
+                consistent_stride_range() != n_locally_internal_)) {
+          /*
+           * In this case we try to fix up the numbering by pushing affected
+           * strides to the end and slightly lowering the n_locally_internal_
+           * marker.
+           */
+          n_locally_internal_ = DoFRenumbering::inconsistent_strides_last(
+              dof_handler,
+              sparsity_pattern_,
+              n_locally_internal_,
+              simd_width<Number>);
+          create_constraints_and_sparsity_pattern();
+          n_locally_internal_ = consistent_stride_range();
+        }
       }
-    }
 #endif
 
+      if (!cache_name_.empty()) {
+        const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+        const auto offset = n_locally_owned_ != 0 ? *locally_owned.begin() : 0;
+        const auto final_cell_dofs = locally_owned_cell_dofs();
+
+        std::vector<types::global_dof_index> new_order(n_locally_owned_);
+        for (std::size_t k = 0; k < initial_cell_dofs.size(); ++k) {
+          const auto index = initial_cell_dofs[k];
+          if (index >= offset && index - offset < n_locally_owned_)
+            new_order[index - offset] = final_cell_dofs[k];
+        }
+
+        write_cached_renumbering(new_order);
+      }
+    }
+
     /*
      * Check that after all the dof manipulation and setup we still end up
      * with indices in [0, locally_internal) that have uniform stencil size
@@ -354,6 +755,62 @@ namespace ryujin
       locally_relevant.compress();
     }
 
+    /*
+     * Extend the locally relevant set by a second layer consisting of all
+     * columns of the (full) rows of all ghost degrees of freedom. The full
+     * ghost rows are not known locally, we thus receive the column indices
+     * from the owning ranks with a ghost exchange. Every row is sent as a
+     * block of max_row_length global indices (stored as double, unused
+     * entries are set to -1):
+     */
+    if (extended_ghost_halo_) {
+      const auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+          locally_owned,
+          locally_relevant,
+          mpi_ensemble_.ensemble_communicator());
+
+      const auto offset = n_locally_owned_ != 0 ? *locally_owned.begin() : 0;
+
+      unsigned int max_row_length = 0;
+      for (unsigned int i = 0; i < n_locally_owned_; ++i)
+        max_row_length = std::max<unsigned int>(
+            max_row_length, sparsity_pattern_.row_length(offset + i));
+      max_row_length = Utilities::MPI::max(
+          max_row_length, mpi_ensemble_.ensemble_communicator());
+
+      LinearAlgebra::distributed::Vector<double> rows(
+          Vectors::create_vector_partitioner(partitioner, max_row_length));
+      rows = -1.;
+
+      for (unsigned int i = 0; i < n_locally_owned_; ++i) {
+        std::size_t position = std::size_t(i) * max_row_length;
+        const auto row = offset + i;
+        for (auto it = sparsity_pattern_.begin(row);
+             it != sparsity_pattern_.end(row);
+             ++it)
+          rows.local_element(position++) = it->column();
+      }
+
+      rows.update_ghost_values();
+
+      IndexSet second_layer(dof_handler.n_dofs());
+      const auto n_relevant = partitioner->locally_owned_size() +
+                              partitioner->n_ghost_indices();
+      for (unsigned int j = n_locally_owned_; j < n_relevant; ++j)
+        for (unsigned int k = 0; k < max_row_length; ++k) {
+          const double column =
+              rows.local_element(std::size_t(j) * max_row_length + k);
+          if (column < 0.)
+            break;
+          const auto index = static_cast<types::global_dof_index>(column);
+          if (!locally_relevant.is_element(index))
+            second_layer.add_index(index);
+        }
+      second_layer.compress();
+      locally_relevant.add_indices(second_layer);
+      locally_relevant.compress();
+    }
+
     n_locally_relevant_ = locally_relevant.n_elements();
 
     scalar_partitioner_ = std::make_shared<dealii::Utilities::MPI::Partitioner>(
@@ -368,10 +825,11 @@ namespace ryujin
     /*
      * After elminiating periodicity and hanging node constraints we need
      * to update n_export_indices_ again. This happens because we need to
-     * call export_indices_first() with incomplete information (missing
-     * eliminated degrees of freedom).
+     * determine the export indices during renumbering with incomplete
+     * information (missing eliminated degrees of freedom).
      */
-    if (mpi_allreduce_logical_or(affine_constraints_.n_constraints() > 0)) {
+    if (extended_ghost_halo_ ||
+        mpi_allreduce_logical_or(affine_constraints_.n_constraints() > 0)) {
       /*
        * Recalculate n_export_indices_:
        */
@@ -380,7 +838,7 @@ namespace ryujin
         if (it.second <= n_locally_internal_)
           n_export_indices_ = std::max(n_export_indices_, it.second);
 
-      constexpr auto simd_length = VectorizedArray<Number>::size();
+      constexpr auto simd_length = simd_width<Number>;
       n_export_indices_ =
           (n_export_indices_ + simd_length - 1) / simd_length * simd_length;
     }
@@ -405,6 +863,9 @@ namespace ryujin
     sparsity_pattern_simd_.reinit(
         n_locally_internal_, sparsity_pattern_, scalar_partitioner_);
 
+    if (!allocate_matrices)
+      return;
+
     /*
      * Next we can (re)initialize all local matrices:
      */
@@ -419,6 +880,11 @@ namespace ryujin
     cij_matrix_.reinit(sparsity_pattern_simd_);
     if (discretization_->have_discontinuous_ansatz())
       incidence_matrix_.reinit(sparsity_pattern_simd_);
+
+    if (precompute_normalized_cij_) {
+      cij_norm_matrix_.reinit(sparsity_pattern_simd_);
+      nij_matrix_.reinit(sparsity_pattern_simd_);
+    }
   }
 
 
@@ -433,6 +899,18 @@ namespace ryujin
 
     measure_of_omega_ = 0.;
 
+    /*
+     * Direct assembly into the SparseMatrixSIMD objects bypasses all
+     * sparse matrix temporaries. This is only possible in absence of
+     * affine constraints and if matrix entries are stored in full
+     * precision.
+     */
+    const bool direct_assembly =
+        direct_assembly_ &&
+        std::is_same_v<storage_number_type<Number>, Number> &&
+        Utilities::MPI::max(affine_constraints_.n_constraints(),
+                            mpi_ensemble_.ensemble_communicator()) == 0;
+
 #ifdef DEAL_II_WITH_TRILINOS
     /* Variant using TrilinosWrappers::SparseMatrix with global numbering */
 
@@ -449,22 +927,35 @@ namespace ryujin
     }
     affine_constraints_assembly.close();
 
-    const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
     TrilinosWrappers::SparsityPattern trilinos_sparsity_pattern;
-    trilinos_sparsity_pattern.reinit(locally_owned,
-                                     sparsity_pattern_,
-                                     mpi_ensemble_.ensemble_communicator());
-
     TrilinosWrappers::SparseMatrix mass_matrix_tmp;
     TrilinosWrappers::SparseMatrix mass_matrix_inverse_tmp;
-    if (discretization_->have_discontinuous_ansatz())
-      mass_matrix_inverse_tmp.reinit(trilinos_sparsity_pattern);
-
     std::array<TrilinosWrappers::SparseMatrix, dim> cij_matrix_tmp;
 
-    mass_matrix_tmp.reinit(trilinos_sparsity_pattern);
-    for (auto &matrix : cij_matrix_tmp)
-      matrix.reinit(trilinos_sparsity_pattern);
+    if (!direct_assembly) {
+      const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+      trilinos_sparsity_pattern.reinit(locally_owned,
+                                       sparsity_pattern_,
+                                       mpi_ensemble_.ensemble_communicator());
+
+      if (discretization_->have_discontinuous_ansatz())
+        mass_matrix_inverse_tmp.reinit(trilinos_sparsity_pattern);
+
+      mass_matrix_tmp.reinit(trilinos_sparsity_pattern);
+      for (auto &matrix : cij_matrix_tmp)
+        matrix.reinit(trilinos_sparsity_pattern);
+
+      /*
+       * All Trilinos matrices hold a copy of the sparsity graph. In memory
+       * lean mode we thus release our copy (unless it is still needed for
+       * the incidence matrix) and the DynamicSparsityPattern right away:
+       */
+      if (memory_lean_setup_) {
+        sparsity_pattern_.reinit(0, 0);
+        if (!discretization_->have_discontinuous_ansatz())
+          trilinos_sparsity_pattern.clear();
+      }
+    }
 
 #else
     /* Variant using deal.II SparseMatrix with local numbering */
@@ -474,7 +965,11 @@ namespace ryujin
     transform_to_local_range(*scalar_partitioner_, affine_constraints_assembly);
 
     SparsityPattern sparsity_pattern_assembly;
-    {
+    dealii::SparseMatrix<Number> mass_matrix_tmp;
+    dealii::SparseMatrix<Number> mass_matrix_inverse_tmp;
+    std::array<dealii::SparseMatrix<Number>, dim> cij_matrix_tmp;
+
+    if (!direct_assembly) {
       DynamicSparsityPattern dsp(n_locally_relevant_, n_locally_relevant_);
       for (const auto &entry : sparsity_pattern_) {
         const auto i = scalar_partitioner_->global_to_local(entry.row());
@@ -482,23 +977,85 @@ namespace ryujin
         dsp.add(i, j);
       }
       sparsity_pattern_assembly.copy_from(dsp);
-    }
 
-    dealii::SparseMatrix<Number> mass_matrix_tmp;
-    dealii::SparseMatrix<Number> mass_matrix_inverse_tmp;
-    if (discretization_->have_discontinuous_ansatz())
-      mass_matrix_inverse_tmp.reinit(sparsity_pattern_assembly);
+      if (discretization_->have_discontinuous_ansatz())
+        mass_matrix_inverse_tmp.reinit(sparsity_pattern_assembly);
 
-    std::array<dealii::SparseMatrix<Number>, dim> cij_matrix_tmp;
+      mass_matrix_tmp.reinit(sparsity_pattern_assembly);
+      for (auto &matrix : cij_matrix_tmp)
+        matrix.reinit(sparsity_pattern_assembly);
 
-    mass_matrix_tmp.reinit(sparsity_pattern_assembly);
-    for (auto &matrix : cij_matrix_tmp)
-      matrix.reinit(sparsity_pattern_assembly);
+      /* In memory lean mode release the DynamicSparsityPattern: */
+      if (memory_lean_setup_)
+        sparsity_pattern_.reinit(0, 0);
+    }
 #endif
 
+    /* The DynamicSparsityPattern is not needed for direct assembly: */
+    if (direct_assembly && memory_lean_setup_)
+      sparsity_pattern_.reinit(0, 0);
+
     const unsigned int dofs_per_cell =
         discretization_->finite_element().dofs_per_cell;
 
+    /*
+     * For direct assembly we color all (non artificial) cells such that
+     * cells of the same color do not share any degree of freedom. This
+     * allows us to add local contributions into the SparseMatrixSIMD
+     * objects concurrently:
+     */
+
+    using CellIterator = typename DoFHandler<dim>::active_cell_iterator;
+    std::vector<std::vector<CellIterator>> colored_cells;
+    if (direct_assembly) {
+      colored_cells = GraphColoring::make_graph_coloring(
+          dof_handler.begin_active(),
+          dof_handler.end(),
+          [&](const CellIterator &cell) {
+            std::vector<types::global_dof_index> indices;
+            if (!cell->is_artificial()) {
+              indices.resize(dofs_per_cell);
+              cell->get_dof_indices(indices);
+            }
+            return indices;
+          });
+    }
+
+    /*
+     * A small lambda that translates the given (global) row and column
+     * indices into the local index range and calls
+     * callable(i, col_idx, ii, jj) for all locally owned rows i, where
+     * col_idx is the position of column j within row i of the SIMD
+     * sparsity pattern and ii, jj are the indices of the local matrix:
+     */
+    const auto for_each_owned_entry = [&](const auto &row_indices,
+                                          const auto &column_indices,
+                                          const auto &callable) {
+      constexpr auto simd_length = simd_width<Number>;
+
+      std::vector<unsigned int> columns(column_indices.size());
+      for (unsigned int jj = 0; jj < column_indices.size(); ++jj)
+        columns[jj] = scalar_partitioner_->global_to_local(column_indices[jj]);
+
+      for (unsigned int ii = 0; ii < row_indices.size(); ++ii) {
+        const auto i = scalar_partitioner_->global_to_local(row_indices[ii]);
+        if (i >= n_locally_owned_)
+          continue;
+
+        const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+        const unsigned int stride = i < n_locally_internal_ ? simd_length : 1;
+        const unsigned int *js = sparsity_pattern_simd_.columns(i);
+
+        for (unsigned int jj = 0; jj < columns.size(); ++jj) {
+          unsigned int col_idx = 0;
+          while (col_idx < row_length && js[col_idx * stride] != columns[jj])
+            ++col_idx;
+          Assert(col_idx < row_length, dealii::ExcInternalError());
+          callable(i, col_idx, ii, jj);
+        }
+      }
+    };
+
     /*
      * Now, assemble all matrices:
      */
@@ -524,7 +1081,14 @@ namespace ryujin
       auto &fe_neighbor_face_values = scratch.fe_neighbor_face_values_;
 
 #ifdef DEAL_II_WITH_TRILINOS
-      is_locally_owned = cell->is_locally_owned();
+      /*
+       * For direct assembly we do not have a
+       * compress(VectorOperation::add) available. In this case we
+       * assemble contributions over all locally relevant (non
+       * artificial) cells.
+       */
+      is_locally_owned =
+          direct_assembly ? !cell->is_artificial() : cell->is_locally_owned();
 #else
       /*
        * When using a local dealii::SparseMatrix<Number> we don not
@@ -733,38 +1297,140 @@ namespace ryujin
       measure_of_omega_ += cell_measure;
     };
 
-    WorkStream::run(dof_handler.begin_active(),
-                    dof_handler.end(),
-                    local_assemble_system,
-                    copy_local_to_global,
-                    AssemblyScratchData<dim>(*discretization_),
+    /* The copy routine for direct assembly: */
+    std::mutex measure_mutex;
+    const auto copy_local_to_simd = [&](const auto &copy) {
+      const auto &is_locally_owned = copy.is_locally_owned_;
+      const auto &local_dof_indices = copy.local_dof_indices_;
+      const auto &neighbor_local_dof_indices = copy.neighbor_local_dof_indices_;
+      const auto &cell_mass_matrix = copy.cell_mass_matrix_;
+      const auto &cell_mass_matrix_inverse = copy.cell_mass_matrix_inverse_;
+      const auto &cell_cij_matrix = copy.cell_cij_matrix_;
+      const auto &interface_cij_matrix = copy.interface_cij_matrix_;
+      const auto &cell_measure = copy.cell_measure_;
+
+      if (!is_locally_owned)
+        return;
+
+      for_each_owned_entry(
+          local_dof_indices,
+          local_dof_indices,
+          [&](auto i, auto col_idx, auto ii, auto jj) {
+            const auto m_ij = mass_matrix_.get_entry(i, col_idx);
+            mass_matrix_.write_entry(
+                m_ij + Number(cell_mass_matrix(ii, jj)), i, col_idx);
+
+            auto c_ij = cij_matrix_.get_tensor(i, col_idx);
+            for (unsigned int d = 0; d < dim; ++d)
+              c_ij[d] += Number(cell_cij_matrix[d](ii, jj));
+            cij_matrix_.write_entry(c_ij, i, col_idx);
+
+            if (discretization_->have_discontinuous_ansatz()) {
+              const auto b_ij = mass_matrix_inverse_.get_entry(i, col_idx);
+              mass_matrix_inverse_.write_entry(
+                  b_ij + Number(cell_mass_matrix_inverse(ii, jj)),
+                  i,
+                  col_idx);
+            }
+          });
+
+      for (unsigned int f_index = 0; f_index < copy.n_faces; ++f_index) {
+        if (neighbor_local_dof_indices[f_index].size() == 0)
+          continue;
+
+        for_each_owned_entry(
+            local_dof_indices,
+            neighbor_local_dof_indices[f_index],
+            [&](auto i, auto col_idx, auto ii, auto jj) {
+              auto c_ij = cij_matrix_.get_tensor(i, col_idx);
+              for (unsigned int d = 0; d < dim; ++d)
+                c_ij[d] += Number(interface_cij_matrix[f_index][d](ii, jj));
+              cij_matrix_.write_entry(c_ij, i, col_idx);
+            });
+      }
+
+      std::lock_guard<std::mutex> lock(measure_mutex);
+      measure_of_omega_ += cell_measure;
+    };
+
+    if (direct_assembly) {
+      mass_matrix_.set_zero();
+      if (discretization_->have_discontinuous_ansatz())
+        mass_matrix_inverse_.set_zero();
+      cij_matrix_.set_zero();
+
+      WorkStream::run(colored_cells,
+                      local_assemble_system,
+                      copy_local_to_simd,
+                      AssemblyScratchData<dim>(*discretization_),
+                      AssemblyCopyData<dim, Number>());
+
+    } else {
+      WorkStream::run(dof_handler.begin_active(),
+                      dof_handler.end(),
+                      local_assemble_system,
+                      copy_local_to_global,
+                      AssemblyScratchData<dim>(*discretization_),
 #ifdef DEAL_II_WITH_TRILINOS
-                    AssemblyCopyData<dim, double>());
+                      AssemblyCopyData<dim, double>());
 #else
-                    AssemblyCopyData<dim, Number>());
+                      AssemblyCopyData<dim, Number>());
 #endif
 
 #ifdef DEAL_II_WITH_TRILINOS
-    mass_matrix_tmp.compress(VectorOperation::add);
-    for (auto &it : cij_matrix_tmp)
-      it.compress(VectorOperation::add);
+      mass_matrix_tmp.compress(VectorOperation::add);
+      for (auto &it : cij_matrix_tmp)
+        it.compress(VectorOperation::add);
 
-    mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ false);
-    if (discretization_->have_discontinuous_ansatz())
-      mass_matrix_inverse_.read_in(mass_matrix_inverse_tmp, /*loc_ind*/ false);
-    cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ false);
+      mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ false);
+      if (discretization_->have_discontinuous_ansatz())
+        mass_matrix_inverse_.read_in(mass_matrix_inverse_tmp, /*loc*/ false);
+      cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ false);
 #else
-    mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ true);
-    if (discretization_->have_discontinuous_ansatz())
-      mass_matrix_inverse_.read_in(mass_matrix_inverse_tmp, /*loc_ind*/ true);
-    cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ true);
+      mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ true);
+      if (discretization_->have_discontinuous_ansatz())
+        mass_matrix_inverse_.read_in(mass_matrix_inverse_tmp, /*loc*/ true);
+      cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ true);
 #endif
 
+      /*
+       * In memory lean mode release all temporaries as soon as they have
+       * been read in. The mass matrix is still needed for computing the
+       * lumped mass matrix:
+       */
+      if (memory_lean_setup_) {
+        mass_matrix_inverse_tmp.clear();
+        for (auto &it : cij_matrix_tmp)
+          it.clear();
+      }
+    }
+
     mass_matrix_.update_ghost_rows();
     if (discretization_->have_discontinuous_ansatz())
       mass_matrix_inverse_.update_ghost_rows();
     cij_matrix_.update_ghost_rows();
 
+    /*
+     * Precompute norms |c_ij| and normalized directions n_ij:
+     */
+
+    if (precompute_normalized_cij_) {
+      for (unsigned int i = 0; i < n_locally_owned_; ++i) {
+        const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+        for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+          const auto c_ij = cij_matrix_.get_tensor(i, col_idx);
+          const auto norm = c_ij.norm();
+          cij_norm_matrix_.write_entry(norm, i, col_idx);
+          /* The diagonal entry c_ii might be zero: */
+          nij_matrix_.write_entry(norm > Number(0.) ? c_ij / norm : c_ij,
+                                  i,
+                                  col_idx);
+        }
+      }
+      cij_norm_matrix_.update_ghost_rows();
+      nij_matrix_.update_ghost_rows();
+    }
+
     measure_of_omega_ = Utilities::MPI::sum(
         measure_of_omega_, mpi_ensemble_.ensemble_communicator());
 
@@ -772,7 +1438,20 @@ namespace ryujin
      * Create lumped mass matrix:
      */
 
-    {
+    if (direct_assembly) {
+      /* Without affine constraints the lumped mass is the row sum: */
+      for (unsigned int i = 0; i < n_locally_owned_; ++i) {
+        const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+        Number m_i = 0.;
+        for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx)
+          m_i += mass_matrix_.get_entry(i, col_idx);
+        lumped_mass_matrix_.local_element(i) = m_i;
+        lumped_mass_matrix_inverse_.local_element(i) = 1. / m_i;
+      }
+      lumped_mass_matrix_.update_ghost_values();
+      lumped_mass_matrix_inverse_.update_ghost_values();
+
+    } else {
 #ifdef DEAL_II_WITH_TRILINOS
       ScalarVector one(scalar_partitioner_);
       one = 1.;
@@ -810,6 +1489,9 @@ namespace ryujin
       lumped_mass_matrix_.update_ghost_values();
       lumped_mass_matrix_inverse_.update_ghost_values();
 #endif
+
+      if (memory_lean_setup_)
+        mass_matrix_tmp.clear();
     }
 
     /*
@@ -819,10 +1501,12 @@ namespace ryujin
     if (discretization_->have_discontinuous_ansatz()) {
 #ifdef DEAL_II_WITH_TRILINOS
       TrilinosWrappers::SparseMatrix incidence_matrix_tmp;
-      incidence_matrix_tmp.reinit(trilinos_sparsity_pattern);
+      if (!direct_assembly)
+        incidence_matrix_tmp.reinit(trilinos_sparsity_pattern);
 #else
       dealii::SparseMatrix<Number> incidence_matrix_tmp;
-      incidence_matrix_tmp.reinit(sparsity_pattern_assembly);
+      if (!direct_assembly)
+        incidence_matrix_tmp.reinit(sparsity_pattern_assembly);
 #endif
 
       /* The local, per-cell assembly routine: */
@@ -840,7 +1524,8 @@ namespace ryujin
             scratch.fe_neighbor_face_values_nodal_;
 
 #ifdef DEAL_II_WITH_TRILINOS
-        is_locally_owned = cell->is_locally_owned();
+        is_locally_owned =
+            direct_assembly ? !cell->is_artificial() : cell->is_locally_owned();
 #else
         is_locally_owned = !cell->is_artificial();
 #endif
@@ -976,22 +1661,61 @@ namespace ryujin
         }
       };
 
-      WorkStream::run(dof_handler.begin_active(),
-                      dof_handler.end(),
-                      local_assemble_system,
-                      copy_local_to_global,
-                      AssemblyScratchData<dim>(*discretization_),
+      /* The copy routine for direct assembly: */
+      const auto copy_local_to_simd = [&](const auto &copy) {
+        const auto &is_locally_owned = copy.is_locally_owned_;
+        const auto &local_dof_indices = copy.local_dof_indices_;
+        const auto &neighbor_local_dof_indices =
+            copy.neighbor_local_dof_indices_;
+        const auto &interface_incidence_matrix =
+            copy.interface_incidence_matrix_;
+
+        if (!is_locally_owned)
+          return;
+
+        for (unsigned int f_index = 0; f_index < copy.n_faces; ++f_index) {
+          if (neighbor_local_dof_indices[f_index].size() == 0)
+            continue;
+
+          for_each_owned_entry(
+              local_dof_indices,
+              neighbor_local_dof_indices[f_index],
+              [&](auto i, auto col_idx, auto ii, auto jj) {
+                const auto &matrix = interface_incidence_matrix[f_index];
+                const auto beta_ij = incidence_matrix_.get_entry(i, col_idx);
+                incidence_matrix_.write_entry(
+                    beta_ij + Number(matrix(ii, jj)), i, col_idx);
+              });
+        }
+      };
+
+      if (direct_assembly) {
+        incidence_matrix_.set_zero();
+
+        WorkStream::run(colored_cells,
+                        local_assemble_system,
+                        copy_local_to_simd,
+                        AssemblyScratchData<dim>(*discretization_),
+                        AssemblyCopyData<dim, Number>());
+
+      } else {
+        WorkStream::run(dof_handler.begin_active(),
+                        dof_handler.end(),
+                        local_assemble_system,
+                        copy_local_to_global,
+                        AssemblyScratchData<dim>(*discretization_),
 #ifdef DEAL_II_WITH_TRILINOS
-                      AssemblyCopyData<dim, double>());
+                        AssemblyCopyData<dim, double>());
 #else
-                      AssemblyCopyData<dim, Number>());
+                        AssemblyCopyData<dim, Number>());
 #endif
 
 #ifdef DEAL_II_WITH_TRILINOS
-      incidence_matrix_.read_in(incidence_matrix_tmp, /*locally_indexe*/ false);
+        incidence_matrix_.read_in(incidence_matrix_tmp, /*loc_ind*/ false);
 #else
-      incidence_matrix_.read_in(incidence_matrix_tmp, /*locally_indexed*/ true);
+        incidence_matrix_.read_in(incidence_matrix_tmp, /*loc_ind*/ true);
 #endif
+      }
       incidence_matrix_.update_ghost_rows();
     }
 
@@ -1036,7 +1760,7 @@ namespace ryujin
           mass_matrix_.get_entry(i, 0) - lumped_mass_matrix_.local_element(i);
 
       /* skip diagonal */
-      constexpr auto simd_length = VectorizedArray<Number>::size();
+      constexpr auto simd_length = simd_width<Number>;
       const unsigned int *js = sparsity_pattern_simd_.columns(i);
       for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
         const auto j = *(i < n_locally_internal_ ? js + col_idx * simd_length
@@ -1078,7 +1802,7 @@ namespace ryujin
       auto sum = cij_matrix_.get_tensor(i, 0);
 
       /* skip diagonal */
-      constexpr auto simd_length = VectorizedArray<Number>::size();
+      constexpr auto simd_length = simd_width<Number>;
       const unsigned int *js = sparsity_pattern_simd_.columns(i);
       for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
         const auto j = *(i < n_locally_internal_ ? js + col_idx * simd_length
@@ -1114,7 +1838,8 @@ namespace ryujin
 
 
   template <int dim, typename Number>
-  void OfflineData<dim, Number>::create_multigrid_data()
+  auto OfflineData<dim, Number>::create_multigrid_data() const
+      -> MultigridData
   {
 #ifdef DEBUG_OUTPUT
     std::cout << "OfflineData<dim, Number>::create_multigrid_data()"
@@ -1130,8 +1855,12 @@ namespace ryujin
     AffineConstraints<float> level_constraints;
     // TODO not yet thread-parallel and without periodicity
 
-    level_boundary_map_.resize(n_levels);
-    level_lumped_mass_matrix_.resize(n_levels);
+    MultigridData data;
+    auto &level_boundary_map = data.level_boundary_map;
+    auto &level_lumped_mass_matrix = data.level_lumped_mass_matrix;
+
+    level_boundary_map.resize(n_levels);
+    level_lumped_mass_matrix.resize(n_levels);
 
     for (unsigned int level = 0; level < n_levels; ++level) {
       /* Assemble lumped mass matrix vector: */
@@ -1143,7 +1872,7 @@ namespace ryujin
           dof_handler.locally_owned_mg_dofs(level),
           relevant_dofs,
           mpi_ensemble_.ensemble_communicator());
-      level_lumped_mass_matrix_[level].reinit(partitioner);
+      level_lumped_mass_matrix[level].reinit(partitioner);
       std::vector<types::global_dof_index> dof_indices(
           dof_handler.get_fe().dofs_per_cell);
       dealii::Vector<Number> mass_values(dof_handler.get_fe().dofs_per_cell);
@@ -1164,15 +1893,471 @@ namespace ryujin
           }
           cell->get_mg_dof_indices(dof_indices);
           level_constraints.distribute_local_to_global(
-              mass_values, dof_indices, level_lumped_mass_matrix_[level]);
+              mass_values, dof_indices, level_lumped_mass_matrix[level]);
         }
-      level_lumped_mass_matrix_[level].compress(VectorOperation::add);
+      level_lumped_mass_matrix[level].compress(VectorOperation::add);
 
       /* Populate boundary map: */
 
-      level_boundary_map_[level] = construct_boundary_map(
+      level_boundary_map[level] = construct_boundary_map(
           dof_handler.begin_mg(level), dof_handler.end_mg(level), *partitioner);
     }
+
+    return data;
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::prepare_cache()
+  {
+    cache_name_.clear();
+    cache_key_.clear();
+
+    if (cache_directory_.empty())
+      return;
+
+    const auto &triangulation = discretization_->triangulation();
+    const auto &dof_handler = *dof_handler_;
+    const auto &communicator = mpi_ensemble_.ensemble_communicator();
+
+    /*
+     * Compute a checksum over all vertex coordinates, boundary ids, and
+     * mapped quadrature points of the locally owned part of the mesh. The
+     * quadrature points capture the attached manifolds and the mapping
+     * which both enter the assembled matrices:
+     */
+
+    std::uint64_t checksum = 0;
+    const auto combine = [](std::uint64_t &seed, const auto value) {
+      using T = std::remove_cv_t<decltype(value)>;
+      const std::uint64_t hash = std::hash<T>()(value);
+      seed ^= hash + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    };
+
+    FEValues<dim> fe_values(discretization_->mapping(),
+                            discretization_->finite_element(),
+                            discretization_->quadrature(),
+                            update_quadrature_points);
+
+    for (const auto &cell : triangulation.active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
+
+      for (const auto v : cell->vertex_indices())
+        for (unsigned int d = 0; d < dim; ++d)
+          combine(checksum, cell->vertex(v)[d]);
+
+      for (const auto f : cell->face_indices())
+        if (cell->face(f)->at_boundary())
+          combine(checksum, cell->face(f)->boundary_id());
+
+      fe_values.reinit(cell);
+      for (const auto &point : fe_values.get_quadrature_points())
+        for (unsigned int d = 0; d < dim; ++d)
+          combine(checksum, point[d]);
+    }
+
+    const auto as_integer = [](const double value) {
+      std::uint64_t result;
+      std::memcpy(&result, &value, sizeof(value));
+      return result;
+    };
+
+    /*
+     * The first part of the key is identical on all ranks and determines
+     * the file name, the second part is rank specific:
+     */
+
+    cache_key_ = {
+        cache_format_version,
+        std::uint64_t(dim),
+        std::uint64_t(sizeof(Number)),
+        std::uint64_t(simd_width<Number>),
+        std::uint64_t(discretization_->ansatz()),
+        std::uint64_t(triangulation.n_global_active_cells()),
+        std::uint64_t(dof_handler.n_dofs()),
+        std::uint64_t(mpi_ensemble_.n_ensemble_ranks()),
+        as_integer(incidence_relaxation_even_),
+        as_integer(incidence_relaxation_odd_),
+        std::uint64_t(precompute_normalized_cij_),
+        std::uint64_t(renumbering_),
+        std::uint64_t(extended_ghost_halo_),
+    };
+
+    std::uint64_t name_hash = Utilities::MPI::sum(checksum, communicator);
+    for (const auto &it : cache_key_)
+      combine(name_hash, it);
+
+    cache_key_.push_back(mpi_ensemble_.ensemble_rank());
+    cache_key_.push_back(n_locally_owned_);
+    cache_key_.push_back(checksum);
+
+    std::ostringstream name;
+    name << cache_directory_ << "/offline_data-" << std::hex
+         << std::setfill('0') << std::setw(16) << name_hash << "-r"
+         << Utilities::int_to_string(mpi_ensemble_.ensemble_rank(), 4);
+    cache_name_ = name.str();
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::write_cache_header(std::ostream &out) const
+  {
+    const std::uint64_t size = cache_key_.size();
+    out.write("RYUJINOD", 8);
+    out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char *>(cache_key_.data()),
+              size * sizeof(std::uint64_t));
+  }
+
+
+  template <int dim, typename Number>
+  bool OfflineData<dim, Number>::read_cache_header(std::istream &in) const
+  {
+    std::array<char, 8> magic;
+    std::uint64_t size = 0;
+    in.read(magic.data(), magic.size());
+    in.read(reinterpret_cast<char *>(&size), sizeof(size));
+    if (!in || std::string(magic.data(), magic.size()) != "RYUJINOD" ||
+        size != cache_key_.size())
+      return false;
+
+    std::vector<std::uint64_t> key(size);
+    in.read(reinterpret_cast<char *>(key.data()),
+            size * sizeof(std::uint64_t));
+    return in && key == cache_key_;
+  }
+
+
+  template <int dim, typename Number>
+  template <typename Callable>
+  void
+  OfflineData<dim, Number>::write_cache_file(const std::string &suffix,
+                                             const Callable &writer) const
+  {
+    /*
+     * Several ensembles might write the very same cache entry
+     * concurrently. We thus write to an ensemble specific temporary file
+     * first and then (atomically) move it into place:
+     */
+
+    std::error_code error_code;
+    std::filesystem::create_directories(cache_directory_, error_code);
+
+    const std::string name = cache_name_ + suffix;
+    const std::string temporary_name =
+        name + ".tmp" + Utilities::int_to_string(mpi_ensemble_.ensemble());
+    {
+      std::ofstream file(temporary_name, std::ios::binary | std::ios::trunc);
+      if (!file)
+        return;
+      write_cache_header(file);
+      writer(file);
+      if (!file) {
+        file.close();
+        std::filesystem::remove(temporary_name, error_code);
+        return;
+      }
+    }
+    std::filesystem::rename(temporary_name, name, error_code);
+  }
+
+
+  template <int dim, typename Number>
+  bool OfflineData<dim, Number>::read_cached_renumbering()
+  {
+    if (cache_name_.empty())
+      return false;
+
+    unsigned int n_locally_internal = 0;
+    unsigned int n_export_indices = 0;
+    std::vector<types::global_dof_index> new_order(n_locally_owned_);
+
+    bool valid = false;
+    {
+      std::ifstream file(cache_name_ + ".dofs", std::ios::binary);
+      if (file && read_cache_header(file)) {
+        file.read(reinterpret_cast<char *>(&n_locally_internal),
+                  sizeof(n_locally_internal));
+        file.read(reinterpret_cast<char *>(&n_export_indices),
+                  sizeof(n_export_indices));
+        file.read(reinterpret_cast<char *>(new_order.data()),
+                  new_order.size() * sizeof(types::global_dof_index));
+        valid = bool(file);
+      }
+    }
+
+    /* All ranks have to agree on using the cache: */
+    const auto &communicator = mpi_ensemble_.ensemble_communicator();
+    if (Utilities::MPI::min(static_cast<unsigned int>(valid), communicator) ==
+        0)
+      return false;
+
+    dof_handler_->renumber_dofs(new_order);
+    n_locally_internal_ = n_locally_internal;
+    n_export_indices_ = n_export_indices;
+
+    return true;
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::write_cached_renumbering(
+      const std::vector<types::global_dof_index> &new_order) const
+  {
+    if (cache_name_.empty())
+      return;
+
+    write_cache_file(".dofs", [&](std::ostream &file) {
+      file.write(reinterpret_cast<const char *>(&n_locally_internal_),
+                 sizeof(n_locally_internal_));
+      file.write(reinterpret_cast<const char *>(&n_export_indices_),
+                 sizeof(n_export_indices_));
+      file.write(reinterpret_cast<const char *>(new_order.data()),
+                 new_order.size() * sizeof(types::global_dof_index));
+    });
+  }
+
+
+  template <int dim, typename Number>
+  bool OfflineData<dim, Number>::read_cached_matrices()
+  {
+    if (cache_name_.empty())
+      return false;
+
+    const bool have_discontinuous_ansatz =
+        discretization_->have_discontinuous_ansatz();
+
+    /*
+     * Nota bene: We read directly into the final data structures. If the
+     * cache entry turns out to be invalid on any rank, assemble() simply
+     * overwrites everything again.
+     */
+
+    bool valid = false;
+    try {
+      std::ifstream file(cache_name_ + ".matrices", std::ios::binary);
+      if (file && read_cache_header(file)) {
+        const auto read = [&file](auto &value) {
+          file.read(reinterpret_cast<char *>(&value), sizeof(value));
+        };
+
+        read(measure_of_omega_);
+
+        mass_matrix_.block_read(file);
+        if (have_discontinuous_ansatz)
+          mass_matrix_inverse_.block_read(file);
+        cij_matrix_.block_read(file);
+        if (have_discontinuous_ansatz)
+          incidence_matrix_.block_read(file);
+        if (precompute_normalized_cij_) {
+          cij_norm_matrix_.block_read(file);
+          nij_matrix_.block_read(file);
+        }
+
+        read_auxiliary_data(file);
+
+        valid = bool(file);
+      }
+    } catch (...) {
+      valid = false;
+    }
+
+    /* All ranks have to agree on using the cache: */
+    const auto &communicator = mpi_ensemble_.ensemble_communicator();
+    if (Utilities::MPI::min(static_cast<unsigned int>(valid), communicator) ==
+        0)
+      return false;
+
+    for (unsigned int i = 0; i < n_locally_owned_; ++i)
+      lumped_mass_matrix_inverse_.local_element(i) =
+          1. / lumped_mass_matrix_.local_element(i);
+    lumped_mass_matrix_.update_ghost_values();
+    lumped_mass_matrix_inverse_.update_ghost_values();
+
+    return true;
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::write_cached_matrices() const
+  {
+    if (cache_name_.empty())
+      return;
+
+    const bool have_discontinuous_ansatz =
+        discretization_->have_discontinuous_ansatz();
+
+    write_cache_file(".matrices", [&](std::ostream &file) {
+      const auto write = [&file](const auto &value) {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+      };
+
+      write(measure_of_omega_);
+
+      mass_matrix_.block_write(file);
+      if (have_discontinuous_ansatz)
+        mass_matrix_inverse_.block_write(file);
+      cij_matrix_.block_write(file);
+      if (have_discontinuous_ansatz)
+        incidence_matrix_.block_write(file);
+      if (precompute_normalized_cij_) {
+        cij_norm_matrix_.block_write(file);
+        nij_matrix_.block_write(file);
+      }
+
+      write_auxiliary_data(file);
+    });
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::write_auxiliary_data(std::ostream &out) const
+  {
+    const auto write = [&out](const auto &value) {
+      out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+
+    for (unsigned int i = 0; i < n_locally_owned_; ++i)
+      write(lumped_mass_matrix_.local_element(i));
+
+    write(std::uint64_t(boundary_map_.size()));
+    for (const auto &[i, normal, normal_mass, boundary_mass, id, position] :
+         boundary_map_) {
+      write(i);
+      for (unsigned int d = 0; d < dim; ++d)
+        write(normal[d]);
+      write(normal_mass);
+      write(boundary_mass);
+      write(id);
+      for (unsigned int d = 0; d < dim; ++d)
+        write(position[d]);
+    }
+
+    write(std::uint64_t(coupling_boundary_pairs_.size()));
+    for (const auto &[i, col_idx, j] : coupling_boundary_pairs_) {
+      write(i);
+      write(col_idx);
+      write(j);
+    }
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::read_auxiliary_data(std::istream &in)
+  {
+    const auto read = [&in](auto &value) {
+      in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    };
+
+    for (unsigned int i = 0; i < n_locally_owned_; ++i)
+      read(lumped_mass_matrix_.local_element(i));
+
+    std::uint64_t size = 0;
+    read(size);
+    boundary_map_.resize(size);
+    for (auto &[i, normal, normal_mass, boundary_mass, id, position] :
+         boundary_map_) {
+      read(i);
+      for (unsigned int d = 0; d < dim; ++d)
+        read(normal[d]);
+      read(normal_mass);
+      read(boundary_mass);
+      read(id);
+      for (unsigned int d = 0; d < dim; ++d)
+        read(position[d]);
+    }
+
+    read(size);
+    coupling_boundary_pairs_.resize(size);
+    for (auto &[i, col_idx, j] : coupling_boundary_pairs_) {
+      read(i);
+      read(col_idx);
+      read(j);
+    }
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::share_assembled_data(const bool assembled)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::share_assembled_data()"
+              << std::endl;
+#endif
+
+    const auto &communicator = mpi_ensemble_.node_peer_communicator();
+
+    /*
+     * Identical meshes lead to identical partitions and local index
+     * ranges on all peers. Verify the local index ranges:
+     */
+    for (const unsigned int n : {n_locally_owned_, n_locally_relevant_})
+      AssertThrow(Utilities::MPI::min(n, communicator) ==
+                      Utilities::MPI::max(n, communicator),
+                  ExcMessage("Cannot share offline data between ensembles "
+                             "with different meshes or partitions."));
+
+    /*
+     * Distribute the (comparatively small) auxiliary data of the
+     * provider to all ranks that did not assemble:
+     */
+
+    std::string buffer;
+    if (Utilities::MPI::this_mpi_process(communicator) == 0) {
+      std::ostringstream out(std::ios::binary);
+      out.write(reinterpret_cast<const char *>(&measure_of_omega_),
+                sizeof(measure_of_omega_));
+      write_auxiliary_data(out);
+      buffer = out.str();
+    }
+    buffer = Utilities::MPI::broadcast(communicator, buffer);
+
+    if (!assembled) {
+      std::istringstream in(buffer, std::ios::binary);
+      in.read(reinterpret_cast<char *>(&measure_of_omega_),
+              sizeof(measure_of_omega_));
+      read_auxiliary_data(in);
+      AssertThrow(in, ExcInternalError());
+
+      for (unsigned int i = 0; i < n_locally_owned_; ++i)
+        lumped_mass_matrix_inverse_.local_element(i) =
+            1. / lumped_mass_matrix_.local_element(i);
+      lumped_mass_matrix_.update_ghost_values();
+      lumped_mass_matrix_inverse_.update_ghost_values();
+    }
+
+    /*
+     * Move all matrices into shared memory windows. All ranks of the
+     * communicator have to share the matrices in the same order:
+     */
+
+    const auto share = [&](auto &matrix) {
+      shared_windows_.push_back(matrix.share_data(communicator));
+    };
+
+    const bool have_discontinuous_ansatz =
+        discretization_->have_discontinuous_ansatz();
+
+    share(mass_matrix_);
+    if (have_discontinuous_ansatz)
+      share(mass_matrix_inverse_);
+    share(cij_matrix_);
+    if (have_discontinuous_ansatz)
+      share(incidence_matrix_);
+    if (precompute_normalized_cij_) {
+      share(cij_norm_matrix_);
+      share(nij_matrix_);
+    }
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::free_shared_windows()
+  {
+    for (auto &window : shared_windows_)
+      MPI_Win_free(&window);
+    shared_windows_.clear();
   }
 
 
@@ -1454,7 +2639,7 @@ namespace ryujin
         continue;
 
       const unsigned int *js = sparsity_pattern_simd_.columns(i);
-      constexpr auto simd_length = VectorizedArray<Number>::size();
+      constexpr auto simd_length = simd_width<Number>;
       /* skip diagonal: */
       for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
         const auto j = *(i < n_locally_internal_ ? js + col_idx * simd_length
@@ -1,20 +1,40 @@
 //
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
-// Copyright (C) 2020 - 2023 by the ryujin authors
+// Copyright (C) 2020 - 2024 by the ryujin authors
 //
 
 #pragma once
 
 #include <compile_time_options.h>
 
+#include "timeline_tracer.h"
+
 #include <deal.II/base/config.h>
+#include <deal.II/base/timer.h>
 
 #ifdef WITH_OPENMP
 #include <omp.h>
 #endif
 
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 /**
  * @name OpenMP parallel for macros
@@ -78,6 +98,23 @@
  */
 #define RYUJIN_OMP_FOR_NOWAIT RYUJIN_PRAGMA(omp for nowait)
 
+/**
+ * Enter a parallel for loop whose schedule is selected at run time, see
+ * set_loop_schedule().
+ *
+ * @ingroup Miscellaneous
+ */
+#define RYUJIN_OMP_FOR_RUNTIME RYUJIN_PRAGMA(omp for schedule(runtime))
+
+/**
+ * Enter a parallel for loop whose schedule is selected at run time, see
+ * set_loop_schedule(), with "nowait" declaration.
+ *
+ * @ingroup Miscellaneous
+ */
+#define RYUJIN_OMP_FOR_RUNTIME_NOWAIT                                          \
+  RYUJIN_PRAGMA(omp for schedule(runtime) nowait)
+
 /**
  * Declare an explicit Thread synchronization barrier.
  *
@@ -134,16 +171,588 @@
 namespace ryujin
 {
   /**
-   * @todo write documentation
+   * An enum selecting the schedule of all parallel for loops annotated
+   * with RYUJIN_OMP_FOR_RUNTIME.
+   *
+   * @ingroup Miscellaneous
+   */
+  enum class LoopSchedule : std::uint8_t {
+    /**
+     * Statically distribute the loop over all threads by slicing the
+     * index range into (equally sized) contiguous chunks.
+     */
+    static_schedule,
+
+    /**
+     * Hand out chunks of the index range to threads on demand, i.e.,
+     * threads that finish early take over remaining work.
+     */
+    dynamic_schedule,
+
+    /**
+     * Like dynamic_schedule but with chunks of decreasing size.
+     */
+    guided_schedule,
+  };
+
+
+  /**
+   * Select the schedule of all subsequent RYUJIN_OMP_FOR_RUNTIME loops
+   * started from the calling thread. A @p chunk_size of 0 selects the
+   * default chunk size of the OpenMP implementation.
+   *
+   * @note Dynamic and guided schedules are always requested with the
+   * "monotonic" modifier, i.e., every thread processes its chunks in
+   * increasing index order. This is required by SynchronizationDispatch.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline void set_loop_schedule([[maybe_unused]] const LoopSchedule schedule,
+                                [[maybe_unused]] const unsigned int chunk_size)
+  {
+#ifdef WITH_OPENMP
+    omp_sched_t kind = omp_sched_static;
+    if (schedule == LoopSchedule::dynamic_schedule)
+      kind = omp_sched_dynamic;
+    else if (schedule == LoopSchedule::guided_schedule)
+      kind = omp_sched_guided;
+
+#if _OPENMP >= 201811
+    if (kind != omp_sched_static)
+      kind = omp_sched_t(kind | omp_sched_monotonic);
+#endif
+
+    omp_set_schedule(kind, static_cast<int>(chunk_size));
+#endif
+  }
+
+
+  /**
+   * A small helper class that records the "busy time" of every thread,
+   * i.e., the wall time spent in parallel loops excluding the time spent
+   * waiting in the subsequent synchronization barrier. Intended use:
+   * ```
+   * RYUJIN_PARALLEL_REGION_BEGIN
+   * const auto busy_start = thread_load_statistics.start();
+   * RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+   * for (unsigned int i = 0; i < size; ++i) {
+   *   // work
+   * }
+   * thread_load_statistics.stop(busy_start);
+   * RYUJIN_OMP_BARRIER
+   * RYUJIN_PARALLEL_REGION_END
+   * ```
+   *
+   * @ingroup Miscellaneous
+   */
+  class ThreadLoadStatistics
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * (Re)initialize the class and reset all recorded busy times. If
+     * @p enabled is false, start() and stop() are no-ops.
+     */
+    void reinit(const bool enabled)
+    {
+      enabled_ = enabled;
+      unsigned int n_threads = 1;
+#ifdef WITH_OPENMP
+      n_threads = omp_get_max_threads();
+#endif
+      busy_time_.assign(enabled_ ? n_threads : 0, Entry());
+    }
+
+    DEAL_II_ALWAYS_INLINE inline clock::time_point start() const
+    {
+#ifdef TIMELINE_TRACING
+      return clock::now();
+#else
+      return enabled_ ? clock::now() : clock::time_point();
+#endif
+    }
+
+    DEAL_II_ALWAYS_INLINE inline void stop(const clock::time_point &start)
+    {
+#ifdef TIMELINE_TRACING
+      TimelineTracer::instance().record("thread busy", start);
+#endif
+      if (RYUJIN_LIKELY(!enabled_))
+        return;
+
+      unsigned int thread = 0;
+#ifdef WITH_OPENMP
+      thread = omp_get_thread_num();
+#endif
+      if (thread < busy_time_.size())
+        busy_time_[thread].value +=
+            std::chrono::duration<double>(clock::now() - start).count();
+    }
+
+    /**
+     * Return the busy time (in seconds) accumulated by every thread since
+     * the last call to reinit() or reset().
+     */
+    std::vector<double> busy_time() const
+    {
+      std::vector<double> result;
+      for (const auto &it : busy_time_)
+        result.push_back(it.value);
+      return result;
+    }
+
+    /**
+     * Reset all recorded busy times to zero.
+     */
+    void reset()
+    {
+      for (auto &it : busy_time_)
+        it.value = 0.;
+    }
+
+    bool enabled() const
+    {
+      return enabled_;
+    }
+
+  private:
+    /* Pad every entry to a cache line to avoid false sharing: */
+    struct alignas(64) Entry {
+      double value = 0.;
+    };
+
+    bool enabled_ = false;
+    std::vector<Entry> busy_time_;
+  };
+
+
+  /**
+   * A small helper class that records the accumulated wall time spent on
+   * every (locally owned) row in the row loops of the HyperbolicModule.
+   * The time spent on a SIMD row chunk is distributed evenly over all
+   * rows of the chunk. Intended use:
+   * ```
+   * RYUJIN_OMP_FOR
+   * for (unsigned int i = 0; i < size; i += stride_size) {
+   *   const auto guard = row_work_statistics.guard(i, stride_size);
+   *   // work
+   * }
+   * ```
+   * Every row must only be processed by a single thread within a loop.
+   *
+   * @ingroup Miscellaneous
+   */
+  class RowWorkStatistics
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * (Re)initialize the class for @p n_rows rows and reset all recorded
+     * work. If @p enabled is false, guard() is a no-op.
+     */
+    void reinit(const bool enabled, const unsigned int n_rows)
+    {
+      enabled_ = enabled;
+      work_.assign(enabled_ ? n_rows : 0, 0.);
+    }
+
+    /**
+     * A guard object recording the wall time between its construction
+     * and destruction.
+     */
+    class Guard
+    {
+    public:
+      Guard(RowWorkStatistics &statistics,
+            const unsigned int row,
+            const unsigned int n_rows)
+          : statistics_(statistics)
+          , row_(row)
+          , n_rows_(n_rows)
+          , start_(statistics.enabled_ ? clock::now() : clock::time_point())
+      {
+      }
+
+      ~Guard()
+      {
+        if (RYUJIN_LIKELY(!statistics_.enabled_))
+          return;
+
+        const double time =
+            std::chrono::duration<double>(clock::now() - start_).count();
+        const unsigned int end =
+            std::min<unsigned int>(row_ + n_rows_, statistics_.work_.size());
+        for (unsigned int i = row_; i < end; ++i)
+          statistics_.work_[i] += time / n_rows_;
+      }
+
+    private:
+      RowWorkStatistics &statistics_;
+      const unsigned int row_;
+      const unsigned int n_rows_;
+      const clock::time_point start_;
+    };
+
+    DEAL_II_ALWAYS_INLINE inline Guard guard(const unsigned int row,
+                                             const unsigned int n_rows)
+    {
+      return Guard(*this, row, n_rows);
+    }
+
+    /**
+     * Return the wall time (in seconds) accumulated for every row since
+     * the last call to reinit() or reset(). The vector is empty if the
+     * statistics are disabled.
+     */
+    const std::vector<double> &work() const
+    {
+      return work_;
+    }
+
+    /**
+     * Reset all recorded work to zero.
+     */
+    void reset()
+    {
+      std::fill(work_.begin(), work_.end(), 0.);
+    }
+
+    bool enabled() const
+    {
+      return enabled_;
+    }
+
+  private:
+    bool enabled_ = false;
+    std::vector<double> work_;
+  };
+
+
+  /**
+   * A small helper class that accumulates work counters for every
+   * (locally owned) row in the row loops of the HyperbolicModule. In
+   * contrast to RowWorkStatistics the counters are deterministic and do
+   * not depend on the timing noise of the machine. The counters are only
+   * recorded if ryujin is configured with WORK_COUNTERS; otherwise
+   * count() compiles to nothing. Intended use:
+   * ```
+   * RYUJIN_OMP_FOR
+   * for (unsigned int i = 0; i < size; i += stride_size) {
+   *   row_work_counters.count(RowWorkCounters::stencil_entries,
+   *                           i, stride_size, row_length - 1);
+   *   // work
+   * }
+   * ```
+   * Every row must only be processed by a single thread within a loop.
+   *
+   * @ingroup Miscellaneous
+   */
+  class RowWorkCounters
+  {
+  public:
+    /**
+     * The recorded counters.
+     */
+    enum Counter : unsigned int {
+      /** Number of processed off-diagonal stencil entries. */
+      stencil_entries,
+      /** Number of calls to the limiter (in both limiter passes). */
+      limiter_calls,
+      /** Number of limiter calls that failed to satisfy the bounds. */
+      limiter_failures,
+      /** Number of steps for which the row skipped the limiter. */
+      smooth_rows,
+      n_counters
+    };
+
+    /**
+     * Names of the counters used for output.
+     */
+    static constexpr std::array<const char *, n_counters> names{
+        {"work_stencil_entries",
+         "work_limiter_calls",
+         "work_limiter_failures",
+         "work_smooth_rows"}};
+
+    /**
+     * Return true if ryujin is configured with WORK_COUNTERS.
+     */
+    static constexpr bool enabled()
+    {
+#ifdef WORK_COUNTERS
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    /**
+     * (Re)initialize the class for @p n_rows rows and reset all counters.
+     */
+    void reinit(const unsigned int n_rows)
+    {
+      if constexpr (enabled())
+        counters_.assign(n_rows, {});
+    }
+
+    /**
+     * Add @p amount to the counter @p counter of all rows of the chunk
+     * [row, row + n_rows).
+     */
+    DEAL_II_ALWAYS_INLINE inline void count(const Counter counter,
+                                            const unsigned int row,
+                                            const unsigned int n_rows,
+                                            const double amount = 1.)
+    {
+      if constexpr (enabled()) {
+        const unsigned int end =
+            std::min<unsigned int>(row + n_rows, counters_.size());
+        for (unsigned int i = row; i < end; ++i)
+          counters_[i][counter] += amount;
+      }
+    }
+
+    /**
+     * Return the value of @p counter of the locally owned row @p row.
+     */
+    double get(const Counter counter, const unsigned int row) const
+    {
+      return counters_[row][counter];
+    }
+
+    /**
+     * Return an estimate of the work spent on every row: the number of
+     * stencil entries plus the number of limiter calls. The vector is
+     * empty if the counters are disabled.
+     */
+    std::vector<double> work() const
+    {
+      std::vector<double> result(counters_.size());
+      for (unsigned int i = 0; i < counters_.size(); ++i)
+        result[i] = counters_[i][stencil_entries] + counters_[i][limiter_calls];
+      return result;
+    }
+
+  private:
+    std::vector<std::array<double, n_counters>> counters_;
+  };
+
+
+#ifdef DEDICATED_COMMUNICATION_THREAD
+  /**
+   * A single, long-lived communication thread that executes all payloads
+   * dispatched by SynchronizationDispatch in the order of submission.
+   * This avoids spawning a new thread for every ghost exchange and
+   * ensures that all asynchronous MPI communication is driven by one
+   * dedicated thread while the worker threads stay on computation.
+   *
+   * @ingroup Miscellaneous
+   */
+  class CommunicationThread
+  {
+  public:
+    /**
+     * Return a reference to the (lazily started) communication thread.
+     */
+    static CommunicationThread &instance()
+    {
+      static CommunicationThread communication_thread;
+      return communication_thread;
+    }
+
+    /**
+     * Queue a @p payload for execution on the communication thread and
+     * return a future signalling its completion.
+     */
+    std::future<void> submit(const std::function<void()> &payload)
+    {
+      std::packaged_task<void()> task(payload);
+      auto result = task.get_future();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+      }
+      condition_.notify_one();
+      return result;
+    }
+
+  private:
+    CommunicationThread()
+        : shutdown_(false)
+        , thread_([this]() { run(); })
+    {
+    }
+
+    ~CommunicationThread()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+      }
+      condition_.notify_one();
+      thread_.join();
+    }
+
+    void run()
+    {
+      for (;;) {
+        std::packaged_task<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          condition_.wait(lock,
+                          [this]() { return shutdown_ || !queue_.empty(); });
+          if (queue_.empty())
+            return;
+          task = std::move(queue_.front());
+          queue_.pop_front();
+        }
+        task();
+      }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::packaged_task<void()>> queue_;
+    bool shutdown_;
+    std::thread thread_;
+  };
+#endif
+
+
+  /**
+   * Pin every OpenMP worker thread of the calling process to a single
+   * CPU. Thread t is pinned to the (offset + t)-th CPU (modulo the number
+   * of available CPUs) of the CPU set the process is allowed to run on.
+   * If the process is not bound to a subset of the CPUs of the node (for
+   * example when the MPI launcher does not bind ranks), @p local_rank
+   * (the rank of the process within the node) is used to compute a
+   * disjoint offset for every process. The function returns the number
+   * of pinned threads.
+   *
+   * Because the OpenMP runtime reuses its worker threads for all
+   * subsequent parallel regions, pinning the threads once keeps every
+   * thread on the same CPU (and thus the same caches and NUMA domain) for
+   * the whole computation.
+   *
+   * @note If the compile-time option DEDICATED_COMMUNICATION_THREAD is set,
+   * the communication thread is started before pinning so that it
+   * inherits the unrestricted CPU set instead of competing with the
+   * master thread.
+   *
+   * @note The function is a no-op on systems other than Linux and without
+   * OpenMP support.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline unsigned int
+  pin_threads([[maybe_unused]] const unsigned int local_rank)
+  {
+#if defined(WITH_OPENMP) && defined(__linux__)
+#ifdef DEDICATED_COMMUNICATION_THREAD
+    CommunicationThread::instance();
+#endif
+
+    cpu_set_t available;
+    CPU_ZERO(&available);
+    if (sched_getaffinity(0, sizeof(available), &available) != 0)
+      return 0;
+
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &available))
+        cpus.push_back(cpu);
+
+    if (cpus.empty())
+      return 0;
+
+    const unsigned int n_threads = omp_get_max_threads();
+    const bool unbound =
+        static_cast<long>(cpus.size()) >= sysconf(_SC_NPROCESSORS_ONLN);
+    const std::size_t offset =
+        unbound ? std::size_t(local_rank) * n_threads : 0;
+
+    std::atomic<unsigned int> n_pinned(0);
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpus[(offset + omp_get_thread_num()) % cpus.size()], &mask);
+    if (sched_setaffinity(0, sizeof(mask), &mask) == 0)
+      ++n_pinned;
+    RYUJIN_PARALLEL_REGION_END
+
+    return n_pinned;
+#else
+    return 0;
+#endif
+  }
+
+
+  /**
+   * A small scheduler for overlapping communication (typically an MPI
+   * ghost exchange) with thread-parallel computation.
+   *
+   * The class takes a payload that is executed asynchronously as soon as
+   * all threads signalled via check() that they have finished working on
+   * the index range the payload depends on (typically the export index
+   * range). If the compile-time option ASYNC_MPI_EXCHANGE is not set, or
+   * if the payload has not been dispatched, the payload is executed in the
+   * destructor. If the compile-time option DEDICATED_COMMUNICATION_THREAD
+   * is set, the payload is executed on the CommunicationThread instead of
+   * a newly spawned thread.
+   *
+   * Optionally, the wall time of the payload and the wall time the
+   * destructor has to wait for the payload to complete (i.e., the
+   * communication time that could not be hidden) are recorded in the
+   * timers "<section>, total" and "<section>, exposed" of a supplied
+   * timer map.
    *
    * @ingroup Miscellaneous
    */
   class SynchronizationDispatch
   {
   public:
+    /**
+     * Constructor taking the payload that should be dispatched.
+     */
     SynchronizationDispatch(const std::function<void()> &async_payload)
         : async_payload_(async_payload)
         , n_threads_ready_(0)
+        , timer_total_(nullptr)
+        , timer_exposed_(nullptr)
+    {
+    }
+
+    /**
+     * Constructor taking the payload that should be dispatched and two
+     * timers for recording the total and exposed (non-hidden) wall time
+     * of the payload.
+     */
+    SynchronizationDispatch(const std::function<void()> &async_payload,
+                            dealii::Timer &timer_total,
+                            dealii::Timer &timer_exposed)
+        : async_payload_(async_payload)
+        , n_threads_ready_(0)
+        , timer_total_(&timer_total)
+        , timer_exposed_(&timer_exposed)
+    {
+    }
+
+    /**
+     * Constructor taking the payload that should be dispatched and a
+     * timer map for recording the total and exposed (non-hidden) wall
+     * time of the payload in the sections "section, total" and "section,
+     * exposed".
+     */
+    SynchronizationDispatch(
+        const std::function<void()> &async_payload,
+        std::map<std::string, dealii::Timer> &computing_timer,
+        const std::string &section)
+        : SynchronizationDispatch(async_payload,
+                                  computing_timer[section + ", total"],
+                                  computing_timer[section + ", exposed"])
     {
     }
 
@@ -151,11 +760,21 @@ namespace ryujin
     {
       /* Executes in serial, non thread-parallel context: */
 
+#ifdef TIMELINE_TRACING
+      const TimelineRegion region("synchronization wait");
+#endif
+
+      if (timer_exposed_ != nullptr)
+        timer_exposed_->start();
+
       if (payload_status_.valid()) {
         payload_status_.wait();
       } else {
-        async_payload_();
+        run_payload();
       }
+
+      if (timer_exposed_ != nullptr)
+        timer_exposed_->stop();
     }
 
 #ifdef ASYNC_MPI_EXCHANGE
@@ -168,7 +787,15 @@ namespace ryujin
 #ifdef WITH_OPENMP
         if (++n_threads_ready_ == omp_get_num_threads())
 #endif
-          payload_status_ = std::async(std::launch::async, async_payload_);
+        {
+#ifdef DEDICATED_COMMUNICATION_THREAD
+          payload_status_ = CommunicationThread::instance().submit(
+              [this]() { run_payload(); });
+#else
+          payload_status_ =
+              std::async(std::launch::async, [this]() { run_payload(); });
+#endif
+        }
       }
     }
 #else
@@ -176,9 +803,28 @@ namespace ryujin
 #endif
 
   private:
+    /**
+     * Execute the payload and record its wall time.
+     */
+    void run_payload()
+    {
+#ifdef TIMELINE_TRACING
+      const TimelineRegion region("ghost exchange");
+#endif
+      if (timer_total_ != nullptr)
+        timer_total_->start();
+
+      async_payload_();
+
+      if (timer_total_ != nullptr)
+        timer_total_->stop();
+    }
+
     const std::function<void()> async_payload_;
     std::future<void> payload_status_;
     std::atomic_int n_threads_ready_;
+    dealii::Timer *timer_total_;
+    dealii::Timer *timer_exposed_;
   };
 } // namespace ryujin
 
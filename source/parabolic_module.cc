@@ -6,14 +6,14 @@
 #include "parabolic_module.template.h"
 #include <instantiate.h>
 
-#define INSTANTIATE(dim, stages)                                               \
-  template void ParabolicModule<Description, dim, NUMBER>::step<stages>(       \
+#define INSTANTIATE(dim, stages, Number)                                       \
+  template void ParabolicModule<Description, dim, Number>::step<stages>(       \
       const StateVector &,                                                     \
-      const NUMBER,                                                            \
+      const Number,                                                            \
       std::array<std::reference_wrapper<const StateVector>, stages>,           \
-      const std::array<NUMBER, stages>,                                        \
+      const std::array<Number, stages>,                                        \
       StateVector &,                                                           \
-      NUMBER) const
+      Number) const
 
 namespace ryujin
 {
@@ -22,19 +22,40 @@ namespace ryujin
   template class ParabolicModule<Description, 2, NUMBER>;
   template class ParabolicModule<Description, 3, NUMBER>;
 
-  INSTANTIATE(1, 0);
-  INSTANTIATE(1, 1);
-  INSTANTIATE(1, 2);
-  INSTANTIATE(1, 3);
+  INSTANTIATE(1, 0, NUMBER);
+  INSTANTIATE(1, 1, NUMBER);
+  INSTANTIATE(1, 2, NUMBER);
+  INSTANTIATE(1, 3, NUMBER);
 
-  INSTANTIATE(2, 0);
-  INSTANTIATE(2, 1);
-  INSTANTIATE(2, 2);
-  INSTANTIATE(2, 3);
+  INSTANTIATE(2, 0, NUMBER);
+  INSTANTIATE(2, 1, NUMBER);
+  INSTANTIATE(2, 2, NUMBER);
+  INSTANTIATE(2, 3, NUMBER);
 
-  INSTANTIATE(3, 0);
-  INSTANTIATE(3, 1);
-  INSTANTIATE(3, 2);
-  INSTANTIATE(3, 3);
+  INSTANTIATE(3, 0, NUMBER);
+  INSTANTIATE(3, 1, NUMBER);
+  INSTANTIATE(3, 2, NUMBER);
+  INSTANTIATE(3, 3, NUMBER);
+
+#ifdef PRECISION_SWITCH
+  template class ParabolicModule<Description, 1, float>;
+  template class ParabolicModule<Description, 2, float>;
+  template class ParabolicModule<Description, 3, float>;
+
+  INSTANTIATE(1, 0, float);
+  INSTANTIATE(1, 1, float);
+  INSTANTIATE(1, 2, float);
+  INSTANTIATE(1, 3, float);
+
+  INSTANTIATE(2, 0, float);
+  INSTANTIATE(2, 1, float);
+  INSTANTIATE(2, 2, float);
+  INSTANTIATE(2, 3, float);
+
+  INSTANTIATE(3, 0, float);
+  INSTANTIATE(3, 1, float);
+  INSTANTIATE(3, 2, float);
+  INSTANTIATE(3, 3, float);
+#endif
 
 } /* namespace ryujin */
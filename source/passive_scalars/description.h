@@ -0,0 +1,52 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include "../stub_parabolic_system.h"
+#include "../stub_solver.h"
+#include "hyperbolic_system.h"
+#include "indicator.h"
+#include "limiter.h"
+#include "riemann_solver.h"
+
+namespace ryujin
+{
+  namespace PassiveScalars
+  {
+    /**
+     * A struct that contains all equation specific classes describing the
+     * chosen hyperbolic system, the indicator, the limiter and
+     * (approximate) Riemann solver.
+     *
+     * We group all of these templates together in this struct so that we
+     * only need to add a single template parameter to the all the
+     * algorithm classes, such as HyperbolicModule.
+     *
+     * @ingroup PassiveScalarsEquations
+     */
+    struct Description {
+      using HyperbolicSystem = PassiveScalars::HyperbolicSystem;
+
+      template <int dim, typename Number = double>
+      using HyperbolicSystemView =
+          PassiveScalars::HyperbolicSystemView<dim, Number>;
+
+      using ParabolicSystem = ryujin::StubParabolicSystem;
+
+      template <int dim, typename Number = double>
+      using ParabolicSolver = ryujin::StubSolver<Description, dim, Number>;
+
+      template <int dim, typename Number = double>
+      using Indicator = PassiveScalars::Indicator<dim, Number>;
+
+      template <int dim, typename Number = double>
+      using Limiter = PassiveScalars::Limiter<dim, Number>;
+
+      template <int dim, typename Number = double>
+      using RiemannSolver = PassiveScalars::RiemannSolver<dim, Number>;
+    };
+  } // namespace PassiveScalars
+} // namespace ryujin
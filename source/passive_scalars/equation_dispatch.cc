@@ -0,0 +1,17 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#include "description.h"
+
+#include <compile_time_options.h>
+#include <equation_dispatch.h>
+
+namespace ryujin
+{
+  namespace PassiveScalars
+  {
+    Dispatch<Description, NUMBER> dispatch_instance("passive scalars");
+  } // namespace PassiveScalars
+} // namespace ryujin
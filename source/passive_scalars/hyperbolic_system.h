@@ -0,0 +1,519 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <convenience_macros.h>
+#include <discretization.h>
+#include <multicomponent_vector.h>
+#include <patterns_conversion.h>
+#include <simd.h>
+#include <state_vector.h>
+
+#include <deal.II/base/parameter_acceptor.h>
+#include <deal.II/base/tensor.h>
+
+#include <array>
+
+namespace ryujin
+{
+  namespace PassiveScalars
+  {
+    template <int dim, typename Number>
+    class HyperbolicSystemView;
+
+    /**
+     * A system of PASSIVE_SCALARS independent scalar tracers
+     * \f$s_1,\ldots,s_N\f$ that are transported with a common, constant
+     * velocity field \f$\mathbf v\f$:
+     * \f{align}
+     *   \partial_t s_k + \nabla\cdot(\mathbf v\,s_k) = 0,
+     *   \qquad k = 1,\ldots,N.
+     * \f}
+     * The number of tracers is fixed at compile time with the
+     * PASSIVE_SCALARS configuration option. All tracers are advanced in a
+     * single sweep over the sparsity pattern, i.e., every stencil and
+     * every matrix entry c_ij is only read once per step for all tracers.
+     *
+     * @ingroup PassiveScalarsEquations
+     */
+    class HyperbolicSystem final : public dealii::ParameterAcceptor
+    {
+    public:
+      /**
+       * The name of the hyperbolic system as a string.
+       */
+      static inline const std::string problem_name = "Passive scalars";
+
+      /**
+       * Constructor.
+       */
+      HyperbolicSystem(const std::string &subsection = "/HyperbolicSystem")
+          : ParameterAcceptor(subsection)
+      {
+        velocity_[0] = 1.;
+        add_parameter("velocity",
+                      velocity_,
+                      "The (constant) velocity field transporting all "
+                      "passive scalars. Only the first dim components are "
+                      "used.");
+      }
+
+      /**
+       * Return a view on the Hyperbolic System for a given dimension @p
+       * dim and choice of number type @p Number (which can be a scalar
+       * float, or double, as well as a VectorizedArray holding packed
+       * scalars.
+       */
+      template <int dim, typename Number>
+      auto view() const
+      {
+        return HyperbolicSystemView<dim, Number>{*this};
+      }
+
+    private:
+      /**
+       * @name Runtime parameters, internal fields, methods, and friends
+       */
+      //@{
+      dealii::Tensor<1, 3, double> velocity_;
+
+      template <int dim, typename Number>
+      friend class HyperbolicSystemView;
+      //@}
+    }; /* HyperbolicSystem */
+
+
+    /**
+     * A view on the HyperbolicSystem for a given dimension @p dim and
+     * choice of number type @p Number (which can be a scalar float, or
+     * double, as well as a VectorizedArray holding packed scalars.
+     */
+    template <int dim, typename Number>
+    class HyperbolicSystemView
+    {
+    public:
+      /**
+       * Constructor taking a reference to the underlying
+       * HyperbolicSystem
+       */
+      HyperbolicSystemView(const HyperbolicSystem &hyperbolic_system)
+          : hyperbolic_system_(hyperbolic_system)
+      {
+      }
+
+      /**
+       * Create a modified view from the current one:
+       */
+      template <int dim2, typename Number2>
+      auto view() const
+      {
+        return HyperbolicSystemView<dim2, Number2>{hyperbolic_system_};
+      }
+
+      /**
+       * The underlying scalar number type.
+       */
+      using ScalarNumber = typename get_value_type<Number>::type;
+
+      /**
+       * @name Access to runtime parameters
+       */
+      //@{
+
+      /**
+       * Return the transport velocity restricted to @a dim components.
+       */
+      DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, dim, Number>
+      velocity() const
+      {
+        dealii::Tensor<1, dim, Number> result;
+        for (unsigned int d = 0; d < dim; ++d)
+          result[d] = Number(ScalarNumber(hyperbolic_system_.velocity_[d]));
+        return result;
+      }
+
+      //@}
+
+    private:
+      const HyperbolicSystem &hyperbolic_system_;
+
+    public:
+      /**
+       * @name Types and constexpr constants
+       */
+      //@{
+
+      /**
+       * The dimension of the state space, i.e., the number of transported
+       * scalars.
+       */
+      static constexpr unsigned int problem_dimension = PASSIVE_SCALARS;
+
+      /**
+       * Storage type for a (conserved) state vector \f$\boldsymbol U\f$.
+       */
+      using state_type = dealii::Tensor<1, problem_dimension, Number>;
+
+      /**
+       * Storage type for the flux \f$\mathbf{f}\f$.
+       */
+      using flux_type =
+          dealii::Tensor<1, problem_dimension, dealii::Tensor<1, dim, Number>>;
+
+      /**
+       * The storage type used for flux contributions. The flux is linear
+       * in the state with a common velocity, it thus suffices to carry
+       * the state itself and form \f$\mathbf v\cdot\mathbf c_{ij}\f$ once
+       * per stencil entry in flux_divergence().
+       */
+      using flux_contribution_type = state_type;
+
+      /**
+       * An array holding all component names of the conserved state as a
+       * string.
+       */
+      static inline const auto component_names =
+          []() -> std::array<std::string, problem_dimension> {
+        std::array<std::string, problem_dimension> result;
+        for (unsigned int k = 0; k < problem_dimension; ++k)
+          result[k] = "s_" + std::to_string(k + 1);
+        return result;
+      }();
+
+      /**
+       * An array holding all component names of the primitive state as a
+       * string.
+       */
+      static inline const auto primitive_component_names = component_names;
+
+      /**
+       * The number of precomputed values.
+       */
+      static constexpr unsigned int n_precomputed_values = 0;
+
+      /**
+       * Array type used for precomputed values.
+       */
+      using precomputed_type = std::array<Number, n_precomputed_values>;
+
+      /**
+       * An array holding all component names of the precomputed values.
+       */
+      static inline const auto precomputed_names =
+          std::array<std::string, n_precomputed_values>{};
+
+      /**
+       * The components of the precomputed values that are read at
+       * neighboring degrees of freedom. Only these components are
+       * exchanged over MPI ranks.
+       */
+      static constexpr std::array<unsigned int, 0>
+          precomputed_ghost_components{};
+
+      /**
+       * The number of precomputed initial values.
+       */
+      static constexpr unsigned int n_initial_precomputed_values = 0;
+
+      /**
+       * Array type used for precomputed initial values.
+       */
+      using initial_precomputed_type =
+          std::array<Number, n_initial_precomputed_values>;
+
+      /**
+       * An array holding all component names of the precomputed values.
+       */
+      static inline const auto initial_precomputed_names =
+          std::array<std::string, n_initial_precomputed_values>{};
+
+      /**
+       * A compound state vector.
+       */
+      using StateVector = Vectors::
+          StateVector<ScalarNumber, problem_dimension, n_precomputed_values>;
+
+      /**
+       * MulticomponentVector for storing the hyperbolic state vector:
+       */
+      using HyperbolicVector =
+          Vectors::MultiComponentVector<ScalarNumber, problem_dimension>;
+
+      /**
+       * MulticomponentVector for storing a vector of precomputed states:
+       */
+      using PrecomputedVector =
+          Vectors::MultiComponentVector<ScalarNumber, n_precomputed_values>;
+
+      /**
+       * MulticomponentVector for storing a vector of precomputed initial
+       * states:
+       */
+      using InitialPrecomputedVector =
+          Vectors::MultiComponentVector<ScalarNumber,
+                                        n_initial_precomputed_values>;
+
+      //@}
+      /**
+       * @name Computing precomputed quantities
+       */
+      //@{
+
+      /**
+       * The number of precomputation cycles.
+       */
+      static constexpr unsigned int n_precomputation_cycles = 0;
+
+      /**
+       * Precompute values for hyperbolic update. This routine is called
+       * within our usual loop() idiom in HyperbolicModule
+       */
+      template <typename DISPATCH, typename SPARSITY>
+      void precomputation_loop(unsigned int /*cycle*/,
+                               const DISPATCH &dispatch_check,
+                               const SPARSITY & /*sparsity_simd*/,
+                               StateVector & /*state_vector*/,
+                               unsigned int /*left*/,
+                               unsigned int /*right*/) const = delete;
+
+      //@}
+      /**
+       * @name Computing derived physical quantities
+       */
+      //@{
+
+      /**
+       * Returns whether the state @p U is admissible. Every state is
+       * admissible for a linear transport system.
+       */
+      bool is_admissible(const state_type & /*U*/) const
+      {
+        return true;
+      }
+
+      //@}
+      /**
+       * @name Special functions for boundary states
+       */
+      //@{
+
+      /**
+       * Apply boundary conditions.
+       *
+       * For the passive scalars we only support Dirichlet boundary
+       * conditions.
+       */
+      template <typename Lambda>
+      state_type
+      apply_boundary_conditions(const dealii::types::boundary_id id,
+                                const state_type &U,
+                                const dealii::Tensor<1, dim, Number> &normal,
+                                const Lambda &get_dirichlet_data) const;
+
+      //@}
+      /**
+       * @name Flux computations
+       */
+      //@{
+
+      /**
+       * Given a state @p U_i and an index @p i compute flux contributions.
+       *
+       * Intended usage:
+       * ```
+       * Indicator<dim, Number> indicator;
+       * for (unsigned int i = n_internal; i < n_owned; ++i) {
+       *   // ...
+       *   const auto flux_i = flux_contribution(precomputed..., i, U_i);
+       *   for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+       *     // ...
+       *     const auto flux_j = flux_contribution(precomputed..., js, U_j);
+       *     const auto flux_ij = flux_divergence(flux_i, flux_j, c_ij);
+       *   }
+       * }
+       * ```
+       *
+       * For the passive scalars we simply store the state <code>U_i</code>.
+       */
+      flux_contribution_type
+      flux_contribution(const PrecomputedVector & /*pv*/,
+                        const InitialPrecomputedVector & /*piv*/,
+                        const unsigned int /*i*/,
+                        const state_type &U_i) const
+      {
+        return U_i;
+      }
+
+      flux_contribution_type
+      flux_contribution(const PrecomputedVector & /*pv*/,
+                        const InitialPrecomputedVector & /*piv*/,
+                        const unsigned int * /*js*/,
+                        const state_type &U_j) const
+      {
+        return U_j;
+      }
+
+      /**
+       * Given flux contributions @p flux_i and @p flux_j compute the flux
+       * <code>(-f(U_i) - f(U_j)</code>, i.e., for all tracers
+       * <code>-(U_i + U_j) (v * c_ij)</code>.
+       */
+      state_type
+      flux_divergence(const flux_contribution_type &flux_i,
+                      const flux_contribution_type &flux_j,
+                      const dealii::Tensor<1, dim, Number> &c_ij) const
+      {
+        return -(flux_i + flux_j) * (velocity() * c_ij);
+      }
+
+      /**
+       * The low-order and high-order fluxes are the same:
+       */
+      static constexpr bool have_high_order_flux = false;
+
+      state_type high_order_flux_divergence(
+          const flux_contribution_type &,
+          const flux_contribution_type &,
+          const dealii::Tensor<1, dim, Number> &) const = delete;
+
+      //@}
+      /**
+       * @name Computing stencil source terms
+       */
+      //@{
+
+      /** We do not have source terms */
+      static constexpr bool have_source_terms = false;
+
+      state_type nodal_source(const PrecomputedVector & /*pv*/,
+                              const unsigned int /*i*/,
+                              const state_type & /*U_i*/,
+                              const ScalarNumber /*tau*/) const = delete;
+
+      state_type nodal_source(const PrecomputedVector & /*pv*/,
+                              const unsigned int * /*js*/,
+                              const state_type & /*U_j*/,
+                              const ScalarNumber /*tau*/) const = delete;
+
+      /** We do not have implicit source terms */
+      static constexpr bool have_implicit_source_terms = false;
+
+      //@}
+      /**
+       * @name State transformations
+       */
+      //@{
+
+      /**
+       * Given a state vector associated with a different spatial
+       * dimensions than the current one, return an "expanded" version of
+       * the state vector associated with @a dim spatial dimensions. The
+       * state of the passive scalars does not depend on the spatial
+       * dimension, the state is thus returned unmodified.
+       */
+      template <typename ST>
+      state_type expand_state(const ST &state) const
+      {
+        return state;
+      }
+
+      /**
+       * Given a primitive state return a conserved state. Both coincide
+       * for the passive scalars.
+       */
+      state_type from_primitive_state(const state_type &primitive_state) const
+      {
+        return primitive_state;
+      }
+
+      /**
+       * Given a conserved state return a primitive state. Both coincide
+       * for the passive scalars.
+       */
+      state_type to_primitive_state(const state_type &state) const
+      {
+        return state;
+      }
+
+      /**
+       * Transform the current state according to a  given operator
+       * @p lambda acting on a @a dim dimensional momentum (or velocity)
+       * vector.
+       */
+      template <typename Lambda>
+      state_type apply_galilei_transform(const state_type &state,
+                                         const Lambda & /*lambda*/) const
+      {
+        return state;
+      }
+
+      //@}
+    }; /* HyperbolicSystemView */
+
+
+    /*
+     * -------------------------------------------------------------------------
+     * Inline definitions
+     * -------------------------------------------------------------------------
+     */
+
+
+    template <int dim, typename Number>
+    template <typename Lambda>
+    DEAL_II_ALWAYS_INLINE inline auto
+    HyperbolicSystemView<dim, Number>::apply_boundary_conditions(
+        dealii::types::boundary_id id,
+        const state_type &U,
+        const dealii::Tensor<1, dim, Number> & /*normal*/,
+        const Lambda &get_dirichlet_data) const -> state_type
+    {
+      state_type result = U;
+
+      if (id == Boundary::dirichlet) {
+        result = get_dirichlet_data();
+
+      } else if (id == Boundary::dirichlet_momentum) {
+        AssertThrow(
+            false,
+            dealii::ExcMessage("Invalid boundary ID »Boundary::"
+                               "dirichlet_momentum«, enforcing Dirichlet "
+                               "boundary conditions on a momentum is not "
+                               "possible for passive scalars."));
+
+      } else if (id == Boundary::slip) {
+        AssertThrow(
+            false,
+            dealii::ExcMessage("Invalid boundary ID »Boundary::slip«, slip "
+                               "boundary conditions are unavailable for "
+                               "passive scalars."));
+        __builtin_trap();
+
+      } else if (id == Boundary::no_slip) {
+        AssertThrow(
+            false,
+            dealii::ExcMessage("Invalid boundary ID »Boundary::no_slip«, "
+                               "no-slip boundary conditions are unavailable "
+                               "for passive scalars."));
+        __builtin_trap();
+
+      } else if (id == Boundary::dynamic) {
+        AssertThrow(
+            false,
+            dealii::ExcMessage("Invalid boundary ID »Boundary::dynamic«, "
+                               "dynamic boundary conditions are unavailable "
+                               "for passive scalars."));
+        __builtin_trap();
+
+      } else {
+        AssertThrow(false, dealii::ExcNotImplemented());
+      }
+
+      return result;
+    }
+  } // namespace PassiveScalars
+} // namespace ryujin
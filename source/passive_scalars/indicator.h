@@ -0,0 +1,219 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include "hyperbolic_system.h"
+
+#include <multicomponent_vector.h>
+#include <simd.h>
+
+#include <deal.II/base/parameter_acceptor.h>
+#include <deal.II/base/vectorization.h>
+
+
+namespace ryujin
+{
+  namespace PassiveScalars
+  {
+    template <typename ScalarNumber = double>
+    class IndicatorParameters : public dealii::ParameterAcceptor
+    {
+    public:
+      IndicatorParameters(const std::string &subsection = "/Indicator")
+          : ParameterAcceptor(subsection)
+      {
+        evc_factor_ = ScalarNumber(1.);
+        add_parameter("evc factor",
+                      evc_factor_,
+                      "Factor for scaling the entropy viscocity commuator");
+      }
+
+      ACCESSOR_READ_ONLY(evc_factor);
+
+    private:
+      ScalarNumber evc_factor_;
+    };
+
+
+    /**
+     * An suitable indicator strategy that is used to form the preliminary
+     * high-order update. We compute an entropy viscosity commutator with
+     * a Krŭzkov entropy for every tracer individually and return the
+     * largest indicator value over all tracers.
+     *
+     * @ingroup PassiveScalarsEquations
+     */
+    template <int dim, typename Number = double>
+    class Indicator
+    {
+    public:
+      /**
+       * @name Typedefs and constexpr constants
+       */
+      //@{
+
+      using View = HyperbolicSystemView<dim, Number>;
+
+      using ScalarNumber = typename View::ScalarNumber;
+
+      static constexpr auto problem_dimension = View::problem_dimension;
+
+      using state_type = typename View::state_type;
+
+      using PrecomputedVector = typename View::PrecomputedVector;
+
+      using Parameters = IndicatorParameters<ScalarNumber>;
+
+      //@}
+      /**
+       * @name Stencil-based computation of indicators
+       *
+       * Intended usage:
+       * ```
+       * Indicator<dim, Number> indicator;
+       * for (unsigned int i = n_internal; i < n_owned; ++i) {
+       *   // ...
+       *   indicator.reset(i, U_i);
+       *   for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+       *     // ...
+       *     indicator.accumulate(js, U_j, c_ij);
+       *   }
+       *   indicator.alpha(hd_i);
+       * }
+       * ```
+       */
+      //@{
+
+      /**
+       * Constructor taking a HyperbolicSystem instance as argument
+       */
+      Indicator(const HyperbolicSystem &hyperbolic_system,
+                const Parameters &parameters,
+                const PrecomputedVector &precomputed_values)
+          : hyperbolic_system(hyperbolic_system)
+          , parameters(parameters)
+          , precomputed_values(precomputed_values)
+      {
+      }
+
+      /**
+       * Reset temporary storage and initialize for a new row corresponding
+       * to state vector U_i. The index @p i is either the first index of a
+       * contiguous range, or (for a SIMD vectorized state) an array of
+       * individual indices, see HyperbolicModule::step().
+       */
+      template <typename Index>
+      void reset(const Index i, const state_type &U_i);
+
+      /**
+       * When looping over the sparsity row, add the contribution associated
+       * with the neighboring state U_j.
+       */
+      void accumulate(const unsigned int *js,
+                      const state_type &U_j,
+                      const dealii::Tensor<1, dim, Number> &c_ij);
+
+      /**
+       * Return the computed alpha_i value.
+       */
+      Number alpha(const Number h_i) const;
+
+      //@}
+
+    private:
+      /**
+       * @name
+       */
+      //@{
+
+      const HyperbolicSystem &hyperbolic_system;
+      const Parameters &parameters;
+      const PrecomputedVector &precomputed_values;
+
+      state_type U_i;
+      state_type u_abs_max;
+      state_type left;
+      state_type right;
+      //@}
+    };
+
+
+    /*
+     * -------------------------------------------------------------------------
+     * Inline definitions
+     * -------------------------------------------------------------------------
+     */
+
+
+    template <int dim, typename Number>
+    template <typename Index>
+    DEAL_II_ALWAYS_INLINE inline void
+    Indicator<dim, Number>::reset(const Index /*i*/, const state_type &new_U_i)
+    {
+      /* entropy viscosity commutator: */
+
+      U_i = new_U_i;
+      for (unsigned int k = 0; k < problem_dimension; ++k)
+        u_abs_max[k] = std::abs(U_i[k]);
+      left = state_type();
+      right = state_type();
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline void Indicator<dim, Number>::accumulate(
+        const unsigned int * /*js*/,
+        const state_type &U_j,
+        const dealii::Tensor<1, dim, Number> &c_ij)
+    {
+      /* entropy viscosity commutator: */
+
+      const auto view = hyperbolic_system.view<dim, Number>();
+
+      constexpr auto gte = dealii::SIMDComparison::greater_than_or_equal;
+
+      /* The velocity contraction is shared by all tracers: */
+      const auto v_c_ij = view.velocity() * c_ij;
+
+      for (unsigned int k = 0; k < problem_dimension; ++k) {
+        const auto u_i = U_i[k];
+        const auto u_j = U_j[k];
+        u_abs_max[k] = std::max(u_abs_max[k], std::abs(u_j));
+
+        /* Derivative of the Krŭzkov entropy: sgn(u_j - u_i) */
+        const auto d_eta_j = dealii::compare_and_apply_mask<gte>(
+            u_j, u_i, Number(1.), Number(-1.));
+
+        left[k] += d_eta_j * u_j * v_c_ij;
+        right[k] += d_eta_j * u_i * v_c_ij;
+      }
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline Number
+    Indicator<dim, Number>::alpha(const Number hd_i) const
+    {
+      const auto regularization =
+          Number(100. * std::numeric_limits<ScalarNumber>::min());
+
+      Number result = Number(0.);
+      for (unsigned int k = 0; k < problem_dimension; ++k) {
+        const Number numerator = left[k] - right[k];
+        const Number denominator = std::abs(left[k]) + std::abs(right[k]);
+
+        const auto quotient =
+            std::abs(numerator) /
+            (denominator + std::max(hd_i * u_abs_max[k], regularization));
+
+        result = std::max(result, quotient);
+      }
+
+      return std::min(Number(1.), parameters.evc_factor() * result);
+    }
+
+  } // namespace PassiveScalars
+} // namespace ryujin
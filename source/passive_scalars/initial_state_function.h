@@ -0,0 +1,88 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include "hyperbolic_system.h"
+#include <initial_state_library.h>
+
+#include <deal.II/base/function_parser.h>
+
+namespace ryujin
+{
+  namespace PassiveScalars
+  {
+    struct Description;
+
+    /**
+     * Initial state defined by user provided functions, one for every
+     * passive scalar.
+     *
+     * @ingroup PassiveScalarsEquations
+     */
+    template <int dim, typename Number>
+    class Function : public InitialState<Description, dim, Number>
+    {
+    public:
+      using View = HyperbolicSystemView<dim, Number>;
+      using state_type = typename View::state_type;
+
+      Function(const HyperbolicSystem &hyperbolic_system,
+               const std::string subsection)
+          : InitialState<Description, dim, Number>("function", subsection)
+          , hyperbolic_system(hyperbolic_system)
+      {
+        expression_ = "0.25 * x";
+        for (unsigned int k = 1; k < View::problem_dimension; ++k)
+          expression_ += "; 0.25 * x";
+        this->add_parameter(
+            "expression",
+            expression_,
+            "A semicolon separated list of function expressions for the "
+            "initial state, one expression per scalar");
+
+        /*
+         * Set up the muparser object with the final description from the
+         * parameter file:
+         */
+        const auto set_up_muparser = [this] {
+          /*
+           * This variant of the constructor initializes the function
+           * parser with support for a time-dependent description involving
+           * a variable »t«:
+           */
+          function_ =
+              std::make_unique<dealii::FunctionParser<dim>>(expression_);
+
+          AssertThrow(function_->n_components == View::problem_dimension,
+                      dealii::ExcMessage(
+                          "The number of semicolon separated expressions "
+                          "has to match the number of passive scalars."));
+        };
+
+        set_up_muparser();
+        this->parse_parameters_call_back.connect(set_up_muparser);
+
+        /* The function parser cannot be evaluated concurrently: */
+        this->thread_safe_ = false;
+      }
+
+      state_type compute(const dealii::Point<dim> &point, Number t) final
+      {
+        state_type result;
+        function_->set_time(t);
+        for (unsigned int k = 0; k < View::problem_dimension; ++k)
+          result[k] = function_->value(point, k);
+        return result;
+      }
+
+    private:
+      const HyperbolicSystem &hyperbolic_system;
+
+      std::string expression_;
+      std::unique_ptr<dealii::FunctionParser<dim>> function_;
+    };
+  } // namespace PassiveScalars
+} // namespace ryujin
@@ -0,0 +1,19 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#include "initial_state_library.template.h"
+
+namespace ryujin
+{
+  template class InitialStateLibrary<Description, 1, NUMBER>;
+  template class InitialStateLibrary<Description, 2, NUMBER>;
+  template class InitialStateLibrary<Description, 3, NUMBER>;
+
+#ifdef PRECISION_SWITCH
+  template class InitialStateLibrary<Description, 1, float>;
+  template class InitialStateLibrary<Description, 2, float>;
+  template class InitialStateLibrary<Description, 3, float>;
+#endif
+} // namespace ryujin
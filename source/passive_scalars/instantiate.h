@@ -0,0 +1,17 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#ifndef RYUJIN_INCLUDE_INSTANTIATION_ONCE
+#define RYUJIN_INCLUDE_INSTANTIATION_ONCE
+#else
+#error Instantiation files can only be included once.
+#endif
+
+#include "description.h"
+
+namespace ryujin
+{
+  using PassiveScalars::Description;
+} // namespace ryujin
@@ -0,0 +1,34 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#include "limiter.template.h"
+
+using namespace dealii;
+
+namespace ryujin
+{
+  namespace PassiveScalars
+  {
+    /* instantiations */
+
+    template class Limiter<1, NUMBER>;
+    template class Limiter<2, NUMBER>;
+    template class Limiter<3, NUMBER>;
+
+    template class Limiter<1, VectorizedArrayType<NUMBER>>;
+    template class Limiter<2, VectorizedArrayType<NUMBER>>;
+    template class Limiter<3, VectorizedArrayType<NUMBER>>;
+
+#ifdef PRECISION_SWITCH
+    template class Limiter<1, float>;
+    template class Limiter<2, float>;
+    template class Limiter<3, float>;
+
+    template class Limiter<1, VectorizedArrayType<float>>;
+    template class Limiter<2, VectorizedArrayType<float>>;
+    template class Limiter<3, VectorizedArrayType<float>>;
+#endif
+  } // namespace PassiveScalars
+} // namespace ryujin
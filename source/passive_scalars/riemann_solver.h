@@ -0,0 +1,111 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include "hyperbolic_system.h"
+
+#include <simd.h>
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+
+namespace ryujin
+{
+  namespace PassiveScalars
+  {
+    template <typename ScalarNumber = double>
+    class RiemannSolverParameters : public dealii::ParameterAcceptor
+    {
+    public:
+      RiemannSolverParameters(const std::string &subsection = "/RiemannSolver")
+          : ParameterAcceptor(subsection)
+      {
+      }
+    };
+
+
+    /**
+     * The exact maximal wavespeed of the 1D Riemann problem: All tracers
+     * are transported with the same velocity \f$\mathbf v\f$, the
+     * wavespeed is thus given by \f$|\mathbf v\cdot\mathbf n_{ij}|\f$
+     * independently of the left and right states.
+     *
+     * @ingroup PassiveScalarsEquations
+     */
+    template <int dim, typename Number = double>
+    class RiemannSolver
+    {
+    public:
+      /**
+       * @name Typedefs and constexpr constants
+       */
+      //@{
+
+      using View = HyperbolicSystemView<dim, Number>;
+
+      using ScalarNumber = typename View::ScalarNumber;
+
+      using state_type = typename View::state_type;
+
+      using PrecomputedVector = typename View::PrecomputedVector;
+
+      using Parameters = RiemannSolverParameters<ScalarNumber>;
+
+      //@}
+      /**
+       * @name Compute wavespeed estimates
+       */
+      //@{
+
+      /**
+       * Constructor taking a HyperbolicSystem instance as argument
+       */
+      RiemannSolver(const HyperbolicSystem &hyperbolic_system,
+                    const Parameters &parameters,
+                    const PrecomputedVector &precomputed_values)
+          : hyperbolic_system(hyperbolic_system)
+          , parameters(parameters)
+          , precomputed_values(precomputed_values)
+      {
+      }
+
+      /**
+       * For two given states U_i a U_j and a (normalized) "direction" n_ij
+       * compute the maximal wavespeed.
+       */
+      Number compute(const state_type & /*U_i*/,
+                     const state_type & /*U_j*/,
+                     const unsigned int /*i*/,
+                     const unsigned int * /*js*/,
+                     const dealii::Tensor<1, dim, Number> &n_ij) const
+      {
+        const auto view = hyperbolic_system.view<dim, Number>();
+        return std::abs(view.velocity() * n_ij);
+      }
+
+      /**
+       * Variant of above function for a (SIMD vectorized) state U_i that
+       * is associated with individual indices @p is instead of a
+       * contiguous range of indices starting at i.
+       */
+      Number compute(const state_type & /*U_i*/,
+                     const state_type & /*U_j*/,
+                     const unsigned int * /*is*/,
+                     const unsigned int * /*js*/,
+                     const dealii::Tensor<1, dim, Number> &n_ij) const
+      {
+        const auto view = hyperbolic_system.view<dim, Number>();
+        return std::abs(view.velocity() * n_ij);
+      }
+
+    private:
+      const HyperbolicSystem &hyperbolic_system;
+      const Parameters &parameters;
+      const PrecomputedVector &precomputed_values;
+      //@}
+    };
+  } // namespace PassiveScalars
+} // namespace ryujin
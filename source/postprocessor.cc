@@ -13,4 +13,10 @@ namespace ryujin
   template class Postprocessor<Description, 2, NUMBER>;
   template class Postprocessor<Description, 3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class Postprocessor<Description, 1, float>;
+  template class Postprocessor<Description, 2, float>;
+  template class Postprocessor<Description, 3, float>;
+#endif
+
 } /* namespace ryujin */
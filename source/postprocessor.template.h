@@ -114,7 +114,7 @@ namespace ryujin
 
     const auto &U = std::get<0>(state_vector);
 
-    using VA = dealii::VectorizedArray<Number>;
+    using VA = VectorizedArrayType<Number>;
 
     const auto &affine_constraints = offline_data_->affine_constraints();
 
@@ -135,20 +135,57 @@ namespace ryujin
     Assert(n_quantities == quantities_.size(), dealii::ExcInternalError());
     Assert(n_quantities == component_names_.size(), dealii::ExcInternalError());
 
+    /* Only convert to primitive states if a primitive quantity is used: */
+    bool need_primitive_state = false;
+    for (const auto &indices : {schlieren_indices_, vorticity_indices_})
+      for (const auto &[is_primitive, index] : indices)
+        need_primitive_state |= is_primitive;
+
+    /* Force recomputation of bounds: */
+    if (recompute_bounds_)
+      bounds_.clear();
+
+    const bool compute_bounds = bounds_.size() != n_quantities;
+
+    /*
+     * We store bounds as (q_max, -q_min) so that all bounds can be
+     * synchronized in a single MPI reduction:
+     */
+    std::vector<Number> bounds(2 * n_quantities,
+                               -std::numeric_limits<Number>::max());
+    for (unsigned int d = 0; d < n_quantities; ++d)
+      bounds[d] = Number(0.);
+
     /*
-     * Step 1: Compute quantities:
+     * Step 1: Compute all quantities and (if necessary) their local
+     * bounds in a single sweep over the stencil:
      */
 
     {
       RYUJIN_PARALLEL_REGION_BEGIN
 
+      std::vector<Number> local_bounds(bounds);
+
       auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
         using T = decltype(sentinel);
         unsigned int stride_size = get_stride_size<T>;
 
+        const auto view = hyperbolic_system_->template view<dim, T>();
+
         std::vector<grad_type<T>> local_schlieren_values(n_schlieren);
         std::vector<curl_type<T>> local_vorticity_values(n_vorticities);
 
+        std::vector<T> lane_bounds(bounds.size());
+        for (unsigned int d = 0; d < bounds.size(); ++d)
+          lane_bounds[d] = T(bounds[d]);
+
+        const auto record_bounds = [&](const unsigned int d, const T &value) {
+          const auto q = std::abs(value);
+          lane_bounds[d] = std::max(lane_bounds[d], q);
+          lane_bounds[n_quantities + d] =
+              std::max(lane_bounds[n_quantities + d], -q);
+        };
+
         RYUJIN_OMP_FOR
         for (unsigned int i = left; i < right; i += stride_size) {
 
@@ -167,8 +204,8 @@ namespace ryujin
                ++col_idx, js += stride_size) {
 
             const auto U_j = U.template get_tensor<T>(js);
-            const auto view = hyperbolic_system_->template view<dim, T>();
-            const auto prim_j = view.to_primitive_state(U_j);
+            const auto prim_j =
+                need_primitive_state ? view.to_primitive_state(U_j) : U_j;
 
             const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
 
@@ -200,15 +237,29 @@ namespace ryujin
 
           for (const auto &schlieren : local_schlieren_values) {
             const auto value_i = schlieren.norm() / m_i;
+            if (compute_bounds)
+              record_bounds(k, value_i);
             write_entry<T>(quantities_[k++], value_i, i);
           }
 
           for (const auto &vorticity : local_vorticity_values) {
             auto value_i =
                 (dim == 2 ? vorticity[0] / m_i : vorticity.norm() / m_i);
+            if (compute_bounds)
+              record_bounds(k, value_i);
             write_entry<T>(quantities_[k++], value_i, i);
           }
         } /* i */
+
+        /* Reduce over SIMD lanes: */
+        for (unsigned int d = 0; d < bounds.size(); ++d) {
+          if constexpr (std::is_same_v<T, Number>) {
+            local_bounds[d] = std::max(local_bounds[d], lane_bounds[d]);
+          } else {
+            for (unsigned int s = 0; s < T::size(); ++s)
+              local_bounds[d] = std::max(local_bounds[d], lane_bounds[d][s]);
+          }
+        }
       };
 
       /* Parallel non-vectorized loop: */
@@ -216,35 +267,26 @@ namespace ryujin
       /* Parallel vectorized SIMD loop: */
       loop(VA(), 0, n_internal);
 
+      RYUJIN_OMP_CRITICAL
+      for (unsigned int d = 0; d < bounds.size(); ++d)
+        bounds[d] = std::max(bounds[d], local_bounds[d]);
+
       RYUJIN_PARALLEL_REGION_END
     }
 
     /*
-     * Step 2: Compute bounds and synchronize over MPI ranks:
+     * Step 2: Synchronize bounds over MPI ranks:
      */
 
-    /* Force recomputation of bounds: */
-    if (recompute_bounds_)
-      bounds_.clear();
-
-    if (bounds_.size() != n_quantities) {
-      bounds_.clear();
-      bounds_.resize(
-          n_quantities,
-          std::make_pair(Number(0.), std::numeric_limits<Number>::max()));
+    if (compute_bounds) {
+      bounds = dealii::Utilities::MPI::max(
+          bounds, mpi_ensemble_.ensemble_communicator());
 
+      bounds_.resize(n_quantities);
       for (unsigned int d = 0; d < n_quantities; ++d) {
-        auto &[q_max, q_min] = bounds_[d];
-        for (unsigned int i = 0; i < n_owned; ++i) {
-          const auto q = quantities_[d].local_element(i);
-          q_max = std::max(q_max, std::abs(q));
-          q_min = std::min(q_min, std::abs(q));
-        }
-        q_max = dealii::Utilities::MPI::max(
-            q_max, mpi_ensemble_.ensemble_communicator());
-        q_min = dealii::Utilities::MPI::min(
-            q_min, mpi_ensemble_.ensemble_communicator());
-        Assert(q_max >= q_min, dealii::ExcInternalError());
+        bounds_[d] = std::make_pair(bounds[d], -bounds[n_quantities + d]);
+        Assert(bounds_[d].first >= bounds_[d].second,
+               dealii::ExcInternalError());
       }
     }
 
@@ -256,9 +298,12 @@ namespace ryujin
       constexpr Number eps = std::numeric_limits<Number>::epsilon();
       constexpr Number floor = std::max(Number(1.0e-10), eps);
 
-      for (unsigned int d = 0; d < n_quantities; ++d) {
-        auto &[q_max, q_min] = bounds_[d];
-        for (unsigned int i = 0; i < n_owned; ++i) {
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
+        for (unsigned int d = 0; d < n_quantities; ++d) {
+          const auto &[q_max, q_min] = bounds_[d];
           auto &q = quantities_[d].local_element(i);
           /* clip off everything that is below the noise "floor": */
           const auto ratio = std::max(Number(0.), std::abs(q) - q_min - floor) /
@@ -268,6 +313,8 @@ namespace ryujin
           q = std::copysign(magnitude, q);
         }
       }
+
+      RYUJIN_PARALLEL_REGION_END
     }
 
     /*
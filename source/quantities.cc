@@ -13,4 +13,10 @@ namespace ryujin
   template class Quantities<Description, 2, NUMBER>;
   template class Quantities<Description, 3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class Quantities<Description, 1, float>;
+  template class Quantities<Description, 2, float>;
+  template class Quantities<Description, 3, float>;
+#endif
+
 } /* namespace ryujin */
@@ -9,16 +9,54 @@
 
 #include "mpi_ensemble.h"
 #include "offline_data.h"
+#include "patterns_conversion.h"
 
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/timer.h>
+#include <deal.II/grid/grid_tools_cache.h>
 #include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/sparse_matrix.templates.h>
 #include <deal.II/lac/vector.h>
 
+#include <functional>
+#include <future>
 #include <optional>
 
+namespace ryujin
+{
+  /**
+   * Controls the file format of the space averaged time series written
+   * by the Quantities class.
+   *
+   * @ingroup TimeLoop
+   */
+  enum class TimeSeriesFormat {
+    /**
+     * Human readable text, one line per time point.
+     */
+    text,
+
+    /**
+     * Binary, append-only columnar format: A header consisting of the
+     * magic string "RYUJINTS", the format version, the number of columns,
+     * the size of a floating point value in bytes (all std::uint32_t), and
+     * the length (std::uint32_t) and content of the text header, followed
+     * by one record of n_columns floating point values (time, primitive
+     * state, second moments) per time point. The script
+     * scripts/convert_time_series converts such files into the text
+     * format.
+     */
+    binary,
+  };
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::TimeSeriesFormat,
+             LIST({ryujin::TimeSeriesFormat::text, "text"},
+                  {ryujin::TimeSeriesFormat::binary, "binary"}, ));
+#endif
+
 namespace ryujin
 {
   /**
@@ -41,6 +79,8 @@ namespace ryujin
     using View =
         typename Description::template HyperbolicSystemView<dim, Number>;
 
+    static constexpr auto problem_dimension = View::problem_dimension;
+
     using state_type = typename View::state_type;
 
     using StateVector = typename View::StateVector;
@@ -59,6 +99,12 @@ namespace ryujin
                const ParabolicSystem &parabolic_system,
                const std::string &subsection = "/Quantities");
 
+    /**
+     * Destructor. Waits for a pending (asynchronous) time series
+     * writeback and frees all MPI communicators.
+     */
+    ~Quantities();
+
     /**
      * Prepare evaluation. A call to @ref prepare() allocates temporary
      * storage and is necessary before accumulate() and write_out() can be
@@ -80,12 +126,21 @@ namespace ryujin
     void accumulate(const StateVector &state_vector, const Number t);
 
     /**
-     * Write quantities of interest to designated output files.
+     * Write quantities of interest to designated output files. If
+     * "asynchronous writeback" is set, the space averaged time series are
+     * written on a background thread. The function waits for the
+     * previous writeback to complete first.
      */
     void write_out(const StateVector &state_vector,
                    const Number t,
                    unsigned int cycle);
 
+    /**
+     * Read a space averaged time series in the "binary" format from
+     * @p input and write it to @p output in the "text" format.
+     */
+    static void convert_time_series(std::istream &input, std::ostream &output);
+
     //@}
 
   private:
@@ -100,8 +155,15 @@ namespace ryujin
     std::vector<std::tuple<std::string, std::string, std::string>>
         boundary_manifolds_;
 
+    std::vector<std::tuple<std::string, std::string, std::string>>
+        point_probes_;
+
     bool clear_temporal_statistics_on_writeout_;
 
+    TimeSeriesFormat time_series_format_;
+
+    bool asynchronous_writeback_;
+
     //@}
     /**
      * @name Internal data
@@ -135,6 +197,13 @@ namespace ryujin
      */
     std::map<std::string, std::vector<boundary_point>> boundary_maps_;
 
+    /**
+     * For each boundary map a communicator over all ranks that own points
+     * of the map (and rank 0). The communicator is MPI_COMM_NULL on all
+     * other ranks.
+     */
+    std::map<std::string, MPI_Comm> boundary_communicators_;
+
     /**
      * A tuple describing boundary values we are interested in: the
      * primitive state and its second moment, boundary stresses and normal
@@ -176,6 +245,13 @@ namespace ryujin
      */
     std::map<std::string, std::vector<interior_point>> interior_maps_;
 
+    /**
+     * For each interior map a communicator over all ranks that own points
+     * of the map (and rank 0). The communicator is MPI_COMM_NULL on all
+     * other ranks.
+     */
+    std::map<std::string, MPI_Comm> interior_communicators_;
+
     /**
      * A tuple describing interior values we are interested in: the
      * primitive state and its second moment.
@@ -202,10 +278,45 @@ namespace ryujin
     std::map<std::string, std::vector<std::tuple<Number, interior_value>>>
         interior_time_series_;
 
+    /**
+     * A tuple describing a point probe at an arbitrary position: the
+     * (local) dof indices and interpolation weights of all degrees of
+     * freedom contributing to the value at the probe position (with
+     * hanging node constraints already resolved), and the position.
+     */
+    using probe_point =
+        std::tuple<std::vector<unsigned int> /*local dof indices*/,
+                   std::vector<Number> /*interpolation weights*/,
+                   dealii::Point<dim>> /*position*/;
+
+    /**
+     * The probe map. Every probe is assigned to exactly one rank (the
+     * lowest rank owning a cell that contains the probe position).
+     */
+    std::map<std::string, std::vector<probe_point>> probe_maps_;
+
+    /**
+     * For each probe map a communicator over all ranks that own probes
+     * of the map (and rank 0).
+     */
+    std::map<std::string, MPI_Comm> probe_communicators_;
+
+    /**
+     * Associated statistics for the probe map.
+     */
+    std::map<std::string, interior_statistic> probe_statistics_;
+    std::map<std::string, std::vector<std::tuple<Number, interior_value>>>
+        probe_time_series_;
+
     std::string base_name_;
     bool first_cycle_;
     std::optional<unsigned int> time_series_cycle_;
 
+    /**
+     * Pending asynchronous writeback of the space averaged time series.
+     */
+    std::future<void> pending_writeback_;
+
     //@}
     /**
      * @name Internal methods
@@ -218,6 +329,32 @@ namespace ryujin
 
     void clear_statistics();
 
+    void free_communicators();
+
+    /**
+     * Locate all probe points of the probe set @p points (coordinates
+     * separated by spaces, points separated by ";") in the locally owned
+     * part of the mesh and compute interpolation weights.
+     */
+    std::vector<probe_point>
+    create_probe_map(const std::string &points,
+                     const dealii::GridTools::Cache<dim> &cache) const;
+
+    /**
+     * Write the string @p chunk of every rank of the @p communicator into
+     * the file @p file_name via collective MPI IO. The chunks are ordered
+     * by rank and the @p header supplied by rank 0 is prepended. Every
+     * chunk is preceded by a "# rank n" separator (with n the ensemble
+     * rank). The separators of ensemble ranks that do not participate are
+     * written as well, so that the file layout is the same as if every
+     * rank had written its (possibly empty) chunk. The function does
+     * nothing if @p communicator is MPI_COMM_NULL.
+     */
+    void write_collectively(const std::string &file_name,
+                            const std::string &header,
+                            const std::string &chunk,
+                            const MPI_Comm &communicator) const;
+
     std::string header_;
 
     template <typename point_type, typename value_type>
@@ -229,7 +366,8 @@ namespace ryujin
     void internal_write_out(const std::string &file_name,
                             const std::string &time_stamp,
                             const std::vector<value_type> &values,
-                            const Number scale);
+                            const Number scale,
+                            const MPI_Comm &communicator);
 
     template <typename value_type>
     void internal_write_out_time_series(
@@ -12,8 +12,12 @@
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/work_stream.h>
 #include <deal.II/dofs/dof_tools.h>
+#include <deal.II/grid/grid_tools.h>
 
+#include <array>
+#include <cstdint>
 #include <fstream>
+#include <sstream>
 
 DEAL_II_NAMESPACE_OPEN
 template <int rank, int dim, typename Number>
@@ -78,12 +82,165 @@ namespace ryujin
                   "Format: '<name> : <level set formula> : <options> , [...] "
                   "(options: time_averaged, space_averaged, instantaneous)");
 
+    add_parameter("point probes",
+                  point_probes_,
+                  "List of point probe sets. Probes can be placed at arbitrary "
+                  "positions, the state is interpolated with the finite "
+                  "element basis of the cell containing the probe. "
+                  "Format: '<name> : <x y [z]>; <x y [z]>; [...] : <options> "
+                  ", [...] (options: time_averaged, space_averaged, "
+                  "instantaneous)");
+
     clear_temporal_statistics_on_writeout_ = true;
     add_parameter("clear statistics on writeout",
                   clear_temporal_statistics_on_writeout_,
                   "If set to true then all temporal statistics (for "
                   "\"time_averaged\" quantities) accumulated so far are reset "
                   "each time a writeout of quantities is performed");
+
+    time_series_format_ = TimeSeriesFormat::text;
+    add_parameter("time series format",
+                  time_series_format_,
+                  "File format of the space averaged time series: \"text\", "
+                  "or \"binary\" (append-only columnar format, use "
+                  "scripts/convert_time_series to convert to text)");
+
+    asynchronous_writeback_ = false;
+    add_parameter("asynchronous writeback",
+                  asynchronous_writeback_,
+                  "Write out the space averaged time series on a background "
+                  "thread while the computation continues");
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Quantities<Description, dim, Number>::~Quantities()
+  {
+    if (pending_writeback_.valid())
+      pending_writeback_.wait();
+    free_communicators();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::free_communicators()
+  {
+    for (auto *communicators : {&interior_communicators_,
+                                &boundary_communicators_,
+                                &probe_communicators_}) {
+      for (auto &[name, communicator] : *communicators)
+        if (communicator != MPI_COMM_NULL)
+          MPI_Comm_free(&communicator);
+      communicators->clear();
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  auto Quantities<Description, dim, Number>::create_probe_map(
+      const std::string &points, const GridTools::Cache<dim> &cache) const
+      -> std::vector<probe_point>
+  {
+    /* Parse the probe positions: */
+
+    std::vector<Point<dim>> positions;
+    for (const auto &entry : Utilities::split_string_list(points, ';')) {
+      std::istringstream stream(entry);
+      Point<dim> position;
+      for (unsigned int d = 0; d < dim; ++d)
+        stream >> position[d];
+      AssertThrow(!stream.fail(),
+                  dealii::ExcMessage("Invalid probe position »" + entry +
+                                     "«, expected " + std::to_string(dim) +
+                                     " coordinates separated by spaces"));
+      positions.push_back(position);
+    }
+
+    /*
+     * Locate every probe in the locally owned part of the triangulation
+     * and assign it to the lowest rank that owns a cell containing it:
+     */
+
+    const unsigned int rank = mpi_ensemble_.ensemble_rank();
+    std::vector<unsigned int> owners(positions.size(),
+                                     numbers::invalid_unsigned_int);
+    std::vector<std::pair<typename Triangulation<dim>::active_cell_iterator,
+                          Point<dim>>>
+        cells_and_unit_points(positions.size());
+
+    for (unsigned int k = 0; k < positions.size(); ++k) {
+      try {
+        const auto cell_and_unit_point =
+            GridTools::find_active_cell_around_point(cache, positions[k]);
+        const auto &cell = cell_and_unit_point.first;
+        if (cell.state() == IteratorState::valid && cell->is_locally_owned()) {
+          owners[k] = rank;
+          cells_and_unit_points[k] = cell_and_unit_point;
+        }
+      } catch (const dealii::ExceptionBase &) {
+        /* The point is not located in the local part of the mesh. */
+      }
+    }
+
+    owners =
+        Utilities::MPI::min(owners, mpi_ensemble_.ensemble_communicator());
+
+    for (unsigned int k = 0; k < positions.size(); ++k)
+      AssertThrow(owners[k] != numbers::invalid_unsigned_int,
+                  dealii::ExcMessage("Could not locate probe " +
+                                     std::to_string(k) + " of »" + points +
+                                     "« in the computational domain"));
+
+    /*
+     * Compute interpolation weights once. Constrained degrees of freedom
+     * are replaced by the degrees of freedom they are constrained to:
+     */
+
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &fe = dof_handler.get_fe();
+    const auto &affine_constraints = offline_data_->affine_constraints();
+    const auto &partitioner = offline_data_->scalar_partitioner();
+
+    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+
+    std::vector<probe_point> map;
+    for (unsigned int k = 0; k < positions.size(); ++k) {
+      if (owners[k] != rank)
+        continue;
+
+      const auto &[cell, unit_point] = cells_and_unit_points[k];
+      const typename DoFHandler<dim>::active_cell_iterator dof_cell(
+          &dof_handler.get_triangulation(),
+          cell->level(),
+          cell->index(),
+          &dof_handler);
+      dof_cell->get_dof_indices(dof_indices);
+
+      std::map<unsigned int, Number> weights;
+      for (unsigned int j = 0; j < fe.dofs_per_cell; ++j) {
+        const Number phi_j = fe.shape_value(j, unit_point);
+        const auto global_index = dof_indices[j];
+        if (!affine_constraints.is_constrained(global_index)) {
+          weights[partitioner->global_to_local(global_index)] += phi_j;
+          continue;
+        }
+        const auto entries =
+            affine_constraints.get_constraint_entries(global_index);
+        if (entries == nullptr)
+          continue;
+        for (const auto &[index, value] : *entries)
+          weights[partitioner->global_to_local(index)] += value * phi_j;
+      }
+
+      auto &[indices, values, position] = map.emplace_back();
+      for (const auto &[index, weight] : weights) {
+        indices.push_back(index);
+        values.push_back(weight);
+      }
+      position = positions[k];
+    }
+
+    return map;
   }
 
 
@@ -94,6 +251,10 @@ namespace ryujin
     std::cout << "Quantities<dim, Number>::prepare()" << std::endl;
 #endif
 
+    /* Make sure that no pending writeback refers to old file names: */
+    if (pending_writeback_.valid())
+      pending_writeback_.get();
+
     base_name_ = name;
 
     /* Force to write to a new time series file: */
@@ -105,39 +266,60 @@ namespace ryujin
     /*
      * Create interior maps and allocate statistics.
      *
-     * We have to loop over the cells and populate the std::map interior_maps_.
+     * We have to loop over the cells and populate the std::map
+     * interior_maps_. The cell loop is thread parallel: every thread
+     * populates a thread-local preliminary map that is merged afterwards.
      */
 
+    const auto &discretization = offline_data_->discretization();
+    const auto &dof_handler = offline_data_->dof_handler();
+
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> owned_cells;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        owned_cells.push_back(cell);
+
     interior_maps_.clear();
     std::transform(
         interior_manifolds_.begin(),
         interior_manifolds_.end(),
         std::inserter(interior_maps_, interior_maps_.end()),
-        [this, n_owned, &sparsity_simd](auto it) {
+        [&](auto it) {
           const auto &[name, expression, option] = it;
           FunctionParser<dim> level_set_function(expression);
 
           std::vector<interior_point> map;
           std::map<int, interior_point> preliminary_map;
 
-          const auto &discretization = offline_data_->discretization();
-          const auto &dof_handler = offline_data_->dof_handler();
-
           const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
 
           const auto support_points =
               dof_handler.get_fe().get_unit_support_points();
 
-          std::vector<dealii::types::global_dof_index> local_dof_indices(
-              dofs_per_cell);
+          const unsigned int n_cells = owned_cells.size();
 
-          /* Loop over cells */
-          for (auto cell : dof_handler.active_cell_iterators()) {
+          /*
+           * A degree of freedom shared by several cells may be found by
+           * more than one thread with (slightly) different positions. We
+           * merge the thread-local maps in a fixed order afterwards so
+           * that the result does not depend on scheduling:
+           */
+          unsigned int n_threads = 1;
+#ifdef WITH_OPENMP
+          n_threads = omp_get_max_threads();
+#endif
+          std::vector<std::map<int, interior_point>> local_maps(n_threads);
 
-            /* skip if not locally owned */
-            if (!cell->is_locally_owned())
-              continue;
+          RYUJIN_PARALLEL_REGION_BEGIN
 
+          std::map<int, interior_point> local_map;
+          std::vector<dealii::types::global_dof_index> local_dof_indices(
+              dofs_per_cell);
+
+          /* Loop over locally owned cells */
+          RYUJIN_OMP_FOR_NOWAIT
+          for (unsigned int c = 0; c < n_cells; ++c) {
+            const auto &cell = owned_cells[c];
             cell->get_active_or_mg_dof_indices(local_dof_indices);
 
             for (unsigned int j = 0; j < dofs_per_cell; ++j) {
@@ -169,15 +351,25 @@ namespace ryujin
 
               const Number interior_mass =
                   offline_data_->lumped_mass_matrix().local_element(index);
-              // FIXME: change to std::set
-              preliminary_map[index] = {index, interior_mass, position};
+              local_map[index] = {index, interior_mass, position};
             }
           }
 
+          unsigned int thread = 0;
+#ifdef WITH_OPENMP
+          thread = omp_get_thread_num();
+#endif
+          local_maps[thread] = std::move(local_map);
+
+          RYUJIN_PARALLEL_REGION_END
+
+          for (auto &local_map : local_maps)
+            preliminary_map.merge(local_map);
+
           /*
            * Now we populate the std::vector(interior_point) object called map.
            */
-          // FIXME: use std::copy
+          map.reserve(preliminary_map.size());
           for (const auto &[index, tuple] : preliminary_map) {
             map.push_back(tuple);
           }
@@ -191,7 +383,8 @@ namespace ryujin
      * We want to loop over the boundary_map() once and populate the map
      * object boundary_maps_. We have to create a vector of
      * boundary_manifolds.size() that holds a std::vector<boundary_point>
-     * for each map entry.
+     * for each map entry. The level set is evaluated thread parallel and
+     * the selected entries are then copied in order.
      */
 
     boundary_maps_.clear();
@@ -203,10 +396,16 @@ namespace ryujin
           const auto &[name, expression, option] = it;
           FunctionParser<dim> level_set_function(expression);
 
-          std::vector<boundary_point> map;
+          const auto &boundary_map = offline_data_->boundary_map();
+          const unsigned int n_entries = boundary_map.size();
+          std::vector<std::uint8_t> selected(n_entries, 0);
+
+          RYUJIN_PARALLEL_REGION_BEGIN
 
-          for (const auto &entry : offline_data_->boundary_map()) {
+          RYUJIN_OMP_FOR
+          for (unsigned int k = 0; k < n_entries; ++k) {
             // [i, normal, normal_mass, boundary_mass, id, position] = entry
+            const auto &entry = boundary_map[k];
             const auto &i = std::get<0>(entry);
 
             /* skip nonlocal */
@@ -220,11 +419,63 @@ namespace ryujin
 
             const auto &position = std::get<5>(entry);
             if (std::abs(level_set_function.value(position)) < 1.e-12)
-              map.push_back(entry);
+              selected[k] = 1;
           }
+
+          RYUJIN_PARALLEL_REGION_END
+
+          std::vector<boundary_point> map;
+          for (unsigned int k = 0; k < n_entries; ++k)
+            if (selected[k])
+              map.push_back(boundary_map[k]);
+
           return std::make_pair(name, map);
         });
 
+    /*
+     * Create probe maps. We perform a single spatial search for all
+     * probes here and only interpolate with cached weights afterwards:
+     */
+
+    probe_maps_.clear();
+    if (!point_probes_.empty()) {
+      const GridTools::Cache<dim> cache(discretization.triangulation(),
+                                        discretization.mapping());
+
+      for (const auto &[probe_name, points, option] : point_probes_)
+        probe_maps_[probe_name] = create_probe_map(points, cache);
+    }
+
+    /*
+     * Create a communicator for every map that only contains the ranks
+     * that own points of the map. We always include rank 0 so that a
+     * (possibly empty) output file with a header is written.
+     */
+
+    free_communicators();
+
+    const auto &ensemble_communicator = mpi_ensemble_.ensemble_communicator();
+    const bool is_root = mpi_ensemble_.ensemble_rank() == 0;
+
+    const auto create_communicators = [&](const auto &point_maps,
+                                          auto &communicators) {
+      for (const auto &[name, point_map] : point_maps) {
+        const bool participate = is_root || !point_map.empty();
+        MPI_Comm communicator;
+        const int ierr =
+            MPI_Comm_split(ensemble_communicator,
+                           participate ? 0 : MPI_UNDEFINED,
+                           mpi_ensemble_.ensemble_rank(),
+                           &communicator);
+        AssertThrowMPI(ierr);
+        communicators[name] = communicator;
+      }
+    };
+
+    create_communicators(interior_maps_, interior_communicators_);
+    create_communicators(boundary_maps_, boundary_communicators_);
+    create_communicators(probe_maps_, probe_communicators_);
+
     /* Clear statistics: */
     clear_statistics();
 
@@ -261,36 +512,50 @@ namespace ryujin
           options.find("time_averaged") == std::string::npos)
         continue;
 
-      /*
-       * FIXME: This currently distributes boundary maps to all MPI ranks.
-       * This is unnecessarily wasteful. Ideally, we should do MPI IO with
-       * only MPI ranks participating who actually have boundary values.
-       */
-
-      const auto received = Utilities::MPI::gather(
-          mpi_ensemble_.ensemble_communicator(), interior_map);
-
-      if (Utilities::MPI::this_mpi_process(
-              mpi_ensemble_.ensemble_communicator()) == 0) {
+      const auto &communicator = interior_communicators_.at(name);
+      if (communicator == MPI_COMM_NULL)
+        continue;
 
-        std::ofstream output(base_name_ + "-" + name + "-R" +
-                             Utilities::to_string(cycle, 4) + "-points.dat");
+      std::ostringstream output;
+      output << std::scientific << std::setprecision(14);
+      for (const auto &entry : interior_map) {
+        const auto &[index, mass_i, x_i] = entry;
+        output << x_i << "\t" << mass_i << "\n";
+      } /*entry*/
+
+      write_collectively(base_name_ + "-" + name + "-R" +
+                             Utilities::to_string(cycle, 4) + "-points.dat",
+                         "#\n# position\tinterior mass\n",
+                         output.str(),
+                         communicator);
+    }
 
-        output << std::scientific << std::setprecision(14);
+    /*
+     * Output probe maps:
+     */
 
-        output << "#\n# position\tinterior mass\n";
+    for (const auto &[name, probe_map] : probe_maps_) {
+      const auto &options = get_options_from_name(point_probes_, name);
+      if (options.find("instantaneous") == std::string::npos &&
+          options.find("time_averaged") == std::string::npos)
+        continue;
 
-        unsigned int rank = 0;
-        for (const auto &entries : received) {
-          output << "# rank " << rank++ << "\n";
-          for (const auto &entry : entries) {
-            const auto &[index, mass_i, x_i] = entry;
-            output << x_i << "\t" << mass_i << "\n";
-          } /*entry*/
-        }   /*entries*/
+      const auto &communicator = probe_communicators_.at(name);
+      if (communicator == MPI_COMM_NULL)
+        continue;
 
-        output << std::flush;
-      }
+      std::ostringstream output;
+      output << std::scientific << std::setprecision(14);
+      for (const auto &entry : probe_map) {
+        const auto &[indices, weights, x_i] = entry;
+        output << x_i << "\n";
+      } /*entry*/
+
+      write_collectively(base_name_ + "-" + name + "-R" +
+                             Utilities::to_string(cycle, 4) + "-points.dat",
+                         "#\n# position\n",
+                         output.str(),
+                         communicator);
     }
 
     /*
@@ -304,37 +569,23 @@ namespace ryujin
           options.find("time_averaged") == std::string::npos)
         continue;
 
-      /*
-       * FIXME: This currently distributes boundary maps to all MPI ranks.
-       * This is unnecessarily wasteful. Ideally, we should do MPI IO with
-       * only MPI ranks participating who actually have boundary values.
-       */
-
-      const auto received = Utilities::MPI::gather(
-          mpi_ensemble_.ensemble_communicator(), boundary_map);
-
-      if (Utilities::MPI::this_mpi_process(
-              mpi_ensemble_.ensemble_communicator()) == 0) {
-
-        std::ofstream output(base_name_ + "-" + name + "-R" +
-                             Utilities::to_string(cycle, 4) + "-points.dat");
-
-        output << std::scientific << std::setprecision(14);
-
-        output << "#\n# position\tnormal\tnormal mass\tboundary mass\n";
-
-        unsigned int rank = 0;
-        for (const auto &entries : received) {
-          output << "# rank " << rank++ << "\n";
-          for (const auto &entry : entries) {
-            const auto &[index, n_i, nm_i, bm_i, id, x_i] = entry;
-            output << x_i << "\t" << n_i << "\t" << nm_i << "\t" << bm_i
-                   << "\n";
-          } /*entry*/
-        }   /*entries*/
+      const auto &communicator = boundary_communicators_.at(name);
+      if (communicator == MPI_COMM_NULL)
+        continue;
 
-        output << std::flush;
-      }
+      std::ostringstream output;
+      output << std::scientific << std::setprecision(14);
+      for (const auto &entry : boundary_map) {
+        const auto &[index, n_i, nm_i, bm_i, id, x_i] = entry;
+        output << x_i << "\t" << n_i << "\t" << nm_i << "\t" << bm_i << "\n";
+      } /*entry*/
+
+      write_collectively(
+          base_name_ + "-" + name + "-R" + Utilities::to_string(cycle, 4) +
+              "-points.dat",
+          "#\n# position\tnormal\tnormal mass\tboundary mass\n",
+          output.str(),
+          communicator);
     }
   }
 
@@ -363,6 +614,10 @@ namespace ryujin
     boundary_statistics_.clear();
     reset(boundary_maps_, boundary_statistics_);
     boundary_time_series_.clear();
+
+    probe_statistics_.clear();
+    reset(probe_maps_, probe_statistics_);
+    probe_time_series_.clear();
   }
 
 
@@ -374,15 +629,44 @@ namespace ryujin
       std::vector<value_type> &val_new)
   {
     const auto &U = std::get<0>(state_vector);
+    const auto view = hyperbolic_system_->template view<dim, Number>();
 
     value_type spatial_average;
     Number mass_sum = Number(0.);
 
-    std::transform(
-        points_vector.begin(),
-        points_vector.end(),
-        val_new.begin(),
-        [&](auto point) -> value_type {
+    const unsigned int n_points = points_vector.size();
+
+    /*
+     * Thread-local partial sums. We combine them in a fixed thread order
+     * afterwards so that the result does not depend on scheduling:
+     */
+    unsigned int n_threads = 1;
+#ifdef WITH_OPENMP
+    n_threads = omp_get_max_threads();
+#endif
+    std::vector<value_type> partial_averages(n_threads);
+    std::vector<Number> partial_mass_sums(n_threads, Number(0.));
+
+    {
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      value_type local_average;
+      Number local_mass_sum = Number(0.);
+
+      RYUJIN_OMP_FOR_NOWAIT
+      for (unsigned int k = 0; k < n_points; ++k) {
+        const auto &point = points_vector[k];
+
+        state_type U_i;
+        Number mass_i = Number(1.);
+
+        if constexpr (std::is_same_v<point_type, probe_point>) {
+          /* Interpolate with the cached weights, probes have unit mass: */
+          const auto &indices = std::get<0>(point);
+          const auto &weights = std::get<1>(point);
+          for (unsigned int l = 0; l < indices.size(); ++l)
+            U_i += weights[l] * U.get_tensor(indices[l]);
+        } else {
           const auto i = std::get<0>(point);
           /*
            * Small trick to get the correct index for retrieving the
@@ -390,23 +674,37 @@ namespace ryujin
            */
           constexpr auto index =
               std::is_same_v<point_type, interior_point> ? 1 : 3;
-          const auto mass_i = std::get<index>(point);
+          mass_i = std::get<index>(point);
+          U_i = U.get_tensor(i);
+        }
 
-          const auto U_i = U.get_tensor(i);
-          const auto view = hyperbolic_system_->template view<dim, Number>();
-          const auto primitive_state = view.to_primitive_state(U_i);
+        const auto primitive_state = view.to_primitive_state(U_i);
 
-          value_type result;
-          std::get<0>(result) = primitive_state;
-          /* Compute second moments of the primitive state: */
-          std::get<1>(result) = schur_product(primitive_state, primitive_state);
+        auto &result = val_new[k];
+        std::get<0>(result) = primitive_state;
+        /* Compute second moments of the primitive state: */
+        std::get<1>(result) = schur_product(primitive_state, primitive_state);
 
-          mass_sum += mass_i;
-          std::get<0>(spatial_average) += mass_i * std::get<0>(result);
-          std::get<1>(spatial_average) += mass_i * std::get<1>(result);
+        local_mass_sum += mass_i;
+        std::get<0>(local_average) += mass_i * std::get<0>(result);
+        std::get<1>(local_average) += mass_i * std::get<1>(result);
+      }
 
-          return result;
-        });
+      unsigned int thread = 0;
+#ifdef WITH_OPENMP
+      thread = omp_get_thread_num();
+#endif
+      partial_averages[thread] = local_average;
+      partial_mass_sums[thread] = local_mass_sum;
+
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    for (unsigned int thread = 0; thread < n_threads; ++thread) {
+      mass_sum += partial_mass_sums[thread];
+      std::get<0>(spatial_average) += std::get<0>(partial_averages[thread]);
+      std::get<1>(spatial_average) += std::get<1>(partial_averages[thread]);
+    }
 
     /* synchronize MPI ranks (MPI Barrier): */
 
@@ -433,35 +731,102 @@ namespace ryujin
       const std::string &file_name,
       const std::string &time_stamp,
       const std::vector<value_type> &values,
-      const Number scale)
+      const Number scale,
+      const MPI_Comm &communicator)
   {
+    /* Only ranks that own points (and rank 0) participate: */
+    if (communicator == MPI_COMM_NULL)
+      return;
+
+    std::ostringstream output;
+    output << std::scientific << std::setprecision(14);
+    for (const auto &entry : values) {
+      const auto &[state, state_square] = entry;
+      output << scale * state << "\t" << scale * state_square << "\n";
+    } /*entry*/
+
+    write_collectively(
+        file_name, time_stamp + "# " + header_, output.str(), communicator);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::write_collectively(
+      const std::string &file_name,
+      const std::string &header,
+      const std::string &chunk,
+      const MPI_Comm &communicator) const
+  {
+    if (communicator == MPI_COMM_NULL)
+      return;
+
+    const auto rank = Utilities::MPI::this_mpi_process(communicator);
+    const auto n_ranks = Utilities::MPI::n_mpi_processes(communicator);
+
     /*
-     * FIXME: This currently distributes interior maps to all MPI ranks.
-     * This is unnecessarily wasteful. Ideally, we should do MPI IO with
-     * only MPI ranks participating who actually have interior values.
+     * Gather the ensemble rank and the chunk size of every participating
+     * rank. A rank writes the separators of all non participating ensemble
+     * ranks between itself and the next participating rank after its
+     * chunk:
      */
 
-    const auto received =
-        Utilities::MPI::gather(mpi_ensemble_.ensemble_communicator(), values);
-
-    if (Utilities::MPI::this_mpi_process(
-            mpi_ensemble_.ensemble_communicator()) == 0) {
+    const unsigned long long local_size =
+        (rank == 0 ? header.size() : 0) + chunk.size();
+    const std::array<unsigned long long, 2> local_data{
+        {static_cast<unsigned long long>(mpi_ensemble_.ensemble_rank()),
+         local_size}};
+    std::vector<unsigned long long> data(2 * n_ranks);
+    int ierr = MPI_Allgather(local_data.data(),
+                             2,
+                             MPI_UNSIGNED_LONG_LONG,
+                             data.data(),
+                             2,
+                             MPI_UNSIGNED_LONG_LONG,
+                             communicator);
+    AssertThrowMPI(ierr);
+
+    const auto separators = [&](const unsigned int r) {
+      const unsigned long long next = r + 1 < n_ranks
+                                          ? data[2 * (r + 1)]
+                                          : mpi_ensemble_.n_ensemble_ranks();
+      std::string result;
+      for (auto k = data[2 * r]; k < next; ++k)
+        result += "# rank " + std::to_string(k) + "\n";
+      return result;
+    };
 
-      std::ofstream output(file_name);
-      output << std::scientific << std::setprecision(14);
-      output << time_stamp << "# " << header_;
-
-      unsigned int rank = 0;
-      for (const auto &entries : received) {
-        output << "# rank " << rank++ << "\n";
-        for (const auto &entry : entries) {
-          const auto &[state, state_square] = entry;
-          output << scale * state << "\t" << scale * state_square << "\n";
-        } /*entry*/
-      }   /*entries*/
-
-      output << std::flush;
-    }
+    /* Compute the file offset of every rank: */
+    unsigned long long offset = 0;
+    for (unsigned int r = 0; r < rank; ++r)
+      offset += data[2 * r + 1] + separators(r).size();
+
+    const auto rank_separators = separators(rank);
+    const auto first_separator = rank_separators.find('\n') + 1;
+    const std::string output = (rank == 0 ? header : std::string()) +
+                               rank_separators.substr(0, first_separator) +
+                               chunk + rank_separators.substr(first_separator);
+
+    MPI_File file;
+    ierr = MPI_File_open(communicator,
+                         file_name.c_str(),
+                         MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                         MPI_INFO_NULL,
+                         &file);
+    AssertThrowMPI(ierr);
+
+    ierr = MPI_File_set_size(file, 0);
+    AssertThrowMPI(ierr);
+
+    ierr = MPI_File_write_at_all(file,
+                                 offset,
+                                 output.data(),
+                                 output.size(),
+                                 MPI_CHAR,
+                                 MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+
+    ierr = MPI_File_close(&file);
+    AssertThrowMPI(ierr);
   }
 
 
@@ -472,28 +837,101 @@ namespace ryujin
       const std::vector<std::tuple<Number, value_type>> &values,
       bool append)
   {
-    if (Utilities::MPI::this_mpi_process(
-            mpi_ensemble_.ensemble_communicator()) == 0) {
-      std::ofstream output;
-      output << std::scientific << std::setprecision(14);
+    /* No MPI calls here, the function might run on a background thread: */
+    if (mpi_ensemble_.ensemble_rank() != 0)
+      return;
 
+    if (time_series_format_ == TimeSeriesFormat::binary) {
+      std::ofstream output;
       if (append) {
-        output.open(file_name, std::ofstream::out | std::ofstream::app);
+        output.open(file_name, std::ios::binary | std::ios::app);
       } else {
-        output.open(file_name, std::ofstream::out | std::ofstream::trunc);
-        output << "# time t\t" << header_;
+        output.open(file_name, std::ios::binary | std::ios::trunc);
+
+        const std::string header = "# time t\t" + header_;
+        const std::uint32_t metadata[4] = {
+            1 /* version */,
+            1 + 2 * problem_dimension /* columns */,
+            sizeof(Number),
+            static_cast<std::uint32_t>(header.size())};
+        output.write("RYUJINTS", 8);
+        output.write(reinterpret_cast<const char *>(metadata),
+                     4 * sizeof(std::uint32_t));
+        output.write(header.data(), header.size());
       }
 
+      /* Pack all records into a single buffer: */
+      std::vector<Number> buffer;
+      buffer.reserve(values.size() * (1 + 2 * problem_dimension));
       for (const auto &entry : values) {
-        const auto t = std::get<0>(entry);
+        buffer.push_back(std::get<0>(entry));
         const auto &[state, state_square] = std::get<1>(entry);
-
-        output << t << "\t" << state << "\t" << state_square << "\n";
+        for (unsigned int k = 0; k < problem_dimension; ++k)
+          buffer.push_back(state[k]);
+        for (unsigned int k = 0; k < problem_dimension; ++k)
+          buffer.push_back(state_square[k]);
       }
 
-      output << std::flush;
-      output.close();
+      output.write(reinterpret_cast<const char *>(buffer.data()),
+                   buffer.size() * sizeof(Number));
+      return;
+    }
+
+    std::ofstream output;
+    output << std::scientific << std::setprecision(14);
+
+    if (append) {
+      output.open(file_name, std::ofstream::out | std::ofstream::app);
+    } else {
+      output.open(file_name, std::ofstream::out | std::ofstream::trunc);
+      output << "# time t\t" << header_;
     }
+
+    for (const auto &entry : values) {
+      const auto t = std::get<0>(entry);
+      const auto &[state, state_square] = std::get<1>(entry);
+
+      output << t << "\t" << state << "\t" << state_square << "\n";
+    }
+
+    output << std::flush;
+    output.close();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::convert_time_series(
+      std::istream &input, std::ostream &output)
+  {
+    char magic[8];
+    std::uint32_t metadata[4];
+    input.read(magic, 8);
+    input.read(reinterpret_cast<char *>(metadata), 4 * sizeof(std::uint32_t));
+
+    AssertThrow(input && std::string(magic, 8) == "RYUJINTS" &&
+                    metadata[0] == 1 &&
+                    metadata[1] == 1 + 2 * problem_dimension &&
+                    metadata[2] == sizeof(Number),
+                dealii::ExcMessage("Not a binary time series with matching "
+                                   "version, column count, and precision"));
+
+    std::string header(metadata[3], '\0');
+    input.read(header.data(), header.size());
+    output << header;
+
+    /* Same layout as internal_write_out_time_series() in text format: */
+    output << std::scientific << std::setprecision(14);
+
+    std::vector<Number> record(metadata[1]);
+    while (input.read(reinterpret_cast<char *>(record.data()),
+                      record.size() * sizeof(Number))) {
+      output << record[0];
+      for (unsigned int k = 0; k < 2 * problem_dimension; ++k)
+        output << (k % problem_dimension == 0 ? "\t" : " ") << record[1 + k];
+      output << "\n";
+    }
+
+    output << std::flush;
   }
 
 
@@ -541,13 +979,30 @@ namespace ryujin
 
           t_new = t;
           const Number tau = t_new - t_old;
+          const Number half_tau = Number(0.5) * tau;
 
-          for (std::size_t i = 0; i < val_sum.size(); ++i) {
-            std::get<0>(val_sum[i]) += 0.5 * tau * std::get<0>(val_old[i]);
-            std::get<0>(val_sum[i]) += 0.5 * tau * std::get<0>(val_new[i]);
-            std::get<1>(val_sum[i]) += 0.5 * tau * std::get<1>(val_old[i]);
-            std::get<1>(val_sum[i]) += 0.5 * tau * std::get<1>(val_new[i]);
+          /*
+           * Not all supported compilers allow to reference structured
+           * bindings within OpenMP regions, use plain references instead:
+           */
+          const auto &values_old = val_old;
+          const auto &values_new = val_new;
+          auto &values_sum = val_sum;
+          const unsigned int n_entries = values_sum.size();
+
+          RYUJIN_PARALLEL_REGION_BEGIN
+
+          RYUJIN_OMP_FOR
+          for (unsigned int i = 0; i < n_entries; ++i) {
+            auto &[sum, sum_square] = values_sum[i];
+            const auto &[state_old, state_square_old] = values_old[i];
+            const auto &[state_new, state_square_new] = values_new[i];
+            sum += half_tau * (state_old + state_new);
+            sum_square += half_tau * (state_square_old + state_square_new);
           }
+
+          RYUJIN_PARALLEL_REGION_END
+
           t_sum += tau;
         }
 
@@ -565,6 +1020,11 @@ namespace ryujin
                boundary_manifolds_,
                boundary_statistics_,
                boundary_time_series_);
+
+    accumulate(probe_maps_,
+               point_probes_,
+               probe_statistics_,
+               probe_time_series_);
   }
 
 
@@ -576,6 +1036,12 @@ namespace ryujin
     std::cout << "Quantities<dim, Number>::write_out()" << std::endl;
 #endif
 
+    /* Wait for the previous writeback to preserve the order of appends: */
+    if (pending_writeback_.valid())
+      pending_writeback_.get();
+
+    std::vector<std::function<void()>> writeback_tasks;
+
     /*
      * First, write out mesh files if this hasn't happened yet.
      */
@@ -590,6 +1056,7 @@ namespace ryujin
      */
 
     const auto write_out = [&](const auto &point_maps,
+                               const auto &communicators,
                                const auto &manifolds,
                                auto &statistics,
                                auto &time_series) {
@@ -624,7 +1091,11 @@ namespace ryujin
           else
             AssertThrow(t_new == t, dealii::ExcInternalError());
 
-          internal_write_out(file_name, time_stamp.str(), val_new, Number(1.));
+          internal_write_out(file_name,
+                             time_stamp.str(),
+                             val_new,
+                             Number(1.),
+                             communicators.at(name));
         }
 
         /*
@@ -645,8 +1116,11 @@ namespace ryujin
             time_stamp << "# averaged from t = " << t_new - t_sum
                        << " to t = " << t_new << std::endl;
 
-            internal_write_out(
-                file_name, time_stamp.str(), val_sum, Number(1.) / t_sum);
+            internal_write_out(file_name,
+                               time_stamp.str(),
+                               val_sum,
+                               Number(1.) / t_sum,
+                               communicators.at(name));
           }
         }
 
@@ -664,25 +1138,49 @@ namespace ryujin
           const auto file_name =
               base_name_ + "-" + name + "-R" +
               Utilities::to_string(time_series_cycle_.value(), 4) +
-              "-space_averaged_time_series.dat";
+              "-space_averaged_time_series" +
+              (time_series_format_ == TimeSeriesFormat::binary ? ".bin"
+                                                               : ".dat");
 
           auto &series = time_series[name];
-          internal_write_out_time_series(file_name, series, /*append*/ append);
+          if (asynchronous_writeback_ && mpi_ensemble_.ensemble_rank() == 0)
+            writeback_tasks.emplace_back(
+                [this, file_name, append, series = std::move(series)]() {
+                  internal_write_out_time_series(file_name, series, append);
+                });
+          else
+            internal_write_out_time_series(
+                file_name, series, /*append*/ append);
           series.clear();
         }
       }
     };
 
     write_out(interior_maps_,
+              interior_communicators_,
               interior_manifolds_,
               interior_statistics_,
               interior_time_series_);
 
     write_out(boundary_maps_,
+              boundary_communicators_,
               boundary_manifolds_,
               boundary_statistics_,
               boundary_time_series_);
 
+    write_out(probe_maps_,
+              probe_communicators_,
+              point_probes_,
+              probe_statistics_,
+              probe_time_series_);
+
+    if (!writeback_tasks.empty())
+      pending_writeback_ = std::async(
+          std::launch::async, [tasks = std::move(writeback_tasks)]() {
+            for (const auto &task : tasks)
+              task();
+          });
+
     if (clear_temporal_statistics_on_writeout_)
       clear_statistics();
   }
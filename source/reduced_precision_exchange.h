@@ -0,0 +1,120 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/partitioner.h>
+
+#include <vector>
+
+namespace ryujin
+{
+  namespace Vectors
+  {
+    /**
+     * A ghost exchange for (distributed) vectors with value type
+     * @p Number that transfers the values over MPI in the (lower)
+     * precision @p TransferNumber. This halves the message size of the
+     * exchange of auxiliary quantities of a double precision computation,
+     * such as the indicator values alpha_i or the limiter bounds.
+     *
+     * In order to keep the locally owned values and their ghost copies on
+     * other MPI ranks bitwise identical, the exported locally owned values
+     * are rounded to @p TransferNumber in place. It is thus the task of the
+     * caller to ensure that rounding is admissible. For example, bounds
+     * have to be widened prior to the exchange so that rounding never
+     * tightens them.
+     *
+     * Usage:
+     * @code
+     * ReducedPrecisionExchange<double> exchange;
+     * exchange.update_ghost_values_start(alpha, channel);
+     * // ...
+     * exchange.update_ghost_values_finish(alpha);
+     * @endcode
+     *
+     * @ingroup SIMD
+     */
+    template <typename Number, typename TransferNumber = float>
+    class ReducedPrecisionExchange
+    {
+    public:
+      /**
+       * Round all exported locally owned values of @p vector to
+       * @p TransferNumber and start the ghost exchange over the
+       * communication channel @p communication_channel. The @p Vector
+       * type has to be a dealii::LinearAlgebra::distributed::Vector with
+       * value type @p Number (or a MultiComponentVector).
+       */
+      template <typename Vector>
+      void update_ghost_values_start(Vector &vector,
+                                     const unsigned int communication_channel)
+      {
+        const auto &partitioner = *vector.get_partitioner();
+        const unsigned int n_owned = partitioner.locally_owned_size();
+
+        owned_values_.resize_fast(n_owned);
+        import_data_.resize_fast(partitioner.n_import_indices());
+        ghost_values_.resize_fast(partitioner.n_ghost_indices());
+
+        /*
+         * Only the exported entries of the locally owned array are read by
+         * export_to_ghosted_array_start(), we thus only convert these:
+         */
+        Number *values = vector.begin();
+        for (const auto &[begin, end] : partitioner.import_indices())
+          for (unsigned int i = begin; i < end; ++i) {
+            const auto value = TransferNumber(values[i]);
+            owned_values_[i] = value;
+            values[i] = Number(value);
+          }
+
+        partitioner.template export_to_ghosted_array_start<TransferNumber>(
+            communication_channel,
+            dealii::ArrayView<const TransferNumber>(owned_values_.data(),
+                                                    n_owned),
+            dealii::make_array_view(import_data_),
+            dealii::make_array_view(ghost_values_),
+            requests_);
+      }
+
+      /**
+       * Complete a ghost exchange started with
+       * update_ghost_values_start() and store the received values in the
+       * ghost range of @p vector.
+       */
+      template <typename Vector>
+      void update_ghost_values_finish(Vector &vector)
+      {
+        const auto &partitioner = *vector.get_partitioner();
+        const unsigned int n_owned = partitioner.locally_owned_size();
+
+        partitioner.export_to_ghosted_array_finish(
+            dealii::make_array_view(ghost_values_), requests_);
+
+        Number *values = vector.begin() + n_owned;
+        for (unsigned int i = 0; i < ghost_values_.size(); ++i)
+          values[i] = Number(ghost_values_[i]);
+
+        /*
+         * Mark the vector as ghosted, so that copies of the vector carry
+         * the ghost values along:
+         */
+        vector.set_ghost_state(true);
+      }
+
+    private:
+      dealii::AlignedVector<TransferNumber> owned_values_;
+      dealii::AlignedVector<TransferNumber> import_data_;
+      dealii::AlignedVector<TransferNumber> ghost_values_;
+      std::vector<MPI_Request> requests_;
+    };
+  } // namespace Vectors
+} // namespace ryujin
@@ -9,9 +9,11 @@
 
 #include "convenience_macros.h"
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/function.h>
 #include <deal.II/base/parameter_acceptor.h>
 
+#include <algorithm>
 #include <string>
 
 namespace ryujin
@@ -51,6 +53,24 @@ namespace ryujin
        */
       virtual double value(double state, unsigned int direction) const = 0;
 
+      /**
+       * Variant of above function operating on a contiguous range of
+       * states @p U. The result is stored in the first argument @p f,
+       * overriding previous contents.
+       */
+      virtual void value(const dealii::ArrayView<double> &f,
+                         const dealii::ArrayView<const double> &U,
+                         unsigned int direction) const
+      {
+        Assert(f.size() == U.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        std::transform(std::begin(U),
+                       std::end(U),
+                       std::begin(f),
+                       [&](double u) { return value(u, direction); });
+      }
+
 
       /**
        * Return the gradient f'(u) of the flux for the given state @p u and
@@ -58,6 +78,40 @@ namespace ryujin
        */
       virtual double gradient(double state, unsigned int direction) const = 0;
 
+      /**
+       * Variant of above function operating on a contiguous range of
+       * states @p U. The result is stored in the first argument @p df,
+       * overriding previous contents.
+       */
+      virtual void gradient(const dealii::ArrayView<double> &df,
+                            const dealii::ArrayView<const double> &U,
+                            unsigned int direction) const
+      {
+        Assert(df.size() == U.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        std::transform(std::begin(U),
+                       std::end(U),
+                       std::begin(df),
+                       [&](double u) { return gradient(u, direction); });
+      }
+
+      /**
+       * Compute lower and upper bounds @p df_min and @p df_max of the
+       * gradient f'(u) in direction @p direction over all states
+       * @p u_min <= u <= @p u_max. Returns false if no such bounds are
+       * available, in which case @p df_min and @p df_max are left
+       * unchanged. The default implementation always returns false.
+       */
+      virtual bool gradient_bounds(double /*u_min*/,
+                                   double /*u_max*/,
+                                   unsigned int /*direction*/,
+                                   double & /*df_min*/,
+                                   double & /*df_max*/) const
+      {
+        return false;
+      }
+
       /**
        * The name of the flux function
        */
@@ -7,11 +7,15 @@
 
 #include "flux.h"
 
+#include <compiled_expression.h>
+
 #include <deal.II/base/function_parser.h>
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <array>
+#include <bit>
 #include <numeric>
 
 namespace ryujin
@@ -26,6 +30,9 @@ namespace ryujin
     class Function : public Flux
     {
     public:
+      using Flux::gradient;
+      using Flux::value;
+
       Function(const std::string &subsection)
           : Flux("function", subsection)
       {
@@ -43,9 +50,34 @@ namespace ryujin
                       "Step size of the central difference quotient to compute "
                       "an approximation of the flux derivative");
 
+        tabulation_points_ = 0;
+        add_parameter(
+            "tabulation points",
+            tabulation_points_,
+            "If set to a value larger than zero, the flux and its derivative "
+            "are sampled once on the given number of equidistant points "
+            "between the tabulation lower and upper bound and subsequently "
+            "evaluated by piecewise cubic Hermite interpolation. States "
+            "outside of the tabulated range are evaluated exactly. Due to "
+            "the maximum principle it is sufficient to cover the range of "
+            "initial and boundary data.");
+
+        tabulation_lower_bound_ = 0.;
+        add_parameter("tabulation lower bound",
+                      tabulation_lower_bound_,
+                      "Lower bound of the tabulated range of states");
+
+        tabulation_upper_bound_ = 1.;
+        add_parameter("tabulation upper bound",
+                      tabulation_upper_bound_,
+                      "Upper bound of the tabulated range of states");
+
         /*
          * Set up the muparser object with the final flux description from
-         * the parameter file:
+         * the parameter file. In addition, we try to compile all
+         * components into a CompiledExpression object for batched
+         * evaluation. If any of the components uses syntax not supported
+         * by CompiledExpression we fall back to muparser:
          */
         const auto set_up_muparser = [this] {
           std::vector<std::string> split_expressions;
@@ -61,7 +93,15 @@ namespace ryujin
               size, 0.0, this->derivative_approximation_delta_);
           flux_function_->initialize({"u"}, split_expressions, {});
 
+          compiled_functions_.resize(size);
+          compiled_ = true;
+          for (unsigned int k = 0; k < size; ++k)
+            compiled_ &=
+                compiled_functions_[k].initialize(split_expressions[k], {"u"});
+
           flux_formula_ = "f(u)={" + expression_ + "}";
+
+          set_up_tabulation(size);
         };
 
         set_up_muparser();
@@ -72,21 +112,289 @@ namespace ryujin
       double value(const double state,
                    const unsigned int direction) const override
       {
+        unsigned int index;
+        double s;
+        if (tabulated_ && locate(state, index, s)) {
+          const auto &c = coefficients_[direction][index];
+          return c[0] + s * (c[1] + s * (c[2] + s * c[3]));
+        }
+
+        if (compiled_)
+          return compiled_functions_[direction].value({state});
+
         return flux_function_->value(dealii::Point<1>(state), direction);
       }
 
 
+      void value(const dealii::ArrayView<double> &f,
+                 const dealii::ArrayView<const double> &U,
+                 const unsigned int direction) const override
+      {
+        if (tabulated_) {
+          Assert(f.size() == U.size(),
+                 dealii::ExcMessage("vectors have different size"));
+
+          for (unsigned int i = 0; i < U.size(); ++i) {
+            unsigned int index;
+            double s;
+            if (!locate(U[i], index, s)) {
+              f[i] = value(U[i], direction);
+              continue;
+            }
+            const auto &c = coefficients_[direction][index];
+            f[i] = c[0] + s * (c[1] + s * (c[2] + s * c[3]));
+          }
+          return;
+        }
+
+        if (!compiled_) {
+          Flux::value(f, U, direction);
+          return;
+        }
+
+        Assert(f.size() == U.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        const double *variables[] = {U.data()};
+        compiled_functions_[direction].evaluate(f.data(), variables, U.size());
+      }
+
+
       double gradient(const double state,
                       const unsigned int direction) const override
       {
+        unsigned int index;
+        double s;
+        if (tabulated_ && locate(state, index, s)) {
+          const auto &c = coefficients_[direction][index];
+          return (c[1] + s * (2. * c[2] + s * 3. * c[3])) * inverse_spacing_;
+        }
+
+        if (compiled_) {
+          /* Same central difference quotient as dealii::FunctionParser: */
+          const double h = this->derivative_approximation_delta_;
+          const auto &function = compiled_functions_[direction];
+          return (function.value({state + h}) - function.value({state - h})) /
+                 (2. * h);
+        }
+
         return flux_function_->gradient(dealii::Point<1>(state), direction)[0];
       }
 
 
+      void gradient(const dealii::ArrayView<double> &df,
+                    const dealii::ArrayView<const double> &U,
+                    const unsigned int direction) const override
+      {
+        if (tabulated_) {
+          Assert(df.size() == U.size(),
+                 dealii::ExcMessage("vectors have different size"));
+
+          for (unsigned int i = 0; i < U.size(); ++i) {
+            unsigned int index;
+            double s;
+            if (!locate(U[i], index, s)) {
+              df[i] = gradient(U[i], direction);
+              continue;
+            }
+            const auto &c = coefficients_[direction][index];
+            df[i] = (c[1] + s * (2. * c[2] + s * 3. * c[3])) * inverse_spacing_;
+          }
+          return;
+        }
+
+        if (!compiled_) {
+          Flux::gradient(df, U, direction);
+          return;
+        }
+
+        Assert(df.size() == U.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        const double h = this->derivative_approximation_delta_;
+        const auto &function = compiled_functions_[direction];
+
+        constexpr auto batch_size = CompiledExpression::batch_size;
+        std::array<double, batch_size> U_plus, U_minus, f_plus, f_minus;
+        const double *variables_plus[] = {U_plus.data()};
+        const double *variables_minus[] = {U_minus.data()};
+
+        for (unsigned int offset = 0; offset < U.size(); offset += batch_size) {
+          const unsigned int n = std::min<unsigned int>(batch_size,
+                                                        U.size() - offset);
+          for (unsigned int i = 0; i < n; ++i) {
+            U_plus[i] = U[offset + i] + h;
+            U_minus[i] = U[offset + i] - h;
+          }
+          function.evaluate(f_plus.data(), variables_plus, n);
+          function.evaluate(f_minus.data(), variables_minus, n);
+          for (unsigned int i = 0; i < n; ++i)
+            df[offset + i] = (f_plus[i] - f_minus[i]) / (2. * h);
+        }
+      }
+
+
+      /**
+       * If the flux is tabulated, the bounds are given by the extrema of
+       * the derivative of the cubic Hermite interpolant over all
+       * intervals covering [u_min, u_max], which are precomputed in
+       * set_up_tabulation() and queried from a sparse table in constant
+       * time.
+       */
+      bool gradient_bounds(const double u_min,
+                           const double u_max,
+                           const unsigned int direction,
+                           double &df_min,
+                           double &df_max) const override
+      {
+        unsigned int first, last;
+        double s;
+        if (!tabulated_ || !locate(u_min, first, s) || !locate(u_max, last, s))
+          return false;
+
+        if (first > last)
+          std::swap(first, last);
+
+        /* Two overlapping ranges of length 2^level cover [first, last]: */
+        const unsigned int level = std::bit_width(last - first + 1) - 1;
+        const auto &table = gradient_bounds_[direction][level];
+        const auto &left = table[first];
+        const auto &right = table[last + 1 - (1u << level)];
+
+        df_min = std::min(left[0], right[0]);
+        df_max = std::max(left[1], right[1]);
+        return true;
+      }
+
     private:
+      /**
+       * Sample the flux and its derivative on the tabulation points and
+       * set up the coefficients of the cubic Hermite interpolant
+       * \f$c_0 + c_1 s + c_2 s^2 + c_3 s^3\f$ on every interval in terms
+       * of the local coordinate \f$s\in[0,1]\f$.
+       */
+      void set_up_tabulation(const unsigned int n_components)
+      {
+        tabulated_ = false;
+        coefficients_.clear();
+        gradient_bounds_.clear();
+
+        if (tabulation_points_ == 0)
+          return;
+
+        AssertThrow(tabulation_points_ >= 2 &&
+                        tabulation_upper_bound_ > tabulation_lower_bound_,
+                    dealii::ExcMessage("The tabulated range must consist of "
+                                       "at least two points and the upper "
+                                       "bound must be larger than the lower "
+                                       "bound"));
+
+        n_intervals_ = tabulation_points_ - 1;
+        const double h =
+            (tabulation_upper_bound_ - tabulation_lower_bound_) / n_intervals_;
+        inverse_spacing_ = 1. / h;
+
+        coefficients_.resize(n_components);
+        for (unsigned int k = 0; k < n_components; ++k) {
+          coefficients_[k].resize(n_intervals_);
+
+          double u_0 = tabulation_lower_bound_;
+          double f_0 = value(u_0, k);
+          double df_0 = h * gradient(u_0, k);
+
+          for (unsigned int i = 0; i < n_intervals_; ++i) {
+            const double u_1 = tabulation_lower_bound_ + (i + 1) * h;
+            const double f_1 = value(u_1, k);
+            const double df_1 = h * gradient(u_1, k);
+
+            coefficients_[k][i] = {f_0,
+                                   df_0,
+                                   3. * (f_1 - f_0) - 2. * df_0 - df_1,
+                                   2. * (f_0 - f_1) + df_0 + df_1};
+
+            f_0 = f_1;
+            df_0 = df_1;
+          }
+        }
+
+        /*
+         * Set up a sparse table of the extrema of the derivative
+         * (c_1 + 2 c_2 s + 3 c_3 s^2) / h over ranges of 2^level
+         * consecutive intervals:
+         */
+        const unsigned int n_levels = std::bit_width(n_intervals_);
+        gradient_bounds_.resize(n_components);
+        for (unsigned int k = 0; k < n_components; ++k) {
+          auto &tables = gradient_bounds_[k];
+          tables.resize(n_levels);
+
+          tables[0].resize(n_intervals_);
+          for (unsigned int i = 0; i < n_intervals_; ++i) {
+            const auto &c = coefficients_[k][i];
+            const auto derivative = [&](const double s) {
+              return (c[1] + s * (2. * c[2] + s * 3. * c[3])) *
+                     inverse_spacing_;
+            };
+
+            double df_min = std::min(derivative(0.), derivative(1.));
+            double df_max = std::max(derivative(0.), derivative(1.));
+            if (c[3] != 0.) {
+              /* Interior extremum of the quadratic: */
+              const double s_0 = -c[2] / (3. * c[3]);
+              if (s_0 > 0. && s_0 < 1.) {
+                df_min = std::min(df_min, derivative(s_0));
+                df_max = std::max(df_max, derivative(s_0));
+              }
+            }
+            tables[0][i] = {df_min, df_max};
+          }
+
+          for (unsigned int level = 1; level < n_levels; ++level) {
+            const unsigned int width = 1u << (level - 1);
+            const auto &previous = tables[level - 1];
+            auto &table = tables[level];
+            table.resize(n_intervals_ + 1 - 2 * width);
+            for (unsigned int i = 0; i < table.size(); ++i)
+              table[i] = {std::min(previous[i][0], previous[i + width][0]),
+                          std::max(previous[i][1], previous[i + width][1])};
+          }
+        }
+
+        tabulated_ = true;
+      }
+
+      /**
+       * Locate @p state in the tabulated range. Returns false if the state
+       * lies outside. Otherwise @p index is set to the interval and @p s
+       * to the local coordinate within the interval.
+       */
+      bool locate(const double state, unsigned int &index, double &s) const
+      {
+        const double x = (state - tabulation_lower_bound_) * inverse_spacing_;
+        if (!(x >= 0. && x <= n_intervals_))
+          return false;
+
+        index = std::min(static_cast<unsigned int>(x), n_intervals_ - 1);
+        s = x - index;
+        return true;
+      }
+
       std::string expression_;
+      unsigned int tabulation_points_;
+      double tabulation_lower_bound_;
+      double tabulation_upper_bound_;
 
       std::unique_ptr<dealii::FunctionParser<1>> flux_function_;
+
+      bool compiled_;
+      std::vector<CompiledExpression> compiled_functions_;
+
+      bool tabulated_ = false;
+      unsigned int n_intervals_;
+      double inverse_spacing_;
+      std::vector<std::vector<std::array<double, 4>>> coefficients_;
+      std::vector<std::vector<std::vector<std::array<double, 2>>>>
+          gradient_bounds_;
     };
   } // namespace FluxLibrary
 } // namespace ryujin
@@ -143,6 +143,18 @@ namespace ryujin
       DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, dim, Number>
       flux_gradient_function(const Number &u) const;
 
+      /**
+       * For two states \f$u_i\f$, \f$u_j\f$ and a direction \f$n_{ij}\f$
+       * return an upper bound of \f$|f'(u)\cdot n_{ij}|\f$ over all
+       * states \f$u\f$ between \f$u_i\f$ and \f$u_j\f$, see
+       * FluxLibrary::Flux::gradient_bounds(). The bound is zero for all
+       * (SIMD) lanes for which the flux provides no gradient bounds.
+       */
+      DEAL_II_ALWAYS_INLINE inline Number
+      flux_gradient_bound(const Number &u_i,
+                          const Number &u_j,
+                          const dealii::Tensor<1, dim, Number> &n_ij) const;
+
       //@}
       /**
        * @name Internal data
@@ -218,6 +230,19 @@ namespace ryujin
         __builtin_trap();
       }();
 
+      /**
+       * The components of the precomputed values that are read at
+       * neighboring degrees of freedom: the flux f and its derivative df
+       * are both needed by the RiemannSolver and the Indicator, thus all
+       * components are exchanged over MPI ranks.
+       */
+      static constexpr auto precomputed_ghost_components = []() {
+        std::array<unsigned int, n_precomputed_values> result{};
+        for (unsigned int k = 0; k < n_precomputed_values; ++k)
+          result[k] = k;
+        return result;
+      }();
+
       /**
        * The number of precomputed initial values.
        */
@@ -447,6 +472,9 @@ namespace ryujin
                               const state_type &U_j,
                               const ScalarNumber tau) const = delete;
 
+      /** We do not have implicit source terms */
+      static constexpr bool have_implicit_source_terms = false;
+
       //@}
       /**
        * @name State transformations
@@ -556,14 +584,23 @@ namespace ryujin
       const auto &flux = hyperbolic_system_.selected_flux_;
       dealii::Tensor<1, dim, Number> result;
 
-      /* This access by calling into value() repeatedly is terrible: */
-      for (unsigned int k = 0; k < dim; ++k) {
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
+      if constexpr (std::is_same_v<ScalarNumber, Number>) {
+        for (unsigned int k = 0; k < dim; ++k)
           result[k] = flux->value(u, k);
-        } else {
-          for (unsigned int s = 0; s < Number::size(); ++s) {
-            result[k][s] = flux->value(u[s], k);
-          }
+      } else {
+        /* Gather all SIMD lanes and evaluate them in a single call: */
+        std::array<double, Number::size()> states;
+        std::array<double, Number::size()> values;
+        for (unsigned int s = 0; s < Number::size(); ++s)
+          states[s] = u[s];
+
+        const dealii::ArrayView<const double> U(states.data(), states.size());
+        const dealii::ArrayView<double> f(values.data(), values.size());
+
+        for (unsigned int k = 0; k < dim; ++k) {
+          flux->value(f, U, k);
+          for (unsigned int s = 0; s < Number::size(); ++s)
+            result[k][s] = values[s];
         }
       }
 
@@ -579,14 +616,23 @@ namespace ryujin
       const auto &flux = hyperbolic_system_.selected_flux_;
       dealii::Tensor<1, dim, Number> result;
 
-      /* This access by calling into value() repeatedly is terrible: */
-      for (unsigned int k = 0; k < dim; ++k) {
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
+      if constexpr (std::is_same_v<ScalarNumber, Number>) {
+        for (unsigned int k = 0; k < dim; ++k)
           result[k] = flux->gradient(u, k);
-        } else {
-          for (unsigned int s = 0; s < Number::size(); ++s) {
-            result[k][s] = flux->gradient(u[s], k);
-          }
+      } else {
+        /* Gather all SIMD lanes and evaluate them in a single call: */
+        std::array<double, Number::size()> states;
+        std::array<double, Number::size()> values;
+        for (unsigned int s = 0; s < Number::size(); ++s)
+          states[s] = u[s];
+
+        const dealii::ArrayView<const double> U(states.data(), states.size());
+        const dealii::ArrayView<double> f(values.data(), values.size());
+
+        for (unsigned int k = 0; k < dim; ++k) {
+          flux->gradient(f, U, k);
+          for (unsigned int s = 0; s < Number::size(); ++s)
+            result[k][s] = values[s];
         }
       }
 
@@ -594,6 +640,51 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline Number
+    HyperbolicSystemView<dim, Number>::flux_gradient_bound(
+        const Number &u_i,
+        const Number &u_j,
+        const dealii::Tensor<1, dim, Number> &n_ij) const
+    {
+      const auto &flux = hyperbolic_system_.selected_flux_;
+
+      /* Bound the range of f'(u) * n_ij component by component: */
+      const auto bound = [&](const double a,
+                             const double b,
+                             const std::array<double, dim> &n) {
+        double lower = 0.;
+        double upper = 0.;
+        for (unsigned int k = 0; k < dim; ++k) {
+          double df_min, df_max;
+          if (!flux->gradient_bounds(
+                  std::min(a, b), std::max(a, b), k, df_min, df_max))
+            return 0.;
+          lower += std::min(n[k] * df_min, n[k] * df_max);
+          upper += std::max(n[k] * df_min, n[k] * df_max);
+        }
+        return std::max(std::abs(lower), std::abs(upper));
+      };
+
+      if constexpr (std::is_same_v<ScalarNumber, Number>) {
+        std::array<double, dim> n;
+        for (unsigned int k = 0; k < dim; ++k)
+          n[k] = n_ij[k];
+        return Number(bound(u_i, u_j, n));
+
+      } else {
+        Number result;
+        for (unsigned int s = 0; s < Number::size(); ++s) {
+          std::array<double, dim> n;
+          for (unsigned int k = 0; k < dim; ++k)
+            n[k] = n_ij[k][s];
+          result[s] = bound(u_i[s], u_j[s], n);
+        }
+        return result;
+      }
+    }
+
+
     template <int dim, typename Number>
     template <typename DISPATCH, typename SPARSITY>
     DEAL_II_ALWAYS_INLINE inline void
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "hyperbolic_system.h"
+#include <compiled_expression.h>
 #include <initial_state_library.h>
 
 #include <deal.II/base/function_parser.h>
@@ -25,6 +26,8 @@ namespace ryujin
     class Function : public InitialState<Description, dim, Number>
     {
     public:
+      using InitialState<Description, dim, Number>::compute;
+
       using View = HyperbolicSystemView<dim, Number>;
       using state_type = typename View::state_type;
 
@@ -40,7 +43,8 @@ namespace ryujin
 
         /*
          * Set up the muparser object with the final flux description from
-         * the parameter file:
+         * the parameter file. If possible, we also compile the expressions
+         * into CompiledExpression objects that are used instead:
          */
         const auto set_up_muparser = [this] {
           /*
@@ -50,6 +54,12 @@ namespace ryujin
            */
           function_ =
               std::make_unique<dealii::FunctionParser<dim>>(expression_);
+
+          compiled_ = compiled_function_.initialize(
+              expression_, CompiledExpression::coordinate_variables<dim>());
+
+          /* Only the compiled expression can be evaluated concurrently: */
+          this->thread_safe_ = compiled_;
         };
 
         set_up_muparser();
@@ -58,17 +68,50 @@ namespace ryujin
 
       state_type compute(const dealii::Point<dim> &point, Number t) final
       {
-        function_->set_time(t);
         state_type result;
-        result[0] = function_->value(point);
+        if (compiled_) {
+          result[0] = compiled_function_.value(point, t);
+        } else {
+          function_->set_time(t);
+          result[0] = function_->value(point);
+        }
         return result;
       }
 
+      void compute(const dealii::ArrayView<state_type> &states,
+                   const dealii::ArrayView<const dealii::Point<dim>> &points,
+                   Number t) final
+      {
+        if (!compiled_) {
+          InitialState<Description, dim, Number>::compute(states, points, t);
+          return;
+        }
+
+        constexpr auto batch_size = CompiledExpression::batch_size;
+        std::array<double, batch_size> values;
+
+        for (unsigned int offset = 0; offset < points.size();
+             offset += batch_size) {
+          const unsigned int n = std::min<unsigned int>(
+              batch_size, points.size() - offset);
+          compiled_function_.evaluate(
+              values.data(),
+              dealii::ArrayView<const dealii::Point<dim>>(
+                  points.data() + offset, n),
+              t);
+          for (unsigned int k = 0; k < n; ++k)
+            states[offset + k][0] = values[k];
+        }
+      }
+
     private:
       const HyperbolicSystem &hyperbolic_system;
 
       std::string expression_;
       std::unique_ptr<dealii::FunctionParser<dim>> function_;
+
+      bool compiled_;
+      CompiledExpression compiled_function_;
     };
   } // namespace ScalarConservation
 } // namespace ryujin
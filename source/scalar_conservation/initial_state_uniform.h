@@ -31,6 +31,8 @@ namespace ryujin
           : InitialState<Description, dim, Number>("uniform", subsection)
           , hyperbolic_system(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         primitive_[0] = 1.0;
         this->add_parameter(
             "primitive state", primitive_, "Initial 1d primitive state");
@@ -48,16 +48,30 @@ namespace ryujin
             "flux gradients of the left and right state also enforce an "
             "entropy "
             "inequality on the prescribed number of random Krŭzkov entropies.");
+
+        use_gradient_bounds_ = false;
+        add_parameter(
+            "use gradient bounds",
+            use_gradient_bounds_,
+            "If enabled (and \"use greedy wavespeed\" is disabled) the "
+            "wavespeed estimate is additionally bounded from below by the "
+            "maximum of |f'(u) n_ij| over all states u between u_i and u_j. "
+            "This guarantees an upper bound on the maximal wavespeed also "
+            "for nonconvex fluxes. The bounds are only available for a "
+            "tabulated \"function\" flux and states within the tabulated "
+            "range.");
       }
 
       ACCESSOR_READ_ONLY(use_greedy_wavespeed);
       ACCESSOR_READ_ONLY(use_averaged_entropy);
       ACCESSOR_READ_ONLY(random_entropies);
+      ACCESSOR_READ_ONLY(use_gradient_bounds);
 
     private:
       bool use_greedy_wavespeed_;
       bool use_averaged_entropy_;
       unsigned int random_entropies_;
+      bool use_gradient_bounds_;
     };
 
 
@@ -134,6 +148,17 @@ namespace ryujin
                      const unsigned int *js,
                      const dealii::Tensor<1, dim, Number> &n_ij) const;
 
+      /**
+       * Variant of above function for a (SIMD vectorized) state U_i that
+       * is associated with individual indices @p is instead of a
+       * contiguous range of indices starting at i.
+       */
+      Number compute(const state_type &U_i,
+                     const state_type &U_j,
+                     const unsigned int *is,
+                     const unsigned int *js,
+                     const dealii::Tensor<1, dim, Number> &n_ij) const;
+
     private:
       const HyperbolicSystem &hyperbolic_system;
       const Parameters &parameters;
@@ -99,6 +99,19 @@ namespace ryujin
         std::cout << "   left  derivative  = " << std::abs(df_i) << std::endl;
         std::cout << "   right derivative  = " << std::abs(df_j) << std::endl;
 #endif
+
+        /*
+         * For nonconvex fluxes the maximum of |f'(u)| might be attained
+         * in the interior of [u_i, u_j]. Use precomputed bounds (if
+         * available):
+         */
+        if (parameters.use_gradient_bounds()) {
+          const auto df_max = view.flux_gradient_bound(u_i, u_j, n_ij);
+          lambda_max = std::max(lambda_max, df_max);
+#ifdef DEBUG_RIEMANN_SOLVER
+          std::cout << "   gradient bound    = " << df_max << std::endl;
+#endif
+        }
       }
 
       /*
@@ -214,5 +227,28 @@ namespace ryujin
       return compute(u_i, u_j, prec_i, prec_j, n_ij);
     }
 
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline Number RiemannSolver<dim, Number>::compute(
+        const state_type &U_i,
+        const state_type &U_j,
+        const unsigned int *is,
+        const unsigned int *js,
+        const dealii::Tensor<1, dim, Number> &n_ij) const
+    {
+      const auto view = hyperbolic_system.view<dim, Number>();
+
+      using pst = typename View::precomputed_type;
+
+      const auto u_i = view.state(U_i);
+      const auto u_j = view.state(U_j);
+
+      const auto &pv = precomputed_values;
+      const auto prec_i = pv.template get_tensor<Number, pst>(is);
+      const auto prec_j = pv.template get_tensor<Number, pst>(js);
+
+      return compute(u_i, u_j, prec_i, prec_j, n_ij);
+    }
+
   } // namespace ScalarConservation
 } // namespace ryujin
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <compile_time_options.h>
+
+#include "hardware_counters.h"
+#include "timeline_tracer.h"
+
 #include <deal.II/base/timer.h>
 
 #include <map>
@@ -16,7 +21,10 @@ namespace ryujin
    * A RAII scope for deal.II timer objects.
    *
    * This class does not perform MPI synchronization in contrast to the
-   * deal.II counterpart.
+   * deal.II counterpart. If ryujin is configured with WITH_PERF_EVENT the
+   * class also accumulates hardware counters for the section, see
+   * HardwareCounters. If configured with TIMELINE_TRACING the begin and
+   * end of the section is recorded by the TimelineTracer.
    *
    * @ingroup Miscellaneous
    */
@@ -25,15 +33,29 @@ namespace ryujin
   public:
     /**
      * Constructor. Starts a timer for the selected @p section.
+     *
+     * The section name and the timer are resolved once in the
+     * constructor. The name is not copied but referenced from the key of
+     * the timer map, so that a Scope does not allocate memory once the
+     * section has been created.
      */
     Scope(std::map<std::string, dealii::Timer> &computing_timer,
           const std::string &section)
-        : computing_timer_(computing_timer)
-        , section_(section)
     {
-      computing_timer_[section_].start();
+      const auto it = computing_timer.try_emplace(section).first;
+      section_ = &it->first;
+      timer_ = &it->second;
+
+#ifdef TIMELINE_TRACING
+      begin_ = TimelineTracer::instance().now();
+#endif
+      timer_->start();
+#ifdef WITH_PERF_EVENT
+      HardwareCounters::instance().start(*section_);
+#endif
 #ifdef DEBUG_OUTPUT
-      std::cout << "{scoped timer} \"" << section_ << "\" started" << std::endl;
+      std::cout << "{scoped timer} \"" << *section_ << "\" started"
+                << std::endl;
 #endif
     }
 
@@ -43,13 +65,23 @@ namespace ryujin
     ~Scope()
     {
 #ifdef DEBUG_OUTPUT
-      std::cout << "{scoped timer} \"" << section_ << "\" stopped" << std::endl;
+      std::cout << "{scoped timer} \"" << *section_ << "\" stopped"
+                << std::endl;
+#endif
+#ifdef WITH_PERF_EVENT
+      HardwareCounters::instance().stop(*section_);
+#endif
+      timer_->stop();
+#ifdef TIMELINE_TRACING
+      TimelineTracer::instance().record(section_->c_str(), begin_);
 #endif
-      computing_timer_[section_].stop();
     }
 
   private:
-    std::map<std::string, dealii::Timer> &computing_timer_;
-    const std::string section_;
+    const std::string *section_;
+    dealii::Timer *timer_;
+#ifdef TIMELINE_TRACING
+    TimelineTracer::clock::time_point begin_;
+#endif
   };
 } // namespace ryujin
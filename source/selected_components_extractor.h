@@ -48,7 +48,7 @@ namespace ryujin
     extract(const HyperbolicSystem &hyperbolic_system,
             const StateVector &state_vector,
             const InitialPrecomputedVector &initial_precomputed,
-            const ScalarVector &alpha,
+            const Vectors::IndicatorVector<Number> &alpha,
             const std::vector<std::string> &selected)
     {
       /*
@@ -69,6 +69,7 @@ namespace ryujin
       //@{
       double gravity_;
       double manning_friction_coefficient_;
+      bool implicit_manning_friction_;
 
       double reference_water_depth_;
       double dry_state_relaxation_small_;
@@ -139,6 +140,11 @@ namespace ryujin
         return hyperbolic_system_.manning_friction_coefficient_;
       }
 
+      DEAL_II_ALWAYS_INLINE inline bool implicit_manning_friction() const
+      {
+        return hyperbolic_system_.implicit_manning_friction_;
+      }
+
       DEAL_II_ALWAYS_INLINE inline ScalarNumber reference_water_depth() const
       {
         return hyperbolic_system_.reference_water_depth_;
@@ -239,6 +245,15 @@ namespace ryujin
       static inline const auto precomputed_names =
           std::array<std::string, n_precomputed_values>{"eta_m", "h_star"};
 
+      /**
+       * The components of the precomputed values that are read at
+       * neighboring degrees of freedom: eta_m (in the Indicator) and
+       * h_star (in the nodal source of a neighbor). Only these components
+       * are exchanged over MPI ranks.
+       */
+      static constexpr std::array<unsigned int, 2>
+          precomputed_ghost_components{{0, 1}};
+
       /**
        * The number of precomputed initial values.
        */
@@ -516,6 +531,18 @@ namespace ryujin
                       const flux_contribution_type &flux_j,
                       const dealii::Tensor<1, dim, Number> &c_ij) const;
 
+      /**
+       * Variant of flux_divergence() for already computed equilibrated
+       * states @p star_states, i.e., the return value of
+       * equilibrated_states(flux_i, flux_j). The HyperbolicModule needs
+       * the equilibrated states for the low-order update and the limiter
+       * bounds anyway and thus computes them only once per pair.
+       */
+      state_type
+      flux_divergence(const flux_contribution_type &flux_i,
+                      const std::array<state_type, 2> &star_states,
+                      const dealii::Tensor<1, dim, Number> &c_ij) const;
+
       /**
        * The low-order and high-order fluxes differ:
        */
@@ -569,6 +596,36 @@ namespace ryujin
                               const state_type &U_j,
                               const ScalarNumber tau) const;
 
+      /**
+       * We can treat the Manning friction pointwise implicitly, see
+       * implicit_source().
+       */
+      static constexpr bool have_implicit_source_terms = true;
+
+      /**
+       * Return true if the Manning friction is treated by implicit_source()
+       * instead of nodal_source().
+       */
+      bool implicit_source_terms() const
+      {
+        return implicit_manning_friction();
+      }
+
+      /**
+       * Apply the Manning friction implicitly to the state @p U over a
+       * time step of size @p tau. For a fixed water depth h the friction
+       * ODE \f$\partial_t \mathbf m = -g n^2 |\mathbf m| \mathbf m /
+       * h^{7/3}\f$ has the exact solution
+       * \f[
+       *   \mathbf m(\tau) = \frac{h^{4/3}}{h^{4/3} + \tau g n^2
+       *   |\mathbf v|}\,\mathbf m,
+       * \f]
+       * which is unconditionally stable and preserves the direction of the
+       * momentum. The water depth is unchanged.
+       */
+      state_type implicit_source(const state_type &U,
+                                 const ScalarNumber tau) const;
+
       //@}
       /**
        * @name State transformations (primitive states, expanding
@@ -644,6 +701,15 @@ namespace ryujin
                     manning_friction_coefficient_,
                     "Roughness coefficient for friction source");
 
+      implicit_manning_friction_ = false;
+      add_parameter(
+          "implicit manning friction",
+          implicit_manning_friction_,
+          "If set to true the (stiff) friction source is not part of the "
+          "explicit update but applied pointwise implicitly after every "
+          "time step. The time step size is then only restricted by the "
+          "hyperbolic CFL condition");
+
       reference_water_depth_ = 1.;
       add_parameter("reference water depth",
                     reference_water_depth_,
@@ -1105,9 +1171,20 @@ namespace ryujin
         const flux_contribution_type &flux_i,
         const flux_contribution_type &flux_j,
         const dealii::Tensor<1, dim, Number> &c_ij) const -> state_type
+    {
+      return flux_divergence(flux_i, equilibrated_states(flux_i, flux_j), c_ij);
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline auto
+    HyperbolicSystemView<dim, Number>::flux_divergence(
+        const flux_contribution_type &flux_i,
+        const std::array<state_type, 2> &star_states,
+        const dealii::Tensor<1, dim, Number> &c_ij) const -> state_type
     {
       const auto &[U_i, Z_i] = flux_i;
-      const auto &[U_star_ij, U_star_ji] = equilibrated_states(flux_i, flux_j);
+      const auto &[U_star_ij, U_star_ji] = star_states;
 
       const auto H_i = water_depth(U_i);
       const auto H_star_ij = water_depth(U_star_ij);
@@ -1213,6 +1290,9 @@ namespace ryujin
         const state_type &U_i,
         const ScalarNumber tau) const -> state_type
     {
+      if (implicit_manning_friction())
+        return state_type();
+
       const auto &[eta_m, h_star] =
           pv.template get_tensor<Number, precomputed_type>(i);
 
@@ -1228,6 +1308,9 @@ namespace ryujin
         const state_type &U_j,
         const ScalarNumber tau) const -> state_type
     {
+      if (implicit_manning_friction())
+        return state_type();
+
       const auto &[eta_m, h_star] =
           pv.template get_tensor<Number, precomputed_type>(js);
 
@@ -1235,6 +1318,32 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline auto
+    HyperbolicSystemView<dim, Number>::implicit_source(
+        const state_type &U, const ScalarNumber tau) const -> state_type
+    {
+      const auto g = gravity();
+      const auto n = manning_friction_coefficient();
+
+      const auto h_inverse = inverse_water_depth_mollified(U);
+      const auto h_star =
+          ryujin::pow(water_depth_sharp(U), ScalarNumber(4. / 3.));
+
+      const auto m = momentum(U);
+      const auto v_norm = (m * h_inverse).norm();
+
+      /* h_star is bounded away from zero, the ratio is thus well defined: */
+      const auto ratio = h_star / (h_star + tau * g * n * n * v_norm);
+
+      state_type result = U;
+      for (unsigned int d = 0; d < dim; ++d)
+        result[d + 1] = ratio * m[d];
+
+      return result;
+    }
+
+
     template <int dim, typename Number>
     template <typename ST>
     DEAL_II_ALWAYS_INLINE inline auto
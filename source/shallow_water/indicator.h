@@ -104,9 +104,12 @@ namespace ryujin
 
       /**
        * Reset temporary storage and initialize for a new row corresponding
-       * to state vector U_i.
+       * to state vector U_i. The index @p i is either the first index of a
+       * contiguous range, or (for a SIMD vectorized state) an array of
+       * individual indices, see HyperbolicModule::step().
        */
-      void reset(const unsigned int /*i*/, const state_type &U_i);
+      template <typename Index>
+      void reset(const Index /*i*/, const state_type &U_i);
 
       /**
        * When looping over the sparsity row, add the contribution associated
@@ -153,8 +156,9 @@ namespace ryujin
 
 
     template <int dim, typename Number>
+    template <typename Index>
     DEAL_II_ALWAYS_INLINE inline void
-    Indicator<dim, Number>::reset(const unsigned int i, const state_type &U_i)
+    Indicator<dim, Number>::reset(const Index i, const state_type &U_i)
     {
       /* entropy viscosity commutator: */
 
@@ -33,6 +33,8 @@ namespace ryujin
           : InitialState<Description, dim, Number>("circular dam break", sub)
           , hyperbolic_system(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         still_water_depth_ = 0.5;
         this->add_parameter("still water depth",
                             still_water_depth_,
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <compiled_expression.h>
 #include <initial_state_library.h>
 
 #include <deal.II/base/function_parser.h>
@@ -25,6 +26,8 @@ namespace ryujin
     class Function : public InitialState<Description, dim, Number>
     {
     public:
+      using InitialState<Description, dim, Number>::compute;
+
       using HyperbolicSystem = typename Description::HyperbolicSystem;
       using View =
           typename Description::template HyperbolicSystemView<dim, Number>;
@@ -58,7 +61,8 @@ namespace ryujin
 
         /*
          * Set up the muparser object with the final flux description from
-         * the parameter file:
+         * the parameter file. If possible, we also compile the expressions
+         * into CompiledExpression objects that are used instead:
          */
         const auto set_up_muparser = [this] {
           using FP = dealii::FunctionParser<dim>;
@@ -71,6 +75,19 @@ namespace ryujin
           velocity_x_function_ = std::make_unique<FP>(velocity_x_expression_);
           if constexpr (dim > 1)
             velocity_y_function_ = std::make_unique<FP>(velocity_y_expression_);
+
+          const auto variables =
+              CompiledExpression::coordinate_variables<dim>();
+          compiled_ =
+              depth_compiled_.initialize(depth_expression_, variables) &&
+              velocity_x_compiled_.initialize(velocity_x_expression_,
+                                              variables);
+          if constexpr (dim > 1)
+            compiled_ = compiled_ && velocity_y_compiled_.initialize(
+                                         velocity_y_expression_, variables);
+
+          /* Only the compiled expressions can be evaluated concurrently: */
+          this->thread_safe_ = compiled_;
         };
 
         set_up_muparser();
@@ -82,20 +99,64 @@ namespace ryujin
         const auto view = hyperbolic_system_.template view<dim, Number>();
         state_type full_primitive;
 
-        depth_function_->set_time(t);
-        full_primitive[0] = depth_function_->value(point);
+        const auto evaluate = [&](const auto &compiled, auto &function) {
+          if (compiled_)
+            return compiled.value(point, t);
+          function->set_time(t);
+          return function->value(point);
+        };
 
-        velocity_x_function_->set_time(t);
-        full_primitive[1] = velocity_x_function_->value(point);
+        full_primitive[0] = evaluate(depth_compiled_, depth_function_);
+        full_primitive[1] =
+            evaluate(velocity_x_compiled_, velocity_x_function_);
 
         if constexpr (dim > 1) {
-          velocity_y_function_->set_time(t);
-          full_primitive[2] = velocity_y_function_->value(point);
+          full_primitive[2] =
+              evaluate(velocity_y_compiled_, velocity_y_function_);
         }
 
         return view.from_primitive_state(full_primitive);
       }
 
+      void compute(const dealii::ArrayView<state_type> &states,
+                   const dealii::ArrayView<const dealii::Point<dim>> &points,
+                   Number t) final
+      {
+        if (!compiled_) {
+          InitialState<Description, dim, Number>::compute(states, points, t);
+          return;
+        }
+
+        const auto view = hyperbolic_system_.template view<dim, Number>();
+
+        std::array<const CompiledExpression *, 1 + dim> expressions;
+        expressions[0] = &depth_compiled_;
+        expressions[1] = &velocity_x_compiled_;
+        if constexpr (dim > 1)
+          expressions[2] = &velocity_y_compiled_;
+
+        constexpr auto batch_size = CompiledExpression::batch_size;
+        std::array<std::array<double, batch_size>, 1 + dim> values;
+
+        for (unsigned int offset = 0; offset < points.size();
+             offset += batch_size) {
+          const unsigned int n = std::min<unsigned int>(
+              batch_size, points.size() - offset);
+          const dealii::ArrayView<const dealii::Point<dim>> batch(
+              points.data() + offset, n);
+
+          for (unsigned int c = 0; c < 1 + dim; ++c)
+            expressions[c]->evaluate(values[c].data(), batch, t);
+
+          for (unsigned int k = 0; k < n; ++k) {
+            state_type full_primitive;
+            for (unsigned int c = 0; c < 1 + dim; ++c)
+              full_primitive[c] = values[c][k];
+            states[offset + k] = view.from_primitive_state(full_primitive);
+          }
+        }
+      }
+
     private:
       const HyperbolicSystem &hyperbolic_system_;
 
@@ -108,6 +169,11 @@ namespace ryujin
       std::unique_ptr<dealii::FunctionParser<dim>> velocity_x_function_;
       std::unique_ptr<dealii::FunctionParser<dim>> velocity_y_function_;
       std::unique_ptr<dealii::FunctionParser<dim>> bathymetry_function_;
+
+      bool compiled_;
+      CompiledExpression depth_compiled_;
+      CompiledExpression velocity_x_compiled_;
+      CompiledExpression velocity_y_compiled_;
     };
   } // namespace ShallowWaterInitialStates
 } // namespace ryujin
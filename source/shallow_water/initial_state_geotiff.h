@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <compiled_expression.h>
 #include <geotiff_reader.h>
 #include <initial_state_library.h>
 #include <lazy.h>
@@ -59,6 +60,18 @@ namespace ryujin
            */
           height_function_ = std::make_unique<FP>(height_expression_);
           velocity_function_ = std::make_unique<FP>(velocity_expression_);
+
+          const auto variables =
+              CompiledExpression::coordinate_variables<dim>();
+          compiled_ =
+              height_compiled_.initialize(height_expression_, variables) &&
+              velocity_compiled_.initialize(velocity_expression_, variables);
+
+          /*
+           * The geotiff reader is thread safe. Only the compiled
+           * expressions can be evaluated concurrently:
+           */
+          this->thread_safe_ = compiled_;
         };
 
         set_up();
@@ -71,11 +84,16 @@ namespace ryujin
 
         dealii::Tensor<1, 2, Number> primitive;
 
-        height_function_->set_time(t);
-        primitive[0] = std::max(0., height_function_->value(point) - z);
+        if (compiled_) {
+          primitive[0] = std::max(0., height_compiled_.value(point, t) - z);
+          primitive[1] = velocity_compiled_.value(point, t);
+        } else {
+          height_function_->set_time(t);
+          primitive[0] = std::max(0., height_function_->value(point) - z);
 
-        velocity_function_->set_time(t);
-        primitive[1] = velocity_function_->value(point);
+          velocity_function_->set_time(t);
+          primitive[1] = velocity_function_->value(point);
+        }
 
         const auto view = hyperbolic_system_.template view<dim, Number>();
         return view.from_initial_state(primitive);
@@ -102,6 +120,10 @@ namespace ryujin
 
       std::unique_ptr<dealii::FunctionParser<dim>> height_function_;
       std::unique_ptr<dealii::FunctionParser<dim>> velocity_function_;
+
+      bool compiled_;
+      CompiledExpression height_compiled_;
+      CompiledExpression velocity_compiled_;
     };
   } // namespace ShallowWaterInitialStates
 } // namespace ryujin
@@ -33,6 +33,8 @@ namespace ryujin
           : InitialState<Description, dim, Number>("hou test", s)
           , hyperbolic_system(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         depth_ = 35;
         this->add_parameter("reservoir water depth",
                             depth_,
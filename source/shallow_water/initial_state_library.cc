@@ -12,4 +12,10 @@ namespace ryujin
   template class InitialStateLibrary<Description, 1, NUMBER>;
   template class InitialStateLibrary<Description, 2, NUMBER>;
   template class InitialStateLibrary<Description, 3, NUMBER>;
+
+#ifdef PRECISION_SWITCH
+  template class InitialStateLibrary<Description, 1, float>;
+  template class InitialStateLibrary<Description, 2, float>;
+  template class InitialStateLibrary<Description, 3, float>;
+#endif
 } // namespace ryujin
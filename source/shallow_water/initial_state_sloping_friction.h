@@ -37,6 +37,8 @@ namespace ryujin
                                                    subsection)
           , hyperbolic_system_(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         slope_ = 1.;
         this->add_parameter(
             "ramp slope",
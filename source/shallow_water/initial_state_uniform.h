@@ -36,6 +36,8 @@ namespace ryujin
           : InitialState<Description, dim, Number>("uniform", subsection)
           , hyperbolic_system_(hyperbolic_system)
       {
+        this->time_independent_ = true;
+
         primitive_[0] = 1.;
         primitive_[1] = 1.;
         this->add_parameter(
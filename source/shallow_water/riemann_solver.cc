@@ -19,8 +19,18 @@ namespace ryujin
     template class RiemannSolver<2, NUMBER>;
     template class RiemannSolver<3, NUMBER>;
 
-    template class RiemannSolver<1, dealii::VectorizedArray<NUMBER>>;
-    template class RiemannSolver<2, dealii::VectorizedArray<NUMBER>>;
-    template class RiemannSolver<3, dealii::VectorizedArray<NUMBER>>;
+    template class RiemannSolver<1, VectorizedArrayType<NUMBER>>;
+    template class RiemannSolver<2, VectorizedArrayType<NUMBER>>;
+    template class RiemannSolver<3, VectorizedArrayType<NUMBER>>;
+
+#ifdef PRECISION_SWITCH
+    template class RiemannSolver<1, float>;
+    template class RiemannSolver<2, float>;
+    template class RiemannSolver<3, float>;
+
+    template class RiemannSolver<1, VectorizedArrayType<float>>;
+    template class RiemannSolver<2, VectorizedArrayType<float>>;
+    template class RiemannSolver<3, VectorizedArrayType<float>>;
+#endif
   } // namespace ShallowWater
 } // namespace ryujin
@@ -250,5 +250,19 @@ namespace ryujin
       return compute(riemann_data_i, riemann_data_j);
     }
 
+
+    template <int dim, typename Number>
+    Number RiemannSolver<dim, Number>::compute(
+        const state_type &U_i,
+        const state_type &U_j,
+        const unsigned int * /*is*/,
+        const unsigned int * /*js*/,
+        const dealii::Tensor<1, dim, Number> &n_ij) const
+    {
+      const auto riemann_data_i = riemann_data_from_state(U_i, n_ij);
+      const auto riemann_data_j = riemann_data_from_state(U_j, n_ij);
+      return compute(riemann_data_i, riemann_data_j);
+    }
+
   } // namespace ShallowWater
 } // namespace ryujin
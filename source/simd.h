@@ -53,6 +53,34 @@ namespace ryujin
   //@}
 
 
+  /**
+   * The number of SIMD lanes used for all vectorized loops over the
+   * SparsityPatternSIMD and MultiComponentVector index ranges for a given
+   * scalar type @p Number. This is the native width of
+   * dealii::VectorizedArray<Number> unless the compile-time option
+   * SIMD_WIDTH selects a smaller (power of two) width.
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number>
+  constexpr unsigned int simd_width =
+      (SIMD_WIDTH == 0 || SIMD_WIDTH > dealii::VectorizedArray<Number>::size())
+          ? dealii::VectorizedArray<Number>::size()
+          : SIMD_WIDTH;
+
+  static_assert((SIMD_WIDTH & (SIMD_WIDTH - 1)) == 0,
+                "SIMD_WIDTH must be zero or a power of two");
+
+  /**
+   * The VectorizedArray type with simd_width<Number> lanes.
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number>
+  using VectorizedArrayType =
+      dealii::VectorizedArray<Number, simd_width<Number>>;
+
+
 #ifndef DOXYGEN
   namespace
   {
@@ -174,6 +202,18 @@ namespace ryujin
 
   /**
    * Controls the bias of the fast_pow() functions.
+   *
+   * fast_pow() evaluates in single precision. For positive arguments and
+   * results in the normal floating point range its relative error is
+   * bounded by \f$(|b| + 4)\,\epsilon_{\text{float}}\f$, where the
+   * \f$|b|\,\epsilon\f$ contribution accounts for the rounding of a
+   * (double precision) argument x to single precision. Rounding a double
+   * precision exponent b that is not representable in single precision
+   * adds at most \f$|b\,\log x|\,\epsilon_{\text{float}}/2\f$. A
+   * biased variant scales the result by \f$1 \pm (2|b| + 8 + |b\,\log
+   * x|)\,\epsilon_{\text{float}}\f$ to guarantee the requested bound.
+   * The test tests/common/fast_pow_bias verifies both bounds over a range
+   * of arguments and exponents.
    */
   enum class Bias {
     /**
@@ -183,13 +223,15 @@ namespace ryujin
 
     /**
      * Guarantee an upper bound, i.e., fast_pow(x,b) >= pow(x,b) provided
-     * that FIXME
+     * that x > 0 and that the result lies in the normal floating point
+     * range.
      */
     max,
 
     /**
-     * Guarantee a lower bound, i.e., fast_pow(x,b) >= pow(x,b) provided
-     * that FIXME
+     * Guarantee a lower bound, i.e., fast_pow(x,b) <= pow(x,b) provided
+     * that x > 0 and that the result lies in the normal floating point
+     * range.
      */
     min
   };
@@ -243,17 +285,19 @@ namespace ryujin
   template <typename T, typename V>
   DEAL_II_ALWAYS_INLINE inline T get_entry(const V &vector, unsigned int i)
   {
-    static_assert(std::is_same_v<typename get_value_type<T>::type,
-                                 typename V::value_type>,
-                  "type mismatch");
     T result;
 
     if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
       /* Non-vectorized sequential access. */
       result = vector.local_element(i);
-    } else {
+    } else if constexpr (std::is_same_v<typename get_value_type<T>::type,
+                                        typename V::value_type>) {
       /* Vectorized fast access. index must be divisible by simd_length */
       result.load(vector.get_values() + i);
+    } else {
+      /* Fallback for mismatched types (float vs double): */
+      for (unsigned int k = 0; k < T::size(); ++k)
+        result[k] = vector.local_element(i + k);
     }
 
     return result;
@@ -306,17 +350,19 @@ namespace ryujin
   DEAL_II_ALWAYS_INLINE inline T get_entry(const V &vector,
                                            const unsigned int *js)
   {
-    static_assert(std::is_same_v<typename get_value_type<T>::type,
-                                 typename V::value_type>,
-                  "type mismatch");
     T result;
 
     if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
       /* Non-vectorized sequential access. */
       result = vector.local_element(js[0]);
-    } else {
+    } else if constexpr (std::is_same_v<typename get_value_type<T>::type,
+                                        typename V::value_type>) {
       /* Vectorized fast access. index must be divisible by simd_length */
       result.gather(vector.get_values(), js);
+    } else {
+      /* Fallback for mismatched types (float vs double): */
+      for (unsigned int k = 0; k < T::size(); ++k)
+        result[k] = vector.local_element(js[k]);
     }
 
     return result;
@@ -356,16 +402,17 @@ namespace ryujin
   DEAL_II_ALWAYS_INLINE inline void
   write_entry(V &vector, const T &values, unsigned int i)
   {
-    static_assert(std::is_same_v<typename get_value_type<T>::type,
-                                 typename V::value_type>,
-                  "type mismatch");
-
     if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
       /* Non-vectorized sequential access. */
       vector.local_element(i) = values;
-    } else {
+    } else if constexpr (std::is_same_v<typename get_value_type<T>::type,
+                                        typename V::value_type>) {
       /* Vectorized fast access. index must be divisible by simd_length */
       values.store(vector.get_values() + i);
+    } else {
+      /* Fallback for mismatched types (float vs double): */
+      for (unsigned int k = 0; k < T::size(); ++k)
+        vector.local_element(i + k) = values[k];
     }
   }
 
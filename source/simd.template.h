@@ -321,31 +321,56 @@ namespace ryujin
 
 #else
 
+  namespace
+  {
+    /*
+     * Apply the bias to the result z = pow(x, b), see the documentation
+     * of the Bias enum.
+     */
+    template <typename T, typename B>
+    DEAL_II_ALWAYS_INLINE inline T
+    apply_bias(const T x, const B b, const T z, const Bias bias)
+    {
+      if (bias == Bias::none)
+        return z;
+
+      using std::abs;
+      using std::log;
+      using std::max;
+      const auto eps = std::numeric_limits<float>::epsilon();
+      const auto log_x = log(max(x, T(std::numeric_limits<float>::min())));
+      const T tolerance = T(eps) * (T(2.) * abs(b) + T(8.) + abs(b * log_x));
+      return bias == Bias::max ? z + z * tolerance : z - z * tolerance;
+    }
+  } // namespace
+
+
   template <>
   // DEAL_II_ALWAYS_INLINE inline
-  float fast_pow(const float x, const float b, const Bias)
+  float fast_pow(const float x, const float b, const Bias bias)
   {
     // Call generic std::pow() implementation
-    return std::pow(x, b);
+    return apply_bias(x, b, std::pow(x, b), bias);
   }
 
 
   template <>
   // DEAL_II_ALWAYS_INLINE inline
-  double fast_pow(const double x, const double b, const Bias)
+  double fast_pow(const double x, const double b, const Bias bias)
   {
     // Call generic std::pow() implementation
-    return std::pow(static_cast<float>(x), static_cast<float>(b));
+    const double z = std::pow(static_cast<float>(x), static_cast<float>(b));
+    return apply_bias(x, b, z, bias);
   }
 
 
   template <typename T, std::size_t width>
   // DEAL_II_ALWAYS_INLINE inline
-  dealii::VectorizedArray<T, width>
-  fast_pow(const dealii::VectorizedArray<T, width> x, const T b, const Bias)
+  dealii::VectorizedArray<T, width> fast_pow(
+      const dealii::VectorizedArray<T, width> x, const T b, const Bias bias)
   {
     // Call generic deal.II implementation
-    return std::pow(x, b);
+    return apply_bias(x, b, std::pow(x, b), bias);
   }
 
 
@@ -354,10 +379,10 @@ namespace ryujin
   dealii::VectorizedArray<T, width>
   fast_pow(const dealii::VectorizedArray<T, width> x,
            const dealii::VectorizedArray<T, width> b,
-           const Bias)
+           const Bias bias)
   {
     // Call generic deal.II implementation
-    return std::pow(x, b);
+    return apply_bias(x, b, std::pow(x, b), bias);
   }
 #endif
 
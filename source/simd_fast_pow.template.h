@@ -9,6 +9,7 @@
 #include "simd.h"
 
 #include <cmath>
+#include <limits>
 
 #if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)
 #define VCL_NAMESPACE vcl
@@ -36,12 +37,13 @@ namespace ryujin
   template <typename VTYPE>
   inline DEAL_II_ALWAYS_INLINE VTYPE fast_pow_impl(VTYPE const x0,
                                                    VTYPE const y,
-                                                   Bias)
+                                                   Bias bias)
   {
     /* clang-format off */
     using namespace vcl;
 
     const float ln2f_hi  =  0.693359375f;        // log(2), split in two for extended precision
+    const float ln2f_lo  = -2.12194440e-4f;
     const auto log2e = static_cast<float>(VM_LOG2E); // 1/log(2)
 
     const float P0logf  =  3.3333331174E-1f;     // coefficients for logarithm expansion
@@ -116,6 +118,7 @@ namespace ryujin
     e2 = round(lg * y * static_cast<float>(VM_LOG2E));
     // subtract this from lg, with extra precision
     v = mul_sub(lg, y, e2 * ln2f_hi);
+    v = nmul_add(e2, ln2f_lo, v);
 
     // correct for previous rounding errors
     v -= mul_sub(lgerr + x2err, y, yr * static_cast<float>(VM_LN2)); // v -= (lgerr + x2err) * y - yr * float(VM_LN2) ;
@@ -157,6 +160,16 @@ namespace ryujin
     xzero = is_zero_or_subnormal(x0);
     z = wm_pow_case_x0(xzero, y, z);
 
+    // apply bias, see the documentation of the Bias enum
+    if (bias != Bias::none) {
+      const float eps = std::numeric_limits<float>::epsilon();
+      const VTYPE log_x = mul_add(ef, static_cast<float>(VM_LN2), lg);
+      VTYPE tolerance = mul_add(abs(y), 2.f * eps, 8.f * eps);
+      tolerance = mul_add(abs(y * log_x), eps, tolerance);
+      z = bias == Bias::max ? mul_add(z, tolerance, z)
+                            : nmul_add(z, tolerance, z);
+    }
+
     return z;
 
     /* clang-format on */
@@ -0,0 +1,243 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include "simd.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace ryujin
+{
+  /**
+   * An approximate pow(x, b) for a fixed exponent b, for example an
+   * exponent derived from the ratio of specific heats. In contrast to
+   * fast_pow() all work that only depends on the exponent is done once
+   * in reinit():
+   *
+   *  - A table of \f$2^{k b} = 2^n f\f$, with an integer n and
+   *    \f$f \in [1, 2)\f$, for all exponents k of the normal single
+   *    precision range.
+   *  - Tables of \f$m_j^b\f$ and \f$1/m_j\f$ for the midpoints \f$m_j\f$
+   *    of 128 subintervals of the mantissa range [1, 2).
+   *  - The coefficients of the binomial series \f$(1 + r)^b\f$ truncated
+   *    after degree 6 (double) or 3 (float).
+   *  - A bound on the relative error of the evaluation for this exponent.
+   *
+   * An evaluation splits \f$x = 2^k m\f$ by integer operations, reduces
+   * the mantissa to \f$m = m_j (1 + r)\f$ with \f$|r| \le 2^{-8}\f$ and
+   * returns \f$2^n f m_j^b (1 + r)^b\f$. This needs four table lookups,
+   * one fused multiply-add for r and one per polynomial degree, three
+   * multiplications, and an integer addition to the exponent bits for
+   * \f$2^n\f$. There is no logarithm and exponential evaluation, no
+   * conversion to single precision, and no special case handling.
+   *
+   * The relative error is bounded by tolerance(), which is about
+   * 2 (|b| + 6) times the machine epsilon of @p Number, for all x in the
+   * normal single precision range with a result in the normal range of
+   * @p Number. With Bias::max or Bias::min the result is scaled by
+   * 1 +/- tolerance(), which guarantees an upper or lower bound for such
+   * x, the same guarantee as for fast_pow(). For other x (including zero,
+   * negative numbers, infinities and NaN) the result is unspecified.
+   *
+   * Usage:
+   * ```
+   * FixedExponentPow<double> pow_gamma(gamma_minus_one_over_two_gamma);
+   * const auto upper_bound = pow_gamma(x, Bias::max);
+   * ```
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number>
+  class FixedExponentPow
+  {
+  public:
+    static_assert(std::is_same_v<Number, double> ||
+                      std::is_same_v<Number, float>,
+                  "Number has to be double or float");
+
+    /**
+     * The degree of the polynomial approximation of \f$(1 + r)^b\f$. The
+     * truncation error is below the machine epsilon of @p Number for
+     * moderate exponents.
+     */
+    static constexpr unsigned int degree =
+        std::is_same_v<Number, double> ? 6 : 3;
+
+    /**
+     * Constructor.
+     */
+    FixedExponentPow(const Number b = Number(1.))
+    {
+      reinit(b);
+    }
+
+    /**
+     * Set up all tables for the exponent @p b.
+     */
+    void reinit(const Number b)
+    {
+      b_ = b;
+
+      const double b_ld = b;
+
+      /*
+       * 2^(k b) = 2^n f with an integer n and f in [1, 2): We split
+       * k b = hi + lo exactly and evaluate f = 2^(hi - n) (1 + lo ln 2) to
+       * avoid the rounding error of k b. The power 2^n is later applied by
+       * adding n to the exponent bits of the result. This way no table
+       * entry underflows or overflows for results in the normal range:
+       */
+      for (int k = min_exponent; k <= max_exponent; ++k) {
+        const double hi = double(k) * b_ld;
+        const double lo = std::fma(double(k), b_ld, -hi);
+        const double n = std::floor(hi);
+        exponent_fraction_[k - min_exponent] =
+            Number(std::exp2(hi - n) * (1. + lo * std::numbers::ln2));
+        exponent_shift_[k - min_exponent] = static_cast<Integer>(
+            static_cast<std::make_signed_t<Integer>>(n) << n_mantissa_bits);
+      }
+
+      for (unsigned int j = 0; j < n_intervals; ++j) {
+        const double m_j = 1. + (j + 0.5) / n_intervals;
+        mantissa_power_[j] = Number(std::pow(m_j, b_ld));
+        mantissa_inverse_[j] = Number(1. / m_j);
+      }
+
+      coefficients_[0] = Number(1.);
+      double binomial = 1.;
+      for (unsigned int n = 1; n <= degree; ++n) {
+        binomial *= (b_ld - (n - 1)) / n;
+        coefficients_[n] = Number(binomial);
+      }
+
+      /*
+       * The truncation error of the binomial series for |r| <= r_max is
+       * bounded by |binom(b, degree + 1)| r_max^(degree + 1) / (1 - q)
+       * with the ratio q of two consecutive terms:
+       */
+      constexpr double r_max = 0.5 / n_intervals;
+      const double next = std::abs(binomial * (b_ld - degree) / (degree + 1));
+      const double q =
+          std::max(1., (std::abs(b_ld) + degree + 1) / (degree + 2)) * r_max;
+      const double truncation =
+          next * std::pow(r_max, degree + 1) / (1. - q);
+
+      /*
+       * Rounding errors: The table entries and the products (about four
+       * eps), the reduced argument r (|b| eps), and the polynomial
+       * evaluation (about two eps). We add a safety factor of two:
+       */
+      const double eps = std::numeric_limits<Number>::epsilon();
+      tolerance_ = Number(2. * ((std::abs(b_ld) + 6.) * eps + truncation));
+    }
+
+    /**
+     * Return the exponent b.
+     */
+    Number exponent() const
+    {
+      return b_;
+    }
+
+    /**
+     * Return the bound on the relative error of an evaluation that is
+     * used for Bias::max and Bias::min.
+     */
+    Number tolerance() const
+    {
+      return tolerance_;
+    }
+
+    /**
+     * Return an approximation of pow(x, b) for a scalar or a
+     * VectorizedArray @p x with the requested @p bias.
+     */
+    template <typename T>
+    T operator()(const T &x, const Bias bias = Bias::none) const
+    {
+      static_assert(std::is_same_v<typename get_value_type<T>::type, Number>,
+                    "The argument has to match the Number type");
+
+      const Number scale = bias == Bias::max   ? Number(1.) + tolerance_
+                           : bias == Bias::min ? Number(1.) - tolerance_
+                                               : Number(1.);
+
+      if constexpr (std::is_same_v<T, Number>) {
+        return evaluate(x, scale);
+      } else {
+        T result;
+        DEAL_II_OPENMP_SIMD_PRAGMA
+        for (unsigned int k = 0; k < T::size(); ++k)
+          result[k] = evaluate(x[k], scale);
+        return result;
+      }
+    }
+
+  private:
+    using Integer = std::conditional_t<std::is_same_v<Number, double>,
+                                       std::uint64_t,
+                                       std::uint32_t>;
+
+    static constexpr int n_mantissa_bits =
+        std::numeric_limits<Number>::digits - 1;
+    static constexpr int exponent_bias =
+        std::numeric_limits<Number>::max_exponent - 1;
+
+    static constexpr int min_exponent =
+        std::numeric_limits<float>::min_exponent - 1;
+    static constexpr int max_exponent =
+        std::numeric_limits<float>::max_exponent - 1;
+
+    static constexpr unsigned int n_interval_bits = 7;
+    static constexpr unsigned int n_intervals = 1u << n_interval_bits;
+
+    static constexpr Integer mantissa_mask =
+        (Integer(1) << n_mantissa_bits) - 1;
+    static constexpr Integer one_bits = std::bit_cast<Integer>(Number(1.));
+
+    inline DEAL_II_ALWAYS_INLINE Number evaluate(const Number x,
+                                                 const Number scale) const
+    {
+      const auto bits = std::bit_cast<Integer>(x);
+
+      const int k = std::clamp(int(bits >> n_mantissa_bits) - exponent_bias,
+                               min_exponent,
+                               max_exponent);
+      const unsigned int j =
+          static_cast<unsigned int>(bits >>
+                                    (n_mantissa_bits - n_interval_bits)) &
+          (n_intervals - 1);
+      const Number m = std::bit_cast<Number>((bits & mantissa_mask) | one_bits);
+
+      const Number r = m * mantissa_inverse_[j] - Number(1.);
+
+      Number p = coefficients_[degree];
+      for (int n = degree - 1; n >= 0; --n)
+        p = p * r + coefficients_[n];
+
+      const Number y = exponent_fraction_[k - min_exponent] *
+                       (mantissa_power_[j] * scale) * p;
+      return std::bit_cast<Number>(std::bit_cast<Integer>(y) +
+                                   exponent_shift_[k - min_exponent]);
+    }
+
+    Number b_;
+    Number tolerance_;
+
+    std::array<Number, degree + 1> coefficients_;
+    std::array<Number, n_intervals> mantissa_power_;
+    std::array<Number, n_intervals> mantissa_inverse_;
+    std::array<Number, max_exponent - min_exponent + 1> exponent_fraction_;
+    std::array<Integer, max_exponent - min_exponent + 1> exponent_shift_;
+  };
+} // namespace ryujin
@@ -174,6 +174,14 @@ namespace ryujin
       static inline const auto precomputed_names =
           std::array<std::string, n_precomputed_values>{};
 
+      /**
+       * The components of the precomputed values that are read at
+       * neighboring degrees of freedom. Only these components are
+       * exchanged over MPI ranks.
+       */
+      static constexpr std::array<unsigned int, 0>
+          precomputed_ghost_components{};
+
       /**
        * The number of precomputed initial values.
        */
@@ -231,6 +239,11 @@ namespace ryujin
       /**
        * Precompute values for hyperbolic update. This routine is called
        * within our usual loop() idiom in HyperbolicModule
+       *
+       * @note Cycle 0 runs while the ghost exchange of the state vector
+       * is still in flight. It must be a pointwise operation that only
+       * reads U_i of the locally owned index range (this is checked in
+       * debug mode). Later cycles may access ghost states U_j.
        */
       template <typename DISPATCH, typename SPARSITY>
       void precomputation_loop(unsigned int /*cycle*/,
@@ -359,6 +372,9 @@ namespace ryujin
                               const state_type & /*U_j*/,
                               const ScalarNumber /*tau*/) const = delete;
 
+      /** We do not have implicit source terms */
+      static constexpr bool have_implicit_source_terms = false;
+
       //@}
       /**
        * @name State transformations
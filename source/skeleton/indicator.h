@@ -88,9 +88,12 @@ namespace ryujin
 
       /**
        * Reset temporary storage and initialize for a new row corresponding
-       * to state vector U_i.
+       * to state vector U_i. The index @p i is either the first index of a
+       * contiguous range, or (for a SIMD vectorized state) an array of
+       * individual indices, see HyperbolicModule::step().
        */
-      void reset(const unsigned int /*i*/, const state_type & /*U_i*/)
+      template <typename Index>
+      void reset(const Index /*i*/, const state_type & /*U_i*/)
       {
         // empty
       }
@@ -85,6 +85,20 @@ namespace ryujin
         return Number(1.);
       }
 
+      /**
+       * Variant of above function for a (SIMD vectorized) state U_i that
+       * is associated with individual indices @p is instead of a
+       * contiguous range of indices starting at i.
+       */
+      Number compute(const state_type & /*U_i*/,
+                     const state_type & /*U_j*/,
+                     const unsigned int * /*is*/,
+                     const unsigned int * /*js*/,
+                     const dealii::Tensor<1, dim, Number> & /*n_ij*/) const
+      {
+        return Number(1.);
+      }
+
     private:
       const HyperbolicSystem &hyperbolic_system;
       const Parameters &parameters;
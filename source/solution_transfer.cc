@@ -12,4 +12,10 @@ namespace ryujin
   template class SolutionTransfer<Description, 1, NUMBER>;
   template class SolutionTransfer<Description, 2, NUMBER>;
   template class SolutionTransfer<Description, 3, NUMBER>;
+
+#ifdef PRECISION_SWITCH
+  template class SolutionTransfer<Description, 1, float>;
+  template class SolutionTransfer<Description, 2, float>;
+  template class SolutionTransfer<Description, 3, float>;
+#endif
 } // namespace ryujin
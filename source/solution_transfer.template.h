@@ -8,6 +8,7 @@
 #include <compile_time_options.h>
 
 #include "discretization.h"
+#include "openmp.h"
 #include "solution_transfer.h"
 #if DEAL_II_VERSION_GTE(9, 6, 0)
 #include "tensor_product_point_kernels.h"
@@ -17,6 +18,7 @@
 #include <deal.II/distributed/tria.h>
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_poly.h>
 #if DEAL_II_VERSION_GTE(9, 6, 0)
 #include <deal.II/grid/cell_status.h>
 #endif
@@ -88,6 +90,25 @@ namespace ryujin
                   state_values.size() * sizeof(state_type));
       return state_values;
     }
+
+
+    /**
+     * Return the lexicographic numbering of the shape functions of a
+     * tensor product finite element, i.e., the (hierarchic) index of the
+     * lexicographic shape function i. This is the ordering expected by
+     * the tensor product point kernels.
+     */
+    template <int dim>
+    std::vector<unsigned int>
+    lexicographic_numbering(const dealii::FiniteElement<dim> &finite_element)
+    {
+      const auto fe_poly =
+          dynamic_cast<const dealii::FE_Poly<dim> *>(&finite_element);
+      AssertThrow(fe_poly != nullptr,
+                  dealii::ExcMessage("The SolutionTransfer class requires a "
+                                     "tensor product finite element"));
+      return fe_poly->get_poly_space_numbering_inverse();
+    }
   } // namespace
 
 
@@ -161,12 +182,30 @@ namespace ryujin
                "You can only add one solution per SolutionTransfer object."));
 
     /*
-     * Add a register_data_attach callback that
+     * The FEValues object used for projecting coarsened cells is created
+     * only once and shared by all invocations of the callback. The same
+     * holds true for the lexicographic numbering of shape functions used
+     * by the tensor product kernels:
+     */
+
+    const auto lexicographic =
+        lexicographic_numbering(discretization.finite_element());
+
+    const auto fe_values = std::make_shared<dealii::FEValues<dim>>(
+        discretization.mapping(),
+        discretization.finite_element(),
+        discretization.quadrature(),
+        dealii::update_values | dealii::update_JxW_values |
+            dealii::update_quadrature_points);
+
+    /*
+     * Add a register_data_attach callback that packs the state values of
+     * every cell:
      */
 
     handle_ = triangulation_->register_data_attach(
-        [this, &old_state_vector](const auto cell,
-                                  const dealii::CellStatus status) {
+        [this, &old_state_vector, fe_values, lexicographic](
+            const auto cell, const dealii::CellStatus status) {
           const auto &dof_handler = offline_data_->dof_handler();
           const auto dof_cell = typename dealii::DoFHandler<dim>::cell_iterator(
               &cell->get_triangulation(),
@@ -220,13 +259,6 @@ namespace ryujin
             const auto &mapping = discretization.mapping();
             const auto &quadrature = discretization.quadrature();
 
-            dealii::FEValues<dim> fe_values(
-                mapping,
-                finite_element,
-                quadrature,
-                dealii::update_values | dealii::update_JxW_values |
-                    dealii::update_quadrature_points);
-
             const auto polynomial_space =
                 dealii::internal::FEPointEvaluation::get_polynomial_space(
                     finite_element);
@@ -240,9 +272,15 @@ namespace ryujin
             std::vector<dealii::Point<dim>> unit_points_temp(
                 std::is_same_v<Number, float> ? quadrature.size() : 0);
 
+            const bool is_linear = finite_element.degree == 1;
+            const unsigned int n_shapes = polynomial_space.size();
+            AssertIndexRange(n_shapes, 10);
+            dealii::ndarray<Number, 10, 2, dim> shapes;
+
             /* Step 1: build up right hand side by iterating over children: */
 
             std::vector<state_type> state_values_quad(quadrature.size());
+            /* The right hand side is stored in lexicographic ordering: */
             std::vector<state_type> local_rhs(n_dofs_per_cell);
 
             std::vector<dealii::types::global_dof_index> dof_indices(
@@ -253,12 +291,12 @@ namespace ryujin
               const auto child_cell = dof_cell->child(child);
               Assert(child_cell->is_active(), dealii::ExcInternalError());
 
-              fe_values.reinit(child_cell);
+              fe_values->reinit(child_cell);
 
               if constexpr (std::is_same_v<Number, float>) {
                 mapping.transform_points_real_to_unit_cell(
                     dof_cell,
-                    fe_values.get_quadrature_points(),
+                    fe_values->get_quadrature_points(),
                     unit_points_temp);
                 std::transform(std::begin(unit_points_temp),
                                std::end(unit_points_temp),
@@ -266,7 +304,7 @@ namespace ryujin
                                [](const auto &x) { return x; });
               } else {
                 mapping.transform_points_real_to_unit_cell(
-                    dof_cell, fe_values.get_quadrature_points(), unit_points);
+                    dof_cell, fe_values->get_quadrature_points(), unit_points);
               }
 
               child_cell->get_dof_indices(dof_indices);
@@ -277,17 +315,28 @@ namespace ryujin
               for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
                 const auto U_i = get_tensor(U, dof_indices[i]);
                 for (unsigned int q = 0; q < quadrature.size(); ++q) {
-                  state_values_quad[q] += U_i * fe_values.shape_value(i, q);
+                  state_values_quad[q] += U_i * fe_values->shape_value(i, q);
                 }
               }
 
               for (unsigned int q = 0; q < quadrature.size(); ++q)
-                state_values_quad[q] *= fe_values.JxW(q);
+                state_values_quad[q] *= fe_values->JxW(q);
 
               for (unsigned int q = 0; q < quadrature.size(); ++q) {
-                const unsigned int n_shapes = polynomial_space.size();
-                AssertIndexRange(n_shapes, 10);
-                dealii::ndarray<Number, 10, 2, dim> shapes;
+                if (is_linear) {
+                  ryujin::internal::integrate_tensor_product_value<
+                      /*is linear*/ true,
+                      dim,
+                      Number,
+                      state_type>(shapes.data(),
+                                  n_shapes,
+                                  state_values_quad[q],
+                                  local_rhs.data(),
+                                  unit_points[q],
+                                  true);
+                  continue;
+                }
+
                 // Evaluate 1d polynomials and their derivatives
                 std::array<Number, dim> point;
                 for (unsigned int d = 0; d < dim; ++d)
@@ -295,10 +344,8 @@ namespace ryujin
                 for (unsigned int i = 0; i < n_shapes; ++i)
                   polynomial_space[i].values_of_array(point, 1, &shapes[i][0]);
 
-                Assert(finite_element.degree == 1, dealii::ExcNotImplemented());
-
                 ryujin::internal::integrate_tensor_product_value<
-                    /*is linear*/ true,
+                    /*is linear*/ false,
                     dim,
                     Number,
                     state_type>(shapes.data(),
@@ -310,9 +357,17 @@ namespace ryujin
               }
             }
 
+            /* Renumber the right hand side into hierarchic ordering: */
+
+            {
+              const auto temp = local_rhs;
+              for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+                local_rhs[lexicographic[i]] = temp[i];
+            }
+
             /* Step 2: solve with inverse mass matrix on coarse cell: */
 
-            fe_values.reinit(dof_cell);
+            fe_values->reinit(dof_cell);
 
             dealii::FullMatrix<double> mij(n_dofs_per_cell, n_dofs_per_cell);
             dealii::Vector<double> mi(n_dofs_per_cell);
@@ -320,8 +375,8 @@ namespace ryujin
               for (unsigned int j = 0; j < n_dofs_per_cell; ++j) {
                 double sum = 0;
                 for (unsigned int q = 0; q < quadrature.size(); ++q)
-                  sum += fe_values.shape_value(i, q) *
-                         fe_values.shape_value(j, q) * fe_values.JxW(q);
+                  sum += fe_values->shape_value(i, q) *
+                         fe_values->shape_value(j, q) * fe_values->JxW(q);
                 mij(i, j) = sum;
                 mi(i) += sum;
               }
@@ -394,13 +449,33 @@ namespace ryujin
     projected_mass.reinit(offline_data_->scalar_partitioner());
     HyperbolicVector projected_state;
     projected_state.reinit(offline_data_->hyperbolic_vector_partitioner());
+    Vectors::set_blocked_range(projected_state, *offline_data_);
+
+    /*
+     * Unpack the stored state values of all cells first. We then compute
+     * the (mass weighted) contributions of every cell to the projected
+     * state in parallel and distribute them serially in the order of the
+     * cells, so that the result does not depend on the number of threads.
+     */
+
+    struct CellData {
+      typename dealii::DoFHandler<dim>::cell_iterator dof_cell;
+      dealii::CellStatus status;
+      std::vector<state_type> state_values;
+
+      /* Contributions to the projected state and mass: */
+      std::vector<dealii::types::global_dof_index> dof_indices;
+      std::vector<state_type> states;
+      std::vector<double> masses;
+    };
+
+    std::vector<CellData> cell_data;
 
     triangulation_->notify_ready_to_unpack( //
         handle_,
-        [this, &projected_mass, &projected_state](
-            const auto &cell,
-            const dealii::CellStatus status,
-            const auto &data_range) {
+        [this, &cell_data](const auto &cell,
+                           const dealii::CellStatus status,
+                           const auto &data_range) {
           const auto &dof_handler = offline_data_->dof_handler();
           const auto dof_cell = typename dealii::DoFHandler<dim>::cell_iterator(
               &cell->get_triangulation(),
@@ -408,171 +483,198 @@ namespace ryujin
               cell->index(),
               &dof_handler);
 
-          /*
-           * Retrieve packed values and project onto cell:
-           */
-
-          const auto n_dofs_per_cell = dof_handler.get_fe().n_dofs_per_cell();
-          std::vector<dealii::types::global_dof_index> dof_indices(
-              n_dofs_per_cell);
-
-          const auto state_values = unpack_state_values<state_type>(data_range);
-
-          switch (status) {
-          case dealii::CellStatus::cell_will_persist:
-            [[fallthrough]];
-          case dealii::CellStatus::children_will_be_coarsened: {
-            /*
-             * For both cases we distribute stored state_values to the
-             * projected_state and projected_mass vectors.
-             */
-
-            Assert(dof_cell->is_active(), dealii::ExcInternalError());
-            dof_cell->get_dof_indices(dof_indices);
-
-            const auto &discretization = offline_data_->discretization();
-            const auto &finite_element = discretization.finite_element();
-            const auto &mapping = discretization.mapping();
-            const auto &quadrature = discretization.quadrature();
-
-            dealii::FEValues<dim> fe_values(mapping,
-                                            finite_element,
-                                            quadrature,
-                                            dealii::update_values |
-                                                dealii::update_JxW_values);
-
-            fe_values.reinit(dof_cell);
-
-            dealii::Vector<double> mi(n_dofs_per_cell);
-            for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
-              double sum = 0;
-              for (unsigned int q = 0; q < quadrature.size(); ++q)
-                sum += fe_values.shape_value(i, q) * fe_values.JxW(q);
-              mi(i) += sum;
-            }
-
-            for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
-              const auto global_i = dof_indices[i];
-              add_tensor(projected_state, mi(i) * state_values[i], global_i);
-              projected_mass(global_i) += mi(i);
-            }
+          cell_data.push_back(
+              {dof_cell,
+               status,
+               unpack_state_values<state_type>(data_range),
+               {},
+               {},
+               {}});
+        });
 
-          } break;
+    const auto &finite_element = discretization.finite_element();
+    const auto &mapping = discretization.mapping();
+    const auto &quadrature = discretization.quadrature();
+    const auto n_dofs_per_cell = finite_element.n_dofs_per_cell();
+    const auto lexicographic = lexicographic_numbering(finite_element);
+    const bool is_linear = finite_element.degree == 1;
 
-          case dealii::CellStatus::cell_will_be_refined: {
-            /*
-             * We are on a (non active) cell that has been refined. Project
-             * onto the children and do a local mass projection there:
-             */
+    /*
+     * Shape function values on the reference cell. For our (Lagrange)
+     * ansatz these do not depend on the mapping. We use them for the fast
+     * path of persisting and coarsened cells that only requires the JxW
+     * values of the cell:
+     */
 
-            Assert(dof_cell->has_children(), dealii::ExcInternalError());
+    dealii::FullMatrix<double> shape_values(n_dofs_per_cell,
+                                            quadrature.size());
+    for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        shape_values(i, q) =
+            finite_element.shape_value(i, quadrature.point(q));
 
-            const auto &discretization = offline_data_->discretization();
-            const auto &finite_element = discretization.finite_element();
-            const auto &mapping = discretization.mapping();
-            const auto &quadrature = discretization.quadrature();
+    RYUJIN_PARALLEL_REGION_BEGIN
 
-            dealii::FEValues<dim> fe_values(
-                mapping,
-                finite_element,
-                quadrature,
-                dealii::update_values | dealii::update_JxW_values |
-                    dealii::update_quadrature_points);
+    /* Stored thread locally: */
 
-            const auto polynomial_space =
-                dealii::internal::FEPointEvaluation::get_polynomial_space(
-                    finite_element);
-            std::vector<dealii::Point<dim, Number>> unit_points(
-                quadrature.size());
-            /*
-             * for Number == float we need a temporary vector for the
-             * transform_points_real_to_unit_cell() function:
-             */
-            std::vector<dealii::Point<dim>> unit_points_temp(
-                std::is_same_v<Number, float> ? quadrature.size() : 0);
+    dealii::FEValues<dim> fe_values(mapping,
+                                    finite_element,
+                                    quadrature,
+                                    dealii::update_values |
+                                        dealii::update_JxW_values |
+                                        dealii::update_quadrature_points);
 
-            dealii::FullMatrix<double> mij(n_dofs_per_cell, n_dofs_per_cell);
-            dealii::Vector<double> mi(n_dofs_per_cell);
-            std::vector<state_type> local_rhs(n_dofs_per_cell);
+    dealii::FEValues<dim> fe_values_jxw(
+        mapping, finite_element, quadrature, dealii::update_JxW_values);
 
-            for (unsigned int child = 0; child < dof_cell->n_children();
-                 ++child) {
-              const auto child_cell = dof_cell->child(child);
+    const auto polynomial_space =
+        dealii::internal::FEPointEvaluation::get_polynomial_space(
+            finite_element);
+    std::vector<dealii::Point<dim, Number>> unit_points(quadrature.size());
+    /*
+     * for Number == float we need a temporary vector for the
+     * transform_points_real_to_unit_cell() function:
+     */
+    std::vector<dealii::Point<dim>> unit_points_temp(
+        std::is_same_v<Number, float> ? quadrature.size() : 0);
+
+    dealii::FullMatrix<double> mij(n_dofs_per_cell, n_dofs_per_cell);
+    dealii::Vector<double> mi(n_dofs_per_cell);
+    std::vector<state_type> local_rhs(n_dofs_per_cell);
+    std::vector<state_type> state_values_lexicographic(n_dofs_per_cell);
+    std::vector<dealii::types::global_dof_index> dof_indices(n_dofs_per_cell);
+
+    RYUJIN_OMP_FOR
+    for (std::size_t k = 0; k < cell_data.size(); ++k) {
+      auto &data = cell_data[k];
+      const auto &dof_cell = data.dof_cell;
+      const auto &state_values = data.state_values;
+
+      switch (data.status) {
+      case dealii::CellStatus::cell_will_persist:
+        [[fallthrough]];
+      case dealii::CellStatus::children_will_be_coarsened: {
+        /*
+         * For both cases we distribute stored state_values to the
+         * projected_state and projected_mass vectors. This only requires
+         * the (lumped) cell masses:
+         */
+
+        Assert(dof_cell->is_active(), dealii::ExcInternalError());
+        data.dof_indices.resize(n_dofs_per_cell);
+        dof_cell->get_dof_indices(data.dof_indices);
+
+        fe_values_jxw.reinit(dof_cell);
+
+        data.states.resize(n_dofs_per_cell);
+        data.masses.resize(n_dofs_per_cell);
+        for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
+          double sum = 0;
+          for (unsigned int q = 0; q < quadrature.size(); ++q)
+            sum += shape_values(i, q) * fe_values_jxw.JxW(q);
+          data.masses[i] = sum;
+          data.states[i] = sum * state_values[i];
+        }
+
+      } break;
+
+      case dealii::CellStatus::cell_will_be_refined: {
+        /*
+         * We are on a (non active) cell that has been refined. Project
+         * onto the children and do a local mass projection there:
+         */
+
+        Assert(dof_cell->has_children(), dealii::ExcInternalError());
+
+        /* The tensor product kernels expect a lexicographic ordering: */
+        for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+          state_values_lexicographic[i] = state_values[lexicographic[i]];
+
+        for (unsigned int child = 0; child < dof_cell->n_children(); ++child) {
+          const auto child_cell = dof_cell->child(child);
+
+          Assert(child_cell->is_active(), dealii::ExcInternalError());
+          child_cell->get_dof_indices(dof_indices);
+
+          /* Step 1: build up right hand side on child cell: */
+
+          fe_values.reinit(child_cell);
+
+          if constexpr (std::is_same_v<Number, float>) {
+            mapping.transform_points_real_to_unit_cell(
+                dof_cell, fe_values.get_quadrature_points(), unit_points_temp);
+            std::transform(std::begin(unit_points_temp),
+                           std::end(unit_points_temp),
+                           std::begin(unit_points),
+                           [](const auto &x) { return x; });
+          } else {
+            mapping.transform_points_real_to_unit_cell(
+                dof_cell, fe_values.get_quadrature_points(), unit_points);
+          }
 
-              Assert(child_cell->is_active(), dealii::ExcInternalError());
-              child_cell->get_dof_indices(dof_indices);
+          for (auto &it : local_rhs)
+            it = state_type{};
 
-              /* Step 1: build up right hand side on child cell: */
+          for (unsigned int q = 0; q < quadrature.size(); ++q) {
+            auto coefficient = dealii::internal::evaluate_tensor_product_value(
+                polynomial_space,
+                make_const_array_view(state_values_lexicographic),
+                unit_points[q],
+                is_linear);
+            coefficient *= fe_values.JxW(q);
 
-              fe_values.reinit(child_cell);
+            for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+              local_rhs[i] += coefficient * fe_values.shape_value(i, q);
+          }
 
-              if constexpr (std::is_same_v<Number, float>) {
-                mapping.transform_points_real_to_unit_cell(
-                    dof_cell,
-                    fe_values.get_quadrature_points(),
-                    unit_points_temp);
-                std::transform(std::begin(unit_points_temp),
-                               std::end(unit_points_temp),
-                               std::begin(unit_points),
-                               [](const auto &x) { return x; });
-              } else {
-                mapping.transform_points_real_to_unit_cell(
-                    dof_cell, fe_values.get_quadrature_points(), unit_points);
-              }
+          /* Step 2: solve with inverse mass matrix on child cell: */
 
-              for (auto &it : local_rhs)
-                it = state_type{};
+          mi = 0.;
+          mij = 0.;
+          for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
+            for (unsigned int j = 0; j < n_dofs_per_cell; ++j) {
+              double sum = 0;
+              for (unsigned int q = 0; q < quadrature.size(); ++q)
+                sum += fe_values.shape_value(i, q) *
+                       fe_values.shape_value(j, q) * fe_values.JxW(q);
+              mij(i, j) = sum;
+              mi(i) += sum;
+            }
+          }
 
-              for (unsigned int q = 0; q < quadrature.size(); ++q) {
-                Assert(finite_element.degree == 1, dealii::ExcNotImplemented());
-                auto coefficient =
-                    dealii::internal::evaluate_tensor_product_value(
-                        polynomial_space,
-                        make_const_array_view(state_values),
-                        unit_points[q],
-                        /*is linear*/ true);
-                coefficient *= fe_values.JxW(q);
-
-                for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
-                  local_rhs[i] += coefficient * fe_values.shape_value(i, q);
-              }
+          mij.gauss_jordan();
 
-              /* Step 2: solve with inverse mass matrix on child cell: */
+          for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
+            state_type U_i;
+            for (unsigned int j = 0; j < n_dofs_per_cell; ++j) {
+              U_i += mij(i, j) * local_rhs[j];
+            }
 
-              mi = 0.;
-              mij = 0.;
-              for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
-                for (unsigned int j = 0; j < n_dofs_per_cell; ++j) {
-                  double sum = 0;
-                  for (unsigned int q = 0; q < quadrature.size(); ++q)
-                    sum += fe_values.shape_value(i, q) *
-                           fe_values.shape_value(j, q) * fe_values.JxW(q);
-                  mij(i, j) = sum;
-                  mi(i) += sum;
-                }
-              }
+            data.dof_indices.push_back(dof_indices[i]);
+            data.states.push_back(mi(i) * U_i);
+            data.masses.push_back(mi(i));
+          }
+        } /*child*/
+      } break;
 
-              mij.gauss_jordan();
+      case dealii::CellStatus::cell_invalid:
+        Assert(false, dealii::ExcInternalError());
+        __builtin_trap();
+        break;
+      }
+    }
 
-              for (unsigned int i = 0; i < n_dofs_per_cell; ++i) {
-                state_type U_i;
-                for (unsigned int j = 0; j < n_dofs_per_cell; ++j) {
-                  U_i += mij(i, j) * local_rhs[j];
-                }
+    RYUJIN_PARALLEL_REGION_END
 
-                const auto global_i = dof_indices[i];
-                add_tensor(projected_state, mi(i) * U_i, global_i);
-                projected_mass(global_i) += mi(i);
-              }
-            } /*child*/
-          } break;
+    /* Distribute all contributions: */
 
-          case dealii::CellStatus::cell_invalid:
-            Assert(false, dealii::ExcInternalError());
-            __builtin_trap();
-            break;
-          }
-        });
+    for (const auto &data : cell_data) {
+      for (std::size_t i = 0; i < data.dof_indices.size(); ++i) {
+        const auto global_i = data.dof_indices[i];
+        add_tensor(projected_state, data.states[i], global_i);
+        projected_mass(global_i) += data.masses[i];
+      }
+    }
 
     /*
      * Distribute values, take the weighted average of unconstrained
@@ -588,6 +690,8 @@ namespace ryujin
       projected_mass.compress(dealii::VectorOperation::add);
       projected_state.compress(dealii::VectorOperation::add);
 
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
       for (unsigned int local_i = 0; local_i < n_locally_owned; ++local_i) {
         const auto global_i = scalar_partitioner->local_to_global(local_i);
         if (affine_constraints.is_constrained(global_i))
@@ -597,6 +701,8 @@ namespace ryujin
         const auto m_i = projected_mass.local_element(local_i);
         new_U.write_tensor(U_i / m_i, local_i);
       }
+      RYUJIN_PARALLEL_REGION_END
+
       new_U.update_ghost_values();
     };
 
@@ -1,6 +1,6 @@
 //
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
-// Copyright (C) 2020 - 2023 by the ryujin authors
+// Copyright (C) 2020 - 2024 by the ryujin authors
 //
 
 #include <compile_time_options.h>
@@ -11,9 +11,41 @@ namespace ryujin
 {
   /* instantiations */
 
-  template class SparsityPatternSIMD<dealii::VectorizedArray<NUMBER>::size()>;
+  template class SparsityPatternSIMD<simd_width<NUMBER>>;
 
   template class SparseMatrixSIMD<NUMBER, 1>;
   template class SparseMatrixSIMD<NUMBER, 2>;
   template class SparseMatrixSIMD<NUMBER, 3>;
+
+  template class SymmetricSparseMatrixSIMD<NUMBER>;
+
+#ifdef PRECISION_SWITCH
+  /*
+   * The sparsity pattern for float coincides with the one for double if
+   * the SIMD width is scalar or capped by SIMD_WIDTH:
+   */
+#if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128 &&                              \
+    (SIMD_WIDTH == 0 || SIMD_WIDTH > DEAL_II_VECTORIZATION_WIDTH_IN_BITS / 64)
+  static_assert(simd_width<float> != simd_width<NUMBER>);
+  template class SparsityPatternSIMD<simd_width<float>>;
+#endif
+
+  template class SparseMatrixSIMD<float, 1>;
+  template class SparseMatrixSIMD<float, 2>;
+  template class SparseMatrixSIMD<float, 3>;
+
+  template class SymmetricSparseMatrixSIMD<float>;
+#endif
+
+#ifdef MIXED_PRECISION_STORAGE
+  /*
+   * Note: An explicit instantiation cannot name an alias template such as
+   * StorageSparseMatrixSIMD, spell out the class template instead:
+   */
+  template class SparseMatrixSIMD<NUMBER, 1, simd_width<NUMBER>, float>;
+  template class SparseMatrixSIMD<NUMBER, 2, simd_width<NUMBER>, float>;
+  template class SparseMatrixSIMD<NUMBER, 3, simd_width<NUMBER>, float>;
+
+  template class SymmetricSparseMatrixSIMD<NUMBER, simd_width<NUMBER>, float>;
+#endif
 } /* namespace ryujin */
@@ -5,13 +5,22 @@
 
 #pragma once
 
+#include <compile_time_options.h>
+
 #include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 
+#include "lazy.h"
+#include "memory_pool.h"
+#include "numa.h"
 #include "openmp.h"
 #include "simd.h"
 
+#include <algorithm>
+#include <iosfwd>
+#include <map>
+
 namespace ryujin
 {
   namespace
@@ -32,11 +41,100 @@ namespace ryujin
   } // namespace
 
 
+  /**
+   * A small container holding persistent MPI requests (set up with
+   * MPI_Recv_init() and MPI_Send_init()) for every communication channel
+   * used by a SparseMatrixSIMD. The requests are bound to the data and
+   * exchange buffer of the owning matrix. The container thus never copies
+   * requests but frees them on assignment and destruction.
+   *
+   * @ingroup SIMD
+   */
+  class PersistentMPIRequests
+  {
+  public:
+    PersistentMPIRequests() = default;
+
+    PersistentMPIRequests(const PersistentMPIRequests &) {}
+
+    PersistentMPIRequests &operator=(const PersistentMPIRequests &)
+    {
+      clear();
+      return *this;
+    }
+
+    ~PersistentMPIRequests()
+    {
+      clear();
+    }
+
+    /**
+     * Free all requests.
+     */
+    void clear()
+    {
+#ifdef DEAL_II_WITH_MPI
+      for (auto &[channel, channel_requests] : requests)
+        for (auto &request : channel_requests)
+          if (request != MPI_REQUEST_NULL)
+            MPI_Request_free(&request);
+#endif
+      requests.clear();
+    }
+
+    /**
+     * Persistent requests for a given communication channel. The first
+     * entries are receive requests, followed by send requests.
+     */
+    std::map<unsigned int, std::vector<MPI_Request>> requests;
+
+    /**
+     * The communication channel of the currently active exchange.
+     */
+    unsigned int active_channel = 0;
+  };
+
+
   template <typename Number,
             int n_components = 1,
-            int simd_length = dealii::VectorizedArray<Number>::size()>
+            int simd_length = simd_width<Number>,
+            typename StorageNumber = Number>
   class SparseMatrixSIMD;
 
+  template <typename Number,
+            int simd_length = simd_width<Number>,
+            typename StorageNumber = Number>
+  class SymmetricSparseMatrixSIMD;
+
+
+  /**
+   * The floating point type used for storing sparse matrices that hold
+   * geometric information (c_ij, m_ij, ...) and limiter coefficients
+   * (d_ij, l_ij). If the compile-time option MIXED_PRECISION_STORAGE is
+   * set we store these matrices in single precision, otherwise we use
+   * the principal Number type.
+   */
+#ifdef MIXED_PRECISION_STORAGE
+  template <typename Number>
+  using storage_number_type = float;
+#else
+  template <typename Number>
+  using storage_number_type = Number;
+#endif
+
+
+  /**
+   * A SparseMatrixSIMD that stores its entries with the (potentially
+   * reduced) precision defined by storage_number_type. All arithmetic is
+   * still performed with type Number.
+   */
+  template <typename Number, int n_components = 1>
+  using StorageSparseMatrixSIMD =
+      SparseMatrixSIMD<Number,
+                       n_components,
+                       simd_width<Number>,
+                       storage_number_type<Number>>;
+
   /**
    * A specialized sparsity pattern for efficient vectorized SIMD access.
    *
@@ -99,6 +197,23 @@ namespace ryujin
 
     const unsigned int *columns(const unsigned int row) const;
 
+    /**
+     * Return a pointer to the column indices of the entry given by @p row
+     * and @p position_within_column. For row indices in the range [0,
+     * n_internal_dofs) the pointer refers to an array of length
+     * simd_length - row % simd_length, otherwise the array has length 1.
+     *
+     * If the compile-time option COMPRESSED_COLUMN_INDICES is set the
+     * column indices are decoded from a compressed 16 bit representation
+     * into the supplied @p buffer (which must have at least size
+     * simd_length) and the function returns a pointer to @p buffer.
+     * Otherwise, the function returns a pointer into the uncompressed
+     * column index array and @p buffer is unused.
+     */
+    const unsigned int *columns(const unsigned int row,
+                                const unsigned int position_within_column,
+                                unsigned int *buffer) const;
+
     unsigned int row_length(const unsigned int row) const;
 
     unsigned int n_rows() const;
@@ -114,6 +229,19 @@ namespace ryujin
     dealii::AlignedVector<unsigned int> column_indices;
     dealii::AlignedVector<unsigned int> indices_transposed;
 
+#ifdef COMPRESSED_COLUMN_INDICES
+    /**
+     * Compressed column indices stored as the (signed) difference between
+     * the column and the row index. Differences that do not fit into 16
+     * bits are marked with the value delta_fallback, in which case the
+     * column index is read from column_indices.
+     */
+    dealii::AlignedVector<std::int16_t> column_deltas;
+
+    static constexpr std::int16_t delta_fallback =
+        std::numeric_limits<std::int16_t>::min();
+#endif
+
     /**
      * Array listing all (locally owned) entries as a pair {row,
      * position_within_column}, potentially duplicated, and arranged
@@ -141,10 +269,46 @@ namespace ryujin
      */
     std::vector<std::pair<unsigned int, unsigned int>> receive_targets;
 
+    /**
+     * Variants of send_targets and receive_targets used by
+     * SparseMatrixSIMD::update_transposed_entries_start() that skip all
+     * diagonal entries: The ranges of transposed_send_targets index into
+     * the off-diagonal entries of entries_to_be_sent, the ranges of
+     * transposed_receive_targets index into the off-diagonal entries of
+     * the ghost rows (in consecutive order).
+     */
+    std::vector<std::pair<unsigned int, unsigned int>> transposed_send_targets;
+    std::vector<std::pair<unsigned int, unsigned int>>
+        transposed_receive_targets;
+
     MPI_Comm mpi_communicator;
 
-    template <typename, int, int>
+    /**
+     * A map that assigns every entry of the sparsity pattern a position
+     * in a compressed storage that only holds the diagonal and the upper
+     * triangular part (in local indexing). Entries of the lower
+     * triangular part are mapped to the position of their transposed
+     * entry. The map is only computed on demand when a
+     * SymmetricSparseMatrixSIMD is initialized with this sparsity
+     * pattern.
+     */
+    mutable Lazy<dealii::AlignedVector<unsigned int>> indices_symmetric;
+
+    /**
+     * The number of entries in the compressed symmetric storage.
+     */
+    mutable std::size_t n_symmetric_elements;
+
+    /**
+     * Populate indices_symmetric and n_symmetric_elements.
+     */
+    void compute_indices_symmetric() const;
+
+    template <typename, int, int, typename>
     friend class SparseMatrixSIMD;
+
+    template <typename, int, typename>
+    friend class SymmetricSparseMatrixSIMD;
   };
 
 
@@ -156,8 +320,17 @@ namespace ryujin
    * SparsityPatternSIMD for details). For the non-vectorized row index
    * region [n_internal_dofs, n_locally_relevant_dofs) we store the matrix in
    * CSR format (equivalent to the static dealii::SparsityPattern).
+   *
+   * The (optional) template parameter @p StorageNumber specifies the
+   * floating point type used for storing the matrix entries. All access
+   * functions convert to and from type @p Number (or a vectorized array
+   * thereof). This allows to store matrices in single precision while
+   * performing all arithmetic in double precision.
    */
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   class SparseMatrixSIMD
   {
   public:
@@ -175,6 +348,38 @@ namespace ryujin
     void read_in(const SparseMatrix &sparse_matrix,
                  bool locally_indexed = true);
 
+    /**
+     * Set all matrix entries (including ghost rows) to zero.
+     */
+    void set_zero();
+
+    /**
+     * Write all matrix entries (including ghost rows) in binary format to
+     * the stream @p out. The sparsity pattern is not written.
+     */
+    void block_write(std::ostream &out) const;
+
+    /**
+     * Read all matrix entries in binary format from the stream @p in. The
+     * matrix must have been initialized with the sparsity pattern that
+     * was used when calling block_write().
+     */
+    void block_read(std::istream &in);
+
+    /**
+     * Move the matrix entries into an MPI-3 shared memory window that is
+     * collective over @p communicator. The entries of the first rank of
+     * @p communicator are copied into the window, all ranks then refer to
+     * this single copy. The function returns the window, which has to be
+     * freed (collectively) by the caller with MPI_Win_free() once the
+     * matrix is reinitialized or destroyed.
+     *
+     * @pre All ranks of @p communicator must share the same compute node
+     * and have to hold a matrix with an identical sparsity pattern. The
+     * matrix must not be modified afterwards.
+     */
+    MPI_Win share_data(const MPI_Comm &communicator);
+
     using VectorizedArray = dealii::VectorizedArray<Number, simd_length>;
 
     /**
@@ -296,11 +501,131 @@ namespace ryujin
 
     void update_ghost_rows();
 
+    /**
+     * Variant of update_ghost_rows_start() that only exchanges the
+     * off-diagonal entries of all ghost rows. These are exactly the
+     * entries that are transposed to locally owned entries, i.e., the
+     * entries accessed by get_transposed_entry(). The diagonal entries
+     * of ghost rows are left untouched.
+     *
+     * This reduces the message size of an exchange by one entry per ghost
+     * row and is used for the limiter coefficients l_ij, for which only
+     * the transposed entries l_ji of cross-rank pairs are ever read.
+     *
+     * @note The exchange always uses nonpersistent MPI requests.
+     */
+    void
+    update_transposed_entries_start(const unsigned int communication_channel);
+
+    /**
+     * Complete an exchange started with update_transposed_entries_start().
+     */
+    void update_transposed_entries_finish();
+
   protected:
     const SparsityPatternSIMD<simd_length> *sparsity;
-    dealii::AlignedVector<Number> data;
-    dealii::AlignedVector<Number> exchange_buffer;
+    PooledVector<StorageNumber> data;
+    PooledVector<StorageNumber> exchange_buffer;
+    PooledVector<StorageNumber> transposed_buffer;
     std::vector<MPI_Request> requests;
+    std::vector<MPI_Request> transposed_requests;
+#ifdef PERSISTENT_MPI_REQUESTS
+    PersistentMPIRequests persistent_requests;
+#endif
+  };
+
+
+  /**
+   * A scalar-valued sparse matrix for efficient vectorized SIMD access
+   * that stores symmetric matrices (in local indexing) compactly.
+   *
+   * The class exposes the same interface as a scalar-valued
+   * SparseMatrixSIMD. Internally, only the diagonal and the upper
+   * triangular part of the matrix are stored, every access to an entry of
+   * the lower triangular part is redirected to its transposed entry with
+   * the help of a precomputed index map stored in the SparsityPatternSIMD
+   * object. This roughly halves the memory footprint of the matrix at the
+   * expense of converting all vectorized loads and stores into gather and
+   * scatter operations.
+   *
+   * @note Writing to an entry of the lower triangular part is a no-op.
+   * This ensures that a vectorized write_entry() operating on a SIMD row
+   * chunk that straddles the diagonal does not race with the write of
+   * the transposed entry.
+   *
+   * @note All ghost rows only consist of a diagonal entry and entries
+   * that are transposed to locally owned entries. There is thus nothing
+   * to exchange and update_ghost_rows() is a no-op.
+   */
+  template <typename Number, int simd_length, typename StorageNumber>
+  class SymmetricSparseMatrixSIMD
+  {
+  public:
+    SymmetricSparseMatrixSIMD();
+
+    SymmetricSparseMatrixSIMD(const SparsityPatternSIMD<simd_length> &sparsity);
+
+    void reinit(const SparsityPatternSIMD<simd_length> &sparsity);
+
+    using VectorizedArray = dealii::VectorizedArray<Number, simd_length>;
+
+    /**
+     * Return the entry indexed by @p row and @p position_within_column.
+     *
+     * @note If the template argument @a Number2
+     * is a vetorized array a gather operation will be performed.
+     * In this case the index @p row must be within the interval
+     * [0, n_internal_dofs) and must be divisible by simd_length.
+     */
+    template <typename Number2 = Number>
+    Number2 get_entry(const unsigned int row,
+                      const unsigned int position_within_column) const;
+
+    /**
+     * Return the transposed entry indexed by @p row and
+     * @p position_within_column. For a symmetric matrix this is equal to
+     * get_entry().
+     */
+    template <typename Number2 = Number>
+    Number2
+    get_transposed_entry(const unsigned int row,
+                         const unsigned int position_within_column) const;
+
+    /**
+     * Write a (scalar valued) @p entry to the matrix indexed by @p row
+     * and @p position_within_column.
+     *
+     * @note If the template argument @a Number2
+     * is a vetorized array a scatter operation will be performed.
+     * In this case the index @p row must be within the interval
+     * [0, n_internal_dofs) and must be divisible by simd_length. The
+     * parameter @p do_streaming_store is ignored.
+     */
+    template <typename Number2 = Number>
+    void write_entry(const Number2 entry,
+                     const unsigned int row,
+                     const unsigned int position_within_column,
+                     const bool do_streaming_store = false);
+
+    /* Synchronize over MPI ranks (no-op): */
+
+    void update_ghost_rows_start(const unsigned int communication_channel = 0);
+
+    void update_ghost_rows_finish();
+
+    void update_ghost_rows();
+
+  protected:
+    /**
+     * Return a pointer into the index map for the given @p row and
+     * @p position_within_column.
+     */
+    const unsigned int *
+    symmetric_index(const unsigned int row,
+                    const unsigned int position_within_column) const;
+
+    const SparsityPatternSIMD<simd_length> *sparsity;
+    PooledVector<StorageNumber> data;
   };
 
   /*
@@ -335,6 +660,47 @@ namespace ryujin
   }
 
 
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  SparsityPatternSIMD<simd_length>::columns(
+      const unsigned int row,
+      const unsigned int position_within_column,
+      [[maybe_unused]] unsigned int *buffer) const
+  {
+    AssertIndexRange(row, row_starts.size() - 1);
+    AssertIndexRange(position_within_column, row_length(row));
+
+#ifdef COMPRESSED_COLUMN_INDICES
+    std::size_t position;
+    unsigned int n_lanes;
+    if (row < n_internal_dofs) {
+      position = row_starts[row / simd_length] +
+                 position_within_column * simd_length + row % simd_length;
+      n_lanes = simd_length - row % simd_length;
+    } else {
+      position = row_starts[row] + position_within_column;
+      n_lanes = 1;
+    }
+
+    const std::int16_t *deltas = column_deltas.data() + position;
+
+    for (unsigned int k = 0; k < n_lanes; ++k) {
+      if (RYUJIN_UNLIKELY(deltas[k] == delta_fallback))
+        buffer[k] = column_indices[position + k];
+      else
+        buffer[k] = row + k + deltas[k];
+    }
+
+    return buffer;
+#else
+    if (row < n_internal_dofs)
+      return columns(row) + position_within_column * simd_length;
+    else
+      return columns(row) + position_within_column;
+#endif
+  }
+
+
   template <int simd_length>
   DEAL_II_ALWAYS_INLINE inline unsigned int
   SparsityPatternSIMD<simd_length>::row_length(const unsigned int row) const
@@ -368,11 +734,15 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename Number2>
   DEAL_II_ALWAYS_INLINE inline auto
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_entry(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_entry(const unsigned int row,
+                const unsigned int position_within_column) const
       -> EntryType<Number2>
   {
     const auto result = get_tensor<Number2>(row, position_within_column);
@@ -383,11 +753,15 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename Number2>
   DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_tensor(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_tensor(const unsigned int row,
+                 const unsigned int position_within_column) const
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
     AssertIndexRange(row, sparsity->row_starts.size() - 1);
@@ -431,13 +805,20 @@ namespace ryujin
              dealii::ExcMessage(
                  "Access only supported for rows at the SIMD granularity"));
 
-      const Number *load_pos =
+      const StorageNumber *load_pos =
           data.data() + (sparsity->row_starts[row / simd_length] +
                          position_within_column * simd_length) *
                             n_components;
 
-      for (unsigned int d = 0; d < n_components; ++d)
-        result[d].load(load_pos + d * simd_length);
+      if constexpr (std::is_same<Number, StorageNumber>::value) {
+        for (unsigned int d = 0; d < n_components; ++d)
+          result[d].load(load_pos + d * simd_length);
+      } else {
+        /* Convert from storage type: */
+        for (unsigned int d = 0; d < n_components; ++d)
+          for (unsigned int k = 0; k < simd_length; ++k)
+            result[d][k] = load_pos[d * simd_length + k];
+      }
 
     } else {
       /* not implemented */
@@ -448,11 +829,15 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename Number2>
   DEAL_II_ALWAYS_INLINE inline auto
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_entry(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_transposed_entry(const unsigned int row,
+                           const unsigned int position_within_column) const
       -> EntryType<Number2>
   {
     const auto result =
@@ -464,11 +849,15 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename Number2>
   DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_tensor(
-      const unsigned int row, const unsigned int position_within_column) const
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      get_transposed_tensor(const unsigned int row,
+                            const unsigned int position_within_column) const
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
     AssertIndexRange(row, sparsity->row_starts.size() - 1);
@@ -542,8 +931,14 @@ namespace ryujin
 
       const unsigned int offset = sparsity->row_starts[row / simd_length] +
                                   position_within_column * simd_length;
-      result[0].gather(data.data(),
-                       sparsity->indices_transposed.data() + offset);
+      if constexpr (std::is_same<Number, StorageNumber>::value) {
+        result[0].gather(data.data(),
+                         sparsity->indices_transposed.data() + offset);
+      } else {
+        /* Convert from storage type: */
+        for (unsigned int k = 0; k < simd_length; ++k)
+          result[0][k] = data[sparsity->indices_transposed[offset + k]];
+      }
 
     } else {
       /* not implemented */
@@ -554,14 +949,17 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename Number2>
   DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_entry(
-      const Number2 entry,
-      const unsigned int row,
-      const unsigned int position_within_column,
-      const bool do_streaming_store)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      write_entry(const Number2 entry,
+                  const unsigned int row,
+                  const unsigned int position_within_column,
+                  const bool do_streaming_store)
   {
     static_assert(
         n_components == 1,
@@ -579,14 +977,17 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename Number2>
   DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_entry(
-      const dealii::Tensor<1, n_components, Number2> &entry,
-      const unsigned int row,
-      const unsigned int position_within_column,
-      const bool do_streaming_store)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      write_entry(const dealii::Tensor<1, n_components, Number2> &entry,
+                  const unsigned int row,
+                  const unsigned int position_within_column,
+                  const bool do_streaming_store)
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
     AssertIndexRange(row, sparsity->row_starts.size() - 1);
@@ -606,13 +1007,13 @@ namespace ryujin
           data[(sparsity->row_starts[simd_row] +
                 position_within_column * simd_length) *
                    n_components +
-               d * simd_length + simd_offset] = entry[d];
+               d * simd_length + simd_offset] = StorageNumber(entry[d]);
       } else {
         // go through standard part
         for (unsigned int d = 0; d < n_components; ++d)
           data[(sparsity->row_starts[row] + position_within_column) *
                    n_components +
-               d] = entry[d];
+               d] = StorageNumber(entry[d]);
       }
 
     } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
@@ -628,11 +1029,16 @@ namespace ryujin
              dealii::ExcMessage(
                  "Access only supported for rows at the SIMD granularity"));
 
-      Number *store_pos =
+      StorageNumber *store_pos =
           data.data() + (sparsity->row_starts[row / simd_length] +
                          position_within_column * simd_length) *
                             n_components;
-      if (do_streaming_store)
+      if constexpr (!std::is_same<Number, StorageNumber>::value) {
+        /* Convert to storage type: */
+        for (unsigned int d = 0; d < n_components; ++d)
+          for (unsigned int k = 0; k < simd_length; ++k)
+            store_pos[d * simd_length + k] = StorageNumber(entry[d][k]);
+      } else if (do_streaming_store)
         for (unsigned int d = 0; d < n_components; ++d)
           entry[d].streaming_store(store_pos + d * simd_length);
       else
@@ -646,10 +1052,13 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows_start(
-      const unsigned int communication_channel)
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_ghost_rows_start(const unsigned int communication_channel)
   {
 #ifdef DEAL_II_WITH_MPI
     AssertIndexRange(communication_channel, 200);
@@ -662,36 +1071,106 @@ namespace ryujin
            dealii::ExcInternalError());
 
     const std::size_t n_indices = sparsity->entries_to_be_sent.size();
-    exchange_buffer.resize_fast(n_components * n_indices);
 
-    requests.resize(sparsity->receive_targets.size() +
-                    sparsity->send_targets.size());
+    const auto &receive_targets = sparsity->receive_targets;
+    const auto &send_targets = sparsity->send_targets;
 
     /*
-     * Set up MPI receive requests. We will always receive data for indices
-     * in the range [n_locally_owned_, n_locally_relevant_), thus the DATA
-     * is stored in non-vectorized CSR format.
+     * We will always receive data for indices in the range
+     * [n_locally_owned_, n_locally_relevant_), thus the DATA is stored in
+     * non-vectorized CSR format.
      */
 
-    {
-      const auto &targets = sparsity->receive_targets;
-      for (unsigned int p = 0; p < targets.size(); ++p) {
-        const int ierr = MPI_Irecv(
-            data.data() +
-                n_components *
-                    (sparsity->row_starts[sparsity->n_locally_owned_dofs] +
-                     (p == 0 ? 0 : targets[p - 1].second)),
-            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
-                n_components * sizeof(Number),
-            MPI_BYTE,
-            targets[p].first,
-            mpi_tag,
-            sparsity->mpi_communicator,
-            &requests[p]);
+    const auto receive_buffer = [&](const unsigned int p) {
+      return data.data() +
+             n_components *
+                 (sparsity->row_starts[sparsity->n_locally_owned_dofs] +
+                  (p == 0 ? 0 : receive_targets[p - 1].second));
+    };
+
+    const auto send_buffer = [&](const unsigned int p) {
+      return exchange_buffer.data() +
+             n_components * (p == 0 ? 0 : send_targets[p - 1].second);
+    };
+
+    const auto message_size = [](const auto &targets, const unsigned int p) {
+      return (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
+             n_components * sizeof(StorageNumber);
+    };
+
+#ifdef PERSISTENT_MPI_REQUESTS
+    /*
+     * Set up persistent MPI requests for the given communication channel
+     * on first use and start all receive requests:
+     */
+
+    auto &channel_requests =
+        persistent_requests.requests[communication_channel];
+    persistent_requests.active_channel = communication_channel;
+
+    if (channel_requests.size() !=
+        receive_targets.size() + send_targets.size()) {
+      /*
+       * Both buffers must not be reallocated once requests are bound to
+       * them. The exchange buffer has the same size for all channels.
+       */
+      exchange_buffer.resize_fast(n_components * n_indices);
+
+      channel_requests.resize(receive_targets.size() + send_targets.size());
+
+      for (unsigned int p = 0; p < receive_targets.size(); ++p) {
+        const int ierr = MPI_Recv_init(receive_buffer(p),
+                                       message_size(receive_targets, p),
+                                       MPI_BYTE,
+                                       receive_targets[p].first,
+                                       mpi_tag,
+                                       sparsity->mpi_communicator,
+                                       &channel_requests[p]);
+        AssertThrowMPI(ierr);
+      }
+
+      for (unsigned int p = 0; p < send_targets.size(); ++p) {
+        const int ierr =
+            MPI_Send_init(send_buffer(p),
+                          message_size(send_targets, p),
+                          MPI_BYTE,
+                          send_targets[p].first,
+                          mpi_tag,
+                          sparsity->mpi_communicator,
+                          &channel_requests[receive_targets.size() + p]);
         AssertThrowMPI(ierr);
       }
     }
 
+    Assert(exchange_buffer.size() == n_components * n_indices,
+           dealii::ExcInternalError());
+
+    {
+      const int ierr =
+          MPI_Startall(receive_targets.size(), channel_requests.data());
+      AssertThrowMPI(ierr);
+    }
+#else
+    exchange_buffer.resize_fast(n_components * n_indices);
+
+    requests.resize(receive_targets.size() + send_targets.size());
+
+    /*
+     * Set up MPI receive requests.
+     */
+
+    for (unsigned int p = 0; p < receive_targets.size(); ++p) {
+      const int ierr = MPI_Irecv(receive_buffer(p),
+                                 message_size(receive_targets, p),
+                                 MPI_BYTE,
+                                 receive_targets[p].first,
+                                 mpi_tag,
+                                 sparsity->mpi_communicator,
+                                 &requests[p]);
+      AssertThrowMPI(ierr);
+    }
+#endif
+
     /*
      * Copy all entries that we plan to send over to the exchange buffer.
      * Here, we have to be careful with indices falling into the "locally
@@ -731,44 +1210,352 @@ namespace ryujin
      * of the receiving MPI rank.
      */
 
+#ifdef PERSISTENT_MPI_REQUESTS
     {
-      const auto &targets = sparsity->send_targets;
-      for (unsigned int p = 0; p < targets.size(); ++p) {
-        const int ierr = MPI_Isend(
-            exchange_buffer.data() +
-                n_components * (p == 0 ? 0 : targets[p - 1].second),
-            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
-                n_components * sizeof(Number),
-            MPI_BYTE,
-            targets[p].first,
-            mpi_tag,
-            sparsity->mpi_communicator,
-            &requests[p + sparsity->receive_targets.size()]);
-        AssertThrowMPI(ierr);
-      }
+      const int ierr =
+          MPI_Startall(send_targets.size(),
+                       channel_requests.data() + receive_targets.size());
+      AssertThrowMPI(ierr);
     }
+#else
+    for (unsigned int p = 0; p < send_targets.size(); ++p) {
+      const int ierr = MPI_Isend(send_buffer(p),
+                                 message_size(send_targets, p),
+                                 MPI_BYTE,
+                                 send_targets[p].first,
+                                 mpi_tag,
+                                 sparsity->mpi_communicator,
+                                 &requests[p + receive_targets.size()]);
+      AssertThrowMPI(ierr);
+    }
+#endif
 #endif
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  inline void SparseMatrixSIMD<Number, n_components, simd_length>::
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
       update_ghost_rows_finish()
   {
 #ifdef DEAL_II_WITH_MPI
-    const int ierr =
-        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#ifdef PERSISTENT_MPI_REQUESTS
+    auto &active_requests =
+        persistent_requests.requests[persistent_requests.active_channel];
+#else
+    auto &active_requests = requests;
+#endif
+    const int ierr = MPI_Waitall(active_requests.size(),
+                                 active_requests.data(),
+                                 MPI_STATUSES_IGNORE);
     AssertThrowMPI(ierr);
 #endif
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows()
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_ghost_rows()
   {
     update_ghost_rows_start();
     update_ghost_rows_finish();
   }
 
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_transposed_entries_start(const unsigned int communication_channel)
+  {
+#ifdef DEAL_II_WITH_MPI
+    AssertIndexRange(communication_channel, 200);
+
+    const unsigned int mpi_tag =
+        dealii::Utilities::MPI::internal::Tags::partitioner_export_start +
+        communication_channel;
+    Assert(mpi_tag <=
+               dealii::Utilities::MPI::internal::Tags::partitioner_export_end,
+           dealii::ExcInternalError());
+
+    const auto &receive_targets = sparsity->transposed_receive_targets;
+    const auto &send_targets = sparsity->transposed_send_targets;
+
+    const std::size_t n_receive =
+        receive_targets.empty() ? 0 : receive_targets.back().second;
+    const std::size_t n_send =
+        send_targets.empty() ? 0 : send_targets.back().second;
+
+    /*
+     * We receive into the first and send from the second part of the
+     * transposed_buffer. The receive part is unpacked into the ghost rows
+     * by update_transposed_entries_finish().
+     */
+    transposed_buffer.resize_fast(n_components * (n_receive + n_send));
+
+    const auto receive_buffer = [&](const unsigned int p) {
+      return transposed_buffer.data() +
+             n_components * (p == 0 ? 0 : receive_targets[p - 1].second);
+    };
+
+    const auto send_buffer = [&](const unsigned int p) {
+      return transposed_buffer.data() +
+             n_components *
+                 (n_receive + (p == 0 ? 0 : send_targets[p - 1].second));
+    };
+
+    const auto message_size = [](const auto &targets, const unsigned int p) {
+      return (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
+             n_components * sizeof(StorageNumber);
+    };
+
+    transposed_requests.resize(receive_targets.size() + send_targets.size());
+
+    for (unsigned int p = 0; p < receive_targets.size(); ++p) {
+      const int ierr = MPI_Irecv(receive_buffer(p),
+                                 message_size(receive_targets, p),
+                                 MPI_BYTE,
+                                 receive_targets[p].first,
+                                 mpi_tag,
+                                 sparsity->mpi_communicator,
+                                 &transposed_requests[p]);
+      AssertThrowMPI(ierr);
+    }
+
+    /* Copy all off-diagonal entries that we plan to send: */
+
+    StorageNumber *destination = send_buffer(0);
+    for (const auto &[row, position_within_column] :
+         sparsity->entries_to_be_sent) {
+      if (position_within_column == 0)
+        continue;
+
+      if (row < sparsity->n_internal_dofs) {
+        // go through vectorized part
+        const unsigned int simd_row = row / simd_length;
+        const unsigned int simd_offset = row % simd_length;
+        for (unsigned int d = 0; d < n_components; ++d)
+          *destination++ = data[(sparsity->row_starts[simd_row] +
+                                 position_within_column * simd_length) *
+                                    n_components +
+                                d * simd_length + simd_offset];
+      } else {
+        // go through standard part
+        for (unsigned int d = 0; d < n_components; ++d)
+          *destination++ =
+              data[(sparsity->row_starts[row] + position_within_column) *
+                       n_components +
+                   d];
+      }
+    }
+
+    for (unsigned int p = 0; p < send_targets.size(); ++p) {
+      const int ierr =
+          MPI_Isend(send_buffer(p),
+                    message_size(send_targets, p),
+                    MPI_BYTE,
+                    send_targets[p].first,
+                    mpi_tag,
+                    sparsity->mpi_communicator,
+                    &transposed_requests[p + receive_targets.size()]);
+      AssertThrowMPI(ierr);
+    }
+#endif
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      update_transposed_entries_finish()
+  {
+#ifdef DEAL_II_WITH_MPI
+    const int ierr = MPI_Waitall(transposed_requests.size(),
+                                 transposed_requests.data(),
+                                 MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
+
+    /*
+     * Unpack the received off-diagonal entries into the ghost rows, which
+     * are stored in non-vectorized CSR format:
+     */
+
+    const StorageNumber *source = transposed_buffer.data();
+    const unsigned int n_rows = sparsity->row_starts.size() - 1;
+    for (unsigned int row = sparsity->n_locally_owned_dofs; row < n_rows;
+         ++row) {
+      const std::size_t begin = sparsity->row_starts[row] + 1;
+      const std::size_t end = sparsity->row_starts[row + 1];
+      std::copy(source,
+                source + n_components * (end - begin),
+                data.data() + n_components * begin);
+      source += n_components * (end - begin);
+    }
+#endif
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::
+      symmetric_index(const unsigned int row,
+                      const unsigned int position_within_column) const
+  {
+    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
+    AssertIndexRange(row, sparsity->row_starts.size() - 1);
+    AssertIndexRange(position_within_column, sparsity->row_length(row));
+
+    const auto &indices = sparsity->indices_symmetric.value();
+
+    if (row < sparsity->n_internal_dofs) {
+      // go through vectorized part
+      const unsigned int simd_row = row / simd_length;
+      const unsigned int simd_offset = row % simd_length;
+      return indices.data() + sparsity->row_starts[simd_row] +
+             position_within_column * simd_length + simd_offset;
+    } else {
+      // go through standard part
+      return indices.data() + sparsity->row_starts[row] +
+             position_within_column;
+    }
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline Number2
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::get_entry(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+    const unsigned int *index = symmetric_index(row, position_within_column);
+
+    if constexpr (std::is_same<Number, Number2>::value) {
+      /*
+       * Non-vectorized slow access. Supports all row indices in
+       * [0,n_owned)
+       */
+      return data[*index];
+
+    } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+      /*
+       * Vectorized access. Indices must be in the range [0,n_internal),
+       * index must be divisible by simd_length
+       */
+
+      Assert(row < sparsity->n_internal_dofs,
+             dealii::ExcMessage(
+                 "Vectorized access only possible in vectorized part"));
+      Assert(row % simd_length == 0,
+             dealii::ExcMessage(
+                 "Access only supported for rows at the SIMD granularity"));
+
+      Number2 result;
+      if constexpr (std::is_same<Number, StorageNumber>::value) {
+        result.gather(data.data(), index);
+      } else {
+        /* Convert from storage type: */
+        for (unsigned int k = 0; k < simd_length; ++k)
+          result[k] = data[index[k]];
+      }
+      return result;
+
+    } else {
+      /* not implemented */
+      __builtin_trap();
+    }
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline Number2
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::
+      get_transposed_entry(const unsigned int row,
+                           const unsigned int position_within_column) const
+  {
+    return get_entry<Number2>(row, position_within_column);
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline void
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::write_entry(
+      const Number2 entry,
+      const unsigned int row,
+      const unsigned int position_within_column,
+      const bool /*do_streaming_store*/)
+  {
+    const unsigned int *index = symmetric_index(row, position_within_column);
+    const unsigned int *column =
+        sparsity->column_indices.data() +
+        (index - sparsity->indices_symmetric.value().data());
+
+    if constexpr (std::is_same<Number, Number2>::value) {
+      /*
+       * Non-vectorized slow access. Supports all row indices in
+       * [0,n_owned)
+       */
+      if (*column >= row)
+        data[*index] = StorageNumber(entry);
+
+    } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+      /*
+       * Vectorized access. Indices must be in the range [0,n_internal),
+       * index must be divisible by simd_length
+       */
+
+      Assert(row < sparsity->n_internal_dofs,
+             dealii::ExcMessage(
+                 "Vectorized access only possible in vectorized part"));
+      Assert(row % simd_length == 0,
+             dealii::ExcMessage(
+                 "Access only supported for rows at the SIMD granularity"));
+
+      for (unsigned int k = 0; k < simd_length; ++k)
+        if (column[k] >= row + k)
+          data[index[k]] = StorageNumber(entry[k]);
+
+    } else {
+      /* not implemented */
+      __builtin_trap();
+    }
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  inline void
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::
+      update_ghost_rows_start(const unsigned int /*communication_channel*/)
+  {
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  inline void
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::
+      update_ghost_rows_finish()
+  {
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  inline void
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::
+      update_ghost_rows()
+  {
+  }
+
 } // namespace ryujin
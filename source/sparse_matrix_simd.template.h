@@ -10,14 +10,70 @@
 #include <deal.II/base/vectorization.h>
 #include <deal.II/lac/sparse_matrix.h>
 
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <utility>
+#include <vector>
+
 namespace ryujin
 {
+  namespace
+  {
+    template <typename Number>
+    using RowEntries =
+        std::vector<std::pair<dealii::types::global_dof_index, Number>>;
+
+    /*
+     * Copy the row @p row of @p sparse_matrix into @p entries sorted by
+     * column index. This works for dealii::SparseMatrix and
+     * TrilinosWrappers::SparseMatrix alike.
+     */
+    template <typename SparseMatrix, typename Number>
+    void gather_row(const SparseMatrix &sparse_matrix,
+                    const dealii::types::global_dof_index row,
+                    RowEntries<Number> &entries)
+    {
+      entries.clear();
+      for (auto it = sparse_matrix.begin(row); it != sparse_matrix.end(row);
+           ++it)
+        entries.emplace_back(it->column(), Number(it->value()));
+
+      std::sort(entries.begin(),
+                entries.end(),
+                [](const auto &left, const auto &right) {
+                  return left.first < right.first;
+                });
+    }
+
+    /*
+     * Return the entry with column index @p column of a row gathered with
+     * gather_row(), or zero if the entry is not stored.
+     */
+    template <typename Number>
+    Number lookup_entry(const RowEntries<Number> &entries,
+                        const dealii::types::global_dof_index column)
+    {
+      const auto it = std::lower_bound(
+          entries.begin(),
+          entries.end(),
+          column,
+          [](const auto &entry, const auto &value) {
+            return entry.first < value;
+          });
+      if (it == entries.end() || it->first != column)
+        return Number(0.);
+      return it->second;
+    }
+  } // namespace
+
 
   template <int simd_length>
   SparsityPatternSIMD<simd_length>::SparsityPatternSIMD()
       : n_internal_dofs(0)
       , row_starts(1)
       , mpi_communicator(MPI_COMM_SELF)
+      , n_symmetric_elements(0)
   {
   }
 
@@ -30,6 +86,7 @@ namespace ryujin
           &partitioner)
       : n_internal_dofs(0)
       , mpi_communicator(MPI_COMM_SELF)
+      , n_symmetric_elements(0)
   {
     reinit(n_internal_dofs, sparsity, partitioner);
   }
@@ -44,6 +101,10 @@ namespace ryujin
   {
     this->mpi_communicator = partitioner->get_mpi_communicator();
 
+    /* Invalidate the symmetric index map: */
+    indices_symmetric.reset();
+    n_symmetric_elements = 0;
+
     this->n_internal_dofs = n_internal_dofs;
     this->n_locally_owned_dofs = partitioner->locally_owned_size();
     this->partitioner = partitioner;
@@ -147,6 +208,34 @@ namespace ryujin
 
     Assert(col_ptr == column_indices.end(), dealii::ExcInternalError());
 
+#ifdef COMPRESSED_COLUMN_INDICES
+    /* Compute compressed column indices: */
+
+    column_deltas.resize_fast(column_indices.size());
+
+    const auto compress = [&](std::size_t position, unsigned int row) {
+      const auto delta = static_cast<std::int64_t>(column_indices[position]) -
+                         static_cast<std::int64_t>(row);
+      if (delta > std::numeric_limits<std::int16_t>::min() &&
+          delta <= std::numeric_limits<std::int16_t>::max())
+        column_deltas[position] = static_cast<std::int16_t>(delta);
+      else
+        column_deltas[position] = delta_fallback;
+    };
+
+    for (unsigned int i = 0; i < n_internal_dofs; i += simd_length) {
+      const std::size_t begin = row_starts[i / simd_length];
+      const std::size_t end = row_starts[i / simd_length + 1];
+      for (std::size_t position = begin; position < end; ++position)
+        compress(position, i + (position - begin) % simd_length);
+    }
+
+    for (unsigned int i = n_internal_dofs; i < sparsity.n_rows(); ++i)
+      for (std::size_t position = row_starts[i]; position < row_starts[i + 1];
+           ++position)
+        compress(position, i);
+#endif
+
     /* Compute the data exchange pattern: */
 
     if (sparsity.n_rows() > n_locally_owned_dofs) {
@@ -164,21 +253,27 @@ namespace ryujin
       const auto &ghost_targets = partitioner->ghost_targets();
 
       receive_targets.resize(ghost_targets.size());
+      transposed_receive_targets.resize(ghost_targets.size());
 
       for (unsigned int p = 0; p < receive_targets.size(); ++p) {
         receive_targets[p].first = ghost_targets[p].first;
+        transposed_receive_targets[p].first = ghost_targets[p].first;
       }
 
       const auto gt_begin = ghost_targets.begin();
       auto gt_ptr = ghost_targets.begin();
       std::size_t index = 0; /* index into ghost range of sparsity pattern */
+      std::size_t transposed_index = 0; /* same, but skipping diagonals */
       unsigned int row_count = 0;
 
       for (unsigned int i = n_locally_owned_dofs; i < sparsity.n_rows(); ++i) {
         index += sparsity.row_length(i);
+        transposed_index += sparsity.row_length(i) - 1;
         ++row_count;
         if (row_count == gt_ptr->second) {
           receive_targets[gt_ptr - gt_begin].second = index;
+          transposed_receive_targets[gt_ptr - gt_begin].second =
+              transposed_index;
           row_count = 0; /* reset row count and move on to new rank */
           ++gt_ptr;
         }
@@ -214,6 +309,8 @@ namespace ryujin
       const auto &import_targets = partitioner->import_targets();
       entries_to_be_sent.clear();
       send_targets.resize(import_targets.size());
+      transposed_send_targets.resize(import_targets.size());
+      unsigned int n_transposed_entries = 0;
       auto idx = import_indices_part.begin();
 
       /*
@@ -257,60 +354,257 @@ namespace ryujin
               const unsigned int position_within_column =
                   jt - sparsity.begin(row);
               entries_to_be_sent.emplace_back(row, position_within_column);
+              ++n_transposed_entries;
             }
           }
         }
 
         send_targets[p].first = partitioner->import_targets()[p].first;
         send_targets[p].second = entries_to_be_sent.size();
+        transposed_send_targets[p].first = send_targets[p].first;
+        transposed_send_targets[p].second = n_transposed_entries;
       }
     }
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  SparseMatrixSIMD<Number, n_components, simd_length>::SparseMatrixSIMD()
+  template <int simd_length>
+  void SparsityPatternSIMD<simd_length>::compute_indices_symmetric() const
+  {
+    indices_symmetric.ensure_initialized([&]() {
+      dealii::AlignedVector<unsigned int> indices;
+      indices.resize_fast(column_indices.size());
+
+      /*
+       * Iterate over all entries of the sparsity pattern and call the
+       * supplied function with the position and the (row, column) pair:
+       */
+      const auto for_each_entry = [&](const auto &payload) {
+        for (unsigned int i = 0; i < n_internal_dofs; i += simd_length) {
+          const std::size_t begin = row_starts[i / simd_length];
+          const std::size_t end = row_starts[i / simd_length + 1];
+          for (std::size_t position = begin; position < end; ++position) {
+            const unsigned int row = i + (position - begin) % simd_length;
+            payload(position, row, column_indices[position]);
+          }
+        }
+
+        for (unsigned int i = n_internal_dofs; i < n_rows(); ++i)
+          for (std::size_t position = row_starts[i];
+               position < row_starts[i + 1];
+               ++position)
+            payload(position, i, column_indices[position]);
+      };
+
+      /* First pass: enumerate the diagonal and upper triangular part: */
+      std::size_t n_elements = 0;
+      for_each_entry([&](std::size_t position, unsigned int row, auto column) {
+        if (column >= row)
+          indices[position] = n_elements++;
+      });
+
+      /* Second pass: point lower triangular entries to their transpose: */
+      for_each_entry([&](std::size_t position, unsigned int row, auto column) {
+        if (column < row) {
+          const auto transposed = indices_transposed[position];
+          Assert(column_indices[transposed] == row, dealii::ExcInternalError());
+          indices[position] = indices[transposed];
+        }
+      });
+
+      n_symmetric_elements = n_elements;
+      return indices;
+    });
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      SparseMatrixSIMD()
       : sparsity(nullptr)
   {
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  SparseMatrixSIMD<Number, n_components, simd_length>::SparseMatrixSIMD(
-      const SparsityPatternSIMD<simd_length> &sparsity)
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      SparseMatrixSIMD(const SparsityPatternSIMD<simd_length> &sparsity)
       : sparsity(&sparsity)
   {
     data.resize(sparsity.n_nonzero_elements() * n_components);
   }
 
 
-  template <typename Number, int n_components, int simd_length>
-  void SparseMatrixSIMD<Number, n_components, simd_length>::reinit(
-      const SparsityPatternSIMD<simd_length> &sparsity)
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      reinit(const SparsityPatternSIMD<simd_length> &sparsity)
   {
     this->sparsity = &sparsity;
+#ifdef PERSISTENT_MPI_REQUESTS
+    /* Requests are bound to the (old) data and exchange buffers: */
+    persistent_requests.clear();
+#endif
     data.resize(sparsity.n_nonzero_elements() * n_components);
+
+    /*
+     * Always first touch, also if the block was recycled by the
+     * MemoryPool: The pages of a recycled block were placed for the row
+     * partition of a different sparsity pattern. first_touch() releases
+     * and re-faults them with the thread partition of the new pattern.
+     */
+    NUMA::first_touch(
+        data.data(),
+        data.size(),
+        sparsity.n_internal_dofs,
+        sparsity.n_locally_owned_dofs,
+        simd_length,
+        [&](const unsigned int i) {
+          const auto &row_starts = sparsity.row_starts;
+          const std::size_t row =
+              i < sparsity.n_internal_dofs ? i / simd_length : i;
+          return std::make_pair(row_starts[row] * n_components,
+                                row_starts[row + 1] * n_components);
+        });
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void
+  SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::set_zero()
+  {
+    std::fill(data.begin(), data.end(), StorageNumber(0.));
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      block_write(std::ostream &out) const
+  {
+    const std::size_t size = data.size();
+    out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char *>(data.data()),
+              size * sizeof(StorageNumber));
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  void SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      block_read(std::istream &in)
+  {
+    std::size_t size = 0;
+    in.read(reinterpret_cast<char *>(&size), sizeof(size));
+    AssertThrow(in && size == data.size(),
+                dealii::ExcMessage("Stored matrix does not match the size of "
+                                   "the sparsity pattern."));
+    in.read(reinterpret_cast<char *>(data.data()),
+            size * sizeof(StorageNumber));
+    AssertThrow(in, dealii::ExcIO());
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
+  MPI_Win SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      share_data(const MPI_Comm &communicator)
+  {
+    const std::size_t size = data.size();
+    AssertThrow(
+        dealii::Utilities::MPI::min(size, communicator) ==
+            dealii::Utilities::MPI::max(size, communicator),
+        dealii::ExcMessage("Cannot share matrix entries between MPI ranks "
+                           "with different sparsity patterns."));
+
+    const bool owner =
+        dealii::Utilities::MPI::this_mpi_process(communicator) == 0;
+
+    StorageNumber *base = nullptr;
+    MPI_Win window;
+    int ierr = MPI_Win_allocate_shared(owner ? size * sizeof(StorageNumber) : 0,
+                                       sizeof(StorageNumber),
+                                       MPI_INFO_NULL,
+                                       communicator,
+                                       &base,
+                                       &window);
+    AssertThrowMPI(ierr);
+
+    MPI_Aint window_size;
+    int displacement_unit;
+    ierr = MPI_Win_shared_query(
+        window, 0, &window_size, &displacement_unit, &base);
+    AssertThrowMPI(ierr);
+
+    if (owner)
+      std::copy(data.begin(), data.end(), base);
+
+    /* Make sure that the window is populated before it is accessed: */
+    ierr = MPI_Barrier(communicator);
+    AssertThrowMPI(ierr);
+
+#ifdef PERSISTENT_MPI_REQUESTS
+    /* Requests are bound to the (old) data: */
+    persistent_requests.clear();
+#endif
+    data.set_external_storage(base);
+
+    return window;
+  }
+
+
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename SparseMatrix>
-  void SparseMatrixSIMD<Number, n_components, simd_length>::read_in(
-      const std::array<SparseMatrix, n_components> &sparse_matrix,
-      bool locally_indexed /*= true*/)
+  void SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      read_in(const std::array<SparseMatrix, n_components> &sparse_matrix,
+              bool locally_indexed /*= true*/)
   {
+    const auto &partitioner = *sparsity->partitioner;
+    const auto to_index = [&](const unsigned int i) {
+      return locally_indexed ? dealii::types::global_dof_index(i)
+                             : partitioner.local_to_global(i);
+    };
+
     RYUJIN_PARALLEL_REGION_BEGIN
 
     /*
-     * We use the indirect (and slow) access via operator()(i, j) into the
-     * sparse matrix we are copying from. This allows for significantly
-     * increased flexibility with respect to the sparsity pattern used in
-     * the sparse_matrix object.
+     * Instead of an indirect access via operator()(i, j), or el(i, j), for
+     * every entry (which searches the row of the sparse matrix every
+     * time), we gather every row once into a thread-local buffer sorted by
+     * column index and look up the entries with a binary search. This
+     * still allows for a sparsity pattern of the sparse_matrix object
+     * that differs from ours.
      */
 
+    std::array<std::array<RowEntries<Number>, n_components>, simd_length> rows;
+
     RYUJIN_OMP_FOR
     for (unsigned int i = 0; i < sparsity->n_internal_dofs; i += simd_length) {
 
+      for (unsigned int k = 0; k < simd_length; ++k)
+        for (unsigned int d = 0; d < n_components; ++d)
+          gather_row(sparse_matrix[d], to_index(i + k), rows[k][d]);
+
       const unsigned int row_length = sparsity->row_length(i);
 
       const unsigned int *js = sparsity->columns(i);
@@ -318,14 +612,11 @@ namespace ryujin
            ++col_idx, js += simd_length) {
 
         dealii::Tensor<1, n_components, VectorizedArray> temp;
-        for (unsigned int k = 0; k < simd_length; ++k)
+        for (unsigned int k = 0; k < simd_length; ++k) {
+          const auto j = to_index(js[k]);
           for (unsigned int d = 0; d < n_components; ++d)
-            if (locally_indexed)
-              temp[d][k] = sparse_matrix[d](i + k, js[k]);
-            else
-              temp[d][k] = sparse_matrix[d].el(
-                  sparsity->partitioner->local_to_global(i + k),
-                  sparsity->partitioner->local_to_global(js[k]));
+            temp[d][k] = lookup_entry(rows[k][d], j);
+        }
 
         write_entry(temp, i, col_idx, true);
       }
@@ -335,18 +626,18 @@ namespace ryujin
     for (unsigned int i = sparsity->n_internal_dofs;
          i < sparsity->n_locally_owned_dofs;
          ++i) {
+
+      for (unsigned int d = 0; d < n_components; ++d)
+        gather_row(sparse_matrix[d], to_index(i), rows[0][d]);
+
       const unsigned int row_length = sparsity->row_length(i);
       const unsigned int *js = sparsity->columns(i);
       for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx, ++js) {
 
+        const auto j = to_index(js[0]);
         dealii::Tensor<1, n_components, Number> temp;
         for (unsigned int d = 0; d < n_components; ++d)
-          if (locally_indexed)
-            temp[d] = sparse_matrix[d](i, js[0]);
-          else
-            temp[d] = sparse_matrix[d].el(
-                sparsity->partitioner->local_to_global(i),
-                sparsity->partitioner->local_to_global(js[0]));
+          temp[d] = lookup_entry(rows[0][d], j);
         write_entry(temp, i, col_idx);
       }
     }
@@ -355,23 +646,36 @@ namespace ryujin
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number,
+            int n_components,
+            int simd_length,
+            typename StorageNumber>
   template <typename SparseMatrix>
-  void SparseMatrixSIMD<Number, n_components, simd_length>::read_in(
-      const SparseMatrix &sparse_matrix, bool locally_indexed /*= true*/)
+  void SparseMatrixSIMD<Number, n_components, simd_length, StorageNumber>::
+      read_in(const SparseMatrix &sparse_matrix,
+              bool locally_indexed /*= true*/)
   {
+    const auto &partitioner = *sparsity->partitioner;
+    const auto to_index = [&](const unsigned int i) {
+      return locally_indexed ? dealii::types::global_dof_index(i)
+                             : partitioner.local_to_global(i);
+    };
+
     RYUJIN_PARALLEL_REGION_BEGIN
 
     /*
-     * We use the indirect (and slow) access via operator()(i, j) into the
-     * sparse matrix we are copying from. This allows for significantly
-     * increased flexibility with respect to the sparsity pattern used in
-     * the sparse_matrix object.
+     * Gather every row once and look up entries with a binary search, see
+     * above.
      */
 
+    std::array<RowEntries<Number>, simd_length> rows;
+
     RYUJIN_OMP_FOR
     for (unsigned int i = 0; i < sparsity->n_internal_dofs; i += simd_length) {
 
+      for (unsigned int k = 0; k < simd_length; ++k)
+        gather_row(sparse_matrix, to_index(i + k), rows[k]);
+
       const unsigned int row_length = sparsity->row_length(i);
 
       const unsigned int *js = sparsity->columns(i);
@@ -380,12 +684,7 @@ namespace ryujin
 
         VectorizedArray temp = {};
         for (unsigned int k = 0; k < simd_length; ++k)
-          if (locally_indexed)
-            temp[k] = sparse_matrix(i + k, js[k]);
-          else
-            temp[k] =
-                sparse_matrix.el(sparsity->partitioner->local_to_global(i + k),
-                                 sparsity->partitioner->local_to_global(js[k]));
+          temp[k] = lookup_entry(rows[k], to_index(js[k]));
 
         write_entry(temp, i, col_idx, true);
       }
@@ -396,16 +695,12 @@ namespace ryujin
          i < sparsity->n_locally_owned_dofs;
          ++i) {
 
+      gather_row(sparse_matrix, to_index(i), rows[0]);
+
       const unsigned int row_length = sparsity->row_length(i);
       const unsigned int *js = sparsity->columns(i);
       for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx, ++js) {
-
-        const Number temp =
-            locally_indexed
-                ? sparse_matrix(i, js[0])
-                : sparse_matrix.el(
-                      sparsity->partitioner->local_to_global(i),
-                      sparsity->partitioner->local_to_global(js[0]));
+        const Number temp = lookup_entry(rows[0], to_index(js[0]));
         write_entry(temp, i, col_idx);
       }
     }
@@ -413,4 +708,49 @@ namespace ryujin
     RYUJIN_PARALLEL_REGION_END
   }
 
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::
+      SymmetricSparseMatrixSIMD()
+      : sparsity(nullptr)
+  {
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::
+      SymmetricSparseMatrixSIMD(
+          const SparsityPatternSIMD<simd_length> &sparsity)
+      : sparsity(nullptr)
+  {
+    reinit(sparsity);
+  }
+
+
+  template <typename Number, int simd_length, typename StorageNumber>
+  void SymmetricSparseMatrixSIMD<Number, simd_length, StorageNumber>::reinit(
+      const SparsityPatternSIMD<simd_length> &sparsity)
+  {
+    this->sparsity = &sparsity;
+    sparsity.compute_indices_symmetric();
+    data.resize(sparsity.n_symmetric_elements);
+
+    /*
+     * The symmetric storage does not follow the row layout of the sparsity
+     * pattern, we thus simply slice the array statically in chunks:
+     */
+    constexpr std::size_t chunk_size = 4096;
+    const std::size_t size = data.size();
+    NUMA::first_touch(data.data(),
+                      size,
+                      0,
+                      (size + chunk_size - 1) / chunk_size,
+                      1,
+                      [&](const unsigned int i) {
+                        return std::make_pair(
+                            std::size_t(i) * chunk_size,
+                            std::min(std::size_t(i + 1) * chunk_size, size));
+                      });
+  }
+
 } // namespace ryujin
@@ -36,6 +36,28 @@ namespace ryujin
     template <typename Number>
     using BlockVector = dealii::LinearAlgebra::distributed::BlockVector<Number>;
 
+    /**
+     * The floating point type used for storing the indicator values
+     * alpha_i and the limiter bounds in the HyperbolicModule. If the
+     * compile-time option MIXED_PRECISION_INDICATORS is set we store these
+     * heuristic quantities in single precision, otherwise we use the
+     * principal Number type.
+     */
+#ifdef MIXED_PRECISION_INDICATORS
+    template <typename Number>
+    using indicator_number_type = float;
+#else
+    template <typename Number>
+    using indicator_number_type = Number;
+#endif
+
+    /**
+     * Shorthand for the ScalarVector storing the indicator values
+     * alpha_i, see indicator_number_type.
+     */
+    template <typename Number>
+    using IndicatorVector = ScalarVector<indicator_number_type<Number>>;
+
     /**
      * A compound state vector formed by a std::tuple consisting of the
      * hyperbolic state vector @p U, precomputed values, and an "parabolic
@@ -51,6 +73,22 @@ namespace ryujin
         BlockVector<Number> /*parabolic state vector*/>;
 
 
+    /**
+     * Helper function that sets the index range of a MultiComponentVector
+     * @p vector that is stored in the blocked layout (if selected) to the
+     * SIMD-vectorized range of indices that are not exported to
+     * neighboring MPI ranks. All vectors associated with the vector
+     * partitioners of OfflineData have to be set up with this function.
+     */
+    template <typename Vector, int dim, typename Number>
+    void set_blocked_range(Vector &vector,
+                           const OfflineData<dim, Number> &offline_data)
+    {
+      vector.set_blocked_range(offline_data.n_export_indices(),
+                               offline_data.n_locally_internal());
+    }
+
+
     template <
         typename Description,
         int dim,
@@ -129,8 +167,12 @@ namespace ryujin
         const OfflineData<dim, Number> &offline_data)
     {
       auto &[U, precomputed, V] = state_vector;
-      U.reinit(offline_data.hyperbolic_vector_partitioner());
-      precomputed.reinit(offline_data.precomputed_vector_partitioner());
+      const auto comm_sm = offline_data.shared_memory_communicator();
+      U.reinit(offline_data.hyperbolic_vector_partitioner(), comm_sm);
+      set_blocked_range(U, offline_data);
+      precomputed.reinit(offline_data.precomputed_vector_partitioner(),
+                         comm_sm);
+      set_blocked_range(precomputed, offline_data);
 
       const auto block_size = offline_data.n_parabolic_state_vectors();
       V.reinit(block_size);
@@ -138,6 +180,13 @@ namespace ryujin
         V.block(i).reinit(offline_data.scalar_partitioner());
       }
 
+      constexpr auto simd_length = simd_width<Number>;
+      NUMA::first_touch_vector(U, problem_dimension, simd_length);
+      if constexpr (prec_dimension > 0)
+        NUMA::first_touch_vector(precomputed, prec_dimension, simd_length);
+      for (unsigned int i = 0; i < block_size; ++i)
+        NUMA::first_touch_vector(V.block(i), 1, simd_length);
+
 #ifdef DEBUG
       /* Poison all vectors: */
       using state_type = typename View::state_type;
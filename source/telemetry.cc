@@ -0,0 +1,96 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#include "telemetry.h"
+
+#include <deal.II/base/exceptions.h>
+
+#include <iomanip>
+#include <sstream>
+
+namespace ryujin
+{
+  Telemetry::~Telemetry()
+  {
+    close();
+  }
+
+
+  void Telemetry::open(const std::string &filename)
+  {
+    close();
+
+    file_.open(filename);
+    AssertThrow(file_.good(),
+                dealii::ExcMessage("Could not open telemetry file >" +
+                                   filename + "<"));
+
+    stop_ = false;
+    thread_ = std::thread([this]() { run(); });
+  }
+
+
+  void Telemetry::close()
+  {
+    if (!thread_.joinable())
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+
+    file_.close();
+  }
+
+
+  void Telemetry::push(const Record &record)
+  {
+    if (!thread_.joinable())
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(record);
+    }
+    condition_.notify_one();
+  }
+
+
+  void Telemetry::run()
+  {
+    std::deque<Record> records;
+
+    for (;;) {
+      bool stop;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+        records.swap(queue_);
+        stop = stop_;
+      }
+
+      /* Format and write out all records outside of the critical section: */
+
+      std::ostringstream output;
+      output << std::setprecision(8) << std::scientific;
+      for (const auto &record : records) {
+        output << "{\"cycle\": " << record.cycle << ", \"t\": " << record.t
+               << ", \"tau\": " << record.tau
+               << ", \"n_restarts\": " << record.n_restarts
+               << ", \"n_warnings\": " << record.n_warnings
+               << ", \"m_dofs_per_sec\": " << record.m_dofs_per_sec << "}\n";
+      }
+      records.clear();
+
+      file_ << output.str() << std::flush;
+
+      if (stop)
+        return;
+    }
+  }
+} /* namespace ryujin */
@@ -0,0 +1,94 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ryujin
+{
+  /**
+   * A low-overhead telemetry stream recording the progress of every
+   * cycle of the TimeLoop.
+   *
+   * Records are handed over with push(), which only appends the record
+   * to a queue. A background thread formats the queued records as
+   * self-contained JSON objects (one per line) and writes them to the
+   * file (or named pipe) given to open(). Neither function communicates
+   * over MPI, the stream is thus meant to be written by a single rank,
+   * and it can be monitored continuously (for example with tail -f)
+   * independently of the terminal update interval.
+   *
+   * @ingroup TimeLoop
+   */
+  class Telemetry final
+  {
+  public:
+    /**
+     * The progress of a single cycle.
+     */
+    struct Record {
+      unsigned int cycle;
+      double t;
+      double tau;
+      unsigned int n_restarts;
+      unsigned int n_warnings;
+      double m_dofs_per_sec;
+    };
+
+    Telemetry() = default;
+
+    ~Telemetry();
+
+    Telemetry(const Telemetry &) = delete;
+    Telemetry &operator=(const Telemetry &) = delete;
+
+    /**
+     * Open the file @p filename and start the background thread.
+     */
+    void open(const std::string &filename);
+
+    /**
+     * Write out all queued records, stop the background thread and close
+     * the file. Does nothing if the stream is not open.
+     */
+    void close();
+
+    /**
+     * Return true if the stream is open.
+     */
+    bool enabled() const
+    {
+      return thread_.joinable();
+    }
+
+    /**
+     * Queue the record @p record for output. Does nothing if the stream
+     * is not open.
+     */
+    void push(const Record &record);
+
+  private:
+    /**
+     * The main function of the background thread.
+     */
+    void run();
+
+    std::ofstream file_;
+    std::thread thread_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Record> queue_;
+    bool stop_ = false;
+  };
+} /* namespace ryujin */
@@ -13,4 +13,10 @@ namespace ryujin
   template class TimeIntegrator<Description, 2, NUMBER>;
   template class TimeIntegrator<Description, 3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class TimeIntegrator<Description, 1, float>;
+  template class TimeIntegrator<Description, 2, float>;
+  template class TimeIntegrator<Description, 3, float>;
+#endif
+
 } /* namespace ryujin */
@@ -37,6 +37,18 @@ namespace ryujin
      * warning is emitted.
      */
     bang_bang_control,
+
+    /**
+     * Adapt the CFL number over cycles with a PI controller acting on the
+     * logarithm of the CFL number. After every accepted step the
+     * controller ramps the CFL number back up towards "cfl max". In case
+     * an invariant domain and or CFL condition violation is detected, the
+     * CFL number is reduced by the controller (bounded from below by
+     * "cfl min") and the time step is repeated. If the second repetition
+     * is unsuccessful as well, the step is repeated a last time with
+     * "cfl min" and a warning is emitted.
+     */
+    pi_control,
   };
 
 
@@ -74,6 +86,41 @@ namespace ryujin
      */
     ssprk_33,
 
+    /**
+     * The four stage, third-order strong stability preserving Runge Kutta
+     * method SSPRK(4,3;2) in the low-storage form of @cite Ketcheson2008:
+     * \f{align*}
+     *   U^{(1)} &= U^n + \tfrac{\tau}{2} L(U^n),
+     *   \quad U^{(2)} = U^{(1)} + \tfrac{\tau}{2} L(U^{(1)}),
+     *   \\
+     *   U^{(3)} &= \tfrac{2}{3} U^n
+     *   + \tfrac{1}{3}\big(U^{(2)} + \tfrac{\tau}{2} L(U^{(2)})\big),
+     *   \quad U^{n+1} = U^{(3)} + \tfrac{\tau}{2} L(U^{(3)}).
+     * \f}
+     * The scheme only needs two temporary state vectors (compared to three
+     * for erk 33).
+     */
+    ssprk_43,
+
+    /**
+     * The nine stage, third-order strong stability preserving Runge Kutta
+     * method SSPRK(9,3;6) of @cite Ketcheson2008 (the member \f$n=3\f$
+     * of the SSPRK(\f$n^2\f$,3) family). The scheme consists of nine
+     * forward Euler steps of size \f$\tau/6\f$ and a single convex
+     * combination. It only needs three temporary state vectors.
+     */
+    ssprk_93,
+
+    /**
+     * The ten stage, fourth-order strong stability preserving Runge Kutta
+     * method SSPRK(10,4;6) in the two-register low-storage form of
+     * @cite Ketcheson2008. The scheme consists of ten forward Euler steps
+     * of size \f$\tau/6\f$ interleaved with two convex combinations and
+     * only needs three temporary state vectors (compared to five for erk
+     * 54).
+     */
+    ssprk_104,
+
     /**
      * The explicit Runge-Kutta method RK(1,1;1), aka a simple, forward
      * Euler step.
@@ -211,12 +258,16 @@ namespace ryujin
 DECLARE_ENUM(ryujin::CFLRecoveryStrategy,
              LIST({ryujin::CFLRecoveryStrategy::none, "none"},
                   {ryujin::CFLRecoveryStrategy::bang_bang_control,
-                   "bang bang control"}));
+                   "bang bang control"},
+                  {ryujin::CFLRecoveryStrategy::pi_control, "pi control"}));
 
 DECLARE_ENUM(
     ryujin::TimeSteppingScheme,
     LIST({ryujin::TimeSteppingScheme::ssprk_22, "ssprk 22"},
          {ryujin::TimeSteppingScheme::ssprk_33, "ssprk 33"},
+         {ryujin::TimeSteppingScheme::ssprk_43, "ssprk 43"},
+         {ryujin::TimeSteppingScheme::ssprk_93, "ssprk 93"},
+         {ryujin::TimeSteppingScheme::ssprk_104, "ssprk 104"},
          {ryujin::TimeSteppingScheme::erk_11, "erk 11"},
          {ryujin::TimeSteppingScheme::erk_22, "erk 22"},
          {ryujin::TimeSteppingScheme::erk_33, "erk 33"},
@@ -276,8 +327,13 @@ namespace ryujin
      * Prepare time integration. A call to prepare() allocates temporary
      * storage and is necessary before any of the following time-stepping
      * functions can be called.
+     *
+     * If @p allocate is set to false only the time-stepping scheme is
+     * set up, i.e., efficiency() and n_temporaries() return meaningful
+     * values, but no temporary storage is allocated. This is used by the
+     * "dry run" mode of the TimeLoop.
      */
-    void prepare();
+    void prepare(const bool allocate = true);
 
     //@}
     /**
@@ -307,6 +363,20 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(time_stepping_scheme);
 
+    /**
+     * Returns true if the "steady state" mode is enabled and the relative
+     * residual has dropped below the "steady state tolerance". The
+     * TimeLoop terminates early in this case.
+     */
+    ACCESSOR_READ_ONLY(steady_state_converged);
+
+    /**
+     * The relative residual of the last pseudo time step in "steady
+     * state" mode, i.e., the l2 norm of the update of the last step
+     * relative to the one of the first step.
+     */
+    ACCESSOR_READ_ONLY(steady_state_residual);
+
     /**
      * The eficiency of the selected time-stepping scheme expressed as the
      * ratio of step size of the combined method to step size of an
@@ -315,6 +385,48 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(efficiency);
 
+    /**
+     * The number of temporary state vectors used by the selected
+     * time-stepping scheme.
+     */
+    unsigned int n_temporaries() const
+    {
+      return temp_.size();
+    }
+
+    /**
+     * Print statistics about the distribution of the local CFL bound of
+     * all degrees of freedom over "multirate levels" to the given output
+     * stream. Level l collects all degrees of freedom that could be
+     * advanced with \f$2^l\f$ times the global time step size. The
+     * function also reports the (theoretical) speedup a local time
+     * stepping scheme could achieve over global time stepping. Nothing is
+     * printed if the "multirate levels" parameter is set to 1.
+     *
+     * @note The levels are purely diagnostic. A conservative multirate
+     * update would need flux registers at level interfaces in the low
+     * order update, the convex limiter and the high-order stage
+     * combination of HyperbolicModule::step(), which all assume a single
+     * uniform time step size.
+     *
+     * @note This function is collective over the ensemble communicator.
+     */
+    void print_multirate_statistics(std::ostream &output) const;
+
+    /**
+     * Print statistics about the effective CFL number (average, minimum
+     * and maximum) used for all accepted time steps since the last call to
+     * this function and reset the statistics. Nothing is printed unless
+     * the "pi control" CFL recovery strategy is selected.
+     */
+    void print_cfl_statistics(std::ostream &output);
+
+    /**
+     * Print the relative residual of the last pseudo time step. Nothing
+     * is printed unless the "steady state" mode is enabled.
+     */
+    void print_steady_state_statistics(std::ostream &output) const;
+
   protected:
     /**
      * Given a reference to a previous state vector U performs an explicit
@@ -334,6 +446,33 @@ namespace ryujin
      */
     Number step_ssprk_33(StateVector &state_vector, Number t, Number tau_max);
 
+    /**
+     * Given a reference to a previous state vector U performs an explicit
+     * four stage, third-order strong-stability preserving Runge-Kutta
+     * SSPRK(4,3;2) time step (and store the result in U). The function
+     * returns the chosen time step size tau, which is guaranteed to be
+     * less than or equal to the parameter @p tau_max.
+     */
+    Number step_ssprk_43(StateVector &state_vector, Number t, Number tau_max);
+
+    /**
+     * Given a reference to a previous state vector U performs an explicit
+     * nine stage, third-order strong-stability preserving Runge-Kutta
+     * SSPRK(9,3;6) time step (and store the result in U). The function
+     * returns the chosen time step size tau, which is guaranteed to be
+     * less than or equal to the parameter @p tau_max.
+     */
+    Number step_ssprk_93(StateVector &state_vector, Number t, Number tau_max);
+
+    /**
+     * Given a reference to a previous state vector U performs an explicit
+     * ten stage, fourth-order strong-stability preserving Runge-Kutta
+     * SSPRK(10,4;6) time step (and store the result in U). The function
+     * returns the chosen time step size tau, which is guaranteed to be
+     * less than or equal to the parameter @p tau_max.
+     */
+    Number step_ssprk_104(StateVector &state_vector, Number t, Number tau_max);
+
     /**
      * Given a reference to a previous state vector U performs an explicit
      * first-order Euler step ERK(1,1;1) time step (and store the result
@@ -342,6 +481,16 @@ namespace ryujin
      */
     Number step_erk_11(StateVector &state_vector, Number t, Number tau_max);
 
+    /**
+     * Given a reference to a previous state vector U performs a local
+     * pseudo time step (and store the result in U) by calling
+     * step_erk_11() with local time stepping enabled in the
+     * HyperbolicModule, and updates the steady state residual. The
+     * function returns the global (minimal) time step size tau.
+     */
+    Number
+    step_steady_state(StateVector &state_vector, Number t, Number tau_max);
+
     /**
      * Given a reference to a previous state vector U performs an explicit
      * second-order Runge-Kutta ERK(2,2;1) time step (and store the result
@@ -433,6 +582,27 @@ namespace ryujin
     Number step_imex_33(StateVector &state_vector, Number t, Number tau_max);
 
   private:
+    /**
+     * Perform a sub-cycled Strang split: the hyperbolic subproblem is
+     * advanced with "strang subcycles" explicit steps of @p explicit_step
+     * (each one with its own CFL-restricted step size), followed by a
+     * single Crank-Nicolson step of the parabolic subproblem over twice
+     * the accumulated time, and a second sequence of explicit steps that
+     * exactly covers the accumulated time again. The function returns
+     * the chosen time step size tau.
+     */
+    template <typename ExplicitStep>
+    Number step_strang_subcycled(StateVector &state_vector,
+                                 Number t,
+                                 Number tau_max,
+                                 const ExplicitStep &explicit_step);
+
+    /**
+     * Update the PI controller of the "pi control" CFL recovery strategy
+     * after a successful (@p accepted is true) or rejected time step.
+     */
+    void update_cfl_controller(bool accepted);
+
     //@}
     /**
      * @name Run time options
@@ -444,9 +614,21 @@ namespace ryujin
 
     CFLRecoveryStrategy cfl_recovery_strategy_;
 
+    bool reuse_first_stage_;
+
+    double cfl_controller_kp_;
+    double cfl_controller_ki_;
+
     TimeSteppingScheme time_stepping_scheme_;
     double efficiency_;
 
+    unsigned int multirate_levels_;
+
+    unsigned int strang_subcycles_;
+
+    bool steady_state_;
+    Number steady_state_tolerance_;
+
     //@}
 
     //@}
@@ -465,6 +647,20 @@ namespace ryujin
 
     std::vector<StateVector> temp_;
 
+    Number cfl_controlled_;
+    double cfl_controller_error_;
+
+    struct CFLStatistics {
+      unsigned int n_steps = 0;
+      double sum = 0.;
+      double min = std::numeric_limits<double>::max();
+      double max = 0.;
+    } cfl_statistics_;
+
+    Number steady_state_initial_residual_;
+    Number steady_state_residual_;
+    bool steady_state_converged_;
+
     //@}
   };
 
@@ -7,6 +7,8 @@
 
 #include "time_integrator.h"
 
+#include <iomanip>
+
 namespace ryujin
 {
   using namespace dealii;
@@ -25,6 +27,23 @@ namespace ryujin
   }
 
 
+  template <typename StateVector, typename Number>
+  void equ(StateVector &dst,
+           const Number a,
+           const StateVector &src_a,
+           const Number b,
+           const StateVector &src_b)
+  {
+    auto &dst_U = std::get<0>(dst);
+    dst_U.equ(a, std::get<0>(src_a));
+    dst_U.add(b, std::get<0>(src_b));
+
+    auto &dst_V = std::get<2>(dst);
+    dst_V.equ(a, std::get<2>(src_a));
+    dst_V.add(b, std::get<2>(src_b));
+  }
+
+
   template <typename Description, int dim, typename Number>
   TimeIntegrator<Description, dim, Number>::TimeIntegrator(
       const MPIEnsemble &mpi_ensemble,
@@ -56,7 +75,29 @@ namespace ryujin
     add_parameter("cfl recovery strategy",
                   cfl_recovery_strategy_,
                   "CFL/invariant domain violation recovery strategy: none, "
-                  "bang bang control");
+                  "bang bang control, pi control");
+
+    reuse_first_stage_ = false;
+    add_parameter(
+        "reuse first stage",
+        reuse_first_stage_,
+        "Store the graph viscosity, indicator values and CFL bound of the "
+        "first stage of every time step and reuse them when the time step "
+        "has to be repeated due to an invariant domain or CFL violation. "
+        "This trades memory for one additional copy of the d_ij matrix for "
+        "cheaper restarts");
+
+    cfl_controller_kp_ = 0.2;
+    add_parameter("cfl controller kp",
+                  cfl_controller_kp_,
+                  "Proportional gain of the PI controller used for the \"pi "
+                  "control\" CFL recovery strategy");
+
+    cfl_controller_ki_ = 0.3;
+    add_parameter("cfl controller ki",
+                  cfl_controller_ki_,
+                  "Integral gain of the PI controller used for the \"pi "
+                  "control\" CFL recovery strategy");
 
     if (ParabolicSystem::is_identity)
       time_stepping_scheme_ = TimeSteppingScheme::erk_33;
@@ -64,15 +105,56 @@ namespace ryujin
       time_stepping_scheme_ = TimeSteppingScheme::strang_erk_33_cn;
     add_parameter("time stepping scheme",
                   time_stepping_scheme_,
-                  "Time stepping scheme: ssprk 22, ssprk 33, erk 11, erk 22, "
-                  "erk 33, erk 43, erk "
-                  "54, strang ssprk 33 cn, strang erk 33 cn, strang erk 43 cn, "
+                  "Time stepping scheme: ssprk 22, ssprk 33, ssprk 43, ssprk "
+                  "93, ssprk 104, erk 11, erk 22, erk 33, erk 43, erk 54, "
+                  "strang ssprk 33 cn, strang erk 33 cn, strang erk 43 cn, "
                   "imex 11, imex 22, imex 33");
+
+    multirate_levels_ = 1;
+    add_parameter("multirate levels",
+                  multirate_levels_,
+                  "Number of local time stepping levels used for "
+                  "classifying degrees of freedom by their local CFL bound. "
+                  "If set to a value larger than 1, the distribution of "
+                  "degrees of freedom over levels and the theoretical "
+                  "speedup of a multirate scheme are reported. This is a "
+                  "diagnostic only: no local time stepping (subcycling) is "
+                  "performed and all degrees of freedom are advanced with "
+                  "the global time step size");
+
+    strang_subcycles_ = 1;
+    add_parameter(
+        "strang subcycles",
+        strang_subcycles_,
+        "Number of explicit hyperbolic steps performed per half of a Strang "
+        "split time step. If set to a value larger than 1, the parabolic "
+        "subproblem of the strang schemes is only solved once every "
+        "2 x \"strang subcycles\" explicit steps with a correspondingly "
+        "larger time step size. Larger values trade accuracy of the "
+        "splitting for fewer parabolic solves");
+
+    steady_state_ = false;
+    add_parameter(
+        "steady state",
+        steady_state_,
+        "Compute a steady state solution with local pseudo time steps: "
+        "every degree of freedom is advanced with its own maximal time "
+        "step size tau_i = cfl m_i / (2 |d_ii|) of the (convex limited) "
+        "forward Euler update. The time loop terminates as soon as the "
+        "relative residual drops below the steady state tolerance. "
+        "Requires the time stepping scheme erk 11");
+
+    steady_state_tolerance_ = Number(1.e-8);
+    add_parameter("steady state tolerance",
+                  steady_state_tolerance_,
+                  "Tolerance for the relative residual, the l2 norm of the "
+                  "pseudo time update relative to the one of the first "
+                  "step, at which a steady state computation terminates");
   }
 
 
   template <typename Description, int dim, typename Number>
-  void TimeIntegrator<Description, dim, Number>::prepare()
+  void TimeIntegrator<Description, dim, Number>::prepare(const bool allocate)
   {
 #ifdef DEBUG_OUTPUT
     std::cout << "TimeIntegrator<dim, Number>::prepare()" << std::endl;
@@ -89,6 +171,18 @@ namespace ryujin
       temp_.resize(2);
       efficiency_ = 1.;
       break;
+    case TimeSteppingScheme::ssprk_43:
+      temp_.resize(2);
+      efficiency_ = 2.;
+      break;
+    case TimeSteppingScheme::ssprk_93:
+      temp_.resize(3);
+      efficiency_ = 6.;
+      break;
+    case TimeSteppingScheme::ssprk_104:
+      temp_.resize(3);
+      efficiency_ = 6.;
+      break;
     case TimeSteppingScheme::erk_11:
       temp_.resize(1);
       efficiency_ = 1.;
@@ -111,15 +205,16 @@ namespace ryujin
       break;
     case TimeSteppingScheme::strang_ssprk_33_cn:
       temp_.resize(3);
-      efficiency_ = 2.;
+      efficiency_ = 2. * strang_subcycles_;
       break;
     case TimeSteppingScheme::strang_erk_33_cn:
       temp_.resize(4);
-      efficiency_ = 6.;
+      efficiency_ = 6. * strang_subcycles_;
       break;
     case TimeSteppingScheme::strang_erk_43_cn:
-      temp_.resize(4);
-      efficiency_ = 8.;
+      /* step_erk_43 needs four temporaries, plus one for sub-cycling: */
+      temp_.resize(strang_subcycles_ > 1 ? 5 : 4);
+      efficiency_ = 8. * strang_subcycles_;
       break;
     case TimeSteppingScheme::imex_11:
       temp_.resize(2);
@@ -135,6 +230,9 @@ namespace ryujin
       break;
     }
 
+    if (!allocate)
+      return;
+
     /* Initialize temporary vectors: */
 
     for (auto &it : temp_) {
@@ -149,6 +247,14 @@ namespace ryujin
 
     hyperbolic_module_->cfl(cfl_max_);
 
+    AssertThrow(cfl_controller_kp_ >= 0. && cfl_controller_ki_ > 0.,
+                ExcMessage("The PI controller gains must be non-negative, and "
+                           "the integral gain must be positive"));
+
+    cfl_controlled_ = cfl_max_;
+    cfl_controller_error_ = 0.;
+    cfl_statistics_ = CFLStatistics();
+
     const auto check_whether_timestepping_makes_sense = [&]() {
       /*
        * Make sure the user selects an appropriate time-stepping scheme.
@@ -159,6 +265,12 @@ namespace ryujin
         [[fallthrough]];
       case TimeSteppingScheme::ssprk_33:
         [[fallthrough]];
+      case TimeSteppingScheme::ssprk_43:
+        [[fallthrough]];
+      case TimeSteppingScheme::ssprk_93:
+        [[fallthrough]];
+      case TimeSteppingScheme::ssprk_104:
+        [[fallthrough]];
       case TimeSteppingScheme::erk_11:
         [[fallthrough]];
       case TimeSteppingScheme::erk_22:
@@ -200,6 +312,103 @@ namespace ryujin
     check_whether_timestepping_makes_sense();
     this->parse_parameters_call_back.connect(
         check_whether_timestepping_makes_sense);
+
+    AssertThrow(multirate_levels_ >= 1,
+                ExcMessage("multirate levels must be at least 1"));
+
+    AssertThrow(strang_subcycles_ >= 1,
+                ExcMessage("strang subcycles must be at least 1"));
+
+    AssertThrow(!steady_state_ ||
+                    time_stepping_scheme_ == TimeSteppingScheme::erk_11,
+                ExcMessage("The steady state mode requires the time stepping "
+                           "scheme »erk 11«"));
+
+    hyperbolic_module_->local_time_stepping(steady_state_);
+    steady_state_initial_residual_ = Number(0.);
+    steady_state_residual_ = Number(1.);
+    steady_state_converged_ = false;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::print_multirate_statistics(
+      std::ostream &output) const
+  {
+    if (multirate_levels_ <= 1)
+      return;
+
+    const auto levels =
+        hyperbolic_module_->local_time_step_levels(multirate_levels_);
+
+    /*
+     * With global time stepping every degree of freedom is advanced with
+     * the smallest time step size. A multirate scheme would only have to
+     * advance level l every 2^l substeps:
+     */
+    double work = 0.;
+    for (unsigned int l = 0; l < levels.size(); ++l)
+      work += levels[l] / double(1u << l);
+
+    output << "        [ multirate levels:";
+    for (const auto &it : levels)
+      output << " " << std::setprecision(1) << std::fixed << 100. * it << "%";
+    output << " (potential speedup " << std::setprecision(2) << std::fixed
+           << (work > 0. ? 1. / work : 1.) << ") ]" << std::endl;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::print_cfl_statistics(
+      std::ostream &output)
+  {
+    if (cfl_recovery_strategy_ != CFLRecoveryStrategy::pi_control)
+      return;
+
+    const auto &[n_steps, sum, min, max] = cfl_statistics_;
+    if (n_steps > 0) {
+      output << "        [ effective CFL: avg = " << std::setprecision(2)
+             << std::fixed << sum / n_steps << ", min = " << min
+             << ", max = " << max << " over " << n_steps << " steps ]"
+             << std::endl;
+    }
+
+    cfl_statistics_ = CFLStatistics();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::print_steady_state_statistics(
+      std::ostream &output) const
+  {
+    if (!steady_state_)
+      return;
+
+    output << "        [ steady state residual: " << std::setprecision(2)
+           << std::scientific << steady_state_residual_ << " (tolerance "
+           << steady_state_tolerance_ << ") ]" << std::endl;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::update_cfl_controller(
+      bool accepted)
+  {
+    /*
+     * We control the logarithm of the CFL number: After an accepted step
+     * the controller drives the CFL number towards "cfl max", after a
+     * rejected step towards "cfl min":
+     */
+
+    const double target = accepted ? cfl_max_ : cfl_min_;
+    const double error = std::log(target / cfl_controlled_);
+
+    const double delta = cfl_controller_kp_ * (error - cfl_controller_error_) +
+                         cfl_controller_ki_ * error;
+    cfl_controller_error_ = error;
+
+    cfl_controlled_ = std::clamp(
+        Number(cfl_controlled_ * std::exp(delta)), cfl_min_, cfl_max_);
   }
 
 
@@ -214,12 +423,21 @@ namespace ryujin
 #endif
     Number tau_max = t_final - t;
 
-    const auto single_step = [&]() {
+    const auto explicit_step = [&]() {
+      if (steady_state_)
+        return step_steady_state(state_vector, t, tau_max);
+
       switch (time_stepping_scheme_) {
       case TimeSteppingScheme::ssprk_22:
         return step_ssprk_22(state_vector, t, tau_max);
       case TimeSteppingScheme::ssprk_33:
         return step_ssprk_33(state_vector, t, tau_max);
+      case TimeSteppingScheme::ssprk_43:
+        return step_ssprk_43(state_vector, t, tau_max);
+      case TimeSteppingScheme::ssprk_93:
+        return step_ssprk_93(state_vector, t, tau_max);
+      case TimeSteppingScheme::ssprk_104:
+        return step_ssprk_104(state_vector, t, tau_max);
       case TimeSteppingScheme::erk_11:
         return step_erk_11(state_vector, t, tau_max);
       case TimeSteppingScheme::erk_22:
@@ -247,6 +465,61 @@ namespace ryujin
       }
     };
 
+    /* Apply (stiff) source terms pointwise implicitly after every step: */
+    const auto single_step = [&]() {
+      const auto tau = explicit_step();
+      hyperbolic_module_->apply_implicit_source(state_vector, tau);
+      return tau;
+    };
+
+    /*
+     * Store the first stage of the time step so that we can cheaply
+     * repeat it in case of a restart:
+     */
+    hyperbolic_module_->first_stage_cache_ =
+        (reuse_first_stage_ &&
+         cfl_recovery_strategy_ != CFLRecoveryStrategy::none)
+            ? FirstStageCache::store
+            : FirstStageCache::none;
+
+    const auto record_cfl = [&](const Number tau) {
+      const double cfl = hyperbolic_module_->cfl();
+      auto &[n_steps, sum, min, max] = cfl_statistics_;
+      n_steps++;
+      sum += cfl;
+      min = std::min(min, cfl);
+      max = std::max(max, cfl);
+      return tau;
+    };
+
+    if (cfl_recovery_strategy_ == CFLRecoveryStrategy::pi_control) {
+      hyperbolic_module_->id_violation_strategy_ =
+          IDViolationStrategy::raise_exception;
+      parabolic_module_->id_violation_strategy_ =
+          IDViolationStrategy::raise_exception;
+
+      /* Attempt the step twice with a controlled CFL number: */
+      for (unsigned int attempt = 0; attempt < 2; ++attempt) {
+        hyperbolic_module_->cfl(cfl_controlled_);
+        try {
+          const auto tau = single_step();
+          update_cfl_controller(true);
+          return record_cfl(tau);
+        } catch (Restart) {
+          update_cfl_controller(false);
+          if (reuse_first_stage_)
+            hyperbolic_module_->first_stage_cache_ = FirstStageCache::reuse;
+        }
+      }
+
+      /* And fall back to "cfl min" and only emit a warning: */
+      hyperbolic_module_->id_violation_strategy_ = IDViolationStrategy::warn;
+      parabolic_module_->id_violation_strategy_ = IDViolationStrategy::warn;
+      hyperbolic_module_->cfl(cfl_min_);
+      cfl_controlled_ = cfl_min_;
+      return record_cfl(single_step());
+    }
+
     if (cfl_recovery_strategy_ == CFLRecoveryStrategy::bang_bang_control) {
       hyperbolic_module_->id_violation_strategy_ =
           IDViolationStrategy::raise_exception;
@@ -267,6 +540,8 @@ namespace ryujin
         hyperbolic_module_->id_violation_strategy_ = IDViolationStrategy::warn;
         parabolic_module_->id_violation_strategy_ = IDViolationStrategy::warn;
         hyperbolic_module_->cfl(cfl_min_);
+        if (reuse_first_stage_)
+          hyperbolic_module_->first_stage_cache_ = FirstStageCache::reuse;
         return single_step();
       }
 
@@ -328,6 +603,130 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_ssprk_43(
+      StateVector &state_vector, Number t, Number tau_max)
+  {
+    /* SSP-RK(4,3), see @cite Ketcheson2008, Sec. 3.2. */
+
+    /* Step 1: T0 = U_old + tau * L(U_old) at time t -> t + tau */
+    hyperbolic_module_->prepare_state_vector(state_vector, t);
+    Number tau = hyperbolic_module_->template step<0>(
+        state_vector, {}, {}, temp_[0], Number(0.), tau_max / 2.);
+
+    /* Step 2: T1 = T0 + tau L(T0) at time t + tau -> t + 2*tau */
+    hyperbolic_module_->prepare_state_vector(temp_[0], t + 1.0 * tau);
+    hyperbolic_module_->template step<0>(temp_[0], {}, {}, temp_[1], tau);
+
+    /* Step 3: T0 = T1 + tau L(T1) at time t + 2*tau -> t + 3*tau */
+    hyperbolic_module_->prepare_state_vector(temp_[1], t + 2.0 * tau);
+    hyperbolic_module_->template step<0>(temp_[1], {}, {}, temp_[0], tau);
+
+    /* Step 3: convex combination: T0 = 2/3 U_old + 1/3 T0 at time t + tau */
+    sadd(temp_[0], Number(1.0 / 3.0), Number(2.0 / 3.0), state_vector);
+
+    /* Step 4: T1 = T0 + tau L(T0) at time t + tau -> t + 2*tau */
+    hyperbolic_module_->prepare_state_vector(temp_[0], t + 1.0 * tau);
+    hyperbolic_module_->template step<0>(temp_[0], {}, {}, temp_[1], tau);
+
+    state_vector.swap(temp_[1]);
+    return 2. * tau;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_ssprk_93(
+      StateVector &state_vector, Number t, Number tau_max)
+  {
+    /* SSP-RK(9,3), see @cite Ketcheson2008, Sec. 4.2 with n = 3. */
+
+    /* Step 1: T2 = U_old + tau * L(U_old) at time t -> t + tau */
+    hyperbolic_module_->prepare_state_vector(state_vector, t);
+    Number tau = hyperbolic_module_->template step<0>(
+        state_vector, {}, {}, temp_[2], Number(0.), tau_max / 6.);
+
+    /* Step 2: T0 = T2 + tau * L(T2) at time t + tau -> t + 2*tau */
+    hyperbolic_module_->prepare_state_vector(temp_[2], t + 1.0 * tau);
+    hyperbolic_module_->template step<0>(temp_[2], {}, {}, temp_[0], tau);
+
+    /* Steps 3 - 6: four forward Euler steps at time t + 2*tau -> t + 6*tau */
+    for (unsigned int s = 0; s < 4; ++s) {
+      auto &src = temp_[s % 2];
+      auto &dst = temp_[(s + 1) % 2];
+      hyperbolic_module_->prepare_state_vector(src, t + (2 + s) * tau);
+      hyperbolic_module_->template step<0>(src, {}, {}, dst, tau);
+    }
+
+    /* Step 6: convex combination: T0 = 3/5 T2 + 2/5 T0 at time t + 3*tau */
+    sadd(temp_[0], Number(2.0 / 5.0), Number(3.0 / 5.0), temp_[2]);
+
+    /* Steps 7 - 9: three forward Euler steps at time t + 3*tau -> t + 6*tau */
+    for (unsigned int s = 0; s < 3; ++s) {
+      auto &src = temp_[s % 2];
+      auto &dst = temp_[(s + 1) % 2];
+      hyperbolic_module_->prepare_state_vector(src, t + (3 + s) * tau);
+      hyperbolic_module_->template step<0>(src, {}, {}, dst, tau);
+    }
+
+    state_vector.swap(temp_[1]);
+    return 6. * tau;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_ssprk_104(
+      StateVector &state_vector, Number t, Number tau_max)
+  {
+    /*
+     * SSP-RK(10,4), see @cite Ketcheson2008, Sec. 4.1. The state vector
+     * has to stay intact in case the step is restarted, so we store the
+     * second register of the method in T2.
+     */
+
+    /* Steps 1 - 5: five forward Euler steps at time t -> t + 5*tau */
+    hyperbolic_module_->prepare_state_vector(state_vector, t);
+    Number tau = hyperbolic_module_->template step<0>(
+        state_vector, {}, {}, temp_[0], Number(0.), tau_max / 6.);
+
+    for (unsigned int s = 1; s < 5; ++s) {
+      auto &src = temp_[(s + 1) % 2];
+      auto &dst = temp_[s % 2];
+      hyperbolic_module_->prepare_state_vector(src, t + s * tau);
+      hyperbolic_module_->template step<0>(src, {}, {}, dst, tau);
+    }
+
+    /*
+     * Second register and convex combination:
+     *   T2 = 1/25 U_old + 9/25 T0,
+     *   T0 = 3/5 U_old + 2/5 T0 at time t + 2*tau
+     */
+    equ(temp_[2],
+        Number(1.0 / 25.0),
+        state_vector,
+        Number(9.0 / 25.0),
+        temp_[0]);
+    sadd(temp_[0], Number(2.0 / 5.0), Number(3.0 / 5.0), state_vector);
+
+    /* Steps 6 - 9: four forward Euler steps at time t + 2*tau -> t + 6*tau */
+    for (unsigned int s = 0; s < 4; ++s) {
+      auto &src = temp_[s % 2];
+      auto &dst = temp_[(s + 1) % 2];
+      hyperbolic_module_->prepare_state_vector(src, t + (2 + s) * tau);
+      hyperbolic_module_->template step<0>(src, {}, {}, dst, tau);
+    }
+
+    /* Step 10: T1 = T0 + tau L(T0) at time t + 6*tau -> t + 7*tau */
+    hyperbolic_module_->prepare_state_vector(temp_[0], t + 6.0 * tau);
+    hyperbolic_module_->template step<0>(temp_[0], {}, {}, temp_[1], tau);
+
+    /* Step 10: convex combination: T1 = T2 + 3/5 T1 at time t + 6*tau */
+    sadd(temp_[1], Number(3.0 / 5.0), Number(1.), temp_[2]);
+
+    state_vector.swap(temp_[1]);
+    return 6. * tau;
+  }
+
+
   template <typename Description, int dim, typename Number>
   Number TimeIntegrator<Description, dim, Number>::step_erk_11(
       StateVector &state_vector, Number t, Number tau_max)
@@ -346,6 +745,40 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_steady_state(
+      StateVector &state_vector, Number t, Number tau_max)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeIntegrator<dim, Number>::step_steady_state()"
+              << std::endl;
+#endif
+
+    /* A local pseudo time step, see HyperbolicModule::local_time_stepping(): */
+    const Number tau = step_erk_11(state_vector, t, tau_max);
+
+    /*
+     * step_erk_11() leaves the old state in temp_[0]. We compute the norm
+     * of the pseudo time update and relate it to the one of the first
+     * step:
+     */
+    auto &update = std::get<0>(temp_[0]);
+    update.sadd(Number(-1.), Number(1.), std::get<0>(state_vector));
+    const Number residual = update.l2_norm();
+
+    if (steady_state_initial_residual_ == Number(0.))
+      steady_state_initial_residual_ = residual;
+
+    steady_state_residual_ =
+        steady_state_initial_residual_ > Number(0.)
+            ? residual / steady_state_initial_residual_
+            : Number(0.);
+    steady_state_converged_ = steady_state_residual_ < steady_state_tolerance_;
+
+    return tau;
+  }
+
+
   template <typename Description, int dim, typename Number>
   Number TimeIntegrator<Description, dim, Number>::step_erk_22(
       StateVector &state_vector, Number t, Number tau_max)
@@ -512,6 +945,65 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  template <typename ExplicitStep>
+  Number TimeIntegrator<Description, dim, Number>::step_strang_subcycled(
+      StateVector &state_vector,
+      Number t,
+      Number tau_max,
+      const ExplicitStep &explicit_step)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeIntegrator<dim, Number>::step_strang_subcycled()"
+              << std::endl;
+#endif
+
+    /*
+     * The explicit steps use temp_[0] - temp_[n-2] as scratch space, so we
+     * advance a copy of the old state in the last temporary. This keeps
+     * the state vector intact in case of a restart:
+     */
+    auto &current = temp_.back();
+    current = state_vector;
+
+    /* Sub-cycled explicit steps with final result in current: */
+
+    Number tau_half = 0.;
+    for (unsigned int i = 0; i < strang_subcycles_; ++i) {
+      const Number bound = tau_max / Number(2.) - tau_half;
+      if (bound <= Number(0.))
+        break;
+      tau_half += explicit_step(current, t + tau_half, bound);
+
+      /* Only the very first stage of the step can be stored or reused: */
+      hyperbolic_module_->first_stage_cache_ = FirstStageCache::none;
+    }
+
+    /* Implicit Crank-Nicolson step over 2 * tau_half: */
+
+    parabolic_module_->template step<0>(
+        current, t, {}, {}, temp_[0], tau_half);
+    sadd(temp_[0], Number(2.), Number(-1.), current);
+    current.swap(temp_[0]);
+
+    /*
+     * Second sequence of explicit steps that exactly covers tau_half.
+     * We stop once the remaining time is within round-off of tau_half:
+     */
+
+    const Number tolerance =
+        Number(100.) * std::numeric_limits<Number>::epsilon() * tau_half;
+    Number tau_second = 0.;
+    while (tau_half - tau_second > tolerance) {
+      tau_second += explicit_step(
+          current, t + tau_half + tau_second, tau_half - tau_second);
+    }
+
+    state_vector.swap(current);
+    return 2. * tau_half;
+  }
+
+
   template <typename Description, int dim, typename Number>
   Number TimeIntegrator<Description, dim, Number>::step_strang_ssprk_33_cn(
       StateVector &state_vector, Number t, Number tau_max)
@@ -523,6 +1015,12 @@ namespace ryujin
               << std::endl;
 #endif
 
+    if (strang_subcycles_ > 1)
+      return step_strang_subcycled(
+          state_vector, t, tau_max, [&](auto &U, Number time, Number bound) {
+            return step_ssprk_33(U, time, bound);
+          });
+
     /* First explicit SSPRK 3 step with final result in temp_[0]: */
 
     hyperbolic_module_->prepare_state_vector(/*!*/ state_vector, t);
@@ -571,6 +1069,12 @@ namespace ryujin
               << std::endl;
 #endif
 
+    if (strang_subcycles_ > 1)
+      return step_strang_subcycled(
+          state_vector, t, tau_max, [&](auto &U, Number time, Number bound) {
+            return step_erk_33(U, time, bound);
+          });
+
     /* First explicit ERK(3,3,1) step with final result in temp_[2]: */
 
     hyperbolic_module_->prepare_state_vector(state_vector, t);
@@ -627,6 +1131,12 @@ namespace ryujin
               << std::endl;
 #endif
 
+    if (strang_subcycles_ > 1)
+      return step_strang_subcycled(
+          state_vector, t, tau_max, [&](auto &U, Number time, Number bound) {
+            return step_erk_43(U, time, bound);
+          });
+
     /* First explicit ERK(4,3,1) step with final result in temp_[3]: */
 
     hyperbolic_module_->prepare_state_vector(state_vector, t);
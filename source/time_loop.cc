@@ -13,4 +13,17 @@ namespace ryujin
   template class TimeLoop<Description, 2, NUMBER>;
   template class TimeLoop<Description, 3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class TimeLoop<Description, 1, float>;
+  template class TimeLoop<Description, 2, float>;
+  template class TimeLoop<Description, 3, float>;
+
+  template void TimeLoop<Description, 1, NUMBER>::run(
+      const TimeLoop<Description, 1, float> &);
+  template void TimeLoop<Description, 2, NUMBER>::run(
+      const TimeLoop<Description, 2, float> &);
+  template void TimeLoop<Description, 3, NUMBER>::run(
+      const TimeLoop<Description, 3, float> &);
+#endif
+
 } // namespace ryujin
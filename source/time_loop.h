@@ -7,7 +7,9 @@
 
 #include <compile_time_options.h>
 
+#include "buddy_checkpoint.h"
 #include "discretization.h"
+#include "ensemble_progress.h"
 #include "hyperbolic_module.h"
 #include "initial_values.h"
 #include "mesh_adaptor.h"
@@ -17,13 +19,20 @@
 #include "parabolic_module.h"
 #include "postprocessor.h"
 #include "quantities.h"
+#include "telemetry.h"
 #include "time_integrator.h"
 #include "vtu_output.h"
 
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/timer.h>
 
+#include <array>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace ryujin
 {
@@ -68,26 +77,75 @@ namespace ryujin
     //@{
 
     /**
-     * Constructor.
+     * Constructor. The MPI ranks of @p mpi_comm are subdivided into
+     * @p n_ensembles ensembles, see MPIEnsemble.
+     *
+     * If @p global_synchronization is false, the ensembles are fully
+     * decoupled: Every ensemble chooses its own time step size, and run
+     * time statistics are gathered, printed and logged per ensemble
+     * (with log files suffixed by "-ensemble_n"). World rank 0
+     * additionally reports the (asynchronously posted) progress of all
+     * ensembles, see EnsembleProgress.
      */
-    TimeLoop(const MPI_Comm &mpi_comm);
+    TimeLoop(const MPI_Comm &mpi_comm,
+             const int n_ensembles = 1,
+             const bool global_synchronization = true);
 
     /**
      * Run the high-level time loop.
+     *
+     * The function can be called repeatedly with different runtime
+     * parameters, for example for a sequence of parameter samples handed
+     * out by an EnsembleScheduler. In this case the mesh and the offline
+     * data of the previous run are reused if all "C - Discretization"
+     * and "D - OfflineData" parameters are unchanged, and if the mesh
+     * has neither been adapted nor been read from a checkpoint.
      */
     void run();
 
+    /**
+     * Run the high-level time loop starting from the final mesh, time and
+     * state of the TimeLoop @p warm_up (with a possibly different number
+     * type @p OtherNumber) instead of creating a mesh and interpolating
+     * initial values. The triangulation of @p warm_up is copied and the
+     * hyperbolic state is converted to @p Number. This allows to compute
+     * an initial transient in single precision and to continue in double
+     * precision, see run_time_loop().
+     *
+     * @pre @p warm_up has to be run() with keep_final_state() set to
+     * true prior to a call to this function.
+     */
+    template <typename OtherNumber>
+    void run(const TimeLoop<Description, dim, OtherNumber> &warm_up);
+
+    /**
+     * Return a mutable reference to a boolean that controls whether run()
+     * keeps the final state vector for a subsequent handoff, see
+     * run(warm_up).
+     */
+    ACCESSOR(keep_final_state)
+
   protected:
     /**
      * @name Private methods for run()
      */
     //@{
 
+    /**
+     * Return all runtime parameters that the mesh and the offline data
+     * depend on, i.e., the "C - Discretization" and "D - OfflineData"
+     * subsections, in textual form.
+     */
+    std::string mesh_parameters() const;
+
     /**
      * Performs a resume operation. Given a @p base_name the function tries
      * to locate correponding checkpoint files and will read in the saved
      * state @p state_vector at saved time @p t with saved output cycle
-     * @p output_cycle.
+     * @p output_cycle. If the most recent checkpoint is incomplete the
+     * function falls back to the previous checkpoint. If a "checkpoint
+     * staging directory" is set, the most recent complete checkpoint of
+     * either the staging directory or the output directory is used.
      */
     template <typename Callable>
     void read_checkpoint(StateVector &state_vector,
@@ -100,7 +158,14 @@ namespace ryujin
      * Write out a checkpoint to disk. Given a @p base_name and a current
      * state @p U at time @p t and output cycle @p output_cycle the
      * function writes out the state to disk using boost::archive for
-     * serialization.
+     * serialization. The new checkpoint is written into temporary files
+     * first and then rotated into place; the previous checkpoint is kept
+     * with a "~" suffix.
+     *
+     * If a "checkpoint staging directory" is set, the checkpoint is
+     * written into the staging directory instead and copied to the
+     * output directory by a background task that is awaited by the next
+     * call to write_checkpoint() and at the end of run().
      *
      * @pre the state_vector has to have been prepared prior to a call to
      * write_checkpoint().
@@ -110,17 +175,66 @@ namespace ryujin
                           const Number &t,
                           const unsigned int &output_cycle);
 
+    /**
+     * Return the checkpoint name in the staging directory for a given
+     * @p base_name, or an empty string if no staging directory is set.
+     */
+    std::string checkpoint_staging_name(const std::string &base_name) const;
+
+    /**
+     * Restore the state @p state_vector at time @p t and output cycle
+     * @p output_cycle from the most recent in-memory buddy checkpoint,
+     * see the "buddy checkpoint interval" option and BuddyCheckpoint. A
+     * rank that has @p lost its own copy (because it replaced a failed
+     * process) rebuilds its state from the copy held by its partner rank.
+     *
+     * @note This function is collective over the ensemble communicator.
+     */
+    void recover_buddy_checkpoint(StateVector &state_vector,
+                                  Number &t,
+                                  unsigned int &output_cycle,
+                                  const bool lost = false);
+
     /**
      * Perform a mesh adaptation cycle according to the selected strategy
      * in the MeshAdaptor class. The state vector is transferred to the new
-     * discretization.
+     * discretization. If no cell ends up flagged for refinement or
+     * coarsening the function returns early and leaves the discretization,
+     * all offline data and the state vector untouched and only resets the
+     * mesh adaptor for the current time @p t.
      */
     template <typename Callable>
     void adapt_mesh_and_transfer_state_vector(
-        StateVector &state_vector, const Callable &prepare_compute_kernels);
+        StateVector &state_vector,
+        const Number t,
+        const Callable &prepare_compute_kernels);
 
     void compute_error(StateVector &state_vector, Number t);
 
+    /**
+     * Compute the (possibly normalized) Linf, L1, and L2 errors summed
+     * over all selected error quantities in a single, thread-parallel
+     * pass over all locally owned degrees of freedom. The analytic
+     * solution is evaluated on the fly and the lumped mass matrix is used
+     * as quadrature. See the "fused error norms" option.
+     */
+    std::array<Number, 3> compute_fused_error_norms(
+        const StateVector &state_vector, Number t) const;
+
+    /**
+     * Compare the hyperbolic state of @p state_vector at time @p t with
+     * the state stored at the last call and return true if the relative
+     * rate of change
+     * \f[
+     *   \frac{\|U(t) - U(t')\|_{L^1}}{(t - t')\,\|U(t)\|_{L^1}}
+     * \f]
+     * (with t' the time of the last call) is below the "convergence
+     * tolerance". The state is then stored for the next call. With
+     * global synchronization the maximal rate over all ensembles is
+     * used so that all ensembles terminate simultaneously.
+     */
+    bool check_convergence(const StateVector &state_vector, Number t);
+
     void output(StateVector &state_vector,
                 const std::string &name,
                 const Number t,
@@ -129,7 +243,13 @@ namespace ryujin
     void print_parameters(std::ostream &stream);
     void print_mpi_partition(std::ostream &stream);
     void print_memory_statistics(std::ostream &stream);
+    void print_startup_profile(std::ostream &stream);
+    void print_dry_run_estimate(std::ostream &stream,
+                                const unsigned int n_parabolic_state_vectors);
     void print_timers(std::ostream &stream);
+    void print_replay_summary(unsigned int cycle,
+                              Number tau,
+                              std::ostream &stream);
     void print_throughput(unsigned int cycle,
                           Number t,
                           std::ostream &stream,
@@ -145,9 +265,49 @@ namespace ryujin
                                 unsigned int output_cycle,
                                 bool write_to_logfile = false,
                                 bool final_time = false);
+
+    void write_statistics(unsigned int cycle, Number t, bool final_time);
+
+    /**
+     * Gather the partition sizes and the wall times of all timer
+     * sections of every MPI rank of the statistics_communicator() and
+     * write them (one line per rank) to the "rank statistics filename".
+     */
+    void write_rank_statistics(unsigned int cycle, Number t);
+
+    /**
+     * Return @p filename with the ensemble suffix (for example
+     * "-ensemble_1") inserted before the extension if ensembles are
+     * decoupled, and @p filename unchanged otherwise.
+     */
+    std::string ensemble_filename(const std::string &filename) const;
+
+    /**
+     * The communicator over which run time statistics are gathered: the
+     * synchronization communicator of the MPIEnsemble. For decoupled
+     * ensembles statistics are thus gathered per ensemble.
+     */
+    const MPI_Comm &statistics_communicator() const
+    {
+      return mpi_ensemble_.synchronization_communicator();
+    }
+
+    /**
+     * Return true on the MPI rank that writes log and statistics files,
+     * i.e., rank 0 of the statistics_communicator().
+     */
+    bool statistics_rank() const
+    {
+      return mpi_ensemble_.global_synchronization()
+                 ? mpi_ensemble_.world_rank() == 0
+                 : mpi_ensemble_.ensemble_rank() == 0;
+    }
     //@}
 
   private:
+    template <typename, int, typename>
+    friend class TimeLoop;
+
     /**
      * @name Run time options
      */
@@ -157,12 +317,22 @@ namespace ryujin
     std::string base_name_ensemble_;
 
     std::string debug_filename_;
+    std::string statistics_filename_;
+    std::string telemetry_filename_;
+    std::string rank_statistics_filename_;
 
     Number t_final_;
     bool enforce_t_final_;
     Number timer_granularity_;
 
+    Number convergence_tolerance_;
+    unsigned int convergence_check_interval_;
+
     bool enable_checkpointing_;
+    bool raw_checkpoints_;
+    bool checkpoint_compression_;
+    unsigned int buddy_checkpoint_interval_;
+    double buddy_checkpoint_timeout_;
     bool enable_output_full_;
     bool enable_output_levelsets_;
     bool enable_compute_error_;
@@ -176,13 +346,29 @@ namespace ryujin
 
     std::vector<std::string> error_quantities_;
     bool error_normalize_;
+    bool fused_error_norms_;
 
     bool resume_;
     bool resume_at_time_zero_;
+    unsigned int replay_cycles_;
+
+    std::string checkpoint_staging_directory_;
 
     Number terminal_update_interval_;
     bool terminal_show_rank_throughput_;
 
+    double peak_memory_bandwidth_;
+    double peak_flop_rate_;
+
+    bool pin_threads_;
+
+    bool use_huge_pages_;
+
+    unsigned int memory_pool_cache_size_;
+
+    bool dry_run_;
+    double dry_run_throughput_;
+
     //@}
     /**
      * @name Internal data:
@@ -191,8 +377,60 @@ namespace ryujin
 
     MPIEnsemble mpi_ensemble_;
 
+    EnsembleProgress ensemble_progress_;
+
     std::map<std::string, dealii::Timer> computing_timer_;
 
+    /**
+     * Pending background copy of a staged checkpoint into the output
+     * directory (only valid on ensemble rank 0).
+     */
+    std::future<void> checkpoint_drain_;
+
+    /**
+     * Set if the mesh was created, read in or adapted after the last call
+     * to write_checkpoint(), see the "raw checkpoints" option.
+     */
+    bool mesh_changed_since_checkpoint_;
+
+    /**
+     * The in-memory checkpoint of the hyperbolic state, see the "buddy
+     * checkpoint interval" option.
+     */
+    BuddyCheckpoint<Number> buddy_checkpoint_;
+
+    /**
+     * Name, wall time and growth of the resident set size (in MiB) of all
+     * phases executed prior to entering the main loop.
+     */
+    std::vector<std::tuple<std::string, double, double>> startup_profile_;
+
+    /**
+     * The mesh parameters (see mesh_parameters()) of the mesh and the
+     * offline data prepared by the last call to run(). Empty if these
+     * cannot be reused.
+     */
+    std::string prepared_mesh_parameters_;
+
+    /**
+     * The final state, time and timer cycle of the last call to run() if
+     * keep_final_state() is set.
+     */
+    bool keep_final_state_;
+    StateVector final_state_;
+    Number final_t_;
+    unsigned int final_timer_cycle_;
+
+    /**
+     * The triangulation, time, timer cycle and a callback initializing
+     * the state vector of a warm-up run that run() starts from, see
+     * run(warm_up). The triangulation is a nullptr otherwise.
+     */
+    const typename Discretization<dim>::Triangulation *handoff_triangulation_;
+    Number handoff_t_;
+    unsigned int handoff_timer_cycle_;
+    std::function<void(StateVector &)> handoff_state_;
+
     MPIEnsembleContainer<HyperbolicSystem> hyperbolic_system_;
     MPIEnsembleContainer<ParabolicSystem> parabolic_system_;
     Discretization<dim> discretization_;
@@ -209,8 +447,35 @@ namespace ryujin
 
     dealii::types::global_dof_index n_global_dofs_;
 
+    /**
+     * The hyperbolic state and time recorded by the last call to
+     * check_convergence(), and the rate of change computed in it.
+     */
+    typename View::HyperbolicVector convergence_state_;
+    Number convergence_time_;
+    Number convergence_rate_;
+
     std::ofstream logfile_; /* log file */
 
+    std::ofstream statistics_file_; /* machine-readable statistics */
+
+    Telemetry telemetry_; /* per-cycle progress */
+
+    /**
+     * Throughput metrics computed in the last call to print_throughput()
+     * and recorded by write_statistics().
+     */
+    struct ThroughputStatistics {
+      double wall_m_dofs_per_sec = 0.;
+      double cpu_m_dofs_per_sec = 0.;
+      double cycles_per_second = 0.;
+      double cpu_time_skew = 0.;
+      double cpu_time_skew_percentage = 0.;
+      double delta_time = 0.;
+    };
+
+    ThroughputStatistics throughput_statistics_;
+
     //@}
   };
 
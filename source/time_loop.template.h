@@ -5,10 +5,16 @@
 
 #pragma once
 
+#include "allocation_counter.h"
+#include "hardware_counters.h"
+#include "memory_pool.h"
+#include "numa.h"
+#include "openmp.h"
 #include "scope.h"
 #include "solution_transfer.h"
 #include "state_vector.h"
 #include "time_loop.h"
+#include "timeline_tracer.h"
 #include "version_info.h"
 
 #include <deal.II/base/logstream.h>
@@ -17,18 +23,294 @@
 #include <deal.II/numerics/vector_tools.h>
 #include <deal.II/numerics/vector_tools.templates.h>
 
+#ifdef DEAL_II_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 
 using namespace dealii;
 
 namespace ryujin
 {
+  namespace
+  {
+    /*
+     * Rotate checkpoints: the current checkpoint @p name becomes the
+     * previous checkpoint ("~"), and the new checkpoint (".new") becomes
+     * current. We always invalidate the target (and the source) by moving
+     * the metadata file first and restoring it last. This way at least
+     * one complete checkpoint exists at any point in time.
+     */
+    void rotate_checkpoint(const std::string &name)
+    {
+      const auto move = [](const std::string &from, const std::string &to) {
+        std::filesystem::remove(to + ".metadata");
+        if (!std::filesystem::exists(from + ".metadata"))
+          return;
+
+        std::filesystem::rename(from + ".metadata", to + ".metadata.pending");
+        for (const std::string suffix :
+             {".mesh", ".mesh_fixed.data", ".mesh.info", ".state"})
+          if (std::filesystem::exists(from + suffix))
+            std::filesystem::rename(from + suffix, to + suffix);
+        std::filesystem::rename(to + ".metadata.pending", to + ".metadata");
+      };
+
+      move(name, name + "~");
+      move(name + ".new", name);
+    }
+
+
+    /*
+     * Hard link (or copy if the file system does not support hard links)
+     * the mesh files of checkpoint @p from to checkpoint @p to.
+     */
+    void link_checkpoint_mesh(const std::string &from, const std::string &to)
+    {
+      namespace fs = std::filesystem;
+      for (const std::string suffix :
+           {".mesh", ".mesh_fixed.data", ".mesh.info"}) {
+        fs::remove(to + suffix);
+        if (!fs::exists(from + suffix))
+          continue;
+        std::error_code error;
+        fs::create_hard_link(from + suffix, to + suffix, error);
+        if (error)
+          fs::copy_file(from + suffix, to + suffix);
+      }
+    }
+
+
+    /*
+     * Write the locally owned part of @p vector as is (i.e., in the
+     * current DoF numbering and memory layout) into the file @p file_name
+     * with a single collective MPI IO call. The file starts with a header
+     * consisting of the number of ranks, a compression flag, the locally
+     * owned size of every rank and the number of bytes written by every
+     * rank, followed by the data of all ranks in rank order.
+     *
+     * If @p compress is set, the data of every rank is byte shuffled
+     * (i.e., the k-th bytes of all values are stored contiguously) and
+     * compressed with zlib.
+     */
+    template <typename Vector>
+    void write_raw_vector(const Vector &vector,
+                          const std::string &file_name,
+                          const MPI_Comm &communicator,
+                          const bool compress)
+    {
+      using value_type = typename Vector::value_type;
+
+      const auto n_ranks = Utilities::MPI::n_mpi_processes(communicator);
+      const auto rank = Utilities::MPI::this_mpi_process(communicator);
+
+      const unsigned long long size =
+          vector.get_partitioner()->locally_owned_size();
+
+      const char *data = reinterpret_cast<const char *>(vector.begin());
+      unsigned long long n_bytes = size * sizeof(value_type);
+
+      std::vector<char> buffer;
+      if (compress) {
+#ifdef DEAL_II_WITH_ZLIB
+        std::vector<char> shuffled(n_bytes);
+        for (unsigned long long i = 0; i < size; ++i)
+          for (unsigned int b = 0; b < sizeof(value_type); ++b)
+            shuffled[b * size + i] = data[i * sizeof(value_type) + b];
+
+        uLongf length = compressBound(n_bytes);
+        buffer.resize(length);
+        const int status =
+            compress2(reinterpret_cast<Bytef *>(buffer.data()),
+                      &length,
+                      reinterpret_cast<const Bytef *>(shuffled.data()),
+                      n_bytes,
+                      Z_BEST_SPEED);
+        AssertThrow(status == Z_OK,
+                    dealii::ExcMessage("zlib compression of the raw "
+                                       "checkpoint \"" +
+                                       file_name + "\" failed"));
+        data = buffer.data();
+        n_bytes = length;
+#else
+        AssertThrow(false,
+                    dealii::ExcMessage("Compressed checkpoints require "
+                                       "deal.II configured with zlib"));
+#endif
+      }
+
+      std::vector<unsigned long long> header(2 * n_ranks + 2);
+      header[0] = n_ranks;
+      header[1] = compress;
+      const std::array<unsigned long long, 2> local_sizes{{size, n_bytes}};
+      std::vector<unsigned long long> sizes(2 * n_ranks);
+      int ierr = MPI_Allgather(local_sizes.data(),
+                               2,
+                               MPI_UNSIGNED_LONG_LONG,
+                               sizes.data(),
+                               2,
+                               MPI_UNSIGNED_LONG_LONG,
+                               communicator);
+      AssertThrowMPI(ierr);
+      for (unsigned int r = 0; r < n_ranks; ++r) {
+        header[2 + r] = sizes[2 * r];
+        header[2 + n_ranks + r] = sizes[2 * r + 1];
+      }
+
+      unsigned long long offset = header.size() * sizeof(header[0]);
+      for (unsigned int r = 0; r < rank; ++r)
+        offset += header[2 + n_ranks + r];
+
+      MPI_File file;
+      ierr = MPI_File_open(communicator,
+                           file_name.c_str(),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                           MPI_INFO_NULL,
+                           &file);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_set_size(file, 0);
+      AssertThrowMPI(ierr);
+
+      if (rank == 0) {
+        ierr = MPI_File_write_at(file,
+                                 0,
+                                 header.data(),
+                                 header.size(),
+                                 MPI_UNSIGNED_LONG_LONG,
+                                 MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+      ierr = MPI_File_write_at_all(
+          file, offset, data, n_bytes, MPI_BYTE, MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_close(&file);
+      AssertThrowMPI(ierr);
+    }
+
+
+    /*
+     * Read the locally owned part of @p vector from a file @p file_name
+     * written by write_raw_vector(). The number of ranks and the locally
+     * owned sizes have to match.
+     */
+    template <typename Vector>
+    void read_raw_vector(Vector &vector,
+                         const std::string &file_name,
+                         const MPI_Comm &communicator)
+    {
+      using value_type = typename Vector::value_type;
+
+      const auto n_ranks = Utilities::MPI::n_mpi_processes(communicator);
+      const auto rank = Utilities::MPI::this_mpi_process(communicator);
+
+      MPI_File file;
+      int ierr = MPI_File_open(communicator,
+                               file_name.c_str(),
+                               MPI_MODE_RDONLY,
+                               MPI_INFO_NULL,
+                               &file);
+      AssertThrowMPI(ierr);
+
+      unsigned long long n_ranks_file = 0;
+      ierr = MPI_File_read_at_all(
+          file, 0, &n_ranks_file, 1, MPI_UNSIGNED_LONG_LONG, MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      AssertThrow(n_ranks_file == n_ranks,
+                  dealii::ExcMessage(
+                      "The raw checkpoint \"" + file_name + "\" was written " +
+                      "with " + std::to_string(n_ranks_file) + " MPI ranks " +
+                      "but we are running with " + std::to_string(n_ranks) +
+                      ". Resuming from a raw checkpoint requires the same " +
+                      "number of ranks."));
+
+      std::vector<unsigned long long> header(2 * n_ranks + 2);
+      ierr = MPI_File_read_at_all(file,
+                                  0,
+                                  header.data(),
+                                  header.size(),
+                                  MPI_UNSIGNED_LONG_LONG,
+                                  MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      const unsigned long long size =
+          vector.get_partitioner()->locally_owned_size();
+      AssertThrow(header[2 + rank] == size,
+                  dealii::ExcMessage(
+                      "The raw checkpoint \"" + file_name + "\" does not " +
+                      "match the current partition. Resuming from a raw " +
+                      "checkpoint requires identical discretization and " +
+                      "offline data parameters."));
+
+      const bool compressed = header[1] != 0;
+      const unsigned long long n_bytes = header[2 + n_ranks + rank];
+
+      unsigned long long offset = header.size() * sizeof(header[0]);
+      for (unsigned int r = 0; r < rank; ++r)
+        offset += header[2 + n_ranks + r];
+
+      char *data = reinterpret_cast<char *>(vector.begin());
+
+      std::vector<char> buffer(compressed ? n_bytes : 0);
+      ierr = MPI_File_read_at_all(file,
+                                  offset,
+                                  compressed ? buffer.data() : data,
+                                  n_bytes,
+                                  MPI_BYTE,
+                                  MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_close(&file);
+      AssertThrowMPI(ierr);
+
+      if (compressed) {
+#ifdef DEAL_II_WITH_ZLIB
+        std::vector<char> shuffled(size * sizeof(value_type));
+        uLongf length = shuffled.size();
+        const int status =
+            uncompress(reinterpret_cast<Bytef *>(shuffled.data()),
+                       &length,
+                       reinterpret_cast<const Bytef *>(buffer.data()),
+                       n_bytes);
+        AssertThrow(status == Z_OK && length == shuffled.size(),
+                    dealii::ExcMessage("zlib decompression of the raw "
+                                       "checkpoint \"" +
+                                       file_name + "\" failed"));
+
+        for (unsigned long long i = 0; i < size; ++i)
+          for (unsigned int b = 0; b < sizeof(value_type); ++b)
+            data[i * sizeof(value_type) + b] = shuffled[b * size + i];
+#else
+        AssertThrow(false,
+                    dealii::ExcMessage("Compressed checkpoints require "
+                                       "deal.II configured with zlib"));
+#endif
+      }
+
+      vector.update_ghost_values();
+    }
+  } // namespace
+
+
   template <typename Description, int dim, typename Number>
-  TimeLoop<Description, dim, Number>::TimeLoop(const MPI_Comm &mpi_comm)
+  TimeLoop<Description, dim, Number>::TimeLoop(
+      const MPI_Comm &mpi_comm,
+      const int n_ensembles,
+      const bool global_synchronization)
       : ParameterAcceptor("/A - TimeLoop")
-      , mpi_ensemble_(mpi_comm)
+      , mpi_ensemble_(mpi_comm, n_ensembles, global_synchronization)
+      , ensemble_progress_(mpi_ensemble_)
       , hyperbolic_system_(mpi_ensemble_, "/B - Equation")
       , parabolic_system_(mpi_ensemble_, "/B - Equation")
       , discretization_(mpi_ensemble_, "/C - Discretization")
@@ -76,6 +358,7 @@ namespace ryujin
                     postprocessor_,
                     hyperbolic_module_.initial_precomputed(),
                     hyperbolic_module_.alpha(),
+                    hyperbolic_module_.row_work_counters(),
                     "/J - VTUOutput")
       , quantities_(mpi_ensemble_,
                     offline_data_,
@@ -96,6 +379,23 @@ namespace ryujin
                   "enforced strictly. If set to true the last time step is "
                   "shortened so that the simulation ends precisely at t_final");
 
+    convergence_tolerance_ = Number(0.);
+    add_parameter(
+        "convergence tolerance",
+        convergence_tolerance_,
+        "If set to a positive value the computation is terminated early "
+        "(prior to reaching the final time) once the relative rate of "
+        "change |U(t) - U(t')|_1 / ((t - t') |U(t)|_1) of the state over "
+        "\"convergence check interval\" cycles drops below this tolerance, "
+        "i.e., once a steady state is reached. A value of zero disables the "
+        "check");
+
+    convergence_check_interval_ = 10;
+    add_parameter("convergence check interval",
+                  convergence_check_interval_,
+                  "Number of cycles between two consecutive convergence "
+                  "checks, see \"convergence tolerance\"");
+
     timer_granularity_ = Number(0.01);
     add_parameter("timer granularity",
                   timer_granularity_,
@@ -112,6 +412,49 @@ namespace ryujin
         "granularity intervals. The frequency is determined by \"timer "
         "granularity\" and \"timer checkpoint multiplier\"");
 
+    raw_checkpoints_ = false;
+    add_parameter(
+        "raw checkpoints",
+        raw_checkpoints_,
+        "If the mesh has not changed since the last checkpoint, write the "
+        "hyperbolic state of a checkpoint as a contiguous binary file in the "
+        "current DoF numbering with a single collective MPI IO call per "
+        "rank, instead of attaching it cell-wise to the triangulation. The "
+        "first checkpoint after startup and after every mesh adaptation is "
+        "written with SolutionTransfer. Resuming from a raw checkpoint "
+        "requires the same number of MPI ranks and unchanged discretization "
+        "and offline data parameters. The mesh files of the previous "
+        "checkpoint are reused for a raw checkpoint");
+
+    checkpoint_compression_ = false;
+    add_parameter("checkpoint compression",
+                  checkpoint_compression_,
+                  "Byte shuffle and compress the state of a raw checkpoint "
+                  "losslessly with zlib");
+
+    mesh_changed_since_checkpoint_ = true;
+
+    buddy_checkpoint_interval_ = 0;
+    add_parameter(
+        "buddy checkpoint interval",
+        buddy_checkpoint_interval_,
+        "Store a diskless checkpoint of the hyperbolic state every that many "
+        "cycles: every rank keeps a copy of its locally owned state in "
+        "memory and sends a second copy asynchronously to a partner rank on "
+        "another compute node. If a time step fails the state is recovered "
+        "from the in-memory checkpoint and written out as a regular "
+        "checkpoint (if checkpointing is enabled) so that the computation "
+        "can be resumed from it. A value of 0 disables buddy checkpoints");
+
+    buddy_checkpoint_timeout_ = 60.;
+    add_parameter(
+        "buddy checkpoint timeout",
+        buddy_checkpoint_timeout_,
+        "Time (in seconds) a rank with a failed time step waits for all "
+        "other ranks to fail as well before the buddy checkpoint is "
+        "recovered. If the failure is not collective within this time the "
+        "computation is aborted with MPI_Abort()");
+
     enable_output_full_ = false;
     add_parameter("enable output full",
                   enable_output_full_,
@@ -189,6 +532,17 @@ namespace ryujin
                   "Flag to control whether the error should be normalized by "
                   "the corresponding norm of the analytic solution.");
 
+    fused_error_norms_ = false;
+    add_parameter(
+        "fused error norms",
+        fused_error_norms_,
+        "Compute the error norms in a single thread-parallel pass over all "
+        "degrees of freedom that evaluates the analytic solution on the fly "
+        "and uses the lumped mass matrix as quadrature. This avoids "
+        "interpolating the analytic solution into a full state vector and "
+        "one Gauss quadrature pass per component and norm. The L1 and L2 "
+        "errors differ from the default by a quadrature error");
+
     resume_ = false;
     add_parameter("resume", resume_, "Resume an interrupted computation");
 
@@ -197,6 +551,28 @@ namespace ryujin
                   resume_at_time_zero_,
                   "Resume from the latest checkpoint but set the time to t=0.");
 
+    replay_cycles_ = 0;
+    add_parameter(
+        "replay cycles",
+        replay_cycles_,
+        "If nonzero, resume from the latest checkpoint and perform exactly "
+        "the given number of cycles with the time-step size fixed by the "
+        "first cycle. No output, checkpoints, quantities, mesh adaptation, "
+        "or convergence checks are performed, worker threads are pinned, "
+        "and a per cycle timing summary of all time step sections is "
+        "printed at the end. This allows to compare builds and machines on "
+        "identical states. Requires \"resume\" to be set");
+
+    checkpoint_staging_directory_ = "";
+    add_parameter(
+        "checkpoint staging directory",
+        checkpoint_staging_directory_,
+        "If set, checkpoints are written to this (fast) directory first "
+        "and copied to the output directory in the background while the "
+        "computation continues. The directory must be accessible by all "
+        "ranks of an ensemble, for example a burst buffer. A leading \"$\" "
+        "refers to an environment variable, for example \"$TMPDIR\"");
+
     terminal_update_interval_ = 5;
     add_parameter("terminal update interval",
                   terminal_update_interval_,
@@ -212,12 +588,102 @@ namespace ryujin
                   "average per thread \"CPU\" throughput value is computed by "
                   "using the umodified total accumulated CPU time.");
 
+    peak_memory_bandwidth_ = 0.;
+    add_parameter("peak memory bandwidth",
+                  peak_memory_bandwidth_,
+                  "Aggregate peak memory bandwidth (in GB/s) of all ranks. If "
+                  "set to a positive value and ryujin is configured with "
+                  "WITH_PERF_EVENT the achieved fraction of the peak bandwidth "
+                  "of every timer section is reported");
+
+    peak_flop_rate_ = 0.;
+    add_parameter("peak flop rate",
+                  peak_flop_rate_,
+                  "Aggregate peak floating point performance (in GFLOP/s) of "
+                  "all ranks. If set to a positive value (together with the "
+                  "peak memory bandwidth) the achieved fraction of the "
+                  "roofline bound of every timer section is reported");
+
+    pin_threads_ = false;
+    add_parameter("pin threads",
+                  pin_threads_,
+                  "If set to true every worker thread is pinned to a single "
+                  "CPU before data structures are set up. This keeps the "
+                  "(persistent) OpenMP thread pool on fixed cores and NUMA "
+                  "domains for the whole computation");
+
+    use_huge_pages_ = false;
+    add_parameter("use huge pages",
+                  use_huge_pages_,
+                  "If set to true the large vectors and matrices are backed "
+                  "by transparent (2 MiB) huge pages, which reduces the "
+                  "number of TLB misses of the gathers in the stencil "
+                  "loops. The achieved coverage is reported in the memory "
+                  "statistics");
+
+    memory_pool_cache_size_ = 0;
+    add_parameter("memory pool cache size",
+                  memory_pool_cache_size_,
+                  "Maximal size (in MiB) of unused blocks kept by the memory "
+                  "pool for the data arrays of sparse matrices. Blocks "
+                  "released during mesh adaptation are reused for the new "
+                  "data structures instead of being returned to the system. "
+                  "The NUMA placement of reused blocks is redone by a first "
+                  "touch. A value of zero disables the pool");
+
+    dry_run_ = false;
+    add_parameter("dry run",
+                  dry_run_,
+                  "If set to true, only the mesh and the partition are set "
+                  "up. An estimate of the per rank memory consumption and a "
+                  "prediction of the wall time per cycle are printed and the "
+                  "program exits without assembling any matrix");
+
+    dry_run_throughput_ = 0.;
+    add_parameter("dry run throughput",
+                  dry_run_throughput_,
+                  "Calibrated per rank throughput (in MQ/s) used to predict "
+                  "the wall time per cycle in a dry run. Use the \"RANK\" "
+                  "throughput reported by a (short) previous run on the same "
+                  "hardware. A value of zero disables the prediction");
+
     debug_filename_ = "";
     add_parameter("debug filename",
                   debug_filename_,
                   "If set to a nonempty string then we output the contents of "
                   "this file at the end. This is mainly useful in the "
-                  "testsuite to output files we wish to compare");
+                  "testsuite to output files we wish to compare. Binary "
+                  "space averaged time series are printed in text format");
+
+    statistics_filename_ = "";
+    add_parameter("statistics filename",
+                  statistics_filename_,
+                  "If set to a nonempty string then machine-readable timer "
+                  "and throughput statistics are written to this file on "
+                  "every terminal update. Every line of the file is a "
+                  "self-contained JSON object");
+
+    telemetry_filename_ = "";
+    add_parameter("telemetry filename",
+                  telemetry_filename_,
+                  "If set to a nonempty string then the progress of every "
+                  "cycle (cycle, t, tau, restarts, warnings and throughput) "
+                  "is written to this file (or named pipe) by a background "
+                  "thread. In contrast to the statistics file this requires "
+                  "neither MPI communication nor a terminal update. Every "
+                  "line of the file is a self-contained JSON object");
+
+    rank_statistics_filename_ = "";
+    add_parameter("rank statistics filename",
+                  rank_statistics_filename_,
+                  "If set to a nonempty string then the wall time of every "
+                  "timer section and the number of locally owned, internal, "
+                  "ghost and export degrees of freedom of every MPI rank are "
+                  "written to this file (in CSV format) whenever the log file "
+                  "is updated. This allows to identify slow ranks");
+
+    keep_final_state_ = false;
+    handoff_triangulation_ = nullptr;
   }
 
 
@@ -238,13 +704,48 @@ namespace ryujin
       }
     }
 
+    /* Reset timers and statistics of a previous run: */
+
+    for (auto &it : computing_timer_)
+      it.second.reset();
+    hyperbolic_module_.clear_stage_traffic();
+    startup_profile_.clear();
+
     /* Attach log file and record runtime parameters: */
 
-    if (mpi_ensemble_.world_rank() == 0)
-      logfile_.open(base_name_ + ".log");
+    /* Decoupled ensembles keep log and statistics files of their own: */
+
+    if (statistics_rank()) {
+      const bool decoupled = !mpi_ensemble_.global_synchronization();
+      logfile_.open((decoupled ? base_name_ensemble_ : base_name_) + ".log");
+
+      if (statistics_filename_ != "")
+        statistics_file_.open(ensemble_filename(statistics_filename_));
+
+      if (telemetry_filename_ != "")
+        telemetry_.open(ensemble_filename(telemetry_filename_));
+    }
 
     print_parameters(logfile_);
 
+    AssertThrow(!dry_run_ || !resume_,
+                dealii::ExcMessage("\"dry run\" cannot be combined with "
+                                   "\"resume\""));
+
+    const bool replay = replay_cycles_ != 0;
+    AssertThrow(!replay || resume_,
+                dealii::ExcMessage("\"replay cycles\" requires \"resume\" to "
+                                   "be set"));
+
+    if (pin_threads_ || replay) {
+      print_info("pinning worker threads");
+      pin_threads(mpi_ensemble_.node_rank());
+    }
+
+    NUMA::huge_pages_enabled() = use_huge_pages_;
+    MemoryPool::instance().set_cache_size(std::size_t(memory_pool_cache_size_)
+                                          << 20);
+
     /*
      * Prepare data structures:
      */
@@ -253,31 +754,82 @@ namespace ryujin
     unsigned int timer_cycle = 0;
     StateVector state_vector;
 
-    /* Create a small lambda for preparing compute kernels: */
-    const auto prepare_compute_kernels = [&]() {
-      print_info("preparing compute kernels");
+    /*
+     * Create a small lambda that records the wall time and the growth of
+     * the resident set size of a phase executed prior to entering the
+     * main loop, see print_startup_profile():
+     */
+    bool record_startup_profile = true;
+    const auto startup_phase = [&](const std::string &name,
+                                   const auto &callable) {
+      if (!record_startup_profile) {
+        callable();
+        return;
+      }
+
+      Utilities::System::MemoryStats stats;
+      Utilities::System::get_memory_stats(stats);
+      const double memory = stats.VmRSS / 1024.;
 
-      unsigned int n_parabolic_state_vectors =
-          parabolic_system_.get().n_parabolic_state_vectors();
+      dealii::Timer timer;
+      callable();
+      timer.stop();
+
+      Utilities::System::get_memory_stats(stats);
+      startup_profile_.emplace_back(
+          name, timer.wall_time(), stats.VmRSS / 1024. - memory);
+    };
 
-      offline_data_.prepare(
-          problem_dimension, n_precomputed_values, n_parabolic_state_vectors);
+    const unsigned int n_parabolic_state_vectors =
+        parabolic_system_.get().n_parabolic_state_vectors();
+
+    /* Create small lambdas for preparing compute kernels: */
+    const auto prepare_modules = [&]() {
+      startup_phase("modules", [&]() {
+        /* Weighted repartitioning needs the work recorded per row: */
+        hyperbolic_module_.record_row_work(
+            enable_mesh_adaptivity_ && mesh_adaptor_.weighted_repartitioning());
+        hyperbolic_module_.prepare();
+        parabolic_module_.prepare();
+        time_integrator_.prepare();
+        mesh_adaptor_.prepare(/*needs current timepoint*/ t);
+        postprocessor_.prepare();
+        vtu_output_.prepare();
+        quantities_.prepare(base_name_ensemble_);
+      });
 
-      hyperbolic_module_.prepare();
-      parabolic_module_.prepare();
-      time_integrator_.prepare();
-      mesh_adaptor_.prepare(/*needs current timepoint*/ t);
-      postprocessor_.prepare();
-      vtu_output_.prepare();
-      quantities_.prepare(base_name_ensemble_);
       print_mpi_partition(logfile_);
 
-      if (mpi_ensemble_.ensemble_rank() == 0)
+      /* Decoupled ensembles only report their own degrees of freedom: */
+      if (!mpi_ensemble_.global_synchronization())
+        n_global_dofs_ = offline_data_.dof_handler().n_dofs();
+      else if (mpi_ensemble_.ensemble_rank() == 0)
         n_global_dofs_ = dealii::Utilities::MPI::sum(
             offline_data_.dof_handler().n_dofs(),
             mpi_ensemble_.ensemble_leader_communicator());
     };
 
+    const auto prepare_compute_kernels = [&]() {
+      print_info("preparing compute kernels");
+
+      startup_phase("offline data", [&]() {
+        offline_data_.prepare(
+            problem_dimension, n_precomputed_values, n_parabolic_state_vectors);
+      });
+
+      prepare_modules();
+    };
+
+    /*
+     * Reuse the mesh and the offline data of a previous run if possible,
+     * see the documentation of run():
+     */
+    const auto mesh_signature =
+        mesh_parameters() + std::to_string(n_parabolic_state_vectors);
+    const bool reuse_mesh = !resume_ && !dry_run_ &&
+                            mesh_signature == prepared_mesh_parameters_;
+    prepared_mesh_parameters_.clear();
+
     {
       Scope scope(computing_timer_, "(re)initialize data structures");
       print_info("initializing data structures");
@@ -298,18 +850,60 @@ namespace ryujin
         }
 
       } else {
-        print_info("creating mesh and interpolating initial values");
-
-        discretization_.prepare(base_name_ensemble_);
+        if (handoff_triangulation_ != nullptr) {
+          print_info("copying mesh and state vector of the warm-up run");
+
+          t = handoff_t_;
+          timer_cycle = handoff_timer_cycle_;
+
+          startup_phase("discretization", [&]() {
+            discretization_.refinement() = 0; /* do not refine */
+            discretization_.prepare(base_name_ensemble_);
+            auto &triangulation = discretization_.triangulation();
+            triangulation.clear();
+            triangulation.copy_triangulation(*handoff_triangulation_);
+          });
+
+          prepare_compute_kernels();
+
+        } else if (reuse_mesh) {
+          print_info("reusing mesh and interpolating initial values");
+          print_info("preparing compute kernels");
+          prepare_modules();
+
+        } else {
+          print_info("creating mesh and interpolating initial values");
+
+          startup_phase("discretization", [&]() {
+            discretization_.prepare(base_name_ensemble_);
+          });
+
+          if (dry_run_) {
+            print_info("dry run: estimating memory and time per cycle");
+            offline_data_.prepare_partition(problem_dimension,
+                                            n_precomputed_values);
+            time_integrator_.prepare(/*allocate*/ false);
+            print_dry_run_estimate(logfile_, n_parabolic_state_vectors);
+            return;
+          }
 
-        prepare_compute_kernels();
+          prepare_compute_kernels();
+        }
 
-        Vectors::reinit_state_vector<Description>(state_vector, offline_data_);
-        std::get<0>(state_vector) =
-            initial_values_.get().interpolate_hyperbolic_vector();
+        startup_phase("initial values", [&]() {
+          Vectors::reinit_state_vector<Description>(state_vector,
+                                                    offline_data_);
+          if (handoff_state_)
+            handoff_state_(state_vector);
+          else
+            std::get<0>(state_vector) =
+                initial_values_.get().interpolate_hyperbolic_vector();
+        });
       }
     }
 
+    record_startup_profile = false;
+
     /*
      * In debug mode poison constrained degrees of freedom and precomputed
      * values:
@@ -319,6 +913,15 @@ namespace ryujin
     Vectors::debug_poison_precomputed_values<Description>(state_vector,
                                                           offline_data_);
 
+    /* Record the initial state for the convergence check: */
+    convergence_rate_ = std::numeric_limits<Number>::max();
+    convergence_time_ = std::numeric_limits<Number>::max();
+    bool state_converged = false;
+
+    double last_telemetry_wall_time = 0.;
+    if (convergence_tolerance_ > Number(0.))
+      check_convergence(state_vector, t);
+
     unsigned int cycle = 1;
     Number last_terminal_output = (terminal_update_interval_ == Number(0.)
                                        ? std::numeric_limits<Number>::max()
@@ -328,12 +931,35 @@ namespace ryujin
      * The honorable main loop:
      */
 
+    /* Place the buddy checkpoint of every rank on the next node: */
+    if (buddy_checkpoint_interval_ != 0)
+      buddy_checkpoint_.reinit(
+          mpi_ensemble_.ensemble_communicator(),
+          Utilities::MPI::n_mpi_processes(
+              mpi_ensemble_.ensemble_node_communicator()));
+
     print_info("entering main loop");
     computing_timer_["time loop"].start();
 
     constexpr Number relax =
         Number(1.) - Number(10.) * std::numeric_limits<Number>::epsilon();
 
+    /* In replay mode all cycles use the time-step size of the first: */
+    Number replay_tau = std::numeric_limits<Number>::max();
+
+    /* Report the autotuned kernel variants once they are locked in: */
+    bool kernel_variants_reported = false;
+
+#ifdef COUNT_ALLOCATIONS
+    /*
+     * Heap allocations inside time steps. The first cycles are skipped
+     * as they populate caches and scratch storage:
+     */
+    constexpr unsigned int n_warm_up_cycles = 2;
+    std::uint64_t n_step_allocations = 0;
+    std::uint64_t max_step_allocations = 0;
+#endif
+
     for (;; ++cycle) {
 
 #ifdef DEBUG_OUTPUT
@@ -342,7 +968,7 @@ namespace ryujin
 
       /* Accumulate quantities of interest: */
 
-      if (enable_compute_quantities_) {
+      if (enable_compute_quantities_ && !replay) {
         Scope scope(computing_timer_,
                     "time step [X]   - accumulate quantities");
         quantities_.accumulate(state_vector, t);
@@ -350,15 +976,26 @@ namespace ryujin
 
       /* Perform various tasks whenever we reach a timer tick: */
 
-      if (t >= relax * timer_cycle * timer_granularity_) {
-        if (enable_compute_error_) {
+      /* Did a steady state computation, or the state itself, converge? */
+      const bool converged =
+          time_integrator_.steady_state_converged() || state_converged;
+
+      if (!replay &&
+          (converged || t >= relax * timer_cycle * timer_granularity_)) {
+        /*
+         * Only interpolate the analytic solution if we are actually going
+         * to write it out in this cycle:
+         */
+        const bool output_analytic =
+            enable_compute_error_ &&
+            ((enable_output_full_ &&
+              timer_cycle % timer_output_full_multiplier_ == 0) ||
+             (enable_output_levelsets_ &&
+              timer_cycle % timer_output_levelsets_multiplier_ == 0));
+
+        if (output_analytic) {
           StateVector analytic;
           {
-            /*
-             * FIXME: We interpolate the analytic solution at every timer
-             * tick. If we happen to actually not output anything then this
-             * is terribly inefficient...
-             */
             Scope scope(computing_timer_,
                         "time step [X]   - interpolate analytic solution");
             Vectors::reinit_state_vector<Description>(analytic, offline_data_);
@@ -389,14 +1026,15 @@ namespace ryujin
         ++timer_cycle;
       }
 
-      /* Break if we have reached the final time. */
+      /* Break if we have reached the final time, or a steady state. */
 
-      if (t >= relax * t_final_)
+      if (replay ? cycle > replay_cycles_
+                 : (converged || t >= relax * t_final_))
         break;
 
       /* Peform a mesh adaptation cycle: */
 
-      if (enable_mesh_adaptivity_) {
+      if (enable_mesh_adaptivity_ && !replay) {
         {
           Scope scope(computing_timer_,
                       "time step [X]   - analyze for mesh adaptation");
@@ -409,22 +1047,112 @@ namespace ryujin
           print_info("performing mesh adaptation");
 
           hyperbolic_module_.prepare_state_vector(state_vector, t);
-          adapt_mesh_and_transfer_state_vector(state_vector,
-                                               prepare_compute_kernels);
+          adapt_mesh_and_transfer_state_vector(
+              state_vector, t, prepare_compute_kernels);
+
+          /* The buddy checkpoint does not match the new partition: */
+          buddy_checkpoint_.clear();
         }
       }
 
       /* Perform a time step: */
 
-      const auto tau = time_integrator_.step(
-          state_vector,
-          t,
-          enforce_t_final_
-              ? std::min(t_final_, timer_cycle * timer_granularity_)
-              : std::numeric_limits<Number>::max());
+      auto tau_max = enforce_t_final_
+                         ? std::min(t_final_, timer_cycle * timer_granularity_)
+                         : std::numeric_limits<Number>::max();
+      if (replay)
+        tau_max = replay_tau;
+
+#ifdef COUNT_ALLOCATIONS
+      const auto n_allocations = AllocationCounter::value();
+#endif
+
+      const auto tau = [&]() {
+        if (!buddy_checkpoint_.valid())
+          return time_integrator_.step(state_vector, t, tau_max);
+
+        try {
+          return time_integrator_.step(state_vector, t, tau_max);
+        } catch (const dealii::ExceptionBase &) {
+          /*
+           * Salvage the last buddy checkpoint to disk before giving up.
+           * Recovering and writing the checkpoint is collective, we thus
+           * first agree that the failure is collective, as for example
+           * the crash detection after the reduction of the time step
+           * size. After a rank-local exception the remaining ranks are
+           * stuck in (or ahead of) the step and we abort instead:
+           */
+          if (!buddy_checkpoint_.agree_on_failure(buddy_checkpoint_timeout_)) {
+            std::cerr << "Time step failed on a subset of ranks, aborting"
+                      << std::endl;
+            MPI_Abort(mpi_ensemble_.world_communicator(), 1);
+          }
+
+          print_info("time step failed, recovering buddy checkpoint");
+          recover_buddy_checkpoint(state_vector, t, timer_cycle);
+          if (enable_checkpointing_) {
+            hyperbolic_module_.prepare_state_vector(state_vector, t);
+            write_checkpoint(state_vector, base_name_ensemble_, t, timer_cycle);
+          }
+          throw;
+        }
+      }();
+
+#ifdef COUNT_ALLOCATIONS
+      if (cycle > n_warm_up_cycles) {
+        const auto n = AllocationCounter::value() - n_allocations;
+        n_step_allocations += n;
+        max_step_allocations = std::max(max_step_allocations, n);
+#ifdef DEBUG_OUTPUT
+        std::cout << "heap allocations in time step: " << n << std::endl;
+#endif
+      }
+#endif
 
       t += tau;
 
+      if (buddy_checkpoint_interval_ != 0 &&
+          cycle % buddy_checkpoint_interval_ == 0 && !replay) {
+        Scope scope(computing_timer_, "time step [X]   - buddy checkpoint");
+        buddy_checkpoint_.store(std::get<0>(state_vector), t, timer_cycle);
+      }
+
+      const auto &kernel_variants = hyperbolic_module_.kernel_variants();
+      if (!kernel_variants_reported && kernel_variants.selected()) {
+        kernel_variants_reported = true;
+        if (statistics_rank()) {
+          logfile_ << std::endl << "Autotuned kernel variants:" << std::endl;
+          kernel_variants.print(logfile_);
+        }
+      }
+
+      if (replay && cycle == 1)
+        replay_tau = tau;
+
+      /* Check for convergence to a steady state: */
+      if (!replay && convergence_tolerance_ > Number(0.) &&
+          cycle % convergence_check_interval_ == 0) {
+        Scope scope(computing_timer_, "time step [X]   - check convergence");
+        state_converged = check_convergence(state_vector, t);
+        if (state_converged)
+          print_info("state converged, terminating early");
+      }
+
+      /* Record the progress of the cycle without any communication: */
+      if (telemetry_.enabled()) {
+        const auto wall_time = computing_timer_["time loop"].wall_time();
+        const auto delta = wall_time - last_telemetry_wall_time;
+        last_telemetry_wall_time = wall_time;
+        telemetry_.push({cycle,
+                         double(t),
+                         double(tau),
+                         hyperbolic_module_.n_restarts() +
+                             parabolic_module_.n_restarts(),
+                         hyperbolic_module_.n_warnings() +
+                             parabolic_module_.n_warnings(),
+                         delta > 0. ? n_global_dofs_ / delta / 1.e6 : 0.});
+      }
+
       /* Print and record cycle statistics: */
       if (terminal_update_interval_ != Number(0.)) {
 
@@ -438,11 +1166,8 @@ namespace ryujin
             (wall_time >= last_terminal_output + terminal_update_interval_);
 
         /* Broadcast boolean from rank 0 to all other ranks: */
-        const auto ierr = MPI_Bcast(&update_terminal,
-                                    1,
-                                    MPI_INT,
-                                    0,
-                                    mpi_ensemble_.world_communicator());
+        const auto ierr = MPI_Bcast(
+            &update_terminal, 1, MPI_INT, 0, statistics_communicator());
         AssertThrowMPI(ierr);
 
         if (write_to_log_file || update_terminal) {
@@ -456,31 +1181,155 @@ namespace ryujin
     /* We have actually performed one cycle less. */
     --cycle;
 
+    /* Make sure that a staged checkpoint has reached the output directory: */
+    if (checkpoint_drain_.valid())
+      checkpoint_drain_.get();
+
     computing_timer_["time loop"].stop();
 
+#ifdef COUNT_ALLOCATIONS
+    if (cycle > n_warm_up_cycles) {
+      const auto &communicator = mpi_ensemble_.ensemble_communicator();
+      const auto total = Utilities::MPI::sum(n_step_allocations, communicator);
+      const auto maximum =
+          Utilities::MPI::max(max_step_allocations, communicator);
+      std::ostringstream output;
+      output << "heap allocations per time step after warm-up: "
+             << double(total) / double(cycle - n_warm_up_cycles) /
+                    double(mpi_ensemble_.n_ensemble_ranks())
+             << " (average), " << maximum << " (maximum)";
+      print_info(output.str());
+    }
+#endif
+
     if (terminal_update_interval_ != Number(0.)) {
       /* Write final timing statistics to screen and logfile: */
       print_cycle_statistics(
           cycle, t, timer_cycle, /*logfile*/ true, /*final*/ true);
     }
 
-    if (enable_compute_error_) {
+    if (replay) {
+      print_replay_summary(cycle, replay_tau, std::cout);
+      print_replay_summary(cycle, replay_tau, logfile_);
+    }
+
+    if (enable_compute_error_ && !replay) {
       /* Output final error: */
       compute_error(state_vector, t);
     }
 
+#ifdef TIMELINE_TRACING
+    /* Write out the recorded timeline of this rank: */
+    const auto world_rank = mpi_ensemble_.world_rank();
+    TimelineTracer::instance().write(
+        base_name_ + "-trace-" + std::to_string(world_rank) + ".json",
+        world_rank);
+#endif
+
     if (mpi_ensemble_.world_rank() == 0 && debug_filename_ != "") {
-      std::ifstream f(debug_filename_);
-      if (f.is_open())
-        std::cout << f.rdbuf();
+      std::ifstream f(debug_filename_, std::ios::binary);
+      if (f.is_open()) {
+        /* Print binary time series in the text format: */
+        if (debug_filename_.ends_with("-space_averaged_time_series.bin"))
+          decltype(quantities_)::convert_time_series(f, std::cout);
+        else
+          std::cout << f.rdbuf();
+      }
+    }
+
+    /* Record whether the mesh can be reused by a subsequent run: */
+    if (!resume_ && !enable_mesh_adaptivity_ &&
+        handoff_triangulation_ == nullptr)
+      prepared_mesh_parameters_ = mesh_signature;
+
+    /* Keep the final state for a subsequent run(warm_up): */
+    if (keep_final_state_) {
+      final_state_ = std::move(state_vector);
+      final_t_ = t;
+      final_timer_cycle_ = timer_cycle;
     }
 
+    logfile_.close();
+    statistics_file_.close();
+    telemetry_.close();
+
 #ifdef WITH_VALGRIND
     CALLGRIND_DUMP_STATS;
 #endif
   }
 
 
+  template <typename Description, int dim, typename Number>
+  template <typename OtherNumber>
+  void TimeLoop<Description, dim, Number>::run(
+      const TimeLoop<Description, dim, OtherNumber> &warm_up)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::run(warm_up)" << std::endl;
+#endif
+
+    AssertThrow(warm_up.keep_final_state_ &&
+                    std::get<0>(warm_up.final_state_).size() != 0,
+                dealii::ExcMessage(
+                    "The warm-up TimeLoop has to be run with "
+                    "keep_final_state() set to true prior to a handoff."));
+
+    handoff_triangulation_ = &warm_up.discretization_.triangulation();
+    handoff_t_ = Number(warm_up.final_t_);
+    handoff_timer_cycle_ = warm_up.final_timer_cycle_;
+
+    /*
+     * The two triangulations are identical, but the (SIMD width
+     * dependent) numbering of the degrees of freedom is not. We thus
+     * match degrees of freedom cell by cell:
+     */
+    handoff_state_ = [&](StateVector &state_vector) {
+      const auto &old_U = std::get<0>(warm_up.final_state_);
+      auto &U = std::get<0>(state_vector);
+
+      const auto &old_dof_handler = warm_up.offline_data_.dof_handler();
+      const auto &old_partitioner = *warm_up.offline_data_.scalar_partitioner();
+      const auto &dof_handler = offline_data_.dof_handler();
+      const auto &scalar_partitioner = *offline_data_.scalar_partitioner();
+
+      const auto n_dofs_per_cell = dof_handler.get_fe().n_dofs_per_cell();
+      std::vector<dealii::types::global_dof_index> old_dof_indices(
+          n_dofs_per_cell);
+      std::vector<dealii::types::global_dof_index> dof_indices(
+          n_dofs_per_cell);
+
+      auto old_cell = old_dof_handler.begin_active();
+      for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (cell->is_locally_owned()) {
+          Assert(old_cell->is_locally_owned() &&
+                     old_cell->center() == cell->center(),
+                 dealii::ExcInternalError());
+          old_cell->get_dof_indices(old_dof_indices);
+          cell->get_dof_indices(dof_indices);
+
+          for (unsigned int k = 0; k < n_dofs_per_cell; ++k) {
+            if (!scalar_partitioner.in_local_range(dof_indices[k]))
+              continue;
+            const auto i = scalar_partitioner.global_to_local(dof_indices[k]);
+            const auto j = old_partitioner.global_to_local(old_dof_indices[k]);
+            const auto old_U_j = old_U.get_tensor(j);
+            typename View::state_type U_i;
+            for (unsigned int d = 0; d < problem_dimension; ++d)
+              U_i[d] = Number(old_U_j[d]);
+            U.write_tensor(U_i, i);
+          }
+        }
+        ++old_cell;
+      }
+    };
+
+    run();
+
+    handoff_triangulation_ = nullptr;
+    handoff_state_ = nullptr;
+  }
+
+
   template <typename Description, int dim, typename Number>
   template <typename Callable>
   void TimeLoop<Description, dim, Number>::read_checkpoint(
@@ -500,27 +1349,82 @@ namespace ryujin
                     "distributed::shared::Triangulation which we use in 1D"));
 
     /*
-     * Initialize discretization, read in the mesh, and initialize everything:
+     * Select the most recent complete checkpoint. A checkpoint is
+     * complete if its metadata file exists (see write_checkpoint()). We
+     * try the current, the pending, and the previous checkpoint in this
+     * order. If a staging directory is set we do the same for the staged
+     * checkpoints and use whichever of the two has the larger output
+     * cycle:
+     */
+
+    std::string name;
+    if (mpi_ensemble_.ensemble_rank() == 0) {
+      const auto select = [](const std::string &prefix) {
+        for (const std::string suffix : {"", ".new", "~"})
+          if (std::filesystem::exists(prefix + suffix + ".metadata"))
+            return prefix + suffix;
+        return std::string();
+      };
+
+      const auto output_cycle_of = [](const std::string &checkpoint) {
+        Number checkpoint_t;
+        unsigned int checkpoint_cycle, checkpoint_handle;
+        std::ifstream file(checkpoint + ".metadata", std::ios::binary);
+        boost::archive::binary_iarchive ia(file);
+        ia >> checkpoint_t >> checkpoint_cycle >> checkpoint_handle;
+        return checkpoint_cycle;
+      };
+
+      name = select(base_name + "-checkpoint");
+
+      const auto staging_name = checkpoint_staging_name(base_name);
+      if (!staging_name.empty()) {
+        const auto staged = select(staging_name);
+        if (!staged.empty() &&
+            (name.empty() || output_cycle_of(staged) > output_cycle_of(name)))
+          name = staged;
+      }
+    }
+    name = dealii::Utilities::MPI::broadcast(
+        mpi_ensemble_.ensemble_communicator(), name);
+
+    AssertThrow(!name.empty(),
+                dealii::ExcMessage("Could not find a complete checkpoint \"" +
+                                   base_name + "-checkpoint\" to resume from"));
+
+    /*
+     * Initialize discretization, read in the mesh, and initialize
+     * everything. Triangulation::load() reads the mesh and attached state
+     * in parallel (via MPI IO) and repartitions the forest over the
+     * current set of MPI ranks. It is thus possible to resume on a
+     * different number of ranks than the checkpoint was written with:
      */
 
+    {
+      Scope scope(computing_timer_, "resume [R]      - load mesh");
 #if !DEAL_II_VERSION_GTE(9, 6, 0)
-    if constexpr (have_distributed_triangulation<dim>) {
+      if constexpr (have_distributed_triangulation<dim>) {
 #endif
-      discretization_.refinement() = 0; /* do not refine */
-      discretization_.prepare(base_name);
-      discretization_.triangulation().load(base_name + "-checkpoint.mesh");
+        discretization_.refinement() = 0; /* do not refine */
+        discretization_.prepare(base_name);
+        discretization_.triangulation().load(name + ".mesh");
 #if !DEAL_II_VERSION_GTE(9, 6, 0)
-    }
+      }
 #endif
+      mesh_changed_since_checkpoint_ = true;
+    }
 
-    prepare_compute_kernels();
+    {
+      Scope scope(computing_timer_, "resume [R]      - prepare kernels");
+      prepare_compute_kernels();
+    }
+
+    Scope scope(computing_timer_, "resume [R]      - load state vector");
 
     /*
      * Read in and broadcast metadata:
      */
 
-    std::string name = base_name + "-checkpoint";
-
     unsigned int transfer_handle;
     if (mpi_ensemble_.ensemble_rank() == 0) {
       std::string meta = name + ".metadata";
@@ -554,11 +1458,19 @@ namespace ryujin
     AssertThrowMPI(ierr);
 
     /*
-     * Now read in the state vector:
+     * Now read in the state vector. An invalid transfer handle marks a
+     * raw checkpoint, see write_checkpoint():
      */
 
     Vectors::reinit_state_vector<Description>(state_vector, offline_data_);
 
+    if (transfer_handle == dealii::numbers::invalid_unsigned_int) {
+      read_raw_vector(std::get<0>(state_vector),
+                      name + ".state",
+                      mpi_ensemble_.ensemble_communicator());
+      return;
+    }
+
     SolutionTransfer<Description, dim, Number> solution_transfer(
         mpi_ensemble_,
         /* we need write access: */ discretization_.triangulation(),
@@ -588,9 +1500,37 @@ namespace ryujin
                     "distributed::shared::Triangulation which we use in 1D"));
 
     /*
-     * Create SolutionTransfer object, attach state vector and write out:
+     * Wait for the background copy of the previously staged checkpoint
+     * to finish before we overwrite the staging area:
+     */
+
+    if (checkpoint_drain_.valid())
+      checkpoint_drain_.get();
+
+    /*
+     * We first write the checkpoint into a set of temporary ".new" files
+     * and rotate them into place afterwards. This ensures that an
+     * interrupted write operation never destroys the previous checkpoint.
+     */
+
+    const std::string staging_name = checkpoint_staging_name(base_name);
+    const std::string name =
+        staging_name.empty() ? base_name + "-checkpoint" : staging_name;
+    const std::string new_name = name + ".new";
+
+    /*
+     * Create SolutionTransfer object, attach state vector and write out.
+     * For a raw checkpoint we write the state vector directly and store
+     * an invalid transfer handle in the metadata instead. We only do so
+     * if the mesh has not changed since the last checkpoint; otherwise
+     * the mesh has to be written anyway and we fall back to the portable
+     * SolutionTransfer format:
      */
 
+    const bool raw_checkpoint =
+        raw_checkpoints_ && !mesh_changed_since_checkpoint_;
+    mesh_changed_since_checkpoint_ = false;
+
     SolutionTransfer<Description, dim, Number> solution_transfer(
         mpi_ensemble_,
         /* we need write access: */ discretization_.triangulation(),
@@ -598,48 +1538,143 @@ namespace ryujin
         hyperbolic_system_,
         parabolic_system_);
 
-    /* need hyperbolic_module.prepare_state_vector() prior to this call: */
-    solution_transfer.prepare_projection(state_vector);
-    const auto transfer_handle = solution_transfer.get_handle();
-
-    std::string name = base_name + "-checkpoint";
-
-    if (mpi_ensemble_.ensemble_rank() == 0) {
-      for (const std::string suffix :
-           {".mesh", ".mesh_fixed.data", ".mesh.info", ".metadata"})
-        if (std::filesystem::exists(name + suffix))
-          std::filesystem::rename(name + suffix, name + suffix + "~");
+    auto transfer_handle = dealii::numbers::invalid_unsigned_int;
+    if (raw_checkpoint) {
+      write_raw_vector(std::get<0>(state_vector),
+                       new_name + ".state",
+                       mpi_ensemble_.ensemble_communicator(),
+                       checkpoint_compression_);
+    } else {
+      /* need hyperbolic_module.prepare_state_vector() prior to this call: */
+      solution_transfer.prepare_projection(state_vector);
+      transfer_handle = solution_transfer.get_handle();
     }
 
+    /*
+     * For a raw checkpoint the mesh is unchanged since the previous
+     * checkpoint @p name (written in this run), so we simply link its
+     * mesh files instead of writing the mesh again:
+     */
+
+    if (raw_checkpoint) {
+      if (mpi_ensemble_.ensemble_rank() == 0)
+        link_checkpoint_mesh(name, new_name);
+    } else {
 #if !DEAL_II_VERSION_GTE(9, 6, 0)
-    if constexpr (have_distributed_triangulation<dim>) {
+      if constexpr (have_distributed_triangulation<dim>) {
 #endif
-      const auto &triangulation = discretization_.triangulation();
-      triangulation.save(name + ".mesh");
+        const auto &triangulation = discretization_.triangulation();
+        triangulation.save(new_name + ".mesh");
 #if !DEAL_II_VERSION_GTE(9, 6, 0)
-    }
+      }
 #endif
+    }
 
     /*
-     * Now, write out metadata on rank 0:
+     * Now, write out metadata on rank 0. The metadata file is written
+     * last and marks the checkpoint as complete:
      */
 
     if (mpi_ensemble_.ensemble_rank() == 0) {
-      std::string meta = name + ".metadata";
+      std::string meta = new_name + ".metadata";
       std::ofstream file(meta, std::ios::binary | std::ios::trunc);
       boost::archive::binary_oarchive oa(file);
       oa << t << output_cycle << transfer_handle;
     }
 
-    const int ierr = MPI_Barrier(mpi_ensemble_.ensemble_communicator());
+    int ierr = MPI_Barrier(mpi_ensemble_.ensemble_communicator());
+    AssertThrowMPI(ierr);
+
+    /*
+     * Rotate checkpoints (see rotate_checkpoint()). A staged checkpoint
+     * is then copied into the output directory in the background. The
+     * copy is again written into ".new" files first (with the metadata
+     * file last) and then rotated into place.
+     */
+
+    if (mpi_ensemble_.ensemble_rank() == 0) {
+      rotate_checkpoint(name);
+
+      if (!staging_name.empty()) {
+        checkpoint_drain_ = std::async(
+            std::launch::async,
+            [from = name, to = base_name + "-checkpoint"]() {
+              namespace fs = std::filesystem;
+              const auto options = fs::copy_options::overwrite_existing;
+
+              fs::remove(to + ".new.metadata");
+              for (const std::string suffix :
+                   {".mesh", ".mesh_fixed.data", ".mesh.info", ".state"})
+                if (fs::exists(from + suffix))
+                  fs::copy_file(from + suffix, to + ".new" + suffix, options);
+              fs::copy_file(from + ".metadata", to + ".new.metadata", options);
+
+              rotate_checkpoint(to);
+            });
+      }
+    }
+
+    ierr = MPI_Barrier(mpi_ensemble_.ensemble_communicator());
     AssertThrowMPI(ierr);
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::recover_buddy_checkpoint(
+      StateVector &state_vector,
+      Number &t,
+      unsigned int &output_cycle,
+      const bool lost /*= false*/)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::recover_buddy_checkpoint()"
+              << std::endl;
+#endif
+
+    Scope scope(computing_timer_, "time step [X]   - recover buddy checkpoint");
+
+    /*
+     * The buddy checkpoint stores the locally owned part of the
+     * hyperbolic state in the current partition. We thus only have to
+     * restore the ghost range afterwards:
+     */
+
+    auto &U = std::get<0>(state_vector);
+    buddy_checkpoint_.recover(U, t, output_cycle, lost);
+    U.update_ghost_values();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  std::string TimeLoop<Description, dim, Number>::checkpoint_staging_name(
+      const std::string &base_name) const
+  {
+    if (checkpoint_staging_directory_.empty())
+      return "";
+
+    std::string directory = checkpoint_staging_directory_;
+    if (directory.front() == '$') {
+      const char *value = std::getenv(directory.c_str() + 1);
+      AssertThrow(value != nullptr,
+                  dealii::ExcMessage("The environment variable »" +
+                                     directory.substr(1) +
+                                     "« used for the checkpoint staging "
+                                     "directory is not set"));
+      directory = value;
+    }
+
+    const auto file_name = std::filesystem::path(base_name).filename();
+    return (std::filesystem::path(directory) / file_name).string() +
+           "-checkpoint";
+  }
+
+
   template <typename Description, int dim, typename Number>
   template <typename Callable>
   void TimeLoop<Description, dim, Number>::adapt_mesh_and_transfer_state_vector(
-      StateVector &state_vector, const Callable &prepare_compute_kernels)
+      StateVector &state_vector,
+      const Number t,
+      const Callable &prepare_compute_kernels)
   {
 #ifdef DEBUG_OUTPUT
     std::cout << "TimeLoop<dim, Number>::adapt_mesh_and_transfer_state_vector()"
@@ -652,11 +1687,45 @@ namespace ryujin
      * Mark cells for coarsening and refinement and set up triangulation:
      */
 
+    dealii::Timer timer;
+
     auto &triangulation = discretization_.triangulation();
-    mesh_adaptor_.mark_cells_for_coarsening_and_refinement(triangulation);
+    mesh_adaptor_.mark_cells_for_coarsening_and_refinement(
+        triangulation, hyperbolic_module_.cfl());
 
     triangulation.prepare_coarsening_and_refinement();
 
+    /*
+     * If no cell is flagged for refinement or coarsening (after the
+     * triangulation enforced its smoothness and 2:1 level constraints) the
+     * discretization stays the same and we can skip tearing down and
+     * rebuilding all offline data and the projection of the state vector.
+     */
+
+    bool mesh_changed = false;
+    for (const auto &cell : triangulation.active_cell_iterators()) {
+      if (cell->is_locally_owned() &&
+          (cell->refine_flag_set() || cell->coarsen_flag_set())) {
+        mesh_changed = true;
+        break;
+      }
+    }
+
+    mesh_changed = Utilities::MPI::logical_or(
+        mesh_changed, mpi_ensemble_.ensemble_communicator());
+
+    if (!mesh_changed) {
+      print_info("mesh adaptation: no cells flagged, keeping current mesh");
+      /*
+       * prepare_compute_kernels() is not called, so we have to reset the
+       * mesh adaptor manually:
+       */
+      mesh_adaptor_.prepare(t);
+      return;
+    }
+
+    mesh_changed_since_checkpoint_ = true;
+
     /*
      * Set up SolutionTransfer:
      */
@@ -675,11 +1744,30 @@ namespace ryujin
      * Execute mesh adaptation and project old state to new state vector:
      */
 
+    /* Prefer the deterministic work counters over measured wall times: */
+    if constexpr (RowWorkCounters::enabled())
+      mesh_adaptor_.attach_cell_weights(
+          triangulation, hyperbolic_module_.row_work_counters().work());
+    else
+      mesh_adaptor_.attach_cell_weights(
+          triangulation, hyperbolic_module_.row_work_statistics().work());
     triangulation.execute_coarsening_and_refinement();
+    mesh_adaptor_.detach_cell_weights();
     prepare_compute_kernels();
 
     Vectors::reinit_state_vector<Description>(state_vector, offline_data_);
     solution_transfer.project(state_vector);
+
+    /* Report the cost of rebuilding all data structures: */
+    timer.stop();
+    const auto wall_time = Utilities::MPI::max(
+        timer.wall_time(), mpi_ensemble_.ensemble_communicator());
+
+    std::ostringstream output;
+    output << "mesh adaptation: " << triangulation.n_global_active_cells()
+           << " active cells, rebuild took " << std::setprecision(2)
+           << std::scientific << wall_time << " s";
+    print_info(output.str());
   }
 
 
@@ -694,113 +1782,124 @@ namespace ryujin
 
     hyperbolic_module_.prepare_state_vector(state_vector, t);
 
-    Vector<Number> difference_per_cell(
-        discretization_.triangulation().n_active_cells());
-
     Number linf_norm = 0.;
     Number l1_norm = 0;
     Number l2_norm = 0;
 
-    const auto analytic_U =
-        initial_values_.get().interpolate_hyperbolic_vector(t);
-    const auto &U = std::get<0>(state_vector);
+    if (fused_error_norms_) {
+      const auto norms = compute_fused_error_norms(state_vector, t);
+      linf_norm = norms[0];
+      l1_norm = norms[1];
+      l2_norm = norms[2];
+    } else {
+      Vector<Number> difference_per_cell(
+          discretization_.triangulation().n_active_cells());
+
+      const auto analytic_U =
+          initial_values_.get().interpolate_hyperbolic_vector(t);
+      const auto &U = std::get<0>(state_vector);
+
+      ScalarVector analytic_component;
+      ScalarVector error_component;
+      analytic_component.reinit(offline_data_.scalar_partitioner());
+      error_component.reinit(offline_data_.scalar_partitioner());
+
+      /* Loop over all selected components: */
+      for (const auto &entry : error_quantities_) {
+        const auto &names = View::component_names;
+        const auto pos = std::find(std::begin(names), std::end(names), entry);
+        if (pos == std::end(names)) {
+          AssertThrow(
+              false,
+              dealii::ExcMessage("Unknown component name »" + entry + "«"));
+          __builtin_trap();
+        }
 
-    ScalarVector analytic_component;
-    ScalarVector error_component;
-    analytic_component.reinit(offline_data_.scalar_partitioner());
-    error_component.reinit(offline_data_.scalar_partitioner());
+        const auto index = std::distance(std::begin(names), pos);
 
-    /* Loop over all selected components: */
-    for (const auto &entry : error_quantities_) {
-      const auto &names = View::component_names;
-      const auto pos = std::find(std::begin(names), std::end(names), entry);
-      if (pos == std::end(names)) {
-        AssertThrow(
-            false,
-            dealii::ExcMessage("Unknown component name »" + entry + "«"));
-        __builtin_trap();
-      }
+        analytic_U.extract_component(analytic_component, index);
 
-      const auto index = std::distance(std::begin(names), pos);
+        /* Compute norms of analytic solution: */
 
-      analytic_U.extract_component(analytic_component, index);
+        Number linf_norm_analytic = 0.;
+        Number l1_norm_analytic = 0.;
+        Number l2_norm_analytic = 0.;
 
-      /* Compute norms of analytic solution: */
+        if (error_normalize_) {
+          linf_norm_analytic =
+              Utilities::MPI::max(analytic_component.linfty_norm(),
+                                  mpi_ensemble_.ensemble_communicator());
 
-      Number linf_norm_analytic = 0.;
-      Number l1_norm_analytic = 0.;
-      Number l2_norm_analytic = 0.;
+          VectorTools::integrate_difference(
+              offline_data_.dof_handler(),
+              analytic_component,
+              Functions::ZeroFunction<dim, Number>(),
+              difference_per_cell,
+              QGauss<dim>(3),
+              VectorTools::L1_norm);
 
-      if (error_normalize_) {
-        linf_norm_analytic =
-            Utilities::MPI::max(analytic_component.linfty_norm(),
+          l1_norm_analytic =
+              Utilities::MPI::sum(difference_per_cell.l1_norm(),
+                                  mpi_ensemble_.ensemble_communicator());
+
+          VectorTools::integrate_difference(
+              offline_data_.dof_handler(),
+              analytic_component,
+              Functions::ZeroFunction<dim, Number>(),
+              difference_per_cell,
+              QGauss<dim>(3),
+              VectorTools::L2_norm);
+
+          l2_norm_analytic = Number(std::sqrt(
+              Utilities::MPI::sum(std::pow(difference_per_cell.l2_norm(), 2),
+                                  mpi_ensemble_.ensemble_communicator())));
+        }
+
+        /* Compute norms of error: */
+
+        U.extract_component(error_component, index);
+        /* Populate constrained dofs due to periodicity: */
+        offline_data_.affine_constraints().distribute(error_component);
+        error_component.update_ghost_values();
+        error_component -= analytic_component;
+
+        const Number linf_norm_error =
+            Utilities::MPI::max(error_component.linfty_norm(),
                                 mpi_ensemble_.ensemble_communicator());
 
         VectorTools::integrate_difference(
             offline_data_.dof_handler(),
-            analytic_component,
+            error_component,
             Functions::ZeroFunction<dim, Number>(),
             difference_per_cell,
             QGauss<dim>(3),
             VectorTools::L1_norm);
 
-        l1_norm_analytic =
+        const Number l1_norm_error =
             Utilities::MPI::sum(difference_per_cell.l1_norm(),
                                 mpi_ensemble_.ensemble_communicator());
 
         VectorTools::integrate_difference(
             offline_data_.dof_handler(),
-            analytic_component,
+            error_component,
             Functions::ZeroFunction<dim, Number>(),
             difference_per_cell,
             QGauss<dim>(3),
             VectorTools::L2_norm);
 
-        l2_norm_analytic = Number(std::sqrt(
+        const Number l2_norm_error = Number(std::sqrt(
             Utilities::MPI::sum(std::pow(difference_per_cell.l2_norm(), 2),
                                 mpi_ensemble_.ensemble_communicator())));
-      }
 
-      /* Compute norms of error: */
-
-      U.extract_component(error_component, index);
-      /* Populate constrained dofs due to periodicity: */
-      offline_data_.affine_constraints().distribute(error_component);
-      error_component.update_ghost_values();
-      error_component -= analytic_component;
-
-      const Number linf_norm_error = Utilities::MPI::max(
-          error_component.linfty_norm(), mpi_ensemble_.ensemble_communicator());
-
-      VectorTools::integrate_difference(offline_data_.dof_handler(),
-                                        error_component,
-                                        Functions::ZeroFunction<dim, Number>(),
-                                        difference_per_cell,
-                                        QGauss<dim>(3),
-                                        VectorTools::L1_norm);
-
-      const Number l1_norm_error = Utilities::MPI::sum(
-          difference_per_cell.l1_norm(), mpi_ensemble_.ensemble_communicator());
-
-      VectorTools::integrate_difference(offline_data_.dof_handler(),
-                                        error_component,
-                                        Functions::ZeroFunction<dim, Number>(),
-                                        difference_per_cell,
-                                        QGauss<dim>(3),
-                                        VectorTools::L2_norm);
-
-      const Number l2_norm_error = Number(std::sqrt(
-          Utilities::MPI::sum(std::pow(difference_per_cell.l2_norm(), 2),
-                              mpi_ensemble_.ensemble_communicator())));
-
-      if (error_normalize_) {
-        linf_norm += linf_norm_error / linf_norm_analytic;
-        l1_norm += l1_norm_error / l1_norm_analytic;
-        l2_norm += l2_norm_error / l2_norm_analytic;
-      } else {
-        linf_norm += linf_norm_error;
-        l1_norm += l1_norm_error;
-        l2_norm += l2_norm_error;
+        if (error_normalize_) {
+          linf_norm += linf_norm_error / linf_norm_analytic;
+          l1_norm += l1_norm_error / l1_norm_analytic;
+          l2_norm += l2_norm_error / l2_norm_analytic;
+        } else {
+          linf_norm += linf_norm_error;
+          l1_norm += l1_norm_error;
+          l2_norm += l2_norm_error;
+        }
       }
     }
 
@@ -812,7 +1911,8 @@ namespace ryujin
      * operation on "peer" ranks zero:
      */
 
-    if (mpi_ensemble_.n_ensembles() > 1) {
+    if (mpi_ensemble_.n_ensembles() > 1 &&
+        mpi_ensemble_.global_synchronization()) {
       linf_norm = Utilities::MPI::sum(
           linf_norm, mpi_ensemble_.ensemble_leader_communicator());
       l1_norm = Utilities::MPI::sum(
@@ -821,7 +1921,7 @@ namespace ryujin
           l2_norm, mpi_ensemble_.ensemble_leader_communicator());
     }
 
-    if (mpi_ensemble_.world_rank() != 0)
+    if (!statistics_rank())
       return;
 
     logfile_ << std::endl << "Computed errors:" << std::endl << std::endl;
@@ -848,6 +1948,191 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  std::array<Number, 3>
+  TimeLoop<Description, dim, Number>::compute_fused_error_norms(
+      const StateVector &state_vector, const Number t) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::compute_fused_error_norms()"
+              << std::endl;
+#endif
+
+    std::vector<unsigned int> indices;
+    for (const auto &entry : error_quantities_) {
+      const auto &names = View::component_names;
+      const auto pos = std::find(std::begin(names), std::end(names), entry);
+      if (pos == std::end(names)) {
+        AssertThrow(
+            false,
+            dealii::ExcMessage("Unknown component name »" + entry + "«"));
+        __builtin_trap();
+      }
+      indices.push_back(std::distance(std::begin(names), pos));
+    }
+    const unsigned int n_indices = indices.size();
+
+    const auto &initial_values = initial_values_.get();
+    const auto points = initial_values.locally_owned_support_points();
+    const unsigned int n_owned = points.size();
+    constexpr auto batch_size =
+        InitialValues<Description, dim, Number>::batch_size;
+
+    const auto &U = std::get<0>(state_vector);
+    const auto &sparsity_simd = offline_data_.sparsity_pattern_simd();
+    const auto &lumped_mass_matrix = offline_data_.lumped_mass_matrix();
+
+    /*
+     * For every selected component we accumulate the maxima of the error
+     * and the analytic solution, as well as the (squared) lumped L1 and
+     * L2 norms of the error and the analytic solution:
+     */
+
+    std::vector<double> maxima(2 * n_indices, 0.);
+    std::vector<double> sums(4 * n_indices, 0.);
+
+    const auto accumulate = [&](const unsigned int i,
+                                std::vector<double> &local_maxima,
+                                std::vector<double> &local_sums) {
+      const unsigned int n = std::min(batch_size, n_owned - i);
+      std::array<typename View::state_type, batch_size> states;
+      initial_values.initial_states(
+          ArrayView<typename View::state_type>(states.data(), n),
+          ArrayView<const dealii::Point<dim>>(points.data() + i, n),
+          t);
+
+      for (unsigned int k = 0; k < n; ++k) {
+        /* Skip constrained degrees of freedom: */
+        if (sparsity_simd.row_length(i + k) == 1)
+          continue;
+
+        const double m_i = lumped_mass_matrix.local_element(i + k);
+        const auto U_i = U.get_tensor(i + k);
+
+        for (unsigned int c = 0; c < n_indices; ++c) {
+          const double analytic = states[k][indices[c]];
+          const double error = std::abs(U_i[indices[c]] - analytic);
+
+          auto &error_max = local_maxima[2 * c];
+          auto &analytic_max = local_maxima[2 * c + 1];
+          error_max = std::max(error_max, error);
+          analytic_max = std::max(analytic_max, std::abs(analytic));
+
+          local_sums[4 * c] += m_i * error;
+          local_sums[4 * c + 1] += m_i * error * error;
+          local_sums[4 * c + 2] += m_i * std::abs(analytic);
+          local_sums[4 * c + 3] += m_i * analytic * analytic;
+        }
+      }
+    };
+
+    if (initial_values.thread_safe()) {
+      RYUJIN_PARALLEL_REGION_BEGIN
+      std::vector<double> local_maxima(maxima.size(), 0.);
+      std::vector<double> local_sums(sums.size(), 0.);
+
+      RYUJIN_OMP_FOR_NOWAIT
+      for (unsigned int i = 0; i < n_owned; i += batch_size)
+        accumulate(i, local_maxima, local_sums);
+
+      RYUJIN_OMP_CRITICAL
+      {
+        for (std::size_t l = 0; l < maxima.size(); ++l)
+          maxima[l] = std::max(maxima[l], local_maxima[l]);
+        for (std::size_t l = 0; l < sums.size(); ++l)
+          sums[l] += local_sums[l];
+      }
+      RYUJIN_PARALLEL_REGION_END
+    } else {
+      for (unsigned int i = 0; i < n_owned; i += batch_size)
+        accumulate(i, maxima, sums);
+    }
+
+    maxima = Utilities::MPI::max(maxima, mpi_ensemble_.ensemble_communicator());
+    sums = Utilities::MPI::sum(sums, mpi_ensemble_.ensemble_communicator());
+
+    std::array<Number, 3> result{};
+    for (unsigned int c = 0; c < n_indices; ++c) {
+      double linf_norm_error = maxima[2 * c];
+      double l1_norm_error = sums[4 * c];
+      double l2_norm_error = std::sqrt(sums[4 * c + 1]);
+
+      if (error_normalize_) {
+        linf_norm_error /= maxima[2 * c + 1];
+        l1_norm_error /= sums[4 * c + 2];
+        l2_norm_error /= std::sqrt(sums[4 * c + 3]);
+      }
+
+      result[0] += Number(linf_norm_error);
+      result[1] += Number(l1_norm_error);
+      result[2] += Number(l2_norm_error);
+    }
+
+    return result;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  bool TimeLoop<Description, dim, Number>::check_convergence(
+      const StateVector &state_vector, const Number t)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::check_convergence()" << std::endl;
+#endif
+
+    const auto &U = std::get<0>(state_vector);
+
+    /*
+     * Start over if this is the first call, or if the mesh has been
+     * adapted since the last call:
+     */
+    if (convergence_state_.get_partitioner() != U.get_partitioner() ||
+        t <= convergence_time_) {
+      convergence_state_.reinit(U.get_partitioner());
+      convergence_state_.copy_locally_owned_data_from(U);
+      convergence_time_ = t;
+      return false;
+    }
+
+    const unsigned int n_owned = offline_data_.n_locally_owned();
+    const auto &sparsity_simd = offline_data_.sparsity_pattern_simd();
+    const auto &lumped_mass_matrix = offline_data_.lumped_mass_matrix();
+
+    double norm = 0.;
+    double difference = 0.;
+
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      /* Skip constrained degrees of freedom: */
+      if (sparsity_simd.row_length(i) == 1)
+        continue;
+
+      const auto m_i = lumped_mass_matrix.local_element(i);
+      const auto U_i = U.get_tensor(i);
+      const auto U_old_i = convergence_state_.get_tensor(i);
+      for (unsigned int k = 0; k < problem_dimension; ++k) {
+        norm += m_i * std::abs(U_i[k]);
+        difference += m_i * std::abs(U_i[k] - U_old_i[k]);
+      }
+    }
+
+    const auto &ensemble_communicator = mpi_ensemble_.ensemble_communicator();
+    norm = Utilities::MPI::sum(norm, ensemble_communicator);
+    difference = Utilities::MPI::sum(difference, ensemble_communicator);
+
+    const double rate = difference /
+                        std::max(norm, std::numeric_limits<double>::min()) /
+                        double(t - convergence_time_);
+
+    convergence_rate_ = Number(Utilities::MPI::max(
+        rate, mpi_ensemble_.synchronization_communicator()));
+
+    convergence_state_.copy_locally_owned_data_from(U);
+    convergence_time_ = t;
+
+    return convergence_rate_ < convergence_tolerance_;
+  }
+
+
   template <typename Description, int dim, typename Number>
   void TimeLoop<Description, dim, Number>::output(StateVector &state_vector,
                                                   const std::string &name,
@@ -908,7 +2193,7 @@ namespace ryujin
   void
   TimeLoop<Description, dim, Number>::print_parameters(std::ostream &stream)
   {
-    if (mpi_ensemble_.world_rank() != 0)
+    if (!statistics_rank())
       return;
 
     /* Output commit and library information: */
@@ -929,6 +2214,42 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  std::string TimeLoop<Description, dim, Number>::mesh_parameters() const
+  {
+    std::ostringstream output;
+    ParameterAcceptor::prm.print_parameters(output, ParameterHandler::ShortPRM);
+
+    /* Extract the two (top level) subsections from the output: */
+
+    std::istringstream input(output.str());
+    std::string result;
+    unsigned int depth = 0;
+    bool selected = false;
+
+    for (std::string line; std::getline(input, line);) {
+      const auto begin = line.find_first_not_of(' ');
+      if (begin == std::string::npos)
+        continue;
+      line.erase(0, begin);
+
+      if (line.rfind("subsection ", 0) == 0) {
+        if (depth == 0)
+          selected = (line == "subsection C - Discretization" ||
+                      line == "subsection D - OfflineData");
+        ++depth;
+      } else if (line == "end" && depth > 0) {
+        --depth;
+      }
+
+      if (selected)
+        result += line + "\n";
+    }
+
+    return result;
+  }
+
+
   template <typename Description, int dim, typename Number>
   void
   TimeLoop<Description, dim, Number>::print_mpi_partition(std::ostream &stream)
@@ -939,6 +2260,122 @@ namespace ryujin
      * handle different data types
      */
 
+    /*
+     * Estimate the cache efficiency of the vectorized stencil gathers:
+     * For every SIMD stride of the internal range we count the number of
+     * distinct columns and the number of distinct cache lines (of a
+     * scalar vector) these columns touch. The ratio of both numbers is
+     * the fraction of transferred data that is actually used.
+     */
+
+    double n_gathered_lines = 0.;
+    double gather_efficiency = 1.;
+    {
+      const auto &sparsity_simd = offline_data_.sparsity_pattern_simd();
+      constexpr auto simd_length = simd_width<Number>;
+      constexpr unsigned int entries_per_line = 64 / sizeof(Number);
+
+      double n_gathered_columns = 0.;
+      std::vector<unsigned int> columns;
+      for (unsigned int i = 0; i < offline_data_.n_locally_internal();
+           i += simd_length) {
+        const unsigned int *js = sparsity_simd.columns(i);
+        columns.assign(js, js + sparsity_simd.row_length(i) * simd_length);
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()),
+                      columns.end());
+        n_gathered_columns += columns.size();
+
+        unsigned int previous_line = numbers::invalid_unsigned_int;
+        for (const auto j : columns) {
+          if (j / entries_per_line != previous_line)
+            n_gathered_lines += 1.;
+          previous_line = j / entries_per_line;
+        }
+      }
+
+      if (n_gathered_lines > 0.)
+        gather_efficiency =
+            n_gathered_columns / (n_gathered_lines * entries_per_line);
+    }
+
+    /*
+     * DoFRenumbering::internal_range_export_indices_first() groups rows
+     * of identical row length into SIMD strides, so that no lane of the
+     * internal range carries any padding. The remaining overhead are all
+     * locally owned rows that could not be packed into a full stride and
+     * are thus processed without vectorization. We report their number and the
+     * share of stencil entries they carry:
+     */
+
+    double scalar_fraction = 0.;
+    {
+      const auto &sparsity_simd = offline_data_.sparsity_pattern_simd();
+
+      double n_entries = 0.;
+      double n_scalar_entries = 0.;
+      for (unsigned int i = 0; i < offline_data_.n_locally_owned(); ++i) {
+        const double row_length = sparsity_simd.row_length(i);
+        n_entries += row_length;
+        if (i >= offline_data_.n_locally_internal())
+          n_scalar_entries += row_length;
+      }
+
+      if (n_entries > 0.)
+        scalar_fraction = n_scalar_entries / n_entries;
+    }
+
+    /*
+     * Estimate the locality of the ghost exchange: We translate the
+     * ranks of the (ensemble) node communicator into ranks of the
+     * ensemble communicator and report the fraction of imported ghost
+     * entries that is owned by a rank on the same compute node. Node
+     * local traffic is handled by shared memory transfers of the MPI
+     * library, whereas all other ghost entries cross the interconnect.
+     */
+
+    double n_ghost_kib = 0.;
+    double on_node_fraction = 1.;
+    {
+      const auto &ensemble_communicator = mpi_ensemble_.ensemble_communicator();
+      const auto &node_communicator =
+          mpi_ensemble_.ensemble_node_communicator();
+
+      MPI_Group ensemble_group, node_group;
+      MPI_Comm_group(ensemble_communicator, &ensemble_group);
+      MPI_Comm_group(node_communicator, &node_group);
+
+      const int n_node_ranks =
+          Utilities::MPI::n_mpi_processes(node_communicator);
+      std::vector<int> node_ranks(n_node_ranks);
+      std::vector<int> ensemble_ranks(n_node_ranks);
+      for (int k = 0; k < n_node_ranks; ++k)
+        node_ranks[k] = k;
+
+      MPI_Group_translate_ranks(node_group,
+                                n_node_ranks,
+                                node_ranks.data(),
+                                ensemble_group,
+                                ensemble_ranks.data());
+      MPI_Group_free(&node_group);
+      MPI_Group_free(&ensemble_group);
+      std::sort(ensemble_ranks.begin(), ensemble_ranks.end());
+
+      double n_ghosts = 0.;
+      double n_on_node_ghosts = 0.;
+      const auto &partitioner = offline_data_.scalar_partitioner();
+      for (const auto &[rank, count] : partitioner->ghost_targets()) {
+        n_ghosts += count;
+        if (std::binary_search(
+                ensemble_ranks.begin(), ensemble_ranks.end(), int(rank)))
+          n_on_node_ghosts += count;
+      }
+
+      n_ghost_kib = n_ghosts * problem_dimension * sizeof(Number) / 1024.;
+      if (n_ghosts > 0.)
+        on_node_fraction = n_on_node_ghosts / n_ghosts;
+    }
+
     // NOLINTBEGIN
     std::vector<double> values = {
         (double)offline_data_.n_export_indices(),
@@ -950,13 +2387,27 @@ namespace ryujin
         (double)offline_data_.n_locally_internal() /
             (double)offline_data_.n_locally_relevant(),
         (double)offline_data_.n_locally_owned() /
-            (double)offline_data_.n_locally_relevant()};
+            (double)offline_data_.n_locally_relevant(),
+        n_gathered_lines,
+        gather_efficiency,
+        (double)(offline_data_.n_locally_owned() -
+                 offline_data_.n_locally_internal()),
+        scalar_fraction,
+        n_ghost_kib,
+        on_node_fraction};
     // NOLINTEND
 
     const auto data =
-        Utilities::MPI::min_max_avg(values, mpi_ensemble_.world_communicator());
+        Utilities::MPI::min_max_avg(values, statistics_communicator());
 
-    if (mpi_ensemble_.world_rank() != 0)
+    /* Gather the size of the blocks cached by the memory pool: */
+    Utilities::MPI::MinMaxAvg memory_pool_data;
+    if (memory_pool_cache_size_ != 0)
+      memory_pool_data = Utilities::MPI::min_max_avg(
+          MemoryPool::instance().n_cached_bytes() / 1024. / 1024.,
+          statistics_communicator());
+
+    if (!statistics_rank())
       return;
 
     std::ostringstream output;
@@ -1004,6 +2455,18 @@ namespace ryujin
     output << std::endl << "             ";
     print_snippet("rel", data[3]);
 
+    output << std::endl << "             ";
+    print_snippet("gth", data[7]);
+    print_percentages(data[8]);
+
+    output << std::endl << "             ";
+    print_snippet("scl", data[9]);
+    print_percentages(data[10]);
+
+    output << std::endl << "             ";
+    print_snippet("gkb", data[11]);
+    print_percentages(data[12]);
+
     stream << output.str() << std::endl;
   }
 
@@ -1016,9 +2479,52 @@ namespace ryujin
     Utilities::System::get_memory_stats(stats);
 
     Utilities::MPI::MinMaxAvg data = Utilities::MPI::min_max_avg(
-        stats.VmRSS / 1024., mpi_ensemble_.world_communicator());
+        stats.VmRSS / 1024., statistics_communicator());
 
-    if (mpi_ensemble_.world_rank() != 0)
+    /*
+     * Gather the per NUMA domain page placement of all ranks. We only
+     * report it if at least one rank sees more than one NUMA domain.
+     */
+    auto domain_memory = NUMA::memory_per_domain();
+    const auto n_domains = Utilities::MPI::max(
+        static_cast<unsigned int>(domain_memory.size()),
+        statistics_communicator());
+    domain_memory.resize(n_domains, 0.);
+
+    std::vector<Utilities::MPI::MinMaxAvg> domain_data;
+    if (n_domains > 1)
+      domain_data = Utilities::MPI::min_max_avg(
+          domain_memory, statistics_communicator());
+
+    /*
+     * Gather the memory high-water marks of the individual phases of
+     * OfflineData::prepare():
+     */
+    const auto &high_water_marks = offline_data_.memory_high_water_marks();
+    std::vector<double> phase_memory;
+    for (const auto &it : high_water_marks)
+      phase_memory.push_back(it.second);
+
+    std::vector<Utilities::MPI::MinMaxAvg> phase_data;
+    if (!phase_memory.empty())
+      phase_data = Utilities::MPI::min_max_avg(
+          phase_memory, statistics_communicator());
+
+    /* Gather the fraction of memory backed by transparent huge pages: */
+    Utilities::MPI::MinMaxAvg huge_page_data;
+    if (use_huge_pages_)
+      huge_page_data =
+          Utilities::MPI::min_max_avg(100. * NUMA::huge_page_coverage(),
+                                      statistics_communicator());
+
+    /* Gather the size of the blocks cached by the memory pool: */
+    Utilities::MPI::MinMaxAvg memory_pool_data;
+    if (memory_pool_cache_size_ != 0)
+      memory_pool_data = Utilities::MPI::min_max_avg(
+          MemoryPool::instance().n_cached_bytes() / 1024. / 1024.,
+          statistics_communicator());
+
+    if (!statistics_rank())
       return;
 
     std::ostringstream output;
@@ -1033,6 +2539,249 @@ namespace ryujin
            << std::setw(8) << data.max                        //
            << " [p" << std::setw(n) << data.max_index << "]"; //
 
+    for (unsigned int k = 0; k < domain_data.size(); ++k) {
+      const auto &it = domain_data[k];
+      output << "\n  node " << std::setw(3) << k << "   [MiB]" //
+             << std::setw(8) << it.min                        //
+             << " [p" << std::setw(n) << it.min_index << "] " //
+             << std::setw(8) << it.avg << " "                 //
+             << std::setw(8) << it.max                        //
+             << " [p" << std::setw(n) << it.max_index << "]"; //
+    }
+
+    for (unsigned int k = 0; k < phase_data.size(); ++k) {
+      const auto &it = phase_data[k];
+      output << "\n  " << std::left << std::setw(11)          //
+             << high_water_marks[k].first << std::right       //
+             << "[MiB]"                                       //
+             << std::setw(8) << it.min                        //
+             << " [p" << std::setw(n) << it.min_index << "] " //
+             << std::setw(8) << it.avg << " "                 //
+             << std::setw(8) << it.max                        //
+             << " [p" << std::setw(n) << it.max_index << "]"; //
+    }
+
+    if (use_huge_pages_) {
+      const auto &it = huge_page_data;
+      output << "\n  huge pages   [%]"                         //
+             << std::setw(8) << it.min                        //
+             << " [p" << std::setw(n) << it.min_index << "] " //
+             << std::setw(8) << it.avg << " "                 //
+             << std::setw(8) << it.max                        //
+             << " [p" << std::setw(n) << it.max_index << "]"; //
+    }
+
+    if (memory_pool_cache_size_ != 0) {
+      const auto &it = memory_pool_data;
+      output << "\n  memory pool[MiB]"                          //
+             << std::setw(8) << it.min                        //
+             << " [p" << std::setw(n) << it.min_index << "] " //
+             << std::setw(8) << it.avg << " "                 //
+             << std::setw(8) << it.max                        //
+             << " [p" << std::setw(n) << it.max_index << "]"; //
+    }
+
+    stream << output.str() << std::endl;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::print_dry_run_estimate(
+      std::ostream &stream, const unsigned int n_parabolic_state_vectors)
+  {
+    /*
+     * Estimate the memory footprint of every rank from the row lengths of
+     * the SIMD sparsity pattern and the number of components of all
+     * matrices and vectors:
+     */
+
+    using StorageNumber = storage_number_type<Number>;
+
+    const double n_owned = offline_data_.n_locally_owned();
+    const double n_relevant = offline_data_.n_locally_relevant();
+    const double n_entries =
+        offline_data_.sparsity_pattern_simd().n_nonzero_elements();
+
+    /* Column indices and transposed indices of the sparsity pattern: */
+    const double sparsity = 2. * n_entries * sizeof(unsigned int);
+
+    /* m_ij, c_ij, the lumped mass matrix and its inverse: */
+    unsigned int n_offline_components = 1 + dim;
+    if (discretization_.have_discontinuous_ansatz())
+      n_offline_components += 2;
+    if (offline_data_.precompute_normalized_cij())
+      n_offline_components += 1 + dim;
+    const double offline_data =
+        n_entries * n_offline_components * sizeof(StorageNumber) +
+        2. * n_relevant * sizeof(Number);
+
+    const double hyperbolic_module = hyperbolic_module_.memory_estimate();
+
+    /* The state vector and all temporaries of the time integrator: */
+    const double state_vector =
+        n_relevant *
+        (problem_dimension + n_precomputed_values + n_parabolic_state_vectors) *
+        sizeof(Number);
+    const double time_integrator =
+        time_integrator_.n_temporaries() * state_vector;
+
+    /*
+     * Every coarser multigrid level holds about 2^-dim of the degrees of
+     * freedom of the next finer level. We estimate four level vectors
+     * (solution, right hand side, residual and smoother diagonal) for
+     * every parabolic state vector:
+     */
+    double multigrid = 0.;
+    if (n_parabolic_state_vectors > 0) {
+      const auto n_levels = discretization_.triangulation().n_global_levels();
+      double fraction = 0.;
+      for (unsigned int level = 1; level < n_levels; ++level)
+        fraction += std::pow(0.5, dim * level);
+      multigrid = 4. * fraction * n_relevant * n_parabolic_state_vectors *
+                  sizeof(Number);
+    }
+
+    const double total = sparsity + offline_data + hyperbolic_module +
+                         state_vector + time_integrator + multigrid;
+
+    /*
+     * The per rank throughput reported by print_throughput() is the
+     * number of degrees of freedom times the efficiency of the time
+     * stepping scheme divided by the wall time per cycle:
+     */
+    const double time_per_cycle =
+        dry_run_throughput_ > 0.
+            ? n_owned * time_integrator_.efficiency() /
+                  (dry_run_throughput_ * 1.e6)
+            : 0.;
+
+    std::vector<double> values = {n_owned,
+                                  n_entries,
+                                  sparsity / 1024. / 1024.,
+                                  offline_data / 1024. / 1024.,
+                                  hyperbolic_module / 1024. / 1024.,
+                                  state_vector / 1024. / 1024.,
+                                  time_integrator / 1024. / 1024.,
+                                  multigrid / 1024. / 1024.,
+                                  total / 1024. / 1024.,
+                                  time_per_cycle};
+
+    const auto data =
+        Utilities::MPI::min_max_avg(values, statistics_communicator());
+
+    const auto n_global_dofs = Utilities::MPI::sum(
+        offline_data_.dof_handler().n_dofs(), statistics_communicator());
+
+    if (!statistics_rank())
+      return;
+
+    std::ostringstream output;
+
+    unsigned int n =
+        dealii::Utilities::needed_digits(mpi_ensemble_.n_world_ranks());
+
+    output << "\nDry run estimate (" << n_global_dofs << " Qdofs on "
+           << Utilities::MPI::n_mpi_processes(statistics_communicator())
+           << " ranks, " << time_integrator_.n_temporaries()
+           << " temporaries):";
+
+    const std::vector<std::string> names = {"owned dofs",
+                                            "stencil entries",
+                                            "sparsity [MiB]",
+                                            "offline data [MiB]",
+                                            "hyperbolic [MiB]",
+                                            "state vector [MiB]",
+                                            "temporaries [MiB]",
+                                            "multigrid [MiB]",
+                                            "total [MiB]",
+                                            "time/cycle [s]"};
+
+    for (unsigned int k = 0; k < names.size(); ++k) {
+      if (k == names.size() - 1 && dry_run_throughput_ <= 0.)
+        break;
+
+      const auto &value = data[k];
+      output << "\n  " << std::left << std::setw(20) << names[k] << std::right
+             << std::setprecision(k < 2 ? 0 : 3) << std::fixed
+             << std::setw(14) << value.min << " [p" << std::setw(n)
+             << value.min_index << "] " << std::setw(14) << value.avg << " "
+             << std::setw(14) << value.max << " [p" << std::setw(n)
+             << value.max_index << "]";
+    }
+
+    if (dry_run_throughput_ <= 0.)
+      output << "\n  (set \"dry run throughput\" to predict the time per "
+                "cycle)";
+
+    output << std::endl;
+
+    stream << output.str() << std::flush;
+    if (mpi_ensemble_.world_rank() == 0)
+      std::cout << output.str() << std::flush;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::print_startup_profile(
+      std::ostream &stream)
+  {
+    if (startup_profile_.empty())
+      return;
+
+    std::vector<double> wall_time;
+    std::vector<double> memory;
+    for (const auto &[name, time, delta] : startup_profile_) {
+      wall_time.push_back(time);
+      memory.push_back(delta);
+    }
+
+    const auto wall_time_data = Utilities::MPI::min_max_avg(
+        wall_time, statistics_communicator());
+    const auto memory_data =
+        Utilities::MPI::min_max_avg(memory, statistics_communicator());
+
+    /* Gather the size of the blocks cached by the memory pool: */
+    Utilities::MPI::MinMaxAvg memory_pool_data;
+    if (memory_pool_cache_size_ != 0)
+      memory_pool_data = Utilities::MPI::min_max_avg(
+          MemoryPool::instance().n_cached_bytes() / 1024. / 1024.,
+          statistics_communicator());
+
+    if (!statistics_rank())
+      return;
+
+    std::ostringstream output;
+
+    unsigned int n =
+        dealii::Utilities::needed_digits(mpi_ensemble_.n_world_ranks());
+
+    output << "\nStartup:";
+
+    for (unsigned int k = 0; k < startup_profile_.size(); ++k) {
+      const auto &time = wall_time_data[k];
+      const auto &delta = memory_data[k];
+
+      /* Cut off at 99.9% as in print_timers(): */
+      constexpr auto eps = std::numeric_limits<double>::epsilon();
+      const auto avg = std::max(time.avg, eps);
+      const auto skew_negative =
+          std::max(100. * (time.min - avg) / avg - eps, -99.9);
+      const auto skew_positive =
+          std::min(100. * (time.max - avg) / avg + eps, 99.9);
+
+      output << "\n  " << std::left << std::setw(16)                  //
+             << std::get<0>(startup_profile_[k]) << std::right        //
+             << std::setprecision(2) << std::fixed                    //
+             << std::setw(8) << time.avg << "s [sk: "                 //
+             << std::setprecision(1) << std::setw(5) << skew_negative //
+             << "%/" << std::setw(4) << skew_positive << "%]"         //
+             << " [p" << std::setw(n) << time.min_index << "/"        //
+             << time.max_index << "]"                                 //
+             << std::setw(9) << delta.avg << " MiB (max "             //
+             << std::setw(8) << delta.max                             //
+             << " [p" << std::setw(n) << delta.max_index << "])";     //
+    }
+
     stream << output.str() << std::endl;
   }
 
@@ -1056,7 +2805,7 @@ namespace ryujin
 
     const auto print_wall_time = [&](auto &timer, auto &stream) {
       const auto wall_time = Utilities::MPI::min_max_avg(
-          timer.wall_time(), mpi_ensemble_.world_communicator());
+          timer.wall_time(), statistics_communicator());
 
       constexpr auto eps = std::numeric_limits<double>::epsilon();
       /*
@@ -1080,13 +2829,13 @@ namespace ryujin
 
     const auto cpu_time_statistics =
         Utilities::MPI::min_max_avg(computing_timer_["time loop"].cpu_time(),
-                                    mpi_ensemble_.world_communicator());
+                                    statistics_communicator());
     const double total_cpu_time = cpu_time_statistics.sum;
 
     const auto print_cpu_time =
         [&](auto &timer, auto &stream, bool percentage) {
           const auto cpu_time = Utilities::MPI::min_max_avg(
-              timer.cpu_time(), mpi_ensemble_.world_communicator());
+              timer.cpu_time(), statistics_communicator());
 
           stream << std::setprecision(2) << std::fixed << std::setw(9)
                  << cpu_time.sum << "s ";
@@ -1115,12 +2864,221 @@ namespace ryujin
     }
     equalize();
 
-    if (mpi_ensemble_.world_rank() != 0)
+    /*
+     * Report the fraction of the ghost exchange that was hidden behind
+     * computation accumulated over all phases of a time step (see
+     * SynchronizationDispatch):
+     */
+
+    std::ostringstream overlap;
+    double local_total = 0.;
+    double local_exposed = 0.;
+    bool have_ghost_exchange_timers = false;
+    for (auto &[name, timer] : computing_timer_) {
+      if (name.ends_with("ghost exchange, total")) {
+        local_total += timer.wall_time();
+        have_ghost_exchange_timers = true;
+      } else if (name.ends_with("ghost exchange, exposed")) {
+        local_exposed += timer.wall_time();
+      }
+    }
+    /* Ranks without ghost exchanges still take part in the reduction: */
+    if (Utilities::MPI::logical_or(have_ghost_exchange_timers,
+                                   statistics_communicator())) {
+      const auto total_time = Utilities::MPI::min_max_avg(
+          local_total, statistics_communicator());
+      const auto exposed_time = Utilities::MPI::min_max_avg(
+          local_exposed, statistics_communicator());
+      const double hidden =
+          total_time.avg > 0.
+              ? std::max(0., 1. - exposed_time.avg / total_time.avg)
+              : 0.;
+      overlap << "  ghost exchange overlap: " << std::setprecision(1)
+              << std::fixed << 100. * hidden << "% hidden";
+    }
+
+    /*
+     * Report hardware counters (summed over all threads and ranks) and
+     * the achieved memory bandwidth and roofline fraction, see
+     * HardwareCounters:
+     */
+
+    std::vector<std::ostringstream> counters;
+#ifdef WITH_PERF_EVENT
+    const auto &hardware_counters = HardwareCounters::instance();
+    if (Utilities::MPI::logical_or(hardware_counters.active(),
+                                   statistics_communicator())) {
+      constexpr auto n_events = HardwareCounters::n_events;
+
+      std::vector<double> values;
+      values.reserve(computing_timer_.size() * n_events);
+      for (auto &[name, timer] : computing_timer_)
+        for (const auto value : hardware_counters.values(name))
+          values.push_back(static_cast<double>(value));
+      Utilities::MPI::sum(values, statistics_communicator(), values);
+
+      std::size_t name_width = 0;
+      for (auto &it : computing_timer_)
+        name_width = std::max(name_width, it.first.length());
+
+      counters.resize(computing_timer_.size());
+      auto value = values.begin();
+      auto kt = counters.begin();
+      for (auto &[name, timer] : computing_timer_) {
+        const double n_cycles = value[HardwareCounters::cycles];
+        const double n_instructions = value[HardwareCounters::instructions];
+        const double bytes = HardwareCounters::cache_line_size *
+                             value[HardwareCounters::cache_misses];
+        const double n_flops = value[HardwareCounters::flops];
+        value += n_events;
+
+        const double wall_time = Utilities::MPI::max(
+            timer.wall_time(), statistics_communicator());
+        const double bandwidth = wall_time > 0. ? bytes / wall_time / 1.e9 : 0.;
+        const double flop_rate =
+            wall_time > 0. ? n_flops / wall_time / 1.e9 : 0.;
+
+        auto &line = *kt++;
+        line << "  " << std::left << std::setw(name_width) << name
+             << std::right << std::setprecision(2) << std::fixed
+             << std::setw(10) << n_cycles / 1.e9 << "G cyc "
+             << std::setw(5) << (n_cycles > 0. ? n_instructions / n_cycles : 0.)
+             << " IPC " << std::setw(9) << bandwidth << " GB/s";
+
+        if (n_flops > 0.)
+          line << std::setw(9) << flop_rate << " GFLOP/s";
+
+        if (peak_memory_bandwidth_ > 0. && peak_flop_rate_ > 0. &&
+            n_flops > 0. && bytes > 0.) {
+          const double bound = std::min(
+              peak_flop_rate_, n_flops / bytes * peak_memory_bandwidth_);
+          line << " (" << std::setprecision(1) << std::setw(5)
+               << 100. * flop_rate / bound << "% roofline)";
+        } else if (peak_memory_bandwidth_ > 0.) {
+          line << " (" << std::setprecision(1) << std::setw(5)
+               << 100. * bandwidth / peak_memory_bandwidth_ << "% peak bw)";
+        }
+      }
+    }
+#endif
+
+    /*
+     * Report the analytic memory traffic of the stages of
+     * HyperbolicModule::step() (summed over all ranks) in bytes per
+     * degree of freedom and invocation and the resulting effective
+     * bandwidth, see HyperbolicModule::stage_traffic():
+     */
+
+    std::vector<std::ostringstream> traffic;
+    {
+      const auto &stage_traffic = hyperbolic_module_.stage_traffic();
+
+      std::vector<double> bytes;
+      std::vector<double> invocations;
+      for (auto &[name, timer] : computing_timer_) {
+        const auto it = stage_traffic.find(name);
+        const bool found = it != stage_traffic.end();
+        bytes.push_back(found ? it->second.first : 0.);
+        invocations.push_back(found ? it->second.second : 0.);
+      }
+      Utilities::MPI::sum(bytes, statistics_communicator(), bytes);
+      Utilities::MPI::max(invocations, statistics_communicator(), invocations);
+
+      std::size_t name_width = 0;
+      for (auto &it : computing_timer_)
+        name_width = std::max(name_width, it.first.length());
+
+      unsigned int k = 0;
+      for (auto &[name, timer] : computing_timer_) {
+        const double n_bytes = bytes[k];
+        const double n_invocations = invocations[k++];
+
+        const double wall_time = Utilities::MPI::max(
+            timer.wall_time(), statistics_communicator());
+
+        if (n_bytes == 0. || n_invocations == 0.)
+          continue;
+
+        const double bandwidth =
+            wall_time > 0. ? n_bytes / wall_time / 1.e9 : 0.;
+        const double bytes_per_dof =
+            n_bytes / n_invocations / static_cast<double>(n_global_dofs_);
+
+        auto &line = traffic.emplace_back();
+        line << "  " << std::left << std::setw(name_width) << name
+             << std::right << std::setprecision(2) << std::fixed
+             << std::setw(10) << n_bytes / 1.e9 << " GB " << std::setw(8)
+             << bytes_per_dof << " B/DoF " << std::setw(9) << bandwidth
+             << " GB/s";
+
+        if (peak_memory_bandwidth_ > 0.)
+          line << " (" << std::setprecision(1) << std::setw(5)
+               << 100. * bandwidth / peak_memory_bandwidth_ << "% peak bw)";
+      }
+    }
+
+    if (!statistics_rank())
       return;
 
     stream << std::endl << "Timer statistics:\n";
     for (auto &it : output)
       stream << it.str() << std::endl;
+    if (!overlap.str().empty())
+      stream << overlap.str() << std::endl;
+
+    if (!counters.empty()) {
+      stream << std::endl << "Hardware counter statistics:\n";
+      for (auto &it : counters)
+        stream << it.str() << std::endl;
+    }
+
+    if (!traffic.empty()) {
+      stream << std::endl << "Analytic memory traffic:\n";
+      for (auto &it : traffic)
+        stream << it.str() << std::endl;
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::print_replay_summary(
+      unsigned int cycle, Number tau, std::ostream &stream)
+  {
+    /*
+     * Report the wall time per cycle of all time step sections. All
+     * sections are listed in the same (alphabetical) order and with a
+     * fixed format so that summaries of different builds and machines
+     * can be compared line by line:
+     */
+
+    std::ostringstream output;
+    output << std::endl << "Replay summary:\n";
+    output << "  " << cycle << " cycles with tau = " << std::scientific
+           << std::setprecision(6) << tau << " on "
+           << Utilities::MPI::n_mpi_processes(statistics_communicator())
+           << " ranks / " << MultithreadInfo::n_threads() << " threads\n";
+
+    std::size_t name_width = 0;
+    for (auto &it : computing_timer_)
+      name_width = std::max(name_width, it.first.length());
+
+    for (auto &[name, timer] : computing_timer_) {
+      if (!name.starts_with("time step") && name != "time loop")
+        continue;
+
+      const auto wall_time = Utilities::MPI::min_max_avg(
+          timer.wall_time(), statistics_communicator());
+      const double scale = cycle > 0 ? 1.e3 / cycle : 0.;
+
+      output << "  " << std::left << std::setw(name_width) << name
+             << std::right << std::fixed << std::setprecision(3)
+             << std::setw(11) << wall_time.avg * scale << " ms/cycle [min "
+             << std::setw(11) << wall_time.min * scale << ", max "
+             << std::setw(11) << wall_time.max * scale << "]\n";
+    }
+
+    if (statistics_rank())
+      stream << output.str() << std::flush;
   }
 
 
@@ -1154,12 +3112,12 @@ namespace ryujin
 
       const auto wall_time_statistics =
           Utilities::MPI::min_max_avg(computing_timer_["time loop"].wall_time(),
-                                      mpi_ensemble_.world_communicator());
+                                      statistics_communicator());
       current.wall_time = wall_time_statistics.max;
 
       const auto cpu_time_statistics =
           Utilities::MPI::min_max_avg(computing_timer_["time loop"].cpu_time(),
-                                      mpi_ensemble_.world_communicator());
+                                      statistics_communicator());
       current.cpu_time_sum = cpu_time_statistics.sum;
       current.cpu_time_avg = cpu_time_statistics.avg;
       current.cpu_time_min = cpu_time_statistics.min;
@@ -1205,6 +3163,13 @@ namespace ryujin
     const double time_per_second =
         (current.t - previous.t) / (current.wall_time - previous.wall_time);
 
+    throughput_statistics_ = {wall_m_dofs_per_sec,
+                              cpu_m_dofs_per_sec,
+                              cycles_per_second,
+                              cpu_time_skew,
+                              cpu_time_skew_percentage,
+                              delta_time};
+
     /* Print Jean-Luc and Martin metrics: */
 
     std::ostringstream output;
@@ -1252,6 +3217,18 @@ namespace ryujin
     if constexpr (!ParabolicSystem::is_identity)
       parabolic_module_.print_solver_statistics(output);
 
+    time_integrator_.print_multirate_statistics(output);
+    time_integrator_.print_cfl_statistics(output);
+    time_integrator_.print_steady_state_statistics(output);
+
+    if (convergence_tolerance_ > Number(0.))
+      output << "        [ rate of change: " << std::setprecision(2)
+             << std::scientific << convergence_rate_ << " (tolerance "
+             << convergence_tolerance_ << ") ]" << std::endl;
+    hyperbolic_module_.print_thread_load_statistics(output);
+    hyperbolic_module_.print_smooth_row_statistics(output);
+    hyperbolic_module_.kernel_variants().print(output);
+
     output << "        [ dt = "
            << std::scientific << std::setprecision(2) << delta_time
            << " ( "
@@ -1281,13 +3258,161 @@ namespace ryujin
     const unsigned int minutes = eta / 60;
     output << minutes << " min";
 
-    if (mpi_ensemble_.world_rank() != 0)
+    if (!statistics_rank())
       return;
 
     stream << output.str() << std::endl;
   }
 
 
+  template <typename Description, int dim, typename Number>
+  std::string TimeLoop<Description, dim, Number>::ensemble_filename(
+      const std::string &filename) const
+  {
+    if (mpi_ensemble_.global_synchronization())
+      return filename;
+
+    std::filesystem::path name(filename);
+    name.replace_filename(name.stem().string() +
+                          base_name_ensemble_.substr(base_name_.size()) +
+                          name.extension().string());
+    return name.string();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::write_rank_statistics(
+      unsigned int cycle, Number t)
+  {
+    if (rank_statistics_filename_ == "")
+      return;
+
+    /*
+     * Every rank contributes one row: the partition sizes followed by the
+     * wall times of all timer sections:
+     */
+
+    const auto &partitioner = *offline_data_.scalar_partitioner();
+
+    std::vector<double> row{double(offline_data_.n_locally_owned()),
+                            double(offline_data_.n_locally_internal()),
+                            double(partitioner.n_ghost_indices()),
+                            double(offline_data_.n_export_indices())};
+    for (auto &[name, timer] : computing_timer_)
+      row.push_back(timer.wall_time());
+
+    const auto rows = Utilities::MPI::gather(statistics_communicator(), row);
+
+    if (!statistics_rank())
+      return;
+
+    std::ofstream file(ensemble_filename(rank_statistics_filename_));
+    file << "# cycle = " << cycle << ", t = " << t << "\n";
+
+    file << "rank, n_owned, n_internal, n_ghost, n_export";
+    for (auto &[name, timer] : computing_timer_)
+      file << ", \"" << name << "\"";
+    file << "\n";
+
+    for (unsigned int rank = 0; rank < rows.size(); ++rank) {
+      file << rank;
+      for (const auto value : rows[rank])
+        file << ", " << value;
+      file << "\n";
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::write_statistics(unsigned int cycle,
+                                                            Number t,
+                                                            bool final_time)
+  {
+    if (statistics_filename_ == "")
+      return;
+
+    /* JSON has no representation for inf and nan: */
+    const auto number = [](const double value) {
+      std::ostringstream result;
+      result << std::setprecision(8) << std::scientific;
+      if (std::isfinite(value))
+        result << value;
+      else
+        result << "null";
+      return result.str();
+    };
+
+    std::ostringstream output;
+    output << std::setprecision(8) << std::scientific;
+
+    output << "{\"cycle\": " << cycle << ", \"t\": " << t
+           << ", \"final\": " << (final_time ? "true" : "false")
+           << ", \"n_dofs\": " << n_global_dofs_
+           << ", \"n_ranks\": "
+           << Utilities::MPI::n_mpi_processes(statistics_communicator());
+
+    /* Timer sections with statistics over all ranks: */
+
+    output << ", \"timers\": {";
+    bool first = true;
+    for (auto &[name, timer] : computing_timer_) {
+      const auto wall_time = Utilities::MPI::min_max_avg(
+          timer.wall_time(), statistics_communicator());
+      const auto cpu_time = Utilities::MPI::min_max_avg(
+          timer.cpu_time(), statistics_communicator());
+
+      std::string escaped;
+      for (const auto c : name) {
+        if (c == '"' || c == '\\')
+          escaped += '\\';
+        escaped += c;
+      }
+
+      output << (first ? "" : ", ") << "\"" << escaped << "\": {"
+             << "\"wall_min\": " << wall_time.min
+             << ", \"wall_avg\": " << wall_time.avg
+             << ", \"wall_max\": " << wall_time.max
+             << ", \"cpu_sum\": " << cpu_time.sum << "}";
+      first = false;
+    }
+    output << "}";
+
+    /* Throughput, restarts and warnings: */
+
+    const auto &[wall_m_dofs_per_sec,
+                 cpu_m_dofs_per_sec,
+                 cycles_per_second,
+                 cpu_time_skew,
+                 cpu_time_skew_percentage,
+                 delta_time] = throughput_statistics_;
+
+    const auto &scheme = time_integrator_.time_stepping_scheme();
+    output << ", \"throughput\": {"
+           << "\"wall_mdofs_per_s\": " << number(wall_m_dofs_per_sec)
+           << ", \"cpu_mdofs_per_s\": " << number(cpu_m_dofs_per_sec)
+           << ", \"cycles_per_s\": " << number(cycles_per_second)
+           << ", \"cpu_time_skew\": " << number(cpu_time_skew)
+           << ", \"cpu_time_skew_fraction\": "
+           << number(cpu_time_skew_percentage)
+           << ", \"dt\": " << number(delta_time) << "}"
+           << ", \"time_stepping_scheme\": \""
+           << Patterns::Tools::Convert<TimeSteppingScheme>::to_string(scheme)
+           << "\", \"cfl\": " << hyperbolic_module_.cfl()
+           << ", \"restarts\": {\"hyperbolic\": "
+           << hyperbolic_module_.n_restarts()
+           << ", \"parabolic\": " << parabolic_module_.n_restarts() << "}"
+           << ", \"warnings\": {\"hyperbolic\": "
+           << hyperbolic_module_.n_warnings()
+           << ", \"parabolic\": " << parabolic_module_.n_warnings() << "}"
+           << "}";
+
+    if (!statistics_rank())
+      return;
+
+    statistics_file_ << output.str() << std::endl;
+  }
+
+
   template <typename Description, int dim, typename Number>
   void TimeLoop<Description, dim, Number>::print_info(const std::string &header)
   {
@@ -1304,7 +3429,7 @@ namespace ryujin
                                                  const std::string &secondary,
                                                  std::ostream &stream)
   {
-    if (mpi_ensemble_.world_rank() != 0)
+    if (!statistics_rank())
       return;
 
     const int header_size = header.size();
@@ -1337,7 +3462,7 @@ namespace ryujin
       bool final_time)
   {
     static const std::string vectorization_name = [] {
-      constexpr auto width = VectorizedArray<Number>::size();
+      constexpr auto width = simd_width<Number>;
 
       std::string result;
       if (width == 1)
@@ -1373,13 +3498,17 @@ namespace ryujin
     if constexpr (!ParabolicSystem::is_identity) {
       output << "\n             (PAR) " << parabolic_system_.get().problem_name;
     }
-    output << "\n             [" << base_name_ << "] ";
+    output << "\n             ["
+           << (mpi_ensemble_.global_synchronization() ? base_name_
+                                                      : base_name_ensemble_)
+           << "] ";
     if (mpi_ensemble_.n_ensembles() > 1) {
       output << mpi_ensemble_.n_ensembles() << " ensembles ";
     }
     output << "with "                                      //
            << n_global_dofs_ << " Qdofs on "               //
-           << mpi_ensemble_.n_world_ranks() << " ranks / " //
+           << Utilities::MPI::n_mpi_processes(statistics_communicator())
+           << " ranks / " //
 #ifdef WITH_OPENMP
            << MultithreadInfo::n_threads() << " threads <" //
 #else
@@ -1393,18 +3522,44 @@ namespace ryujin
            << "s)\n";
 
     print_memory_statistics(output);
+    print_startup_profile(output);
     print_timers(output);
     print_throughput(cycle, t, output, final_time);
+    write_statistics(cycle, t, final_time);
+
+    if (write_to_logfile || final_time)
+      write_rank_statistics(cycle, t);
+
+    if (write_to_logfile && statistics_rank())
+      logfile_ << "\n" << output.str() << std::flush;
+
+    /*
+     * Post the progress of the ensemble and report the (last posted)
+     * progress of all decoupled ensembles on world rank 0:
+     */
+
+    ensemble_progress_.post(
+        {double(cycle), double(t), computing_timer_["time loop"].wall_time()});
 
     if (mpi_ensemble_.world_rank() == 0) {
+      const auto progress = ensemble_progress_.gather();
+      if (!progress.empty()) {
+        output << "\nEnsemble progress:\n";
+        for (unsigned int i = 0; i < progress.size(); ++i) {
+          const auto &[ensemble_cycle, ensemble_t, wall_time] = progress[i];
+          output << "  ensemble " << std::setw(4) << i << ": cycle "
+                 << std::setw(8) << (unsigned int)ensemble_cycle
+                 << "  t = " << std::setprecision(8) << std::fixed
+                 << ensemble_t << " (" << std::setprecision(1)
+                 << ensemble_t / t_final_ * 100 << "%)  wall time "
+                 << std::setprecision(1) << wall_time << "s\n";
+        }
+      }
+
 #ifndef DEBUG_OUTPUT
       std::cout << "\033[2J\033[H";
 #endif
       std::cout << output.str() << std::flush;
-
-      if (write_to_logfile) {
-        logfile_ << "\n" << output.str() << std::flush;
-      }
     }
   }
 
@@ -0,0 +1,238 @@
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Copyright (C) 2024 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A minimal timeline tracer. The class is a process-wide singleton that
+   * is initialized once in main() and that records the begin and end
+   * timestamps of all timer sections managed by a Scope object, of all
+   * busy phases of OpenMP threads recorded by ThreadLoadStatistics, and
+   * of all MPI exchanges and synchronization waits dispatched by
+   * SynchronizationDispatch if ryujin is configured with
+   * TIMELINE_TRACING. Without this option all functions are no-ops.
+   *
+   * Every thread records into its own, preallocated ring buffer. The
+   * capacity (in events per thread) defaults to 65536 and can be set
+   * with the environment variable RYUJIN_TRACE_CAPACITY. If a buffer
+   * overflows the oldest events are overwritten. The recorded timelines
+   * are written out per MPI rank in the Chrome trace event format that
+   * can be viewed in chrome://tracing or ui.perfetto.dev.
+   *
+   * @ingroup Miscellaneous
+   */
+  class TimelineTracer
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * A recorded event. The name is truncated to fit into a fixed size
+     * character array so that recording an event never allocates.
+     */
+    struct Event {
+      std::array<char, 48> name;
+      std::int64_t begin;
+      std::int64_t end;
+    };
+
+    /**
+     * Return a reference to the singleton.
+     */
+    static TimelineTracer &instance()
+    {
+      static TimelineTracer timeline_tracer;
+      return timeline_tracer;
+    }
+
+    /**
+     * Allocate a ring buffer for every thread of the OpenMP thread pool
+     * and a few additional buffers for communication threads. Has to be
+     * called after the thread pool has been set up.
+     */
+    void initialize()
+    {
+#ifdef TIMELINE_TRACING
+      std::size_t capacity = 65536;
+      if (const char *value = std::getenv("RYUJIN_TRACE_CAPACITY"))
+        capacity = std::max<std::size_t>(1, std::strtoull(value, nullptr, 0));
+
+      unsigned int n_threads = 1;
+#ifdef WITH_OPENMP
+      n_threads = omp_get_max_threads();
+#endif
+      buffers_.assign(n_threads + n_additional_buffers, Buffer());
+      for (auto &buffer : buffers_)
+        buffer.events.resize(capacity);
+
+      epoch_ = clock::now();
+      active_ = true;
+#endif
+    }
+
+    /**
+     * Return true if the tracer has been initialized.
+     */
+    bool active() const
+    {
+      return active_;
+    }
+
+    /**
+     * Return the current timestamp.
+     */
+    clock::time_point now() const
+    {
+#ifdef TIMELINE_TRACING
+      if (active_)
+        return clock::now();
+#endif
+      return clock::time_point();
+    }
+
+    /**
+     * Record an event with name @p name that started at @p begin and
+     * ends now on the calling thread.
+     */
+    void record([[maybe_unused]] const char *name,
+                [[maybe_unused]] const clock::time_point &begin)
+    {
+#ifdef TIMELINE_TRACING
+      if (!active_)
+        return;
+
+      const auto end = clock::now();
+
+      thread_local unsigned int index = next_buffer_++;
+      if (index >= buffers_.size())
+        return;
+
+      auto &buffer = buffers_[index];
+      auto &event = buffer.events[buffer.n_recorded++ % buffer.events.size()];
+      std::strncpy(event.name.data(), name, event.name.size() - 1);
+      event.name.back() = '\0';
+      event.begin = timestamp(begin);
+      event.end = timestamp(end);
+#endif
+    }
+
+    /**
+     * Write all recorded events in the Chrome trace event format to the
+     * file @p file_name. The @p rank is used as process id.
+     */
+    void write([[maybe_unused]] const std::string &file_name,
+               [[maybe_unused]] const unsigned int rank) const
+    {
+#ifdef TIMELINE_TRACING
+      if (!active_)
+        return;
+
+      std::ofstream output(file_name);
+      output << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+      bool first = true;
+      for (unsigned int t = 0; t < buffers_.size(); ++t) {
+        const auto &buffer = buffers_[t];
+        const auto size = buffer.events.size();
+        const auto n_events = std::min<std::size_t>(buffer.n_recorded, size);
+        const auto offset = buffer.n_recorded - n_events;
+
+        for (std::size_t k = 0; k < n_events; ++k) {
+          const auto &event = buffer.events[(offset + k) % size];
+          output << (first ? "\n" : ",\n") << "{\"name\": \""
+                 << event.name.data() << "\", \"ph\": \"X\", \"pid\": " << rank
+                 << ", \"tid\": " << t << ", \"ts\": " << 1.e-3 * event.begin
+                 << ", \"dur\": " << 1.e-3 * (event.end - event.begin) << "}";
+          first = false;
+        }
+      }
+
+      output << "\n]}" << std::endl;
+#endif
+    }
+
+  private:
+    TimelineTracer() = default;
+
+    /**
+     * The number of buffers allocated in addition to one buffer per
+     * OpenMP thread.
+     */
+    static constexpr unsigned int n_additional_buffers = 4;
+
+    /**
+     * Return the time in nanoseconds elapsed since initialize().
+     */
+    std::int64_t timestamp(const clock::time_point &time) const
+    {
+      const auto elapsed = time - epoch_;
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+          .count();
+    }
+
+    /* Pad every buffer to a cache line to avoid false sharing: */
+    struct alignas(64) Buffer {
+      std::size_t n_recorded = 0;
+      std::vector<Event> events;
+    };
+
+    bool active_ = false;
+
+    clock::time_point epoch_;
+    std::vector<Buffer> buffers_;
+    std::atomic_uint next_buffer_ = 0;
+  };
+
+
+  /**
+   * A RAII scope recording a single event with the TimelineTracer.
+   *
+   * @ingroup Miscellaneous
+   */
+  class TimelineRegion
+  {
+  public:
+    /**
+     * Constructor. Starts the event with name @p name. The name has to
+     * outlive the object.
+     */
+    TimelineRegion(const char *name)
+        : name_(name)
+        , begin_(TimelineTracer::instance().now())
+    {
+    }
+
+    /**
+     * Destructor. Records the event.
+     */
+    ~TimelineRegion()
+    {
+      TimelineTracer::instance().record(name_, begin_);
+    }
+
+  private:
+    const char *name_;
+    const TimelineTracer::clock::time_point begin_;
+  };
+} // namespace ryujin
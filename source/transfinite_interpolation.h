@@ -10,6 +10,11 @@
 #include <deal.II/base/config.h>
 #include <deal.II/grid/manifold.h>
 
+#include <array>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace ryujin
 {
   using namespace dealii; // FIXME: namespace pollution
@@ -20,6 +25,12 @@ namespace ryujin
    * and all relevant Manifold information. That way it can be initialized
    * with one Triangulation and be used with another Triangulation.
    *
+   * Furthermore, successful pull-backs of points into the chart space of
+   * a coarse cell are cached. Refining curved meshes (and evaluating
+   * high-order mappings) pulls back the same vertices and midpoints for
+   * every adjacent cell, face and line. The cache therefore avoids most
+   * of the Newton iterations that would otherwise be repeated.
+   *
    * @ingroup Mesh
    */
   template <int dim, int spacedim = dim>
@@ -67,6 +78,22 @@ namespace ryujin
         const Point<dim> &chart_point,
         const Point<spacedim> &pushed_forward_chart_point) const;
 
+    /**
+     * Look up a previously computed pull-back of @p point on the
+     * coarse cell with index @p cell_index. Returns true and sets
+     * @p chart_point if the point is found in the cache.
+     */
+    bool lookup_pull_back(const unsigned int cell_index,
+                          const Point<spacedim> &point,
+                          Point<dim> &chart_point) const;
+
+    /**
+     * Store a successful pull-back in the cache.
+     */
+    void store_pull_back(const unsigned int cell_index,
+                         const Point<spacedim> &point,
+                         const Point<dim> &chart_point) const;
+
     Triangulation<dim, spacedim> triangulation;
 
     int level_coarse;
@@ -74,6 +101,37 @@ namespace ryujin
     std::vector<bool> coarse_cell_is_flat;
 
     std::unique_ptr<Manifold<dim, spacedim>> chart_manifold;
+
+    /*
+     * The pull-back cache. Points are identified by their exact
+     * (bitwise) coordinates. Access is guarded by a shared mutex because
+     * mappings might be evaluated concurrently from multiple threads.
+     */
+
+    struct PullBackKey {
+      unsigned int cell_index;
+      std::array<double, spacedim> coordinates;
+
+      bool operator==(const PullBackKey &other) const = default;
+    };
+
+    struct PullBackKeyHash {
+      std::size_t operator()(const PullBackKey &key) const
+      {
+        std::size_t result = std::hash<unsigned int>{}(key.cell_index);
+        for (const auto &it : key.coordinates)
+          result ^= std::hash<double>{}(it) + 0x9e3779b9 + (result << 6) +
+                    (result >> 2);
+        return result;
+      }
+    };
+
+    static constexpr std::size_t max_pull_back_cache_size = 1 << 22;
+
+    mutable std::unordered_map<PullBackKey, Point<dim>, PullBackKeyHash>
+        pull_back_cache;
+
+    mutable std::shared_mutex pull_back_cache_mutex;
   };
 
 } // namespace ryujin
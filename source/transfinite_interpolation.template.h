@@ -52,6 +52,11 @@ namespace ryujin
 
     this->chart_manifold = chart_manifold.clone();
 
+    {
+      std::unique_lock<std::shared_mutex> lock(pull_back_cache_mutex);
+      pull_back_cache.clear();
+    }
+
     level_coarse = triangulation.last()->level();
     coarse_cell_is_flat.resize(triangulation.n_cells(level_coarse), false);
     typename Triangulation<dim, spacedim>::active_cell_iterator
@@ -560,6 +565,44 @@ namespace ryujin
   }
 
 
+  template <int dim, int spacedim>
+  bool TransfiniteInterpolationManifold<dim, spacedim>::lookup_pull_back(
+      const unsigned int cell_index,
+      const Point<spacedim> &point,
+      Point<dim> &chart_point) const
+  {
+    PullBackKey key{cell_index, {}};
+    for (unsigned int d = 0; d < spacedim; ++d)
+      key.coordinates[d] = point[d];
+
+    std::shared_lock<std::shared_mutex> lock(pull_back_cache_mutex);
+    const auto it = pull_back_cache.find(key);
+    if (it == pull_back_cache.end())
+      return false;
+
+    chart_point = it->second;
+    return true;
+  }
+
+
+  template <int dim, int spacedim>
+  void TransfiniteInterpolationManifold<dim, spacedim>::store_pull_back(
+      const unsigned int cell_index,
+      const Point<spacedim> &point,
+      const Point<dim> &chart_point) const
+  {
+    PullBackKey key{cell_index, {}};
+    for (unsigned int d = 0; d < spacedim; ++d)
+      key.coordinates[d] = point[d];
+
+    std::unique_lock<std::shared_mutex> lock(pull_back_cache_mutex);
+    /* Bound the memory consumption by simply starting over: */
+    if (pull_back_cache.size() >= max_pull_back_cache_size)
+      pull_back_cache.clear();
+    pull_back_cache.emplace(key, chart_point);
+  }
+
+
   template <int dim, int spacedim>
   std::array<unsigned int, 20> TransfiniteInterpolationManifold<dim, spacedim>::
       get_possible_cells_around_points(
@@ -768,6 +811,12 @@ namespace ryujin
     auto compute_chart_point =
         [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
             const unsigned int point_index) {
+          // first check whether we have pulled back this point before
+          if (lookup_pull_back(cell->index(),
+                               surrounding_points[point_index],
+                               chart_points[point_index]))
+            return;
+
           Point<dim> guess;
           // an optimization: keep track of whether or not we used the affine
           // approximation so that we don't call pull_back with the same
@@ -827,6 +876,12 @@ namespace ryujin
             chart_points[point_index] =
                 pull_back(cell, surrounding_points[point_index], guess);
           }
+
+          if (chart_points[point_index][0] !=
+              internal::invalid_pull_back_coordinate)
+            store_pull_back(cell->index(),
+                            surrounding_points[point_index],
+                            chart_points[point_index]);
         };
 
     // check whether all points are inside the unit cell of the current chart
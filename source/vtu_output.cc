@@ -13,4 +13,10 @@ namespace ryujin
   template class VTUOutput<Description, 2, NUMBER>;
   template class VTUOutput<Description, 3, NUMBER>;
 
+#ifdef PRECISION_SWITCH
+  template class VTUOutput<Description, 1, float>;
+  template class VTUOutput<Description, 2, float>;
+  template class VTUOutput<Description, 3, float>;
+#endif
+
 } /* namespace ryujin */
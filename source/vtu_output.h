@@ -9,12 +9,59 @@
 
 #include "mpi_ensemble.h"
 #include "offline_data.h"
+#include "openmp.h"
+#include "patterns_conversion.h"
 #include "postprocessor.h"
 
+#include <deal.II/base/data_out_base.h>
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/grid/intergrid_map.h>
 #include <deal.II/multigrid/mg_transfer_matrix_free.h>
+#include <deal.II/numerics/data_out.h>
+
+#include <deque>
+#include <future>
+#include <map>
+
+namespace ryujin
+{
+  /**
+   * Controls the file format used by VTUOutput.
+   *
+   * @ingroup TimeLoop
+   */
+  enum class OutputFormat {
+    /**
+     * Write out vtu files, either one file per rank together with a pvtu
+     * record, or a single vtu file via MPI IO.
+     */
+    vtu,
+
+    /**
+     * Write out a single HDF5 file per output cycle with all state fields
+     * and an XDMF record referencing all output cycles. The mesh geometry
+     * is only written once per mesh (i.e., once after every call to
+     * VTUOutput::prepare()). This option requires deal.II to be configured
+     * with HDF5 support.
+     */
+    hdf5,
+
+    /**
+     * Do not write any files but pass all output fields to a ParaView
+     * Catalyst 2 pipeline for in-situ visualization. This option requires
+     * ryujin to be configured with WITH_CATALYST.
+     */
+    catalyst,
+  };
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::OutputFormat,
+             LIST({ryujin::OutputFormat::vtu, "vtu"},
+                  {ryujin::OutputFormat::hdf5, "hdf5"},
+                  {ryujin::OutputFormat::catalyst, "catalyst"}, ));
+#endif
 
 namespace ryujin
 {
@@ -68,15 +115,27 @@ namespace ryujin
               const ParabolicSystem &parabolic_system,
               const Postprocessor<Description, dim, Number> &postprocessor,
               const InitialPrecomputedVector &initial_precomputed,
-              const ScalarVector &alpha,
+              const Vectors::IndicatorVector<Number> &alpha,
+              const RowWorkCounters &row_work_counters,
               const std::string &subsection = "/VTUOutput");
 
+    /**
+     * Destructor. Waits for all pending (asynchronous) outputs to
+     * complete and finalizes Catalyst (if initialized).
+     */
+    ~VTUOutput();
+
     /**
      * Prepare VTU output. A call to @ref prepare() allocates temporary
      * storage and is necessary before schedule_output() can be called.
      *
      * Calling prepare() allocates temporary storage for additional (dim +
-     * 5) scalar vectors of type OfflineData::scalar_type.
+     * 5) scalar vectors of type OfflineData::scalar_type. The function
+     * also evaluates the "region of interest" cell selection and the list
+     * of cells intersecting the "manifolds" for the current mesh.
+     *
+     * The function waits for all pending (asynchronous) outputs to
+     * complete.
      */
     void prepare();
 
@@ -88,7 +147,9 @@ namespace ryujin
      * The function post-processes quantities synchronously, and (depending
      * on configuration options) schedules the write-out asynchronously
      * onto a background worker thread. This implies that @p U can again be
-     * modified once schedule_output() returned.
+     * modified once schedule_output() returned. If more than "asynchronous
+     * queue size" outputs are pending, the function either waits for the
+     * oldest output to complete, or skips the output altogether.
      *
      * The booleans @p output_full controls whether the full vector field
      * is written out. Correspondingly, @p output_cutplanes controls
@@ -104,18 +165,96 @@ namespace ryujin
                          bool output_full = true,
                          bool output_cutplanes = true);
 
+    /**
+     * Return true if only the statistics over all ensemble members are
+     * written out, see the "ensemble statistics" run time parameter.
+     */
+    bool ensemble_statistics() const
+    {
+      return ensemble_statistics_ && mpi_ensemble_.n_ensembles() > 1;
+    }
+
   private:
+    /**
+     * Replace every field in @p fields (with names @p field_names) by its
+     * mean, (sample) variance, minimum and maximum over all ensemble
+     * members. The statistics are stored in @p statistics. The function
+     * requires MPI communication over the peer communicator.
+     */
+    void compute_ensemble_statistics(
+        std::vector<const ScalarVector *> &fields,
+        std::vector<std::string> &field_names,
+        std::vector<ScalarVector> &statistics) const;
+
+    /**
+     * Return the tolerance for lossy output of the quantity @p quantity
+     * as specified by the "vtu output tolerances" parameter, or zero if
+     * the quantity is written out losslessly.
+     */
+    Number output_tolerance(const std::string &quantity) const;
+
+    /**
+     * Write out the (already built) patches of @p data_out into an HDF5
+     * file and update the corresponding XDMF record. The mesh geometry is
+     * written only once per file name prefix @p name and mesh.
+     */
+    void write_hdf5(const dealii::DataOut<dim> &data_out,
+                    const std::string &name,
+                    Number t,
+                    unsigned int cycle);
+
+    /**
+     * Pass the (already built) patches of @p data_out as an unstructured
+     * Conduit mesh blueprint on the channel @p name to Catalyst. Catalyst
+     * is initialized with the configured pipeline scripts on first use.
+     */
+    void write_catalyst(const dealii::DataOut<dim> &data_out,
+                        const std::string &name,
+                        Number t,
+                        unsigned int cycle);
+
+    /**
+     * Compute the cut surfaces of all "manifolds" with the locally owned
+     * cells in the region of interest with a marching cubes algorithm
+     * and store the surface patches together with the degrees of freedom
+     * and shape function values needed to interpolate onto the patch
+     * vertices.
+     */
+    void prepare_slices();
+
     /**
      * @name Run time options
      */
     //@{
 
+    OutputFormat output_format_;
+
     bool use_mpi_io_;
 
+    unsigned int io_ranks_per_node_;
+
+    std::vector<std::string> catalyst_scripts_;
+
+    bool asynchronous_writeback_;
+
+    unsigned int asynchronous_queue_size_;
+
+    bool skip_output_if_busy_;
+
+    bool ensemble_statistics_;
+
     std::vector<std::string> manifolds_;
 
+    bool slice_manifolds_;
+
+    std::string region_of_interest_;
+
+    unsigned int output_subdivisions_;
+
     std::vector<std::string> vtu_output_quantities_;
 
+    std::vector<std::pair<std::string, Number>> output_tolerances_;
+
     //@}
     /**
      * @name Internal data
@@ -131,7 +270,34 @@ namespace ryujin
         postprocessor_;
 
     const InitialPrecomputedVector &initial_precomputed_;
-    const ScalarVector &alpha_;
+    const Vectors::IndicatorVector<Number> &alpha_;
+    const RowWorkCounters &row_work_counters_;
+
+    std::deque<std::future<void>> pending_writes_;
+
+    std::map<std::string, std::string> hdf5_mesh_files_;
+    std::map<std::string, std::vector<dealii::XDMFEntry>> xdmf_entries_;
+
+    bool catalyst_initialized_;
+
+    /* Cell selection for the region of interest, indexed by the active
+     * cell index and recomputed in prepare(): */
+    std::vector<bool> cell_in_region_of_interest_;
+
+    /* All (non-artificial) cells in the region of interest that intersect
+     * one of the manifolds, sorted by the active cell index and
+     * recomputed in prepare(): */
+    std::vector<typename dealii::Triangulation<dim>::active_cell_iterator>
+        levelset_cells_;
+
+    /* The cut surfaces of the manifolds for slice output computed in
+     * prepare_slices(). For every patch vertex we store the local
+     * indices and shape function values of all degrees of freedom of the
+     * surrounding cell: */
+    static constexpr int slice_dim = dim == 1 ? 1 : dim - 1;
+    std::vector<dealii::DataOutBase::Patch<slice_dim, dim>> slice_patches_;
+    std::vector<unsigned int> slice_dof_indices_;
+    std::vector<Number> slice_shape_values_;
     //@}
   };
 
@@ -8,16 +8,85 @@
 #include "selected_components_extractor.h"
 #include "vtu_output.h"
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/function_parser.h>
+#include <deal.II/grid/grid_tools.h>
 #include <deal.II/numerics/data_out.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#ifdef WITH_CATALYST
+#include <catalyst.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
 
 namespace ryujin
 {
   using namespace dealii;
 
 
+  namespace
+  {
+    /**
+     * Round all locally owned entries of @p vector to an integer multiple
+     * of the largest power of two that is smaller than or equal to
+     * 2 * @p tolerance. This introduces a pointwise error of at most
+     * @p tolerance and zeroes out the trailing mantissa bits. For a
+     * tolerance of zero the vector is left unchanged.
+     */
+    template <typename Vector, typename Number>
+    void quantize(Vector &vector, const Number tolerance)
+    {
+      if (tolerance <= Number(0.))
+        return;
+
+      const Number step =
+          std::exp2(std::floor(std::log2(Number(2.) * tolerance)));
+      for (auto &it : vector)
+        it = std::round(it / step) * step;
+    }
+
+
+    /**
+     * A minimal DataOutInterface holding a precomputed list of patches,
+     * used for writing out the cut surfaces of the level set output.
+     */
+    template <int dim, int spacedim>
+    class SurfaceOutput : public DataOutInterface<dim, spacedim>
+    {
+    public:
+      SurfaceOutput(std::vector<DataOutBase::Patch<dim, spacedim>> &&patches,
+                    const std::vector<std::string> &names)
+          : patches_(std::move(patches))
+          , names_(names)
+      {
+      }
+
+    protected:
+      const std::vector<DataOutBase::Patch<dim, spacedim>> &
+      get_patches() const override
+      {
+        return patches_;
+      }
+
+      std::vector<std::string> get_dataset_names() const override
+      {
+        return names_;
+      }
+
+    private:
+      std::vector<DataOutBase::Patch<dim, spacedim>> patches_;
+      std::vector<std::string> names_;
+    };
+  } // namespace
+
+
   template <typename Description, int dim, typename Number>
   VTUOutput<Description, dim, Number>::VTUOutput(
       const MPIEnsemble &mpi_ensemble,
@@ -26,7 +95,8 @@ namespace ryujin
       const ParabolicSystem &parabolic_system,
       const Postprocessor<Description, dim, Number> &postprocessor,
       const InitialPrecomputedVector &initial_precomputed,
-      const ScalarVector &alpha,
+      const Vectors::IndicatorVector<Number> &alpha,
+      const RowWorkCounters &row_work_counters,
       const std::string &subsection /*= "VTUOutput"*/)
       : ParameterAcceptor(subsection)
       , mpi_ensemble_(mpi_ensemble)
@@ -36,7 +106,24 @@ namespace ryujin
       , postprocessor_(&postprocessor)
       , initial_precomputed_(initial_precomputed)
       , alpha_(alpha)
+      , row_work_counters_(row_work_counters)
+      , catalyst_initialized_(false)
   {
+    output_format_ = OutputFormat::vtu;
+    add_parameter("output format",
+                  output_format_,
+                  "Output file format: \"vtu\" (vtu files with a pvtu record, "
+                  "or a single vtu file via MPI IO), \"hdf5\" (one HDF5 "
+                  "file per cycle with an XDMF record, the mesh is only "
+                  "written once per mesh), or \"catalyst\" (in-situ "
+                  "visualization with ParaView Catalyst, no files written)");
+
+    add_parameter("catalyst scripts",
+                  catalyst_scripts_,
+                  "List of Catalyst pipeline (python) scripts that are "
+                  "executed for every output if the output format is set to "
+                  "\"catalyst\"");
+
     use_mpi_io_ = true;
     add_parameter("use mpi io",
                   use_mpi_io_,
@@ -44,11 +131,80 @@ namespace ryujin
                   "write_vtu_in_parallel() instead of independent output files "
                   "via write_vtu_with_pvtu_record()");
 
+    io_ranks_per_node_ = 0;
+    add_parameter("io ranks per node",
+                  io_ranks_per_node_,
+                  "If \"use mpi io\" is disabled and this number is nonzero, "
+                  "the patches of all ranks are gathered on the given number "
+                  "of aggregator ranks per compute node, which then write one "
+                  "vtu file each via MPI IO. Otherwise, every rank writes "
+                  "its own vtu file");
+    asynchronous_writeback_ = false;
+    add_parameter("asynchronous writeback",
+                  asynchronous_writeback_,
+                  "If enabled, patches are built synchronously but the vtu "
+                  "files are written on a background thread while the "
+                  "computation continues. This option writes one file per "
+                  "rank and a pvtu record and ignores \"use mpi io\". HDF5 "
+                  "output is always written synchronously");
+
+    asynchronous_queue_size_ = 2;
+    add_parameter("asynchronous queue size",
+                  asynchronous_queue_size_,
+                  "Maximal number of outputs that are pending in the "
+                  "background at any given time");
+
+    skip_output_if_busy_ = false;
+    add_parameter("skip output if busy",
+                  skip_output_if_busy_,
+                  "If enabled, an output is skipped altogether if the queue "
+                  "of pending outputs is full. Otherwise, we wait for the "
+                  "oldest pending output to complete");
+
+    ensemble_statistics_ = false;
+    add_parameter("ensemble statistics",
+                  ensemble_statistics_,
+                  "If enabled (and running with more than one ensemble), "
+                  "every output field is replaced by its mean, variance, "
+                  "minimum and maximum over all ensemble members. The "
+                  "statistics are computed in-situ (via the peer "
+                  "communicator) and only written out by the first ensemble. "
+                  "Requires an identical mesh and partition for all "
+                  "ensembles");
+
     add_parameter("manifolds",
                   manifolds_,
                   "List of level set functions. The description is used to "
                   "only output cells that intersect the given level set.");
 
+    slice_manifolds_ = false;
+    add_parameter("slice manifolds",
+                  slice_manifolds_,
+                  "If enabled, the level set output interpolates all fields "
+                  "onto the actual cut surfaces of the manifolds (computed "
+                  "with a marching cubes algorithm) instead of writing out "
+                  "all cells intersecting a level set. This option requires "
+                  "the \"vtu\" output format and dim > 1");
+
+    add_parameter(
+        "region of interest",
+        region_of_interest_,
+        "A level set function describing a region of interest. If "
+        "nonempty, only cells with at least one vertex for which the "
+        "function is nonnegative are written out. For example, the "
+        "bounding box [0,1]x[-1,1] is described by "
+        "\"min(x, 1 - x, y + 1, 1 - y)\". The selection is evaluated once "
+        "per mesh.");
+
+    output_subdivisions_ = 0;
+    add_parameter("output subdivisions",
+                  output_subdivisions_,
+                  "Number of subdivisions of every cell used for output. A "
+                  "value of zero selects the polynomial degree of the finite "
+                  "element and thus writes out all degrees of freedom. A "
+                  "value of one writes out the cell vertices only, which "
+                  "subsamples the output of higher-order elements.");
+
     std::copy(std::begin(View::component_names),
               std::end(View::component_names),
               std::back_inserter(vtu_output_quantities_));
@@ -61,6 +217,31 @@ namespace ryujin
                   vtu_output_quantities_,
                   "List of conserved, primitive, precomputed, or postprocessed "
                   "quantities that will be written to the vtu files.");
+
+    add_parameter(
+        "vtu output tolerances",
+        output_tolerances_,
+        "List of pairs \"quantity : tolerance\" enabling lossy, error "
+        "bounded output of the given quantity. The values are rounded to a "
+        "multiple of a power of two that is at most twice the tolerance, "
+        "which guarantees a pointwise error of at most the tolerance and "
+        "renders trailing mantissa bits zero so that the output compresses "
+        "much better.");
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  VTUOutput<Description, dim, Number>::~VTUOutput()
+  {
+    for (auto &it : pending_writes_)
+      it.wait();
+
+#ifdef WITH_CATALYST
+    if (catalyst_initialized_) {
+      conduit_cpp::Node node;
+      catalyst_finalize(conduit_cpp::c_node(&node));
+    }
+#endif
   }
 
 
@@ -71,11 +252,276 @@ namespace ryujin
     std::cout << "VTUOutput<dim, Number>::prepare()" << std::endl;
 #endif
 
+    /* Make sure that no pending output refers to an old mesh: */
+    while (!pending_writes_.empty()) {
+      pending_writes_.front().get();
+      pending_writes_.pop_front();
+    }
+
+#ifndef DEAL_II_WITH_HDF5
+    AssertThrow(output_format_ != OutputFormat::hdf5,
+                dealii::ExcMessage("The \"hdf5\" output format requires "
+                                   "deal.II to be configured with HDF5"));
+#endif
+
+#ifndef WITH_CATALYST
+    AssertThrow(output_format_ != OutputFormat::catalyst,
+                dealii::ExcMessage("The \"catalyst\" output format requires "
+                                   "ryujin to be configured with "
+                                   "WITH_CATALYST"));
+#endif
+
+    /* The mesh has (possibly) changed, write it out again: */
+    hdf5_mesh_files_.clear();
+
+    /* Evaluate the region of interest for the current mesh: */
+    cell_in_region_of_interest_.clear();
+    if (!region_of_interest_.empty()) {
+      const auto &triangulation =
+          offline_data_->discretization().triangulation();
+      cell_in_region_of_interest_.resize(triangulation.n_active_cells(), false);
+
+      FunctionParser<dim> level_set_function(region_of_interest_);
+      for (const auto &cell : triangulation.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+        for (unsigned int v : cell->vertex_indices()) {
+          constexpr auto eps = std::numeric_limits<Number>::epsilon();
+          if (level_set_function.value(cell->vertex(v)) >= 0. - 100. * eps) {
+            cell_in_region_of_interest_[cell->active_cell_index()] = true;
+            break;
+          }
+        }
+      }
+    }
+
+    /*
+     * Collect all cells in the vicinity of the manifolds once per mesh so
+     * that level set output only has to visit the selected cells:
+     */
+    levelset_cells_.clear();
+    if (!manifolds_.empty() && !slice_manifolds_) {
+      const auto &triangulation =
+          offline_data_->discretization().triangulation();
+
+      std::vector<std::unique_ptr<FunctionParser<dim>>> level_set_functions;
+      for (const auto &expression : manifolds_)
+        level_set_functions.emplace_back(
+            std::make_unique<FunctionParser<dim>>(expression));
+
+      const auto intersects = [&](const auto &cell) {
+        for (const auto &function : level_set_functions) {
+          unsigned int above = 0;
+          unsigned int below = 0;
+
+          for (unsigned int v : cell->vertex_indices()) {
+            constexpr auto eps = std::numeric_limits<Number>::epsilon();
+            const auto value = function->value(cell->vertex(v));
+            if (value >= 0. - 100. * eps)
+              above++;
+            if (value <= 0. + 100. * eps)
+              below++;
+            if (above > 0 && below > 0)
+              return true;
+          }
+        }
+        return false;
+      };
+
+      for (const auto &cell : triangulation.active_cell_iterators()) {
+        if (cell->is_artificial())
+          continue;
+        if (!cell_in_region_of_interest_.empty() &&
+            !cell_in_region_of_interest_[cell->active_cell_index()])
+          continue;
+        if (intersects(cell))
+          levelset_cells_.push_back(cell);
+      }
+    }
+
+    slice_patches_.clear();
+    slice_dof_indices_.clear();
+    slice_shape_values_.clear();
+    if (slice_manifolds_ && !manifolds_.empty()) {
+      AssertThrow(dim > 1,
+                  dealii::ExcMessage("\"slice manifolds\" requires dim > 1"));
+      AssertThrow(output_format_ == OutputFormat::vtu,
+                  dealii::ExcMessage("\"slice manifolds\" requires the "
+                                     "\"vtu\" output format"));
+      prepare_slices();
+    }
+
     SelectedComponentsExtractor<Description, dim, Number>::check(
         vtu_output_quantities_);
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void VTUOutput<Description, dim, Number>::prepare_slices()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "VTUOutput<dim, Number>::prepare_slices()" << std::endl;
+#endif
+
+    const auto &discretization = offline_data_->discretization();
+    const auto &mapping = discretization.mapping();
+    const auto &finite_element = discretization.finite_element();
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &scalar_partitioner = offline_data_->scalar_partitioner();
+    const auto dofs_per_cell = finite_element.n_dofs_per_cell();
+
+    /* Resolve a curved level set with one sub cell per polynomial degree: */
+    const GridTools::MarchingCubeAlgorithm<dim, ScalarVector> marching_cubes(
+        mapping, finite_element, std::max(1u, finite_element.degree));
+
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+    std::vector<Point<dim>> vertices;
+    std::vector<CellData<slice_dim>> cells;
+
+    ScalarVector level_set;
+    level_set.reinit(scalar_partitioner);
+
+    for (const auto &expression : manifolds_) {
+      FunctionParser<dim> level_set_function(expression);
+      VectorTools::interpolate(
+          mapping, dof_handler, level_set_function, level_set);
+      level_set.update_ghost_values();
+
+      for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+        if (!cell_in_region_of_interest_.empty() &&
+            !cell_in_region_of_interest_[cell->active_cell_index()])
+          continue;
+
+        vertices.clear();
+        cells.clear();
+        marching_cubes.process_cell(cell, level_set, 0., vertices, cells);
+        if (cells.empty())
+          continue;
+
+        cell->get_dof_indices(dof_indices);
+
+        for (const auto &surface_cell : cells) {
+          auto &patch = slice_patches_.emplace_back();
+          patch.n_subdivisions = 1;
+          patch.patch_index = slice_patches_.size() - 1;
+
+          /* The cut surface of a hexahedron consists of triangles: */
+          const unsigned int n_vertices = surface_cell.vertices.size();
+          if (n_vertices == 3)
+            patch.reference_cell = ReferenceCells::Triangle;
+
+          for (unsigned int v = 0; v < n_vertices; ++v) {
+            const auto &point = vertices[surface_cell.vertices[v]];
+            patch.vertices[v] = point;
+
+            const auto unit_point = GeometryInfo<dim>::project_to_unit_cell(
+                mapping.transform_real_to_unit_cell(cell, point));
+            for (unsigned int k = 0; k < dofs_per_cell; ++k) {
+              slice_dof_indices_.push_back(
+                  scalar_partitioner->global_to_local(dof_indices[k]));
+              slice_shape_values_.push_back(
+                  finite_element.shape_value(k, unit_point));
+            }
+          }
+        }
+      }
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void VTUOutput<Description, dim, Number>::compute_ensemble_statistics(
+      std::vector<const ScalarVector *> &fields,
+      std::vector<std::string> &field_names,
+      std::vector<ScalarVector> &statistics) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "VTUOutput<dim, Number>::compute_ensemble_statistics()"
+              << std::endl;
+#endif
+
+    const auto &peer_communicator = mpi_ensemble_.peer_communicator();
+    const unsigned int n_ensembles = mpi_ensemble_.n_ensembles();
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+
+    AssertThrow(Utilities::MPI::min(n_owned, peer_communicator) ==
+                    Utilities::MPI::max(n_owned, peer_communicator),
+                ExcMessage("Ensemble statistics require an identical mesh "
+                           "and partition for all ensembles"));
+
+    /*
+     * Pack all fields into a single buffer so that every statistic
+     * requires only one reduction over the peer communicator:
+     */
+
+    const unsigned int n_fields = fields.size();
+    const std::size_t size = std::size_t(n_fields) * n_owned;
+
+    std::vector<Number> values(size);
+    for (unsigned int f = 0; f < n_fields; ++f)
+      std::copy_n(fields[f]->begin(), n_owned, values.begin() + f * n_owned);
+
+    std::vector<Number> mean(size);
+    std::vector<Number> minimum(size);
+    std::vector<Number> maximum(size);
+    Utilities::MPI::sum(make_array_view(std::as_const(values)),
+                        peer_communicator,
+                        make_array_view(mean));
+    Utilities::MPI::min(make_array_view(std::as_const(values)),
+                        peer_communicator,
+                        make_array_view(minimum));
+    Utilities::MPI::max(make_array_view(std::as_const(values)),
+                        peer_communicator,
+                        make_array_view(maximum));
+
+    /* Compute the variance in a second pass for better accuracy: */
+    for (std::size_t k = 0; k < size; ++k) {
+      mean[k] /= Number(n_ensembles);
+      values[k] = (values[k] - mean[k]) * (values[k] - mean[k]);
+    }
+
+    std::vector<Number> variance(size);
+    Utilities::MPI::sum(make_array_view(std::as_const(values)),
+                        peer_communicator,
+                        make_array_view(variance));
+    for (auto &it : variance)
+      it /= Number(n_ensembles - 1);
+
+    /* Unpack: */
+
+    const auto &affine_constraints = offline_data_->affine_constraints();
+
+    const std::array<std::pair<const std::vector<Number> *, std::string>, 4>
+        statistic_names{{{&mean, "_mean"},
+                         {&variance, "_variance"},
+                         {&minimum, "_min"},
+                         {&maximum, "_max"}}};
+
+    statistics.resize(statistic_names.size() * n_fields);
+
+    std::vector<const ScalarVector *> new_fields;
+    std::vector<std::string> new_field_names;
+
+    auto it = statistics.begin();
+    for (unsigned int f = 0; f < n_fields; ++f)
+      for (const auto &[data, suffix] : statistic_names) {
+        it->reinit(offline_data_->scalar_partitioner());
+        std::copy_n(data->begin() + f * n_owned, n_owned, it->begin());
+        affine_constraints.distribute(*it);
+        it->update_ghost_values();
+
+        new_fields.push_back(&*it);
+        new_field_names.push_back(field_names[f] + suffix);
+        ++it;
+      }
+
+    fields.swap(new_fields);
+    field_names.swap(new_field_names);
+  }
+
+
   template <typename Description, int dim, typename Number>
   void VTUOutput<Description, dim, Number>::schedule_output(
       const StateVector &state_vector,
@@ -88,11 +534,51 @@ namespace ryujin
 #ifdef DEBUG_OUTPUT
     std::cout << "VTUOutput<dim, Number>::schedule_output()" << std::endl;
 #endif
+
+    if (asynchronous_writeback_) {
+      /* Remove all completed outputs (and rethrow any exception): */
+      for (auto it = pending_writes_.begin(); it != pending_writes_.end();) {
+        if (it->wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready) {
+          it->get();
+          it = pending_writes_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+
+      /*
+       * The decision whether to skip (or wait) has to be consistent over
+       * all ranks, otherwise the pvtu record would refer to missing files:
+       */
+      bool busy = Utilities::MPI::logical_or(
+          pending_writes_.size() >= asynchronous_queue_size_,
+          mpi_ensemble_.ensemble_communicator());
+      /* With ensemble statistics all ensembles take part in an output: */
+      if (ensemble_statistics())
+        busy = Utilities::MPI::logical_or(busy,
+                                          mpi_ensemble_.peer_communicator());
+      if (busy) {
+        if (skip_output_if_busy_)
+          return;
+
+        while (!pending_writes_.empty() &&
+               pending_writes_.size() >= asynchronous_queue_size_) {
+          pending_writes_.front().get();
+          pending_writes_.pop_front();
+        }
+      }
+    }
+
     const auto &affine_constraints = offline_data_->affine_constraints();
 
     /*
      * Extract quantities and store in ScalarVectors so that we can call
-     * DataOut::add_data_vector()
+     * DataOut::add_data_vector(). The vectors are only needed while
+     * building patches: every DataOut object releases its references to
+     * the input data right after build_patches() (see below), so that
+     * the temporary vectors are freed before the (possibly asynchronous)
+     * write out and only the patches are kept alive.
      */
 
     auto selected_components =
@@ -103,24 +589,57 @@ namespace ryujin
             alpha_,
             vtu_output_quantities_);
 
-    /* prepare DataOut: */
-
-    auto data_out = std::make_unique<dealii::DataOut<dim>>();
-    data_out->attach_dof_handler(offline_data_->dof_handler());
-
     for (unsigned int d = 0; d < selected_components.size(); ++d) {
-      affine_constraints.distribute(selected_components[d]);
-      selected_components[d].update_ghost_values();
-      data_out->add_data_vector(selected_components[d],
-                                vtu_output_quantities_[d],
-                                DataOut<dim>::type_dof_data);
+      auto &it = selected_components[d];
+      affine_constraints.distribute(it);
+      quantize(it, output_tolerance(vtu_output_quantities_[d]));
+      it.update_ghost_values();
     }
 
+    /*
+     * Create quantized copies of all postprocessed quantities for which a
+     * tolerance has been specified:
+     */
+
     const auto n_quantities = postprocessor_->n_quantities();
-    for (unsigned int i = 0; i < n_quantities; ++i)
-      data_out->add_data_vector(postprocessor_->quantities()[i],
-                                postprocessor_->component_names()[i],
-                                DataOut<dim>::type_dof_data);
+    std::vector<ScalarVector> postprocessed_quantities;
+    postprocessed_quantities.reserve(n_quantities);
+    std::vector<const ScalarVector *> postprocessed(n_quantities);
+
+    for (unsigned int i = 0; i < n_quantities; ++i) {
+      const auto &quantity = postprocessor_->quantities()[i];
+      const auto tolerance =
+          output_tolerance(postprocessor_->component_names()[i]);
+      if (tolerance == Number(0.)) {
+        postprocessed[i] = &quantity;
+        continue;
+      }
+
+      auto &copy = postprocessed_quantities.emplace_back(quantity);
+      quantize(copy, tolerance);
+      copy.update_ghost_values();
+      postprocessed[i] = &copy;
+    }
+
+    /*
+     * Write out the per-row work counters of the HyperbolicModule if
+     * ryujin is configured with WORK_COUNTERS:
+     */
+
+    std::vector<ScalarVector> work_counters;
+    if constexpr (RowWorkCounters::enabled()) {
+      const unsigned int n_owned = offline_data_->n_locally_owned();
+      work_counters.resize(RowWorkCounters::n_counters);
+      for (unsigned int c = 0; c < RowWorkCounters::n_counters; ++c) {
+        auto &it = work_counters[c];
+        it.reinit(offline_data_->scalar_partitioner());
+        for (unsigned int i = 0; i < n_owned; ++i)
+          it.local_element(i) =
+              row_work_counters_.get(RowWorkCounters::Counter(c), i);
+        affine_constraints.distribute(it);
+        it.update_ghost_values();
+      }
+    }
 
     DataOutBase::VtkFlags flags(t,
                                 cycle,
@@ -130,66 +649,216 @@ namespace ryujin
 #else
                                 DataOutBase::VtkFlags::best_speed);
 #endif
-    data_out->set_flags(flags);
+
+    /* Collect all output fields: */
+
+    std::vector<const ScalarVector *> fields;
+    std::vector<std::string> field_names;
+
+    for (unsigned int d = 0; d < selected_components.size(); ++d) {
+      fields.push_back(&selected_components[d]);
+      field_names.push_back(vtu_output_quantities_[d]);
+    }
+
+    for (unsigned int i = 0; i < n_quantities; ++i) {
+      fields.push_back(postprocessed[i]);
+      field_names.push_back(postprocessor_->component_names()[i]);
+    }
+
+    for (unsigned int c = 0; c < work_counters.size(); ++c) {
+      fields.push_back(&work_counters[c]);
+      field_names.push_back(RowWorkCounters::names[c]);
+    }
+
+    /*
+     * Replace all fields by their statistics over all ensemble members.
+     * Only the first ensemble writes out:
+     */
+    std::vector<ScalarVector> statistics;
+    if (ensemble_statistics()) {
+      compute_ensemble_statistics(fields, field_names, statistics);
+      if (mpi_ensemble_.ensemble() != 0)
+        return;
+      name += "-statistics";
+    }
+
+    /* prepare DataOut: */
+
+    const auto make_data_out = [&]() {
+      auto data_out = std::make_unique<dealii::DataOut<dim>>();
+      data_out->attach_dof_handler(offline_data_->dof_handler());
+
+      for (unsigned int k = 0; k < fields.size(); ++k)
+        data_out->add_data_vector(
+            *fields[k], field_names[k], DataOut<dim>::type_dof_data);
+
+      data_out->set_flags(flags);
+      return data_out;
+    };
+
+    /*
+     * In asynchronous mode we only build patches synchronously and
+     * collect the DataOut objects together with their file name prefix
+     * for writing them out on a background thread:
+     */
+    std::vector<std::pair<std::shared_ptr<dealii::DataOut<dim>>, std::string>>
+        staged_outputs;
+    std::vector<std::pair<std::shared_ptr<SurfaceOutput<slice_dim, dim>>,
+                          std::string>>
+        staged_surfaces;
 
     const auto &discretization = offline_data_->discretization();
     const auto &mapping = discretization.mapping();
     const auto patch_order =
-        std::max(1u, discretization.finite_element().degree) - 1u;
+        output_subdivisions_ != 0
+            ? output_subdivisions_
+            : std::max(1u, discretization.finite_element().degree) - 1u;
+
+    const auto build_patches = [&](dealii::DataOut<dim> &data_out) {
+      data_out.build_patches(mapping, patch_order);
+      /* The patches hold a copy of all data, drop the input vectors: */
+      data_out.clear_input_data_references();
+    };
+
+    /* Restrict the output to the region of interest (if any): */
+    const auto in_region_of_interest = [this](const auto &cell) {
+      if (cell_in_region_of_interest_.empty())
+        return true;
+      return bool(cell_in_region_of_interest_[cell->active_cell_index()]);
+    };
+
+    /*
+     * The number of files written in parallel by write_vtu_with_pvtu_record.
+     * A value of zero indicates one file per rank:
+     */
+    unsigned int n_groups = 0;
+    if (io_ranks_per_node_ > 0) {
+      const unsigned int n_nodes = std::max(
+          1, mpi_ensemble_.n_nodes() / mpi_ensemble_.n_ensembles());
+      n_groups = std::min<unsigned int>(io_ranks_per_node_ * n_nodes,
+                                        mpi_ensemble_.n_ensemble_ranks());
+    }
 
     /* Perform output: */
 
     if (output_full) {
-      data_out->build_patches(mapping, patch_order);
+      auto data_out = make_data_out();
+      if (!cell_in_region_of_interest_.empty())
+        data_out->set_cell_selection([in_region_of_interest](const auto &cell) {
+          return cell->is_active() && cell->is_locally_owned() &&
+                 in_region_of_interest(cell);
+        });
+      build_patches(*data_out);
 
-      if (use_mpi_io_) {
+      if (output_format_ == OutputFormat::hdf5) {
+        write_hdf5(*data_out, name, t, cycle);
+      } else if (output_format_ == OutputFormat::catalyst) {
+        write_catalyst(*data_out, "full", t, cycle);
+      } else if (asynchronous_writeback_) {
+        staged_outputs.emplace_back(std::move(data_out), name);
+      } else if (use_mpi_io_) {
         /* MPI-based synchronous IO */
         data_out->write_vtu_in_parallel(
             name + "_" + Utilities::to_string(cycle, 6) + ".vtu",
             mpi_ensemble_.ensemble_communicator());
       } else {
         data_out->write_vtu_with_pvtu_record(
-            "", name, cycle, mpi_ensemble_.ensemble_communicator(), 6);
+            "",
+            name,
+            cycle,
+            mpi_ensemble_.ensemble_communicator(),
+            6,
+            n_groups);
       }
     }
 
-    if (output_levelsets && manifolds_.size() != 0) {
+    if (output_levelsets && manifolds_.size() != 0 && slice_manifolds_) {
       /*
-       * Specify an output filter that selects only cells for output that are
-       * in the viscinity of a specified set of output planes:
+       * Interpolate all fields onto the vertices of the cut surfaces
+       * computed in prepare_slices():
        */
 
-      std::vector<std::shared_ptr<FunctionParser<dim>>> level_set_functions;
-      for (const auto &expression : manifolds_)
-        level_set_functions.emplace_back(
-            std::make_shared<FunctionParser<dim>>(expression));
+      const auto dofs_per_cell =
+          discretization.finite_element().n_dofs_per_cell();
 
-      data_out->set_cell_selection([level_set_functions](const auto &cell) {
-        if (!cell->is_active() || cell->is_artificial())
-          return false;
+      auto patches = slice_patches_;
+      std::size_t offset = 0;
+      for (auto &patch : patches) {
+        const unsigned int n_vertices = patch.reference_cell.n_vertices();
+        patch.data.reinit(fields.size(), n_vertices);
+        for (unsigned int v = 0; v < n_vertices; ++v) {
+          const auto *indices = slice_dof_indices_.data() + offset;
+          const auto *shape_values = slice_shape_values_.data() + offset;
+          for (unsigned int f = 0; f < fields.size(); ++f) {
+            Number value = Number(0.);
+            for (unsigned int k = 0; k < dofs_per_cell; ++k)
+              value += fields[f]->local_element(indices[k]) * shape_values[k];
+            patch.data(f, v) = value;
+          }
+          offset += dofs_per_cell;
+        }
+      }
 
-        for (const auto &function : level_set_functions) {
+      auto surface_out = std::make_shared<SurfaceOutput<slice_dim, dim>>(
+          std::move(patches), field_names);
+      surface_out->set_flags(flags);
 
-          unsigned int above = 0;
-          unsigned int below = 0;
+      if (asynchronous_writeback_) {
+        staged_surfaces.emplace_back(std::move(surface_out),
+                                     name + "-levelsets");
+      } else if (use_mpi_io_) {
+        /* MPI-based synchronous IO */
+        surface_out->write_vtu_in_parallel(
+            name + "-levelsets_" + Utilities::to_string(cycle, 6) + ".vtu",
+            mpi_ensemble_.ensemble_communicator());
+      } else {
+        surface_out->write_vtu_with_pvtu_record(
+            "",
+            name + "-levelsets",
+            cycle,
+            mpi_ensemble_.ensemble_communicator(),
+            6,
+            n_groups);
+      }
 
-          for (unsigned int v : cell->vertex_indices()) {
-            const auto vertex = cell->vertex(v);
-            constexpr auto eps = std::numeric_limits<Number>::epsilon();
-            if (function->value(vertex) >= 0. - 100. * eps)
-              above++;
-            if (function->value(vertex) <= 0. + 100. * eps)
-              below++;
-            if (above > 0 && below > 0)
-              return true;
-          }
-        }
-        return false;
-      });
+    } else if (output_levelsets && manifolds_.size() != 0) {
+      /*
+       * Only visit the cells in the vicinity of the manifolds that have
+       * been collected in prepare():
+       */
+
+      using cell_iterator = typename Triangulation<dim>::cell_iterator;
 
-      data_out->build_patches(mapping, patch_order);
+      auto data_out = make_data_out();
+      data_out->set_cell_selection(
+          [this](const Triangulation<dim> &triangulation) -> cell_iterator {
+            if (levelset_cells_.empty())
+              return triangulation.end();
+            return levelset_cells_.front();
+          },
+          [this](const Triangulation<dim> &triangulation,
+                 const cell_iterator &cell) -> cell_iterator {
+            const auto it = std::upper_bound(
+                levelset_cells_.begin(),
+                levelset_cells_.end(),
+                cell->active_cell_index(),
+                [](const auto index, const auto &entry) {
+                  return index < entry->active_cell_index();
+                });
+            if (it == levelset_cells_.end())
+              return triangulation.end();
+            return *it;
+          });
 
-      if (use_mpi_io_) {
+      build_patches(*data_out);
+
+      if (output_format_ == OutputFormat::hdf5) {
+        write_hdf5(*data_out, name + "-levelsets", t, cycle);
+      } else if (output_format_ == OutputFormat::catalyst) {
+        write_catalyst(*data_out, "levelsets", t, cycle);
+      } else if (asynchronous_writeback_) {
+        staged_outputs.emplace_back(std::move(data_out), name + "-levelsets");
+      } else if (use_mpi_io_) {
         /* MPI-based synchronous IO */
         data_out->write_vtu_in_parallel(
             name + "-levelsets_" + Utilities::to_string(cycle, 6) + ".vtu",
@@ -200,12 +869,212 @@ namespace ryujin
             name + "-levelsets",
             cycle,
             mpi_ensemble_.ensemble_communicator(),
-            6);
+            6,
+            n_groups);
       }
     }
 
-    /* Explicitly delete pointer to free up memory early: */
-    data_out.reset();
+    if (staged_outputs.empty() && staged_surfaces.empty())
+      return;
+
+    /*
+     * Write out one vtu file per rank and a pvtu record on rank 0. This
+     * mimics the file layout of write_vtu_with_pvtu_record() but does not
+     * require any MPI communication on the background thread.
+     */
+    const unsigned int rank = mpi_ensemble_.ensemble_rank();
+    const unsigned int n_ranks = mpi_ensemble_.n_ensemble_ranks();
+
+    pending_writes_.emplace_back(std::async(
+        std::launch::async,
+        [staged_outputs, staged_surfaces, cycle, rank, n_ranks]() {
+          const auto n_digits = Utilities::needed_digits(n_ranks);
+
+          const auto write_out = [&](const auto &data_out,
+                                     const std::string &prefix) {
+            const auto base = prefix + "_" + Utilities::to_string(cycle, 6);
+            const auto vtu_name = [&](const unsigned int r) {
+              return base + "." + Utilities::to_string(r, n_digits) + ".vtu";
+            };
+
+            std::ofstream output(vtu_name(rank));
+            data_out->write_vtu(output);
+
+            if (rank == 0) {
+              std::vector<std::string> filenames;
+              for (unsigned int r = 0; r < n_ranks; ++r)
+                filenames.push_back(
+                    std::filesystem::path(vtu_name(r)).filename().string());
+
+              std::ofstream record(base + ".pvtu");
+              data_out->write_pvtu_record(record, filenames);
+            }
+          };
+
+          for (const auto &[data_out, prefix] : staged_outputs)
+            write_out(data_out, prefix);
+          for (const auto &[surface_out, prefix] : staged_surfaces)
+            write_out(surface_out, prefix);
+        }));
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Number VTUOutput<Description, dim, Number>::output_tolerance(
+      const std::string &quantity) const
+  {
+    const auto it = std::find_if(
+        std::begin(output_tolerances_),
+        std::end(output_tolerances_),
+        [&](const auto &entry) { return entry.first == quantity; });
+    return it == std::end(output_tolerances_) ? Number(0.) : it->second;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void VTUOutput<Description, dim, Number>::write_hdf5(
+      [[maybe_unused]] const dealii::DataOut<dim> &data_out,
+      [[maybe_unused]] const std::string &name,
+      [[maybe_unused]] Number t,
+      [[maybe_unused]] unsigned int cycle)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "VTUOutput<dim, Number>::write_hdf5()" << std::endl;
+#endif
+
+#ifdef DEAL_II_WITH_HDF5
+    const auto &mpi_communicator = mpi_ensemble_.ensemble_communicator();
+
+    /*
+     * We do not filter duplicate vertices so that discontinuous fields
+     * are represented faithfully:
+     */
+    DataOutBase::DataOutFilter data_filter(
+        DataOutBase::DataOutFilterFlags(false, true));
+    data_out.write_filtered_data(data_filter);
+
+    const auto solution_filename =
+        name + "_" + Utilities::to_string(cycle, 6) + ".h5";
+
+    /* Only write the mesh geometry for the first output on a new mesh: */
+    auto [it, write_mesh_file] = hdf5_mesh_files_.try_emplace(
+        name, name + "-mesh_" + Utilities::to_string(cycle, 6) + ".h5");
+    const auto &mesh_filename = it->second;
+
+    data_out.write_hdf5_parallel(data_filter,
+                                 write_mesh_file,
+                                 mesh_filename,
+                                 solution_filename,
+                                 mpi_communicator);
+
+    auto &entries = xdmf_entries_[name];
+    entries.push_back(data_out.create_xdmf_entry(
+        data_filter, mesh_filename, solution_filename, t, mpi_communicator));
+
+    data_out.write_xdmf_file(entries, name + ".xdmf", mpi_communicator);
+#endif
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void VTUOutput<Description, dim, Number>::write_catalyst(
+      [[maybe_unused]] const dealii::DataOut<dim> &data_out,
+      [[maybe_unused]] const std::string &name,
+      [[maybe_unused]] Number t,
+      [[maybe_unused]] unsigned int cycle)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "VTUOutput<dim, Number>::write_catalyst()" << std::endl;
+#endif
+
+#ifdef WITH_CATALYST
+    if (!catalyst_initialized_) {
+      conduit_cpp::Node node;
+      for (unsigned int i = 0; i < catalyst_scripts_.size(); ++i)
+        node["catalyst/scripts/script" + std::to_string(i)].set(
+            catalyst_scripts_[i]);
+      node["catalyst_load/implementation"].set("paraview");
+
+      const auto status = catalyst_initialize(conduit_cpp::c_node(&node));
+      AssertThrow(status == catalyst_status_ok,
+                  dealii::ExcMessage("Failed to initialize Catalyst"));
+      catalyst_initialized_ = true;
+    }
+
+    /*
+     * Flatten patches into a list of (duplicated) vertices and cells. The
+     * filter stores cells in VTK ordering, which is what the Conduit mesh
+     * blueprint expects:
+     */
+
+    DataOutBase::DataOutFilter data_filter(
+        DataOutBase::DataOutFilterFlags(false, false));
+    data_out.write_filtered_data(data_filter);
+
+    const auto n_nodes = data_filter.n_nodes();
+    std::vector<double> node_data;
+    data_filter.fill_node_data(node_data);
+
+    std::vector<unsigned int> cell_data;
+    data_filter.fill_cell_data(0, cell_data);
+
+    /*
+     * Describe the mesh and all fields with the Conduit mesh blueprint.
+     * All arrays are passed by reference (set_external()), i.e., no copy
+     * is made:
+     */
+
+    conduit_cpp::Node node;
+    node["catalyst/state/timestep"].set(cycle);
+    node["catalyst/state/time"].set(static_cast<double>(t));
+
+    auto channel = node["catalyst/channels/" + name];
+    channel["type"].set("mesh");
+
+    auto mesh = channel["data"];
+    mesh["coordsets/coords/type"].set("explicit");
+
+    constexpr std::array<const char *, 3> coordinates{"x", "y", "z"};
+    for (unsigned int d = 0; d < dim; ++d)
+      mesh["coordsets/coords/values/" + std::string(coordinates[d])]
+          .set_external(node_data.data(),
+                        n_nodes,
+                        d * sizeof(double),
+                        dim * sizeof(double));
+
+    constexpr std::array<const char *, 3> shapes{"line", "quad", "hex"};
+    mesh["topologies/mesh/type"].set("unstructured");
+    mesh["topologies/mesh/coordset"].set("coords");
+    mesh["topologies/mesh/elements/shape"].set(shapes[dim - 1]);
+    mesh["topologies/mesh/elements/connectivity"].set_external(
+        cell_data.data(), cell_data.size());
+
+    for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i) {
+      auto field = mesh["fields/" + data_filter.get_data_set_name(i)];
+      field["association"].set("vertex");
+      field["topology"].set("mesh");
+
+      const auto n_components = data_filter.get_data_set_dim(i);
+      Assert(n_components <= 3, dealii::ExcNotImplemented());
+      /* get_data_set() returns a const pointer: */
+      auto *data = const_cast<double *>(data_filter.get_data_set(i));
+
+      if (n_components == 1) {
+        field["values"].set_external(data, n_nodes);
+      } else {
+        for (unsigned int d = 0; d < n_components; ++d)
+          field["values/" + std::string(coordinates[d])].set_external(
+              data,
+              n_nodes,
+              d * sizeof(double),
+              n_components * sizeof(double));
+      }
+    }
+
+    const auto status = catalyst_execute(conduit_cpp::c_node(&node));
+    AssertThrow(status == catalyst_status_ok,
+                dealii::ExcMessage("Catalyst execute failed"));
+#endif
   }
 
 } /* namespace ryujin */
@@ -0,0 +1,153 @@
+#include <buddy_checkpoint.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <iostream>
+#include <memory>
+
+/*
+ * Store and recover a buddy checkpoint of a distributed vector:
+ *  - every rank recovers its own copy,
+ *  - some (or all) ranks have lost their copy and receive it back from
+ *    the partner rank,
+ *  - recovering into a vector with a different partition throws.
+ */
+
+using Vector = dealii::LinearAlgebra::distributed::Vector<double>;
+
+Vector create_vector(const unsigned int n_extra)
+{
+  const auto n_ranks = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const auto rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  /* Rank r owns 3 + r + n_extra (on the last rank) entries: */
+  unsigned int size = 0;
+  unsigned int begin = 0;
+  for (unsigned int r = 0; r < n_ranks; ++r) {
+    const unsigned int local_size = 3 + r + (r + 1 == n_ranks ? n_extra : 0);
+    if (r == rank)
+      begin = size;
+    size += local_size;
+  }
+  const unsigned int local_size =
+      3 + rank + (rank + 1 == n_ranks ? n_extra : 0);
+
+  dealii::IndexSet locally_owned(size);
+  locally_owned.add_range(begin, begin + local_size);
+
+  const auto partitioner =
+      std::make_shared<dealii::Utilities::MPI::Partitioner>(
+          locally_owned, dealii::IndexSet(size), MPI_COMM_WORLD);
+
+  Vector vector;
+  vector.reinit(partitioner);
+  return vector;
+}
+
+
+void fill(Vector &vector, const double offset)
+{
+  const auto rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const auto local_size = vector.get_partitioner()->locally_owned_size();
+  for (unsigned int i = 0; i < local_size; ++i)
+    vector.local_element(i) = offset + 100. * rank + i;
+}
+
+
+bool check(const Vector &vector,
+           const double offset,
+           const double t,
+           const unsigned int output_cycle,
+           const double t_expected,
+           const unsigned int output_cycle_expected)
+{
+  const auto rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const auto local_size = vector.get_partitioner()->locally_owned_size();
+
+  bool success = (t == t_expected) && (output_cycle == output_cycle_expected);
+  for (unsigned int i = 0; i < local_size; ++i)
+    success &= vector.local_element(i) == offset + 100. * rank + i;
+
+  return dealii::Utilities::MPI::logical_and(success, MPI_COMM_WORLD);
+}
+
+
+void print(const bool success)
+{
+  if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    std::cout << (success ? "OK" : "FAILED") << std::endl;
+}
+
+
+void test(const unsigned int stride)
+{
+  const auto n_ranks = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const auto rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  ryujin::BuddyCheckpoint<double> buddy_checkpoint;
+  buddy_checkpoint.reinit(MPI_COMM_WORLD, stride);
+
+  auto vector = create_vector(0);
+
+  double t = 0.;
+  unsigned int output_cycle = 0;
+
+  /* Recover the own copy: */
+  {
+    fill(vector, 0.);
+    buddy_checkpoint.store(vector, 1.5, 7);
+    fill(vector, -1000.);
+    buddy_checkpoint.recover(vector, t, output_cycle);
+    print(buddy_checkpoint.valid() &&
+          check(vector, 0., t, output_cycle, 1.5, 7));
+  }
+
+  /* The last rank recovers from its partner: */
+  {
+    fill(vector, 1000.);
+    buddy_checkpoint.store(vector, 2.5, 8);
+    fill(vector, -1000.);
+    buddy_checkpoint.recover(vector, t, output_cycle, rank + 1 == n_ranks);
+    print(check(vector, 1000., t, output_cycle, 2.5, 8));
+  }
+
+  /* All ranks recover from their partner: */
+  {
+    fill(vector, 2000.);
+    buddy_checkpoint.store(vector, 3.5, 9);
+    fill(vector, -1000.);
+    buddy_checkpoint.recover(vector, t, output_cycle, true);
+    print(check(vector, 2000., t, output_cycle, 3.5, 9));
+  }
+
+  /* A checkpoint of a different partition is rejected: */
+  {
+    auto other_vector = create_vector(2);
+    bool thrown = false;
+    try {
+      buddy_checkpoint.recover(other_vector, t, output_cycle);
+    } catch (const dealii::ExceptionBase &) {
+      thrown = true;
+    }
+    print(dealii::Utilities::MPI::logical_and(thrown == (rank + 1 == n_ranks),
+                                              MPI_COMM_WORLD));
+  }
+
+  buddy_checkpoint.clear();
+  print(!buddy_checkpoint.valid());
+}
+
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv);
+
+  const auto n_ranks = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  /* Partner on the next rank, two ranks ahead, and a local only copy: */
+  test(1);
+  test(2);
+  test(n_ranks);
+}
@@ -0,0 +1,105 @@
+#include <local_index_handling.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <iostream>
+
+/*
+ * Check that the threaded cell loop of make_extended_sparsity_pattern()
+ * and make_extended_sparsity_pattern_dg() yields the same pattern as the
+ * serial loop (with a thread limit of one). The cG variant is checked on
+ * an adaptively refined mesh with hanging node constraints.
+ */
+
+using namespace dealii;
+
+constexpr int dim = 2;
+
+template <typename Callable>
+bool compare(const DoFHandler<dim> &dof_handler,
+             const AffineConstraints<double> &affine_constraints,
+             const Callable &make_pattern)
+{
+  IndexSet locally_relevant;
+  ryujin::DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                                  locally_relevant);
+
+  const auto n_dofs = dof_handler.n_dofs();
+
+  MultithreadInfo::set_thread_limit(1);
+  DynamicSparsityPattern serial(n_dofs, n_dofs, locally_relevant);
+  make_pattern(dof_handler, serial, affine_constraints, false);
+
+  MultithreadInfo::set_thread_limit();
+  DynamicSparsityPattern threaded(n_dofs, n_dofs, locally_relevant);
+  make_pattern(dof_handler, threaded, affine_constraints, false);
+
+  bool success = serial.n_nonzero_elements() == threaded.n_nonzero_elements();
+  for (const auto row : locally_relevant) {
+    const auto row_length = serial.row_length(row);
+    success &= threaded.row_length(row) == row_length;
+    if (!success)
+      break;
+    for (unsigned int k = 0; k < row_length; ++k)
+      success &=
+          serial.column_number(row, k) == threaded.column_number(row, k);
+  }
+
+  return Utilities::MPI::logical_and(success, MPI_COMM_WORLD);
+}
+
+
+int main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv);
+
+  parallel::distributed::Triangulation<dim> triangulation(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(triangulation);
+  triangulation.refine_global(3);
+
+  const auto print = [](const bool success) {
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+      std::cout << (success ? "OK" : "FAILED") << std::endl;
+  };
+
+  {
+    const FE_DGQ<dim> finite_element(1);
+    DoFHandler<dim> dof_handler(triangulation);
+    dof_handler.distribute_dofs(finite_element);
+
+    AffineConstraints<double> affine_constraints;
+    affine_constraints.close();
+
+    print(compare(dof_handler, affine_constraints, [](auto &&...args) {
+      ryujin::DoFTools::make_extended_sparsity_pattern_dg(args...);
+    }));
+  }
+
+  /* Refine locally to create hanging nodes: */
+  for (const auto &cell : triangulation.active_cell_iterators())
+    if (cell->is_locally_owned() && cell->center()[0] < 0.3)
+      cell->set_refine_flag();
+  triangulation.execute_coarsening_and_refinement();
+
+  {
+    const FE_Q<dim> finite_element(1);
+    DoFHandler<dim> dof_handler(triangulation);
+    dof_handler.distribute_dofs(finite_element);
+
+    IndexSet locally_relevant;
+    ryujin::DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                                    locally_relevant);
+    AffineConstraints<double> affine_constraints(locally_relevant);
+    ryujin::DoFTools::make_hanging_node_constraints(dof_handler,
+                                                    affine_constraints);
+    affine_constraints.close();
+
+    print(compare(dof_handler, affine_constraints, [](auto &&...args) {
+      ryujin::DoFTools::make_extended_sparsity_pattern(args...);
+    }));
+  }
+}
@@ -0,0 +1,92 @@
+#include <simd.h>
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+/*
+ * Sweep over a range of arguments x and exponents b and verify that the
+ * biased variants of fast_pow() bound pow() from above (Bias::max) and
+ * from below (Bias::min), as documented for ryujin::Bias.
+ */
+
+int main()
+{
+  using VA = dealii::VectorizedArray<double>;
+  constexpr auto simd_width = VA::size();
+
+  bool success = true;
+
+  const auto check = [&](const double x,
+                         const double b,
+                         const double reference,
+                         const double upper,
+                         const double lower,
+                         const char *variant) {
+    if (upper < reference || lower > reference) {
+      std::cout << variant << ": x = " << x << ", b = " << b
+                << ", pow = " << reference << ", max = " << upper
+                << ", min = " << lower << std::endl;
+      success = false;
+    }
+  };
+
+  /* Only check results in the normal single precision range: */
+  const auto in_range = [](const double value) {
+    return value >= double(std::numeric_limits<float>::min()) &&
+           value <= double(std::numeric_limits<float>::max());
+  };
+
+  for (int k = -300; k <= 300; ++k) {
+    const double x = std::pow(10., k / 50.) * (1. + 0.001 * (k % 7));
+
+    for (int l = -200; l <= 200; ++l) {
+      const double b = l / 20.;
+
+      const double reference = std::pow(x, b);
+      if (!in_range(reference))
+        continue;
+
+      /* Scalar double precision: */
+      check(x,
+            b,
+            reference,
+            ryujin::fast_pow(x, b, ryujin::Bias::max),
+            ryujin::fast_pow(x, b, ryujin::Bias::min),
+            "double");
+
+      /* Scalar single precision: */
+      const float x_f = float(x);
+      const float b_f = float(b);
+      const double reference_f = std::pow(double(x_f), double(b_f));
+      if (in_range(reference_f))
+        check(x_f,
+              b_f,
+              reference_f,
+              ryujin::fast_pow(x_f, b_f, ryujin::Bias::max),
+              ryujin::fast_pow(x_f, b_f, ryujin::Bias::min),
+              "float");
+
+      /* Vectorized, with scalar and vectorized exponent: */
+      VA x_v, b_v;
+      for (unsigned int i = 0; i < simd_width; ++i) {
+        x_v[i] = x * (1. + 0.01 * i);
+        b_v[i] = b;
+      }
+
+      const auto upper = ryujin::fast_pow(x_v, b, ryujin::Bias::max);
+      const auto lower = ryujin::fast_pow(x_v, b, ryujin::Bias::min);
+      const auto upper_v = ryujin::fast_pow(x_v, b_v, ryujin::Bias::max);
+      const auto lower_v = ryujin::fast_pow(x_v, b_v, ryujin::Bias::min);
+      for (unsigned int i = 0; i < simd_width; ++i) {
+        const double reference_v = std::pow(x_v[i], b);
+        if (!in_range(reference_v))
+          continue;
+        check(x_v[i], b, reference_v, upper[i], lower[i], "VA");
+        check(x_v[i], b, reference_v, upper_v[i], lower_v[i], "VA, VA");
+      }
+    }
+  }
+
+  std::cout << (success ? "OK" : "FAILED") << std::endl;
+}
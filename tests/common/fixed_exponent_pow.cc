@@ -0,0 +1,111 @@
+#include <simd_fixed_exponent_pow.h>
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+/*
+ * Sweep over a range of arguments x and fixed exponents b and verify that
+ * FixedExponentPow is accurate to within tolerance() and that the biased
+ * variants bound pow() from above (Bias::max) and from below (Bias::min).
+ */
+
+template <typename Number>
+bool test()
+{
+  using VA = dealii::VectorizedArray<Number>;
+  constexpr auto simd_width = VA::size();
+
+  bool success = true;
+
+  const auto check = [&](const double x,
+                         const double b,
+                         const double reference,
+                         const double value,
+                         const double upper,
+                         const double lower,
+                         const double tolerance,
+                         const char *variant) {
+    const double error = std::abs(value - reference) / reference;
+    if (error > tolerance || upper < reference || lower > reference) {
+      std::cout << variant << ": x = " << x << ", b = " << b
+                << ", pow = " << reference << ", value = " << value
+                << ", max = " << upper << ", min = " << lower << std::endl;
+      success = false;
+    }
+  };
+
+  /* Only check results in the normal range of Number: */
+  const auto in_range = [](const double value) {
+    return value >= double(std::numeric_limits<Number>::min()) &&
+           value <= double(std::numeric_limits<Number>::max());
+  };
+
+  /* Exponents (gamma - 1) / (2 gamma) and friends and a sweep: */
+  std::vector<double> exponents;
+  for (const double gamma : {1.4, 5. / 3., 1.2, 1.1, 3.}) {
+    exponents.push_back((gamma - 1.) / (2. * gamma));
+    exponents.push_back(-(gamma - 1.) / (2. * gamma));
+    exponents.push_back(2. * gamma / (gamma - 1.));
+    exponents.push_back(1. / gamma);
+    exponents.push_back(gamma);
+  }
+  for (int l = -200; l <= 200; ++l)
+    exponents.push_back(l / 20.);
+
+  for (const double exponent : exponents) {
+    const Number b = Number(exponent);
+    const ryujin::FixedExponentPow<Number> fixed_pow(b);
+    const double tolerance = fixed_pow.tolerance();
+
+    for (int k = -1900; k <= 1900; ++k) {
+      const Number x = Number(std::pow(10., k / 50.) * (1. + 0.001 * (k % 7)));
+      if (!(x >= std::numeric_limits<float>::min() &&
+            x <= std::numeric_limits<float>::max()))
+        continue;
+
+      const double reference = std::pow(double(x), double(b));
+      if (in_range(reference))
+        check(x,
+              b,
+              reference,
+              fixed_pow(x),
+              fixed_pow(x, ryujin::Bias::max),
+              fixed_pow(x, ryujin::Bias::min),
+              tolerance,
+              "scalar");
+
+      VA x_v;
+      for (unsigned int i = 0; i < simd_width; ++i)
+        x_v[i] = x * Number(1. + 0.01 * i);
+
+      const auto value = fixed_pow(x_v);
+      const auto upper = fixed_pow(x_v, ryujin::Bias::max);
+      const auto lower = fixed_pow(x_v, ryujin::Bias::min);
+      for (unsigned int i = 0; i < simd_width; ++i) {
+        const double reference_v = std::pow(double(x_v[i]), double(b));
+        if (!in_range(reference_v) ||
+            !(x_v[i] <= std::numeric_limits<float>::max()))
+          continue;
+        check(x_v[i],
+              b,
+              reference_v,
+              value[i],
+              upper[i],
+              lower[i],
+              tolerance,
+              "VA");
+      }
+    }
+  }
+
+  return success;
+}
+
+
+int main()
+{
+  std::cout << "double: " << (test<double>() ? "OK" : "FAILED") << std::endl;
+  std::cout << "float:  " << (test<float>() ? "OK" : "FAILED") << std::endl;
+}
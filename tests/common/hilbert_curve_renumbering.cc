@@ -0,0 +1,68 @@
+#include <local_index_handling.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <iostream>
+
+/*
+ * Check that DoFRenumbering::hilbert_curve() only permutes the locally
+ * owned index range and orders the degrees of freedom along the Hilbert
+ * curve through their support points.
+ */
+
+using namespace dealii;
+
+constexpr int dim = 2;
+
+bool check(DoFHandler<dim> &dof_handler, const Mapping<dim> &mapping)
+{
+  const IndexSet locally_owned = dof_handler.locally_owned_dofs();
+  ryujin::DoFRenumbering::hilbert_curve(dof_handler, mapping);
+  bool success = dof_handler.locally_owned_dofs() == locally_owned;
+
+  /* The support points in the new numbering are sorted along the curve: */
+  std::map<types::global_dof_index, Point<dim>> support_points;
+  DoFTools::map_dofs_to_support_points(mapping, dof_handler, support_points);
+
+  std::vector<Point<dim>> points;
+  for (const auto &[index, point] : support_points)
+    if (locally_owned.is_element(index))
+      points.push_back(point);
+  success &= points.size() == locally_owned.n_elements();
+
+  constexpr int bits_per_dim = 64 / dim;
+  const auto indices =
+      Utilities::inverse_Hilbert_space_filling_curve(points, bits_per_dim);
+
+  std::vector<std::uint64_t> keys;
+  for (const auto &index : indices)
+    keys.push_back(Utilities::pack_integers<dim>(index, bits_per_dim));
+  success &= std::is_sorted(keys.begin(), keys.end());
+
+  return success;
+}
+
+
+int main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv);
+
+  parallel::distributed::Triangulation<dim> triangulation(MPI_COMM_WORLD);
+  GridGenerator::hyper_ball(triangulation);
+  triangulation.refine_global(3);
+
+  const MappingQ<dim> mapping(1);
+  const FE_Q<dim> finite_element(2);
+
+  DoFHandler<dim> dof_handler(triangulation);
+  dof_handler.distribute_dofs(finite_element);
+
+  const bool success =
+      Utilities::MPI::logical_and(check(dof_handler, mapping), MPI_COMM_WORLD);
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    std::cout << (success ? "OK" : "FAILED") << std::endl;
+}
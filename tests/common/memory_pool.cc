@@ -0,0 +1,120 @@
+#include <memory_pool.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace ryujin;
+
+int main()
+{
+  constexpr std::size_t MB = 1 << 20;
+
+  std::cout << "Size classes" << std::endl;
+  for (const std::size_t size : {std::size_t(1),
+                                 std::size_t(65),
+                                 std::size_t(1000),
+                                 MB - 1,
+                                 MB,
+                                 MB + 1,
+                                 5 * MB / 4,
+                                 5 * MB / 4 + 1,
+                                 3 * MB,
+                                 7 * MB + 1,
+                                 8 * MB})
+    std::cout << size << " -> " << MemoryPool::size_class(size) << std::endl;
+
+  auto &pool = MemoryPool::instance();
+  std::cout << "enabled: " << pool.enabled() << std::endl;
+  pool.set_cache_size(16 * MB);
+  std::cout << "enabled: " << pool.enabled() << std::endl;
+
+  std::cout << "Recycling" << std::endl;
+  {
+    bool recycled;
+    const auto [pointer, capacity] = pool.allocate(3 * MB, recycled);
+    std::cout << capacity << " " << recycled << std::endl;
+    pool.deallocate(pointer, capacity);
+    std::cout << pool.n_cached_bytes() << std::endl;
+
+    /* Same size class, served from the cache: */
+    const auto [pointer_2, capacity_2] = pool.allocate(3 * MB - 100, recycled);
+    std::cout << capacity_2 << " " << recycled << " " << (pointer_2 == pointer)
+              << " " << pool.n_cached_bytes() << std::endl;
+
+    /* More than one size class of slack, not served from the cache: */
+    pool.deallocate(pointer_2, capacity_2);
+    const auto [pointer_3, capacity_3] = pool.allocate(MB, recycled);
+    std::cout << capacity_3 << " " << recycled << " " << pool.n_cached_bytes()
+              << std::endl;
+    pool.deallocate(pointer_3, capacity_3);
+  }
+
+  std::cout << "Cache trim limit" << std::endl;
+  {
+    pool.set_cache_size(0);
+    pool.set_cache_size(16 * MB);
+    std::cout << pool.n_cached_bytes() << std::endl;
+
+    bool recycled;
+    std::vector<std::pair<void *, std::size_t>> blocks;
+    for (const auto size : {8 * MB, 8 * MB, 4 * MB})
+      blocks.push_back(pool.allocate(size, recycled));
+    for (const auto &[pointer, capacity] : blocks) {
+      pool.deallocate(pointer, capacity);
+      std::cout << pool.n_cached_bytes() << std::endl;
+    }
+
+    pool.set_cache_size(4 * MB);
+    std::cout << pool.n_cached_bytes() << std::endl;
+    pool.set_cache_size(0);
+    std::cout << pool.n_cached_bytes() << " " << pool.enabled() << std::endl;
+  }
+
+  std::cout << "PooledVector::resize_fast()" << std::endl;
+  {
+    pool.set_cache_size(64 * MB);
+
+    PooledVector<double> v;
+    v.resize(MB);
+    std::cout << v.size() << " " << v.recycled() << std::endl;
+    for (unsigned int k = 0; k < 1000; ++k)
+      v[k] = double(k);
+    const double *data = v.data();
+
+    /* Shrink within the size class: in place */
+    v.resize_fast(MB - 1000);
+    std::cout << v.size() << " " << v.recycled() << " " << (v.data() == data)
+              << std::endl;
+
+    /* Shrink by more than a size class: reallocate and preserve */
+    v.resize_fast(MB / 4);
+    bool preserved = true;
+    for (unsigned int k = 0; k < 1000; ++k)
+      preserved &= v[k] == double(k);
+    std::cout << v.size() << " " << v.recycled() << " " << (v.data() == data)
+              << " " << preserved << " " << pool.n_cached_bytes() << std::endl;
+
+    /* The released block is served from the cache: */
+    PooledVector<double> w;
+    w.resize_fast(MB);
+    std::cout << w.size() << " " << w.recycled() << " " << (w.data() == data)
+              << " " << pool.n_cached_bytes() << std::endl;
+
+    std::cout << "PooledVector::set_external_storage()" << std::endl;
+
+    std::vector<double> external(10, 1.);
+    v.resize(10);
+    v.set_external_storage(external.data());
+    std::cout << v.external() << " " << (v.data() == external.data()) << " "
+              << v.recycled() << " " << (v.memory_consumption() == sizeof(v))
+              << std::endl;
+
+    /* Resizing moves the vector back to a block of its own: */
+    v.resize(20);
+    std::cout << v.external() << " " << (v.data() == external.data()) << " "
+              << v[0] << " " << v[15] << " " << external[0] << std::endl;
+  }
+
+  pool.set_cache_size(0);
+  std::cout << "OK" << std::endl;
+}
@@ -0,0 +1,113 @@
+#include <discretization.h>
+#include <mpi_ensemble.h>
+#include <offline_data.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parameter_acceptor.h>
+
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/*
+ * Prepare the offline data twice with the "cache directory" set: The
+ * first call assembles and populates the cache, the second call has to
+ * read the cache entry and has to produce identical dof indices and
+ * matrices.
+ */
+
+using namespace ryujin;
+
+constexpr int dim = 2;
+
+std::vector<double> snapshot(const OfflineData<dim, double> &offline_data)
+{
+  std::vector<double> result;
+
+  for (const auto &cell : offline_data.dof_handler().active_cell_iterators()) {
+    if (!cell->is_locally_owned())
+      continue;
+    std::vector<dealii::types::global_dof_index> dof_indices(
+        cell->get_fe().n_dofs_per_cell());
+    cell->get_dof_indices(dof_indices);
+    result.insert(result.end(), dof_indices.begin(), dof_indices.end());
+  }
+
+  result.push_back(offline_data.n_locally_internal());
+  result.push_back(offline_data.n_export_indices());
+  result.push_back(offline_data.boundary_map().size());
+  result.push_back(offline_data.measure_of_omega());
+
+  const auto &sparsity_simd = offline_data.sparsity_pattern_simd();
+  for (unsigned int i = 0; i < offline_data.n_locally_owned(); ++i) {
+    result.push_back(offline_data.lumped_mass_matrix().local_element(i));
+    for (unsigned int col = 0; col < sparsity_simd.row_length(i); ++col) {
+      result.push_back(offline_data.mass_matrix().get_entry(i, col));
+      result.push_back(offline_data.mass_matrix_inverse().get_entry(i, col));
+      const auto c_ij = offline_data.cij_matrix().get_tensor(i, col);
+      for (unsigned int d = 0; d < dim; ++d)
+        result.push_back(c_ij[d]);
+    }
+  }
+
+  return result;
+}
+
+
+bool has_phase(const OfflineData<dim, double> &offline_data,
+               const std::string &phase)
+{
+  for (const auto &[name, high_water_mark] :
+       offline_data.memory_high_water_marks())
+    if (name == phase)
+      return true;
+  return false;
+}
+
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv);
+
+  const std::string cache_directory = "offline_data_cache";
+  if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    std::filesystem::remove_all(cache_directory);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  MPIEnsemble mpi_ensemble(MPI_COMM_WORLD);
+  Discretization<dim> discretization(mpi_ensemble, "/Discretization");
+  OfflineData<dim, double> offline_data(
+      mpi_ensemble, discretization, "/OfflineData");
+
+  std::stringstream parameters;
+  parameters << "subsection Discretization\n"
+             << "  set geometry        = rectangular domain\n"
+             << "  set mesh refinement = 3\n"
+             << "  set mesh writeout   = false\n"
+             << "end\n"
+             << "subsection OfflineData\n"
+             << "  set cache directory = " << cache_directory << "\n"
+             << "end\n";
+  dealii::ParameterAcceptor::initialize(parameters);
+
+  discretization.prepare("offline_data_cache");
+
+  offline_data.prepare(/*problem_dimension*/ 4,
+                       /*n_precomputed_values*/ 1,
+                       /*n_parabolic_state_vectors*/ 0);
+  const auto assembled = snapshot(offline_data);
+  const bool assembled_phase = has_phase(offline_data, "assemble");
+
+  offline_data.prepare(/*problem_dimension*/ 4,
+                       /*n_precomputed_values*/ 1,
+                       /*n_parabolic_state_vectors*/ 0);
+  const auto cached = snapshot(offline_data);
+  const bool cached_phase = has_phase(offline_data, "read cache");
+
+  const bool success = dealii::Utilities::MPI::logical_and(
+      assembled_phase && cached_phase && assembled == cached, MPI_COMM_WORLD);
+
+  if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    std::cout << (success ? "OK" : "FAILED") << std::endl;
+}
@@ -0,0 +1,120 @@
+#include <simd.h>
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <iostream>
+#include <vector>
+
+/*
+ * Compute the products y = A x and y = A^T x with the SIMD layout of a
+ * given width (vectorized over all internal rows). All values are small
+ * integers, so the results have to be identical for all widths.
+ */
+template <int width>
+std::vector<double> products(const dealii::DynamicSparsityPattern &spars,
+                             const dealii::IndexSet &locally_owned)
+{
+  using VA = dealii::VectorizedArray<double, width>;
+
+  const unsigned int n = spars.n_rows();
+  const unsigned int n_internal = (12 / width) * width;
+
+  auto partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+      locally_owned, dealii::IndexSet(n), MPI_COMM_SELF);
+  ryujin::SparsityPatternSIMD<width> sparsity(n_internal, spars, partitioner);
+  ryujin::SparseMatrixSIMD<double, 1, width> matrix(sparsity);
+
+  unsigned int js_buffer[width];
+
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < sparsity.row_length(i); ++j) {
+      const auto column = *sparsity.columns(i, j, js_buffer);
+      matrix.write_entry(double(1 + 3 * i + column), i, j);
+    }
+
+  std::vector<double> x(n);
+  for (unsigned int i = 0; i < n; ++i)
+    x[i] = double(i % 7 + 1);
+
+  std::vector<double> result(2 * n);
+
+  unsigned int i = 0;
+  for (; i < n_internal; i += width) {
+    VA y;
+    VA y_transposed;
+    y = 0.;
+    y_transposed = 0.;
+    for (unsigned int j = 0; j < sparsity.row_length(i); ++j) {
+      const unsigned int *js = sparsity.columns(i, j, js_buffer);
+      VA x_j;
+      for (unsigned int k = 0; k < width; ++k)
+        x_j[k] = x[js[k]];
+      y += matrix.template get_entry<VA>(i, j) * x_j;
+      y_transposed += matrix.template get_transposed_entry<VA>(i, j) * x_j;
+    }
+    for (unsigned int k = 0; k < width; ++k) {
+      result[i + k] = y[k];
+      result[n + i + k] = y_transposed[k];
+    }
+  }
+
+  for (; i < n; ++i) {
+    for (unsigned int j = 0; j < sparsity.row_length(i); ++j) {
+      const auto x_j = x[*sparsity.columns(i, j, js_buffer)];
+      result[i] += matrix.get_entry(i, j) * x_j;
+      result[n + i] += matrix.get_transposed_entry(i, j) * x_j;
+    }
+  }
+
+  return result;
+}
+
+
+/*
+ * Compare all widths 2, 4, ... up to the native width against width 1:
+ */
+template <int width>
+bool compare(const dealii::DynamicSparsityPattern &spars,
+             const dealii::IndexSet &locally_owned,
+             const std::vector<double> &reference)
+{
+  if constexpr (width > dealii::VectorizedArray<double>::size()) {
+    return true;
+  } else {
+    const bool success = products<width>(spars, locally_owned) == reference;
+    return success && compare<2 * width>(spars, locally_owned, reference);
+  }
+}
+
+
+int main()
+{
+  constexpr auto width = ryujin::simd_width<double>;
+  static_assert(ryujin::VectorizedArrayType<double>::size() == width);
+
+  bool success = width <= dealii::VectorizedArray<double>::size();
+  success &= (width & (width - 1)) == 0;
+  std::cout << (success ? "OK" : "FAILED") << std::endl;
+
+  dealii::DynamicSparsityPattern spars(14, 14);
+  spars.add(0, 0);
+  spars.add(0, 1);
+  spars.add(0, 13);
+  for (unsigned int i = 1; i < 12; ++i) {
+    spars.add(i, i - 1);
+    spars.add(i, i);
+    spars.add(i, i + 1);
+  }
+  spars.add(12, 12);
+  spars.add(12, 11);
+  spars.add(13, 13);
+  spars.add(13, 0);
+  spars.compress();
+
+  dealii::IndexSet locally_owned(14);
+  locally_owned.add_range(0, 14);
+
+  const auto reference = products<1>(spars, locally_owned);
+  success = compare<2>(spars, locally_owned, reference);
+  std::cout << (success ? "OK" : "FAILED") << std::endl;
+}
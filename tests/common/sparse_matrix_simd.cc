@@ -1,6 +1,9 @@
 #include <sparse_matrix_simd.h>
 #include <sparse_matrix_simd.template.h>
 
+#include <array>
+#include <set>
+
 int main()
 {
   using VA = dealii::VectorizedArray<double>;
@@ -81,4 +84,98 @@ int main()
     std::cout << my_sparse.get_transposed_entry(i, 0) << " "
               << my_sparse.get_transposed_entry(i, 1) << " ";
   std::cout << std::endl;
+
+  unsigned int js_buffer[simd_width];
+
+  std::cout << "Symmetric storage" << std::endl;
+  {
+    ryujin::SymmetricSparseMatrixSIMD<double, simd_width> my_symmetric(
+        my_sparsity);
+
+    const auto value = [](const unsigned int i, const unsigned int j) {
+      return double(100 * std::min(i, j) + std::max(i, j));
+    };
+
+    /* Only write to the diagonal and the upper triangular part: */
+    for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i)
+      for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+        const auto column = *my_sparsity.columns(i, j, js_buffer);
+        if (column >= i)
+          my_symmetric.write_entry(value(i, column), i, j);
+      }
+
+    bool success = true;
+    for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i)
+      for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+        const auto column = *my_sparsity.columns(i, j, js_buffer);
+        success &= my_symmetric.get_entry(i, j) == value(i, column);
+        success &= my_symmetric.get_transposed_entry(i, j) == value(i, column);
+      }
+
+    for (i = 0; i < (12 / simd_width) * simd_width; i += simd_width)
+      for (unsigned int j = 0; j < 3; ++j) {
+        const auto a = my_symmetric.template get_entry<VA>(i, j);
+        const unsigned int *js = my_sparsity.columns(i, j, js_buffer);
+        for (unsigned int k = 0; k < simd_width; ++k)
+          success &= a[k] == value(i + k, js[k]);
+      }
+
+    std::cout << (success ? "OK" : "FAILED") << std::endl;
+  }
+
+  std::cout << "Column indices" << std::endl;
+  {
+    /*
+     * Couple the first and the last row so that the column delta is
+     * not representable in 16 bits (see COMPRESSED_COLUMN_INDICES):
+     */
+    constexpr unsigned int n = 70000;
+    constexpr unsigned int n_internal = (n / 2 / simd_width) * simd_width;
+
+    dealii::DynamicSparsityPattern spars(n, n);
+    for (unsigned int i = 0; i < n; ++i) {
+      spars.add(i, i);
+      spars.add(i, (i + n - 1) % n);
+      spars.add(i, (i + 1) % n);
+    }
+    spars.compress();
+
+    dealii::IndexSet locally_owned(n);
+    locally_owned.add_range(0, n);
+    dealii::IndexSet locally_relevant(n);
+    auto partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+        locally_owned, locally_relevant, MPI_COMM_SELF);
+
+    ryujin::SparsityPatternSIMD<simd_width> sparsity(
+        n_internal, spars, partitioner);
+
+    bool success = sparsity.n_rows() == n;
+    for (unsigned int i = 0; i < n; ++i) {
+      const unsigned int row_length = sparsity.row_length(i);
+      success &= row_length == spars.row_length(i);
+
+      std::set<unsigned int> columns;
+      for (unsigned int j = 0; j < row_length; ++j) {
+        const unsigned int *js = sparsity.columns(i, j, js_buffer);
+        success &= spars.exists(i, js[0]);
+        columns.insert(js[0]);
+      }
+      success &= columns.size() == row_length;
+      success &= *sparsity.columns(i, 0, js_buffer) == i;
+    }
+
+    /* SIMD access must agree with access lane by lane: */
+    for (unsigned int i = 0; i < n_internal; i += simd_width)
+      for (unsigned int j = 0; j < sparsity.row_length(i); ++j) {
+        const unsigned int *js = sparsity.columns(i, j, js_buffer);
+        std::array<unsigned int, simd_width> lanes;
+        std::copy(js, js + simd_width, lanes.begin());
+        for (unsigned int k = 0; k < simd_width; ++k) {
+          unsigned int lane_buffer[simd_width];
+          success &= *sparsity.columns(i + k, j, lane_buffer) == lanes[k];
+        }
+      }
+
+    std::cout << (success ? "OK" : "FAILED") << std::endl;
+  }
 }
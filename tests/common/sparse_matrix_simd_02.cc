@@ -0,0 +1,114 @@
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <cmath>
+#include <iostream>
+
+/*
+ * Check that a SparseMatrixSIMD with single precision storage (see the
+ * compile-time option MIXED_PRECISION_STORAGE) produces matrix-vector
+ * products that agree with double precision storage up to the expected
+ * float rounding error.
+ */
+
+int main()
+{
+  using VA = dealii::VectorizedArray<double>;
+  constexpr auto simd_width = VA::size();
+
+  constexpr unsigned int n = 64;
+  constexpr unsigned int n_internal = (48 / simd_width) * simd_width;
+
+  dealii::DynamicSparsityPattern spars(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = (i < 3 ? 0 : i - 3); j < std::min(n, i + 4); ++j)
+      spars.add(i, j);
+  spars.add(0, n - 1);
+  spars.add(n - 1, 0);
+  spars.compress();
+
+  dealii::IndexSet locally_owned(n);
+  locally_owned.add_range(0, n);
+  dealii::IndexSet locally_relevant(n);
+  auto partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+      locally_owned, locally_relevant, MPI_COMM_SELF);
+
+  ryujin::SparsityPatternSIMD<simd_width> sparsity(
+      n_internal, spars, partitioner);
+
+  ryujin::SparseMatrixSIMD<double, 1, simd_width, double> matrix_double(
+      sparsity);
+  ryujin::SparseMatrixSIMD<double, 1, simd_width, float> matrix_float(
+      sparsity);
+
+  unsigned int js_buffer[simd_width];
+
+  const auto value = [](const unsigned int i, const unsigned int j) {
+    return 1. / (1. + i + 2. * j) - 0.1 * std::sin(double(i * j));
+  };
+
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int col = 0; col < sparsity.row_length(i); ++col) {
+      const auto j = *sparsity.columns(i, col, js_buffer);
+      matrix_double.write_entry(value(i, j), i, col);
+      matrix_float.write_entry(value(i, j), i, col);
+    }
+
+  std::vector<double> x(n);
+  for (unsigned int j = 0; j < n; ++j)
+    x[j] = std::cos(0.3 * j) + 0.5;
+
+  bool success = true;
+
+  const auto check = [&](const unsigned int i,
+                         const double y_double,
+                         const double y_float,
+                         const double y_abs) {
+    /* Every entry is rounded with a relative error of at most 2^-24: */
+    const double tolerance = 2. * std::ldexp(1., -24) * y_abs;
+    if (std::abs(y_double - y_float) > tolerance) {
+      std::cout << "row " << i << ": |" << y_double << " - " << y_float
+                << "| > " << tolerance << std::endl;
+      success = false;
+    }
+  };
+
+  /* Vectorized SIMD rows: */
+  for (unsigned int i = 0; i < n_internal; i += simd_width) {
+    VA y_double = VA(0.), y_float = VA(0.), y_abs = VA(0.);
+    for (unsigned int col = 0; col < sparsity.row_length(i); ++col) {
+      const unsigned int *js = sparsity.columns(i, col, js_buffer);
+      VA x_j;
+      for (unsigned int k = 0; k < simd_width; ++k)
+        x_j[k] = x[js[k]];
+      const auto a_double = matrix_double.template get_entry<VA>(i, col);
+      const auto a_float = matrix_float.template get_entry<VA>(i, col);
+      y_double += a_double * x_j;
+      y_float += a_float * x_j;
+      y_abs += std::abs(a_double * x_j);
+    }
+    for (unsigned int k = 0; k < simd_width; ++k)
+      check(i + k, y_double[k], y_float[k], y_abs[k]);
+  }
+
+  /* Non-vectorized rows: */
+  for (unsigned int i = n_internal; i < n; ++i) {
+    double y_double = 0., y_float = 0., y_abs = 0.;
+    for (unsigned int col = 0; col < sparsity.row_length(i); ++col) {
+      const auto j = *sparsity.columns(i, col, js_buffer);
+      const auto a_double = matrix_double.get_entry(i, col);
+      const auto a_float = matrix_float.get_entry(i, col);
+      y_double += a_double * x[j];
+      y_float += a_float * x[j];
+      y_abs += std::abs(a_double * x[j]);
+    }
+    check(i, y_double, y_float, y_abs);
+  }
+
+  /* Entries that are representable in single precision must be exact: */
+  matrix_float.write_entry(0.375, n - 1, 0);
+  if (matrix_float.get_entry(n - 1, 0) != 0.375)
+    success = false;
+
+  std::cout << (success ? "OK" : "FAILED") << std::endl;
+}
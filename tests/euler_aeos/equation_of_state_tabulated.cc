@@ -0,0 +1,198 @@
+#include <equation_of_state_noble_abel_stiffened_gas.h>
+#include <equation_of_state_polytropic_gas.h>
+#include <equation_of_state_tabulated.h>
+
+#include <deal.II/base/vectorization.h>
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/*
+ * Test the tabulated EOS against the analytic equation of state it was
+ * tabulated from:
+ *
+ *  - a polytropic gas on a linearly spaced table: The pressure and the
+ *    temperature are bilinear in (rho, e) and thus interpolated exactly,
+ *  - a Noble-Abel stiffened gas on a logarithmically spaced table.
+ *
+ * The vectorized and the single precision evaluation have to match the
+ * scalar double precision evaluation.
+ */
+
+using namespace ryujin::EquationOfStateLibrary;
+using namespace ryujin;
+using namespace dealii;
+
+void test(const Tabulated &tabulated,
+          const EquationOfState &source,
+          const std::array<double, 2> &density_range,
+          const std::array<double, 2> &energy_range,
+          const double tolerance_p_T_e,
+          const double tolerance_c)
+{
+  const auto print = [](const std::string &name, const bool success) {
+    std::cout << name << ": " << (success ? "OK" : "FAILED") << std::endl;
+  };
+
+  std::cout << "name = " << source.name() << std::endl;
+
+  /* Deterministic sample points (off the grid) within the given ranges: */
+  constexpr unsigned int n_samples = 20;
+  std::array<double, n_samples> rho, e;
+  for (unsigned int k = 0; k < n_samples; ++k) {
+    const double a = 0.5 + 0.5 * std::sin(1.7 * k + 0.3);
+    const double b = 0.5 + 0.5 * std::sin(2.3 * k + 1.1);
+    rho[k] = density_range[0] + (density_range[1] - density_range[0]) * a;
+    e[k] = energy_range[0] + (energy_range[1] - energy_range[0]) * b;
+  }
+
+  const auto relative_error = [](const double value, const double reference) {
+    return std::abs(value - reference) / std::abs(reference);
+  };
+
+  double error_p = 0., error_c = 0., error_T = 0., error_e = 0.;
+  for (unsigned int k = 0; k < n_samples; ++k) {
+    const double p = source.pressure(rho[k], e[k]);
+    error_p = std::max(error_p,
+                       relative_error(tabulated.pressure(rho[k], e[k]), p));
+    error_c = std::max(
+        error_c,
+        relative_error(tabulated.speed_of_sound(rho[k], e[k]),
+                       source.speed_of_sound(rho[k], e[k])));
+    error_T = std::max(error_T,
+                       relative_error(tabulated.temperature(rho[k], e[k]),
+                                      source.temperature(rho[k], e[k])));
+    error_e = std::max(
+        error_e,
+        relative_error(tabulated.specific_internal_energy(rho[k], p), e[k]));
+  }
+
+  print("pressure", error_p < tolerance_p_T_e);
+  print("speed of sound", error_c < tolerance_c);
+  print("temperature", error_T < tolerance_p_T_e);
+  print("specific internal energy", error_e < tolerance_p_T_e);
+
+  /* Vectorized evaluation: */
+  {
+    using VA = VectorizedArray<double>;
+    bool success = true;
+    for (unsigned int k = 0; k + VA::size() <= n_samples; k += VA::size()) {
+      VA rho_v, e_v;
+      rho_v.load(rho.data() + k);
+      e_v.load(e.data() + k);
+      const VA p_v = tabulated.pressure(rho_v, e_v);
+      const VA c_v = tabulated.speed_of_sound(rho_v, e_v);
+      const VA T_v = tabulated.temperature(rho_v, e_v);
+      const VA e_back_v = tabulated.specific_internal_energy(rho_v, p_v);
+      for (unsigned int l = 0; l < VA::size(); ++l) {
+        const double p = tabulated.pressure(rho[k + l], e[k + l]);
+        success &= relative_error(p_v[l], p) < 1.e-14;
+        success &= relative_error(
+                       c_v[l], tabulated.speed_of_sound(rho[k + l], e[k + l])) <
+                   1.e-14;
+        success &= relative_error(
+                       T_v[l], tabulated.temperature(rho[k + l], e[k + l])) <
+                   1.e-14;
+        success &= relative_error(e_back_v[l],
+                                  tabulated.specific_internal_energy(
+                                      rho[k + l], p)) < 1.e-14;
+      }
+    }
+    print("vectorized", success);
+  }
+
+  /* Single precision evaluation: */
+  {
+    bool success = true;
+    for (unsigned int k = 0; k < n_samples; ++k) {
+      const float p = tabulated.pressure<float>(float(rho[k]), float(e[k]));
+      success &= relative_error(p, tabulated.pressure(rho[k], e[k])) < 1.e-5;
+    }
+    print("float", success);
+  }
+}
+
+
+int main()
+{
+  equation_of_state_list_type equation_of_state_list;
+
+  const auto polytropic_gas = std::make_shared<PolytropicGas>("");
+  const auto noble_abel_stiffened_gas =
+      std::make_shared<NobleAbelStiffenedGas>("");
+  const auto linear =
+      std::make_shared<Tabulated>("/linear", equation_of_state_list);
+  const auto logarithmic =
+      std::make_shared<Tabulated>("/logarithmic", equation_of_state_list);
+
+  equation_of_state_list.insert(polytropic_gas);
+  equation_of_state_list.insert(noble_abel_stiffened_gas);
+  equation_of_state_list.insert(linear);
+  equation_of_state_list.insert(logarithmic);
+
+  {
+    std::stringstream parameters;
+    parameters << "subsection noble abel stiffened gas\n"
+               << "set gamma = 1.4\n"
+               << "set covolume b = 0.2\n"
+               << "set reference specific internal energy = 0.00125\n"
+               << "set reference pressure = 0.005\n"
+               << "end\n"
+               << "subsection linear\n"
+               << "subsection tabulated\n"
+               << "set source equation of state = polytropic gas\n"
+               << "set density range = 0.5, 2.5\n"
+               << "set specific internal energy range = 0.5, 3.0\n"
+               << "set number of points = 64, 64\n"
+               << "set logarithmic spacing = false, false\n"
+               << "set share tables = false\n"
+               << "end\n"
+               << "end\n"
+               << "subsection logarithmic\n"
+               << "subsection tabulated\n"
+               << "set source equation of state = noble abel stiffened gas\n"
+               << "set density range = 0.1, 4.5\n"
+               << "set specific internal energy range = 0.1, 100.0\n"
+               << "set number of points = 256, 256\n"
+               << "set logarithmic spacing = true, true\n"
+               << "set share tables = false\n"
+               << "end\n"
+               << "end\n"
+               << std::endl;
+    ParameterAcceptor::initialize(parameters);
+  }
+
+  std::cout << std::setprecision(10);
+  std::cout << std::scientific;
+
+  std::cout << "\nTabulated polytropic gas with gamma=1.4, linear spacing"
+            << std::endl;
+  {
+    const auto rho = 1.4;
+    const auto e = 1.0 / 1.4 / 0.4;
+    const auto p = linear->pressure(rho, e);
+    const auto e_back = linear->specific_internal_energy(rho, p);
+    const auto T = linear->temperature(rho, e);
+
+    std::cout << "input rho      = " << rho << std::endl    //
+              << "input e        = " << e << std::endl      //
+              << "output p       = " << p << std::endl      //
+              << "check e_back   = " << e_back << std::endl //
+              << "check T        = " << T << std::endl;
+  }
+  test(*linear, *polytropic_gas, {0.6, 2.4}, {0.6, 2.9}, 1.e-12, 1.e-3);
+
+  std::cout << "\nTabulated NobleAbelStiffenedGas with gamma=1.4, b=0.2, "
+               "q=0.00125, pinf=0.005, logarithmic spacing"
+            << std::endl;
+  test(*logarithmic,
+       *noble_abel_stiffened_gas,
+       {0.5, 4.0},
+       {1.0, 50.0},
+       1.e-2,
+       1.e-2);
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include <hyperbolic_system.h>
+#include <riemann_solver.h>
+#include <simd.h>
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ryujin::PassiveScalars;
+using namespace ryujin;
+using namespace dealii;
+
+/*
+ * Check the flux divergence and the wavespeed of the passive scalars
+ * system against the closed form expressions. All tracers are checked
+ * individually, so that the output does not depend on the configured
+ * number of PASSIVE_SCALARS.
+ */
+
+template <int dim, typename Number>
+void test()
+{
+  std::cout << std::setprecision(10);
+  std::cout << std::scientific;
+
+  HyperbolicSystem hyperbolic_system;
+  typename RiemannSolver<dim, Number>::Parameters riemann_solver_parameters;
+
+  const auto view = hyperbolic_system.view<dim, Number>();
+
+  {
+    std::stringstream parameters;
+    parameters << "subsection HyperbolicSystem\n"
+               << "set velocity = 1, -0.5, 0.25\n"
+               << "end\n"
+               << std::endl;
+    ParameterAcceptor::initialize(parameters);
+  }
+
+  using View = HyperbolicSystemView<dim, Number>;
+  using state_type = typename View::state_type;
+  using PrecomputedVector = typename View::PrecomputedVector;
+  using InitialPrecomputedVector = typename View::InitialPrecomputedVector;
+
+  PrecomputedVector dummy;
+  InitialPrecomputedVector dummy_initial;
+
+  RiemannSolver<dim, Number> riemann_solver(
+      hyperbolic_system, riemann_solver_parameters, dummy);
+
+  std::cout << "dim = " << dim << std::endl;
+  std::cout << "velocity = " << view.velocity() << std::endl;
+
+  state_type U_i, U_j;
+  for (unsigned int k = 0; k < View::problem_dimension; ++k) {
+    U_i[k] = Number(k + 1);
+    U_j[k] = Number(2 * (k + 1));
+  }
+
+  /* c_ij = 0.5 e_1 + 2 e_2, i.e., v * c_ij = 0.5 - 1 = -0.5 (for dim > 1) */
+  Tensor<1, dim, Number> c_ij;
+  c_ij[0] = Number(0.5);
+  if constexpr (dim > 1)
+    c_ij[1] = Number(2.);
+  const Number v_c = dim > 1 ? Number(-0.5) : Number(0.5);
+
+  const unsigned int js[1] = {1};
+  const auto flux_i = view.flux_contribution(dummy, dummy_initial, 0, U_i);
+  const auto flux_j = view.flux_contribution(dummy, dummy_initial, js, U_j);
+  const auto divergence = view.flux_divergence(flux_i, flux_j, c_ij);
+
+  bool success = true;
+  for (unsigned int k = 0; k < View::problem_dimension; ++k)
+    if (divergence[k] != -Number(3 * (k + 1)) * v_c)
+      success = false;
+  std::cout << "flux_divergence: " << (success ? "OK" : "FAILED")
+            << std::endl;
+
+  /* n_ij = 0.6 e_1 + 0.8 e_2, i.e., |v * n_ij| = |0.6 - 0.4| = 0.2 */
+  Tensor<1, dim, Number> n_ij;
+  n_ij[0] = Number(dim > 1 ? 0.6 : 1.);
+  if constexpr (dim > 1)
+    n_ij[1] = Number(0.8);
+
+  const auto lambda_max = riemann_solver.compute(U_i, U_j, 0, js, n_ij);
+  const auto lambda_max_swapped =
+      riemann_solver.compute(U_j, U_i, 1, js, n_ij);
+  std::cout << "lambda_max = " << lambda_max << std::endl;
+  std::cout << "symmetric: "
+            << (lambda_max == lambda_max_swapped ? "OK" : "FAILED")
+            << std::endl;
+}
+
+int main()
+{
+  test<1, double>();
+  dealii::ParameterAcceptor::clear();
+  test<2, double>();
+  dealii::ParameterAcceptor::clear();
+  test<3, double>();
+
+  return 0;
+}